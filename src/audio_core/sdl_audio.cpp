@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <bit>
+#include <cstring>
 #include <SDL3/SDL_audio.h>
 #include <SDL3/SDL_init.h>
 #include <SDL3/SDL_timer.h>
@@ -72,13 +75,21 @@ int SDLAudio::AudioOutOpen(int type, u32 samples_num, u32 freq,
                 port.volume[i] = Libraries::AudioOut::SCE_AUDIO_OUT_VOLUME_0DB;
             }
 
+            // Four guest blocks of buffering bounds the latency similarly to the
+            // previous high-water mark on the SDL stream.
+            const u64 block_size = u64(port.samples_num) * port.sample_size * port.channels_num;
+            port.ring_size = std::bit_ceil(block_size * 4);
+            port.ring = std::make_unique<u8[]>(port.ring_size);
+            port.ring_write.store(0, std::memory_order_relaxed);
+            port.ring_read.store(0, std::memory_order_relaxed);
+
             SDL_AudioSpec fmt;
             SDL_zero(fmt);
             fmt.format = sampleFormat;
             fmt.channels = port.channels_num;
             fmt.freq = 48000;
-            port.stream =
-                SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &fmt, NULL, NULL);
+            port.stream = SDL_OpenAudioDeviceStream(SDL_AUDIO_DEVICE_DEFAULT_PLAYBACK, &fmt,
+                                                    &AudioCallback, &port);
             SDL_ResumeAudioDevice(SDL_GetAudioStreamDevice(port.stream));
             return id + 1;
         }
@@ -87,8 +98,29 @@ int SDLAudio::AudioOutOpen(int type, u32 samples_num, u32 freq,
     return -1; // all ports are used
 }
 
+void SDLAudio::AudioCallback(void* userdata, SDL_AudioStream* stream, int additional_amount,
+                             int total_amount) {
+    auto* port = static_cast<PortOut*>(userdata);
+    const u64 read = port->ring_read.load(std::memory_order_relaxed);
+    const u64 avail = port->ring_write.load(std::memory_order_acquire) - read;
+    const u64 to_copy = std::min(avail, u64(std::max(additional_amount, 0)));
+    if (to_copy == 0) {
+        // Underrun, SDL pads the device buffer with silence.
+        return;
+    }
+    // Feeding the stream here runs the sample-rate conversion on the SDL audio
+    // thread instead of the guest thread that produced the block.
+    const u64 offset = read & (port->ring_size - 1);
+    const u64 first = std::min(to_copy, port->ring_size - offset);
+    SDL_PutAudioStreamData(stream, &port->ring[offset], int(first));
+    if (first < to_copy) {
+        SDL_PutAudioStreamData(stream, &port->ring[0], int(to_copy - first));
+    }
+    port->ring_read.store(read + to_copy, std::memory_order_release);
+    port->ring_read.notify_one();
+}
+
 s32 SDLAudio::AudioOutOutput(s32 handle, const void* ptr) {
-    std::scoped_lock lock{m_mutex};
     auto& port = portsOut[handle - 1];
     if (!port.isOpen) {
         return ORBIS_AUDIO_OUT_ERROR_INVALID_PORT;
@@ -97,14 +129,107 @@ s32 SDLAudio::AudioOutOutput(s32 handle, const void* ptr) {
         return 0;
     }
     // TODO mixing channels
-    int result = SDL_PutAudioStreamData(port.stream, ptr,
-                                        port.samples_num * port.sample_size * port.channels_num);
-    // TODO find a correct value 8192 is estimated
-    while (SDL_GetAudioStreamAvailable(port.stream) > 8192) {
-        SDL_Delay(0);
+    const u8* data = static_cast<const u8*>(ptr);
+    u64 remaining = u64(port.samples_num) * port.sample_size * port.channels_num;
+    u64 write = port.ring_write.load(std::memory_order_relaxed);
+    while (remaining > 0) {
+        const u64 read = port.ring_read.load(std::memory_order_acquire);
+        const u64 free_space = port.ring_size - (write - read);
+        if (free_space == 0) {
+            // The ring holds a few blocks worth of backlog; blocking here mirrors
+            // the pacing of sceAudioOutOutput without taking the port mutex.
+            port.ring_read.wait(read, std::memory_order_relaxed);
+            continue;
+        }
+        const u64 to_copy = std::min(remaining, free_space);
+        const u64 offset = write & (port.ring_size - 1);
+        const u64 first = std::min(to_copy, port.ring_size - offset);
+        std::memcpy(&port.ring[offset], data, first);
+        std::memcpy(&port.ring[0], data + first, to_copy - first);
+        write += to_copy;
+        port.ring_write.store(write, std::memory_order_release);
+        data += to_copy;
+        remaining -= to_copy;
+    }
+
+    return 0;
+}
+
+s32 SDLAudio::AudioOutOutputs(Libraries::AudioOut::OrbisAudioOutOutputParam* param, u32 num) {
+    struct Pending {
+        PortOut* port;
+        const u8* data;
+        u64 write;
+        u64 remaining;
+    };
+    std::array<Pending, 22> pending;
+    u32 num_pending = 0;
+    if (num > pending.size()) {
+        return ORBIS_AUDIO_OUT_ERROR_PORT_FULL;
+    }
+
+    // Validate every handle up front so a bad entry fails the whole call before
+    // any sibling port has consumed its block.
+    for (u32 i = 0; i < num; i++) {
+        if (param[i].handle < 1 || param[i].handle > s32(portsOut.size())) {
+            return ORBIS_AUDIO_OUT_ERROR_INVALID_PORT;
+        }
+        auto& port = portsOut[param[i].handle - 1];
+        if (!port.isOpen) {
+            return ORBIS_AUDIO_OUT_ERROR_INVALID_PORT;
+        }
+        if (param[i].ptr == nullptr) {
+            continue;
+        }
+        pending[num_pending++] = {
+            .port = &port,
+            .data = static_cast<const u8*>(param[i].ptr),
+            .write = port.ring_write.load(std::memory_order_relaxed),
+            .remaining = u64(port.samples_num) * port.sample_size * port.channels_num,
+        };
+    }
+
+    // Round-robin over the ports, copying whatever fits into each ring, so one
+    // full ring never delays the submission of its siblings. Only sleep when no
+    // port made progress during a whole pass.
+    u32 num_done = 0;
+    while (num_done < num_pending) {
+        bool progress = false;
+        u64 stalled_read = 0;
+        PortOut* stalled_port = nullptr;
+        for (u32 i = 0; i < num_pending; i++) {
+            auto& entry = pending[i];
+            if (entry.remaining == 0) {
+                continue;
+            }
+            auto& port = *entry.port;
+            const u64 read = port.ring_read.load(std::memory_order_acquire);
+            const u64 free_space = port.ring_size - (entry.write - read);
+            if (free_space == 0) {
+                stalled_port = &port;
+                stalled_read = read;
+                continue;
+            }
+            const u64 to_copy = std::min(entry.remaining, free_space);
+            const u64 offset = entry.write & (port.ring_size - 1);
+            const u64 first = std::min(to_copy, port.ring_size - offset);
+            std::memcpy(&port.ring[offset], entry.data, first);
+            std::memcpy(&port.ring[0], entry.data + first, to_copy - first);
+            entry.write += to_copy;
+            port.ring_write.store(entry.write, std::memory_order_release);
+            entry.data += to_copy;
+            entry.remaining -= to_copy;
+            progress = true;
+            if (entry.remaining == 0) {
+                num_done++;
+            }
+        }
+        if (!progress && stalled_port != nullptr) {
+            stalled_port->ring_read.wait(stalled_read, std::memory_order_relaxed);
+        }
     }
 
-    return result;
+    return 0;
 }
 
 bool SDLAudio::AudioOutSetVolume(s32 handle, s32 bitflag, s32* volume) {
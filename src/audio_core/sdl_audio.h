@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <SDL3/SDL_audio.h>
 #include "core/libraries/audio/audioout.h"
@@ -17,6 +19,7 @@ public:
     int AudioOutOpen(int type, u32 samples_num, u32 freq,
                      Libraries::AudioOut::OrbisAudioOutParam format);
     s32 AudioOutOutput(s32 handle, const void* ptr);
+    s32 AudioOutOutputs(Libraries::AudioOut::OrbisAudioOutOutputParam* param, u32 num);
     bool AudioOutSetVolume(s32 handle, s32 bitflag, s32* volume);
     bool AudioOutGetStatus(s32 handle, int* type, int* channels_num);
 
@@ -31,7 +34,18 @@ private:
         int channels_num = 0;
         int volume[8] = {};
         SDL_AudioStream* stream = nullptr;
+        // Single-producer single-consumer byte ring between the guest audio thread
+        // and the SDL device callback. AudioOutOutput is the only writer and the
+        // callback the only reader, so no lock is required on the sample path.
+        std::unique_ptr<u8[]> ring;
+        u64 ring_size = 0; ///< Capacity in bytes, always a power of two.
+        std::atomic<u64> ring_write{0};
+        std::atomic<u64> ring_read{0};
     };
+
+    static void AudioCallback(void* userdata, SDL_AudioStream* stream, int additional_amount,
+                              int total_amount);
+
     std::mutex m_mutex;
     std::array<PortOut, 22> portsOut; // main up to 8 ports , BGM 1 port , voice up to 4 ports ,
                                       // personal up to 4 ports , padspk up to 5 ports , aux 1 port
@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "common/types.h"
+#include "video_core/texture_cache/tile_manager.h"
+
+// CPU detile of a 32bpp surface, the path taken when an image is refreshed
+// from tiled guest memory. The tiled source is padded past the nominal size
+// since tiling rounds surfaces up to whole (macro)tiles.
+static void BM_ConvertTileToLinear(benchmark::State& state) {
+    const u32 width = static_cast<u32>(state.range(0));
+    const u32 height = static_cast<u32>(state.range(1));
+    const bool is_neo = state.range(2) != 0;
+
+    const size_t padded = size_t((width + 127) & ~127u) * ((height + 127) & ~127u) * 4 * 2;
+    std::vector<u8> src(padded);
+    std::vector<u8> dst(size_t(width) * height * 4);
+    for (size_t i = 0; i < src.size(); i++) {
+        src[i] = static_cast<u8>(i * 131 + 7);
+    }
+
+    for (auto _ : state) {
+        VideoCore::ConvertTileToLinear(dst.data(), src.data(), width, height, is_neo);
+        benchmark::DoNotOptimize(dst.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() * dst.size());
+}
+
+BENCHMARK(BM_ConvertTileToLinear)
+    ->Args({1280, 720, 0})
+    ->Args({1920, 1080, 0})
+    ->Args({1920, 1080, 1})
+    ->Args({3840, 2160, 1});
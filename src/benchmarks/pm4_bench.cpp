@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <memory>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "video_core/amdgpu/liverpool.h"
+#include "video_core/amdgpu/pm4_cmds.h"
+
+using AmdGpu::Liverpool;
+using AmdGpu::PM4ItOpcode;
+using AmdGpu::PM4Type3Header;
+
+namespace {
+
+// Builds a command stream shaped like a frame's state setup: long bursts of
+// register upload packets broken up by NOPs. No draw packets are included, so
+// the stream decodes fully with no rasterizer bound.
+std::vector<u32> BuildRegisterStream(u32 num_bursts) {
+    std::vector<u32> dcb;
+    dcb.reserve(num_bursts * 12);
+    for (u32 burst = 0; burst < num_bursts; burst++) {
+        // SET_SH_REG writing 8 consecutive dwords.
+        const PM4Type3Header set_header{PM4ItOpcode::SetShReg, 8};
+        dcb.push_back(set_header.raw);
+        dcb.push_back((burst * 8) % 256);
+        for (u32 i = 0; i < 8; i++) {
+            dcb.push_back(burst * 8 + i);
+        }
+        // Trailing NOP with an empty payload dword, as guests emit.
+        const PM4Type3Header nop_header{PM4ItOpcode::Nop, 0};
+        dcb.push_back(nop_header.raw);
+        dcb.push_back(0);
+    }
+    return dcb;
+}
+
+} // Anonymous namespace
+
+// PM4 decode throughput of the graphics command processor, measured by
+// submitting a replayed dword stream and waiting for the processor thread to
+// drain it.
+static void BM_ProcessGraphics(benchmark::State& state) {
+    auto liverpool = std::make_unique<Liverpool>();
+    const auto dcb = BuildRegisterStream(static_cast<u32>(state.range(0)));
+
+    for (auto _ : state) {
+        liverpool->SubmitGfx(dcb, {});
+        liverpool->WaitGpuIdle();
+    }
+    state.SetBytesProcessed(state.iterations() * dcb.size() * sizeof(u32));
+}
+
+BENCHMARK(BM_ProcessGraphics)->Arg(1000)->Arg(50000)->Unit(benchmark::kMicrosecond);
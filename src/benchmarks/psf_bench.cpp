@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <benchmark/benchmark.h>
+#include "core/file_format/psf.h"
+
+namespace {
+
+// Builds an in-memory param.sfo with alternating string and integer entries,
+// shaped like the ones shipped with titles.
+std::vector<u8> BuildPsf(u32 num_entries) {
+    std::vector<u8> key_table;
+    std::vector<u8> data_table;
+    std::vector<PSFEntry> entries(num_entries);
+
+    for (u32 i = 0; i < num_entries; i++) {
+        PSFEntry& entry = entries[i];
+        entry.key_offset = static_cast<u16>(key_table.size());
+        entry.data_offset = static_cast<u32>(data_table.size());
+
+        const std::string key = "KEY_" + std::to_string(i);
+        key_table.insert(key_table.end(), key.begin(), key.end());
+        key_table.push_back('\0');
+
+        if (i % 2 == 0) {
+            entry.param_fmt = PSFEntry::Fmt::TextNormal;
+            const std::string value = "value-" + std::to_string(i * 7919);
+            entry.param_len = static_cast<u32>(value.size() + 1);
+            entry.param_max_len = entry.param_len;
+            data_table.insert(data_table.end(), value.begin(), value.end());
+            data_table.push_back('\0');
+        } else {
+            entry.param_fmt = PSFEntry::Fmt::Integer;
+            entry.param_len = sizeof(u32);
+            entry.param_max_len = sizeof(u32);
+            const u32 value = i * 2654435761u;
+            const auto* bytes = reinterpret_cast<const u8*>(&value);
+            data_table.insert(data_table.end(), bytes, bytes + sizeof(u32));
+        }
+    }
+
+    PSFHeader header{};
+    header.magic = 0x00505346;
+    header.version = 0x101;
+    header.key_table_offset = sizeof(PSFHeader) + num_entries * sizeof(PSFEntry);
+    header.data_table_offset = header.key_table_offset + static_cast<u32>(key_table.size());
+    header.index_table_entries = num_entries;
+
+    std::vector<u8> psf(sizeof(PSFHeader) + num_entries * sizeof(PSFEntry) + key_table.size() +
+                        data_table.size());
+    u8* out = psf.data();
+    std::memcpy(out, &header, sizeof(header));
+    out += sizeof(header);
+    std::memcpy(out, entries.data(), num_entries * sizeof(PSFEntry));
+    out += num_entries * sizeof(PSFEntry);
+    std::memcpy(out, key_table.data(), key_table.size());
+    out += key_table.size();
+    std::memcpy(out, data_table.data(), data_table.size());
+    return psf;
+}
+
+} // Anonymous namespace
+
+// Full param.sfo parse, run once per title at boot and per entry during game
+// library scans in the GUI.
+static void BM_PsfOpen(benchmark::State& state) {
+    const auto blob = BuildPsf(static_cast<u32>(state.range(0)));
+
+    for (auto _ : state) {
+        PSF psf;
+        benchmark::DoNotOptimize(psf.open("", blob));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_PsfOpen)->Arg(32)->Arg(256);
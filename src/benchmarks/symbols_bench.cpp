@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <benchmark/benchmark.h>
+#include "core/loader/symbols_resolver.h"
+
+namespace {
+
+Core::Loader::SymbolResolver MakeSymbol(int i) {
+    Core::Loader::SymbolResolver sr{};
+    sr.name = "nid" + std::to_string(i);
+    sr.library = "libSceBench" + std::to_string(i % 16);
+    sr.library_version = 1;
+    sr.module = "libSceBench" + std::to_string(i % 16);
+    sr.module_version_major = 1;
+    sr.module_version_minor = 1;
+    sr.type = Core::Loader::SymbolType::Function;
+    return sr;
+}
+
+} // Anonymous namespace
+
+// Symbol lookup during relocation; a large module resolves tens of thousands
+// of imports against the HLE table at load time.
+static void BM_FindSymbolHit(benchmark::State& state) {
+    const int num_symbols = static_cast<int>(state.range(0));
+    Core::Loader::SymbolsResolver resolver;
+    for (int i = 0; i < num_symbols; i++) {
+        resolver.AddSymbol(MakeSymbol(i), 0x1000 + i);
+    }
+
+    int next = 0;
+    for (auto _ : state) {
+        const auto* record = resolver.FindSymbol(MakeSymbol(next));
+        benchmark::DoNotOptimize(record);
+        next = (next + 1) % num_symbols;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_FindSymbolMiss(benchmark::State& state) {
+    const int num_symbols = static_cast<int>(state.range(0));
+    Core::Loader::SymbolsResolver resolver;
+    for (int i = 0; i < num_symbols; i++) {
+        resolver.AddSymbol(MakeSymbol(i), 0x1000 + i);
+    }
+
+    int next = 0;
+    for (auto _ : state) {
+        const auto* record = resolver.FindSymbol(MakeSymbol(num_symbols + next));
+        benchmark::DoNotOptimize(record);
+        next = (next + 1) % num_symbols;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_FindSymbolHit)->Arg(1000)->Arg(20000);
+BENCHMARK(BM_FindSymbolMiss)->Arg(20000);
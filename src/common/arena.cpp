@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <bit>
+#include <new>
+#include "common/alignment.h"
+#include "common/arena.h"
+#include "common/assert.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace Common {
+
+BumpArena::BumpArena(std::size_t block_size_) : block_size{block_size_} {
+    AppendBlock(block_size);
+}
+
+BumpArena::~BumpArena() {
+    for (const Block& block : blocks) {
+        ::operator delete(block.data, std::align_val_t{DefaultBlockSize});
+    }
+}
+
+BumpArena::Block& BumpArena::AppendBlock(std::size_t min_size) {
+    const std::size_t size = std::max(block_size, min_size);
+    // Align blocks to the large-page granule so transparent huge pages can back
+    // them, keeping TLB pressure of the hot PM4 paths low.
+    u8* const data = static_cast<u8*>(::operator new(size, std::align_val_t{DefaultBlockSize}));
+#ifdef __linux__
+    madvise(data, size, MADV_HUGEPAGE);
+#endif
+    return blocks.emplace_back(data, size);
+}
+
+void* BumpArena::Allocate(std::size_t size, std::size_t align) {
+    ASSERT(std::has_single_bit(align));
+    std::scoped_lock lk{mutex};
+    while (true) {
+        Block& block = blocks[active_block];
+        const std::size_t aligned = Common::AlignUp(offset, align);
+        if (aligned + size <= block.size) {
+            offset = aligned + size;
+            return block.data + aligned;
+        }
+        if (++active_block == blocks.size()) {
+            AppendBlock(size);
+        }
+        offset = 0;
+    }
+}
+
+void BumpArena::Reset() {
+    std::scoped_lock lk{mutex};
+    active_block = 0;
+    offset = 0;
+}
+
+std::size_t BumpArena::CommittedBytes() const {
+    std::scoped_lock lk{mutex};
+    std::size_t total = 0;
+    for (const Block& block : blocks) {
+        total += block.size;
+    }
+    return total;
+}
+
+} // namespace Common
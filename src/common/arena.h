@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+#include "common/types.h"
+
+namespace Common {
+
+/**
+ * Frame-scoped bump allocator for transient allocations that all die at a
+ * known quiescent point, e.g. PM4 submit task frames retired by the end of a
+ * guest frame. Memory is carved out of large-page-aligned blocks with a bump
+ * pointer, so individual allocations are a pointer increment and individual
+ * frees are no-ops; Reset() rewinds every block at once but keeps them mapped,
+ * so the steady state performs no system allocations at all.
+ *
+ * Allocate() is thread-safe. The caller must guarantee that no allocation is
+ * still live (and none is concurrently being made) when calling Reset().
+ */
+class BumpArena {
+public:
+    explicit BumpArena(std::size_t block_size_ = DefaultBlockSize);
+    ~BumpArena();
+
+    BumpArena(const BumpArena&) = delete;
+    BumpArena& operator=(const BumpArena&) = delete;
+
+    /// Carves size bytes with the requested alignment out of the current block.
+    [[nodiscard]] void* Allocate(std::size_t size, std::size_t align = alignof(std::max_align_t));
+
+    /// Rewinds all blocks without unmapping them, invalidating every
+    /// outstanding allocation.
+    void Reset();
+
+    /// Total bytes of backing blocks currently mapped.
+    std::size_t CommittedBytes() const;
+
+private:
+    static constexpr std::size_t DefaultBlockSize = 2_MB;
+
+    struct Block {
+        u8* data;
+        std::size_t size;
+    };
+
+    Block& AppendBlock(std::size_t min_size);
+
+    const std::size_t block_size;
+    mutable std::mutex mutex;
+    std::vector<Block> blocks;
+    std::size_t active_block{};
+    std::size_t offset{};
+};
+
+} // namespace Common
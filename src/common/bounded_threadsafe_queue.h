@@ -3,13 +3,19 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <cstddef>
 #include <memory>
 #include <mutex>
+#include <span>
 #include "common/polyfill_thread.h"
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
 namespace Common {
 
 namespace detail {
@@ -55,6 +61,35 @@ public:
         return t;
     }
 
+    /// Drains up to out.size() elements with a single synchronization episode,
+    /// returning the number popped. Upcoming slots are prefetched while earlier
+    /// ones are moved out so large drains stream instead of stalling per element.
+    std::size_t TryPopBatch(std::span<T> out) {
+        return PopBatch(out);
+    }
+
+    /// Blocking batched pop: spins briefly in case a bursty producer publishes
+    /// again within a few hundred cycles, then falls back to a condition
+    /// variable wait. Returns 0 only when the stop token is triggered.
+    std::size_t PopBatchWait(std::span<T> out, std::stop_token stop_token) {
+        for (int spin = 0; spin < 128; ++spin) {
+            if (const std::size_t count = PopBatch(out)) {
+                return count;
+            }
+        }
+        const std::size_t read_index = m_read_index.load(std::memory_order::relaxed);
+        {
+            std::unique_lock lock{consumer_cv_mutex};
+            Common::CondvarWait(consumer_cv, lock, stop_token, [this, read_index] {
+                return read_index != m_write_index.load(std::memory_order::acquire);
+            });
+            if (stop_token.stop_requested()) {
+                return 0;
+            }
+        }
+        return PopBatch(out);
+    }
+
 private:
     enum class PushMode {
         Try,
@@ -148,6 +183,42 @@ private:
         return true;
     }
 
+    static void PrefetchSlot(const T* slot) {
+#ifdef _MSC_VER
+        _mm_prefetch(reinterpret_cast<const char*>(slot), _MM_HINT_T0);
+#else
+        __builtin_prefetch(slot);
+#endif
+    }
+
+    std::size_t PopBatch(std::span<T> out) {
+        static constexpr std::size_t PrefetchDistance = 4;
+
+        const std::size_t read_index = m_read_index.load(std::memory_order::relaxed);
+        const std::size_t write_index = m_write_index.load(std::memory_order::acquire);
+        const std::size_t count = std::min(write_index - read_index, out.size());
+        if (count == 0) {
+            return 0;
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            if (i + PrefetchDistance < count) {
+                PrefetchSlot(std::addressof(m_data[(read_index + i + PrefetchDistance) % Capacity]));
+            }
+            out[i] = std::move(m_data[(read_index + i) % Capacity]);
+        }
+
+        // Publish the whole drained range at once; there is only one consumer,
+        // so a plain release store replaces count read-modify-writes.
+        m_read_index.store(read_index + count, std::memory_order::release);
+
+        // Notify the producer that slots have been freed.
+        std::scoped_lock lock{producer_cv_mutex};
+        producer_cv.notify_one();
+
+        return count;
+    }
+
     alignas(128) std::atomic_size_t m_read_index{0};
     alignas(128) std::atomic_size_t m_write_index{0};
 
@@ -194,6 +265,14 @@ public:
         return spsc_queue.PopWait(stop_token);
     }
 
+    std::size_t TryPopBatch(std::span<T> out) {
+        return spsc_queue.TryPopBatch(out);
+    }
+
+    std::size_t PopBatchWait(std::span<T> out, std::stop_token stop_token) {
+        return spsc_queue.PopBatchWait(out, stop_token);
+    }
+
 private:
     SPSCQueue<T, Capacity> spsc_queue;
     std::mutex write_mutex;
@@ -239,6 +318,11 @@ public:
         return spsc_queue.PopWait(stop_token);
     }
 
+    std::size_t TryPopBatch(std::span<T> out) {
+        std::scoped_lock lock{read_mutex};
+        return spsc_queue.TryPopBatch(out);
+    }
+
 private:
     SPSCQueue<T, Capacity> spsc_queue;
     std::mutex write_mutex;
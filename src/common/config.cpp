@@ -1,14 +1,56 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <atomic>
+#include <chrono>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 #include <fmt/core.h>
 #include <toml.hpp>
+#include "common/logging/backend.h"
+#include "common/logging/filter.h"
+#include "common/thread.h"
 #include "config.h"
 
 namespace Config {
 
+/**
+ * Immutable snapshot of the settings that are read every frame and may be
+ * flipped at runtime. Readers pay a single acquire load; the watcher thread
+ * publishes a fresh snapshot with a pointer swap. Old snapshots are retired
+ * instead of freed since a reader may still hold one across the swap; reloads
+ * are rare and the snapshots small, so the retired list stays negligible.
+ */
+struct RuntimeConfig {
+    u64 version{};
+    bool dump_shaders{};
+    bool dump_pm4{};
+    bool capture_pm4{};
+    bool dump_frame_stats{};
+    bool capture_frames{};
+    std::string log_filter;
+    std::string present_mode = "auto";
+    std::string p_cores;
+    std::string e_cores;
+};
+
+static std::atomic<const RuntimeConfig*> runtime_config{nullptr};
+static std::mutex runtime_mutex;
+static std::vector<std::unique_ptr<const RuntimeConfig>> retired_runtimes;
+
+static const RuntimeConfig* runtime() {
+    if (const auto* snapshot = runtime_config.load(std::memory_order_acquire)) {
+        return snapshot;
+    }
+    static const RuntimeConfig defaults{};
+    return &defaults;
+}
+
+
 static bool isNeo = false;
 static bool isFullscreen = false;
 static u32 screenWidth = 1280;
@@ -18,12 +60,30 @@ static std::string logFilter;
 static std::string logType = "sync";
 static bool isDebugDump = false;
 static bool isLibc = true;
+static bool isLazyBinding = false;
+static bool useDmemHugePages = false;
+static bool usePreciseSleep = false;
 static bool isShowSplash = true;
 static bool isNullGpu = false;
+static bool isHeadless = false;
 static bool shouldDumpShaders = false;
 static bool shouldDumpPM4 = false;
+static bool shouldCapturePM4 = false;
+static bool shouldDumpFrameStats = false;
+static bool shouldCaptureFrames = false;
+static bool shouldCompileShadersAsync = false;
+static bool useDynamicResolution = false;
+static u32 numComputeThreads = 0;
+static bool busyPollGpuThread = false;
+static u32 transferBudgetMb = 0;
+static u32 numFlipQueueSlots = 0; // 0 = one pending flip per registered display buffer
 static bool vkValidation = false;
 static bool vkValidationSync = false;
+// Present mode policy: "auto", "fifo", "mailbox" or "immediate".
+static std::string presentMode = "auto";
+// Manual P/E core list overrides ("0-7,16"); empty = auto-detect topology.
+static std::string pCoresOverride;
+static std::string eCoresOverride;
 // Gui
 std::string settings_install_dir = "";
 u32 main_window_geometry_x = 400;
@@ -42,10 +102,43 @@ std::vector<std::string> m_pkg_viewer;
 std::vector<std::string> m_elf_viewer;
 std::vector<std::string> m_recent_files;
 
+/// Builds a new runtime snapshot from the freshly parsed statics and swaps it in.
+static void publishRuntime() {
+    std::scoped_lock lock{runtime_mutex};
+    auto snapshot = std::make_unique<RuntimeConfig>(RuntimeConfig{
+        .version = retired_runtimes.size() + 1,
+        .dump_shaders = shouldDumpShaders,
+        .dump_pm4 = shouldDumpPM4,
+        .capture_pm4 = shouldCapturePM4,
+        .dump_frame_stats = shouldDumpFrameStats,
+        .capture_frames = shouldCaptureFrames,
+        .log_filter = logFilter,
+        .present_mode = presentMode,
+        .p_cores = pCoresOverride,
+        .e_cores = eCoresOverride,
+    });
+    const auto* old = runtime_config.exchange(snapshot.release(), std::memory_order_release);
+    if (old) {
+        retired_runtimes.emplace_back(old);
+    }
+}
+
 bool isLleLibc() {
     return isLibc;
 }
 
+bool lazyJumpSlotBinding() {
+    return isLazyBinding;
+}
+
+bool directMemoryHugePages() {
+    return useDmemHugePages;
+}
+
+bool preciseSleep() {
+    return usePreciseSleep;
+}
+
 bool isNeoMode() {
     return isNeo;
 }
@@ -67,7 +160,7 @@ s32 getGpuId() {
 }
 
 std::string getLogFilter() {
-    return logFilter;
+    return runtime()->log_filter;
 }
 
 std::string getLogType() {
@@ -86,12 +179,52 @@ bool nullGpu() {
     return isNullGpu;
 }
 
+bool headlessMode() {
+    return isHeadless;
+}
+
 bool dumpShaders() {
-    return shouldDumpShaders;
+    return runtime()->dump_shaders;
 }
 
 bool dumpPM4() {
-    return shouldDumpPM4;
+    return runtime()->dump_pm4;
+}
+
+bool capturePM4() {
+    return runtime()->capture_pm4;
+}
+
+bool dumpFrameStats() {
+    return runtime()->dump_frame_stats;
+}
+
+bool dynamicResolutionEnabled() {
+    return useDynamicResolution;
+}
+
+bool captureFrames() {
+    return runtime()->capture_frames;
+}
+
+bool asyncShaderCompilation() {
+    return shouldCompileShadersAsync;
+}
+
+u32 computeThreads() {
+    return numComputeThreads;
+}
+
+bool gpuBusyPoll() {
+    return busyPollGpuThread;
+}
+
+u32 transferBudgetMbPerSec() {
+    return transferBudgetMb;
+}
+
+u32 flipQueueDepth() {
+    return numFlipQueueSlots;
 }
 
 bool vkValidationEnabled() {
@@ -102,6 +235,18 @@ bool vkValidationSyncEnabled() {
     return vkValidationSync;
 }
 
+std::string vkPresentMode() {
+    return runtime()->present_mode;
+}
+
+std::string pCoreList() {
+    return runtime()->p_cores;
+}
+
+std::string eCoreList() {
+    return runtime()->e_cores;
+}
+
 void setMainWindowGeometry(u32 x, u32 y, u32 w, u32 h) {
     main_window_geometry_x = x;
     main_window_geometry_y = y;
@@ -224,6 +369,9 @@ void load(const std::filesystem::path& path) {
             logFilter = toml::find_or<toml::string>(general, "logFilter", "");
             logType = toml::find_or<toml::string>(general, "logType", "sync");
             isShowSplash = toml::find_or<toml::boolean>(general, "showSplash", true);
+            isLazyBinding = toml::find_or<toml::boolean>(general, "lazyBinding", false);
+            useDmemHugePages = toml::find_or<toml::boolean>(general, "directMemoryHugePages", false);
+            usePreciseSleep = toml::find_or<toml::boolean>(general, "preciseSleep", false);
         }
     }
     if (data.contains("GPU")) {
@@ -235,8 +383,28 @@ void load(const std::filesystem::path& path) {
             screenHeight = toml::find_or<toml::integer>(gpu, "screenHeight", screenHeight);
             gpuId = toml::find_or<toml::integer>(gpu, "gpuId", 0);
             isNullGpu = toml::find_or<toml::boolean>(gpu, "nullGpu", false);
+            isHeadless = toml::find_or<toml::boolean>(gpu, "headless", false);
             shouldDumpShaders = toml::find_or<toml::boolean>(gpu, "dumpShaders", false);
             shouldDumpPM4 = toml::find_or<toml::boolean>(gpu, "dumpPM4", false);
+            shouldCapturePM4 = toml::find_or<toml::boolean>(gpu, "capturePM4", false);
+            shouldDumpFrameStats = toml::find_or<toml::boolean>(gpu, "dumpFrameStats", false);
+            shouldCaptureFrames = toml::find_or<toml::boolean>(gpu, "captureFrames", false);
+            shouldCompileShadersAsync =
+                toml::find_or<toml::boolean>(gpu, "asyncShaderCompilation", false);
+            useDynamicResolution = toml::find_or<toml::boolean>(gpu, "dynamicResolution", false);
+            numComputeThreads = toml::find_or<toml::integer>(gpu, "computeThreads", 0);
+            busyPollGpuThread = toml::find_or<toml::boolean>(gpu, "busyPoll", false);
+            transferBudgetMb = toml::find_or<toml::integer>(gpu, "transferBudgetMBps", 0);
+            numFlipQueueSlots = toml::find_or<toml::integer>(gpu, "flipQueueDepth", 0);
+        }
+    }
+    if (data.contains("CPU")) {
+        auto cpuResult = toml::expect<toml::value>(data.at("CPU"));
+        if (cpuResult.is_ok()) {
+            auto cpu = cpuResult.unwrap();
+
+            pCoresOverride = toml::find_or<toml::string>(cpu, "pCores", "");
+            eCoresOverride = toml::find_or<toml::string>(cpu, "eCores", "");
         }
     }
     if (data.contains("Vulkan")) {
@@ -246,6 +414,7 @@ void load(const std::filesystem::path& path) {
 
             vkValidation = toml::find_or<toml::boolean>(vk, "validation", true);
             vkValidationSync = toml::find_or<toml::boolean>(vk, "validation_sync", true);
+            presentMode = toml::find_or<toml::string>(vk, "presentMode", "auto");
         }
     }
     if (data.contains("Debug")) {
@@ -287,7 +456,40 @@ void load(const std::filesystem::path& path) {
             m_table_mode = toml::find_or<toml::integer>(gui, "gameTableMode", 0);
         }
     }
+
+    publishRuntime();
+}
+
+void startWatcher(const std::filesystem::path& path) {
+    static std::jthread watcher;
+    watcher = std::jthread([path](std::stop_token token) {
+        Common::SetCurrentThreadName("shadPS4:ConfigWatch");
+        std::error_code ec;
+        auto last_mtime = std::filesystem::last_write_time(path, ec);
+        while (!token.stop_requested()) {
+            // Sleep in short slices so emulator shutdown is not held up by the
+            // poll interval.
+            for (int i = 0; i < 10 && !token.stop_requested(); i++) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            }
+            const auto mtime = std::filesystem::last_write_time(path, ec);
+            if (ec || mtime == last_mtime) {
+                continue;
+            }
+            last_mtime = mtime;
+            load(path);
+            // Re-apply the log filter so filter edits take effect immediately.
+            Common::Log::Filter filter;
+            filter.ParseFilterString(getLogFilter());
+            Common::Log::SetGlobalFilter(filter);
+            // Migrate registered threads in case the core lists changed.
+            Common::ReapplyThreadRoles();
+            fmt::print("Reloaded configuration from {} (snapshot v{})\n", path.string(),
+                       runtime()->version);
+        }
+    });
 }
+
 void save(const std::filesystem::path& path) {
     toml::basic_value<toml::preserve_comments> data;
 
@@ -312,14 +514,30 @@ void save(const std::filesystem::path& path) {
     data["General"]["logFilter"] = logFilter;
     data["General"]["logType"] = logType;
     data["General"]["showSplash"] = isShowSplash;
+    data["General"]["lazyBinding"] = isLazyBinding;
+    data["General"]["directMemoryHugePages"] = useDmemHugePages;
+    data["General"]["preciseSleep"] = usePreciseSleep;
     data["GPU"]["gpuId"] = gpuId;
     data["GPU"]["screenWidth"] = screenWidth;
     data["GPU"]["screenHeight"] = screenHeight;
     data["GPU"]["nullGpu"] = isNullGpu;
+    data["GPU"]["headless"] = isHeadless;
     data["GPU"]["dumpShaders"] = shouldDumpShaders;
     data["GPU"]["dumpPM4"] = shouldDumpPM4;
+    data["GPU"]["capturePM4"] = shouldCapturePM4;
+    data["GPU"]["dumpFrameStats"] = shouldDumpFrameStats;
+    data["GPU"]["captureFrames"] = shouldCaptureFrames;
+    data["GPU"]["asyncShaderCompilation"] = shouldCompileShadersAsync;
+    data["GPU"]["dynamicResolution"] = useDynamicResolution;
+    data["GPU"]["computeThreads"] = numComputeThreads;
+    data["GPU"]["busyPoll"] = busyPollGpuThread;
+    data["GPU"]["transferBudgetMBps"] = transferBudgetMb;
+    data["GPU"]["flipQueueDepth"] = numFlipQueueSlots;
+    data["CPU"]["pCores"] = pCoresOverride;
+    data["CPU"]["eCores"] = eCoresOverride;
     data["Vulkan"]["validation"] = vkValidation;
     data["Vulkan"]["validation_sync"] = vkValidationSync;
+    data["Vulkan"]["presentMode"] = presentMode;
     data["Debug"]["DebugDump"] = isDebugDump;
     data["LLE"]["libc"] = isLibc;
     data["GUI"]["theme"] = mw_themes;
@@ -11,6 +11,11 @@ namespace Config {
 void load(const std::filesystem::path& path);
 void save(const std::filesystem::path& path);
 
+/// Spawns a thread that reloads the file whenever its modification time changes.
+/// Settings read per frame (dump flags, present mode, log filter) take effect
+/// live; structural settings only apply on the next start.
+void startWatcher(const std::filesystem::path& path);
+
 bool isNeoMode();
 bool isFullscreenMode();
 std::string getLogFilter();
@@ -22,13 +27,29 @@ s32 getGpuId();
 
 bool debugDump();
 bool isLleLibc();
+bool lazyJumpSlotBinding();
+bool directMemoryHugePages();
+bool preciseSleep();
 bool showSplash();
 bool nullGpu();
+bool headlessMode();
 bool dumpShaders();
 bool dumpPM4();
+bool capturePM4();
+bool dumpFrameStats();
+bool dynamicResolutionEnabled();
+bool captureFrames();
+bool asyncShaderCompilation();
+u32 computeThreads();
+bool gpuBusyPoll();
+u32 transferBudgetMbPerSec();
+u32 flipQueueDepth();
 
 bool vkValidationEnabled();
 bool vkValidationSyncEnabled();
+std::string vkPresentMode();
+std::string pCoreList();
+std::string eCoreList();
 
 // Gui
 void setMainWindowGeometry(u32 x, u32 y, u32 w, u32 h);
@@ -34,4 +34,44 @@ void Disassembler::printInst(ZydisDecodedInstruction& inst, ZydisDecodedOperand*
     fmt::print("instruction: {}\n", szBuffer);
 }
 
+const std::vector<std::string>& Disassembler::formatWindow(const void* code, u64 size, u64 address,
+                                                           u32 max_lines) {
+    if (const auto it = m_window_cache.find(address); it != m_window_cache.end()) {
+        m_window_lru.splice(m_window_lru.begin(), m_window_lru, it->second.lru_it);
+        return it->second.lines;
+    }
+
+    std::vector<std::string> lines;
+    lines.reserve(max_lines);
+    const u8* ptr = static_cast<const u8*>(code);
+    u64 offset = 0;
+    char buffer[256];
+    while (lines.size() < max_lines && offset < size) {
+        ZydisDecodedInstruction instruction;
+        ZydisDecodedOperand operands[ZYDIS_MAX_OPERAND_COUNT_VISIBLE];
+        const ZyanStatus status = ZydisDecoderDecodeFull(&m_decoder, ptr + offset, size - offset,
+                                                         &instruction, operands);
+        if (!ZYAN_SUCCESS(status)) {
+            // Skip one byte so a stray data byte does not stall the window.
+            lines.push_back(fmt::format("{:#018x}: <invalid>", address + offset));
+            offset += 1;
+            continue;
+        }
+        ZydisFormatterFormatInstruction(&m_formatter, &instruction, operands,
+                                        instruction.operand_count_visible, buffer, sizeof(buffer),
+                                        address + offset, ZYAN_NULL);
+        lines.push_back(fmt::format("{:#018x}: {}", address + offset, buffer));
+        offset += instruction.length;
+    }
+
+    if (m_window_cache.size() >= WindowCacheCapacity) {
+        m_window_cache.erase(m_window_lru.back());
+        m_window_lru.pop_back();
+    }
+    m_window_lru.push_front(address);
+    const auto [it, _] =
+        m_window_cache.emplace(address, CachedWindow{std::move(lines), m_window_lru.begin()});
+    return it->second.lines;
+}
+
 } // namespace Common
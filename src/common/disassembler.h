@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
 #include <Zydis/Zydis.h>
 #include "common/types.h"
 
@@ -16,9 +20,25 @@ public:
     void printInst(ZydisDecodedInstruction& inst, ZydisDecodedOperand* operands, u64 address);
     void printInstruction(void* code, u64 address);
 
+    /// Formats up to max_lines instructions starting at address, decoding only
+    /// that window instead of the whole segment. Windows are kept in a small
+    /// LRU cache keyed by start address, so scrolling back over a range does
+    /// not pay the decode cost again.
+    const std::vector<std::string>& formatWindow(const void* code, u64 size, u64 address,
+                                                 u32 max_lines);
+
 private:
+    static constexpr size_t WindowCacheCapacity = 64;
+
+    struct CachedWindow {
+        std::vector<std::string> lines;
+        std::list<u64>::iterator lru_it;
+    };
+
     ZydisDecoder m_decoder;
     ZydisFormatter m_formatter;
+    std::list<u64> m_window_lru;
+    std::unordered_map<u64, CachedWindow> m_window_cache;
 };
 
 } // namespace Common
@@ -1,9 +1,11 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
 #include <cstring>
 #include <ctime>
 #include "common/discord.h"
+#include "common/thread.h"
 
 namespace Discord {
 
@@ -13,28 +15,72 @@ void RPC::init() {
 
     startTimestamp = time(nullptr);
     enabled = true;
+    presence_thread = std::jthread([this](std::stop_token stoken) { worker(stoken); });
 }
 
 void RPC::update(Discord::RPCStatus status, const std::string& game) {
-    DiscordRichPresence rpc{};
-
-    if (status == Discord::RPCStatus::Playing) {
-        rpc.details = "Playing a game";
-        rpc.state = game.c_str();
-    } else {
-        rpc.details = "Idle";
+    // Post to the mailbox and return; intermediate states that the worker never
+    // sees are fine, only the latest one matters.
+    {
+        std::scoped_lock lock{mailbox_mutex};
+        mailbox_status = status;
+        mailbox_game = game;
+        ++mailbox_generation;
     }
+    mailbox_cv.notify_one();
+}
+
+void RPC::worker(std::stop_token stoken) {
+    Common::SetCurrentThreadName("shadPS4:DiscordRPC");
+    Common::SetCurrentThreadPriority(Common::ThreadPriority::Low);
 
-    rpc.largeImageKey = "shadps4";
-    rpc.largeImageText = "ShadPS4 is a PS4 emulator";
-    rpc.startTimestamp = startTimestamp;
+    std::uint64_t applied_generation = 0;
+    while (!stoken.stop_requested()) {
+        RPCStatus status;
+        std::string game;
+        bool has_update = false;
+        {
+            using namespace std::chrono_literals;
+            std::unique_lock lock{mailbox_mutex};
+            // Wake on a new state or periodically to pump the SDK callbacks.
+            mailbox_cv.wait_for(lock, stoken, 2s,
+                                [&] { return mailbox_generation != applied_generation; });
+            if (mailbox_generation != applied_generation) {
+                applied_generation = mailbox_generation;
+                status = mailbox_status;
+                game = mailbox_game;
+                has_update = true;
+            }
+        }
+        if (stoken.stop_requested()) {
+            break;
+        }
 
-    Discord_UpdatePresence(&rpc);
+        if (has_update) {
+            DiscordRichPresence rpc{};
+            if (status == Discord::RPCStatus::Playing) {
+                rpc.details = "Playing a game";
+                rpc.state = game.c_str();
+            } else {
+                rpc.details = "Idle";
+            }
+            rpc.largeImageKey = "shadps4";
+            rpc.largeImageText = "ShadPS4 is a PS4 emulator";
+            rpc.startTimestamp = startTimestamp;
+
+            Discord_UpdatePresence(&rpc);
+        }
+        Discord_RunCallbacks();
+    }
 }
 
 void RPC::stop() {
     if (enabled) {
         enabled = false;
+        presence_thread.request_stop();
+        if (presence_thread.joinable()) {
+            presence_thread.join();
+        }
         Discord_ClearPresence();
         Discord_Shutdown();
     }
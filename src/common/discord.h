@@ -3,8 +3,11 @@
 
 #pragma once
 
+#include <condition_variable>
 #include <cstdint>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <discord_rpc.h>
 
 namespace Discord {
@@ -18,6 +21,18 @@ class RPC {
     std::uint64_t startTimestamp;
     bool enabled = false;
 
+    // Latest-wins mailbox: update() only stores the newest state and bumps the
+    // generation; every SDK call happens on the presence thread, so a network
+    // stall inside the Discord library can never block an emulator path.
+    std::mutex mailbox_mutex;
+    std::condition_variable_any mailbox_cv;
+    std::uint64_t mailbox_generation = 0;
+    RPCStatus mailbox_status = RPCStatus::Idling;
+    std::string mailbox_game;
+    std::jthread presence_thread;
+
+    void worker(std::stop_token stoken);
+
 public:
     void init();
     void update(RPCStatus status, const std::string& title);
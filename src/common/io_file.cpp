@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <cstring>
 #include <vector>
 
 #include "common/alignment.h"
@@ -157,6 +159,11 @@ IOFile::IOFile(IOFile&& other) noexcept {
     std::swap(file_access_mode, other.file_access_mode);
     std::swap(file_type, other.file_type);
     std::swap(file, other.file);
+    std::swap(read_buffered, other.read_buffered);
+    std::swap(read_buffer, other.read_buffer);
+    std::swap(buffer_file_offset, other.buffer_file_offset);
+    std::swap(buffer_valid, other.buffer_valid);
+    std::swap(buffer_pos, other.buffer_pos);
 }
 
 IOFile& IOFile::operator=(IOFile&& other) noexcept {
@@ -164,6 +171,11 @@ IOFile& IOFile::operator=(IOFile&& other) noexcept {
     std::swap(file_access_mode, other.file_access_mode);
     std::swap(file_type, other.file_type);
     std::swap(file, other.file);
+    std::swap(read_buffered, other.read_buffered);
+    std::swap(read_buffer, other.read_buffer);
+    std::swap(buffer_file_offset, other.buffer_file_offset);
+    std::swap(buffer_valid, other.buffer_valid);
+    std::swap(buffer_pos, other.buffer_pos);
     return *this;
 }
 
@@ -208,6 +220,10 @@ void IOFile::Close() {
     }
 
     file = nullptr;
+    read_buffered = false;
+    buffer_file_offset = 0;
+    buffer_valid = 0;
+    buffer_pos = 0;
 
 #ifdef _WIN64
     if (file_mapping) {
@@ -234,6 +250,58 @@ uintptr_t IOFile::GetFileMapping() {
 #endif
 }
 
+void IOFile::SetReadBuffered(bool enabled) {
+    if (read_buffered == enabled) {
+        return;
+    }
+
+    if (!enabled && IsOpen() && buffer_pos != buffer_valid) {
+        // Put the host position back on the logical one before dropping the window.
+        fseeko(file, -static_cast<s64>(buffer_valid - buffer_pos), SEEK_CUR);
+    }
+
+    read_buffered = enabled;
+    buffer_file_offset = 0;
+    buffer_valid = 0;
+    buffer_pos = 0;
+}
+
+size_t IOFile::ReadBuffered(void* data, size_t bytes) const {
+    u8* out = static_cast<u8*>(data);
+    size_t total_read = 0;
+
+    // Drain whatever the window already holds.
+    if (const size_t unread = buffer_valid - buffer_pos; unread != 0) {
+        const size_t copy_size = std::min(unread, bytes);
+        std::memcpy(out, read_buffer.data() + buffer_pos, copy_size);
+        buffer_pos += copy_size;
+        out += copy_size;
+        bytes -= copy_size;
+        total_read += copy_size;
+    }
+
+    if (bytes == 0) {
+        return total_read;
+    }
+
+    // Window-sized reads and larger go straight to the host; staging them
+    // through the buffer would only add a copy.
+    if (bytes >= ReadBufferSize) {
+        buffer_file_offset = 0;
+        buffer_valid = 0;
+        buffer_pos = 0;
+        return total_read + std::fread(out, 1, bytes, file);
+    }
+
+    read_buffer.resize(ReadBufferSize);
+    buffer_file_offset = static_cast<u64>(ftello(file));
+    buffer_valid = std::fread(read_buffer.data(), 1, ReadBufferSize, file);
+    buffer_pos = std::min(bytes, buffer_valid);
+    std::memcpy(out, read_buffer.data(), buffer_pos);
+
+    return total_read + buffer_pos;
+}
+
 std::string IOFile::ReadString(size_t length) const {
     std::vector<char> string_buffer(length);
 
@@ -335,6 +403,24 @@ bool IOFile::Seek(s64 offset, SeekOrigin origin) const {
         return false;
     }
 
+    if (buffer_valid != 0) {
+        // Seeks landing inside the prefetched window just move within it.
+        if (origin == SeekOrigin::SetOrigin && offset >= 0 &&
+            static_cast<u64>(offset) >= buffer_file_offset &&
+            static_cast<u64>(offset) <= buffer_file_offset + buffer_valid) {
+            buffer_pos = static_cast<size_t>(static_cast<u64>(offset) - buffer_file_offset);
+            return true;
+        }
+        // The host position sits at the end of the window, so relative seeks
+        // must be resolved against the logical position instead.
+        if (origin == SeekOrigin::CurrentPosition) {
+            offset -= static_cast<s64>(buffer_valid - buffer_pos);
+        }
+        buffer_file_offset = 0;
+        buffer_valid = 0;
+        buffer_pos = 0;
+    }
+
     errno = 0;
 
     const auto seek_result = fseeko(file, offset, ToSeekOrigin(origin)) == 0;
@@ -356,7 +442,7 @@ s64 IOFile::Tell() const {
 
     errno = 0;
 
-    return ftello(file);
+    return ftello(file) - static_cast<s64>(buffer_valid - buffer_pos);
 }
 
 } // namespace Common::FS
@@ -7,6 +7,7 @@
 #include <filesystem>
 #include <span>
 #include <type_traits>
+#include <vector>
 
 #include "common/concepts.h"
 #include "common/types.h"
@@ -116,6 +117,15 @@ public:
     bool Seek(s64 offset, SeekOrigin origin = SeekOrigin::SetOrigin) const;
     s64 Tell() const;
 
+    /**
+     * Enables a 64 KB read-ahead window so runs of small reads (header and
+     * table parsing) are served from memory instead of one host read each.
+     * Reads of a full window or more bypass the buffer, and seeks landing
+     * inside the prefetched range just move within it. Only meaningful for
+     * files opened for reading; Tell/Seek semantics are unchanged.
+     */
+    void SetReadBuffered(bool enabled);
+
     template <typename T>
     size_t Read(T& data) const {
         if constexpr (IsContiguousContainer<T>) {
@@ -154,6 +164,9 @@ public:
 
     template <typename T>
     size_t ReadRaw(void* data, size_t size) const {
+        if (read_buffered) {
+            return ReadBuffered(data, size * sizeof(T)) / sizeof(T);
+        }
         return std::fread(data, sizeof(T), size, file);
     }
 
@@ -177,7 +190,7 @@ public:
             return false;
         }
 
-        return std::fread(&object, sizeof(T), 1, file) == 1;
+        return ReadRaw<T>(&object, 1) == 1;
     }
 
     template <typename T>
@@ -209,12 +222,25 @@ public:
     }
 
 private:
+    size_t ReadBuffered(void* data, size_t bytes) const;
+
+    static constexpr size_t ReadBufferSize = 64_KB;
+
     std::filesystem::path file_path;
     FileAccessMode file_access_mode{};
     FileType file_type{};
 
     std::FILE* file = nullptr;
     uintptr_t file_mapping = 0;
+
+    // Read-ahead state; reads are const so the window is mutable. The host
+    // position sits at the end of the valid window, the logical position at
+    // buffer_file_offset + buffer_pos.
+    bool read_buffered = false;
+    mutable std::vector<u8> read_buffer;
+    mutable u64 buffer_file_offset = 0;
+    mutable size_t buffer_valid = 0;
+    mutable size_t buffer_pos = 0;
 };
 
 } // namespace Common::FS
@@ -1,9 +1,15 @@
 // SPDX-FileCopyrightText: Copyright 2014 Citra Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <filesystem>
+#include <memory>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -11,7 +17,6 @@
 #include <windows.h> // For OutputDebugStringW
 #endif
 
-#include "common/bounded_threadsafe_queue.h"
 #include "common/config.h"
 #include "common/debug.h"
 #include "common/io_file.h"
@@ -20,6 +25,7 @@
 #include "common/logging/log_entry.h"
 #include "common/logging/text_formatter.h"
 #include "common/path_util.h"
+#include "common/polyfill_thread.h"
 #include "common/string_util.h"
 #include "common/thread.h"
 
@@ -118,6 +124,58 @@ public:
 
 bool initialization_in_progress_suppress_logging = true;
 
+/// A log message with formatting deferred to the backend thread.
+struct RawEntry {
+    std::chrono::microseconds timestamp;
+    Class log_class{};
+    Level log_level{};
+    const char* filename = nullptr;
+    u32 line_num = 0;
+    const char* function = nullptr;
+    const char* format = nullptr;
+    FmtArgStore args;
+};
+
+/**
+ * Single-producer single-consumer ring of raw entries. Each logging thread owns
+ * one as producer; the backend thread is the only consumer, so pushes are a store
+ * and an index publish with no locks or waits.
+ */
+class ThreadRing {
+    static constexpr u64 Capacity = 1024;
+
+public:
+    bool TryPush(RawEntry&& entry) {
+        const u64 head = head_idx.load(std::memory_order_relaxed);
+        if (head - tail_idx.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+        slots[head % Capacity] = std::move(entry);
+        head_idx.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool TryPop(RawEntry& entry) {
+        const u64 tail = tail_idx.load(std::memory_order_relaxed);
+        if (tail == head_idx.load(std::memory_order_acquire)) {
+            return false;
+        }
+        entry = std::move(slots[tail % Capacity]);
+        tail_idx.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool Empty() const {
+        return head_idx.load(std::memory_order_acquire) ==
+               tail_idx.load(std::memory_order_acquire);
+    }
+
+private:
+    std::array<RawEntry, Capacity> slots{};
+    std::atomic<u64> head_idx{};
+    std::atomic<u64> tail_idx{};
+};
+
 /**
  * Static state as a singleton.
  */
@@ -166,11 +224,20 @@ public:
         color_console_backend.SetEnabled(enabled);
     }
 
+    bool ShouldLog(Class log_class, Level log_level) const {
+        if (filter.CheckMessage(log_class, log_level)) {
+            return true;
+        }
+        // Important messages are still propagated to an attached profiler.
+        return log_level >= Level::Warning && IsProfilerConnected();
+    }
+
     void PushEntry(Class log_class, Level log_level, const char* filename, unsigned int line_num,
-                   const char* function, std::string message) {
+                   const char* function, const char* format, FmtArgStore&& args) {
         // Propagate important log messages to the profiler
-        if (IsProfilerConnected()) {
-            const auto& msg_str = std::format("[{}] {}", GetLogClassName(log_class), message);
+        if (log_level >= Level::Warning && IsProfilerConnected()) {
+            const auto& msg_str =
+                fmt::format("[{}] {}", GetLogClassName(log_class), fmt::vformat(format, args));
             switch (log_level) {
             case Level::Warning:
                 TRACE_WARN(msg_str);
@@ -194,21 +261,22 @@ public:
         using std::chrono::microseconds;
         using std::chrono::steady_clock;
 
-        const Entry entry = {
+        RawEntry entry = {
             .timestamp = duration_cast<microseconds>(steady_clock::now() - time_origin),
             .log_class = log_class,
             .log_level = log_level,
             .filename = filename,
             .line_num = line_num,
             .function = function,
-            .message = std::move(message),
+            .format = format,
+            .args = std::move(args),
         };
-        if (Config::getLogType() == "async") {
-            message_queue.EmplaceWait(entry);
-        } else {
-            ForEachBackend([&entry](auto& backend) { backend.Write(entry); });
+        // Fault storms (e.g. unmapped reads) repeat one callsite millions of times and
+        // can saturate even the async backend. Criticals always pass.
+        if (log_level < Level::Critical && !FloodControl(entry)) {
+            return;
         }
-        std::fflush(stdout);
+        Dispatch(std::move(entry));
     }
 
 private:
@@ -217,25 +285,185 @@ private:
 
     ~Impl() = default;
 
+    /// Hands a raw entry to the backend thread, or writes it inline in sync mode.
+    void Dispatch(RawEntry&& entry) {
+        if (Config::getLogType() == "async") {
+            // Push into this thread's ring; the backend thread formats and writes.
+            auto& ring = GetThreadRing();
+            while (!ring.TryPush(std::move(entry))) {
+                // The ring is full; the backend thread is already awake draining it.
+                std::this_thread::yield();
+            }
+            if (num_pending.fetch_add(1, std::memory_order_release) == 0) {
+                std::scoped_lock wake_lock{wake_mutex};
+                wake_cv.notify_one();
+            }
+        } else {
+            const Entry formatted = FormatEntry(entry);
+            ForEachBackend([&formatted](auto& backend) { backend.Write(formatted); });
+            std::fflush(stdout);
+        }
+    }
+
+    /// Formats a raw entry into the structured form the backends consume.
+    static Entry FormatEntry(const RawEntry& raw) {
+        return Entry{
+            .timestamp = raw.timestamp,
+            .log_class = raw.log_class,
+            .log_level = raw.log_level,
+            .filename = raw.filename,
+            .line_num = raw.line_num,
+            .function = raw.function,
+            .message = fmt::vformat(raw.format, raw.args),
+        };
+    }
+
+    /// Per-callsite burst budget per suppression window before dedup kicks in.
+    static constexpr u32 CallsiteBurst = 128;
+    static constexpr u64 CallsiteWindowUs = 1'000'000;
+    /// Global token bucket: bounded burst, sustained refill rate in messages/second.
+    static constexpr s64 BucketCapacity = 8192;
+    static constexpr s64 BucketRefillPerSec = 2000;
+
+    /// Suppression state for one callsite, identified by its format string literal.
+    /// All fields are racy-by-design relaxed atomics; a miscounted message or two
+    /// during a storm does not matter, bounding the flood does.
+    struct CallsiteState {
+        std::atomic<const char*> key{};
+        std::atomic<u64> window_start_us{};
+        std::atomic<u32> count{};
+        std::atomic<u32> suppressed{};
+    };
+
+    /**
+     * Decides whether an entry may be emitted. Repeated messages from one callsite
+     * beyond CallsiteBurst per window are counted and replaced by a single summary
+     * line when the window rolls over; on top of that a global token bucket caps the
+     * sustained rate across all callsites so pathological floods cost bounded IO.
+     */
+    bool FloodControl(const RawEntry& entry) {
+        const u64 now_us = static_cast<u64>(entry.timestamp.count());
+
+        // Refill the global bucket and report drops once the storm subsides.
+        const u64 last_refill = bucket_refill_us.load(std::memory_order_relaxed);
+        const s64 refill =
+            static_cast<s64>((now_us - last_refill) * BucketRefillPerSec / 1'000'000);
+        if (refill > 0) {
+            u64 expected = last_refill;
+            if (bucket_refill_us.compare_exchange_strong(expected, now_us,
+                                                         std::memory_order_relaxed)) {
+                s64 tokens = bucket_tokens.load(std::memory_order_relaxed);
+                while (!bucket_tokens.compare_exchange_weak(
+                    tokens, std::min(tokens + refill, BucketCapacity),
+                    std::memory_order_relaxed)) {
+                }
+                const u64 dropped = bucket_dropped.exchange(0, std::memory_order_relaxed);
+                if (dropped != 0) {
+                    EmitSummary(entry, "(flood control) rate limit dropped {} messages",
+                                dropped);
+                }
+            }
+        }
+
+        // Per-callsite dedup. Collisions in the fixed table fall through unsuppressed.
+        const uintptr_t key = reinterpret_cast<uintptr_t>(entry.format);
+        auto& slot = callsites[((key >> 4) ^ entry.line_num) % callsites.size()];
+        if (slot.key.load(std::memory_order_relaxed) != entry.format) {
+            // Claim the slot once its current owner has gone quiet for a window.
+            if (now_us - slot.window_start_us.load(std::memory_order_relaxed) >=
+                CallsiteWindowUs) {
+                slot.window_start_us.store(now_us, std::memory_order_relaxed);
+                slot.count.store(0, std::memory_order_relaxed);
+                slot.suppressed.store(0, std::memory_order_relaxed);
+                slot.key.store(entry.format, std::memory_order_relaxed);
+            }
+        } else if (now_us - slot.window_start_us.load(std::memory_order_relaxed) >=
+                   CallsiteWindowUs) {
+            slot.window_start_us.store(now_us, std::memory_order_relaxed);
+            slot.count.store(0, std::memory_order_relaxed);
+            const u32 suppressed = slot.suppressed.exchange(0, std::memory_order_relaxed);
+            if (suppressed != 0) {
+                EmitSummary(entry, "(flood control) previous message repeated {} more times",
+                            suppressed);
+            }
+        }
+        if (slot.key.load(std::memory_order_relaxed) == entry.format &&
+            slot.count.fetch_add(1, std::memory_order_relaxed) >= CallsiteBurst) {
+            slot.suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        // Charge the global bucket last so suppressed messages cost no tokens.
+        s64 tokens = bucket_tokens.load(std::memory_order_relaxed);
+        do {
+            if (tokens <= 0) {
+                bucket_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        } while (
+            !bucket_tokens.compare_exchange_weak(tokens, tokens - 1, std::memory_order_relaxed));
+        return true;
+    }
+
+    /// Emits a synthesized flood-control line attributed to the affected callsite.
+    void EmitSummary(const RawEntry& like, const char* format, u64 count) {
+        FmtArgStore args;
+        args.push_back(count);
+        Dispatch(RawEntry{
+            .timestamp = like.timestamp,
+            .log_class = like.log_class,
+            .log_level = like.log_level,
+            .filename = like.filename,
+            .line_num = like.line_num,
+            .function = like.function,
+            .format = format,
+            .args = std::move(args),
+        });
+    }
+
+    /// Returns the calling thread's ring, registering it on first use.
+    ThreadRing& GetThreadRing() {
+        thread_local std::shared_ptr<ThreadRing> ring = [this] {
+            auto new_ring = std::make_shared<ThreadRing>();
+            std::scoped_lock lock{ring_mutex};
+            rings.push_back(new_ring);
+            return new_ring;
+        }();
+        return *ring;
+    }
+
+    /// Drains every thread ring, returning the number of messages written.
+    u64 DrainRings() {
+        u64 drained = 0;
+        RawEntry entry;
+        std::scoped_lock lock{ring_mutex};
+        for (const auto& ring : rings) {
+            while (ring->TryPop(entry)) {
+                const Entry formatted = FormatEntry(entry);
+                ForEachBackend([&formatted](auto& backend) { backend.Write(formatted); });
+                drained++;
+            }
+        }
+        // Drop rings whose producer thread has exited and left nothing behind.
+        std::erase_if(rings, [](const auto& ring) { return ring.use_count() == 1 && ring->Empty(); });
+        return drained;
+    }
+
     void StartBackendThread() {
         backend_thread = std::jthread([this](std::stop_token stop_token) {
             Common::SetCurrentThreadName("shadPS4:Log");
-            Entry entry;
-            const auto write_logs = [this, &entry]() {
-                ForEachBackend([&entry](auto& backend) { backend.Write(entry); });
-            };
+            Common::SetCurrentThreadRole(Common::ThreadRole::Logging);
             while (!stop_token.stop_requested()) {
-                message_queue.PopWait(entry, stop_token);
-                if (entry.filename != nullptr) {
-                    write_logs();
+                {
+                    std::unique_lock lock{wake_mutex};
+                    Common::CondvarWait(wake_cv, lock, stop_token, [this] {
+                        return num_pending.load(std::memory_order_acquire) != 0;
+                    });
                 }
+                num_pending.fetch_sub(DrainRings(), std::memory_order_release);
             }
-            // Drain the logging queue. Only writes out up to MAX_LOGS_TO_WRITE to prevent a
-            // case where a system is repeatedly spamming logs even on close.
-            int max_logs_to_write = filter.IsDebug() ? std::numeric_limits<s32>::max() : 100;
-            while (max_logs_to_write-- && message_queue.TryPop(entry)) {
-                write_logs();
-            }
+            // Drain anything the producers managed to push before the stop request.
+            DrainRings();
         });
     }
 
@@ -265,7 +493,16 @@ private:
     ColorConsoleBackend color_console_backend{};
     FileBackend file_backend;
 
-    MPSCQueue<Entry> message_queue{};
+    std::array<CallsiteState, 512> callsites{};
+    std::atomic<s64> bucket_tokens{BucketCapacity};
+    std::atomic<u64> bucket_refill_us{};
+    std::atomic<u64> bucket_dropped{};
+
+    std::mutex ring_mutex;
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+    std::atomic<u64> num_pending{};
+    std::mutex wake_mutex;
+    std::condition_variable_any wake_cv;
     std::chrono::steady_clock::time_point time_origin{std::chrono::steady_clock::now()};
     std::jthread backend_thread;
 };
@@ -291,12 +528,19 @@ void SetColorConsoleBackendEnabled(bool enabled) {
     Impl::Instance().SetColorConsoleBackendEnabled(enabled);
 }
 
+bool ShouldLog(Class log_class, Level log_level) {
+    if (initialization_in_progress_suppress_logging) [[unlikely]] {
+        return false;
+    }
+    return Impl::Instance().ShouldLog(log_class, log_level);
+}
+
 void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
                        unsigned int line_num, const char* function, const char* format,
-                       const fmt::format_args& args) {
+                       FmtArgStore&& args) {
     if (!initialization_in_progress_suppress_logging) [[likely]] {
-        Impl::Instance().PushEntry(log_class, log_level, filename, line_num, function,
-                                   fmt::vformat(format, args));
+        Impl::Instance().PushEntry(log_class, log_level, filename, line_num, function, format,
+                                   std::move(args));
     }
 }
 } // namespace Common::Log
@@ -7,6 +7,8 @@
 #include <array>
 #include <string_view>
 
+#include <fmt/args.h>
+
 #include "common/logging/formatter.h"
 #include "common/logging/types.h"
 
@@ -20,16 +22,75 @@ constexpr const char* TrimSourcePath(std::string_view source) {
     return source.data() + idx;
 }
 
-/// Logs a message to the global logger, using fmt
+/// Argument store that owns copies of the format arguments so formatting can be deferred.
+using FmtArgStore = fmt::dynamic_format_arg_store<fmt::format_context>;
+
+// Compile-time log floor. Statements below it vanish entirely: the gate is
+// evaluated before the call is instantiated, so neither the runtime filter
+// check nor the argument copies survive into the binary. The default keeps
+// Trace debug-only as before; builds can raise the floor further with
+// -DSHADPS4_LOG_MIN_LEVEL=<numeric Level value>.
+#ifndef SHADPS4_LOG_MIN_LEVEL
+#ifdef _DEBUG
+#define SHADPS4_LOG_MIN_LEVEL 0
+#else
+#define SHADPS4_LOG_MIN_LEVEL 1
+#endif
+#endif
+
+/// Minimum level compiled in for a class. Hot-path classes log per PM4 packet
+/// or per syscall, so their verbose statements are only kept in debug builds.
+constexpr Level MinimumLevel(Class log_class) {
+    constexpr Level build_floor{static_cast<Level>(SHADPS4_LOG_MIN_LEVEL)};
+    switch (log_class) {
+    case Class::Render:
+    case Class::Kernel:
+    case Class::Kernel_Pthread:
+    case Class::Kernel_Fs:
+    case Class::Kernel_Vmm:
+    case Class::Kernel_Event:
+    case Class::Kernel_Sce:
+    case Class::Lib_Kernel:
+    case Class::Lib_GnmDriver:
+#ifdef _DEBUG
+        return build_floor;
+#else
+        return std::max(build_floor, Level::Info);
+#endif
+    default:
+        return build_floor;
+    }
+}
+
+/// Checks whether a message of the given class and level would be emitted at all.
+bool ShouldLog(Class log_class, Level log_level);
+
+/// Logs a message to the global logger; formatting happens on the backend thread.
 void FmtLogMessageImpl(Class log_class, Level log_level, const char* filename,
                        unsigned int line_num, const char* function, const char* format,
-                       const fmt::format_args& args);
+                       FmtArgStore&& args);
 
 template <typename... Args>
 void FmtLogMessage(Class log_class, Level log_level, const char* filename, unsigned int line_num,
                    const char* function, const char* format, const Args&... args) {
+    if (!ShouldLog(log_class, log_level)) {
+        return;
+    }
+    // The store deep-copies strings, so formatting can safely happen off-thread.
+    FmtArgStore store;
+    (store.push_back(args), ...);
     FmtLogMessageImpl(log_class, log_level, filename, line_num, function, format,
-                      fmt::make_format_args(args...));
+                      std::move(store));
+}
+
+/// Statically gated entry point used by the LOG_* macros; when the level is
+/// below the compile-time floor for the class the whole call folds away.
+template <Class log_class, Level log_level, typename... Args>
+void FmtLogMessage(const char* filename, unsigned int line_num, const char* function,
+                   const char* format, const Args&... args) {
+    if constexpr (log_level >= MinimumLevel(log_class)) {
+        FmtLogMessage(log_class, log_level, filename, line_num, function, format, args...);
+    }
 }
 
 } // namespace Common::Log
@@ -39,32 +100,23 @@ void FmtLogMessage(Class log_class, Level log_level, const char* filename, unsig
     Common::Log::FmtLogMessage(log_class, log_level, Common::Log::TrimSourcePath(__FILE__),        \
                                __LINE__, __func__, __VA_ARGS__)
 
-#ifdef _DEBUG
+// The class and level are template arguments so the compile-time floor can
+// discard the statement before any argument is evaluated.
 #define LOG_TRACE(log_class, ...)                                                                  \
-    Common::Log::FmtLogMessage(Common::Log::Class::log_class, Common::Log::Level::Trace,           \
-                               Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__,          \
-                               __VA_ARGS__)
-#else
-#define LOG_TRACE(log_class, fmt, ...) (void(0))
-#endif
-
+    Common::Log::FmtLogMessage<Common::Log::Class::log_class, Common::Log::Level::Trace>(          \
+        Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__, __VA_ARGS__)
 #define LOG_DEBUG(log_class, ...)                                                                  \
-    Common::Log::FmtLogMessage(Common::Log::Class::log_class, Common::Log::Level::Debug,           \
-                               Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__,          \
-                               __VA_ARGS__)
+    Common::Log::FmtLogMessage<Common::Log::Class::log_class, Common::Log::Level::Debug>(          \
+        Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__, __VA_ARGS__)
 #define LOG_INFO(log_class, ...)                                                                   \
-    Common::Log::FmtLogMessage(Common::Log::Class::log_class, Common::Log::Level::Info,            \
-                               Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__,          \
-                               __VA_ARGS__)
+    Common::Log::FmtLogMessage<Common::Log::Class::log_class, Common::Log::Level::Info>(           \
+        Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__, __VA_ARGS__)
 #define LOG_WARNING(log_class, ...)                                                                \
-    Common::Log::FmtLogMessage(Common::Log::Class::log_class, Common::Log::Level::Warning,         \
-                               Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__,          \
-                               __VA_ARGS__)
+    Common::Log::FmtLogMessage<Common::Log::Class::log_class, Common::Log::Level::Warning>(        \
+        Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__, __VA_ARGS__)
 #define LOG_ERROR(log_class, ...)                                                                  \
-    Common::Log::FmtLogMessage(Common::Log::Class::log_class, Common::Log::Level::Error,           \
-                               Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__,          \
-                               __VA_ARGS__)
+    Common::Log::FmtLogMessage<Common::Log::Class::log_class, Common::Log::Level::Error>(          \
+        Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__, __VA_ARGS__)
 #define LOG_CRITICAL(log_class, ...)                                                               \
-    Common::Log::FmtLogMessage(Common::Log::Class::log_class, Common::Log::Level::Critical,        \
-                               Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__,          \
-                               __VA_ARGS__)
+    Common::Log::FmtLogMessage<Common::Log::Class::log_class, Common::Log::Level::Critical>(       \
+        Common::Log::TrimSourcePath(__FILE__), __LINE__, __func__, __VA_ARGS__)
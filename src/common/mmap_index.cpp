@@ -0,0 +1,218 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include "common/logging/log.h"
+#include "common/mmap_index.h"
+
+#ifdef _WIN64
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Common {
+
+namespace {
+
+struct IndexHeader {
+    u32 magic;
+    u32 version;
+    u32 capacity;
+    u32 user_tag;
+};
+
+struct IndexSlot {
+    u64 hash;
+    u64 offset;
+    u32 length;
+    u32 ready;
+};
+
+constexpr u32 IndexMagic = 0x58444D4D; // 'MMDX'
+constexpr u32 IndexVersion = 1;
+
+} // Anonymous namespace
+
+MmapIndex::~MmapIndex() {
+    Close();
+}
+
+bool MmapIndex::Open(const std::filesystem::path& path, u32 capacity, u32 user_tag) {
+    Close();
+
+    capacity = std::bit_ceil(std::max(capacity, 2U));
+    const size_t size = sizeof(IndexHeader) + sizeof(IndexSlot) * capacity;
+
+    // Validate an existing file before mapping it; a stale layout or a different
+    // record format (user_tag) throws the whole index away. Concurrent creation
+    // is benign as every creator writes the identical header and zeroed slots.
+    bool create = true;
+    std::error_code ec;
+    if (std::filesystem::file_size(path, ec) == size && !ec) {
+        create = false;
+    }
+
+#ifdef _WIN64
+    file_handle = CreateFileW(path.native().c_str(), GENERIC_READ | GENERIC_WRITE,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_ALWAYS,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_handle == INVALID_HANDLE_VALUE) {
+        file_handle = nullptr;
+        return false;
+    }
+    mapping_handle = CreateFileMappingW(file_handle, nullptr, PAGE_READWRITE, 0,
+                                        static_cast<DWORD>(size), nullptr);
+    if (!mapping_handle) {
+        Close();
+        return false;
+    }
+    map = static_cast<u8*>(MapViewOfFile(mapping_handle, FILE_MAP_ALL_ACCESS, 0, 0, size));
+#else
+    fd = open(path.string().c_str(), O_RDWR | O_CREAT, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        Close();
+        return false;
+    }
+    map = static_cast<u8*>(mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+    if (map == MAP_FAILED) {
+        map = nullptr;
+    }
+#endif
+    if (!map) {
+        Close();
+        return false;
+    }
+    map_size = size;
+
+    auto* header = reinterpret_cast<IndexHeader*>(map);
+    if (create) {
+        const IndexHeader init{
+            .magic = IndexMagic,
+            .version = IndexVersion,
+            .capacity = capacity,
+            .user_tag = user_tag,
+        };
+        std::memcpy(header, &init, sizeof(init));
+    } else if (header->magic != IndexMagic || header->version != IndexVersion ||
+               header->capacity != capacity || header->user_tag != user_tag) {
+        LOG_INFO(Common, "Discarding index {} with incompatible layout", path.string());
+        std::memset(map, 0, map_size);
+        const IndexHeader init{
+            .magic = IndexMagic,
+            .version = IndexVersion,
+            .capacity = capacity,
+            .user_tag = user_tag,
+        };
+        std::memcpy(header, &init, sizeof(init));
+    }
+
+    slots = map + sizeof(IndexHeader);
+    num_slots = capacity;
+    return true;
+}
+
+void MmapIndex::Close() {
+    if (map) {
+#ifdef _WIN64
+        FlushViewOfFile(map, map_size);
+        UnmapViewOfFile(map);
+#else
+        msync(map, map_size, MS_ASYNC);
+        munmap(map, map_size);
+#endif
+        map = nullptr;
+    }
+#ifdef _WIN64
+    if (mapping_handle) {
+        CloseHandle(mapping_handle);
+        mapping_handle = nullptr;
+    }
+    if (file_handle) {
+        CloseHandle(file_handle);
+        file_handle = nullptr;
+    }
+#else
+    if (fd >= 0) {
+        close(fd);
+        fd = -1;
+    }
+#endif
+    map_size = 0;
+    slots = nullptr;
+    num_slots = 0;
+}
+
+bool MmapIndex::ReadSlot(u32 index, u64* hash, u64* offset, u32* length) const {
+    auto& slot = static_cast<IndexSlot*>(slots)[index];
+    if (std::atomic_ref{slot.ready}.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+    *hash = std::atomic_ref{slot.hash}.load(std::memory_order_relaxed);
+    *offset = slot.offset;
+    *length = slot.length;
+    return true;
+}
+
+bool MmapIndex::Lookup(u64 hash, u64* offset, u32* length) const {
+    if (!slots) {
+        return false;
+    }
+    // Zero marks an empty slot, so remap the (vanishingly unlikely) zero hash.
+    hash = std::max<u64>(hash, 1);
+    const u32 mask = num_slots - 1;
+    for (u32 i = 0; i < num_slots; i++) {
+        auto& slot = static_cast<IndexSlot*>(slots)[(hash + i) & mask];
+        const u64 slot_hash = std::atomic_ref{slot.hash}.load(std::memory_order_acquire);
+        if (slot_hash == 0) {
+            return false;
+        }
+        if (slot_hash != hash) {
+            continue;
+        }
+        // A claimed but not yet published slot counts as absent; the record it
+        // points at may still be mid-write in the data file.
+        if (std::atomic_ref{slot.ready}.load(std::memory_order_acquire) == 0) {
+            return false;
+        }
+        *offset = slot.offset;
+        *length = slot.length;
+        return true;
+    }
+    return false;
+}
+
+bool MmapIndex::Insert(u64 hash, u64 offset, u32 length) {
+    if (!slots) {
+        return false;
+    }
+    hash = std::max<u64>(hash, 1);
+    const u32 mask = num_slots - 1;
+    for (u32 i = 0; i < num_slots; i++) {
+        auto& slot = static_cast<IndexSlot*>(slots)[(hash + i) & mask];
+        std::atomic_ref hash_ref{slot.hash};
+        u64 expected = 0;
+        if (hash_ref.compare_exchange_strong(expected, hash, std::memory_order_acq_rel)) {
+            slot.offset = offset;
+            slot.length = length;
+            std::atomic_ref{slot.ready}.store(1, std::memory_order_release);
+            return true;
+        }
+        if (expected == hash) {
+            // Another writer (possibly in another process) beat us to it.
+            return true;
+        }
+    }
+    LOG_WARNING(Common, "Mapped index is full, dropping record");
+    return false;
+}
+
+} // namespace Common
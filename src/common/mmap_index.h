@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include "common/types.h"
+
+namespace Common {
+
+/**
+ * Fixed-capacity open-addressing hash index memory-mapped from a file. Each
+ * slot publishes a (hash -> offset, length) record pointing into a companion
+ * data file, so a lookup is a few page-fault-cheap probes instead of a
+ * directory scan or a sequential file parse.
+ *
+ * The on-disk layout is safe for concurrent writers sharing the file (e.g.
+ * over NFS): a writer claims a slot by atomically swinging its hash from zero,
+ * fills in offset and length, then release-stores a ready flag. Readers only
+ * observe records whose ready flag is set, so a torn or in-flight insert is
+ * indistinguishable from an absent one. Entries are never removed; a layout
+ * change is signalled through user_tag, which invalidates the whole file.
+ */
+class MmapIndex {
+public:
+    MmapIndex() = default;
+    ~MmapIndex();
+
+    MmapIndex(const MmapIndex&) = delete;
+    MmapIndex& operator=(const MmapIndex&) = delete;
+
+    /// Maps the index at path, creating or recreating it when missing, truncated
+    /// or carrying a different user_tag. Capacity is rounded up to a power of two.
+    bool Open(const std::filesystem::path& path, u32 capacity, u32 user_tag);
+
+    /// Unmaps and flushes the file; the object can be reopened afterwards.
+    void Close();
+
+    bool IsOpen() const {
+        return slots != nullptr;
+    }
+
+    /// Probes for hash and returns its published record, or false when absent.
+    bool Lookup(u64 hash, u64* offset, u32* length) const;
+
+    /// Publishes (hash -> offset, length). Returns false only when the table is
+    /// full; an already present hash (ours or another writer's) is a success.
+    bool Insert(u64 hash, u64 offset, u32 length);
+
+    /// Invokes func(hash, offset, length) for every published record.
+    template <typename Func>
+    void ForEach(Func&& func) const {
+        for (u32 i = 0; i < num_slots; i++) {
+            u64 offset{};
+            u32 length{};
+            u64 hash{};
+            if (ReadSlot(i, &hash, &offset, &length)) {
+                func(hash, offset, length);
+            }
+        }
+    }
+
+private:
+    bool ReadSlot(u32 index, u64* hash, u64* offset, u32* length) const;
+
+    u8* map{};
+    size_t map_size{};
+    void* slots{};
+    u32 num_slots{};
+#ifdef _WIN64
+    void* file_handle{};
+    void* mapping_handle{};
+#else
+    int fd{-1};
+#endif
+};
+
+} // namespace Common
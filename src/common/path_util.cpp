@@ -1,7 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
-#include <unordered_map>
+#include <array>
 #include "common/logging/log.h"
 #include "common/path_util.h"
 
@@ -19,13 +19,16 @@ namespace Common::FS {
 
 namespace fs = std::filesystem;
 
-static auto UserPaths = [] {
-    std::unordered_map<PathType, fs::path> paths;
+// The roots are derived once and only replaced through SetUserPath or
+// ResetUserPaths; lookups index the array directly, with no hashing and no
+// per-call allocation.
+static std::array<fs::path, NumPathTypes> BuildUserPaths() {
+    std::array<fs::path, NumPathTypes> paths;
     const auto user_dir = std::filesystem::current_path() / PORTABLE_DIR;
 
     const auto create_path = [&](PathType shad_path, const fs::path& new_path) {
         std::filesystem::create_directory(new_path);
-        paths.insert_or_assign(shad_path, new_path);
+        paths[static_cast<std::size_t>(shad_path)] = new_path;
     };
 
     create_path(PathType::UserDir, user_dir);
@@ -39,7 +42,9 @@ static auto UserPaths = [] {
     create_path(PathType::SysModuleDir, user_dir / SYSMODULES_DIR);
 
     return paths;
-}();
+}
+
+static std::array<fs::path, NumPathTypes> UserPaths = BuildUserPaths();
 
 bool ValidatePath(const fs::path& path) {
     if (path.empty()) {
@@ -68,7 +73,7 @@ std::string PathToUTF8String(const std::filesystem::path& path) {
 }
 
 const fs::path& GetUserPath(PathType shad_path) {
-    return UserPaths.at(shad_path);
+    return UserPaths[static_cast<std::size_t>(shad_path)];
 }
 
 std::string GetUserPathString(PathType shad_path) {
@@ -82,7 +87,11 @@ void SetUserPath(PathType shad_path, const fs::path& new_path) {
         return;
     }
 
-    UserPaths.insert_or_assign(shad_path, new_path);
+    UserPaths[static_cast<std::size_t>(shad_path)] = new_path;
+}
+
+void ResetUserPaths() {
+    UserPaths = BuildUserPaths();
 }
 
 } // namespace Common::FS
@@ -19,6 +19,7 @@ enum class PathType {
     GameDataDir,    // Where game data is stored.
     SysModuleDir,   // Where system modules are stored.
 };
+constexpr std::size_t NumPathTypes = static_cast<std::size_t>(PathType::SysModuleDir) + 1;
 
 constexpr auto PORTABLE_DIR = "user";
 
@@ -84,4 +85,11 @@ constexpr auto LOG_FILE = "shad_log.txt";
  */
 void SetUserPath(PathType user_path, const std::filesystem::path& new_path);
 
+/**
+ * Recomputes every PathType root from the current working directory, creating
+ * missing directories. Call after switching portable mode so subsequent
+ * GetUserPath calls observe the new location.
+ */
+void ResetUserPaths();
+
 } // namespace Common::FS
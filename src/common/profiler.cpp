@@ -0,0 +1,139 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <fmt/format.h>
+#include "common/io_file.h"
+#include "common/profiler.h"
+#include "common/singleton.h"
+
+namespace Common {
+
+namespace {
+
+u64 MonotonicNS() {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+} // Anonymous namespace
+
+/**
+ * Fixed-size wrapping buffer of completed scopes. Only the owning thread writes,
+ * so recording is a couple of stores; old events are overwritten once full so the
+ * export always covers the most recent window of activity.
+ */
+class Profiler::ThreadRing {
+public:
+    static constexpr u64 Capacity = 16384;
+
+    /// Number of oldest events skipped at export time. Producers may still be
+    /// overwriting the tail of the window while a trace is being written.
+    static constexpr u64 OverwriteMargin = 64;
+
+    struct Event {
+        const char* name;
+        u64 start_ns;
+        u64 end_ns;
+    };
+
+    explicit ThreadRing(u32 thread_id_) : thread_id{thread_id_} {}
+
+    void Push(const char* name, u64 start_ns, u64 end_ns) {
+        const u64 head = head_idx.load(std::memory_order_relaxed);
+        slots[head % Capacity] = Event{name, start_ns, end_ns};
+        head_idx.store(head + 1, std::memory_order_release);
+    }
+
+    template <typename Func>
+    void ForEachEvent(Func&& func) const {
+        const u64 head = head_idx.load(std::memory_order_acquire);
+        const u64 count = std::min(head, Capacity);
+        const u64 begin = head - count + (count == Capacity ? OverwriteMargin : 0);
+        for (u64 i = begin; i < head; i++) {
+            func(slots[i % Capacity]);
+        }
+    }
+
+    u32 ThreadId() const {
+        return thread_id;
+    }
+
+private:
+    std::array<Event, Capacity> slots{};
+    std::atomic<u64> head_idx{};
+    u32 thread_id;
+};
+
+Profiler::Profiler() : time_origin{MonotonicNS()} {}
+
+Profiler::~Profiler() = default;
+
+u64 Profiler::Now() const {
+    return MonotonicNS() - time_origin;
+}
+
+Profiler::ThreadRing& Profiler::GetThreadRing() {
+    thread_local std::shared_ptr<ThreadRing> ring = [this] {
+        std::scoped_lock lock{ring_mutex};
+        auto new_ring = std::make_shared<ThreadRing>(static_cast<u32>(rings.size()));
+        rings.push_back(new_ring);
+        return new_ring;
+    }();
+    return *ring;
+}
+
+void Profiler::RecordScope(const char* name, u64 start_ns, u64 end_ns) {
+    GetThreadRing().Push(name, start_ns, end_ns);
+}
+
+Profiler::FrameStats Profiler::EndFrame() {
+    const u64 now = Now();
+    FrameStats stats{};
+    stats.frame_time_ms = static_cast<f64>(now - last_frame_end) / 1'000'000.0;
+    last_frame_end = now;
+    for (size_t i = 0; i < NumCounters; i++) {
+        const u64 current = counters[i].load(std::memory_order_relaxed);
+        stats.deltas[i] = current - last_counters[i];
+        last_counters[i] = current;
+    }
+    return stats;
+}
+
+bool Profiler::SaveTrace(const std::filesystem::path& path) {
+    FS::IOFile file{path, FS::FileAccessMode::Write, FS::FileType::TextFile};
+    if (!file.IsOpen()) {
+        return false;
+    }
+
+    std::string json = "[\n";
+    {
+        std::scoped_lock lock{ring_mutex};
+        for (const auto& ring : rings) {
+            ring->ForEachEvent([&](const ThreadRing::Event& event) {
+                fmt::format_to(std::back_inserter(json),
+                               "{{\"name\":\"{}\",\"ph\":\"X\",\"pid\":0,\"tid\":{},"
+                               "\"ts\":{:.3f},\"dur\":{:.3f}}},\n",
+                               event.name, ring->ThreadId(), event.start_ns / 1000.0,
+                               (event.end_ns - event.start_ns) / 1000.0);
+            });
+        }
+    }
+    if (json.ends_with(",\n")) {
+        json.resize(json.size() - 2);
+        json += '\n';
+    }
+    json += "]\n";
+    file.WriteString(json);
+    return true;
+}
+
+ProfilerScope::ProfilerScope(const char* name_)
+    : name{name_}, start{Singleton<Profiler>::Instance()->Now()} {}
+
+ProfilerScope::~ProfilerScope() {
+    auto* profiler = Singleton<Profiler>::Instance();
+    profiler->RecordScope(name, start, profiler->Now());
+}
+
+} // namespace Common
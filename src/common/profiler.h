@@ -0,0 +1,104 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "common/types.h"
+
+namespace Common {
+
+/**
+ * Lightweight built-in instrumentation layer. Scoped timers record into
+ * per-thread ring buffers that can be exported as chrome://tracing JSON, and
+ * frame counters feed the statistics line shown by the presenter.
+ */
+class Profiler {
+public:
+    enum class Counter : u32 {
+        DrawCalls,
+        DispatchCalls,
+        ImageCacheHits,
+        ImageCacheMisses,
+        ImagesEvicted,
+        ImageRefreshBytes,
+        ImageBcnPassthroughBytes,
+        ImageRefreshesSkipped,
+        ImageDetilesCpu,
+        ImageDetilesGpu,
+        ImageCpuWriteFaults,
+        PipelinesCompiled,
+        Count,
+    };
+    static constexpr size_t NumCounters = static_cast<size_t>(Counter::Count);
+
+    /// Per-frame statistics snapshot produced by EndFrame().
+    struct FrameStats {
+        f64 frame_time_ms{};
+        std::array<u64, NumCounters> deltas{};
+
+        u64 Get(Counter counter) const {
+            return deltas[static_cast<size_t>(counter)];
+        }
+    };
+
+    Profiler();
+    ~Profiler();
+
+    /// Returns monotonic nanoseconds since profiler creation.
+    u64 Now() const;
+
+    /// Records a completed scope into the calling thread's ring buffer.
+    void RecordScope(const char* name, u64 start_ns, u64 end_ns);
+
+    /// Bumps a frame counter; EndFrame() reports counters as per-frame deltas.
+    void AddCounter(Counter counter, u64 amount = 1) {
+        counters[static_cast<size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    /// Marks the end of a presented frame and returns the stats it accumulated.
+    FrameStats EndFrame();
+
+    /// Writes the buffered scopes of all threads as a chrome://tracing JSON file.
+    bool SaveTrace(const std::filesystem::path& path);
+
+private:
+    class ThreadRing;
+    ThreadRing& GetThreadRing();
+
+private:
+    u64 time_origin{};
+    std::array<std::atomic<u64>, NumCounters> counters{};
+    std::array<u64, NumCounters> last_counters{};
+    u64 last_frame_end{};
+    std::mutex ring_mutex;
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+};
+
+/// RAII helper timing the enclosing scope into the profiler.
+class ProfilerScope {
+public:
+    explicit ProfilerScope(const char* name_);
+    ~ProfilerScope();
+
+    ProfilerScope(const ProfilerScope&) = delete;
+    ProfilerScope& operator=(const ProfilerScope&) = delete;
+
+private:
+    const char* name;
+    u64 start;
+};
+
+} // namespace Common
+
+#define DETAIL_PROFILE_CONCAT2(x, y) x##y
+#define DETAIL_PROFILE_CONCAT(x, y) DETAIL_PROFILE_CONCAT2(x, y)
+
+/// Times the enclosing scope under the provided literal name.
+#define PROFILE_SCOPE(name)                                                                        \
+    const ::Common::ProfilerScope DETAIL_PROFILE_CONCAT(profile_scope_, __LINE__) { name }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <bit>
 #include <compare>
 #include <numeric>
@@ -17,13 +18,26 @@ namespace Common {
 struct SlotId {
     static constexpr u32 INVALID_INDEX = std::numeric_limits<u32>::max();
 
-    constexpr auto operator<=>(const SlotId&) const noexcept = default;
+    /// Ordering and equality intentionally ignore the generation, so versioned
+    /// handles stay interchangeable with index-only literals like NULL_IMAGE_ID
+    /// and with indices round-tripped through guest integers.
+    constexpr std::strong_ordering operator<=>(const SlotId& other) const noexcept {
+        return index <=> other.index;
+    }
+
+    constexpr bool operator==(const SlotId& other) const noexcept {
+        return index == other.index;
+    }
 
     constexpr explicit operator bool() const noexcept {
         return index != INVALID_INDEX;
     }
 
     u32 index = INVALID_INDEX;
+
+    /// Generation the slot had when this handle was created. Zero marks an
+    /// unversioned handle that bypasses stale-handle checks.
+    u32 generation = 0;
 };
 
 template <class T>
@@ -55,7 +69,10 @@ public:
     }
 
     bool is_allocated(SlotId id) const {
-        return ReadStorageBit(id.index);
+        if (!ReadStorageBit(id.index)) {
+            return false;
+        }
+        return id.generation == 0 || generations[id.index] == id.generation;
     }
 
     template <typename... Args>
@@ -63,8 +80,9 @@ public:
         const u32 index = FreeValueIndex();
         new (&values[index].object) T(std::forward<Args>(args)...);
         SetStorageBit(index);
+        AppendDense(index);
 
-        return SlotId{index};
+        return SlotId{index, generations[index]};
     }
 
     template <typename... Args>
@@ -76,16 +94,74 @@ public:
         existing_value.~T();
         new (&values[existing_id.index].object) T(std::forward<Args>(args)...);
         SetStorageBit(index);
+        AppendDense(index);
 
-        return SlotId{index};
+        return SlotId{index, generations[index]};
     }
 
     void erase(SlotId id) noexcept {
+        ValidateIndex(id);
         values[id.index].object.~T();
+        ++generations[id.index];
+        RemoveDense(id.index);
         free_list.push_back(id.index);
         ResetStorageBit(id.index);
     }
 
+    /// Invokes func(SlotId, T&) for every live slot, walking the dense index
+    /// array so the cost is proportional to live objects, not capacity.
+    template <typename Func>
+    void for_each(Func&& func) {
+        for (const u32 index : dense) {
+            func(SlotId{index, generations[index]}, values[index].object);
+        }
+    }
+
+    template <typename Func>
+    void for_each(Func&& func) const {
+        for (const u32 index : dense) {
+            func(SlotId{index, generations[index]}, values[index].object);
+        }
+    }
+
+    /// Releases trailing slot storage once occupancy drops far below capacity.
+    /// Live slots keep their indices so outstanding handles stay valid; call
+    /// from a GPU-idle point (e.g. a deferred destruction callback) so object
+    /// moves cannot race in-flight work reading them.
+    void compact() noexcept {
+        if (values_capacity <= InitialCapacity || size() * 4 > values_capacity) {
+            return;
+        }
+        // Hand out low indices first so the live range stays packed and future
+        // compactions can release more of the tail.
+        std::ranges::sort(free_list, std::ranges::greater{});
+
+        u32 highest_live = 0;
+        for (const u32 index : dense) {
+            highest_live = std::max(highest_live, index);
+        }
+        const std::size_t required = dense.empty() ? 0 : std::size_t(highest_live) + 1;
+        const std::size_t new_capacity = std::max(InitialCapacity, std::bit_ceil(required));
+        if (new_capacity >= values_capacity) {
+            return;
+        }
+
+        Entry* const new_values = new Entry[new_capacity];
+        for (const u32 index : dense) {
+            T& old_value = values[index].object;
+            new (&new_values[index].object) T(std::move(old_value));
+            old_value.~T();
+        }
+        delete[] values;
+        values = new_values;
+        values_capacity = new_capacity;
+
+        stored_bitset.resize((new_capacity + 63) / 64);
+        generations.resize(new_capacity);
+        dense_pos.resize(new_capacity);
+        std::erase_if(free_list, [new_capacity](u32 index) { return index >= new_capacity; });
+    }
+
     std::size_t size() const noexcept {
         return values_capacity - free_list.size();
     }
@@ -119,6 +195,20 @@ private:
         DEBUG_ASSERT(id);
         DEBUG_ASSERT(id.index / 64 < stored_bitset.size());
         DEBUG_ASSERT(((stored_bitset[id.index / 64] >> (id.index % 64)) & 1) != 0);
+        // Unversioned handles (generation zero) cannot be checked for staleness.
+        DEBUG_ASSERT(id.generation == 0 || generations[id.index] == id.generation);
+    }
+
+    void AppendDense(u32 index) noexcept {
+        dense_pos[index] = static_cast<u32>(dense.size());
+        dense.push_back(index);
+    }
+
+    void RemoveDense(u32 index) noexcept {
+        const u32 pos = dense_pos[index];
+        dense_pos[dense.back()] = pos;
+        dense[pos] = dense.back();
+        dense.pop_back();
     }
 
     [[nodiscard]] u32 FreeValueIndex() noexcept {
@@ -148,6 +238,10 @@ private:
         }
 
         stored_bitset.resize((new_capacity + 63) / 64);
+        // Fresh slots start at generation one; zero is reserved for unversioned
+        // handles.
+        generations.resize(new_capacity, 1);
+        dense_pos.resize(new_capacity);
 
         const std::size_t old_free_size = free_list.size();
         free_list.resize(old_free_size + (new_capacity - values_capacity));
@@ -163,7 +257,13 @@ private:
     std::size_t values_capacity = 0;
 
     std::vector<u64> stored_bitset;
+    std::vector<u32> generations;
     std::vector<u32> free_list;
+
+    // Dense index array for cache-friendly iteration over live slots, with a
+    // sparse position map to keep erase O(1).
+    std::vector<u32> dense;
+    std::vector<u32> dense_pos;
 };
 
 } // namespace Common
@@ -12,6 +12,11 @@
 #include <windows.h>
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define COMMON_STRING_UTIL_SSE2
+#endif
+
 namespace Common {
 
 std::string ToLower(std::string str) {
@@ -32,6 +37,129 @@ std::vector<std::string> SplitString(const std::string& str, char delimiter) {
     return output;
 }
 
+void UTF16ToUTF8(std::u16string_view input, std::string& output) {
+    output.clear();
+    output.reserve(input.size());
+    size_t i = 0;
+
+#ifdef COMMON_STRING_UTIL_SSE2
+    // PSF fields and save data paths are almost always plain ASCII; convert
+    // those 16 code units at a time and leave only the rare non-ASCII stretch
+    // to the scalar decoder below.
+    while (i + 16 <= input.size()) {
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.data() + i));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.data() + i + 8));
+        const __m128i non_ascii = _mm_and_si128(_mm_or_si128(lo, hi),
+                                                _mm_set1_epi16(static_cast<short>(0xFF80)));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi16(non_ascii, _mm_setzero_si128())) != 0xFFFF) {
+            break;
+        }
+        char buffer[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer), _mm_packus_epi16(lo, hi));
+        output.append(buffer, sizeof(buffer));
+        i += 16;
+    }
+#endif
+
+    while (i < input.size()) {
+        u32 cp = input[i++];
+        if (cp >= 0xD800 && cp < 0xDC00 && i < input.size()) {
+            const u32 low = input[i];
+            if (low >= 0xDC00 && low < 0xE000) {
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                ++i;
+            }
+        }
+        if (cp < 0x80) {
+            output.push_back(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+            output.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            output.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            output.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            output.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else {
+            output.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            output.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            output.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+}
+
+void UTF8ToUTF16(std::string_view input, std::u16string& output) {
+    output.clear();
+    output.reserve(input.size());
+    size_t i = 0;
+
+#ifdef COMMON_STRING_UTIL_SSE2
+    while (i + 16 <= input.size()) {
+        const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input.data() + i));
+        if (_mm_movemask_epi8(bytes) != 0) {
+            break;
+        }
+        char16_t buffer[16];
+        const __m128i zero = _mm_setzero_si128();
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer), _mm_unpacklo_epi8(bytes, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(buffer + 8), _mm_unpackhi_epi8(bytes, zero));
+        output.append(buffer, 16);
+        i += 16;
+    }
+#endif
+
+    while (i < input.size()) {
+        const u8 byte = static_cast<u8>(input[i]);
+        u32 cp = 0xFFFD;
+        size_t len = 1;
+        if (byte < 0x80) {
+            cp = byte;
+        } else if ((byte & 0xE0) == 0xC0) {
+            cp = byte & 0x1F;
+            len = 2;
+        } else if ((byte & 0xF0) == 0xE0) {
+            cp = byte & 0x0F;
+            len = 3;
+        } else if ((byte & 0xF8) == 0xF0) {
+            cp = byte & 0x07;
+            len = 4;
+        }
+        if (i + len > input.size()) {
+            cp = 0xFFFD;
+            len = 1;
+        }
+        for (size_t k = 1; k < len; ++k) {
+            const u8 cont = static_cast<u8>(input[i + k]);
+            if ((cont & 0xC0) != 0x80) {
+                cp = 0xFFFD;
+                len = k;
+                break;
+            }
+            cp = (cp << 6) | (cont & 0x3F);
+        }
+        i += len;
+        if (cp < 0x10000) {
+            output.push_back(static_cast<char16_t>(cp));
+        } else {
+            cp -= 0x10000;
+            output.push_back(static_cast<char16_t>(0xD800 + (cp >> 10)));
+            output.push_back(static_cast<char16_t>(0xDC00 + (cp & 0x3FF)));
+        }
+    }
+}
+
+std::string UTF16ToUTF8(std::u16string_view input) {
+    std::string output;
+    UTF16ToUTF8(input, output);
+    return output;
+}
+
+std::u16string UTF8ToUTF16(std::string_view input) {
+    std::u16string output;
+    UTF8ToUTF16(input, output);
+    return output;
+}
+
 #ifdef _WIN32
 static std::wstring CPToUTF16(u32 code_page, std::string_view input) {
     const auto size =
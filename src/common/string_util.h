@@ -14,6 +14,17 @@ namespace Common {
 
 std::vector<std::string> SplitString(const std::string& str, char delimiter);
 
+/// Converts between UTF-16 and UTF-8. ASCII-dominant inputs (PSF fields, save
+/// data paths) take a vectorized fast path; the scalar tail handles surrogate
+/// pairs and substitutes malformed sequences.
+[[nodiscard]] std::string UTF16ToUTF8(std::u16string_view input);
+[[nodiscard]] std::u16string UTF8ToUTF16(std::string_view input);
+
+/// Buffer-reuse variants: the result replaces the caller's buffer contents, so
+/// repeated conversions reuse its capacity instead of reallocating.
+void UTF16ToUTF8(std::u16string_view input, std::string& output);
+void UTF8ToUTF16(std::string_view input, std::u16string& output);
+
 #ifdef _WIN32
 [[nodiscard]] std::string UTF16ToUTF8(std::wstring_view input);
 [[nodiscard]] std::wstring UTF8ToUTF16W(std::string_view str);
@@ -2,8 +2,13 @@
 // SPDX-FileCopyrightText: 2014 Citra Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <fstream>
+#include <mutex>
 #include <string>
+#include <vector>
 
+#include "common/config.h"
 #include "common/error.h"
 #include "common/logging/log.h"
 #include "common/thread.h"
@@ -120,4 +125,219 @@ void SetCurrentThreadName(const char*) {
 
 #endif
 
+namespace {
+
+/// Parses a sysfs-style cpu list ("0-7,16,18") into logical cpu indices.
+std::vector<u32> ParseCpuList(const std::string& list) {
+    std::vector<u32> cpus;
+    size_t pos = 0;
+    while (pos < list.size()) {
+        size_t end = list.find(',', pos);
+        if (end == std::string::npos) {
+            end = list.size();
+        }
+        const std::string token = list.substr(pos, end - pos);
+        pos = end + 1;
+        if (token.empty()) {
+            continue;
+        }
+        const size_t dash = token.find('-');
+        try {
+            if (dash == std::string::npos) {
+                cpus.push_back(std::stoul(token));
+            } else {
+                const u32 first = std::stoul(token.substr(0, dash));
+                const u32 last = std::stoul(token.substr(dash + 1));
+                for (u32 cpu = first; cpu <= last; ++cpu) {
+                    cpus.push_back(cpu);
+                }
+            }
+        } catch (const std::exception&) {
+            LOG_ERROR(Common, "Malformed cpu list token '{}'", token);
+        }
+    }
+    return cpus;
+}
+
+struct CoreSets {
+    std::vector<u32> perf;
+    std::vector<u32> eff;
+};
+
+#if defined(__linux__)
+
+std::vector<u32> ReadSysfsCpuList(const char* path) {
+    std::ifstream file{path};
+    std::string list;
+    if (!file || !std::getline(file, list)) {
+        return {};
+    }
+    return ParseCpuList(list);
+}
+
+CoreSets DetectCoreSets() {
+    // Intel hybrid parts expose the core types here; both files missing means
+    // a homogeneous topology and we leave scheduling to the kernel.
+    return CoreSets{
+        .perf = ReadSysfsCpuList("/sys/devices/cpu_core/cpus"),
+        .eff = ReadSysfsCpuList("/sys/devices/cpu_atom/cpus"),
+    };
+}
+
+#elif defined(_WIN32)
+
+CoreSets DetectCoreSets() {
+    CoreSets sets;
+    ULONG size = 0;
+    GetSystemCpuSetInformation(nullptr, 0, &size, GetCurrentProcess(), 0);
+    if (size == 0) {
+        return sets;
+    }
+    std::vector<char> buffer(size);
+    auto* info = reinterpret_cast<PSYSTEM_CPU_SET_INFORMATION>(buffer.data());
+    if (!GetSystemCpuSetInformation(info, size, &size, GetCurrentProcess(), 0)) {
+        return sets;
+    }
+    u8 max_class = 0;
+    for (ULONG offset = 0; offset < size;) {
+        const auto* entry = reinterpret_cast<PSYSTEM_CPU_SET_INFORMATION>(buffer.data() + offset);
+        max_class = std::max(max_class, entry->CpuSet.EfficiencyClass);
+        offset += entry->Size;
+    }
+    if (max_class == 0) {
+        // All cores report the same class, topology is homogeneous.
+        return sets;
+    }
+    for (ULONG offset = 0; offset < size;) {
+        const auto* entry = reinterpret_cast<PSYSTEM_CPU_SET_INFORMATION>(buffer.data() + offset);
+        auto& cpus = entry->CpuSet.EfficiencyClass == max_class ? sets.perf : sets.eff;
+        cpus.push_back(entry->CpuSet.LogicalProcessorIndex);
+        offset += entry->Size;
+    }
+    return sets;
+}
+
+#else
+
+CoreSets DetectCoreSets() {
+    return {};
+}
+
+#endif
+
+/// Resolves the core sets, preferring config overrides over detection.
+CoreSets ResolveCoreSets() {
+    CoreSets sets;
+    const std::string p_override = Config::pCoreList();
+    const std::string e_override = Config::eCoreList();
+    if (!p_override.empty() || !e_override.empty()) {
+        sets.perf = ParseCpuList(p_override);
+        sets.eff = ParseCpuList(e_override);
+        return sets;
+    }
+    return DetectCoreSets();
+}
+
+const std::vector<u32>& CpusForRole(const CoreSets& sets, ThreadRole role) {
+    switch (role) {
+    case ThreadRole::GpuCommand:
+    case ThreadRole::Present:
+    case ThreadRole::Audio:
+    case ThreadRole::Guest:
+        return sets.perf;
+    case ThreadRole::Logging:
+    case ThreadRole::Io:
+    default:
+        return sets.eff;
+    }
+}
+
+#if defined(__linux__) || defined(__FreeBSD__)
+using ThreadHandle = pthread_t;
+
+ThreadHandle CurrentThreadHandle() {
+    return pthread_self();
+}
+
+void ApplyAffinity(ThreadHandle handle, const std::vector<u32>& cpus) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const u32 cpu : cpus) {
+        CPU_SET(cpu, &set);
+    }
+    if (int e = pthread_setaffinity_np(handle, sizeof(set), &set)) {
+        errno = e;
+        LOG_ERROR(Common, "Failed to set thread affinity: {}", GetLastErrorMsg());
+    }
+}
+#elif defined(_WIN32)
+using ThreadHandle = DWORD;
+
+ThreadHandle CurrentThreadHandle() {
+    return GetCurrentThreadId();
+}
+
+void ApplyAffinity(ThreadHandle tid, const std::vector<u32>& cpus) {
+    DWORD_PTR mask = 0;
+    for (const u32 cpu : cpus) {
+        if (cpu < sizeof(mask) * 8) {
+            mask |= DWORD_PTR(1) << cpu;
+        }
+    }
+    const HANDLE handle = OpenThread(THREAD_SET_INFORMATION | THREAD_QUERY_INFORMATION, FALSE, tid);
+    if (!handle) {
+        LOG_ERROR(Common, "Failed to open thread {} for affinity update", tid);
+        return;
+    }
+    if (!SetThreadAffinityMask(handle, mask)) {
+        LOG_ERROR(Common, "Failed to set thread affinity: {}", GetLastErrorMsg());
+    }
+    CloseHandle(handle);
+}
+#else
+using ThreadHandle = int;
+
+ThreadHandle CurrentThreadHandle() {
+    return 0;
+}
+
+void ApplyAffinity(ThreadHandle, const std::vector<u32>&) {}
+#endif
+
+struct RoleThread {
+    ThreadRole role;
+    ThreadHandle handle;
+};
+
+// Registered threads are the long-lived emulator service threads; entries are
+// never removed, so only threads that live for the whole session may register.
+std::mutex role_mutex;
+std::vector<RoleThread> role_threads;
+
+} // Anonymous namespace
+
+void SetCurrentThreadRole(ThreadRole role) {
+    const ThreadHandle handle = CurrentThreadHandle();
+    {
+        std::scoped_lock lock{role_mutex};
+        role_threads.push_back(RoleThread{role, handle});
+    }
+    const CoreSets sets = ResolveCoreSets();
+    const auto& cpus = CpusForRole(sets, role);
+    if (!cpus.empty()) {
+        ApplyAffinity(handle, cpus);
+    }
+}
+
+void ReapplyThreadRoles() {
+    const CoreSets sets = ResolveCoreSets();
+    std::scoped_lock lock{role_mutex};
+    for (const RoleThread& thread : role_threads) {
+        const auto& cpus = CpusForRole(sets, thread.role);
+        if (!cpus.empty()) {
+            ApplyAffinity(thread.handle, cpus);
+        }
+    }
+}
+
 } // namespace Common
@@ -16,8 +16,27 @@ enum class ThreadPriority : u32 {
     Critical = 4,
 };
 
+enum class ThreadRole : u32 {
+    GpuCommand, // Liverpool command processor and ASC workers
+    Present,    // Thread driving flips and presentation
+    Audio,      // Audio mixing/output
+    Guest,      // Guest game threads
+    Logging,    // Log writer
+    Io,         // Background file IO (save committer, dumpers, watchers)
+};
+
 void SetCurrentThreadPriority(ThreadPriority new_priority);
 
 void SetCurrentThreadName(const char* name);
 
+/// Pins the calling thread to the core set appropriate for its role on hybrid
+/// (P/E-core) hosts and registers it for later re-placement. Latency-critical
+/// roles go to performance cores, background roles to efficiency cores. On
+/// homogeneous topologies without config overrides this is a no-op.
+void SetCurrentThreadRole(ThreadRole role);
+
+/// Re-applies placement of every registered thread, picking up changed core
+/// list overrides from the config (called on config hot-reload).
+void ReapplyThreadRoles();
+
 } // namespace Common
@@ -0,0 +1,211 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <fmt/format.h>
+
+#include "common/polyfill_thread.h"
+#include "common/thread.h"
+#include "common/thread_pool.h"
+
+namespace Common {
+
+namespace {
+constexpr size_t InitialDequeCapacity = 256;
+
+// Identifies the current thread when posting from inside a pool task, so
+// nested submissions go to the worker's own deque instead of the injector.
+thread_local ThreadPool* this_pool = nullptr;
+thread_local u32 this_worker = 0;
+} // Anonymous namespace
+
+struct ThreadPool::StealQueue::Buffer {
+    explicit Buffer(size_t capacity_) : capacity{capacity_}, slots(capacity_) {}
+
+    Task* Get(s64 index) const {
+        return slots[index & (capacity - 1)].load(std::memory_order_relaxed);
+    }
+    void Put(s64 index, Task* task) {
+        slots[index & (capacity - 1)].store(task, std::memory_order_relaxed);
+    }
+
+    size_t capacity;
+    std::vector<std::atomic<Task*>> slots;
+};
+
+ThreadPool::StealQueue::StealQueue(size_t capacity) {
+    auto initial = std::make_unique<Buffer>(capacity);
+    buffer.store(initial.get(), std::memory_order_relaxed);
+    retired.push_back(std::move(initial));
+}
+
+ThreadPool::StealQueue::~StealQueue() = default;
+
+void ThreadPool::StealQueue::Push(Task* task) {
+    const s64 b = bottom.load(std::memory_order_relaxed);
+    const s64 t = top.load(std::memory_order_acquire);
+    Buffer* a = buffer.load(std::memory_order_relaxed);
+    if (b - t > static_cast<s64>(a->capacity) - 1) {
+        // Full: migrate live entries into a buffer twice the size. The old buffer is
+        // retired rather than freed since concurrent thieves may still be reading it.
+        auto grown = std::make_unique<Buffer>(a->capacity * 2);
+        for (s64 i = t; i != b; ++i) {
+            grown->Put(i, a->Get(i));
+        }
+        a = grown.get();
+        buffer.store(a, std::memory_order_release);
+        retired.push_back(std::move(grown));
+    }
+    a->Put(b, task);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+}
+
+ThreadPool::Task* ThreadPool::StealQueue::Pop() {
+    const s64 b = bottom.load(std::memory_order_relaxed) - 1;
+    Buffer* a = buffer.load(std::memory_order_relaxed);
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    s64 t = top.load(std::memory_order_relaxed);
+    Task* task = nullptr;
+    if (t <= b) {
+        task = a->Get(b);
+        if (t == b) {
+            // Racing with thieves for the last entry.
+            if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                             std::memory_order_relaxed)) {
+                task = nullptr;
+            }
+            bottom.store(b + 1, std::memory_order_relaxed);
+        }
+    } else {
+        bottom.store(b + 1, std::memory_order_relaxed);
+    }
+    return task;
+}
+
+ThreadPool::Task* ThreadPool::StealQueue::Steal() {
+    s64 t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const s64 b = bottom.load(std::memory_order_acquire);
+    Task* task = nullptr;
+    if (t < b) {
+        Buffer* a = buffer.load(std::memory_order_acquire);
+        task = a->Get(t);
+        if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+            // Lost the entry to the owner or another thief.
+            return nullptr;
+        }
+    }
+    return task;
+}
+
+ThreadPool::ThreadPool(u32 num_workers) {
+    if (num_workers == 0) {
+        // Leave a couple of cores of headroom for the guest and GPU process threads.
+        const s32 num_cores = static_cast<s32>(std::thread::hardware_concurrency());
+        num_workers = static_cast<u32>(std::max(num_cores - 2, 1));
+    }
+    queues.reserve(num_workers);
+    for (u32 i = 0; i < num_workers; i++) {
+        queues.push_back(std::make_unique<StealQueue>(InitialDequeCapacity));
+    }
+    workers.reserve(num_workers);
+    for (u32 i = 0; i < num_workers; i++) {
+        workers.emplace_back([this, i](std::stop_token token) { WorkerLoop(i, token); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    for (auto& worker : workers) {
+        worker.request_stop();
+    }
+    {
+        std::scoped_lock lk{wake_mutex};
+        wake_cv.notify_all();
+    }
+    workers.clear();
+    // Dispose of any tasks that were never picked up.
+    for (auto& queue : queues) {
+        while (Task* task = queue->Steal()) {
+            delete task;
+        }
+    }
+    for (Task* task : injector) {
+        delete task;
+    }
+}
+
+void ThreadPool::Post(std::function<void()> task) {
+    auto* item = new Task{std::move(task)};
+    num_pending.fetch_add(1, std::memory_order_relaxed);
+    if (this_pool == this) {
+        queues[this_worker]->Push(item);
+    } else {
+        std::scoped_lock lk{injector_mutex};
+        injector.push_back(item);
+    }
+    num_queued.fetch_add(1, std::memory_order_release);
+    std::scoped_lock lk{wake_mutex};
+    wake_cv.notify_one();
+}
+
+void ThreadPool::WaitForIdle() {
+    std::unique_lock lk{wake_mutex};
+    idle_cv.wait(lk, [this] { return num_pending.load(std::memory_order_acquire) == 0; });
+}
+
+bool ThreadPool::IsWorkerThread() noexcept {
+    return this_pool != nullptr;
+}
+
+ThreadPool::Task* ThreadPool::FindTask(u32 index) {
+    if (Task* task = queues[index]->Pop()) {
+        return task;
+    }
+    {
+        std::scoped_lock lk{injector_mutex};
+        if (!injector.empty()) {
+            Task* task = injector.front();
+            injector.pop_front();
+            return task;
+        }
+    }
+    for (u32 i = 1; i < static_cast<u32>(queues.size()); i++) {
+        const u32 victim = (index + i) % static_cast<u32>(queues.size());
+        if (Task* task = queues[victim]->Steal()) {
+            return task;
+        }
+    }
+    return nullptr;
+}
+
+void ThreadPool::Finish(Task* task) {
+    delete task;
+    if (num_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::scoped_lock lk{wake_mutex};
+        idle_cv.notify_all();
+    }
+}
+
+void ThreadPool::WorkerLoop(u32 index, std::stop_token token) {
+    SetCurrentThreadName(fmt::format("shadPS4:Worker{}", index).c_str());
+    this_pool = this;
+    this_worker = index;
+    while (!token.stop_requested()) {
+        if (Task* task = FindTask(index)) {
+            num_queued.fetch_sub(1, std::memory_order_relaxed);
+            task->work();
+            Finish(task);
+            continue;
+        }
+        // Sleep on queued rather than pending work so a worker does not spin
+        // while the only remaining tasks are executing on its siblings.
+        std::unique_lock lk{wake_mutex};
+        CondvarWait(wake_cv, lk, token,
+                    [this] { return num_queued.load(std::memory_order_acquire) != 0; });
+    }
+}
+
+} // namespace Common
@@ -0,0 +1,85 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "common/types.h"
+
+namespace Common {
+
+/**
+ * Work-stealing task pool shared across emulator subsystems. Each worker owns a
+ * Chase-Lev deque that it pushes and pops from the LIFO end; idle workers steal
+ * from the FIFO end of their siblings. Tasks posted from non-worker threads land
+ * in a shared injector queue that workers drain when their own deque runs dry.
+ * The pool is sized below the core count by default so bursty host work does not
+ * starve the guest and GPU threads.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(u32 num_workers = 0);
+    ~ThreadPool();
+
+    /// Schedules a task for execution on any worker thread.
+    void Post(std::function<void()> task);
+
+    /// Blocks until every task posted so far has finished executing.
+    void WaitForIdle();
+
+    /// Returns true when called from inside a pool task. Fork-join callers must
+    /// not block a worker on work that only other workers can execute.
+    static bool IsWorkerThread() noexcept;
+
+    u32 NumWorkers() const noexcept {
+        return static_cast<u32>(workers.size());
+    }
+
+private:
+    struct Task {
+        std::function<void()> work;
+    };
+
+    /// Chase-Lev work-stealing deque of task pointers. Push/Pop may only be
+    /// called by the owning worker; Steal is safe from any thread.
+    class StealQueue {
+    public:
+        explicit StealQueue(size_t capacity);
+        ~StealQueue();
+
+        void Push(Task* task);
+        Task* Pop();
+        Task* Steal();
+
+    private:
+        struct Buffer;
+
+        std::atomic<s64> top{0};
+        std::atomic<s64> bottom{0};
+        std::atomic<Buffer*> buffer;
+        std::vector<std::unique_ptr<Buffer>> retired;
+    };
+
+    void WorkerLoop(u32 index, std::stop_token token);
+    Task* FindTask(u32 index);
+    void Finish(Task* task);
+
+    std::vector<std::unique_ptr<StealQueue>> queues;
+    std::mutex injector_mutex;
+    std::deque<Task*> injector;
+    std::atomic<u64> num_pending{};
+    std::atomic<u64> num_queued{};
+    std::mutex wake_mutex;
+    std::condition_variable_any wake_cv;
+    std::condition_variable idle_cv;
+    std::vector<std::jthread> workers;
+};
+
+} // namespace Common
@@ -1,8 +1,11 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <boost/container/small_vector.hpp>
 #include <boost/icl/separate_interval_set.hpp>
 #include "common/assert.h"
+#include "common/config.h"
 #include "common/error.h"
 #include "core/address_space.h"
 #include "core/libraries/kernel/memory_management.h"
@@ -11,6 +14,7 @@
 #include <windows.h>
 #else
 #include <fcntl.h>
+#include <unistd.h>
 #include <sys/mman.h>
 #endif
 
@@ -52,9 +56,22 @@ struct AddressSpace::Impl {
         placeholders.insert({virtual_addr, virtual_addr + virtual_size});
 
         // Allocate backing file that represents the total physical memory.
-        backing_handle =
-            CreateFileMapping2(INVALID_HANDLE_VALUE, nullptr, FILE_MAP_WRITE | FILE_MAP_READ,
-                               PAGE_READWRITE, SEC_COMMIT, BackingSize, nullptr, nullptr, 0);
+        // Optionally use large pages to reduce TLB pressure when scanning GPU resources.
+        // This requires SeLockMemoryPrivilege so fall back to regular pages when denied.
+        if (Config::directMemoryHugePages()) {
+            backing_handle = CreateFileMapping2(
+                INVALID_HANDLE_VALUE, nullptr, FILE_MAP_WRITE | FILE_MAP_READ, PAGE_READWRITE,
+                SEC_COMMIT | SEC_LARGE_PAGES, BackingSize, nullptr, nullptr, 0);
+            if (!backing_handle) {
+                LOG_WARNING(Kernel_Vmm, "Unable to back direct memory with large pages: {}",
+                            Common::GetLastErrorMsg());
+            }
+        }
+        if (!backing_handle) {
+            backing_handle =
+                CreateFileMapping2(INVALID_HANDLE_VALUE, nullptr, FILE_MAP_WRITE | FILE_MAP_READ,
+                                   PAGE_READWRITE, SEC_COMMIT, BackingSize, nullptr, nullptr, 0);
+        }
         ASSERT(backing_handle);
         // Allocate a virtual memory for the backing file map as placeholder
         backing_base = static_cast<u8*>(VirtualAlloc2(process, nullptr, BackingSize,
@@ -229,18 +246,36 @@ struct AddressSpace::Impl {
         }
         madvise(virtual_base, virtual_size, MADV_HUGEPAGE);
 
-        backing_fd = memfd_create("BackingDmem", 0);
-        if (backing_fd < 0) {
-            LOG_CRITICAL(Kernel_Vmm, "memfd_create failed: {}", strerror(errno));
-            throw std::bad_alloc{};
+        // Optionally back direct memory with 2MiB huge pages to reduce TLB pressure
+        // when scanning GPU resources. The huge page pool may be absent or too small,
+        // in which case fall back to regular pages.
+#if defined(MFD_HUGETLB) && defined(MFD_HUGE_2MB)
+        if (Config::directMemoryHugePages()) {
+            backing_fd = memfd_create("BackingDmem", MFD_HUGETLB | MFD_HUGE_2MB);
+            if (backing_fd >= 0 && ftruncate(backing_fd, BackingSize) != 0) {
+                close(backing_fd);
+                backing_fd = -1;
+            }
+            if (backing_fd < 0) {
+                LOG_WARNING(Kernel_Vmm, "Unable to back direct memory with huge pages: {}",
+                            strerror(errno));
+            }
         }
+#endif
+        if (backing_fd < 0) {
+            backing_fd = memfd_create("BackingDmem", 0);
+            if (backing_fd < 0) {
+                LOG_CRITICAL(Kernel_Vmm, "memfd_create failed: {}", strerror(errno));
+                throw std::bad_alloc{};
+            }
 
-        // Defined to extend the file with zeros
-        int ret = ftruncate(backing_fd, BackingSize);
-        if (ret != 0) {
-            LOG_CRITICAL(Kernel_Vmm, "ftruncate failed with {}, are you out-of-memory?",
-                         strerror(errno));
-            throw std::bad_alloc{};
+            // Defined to extend the file with zeros
+            int ret = ftruncate(backing_fd, BackingSize);
+            if (ret != 0) {
+                LOG_CRITICAL(Kernel_Vmm, "ftruncate failed with {}, are you out-of-memory?",
+                             strerror(errno));
+                throw std::bad_alloc{};
+            }
         }
 
         // Map backing dmem handle.
@@ -303,7 +338,7 @@ struct AddressSpace::Impl {
         ASSERT_MSG(ret == 0, "mprotect failed: {}", strerror(errno));
     }
 
-    int backing_fd;
+    int backing_fd = -1;
     u8* backing_base{};
     u8* virtual_base{};
     size_t virtual_size{};
@@ -337,4 +372,26 @@ void AddressSpace::Protect(VAddr virtual_addr, size_t size, MemoryPermission per
     return impl->Protect(virtual_addr, size, true, true, true);
 }
 
+void AddressSpace::Protect(std::span<const ProtectRange> ranges) {
+    boost::container::small_vector<ProtectRange, 32> plan(ranges.begin(), ranges.end());
+    std::ranges::sort(plan, {}, &ProtectRange::virtual_addr);
+
+    // Walk the sorted plan emitting one call per maximal run of touching
+    // ranges that request the same permissions.
+    size_t it = 0;
+    while (it < plan.size()) {
+        VAddr run_start = plan[it].virtual_addr;
+        VAddr run_end = run_start + plan[it].size;
+        const MemoryPermission perms = plan[it].perms;
+        size_t next = it + 1;
+        while (next < plan.size() && plan[next].virtual_addr <= run_end &&
+               plan[next].perms == perms) {
+            run_end = std::max(run_end, plan[next].virtual_addr + plan[next].size);
+            ++next;
+        }
+        Protect(run_start, run_end - run_start, perms);
+        it = next;
+    }
+}
+
 } // namespace Core
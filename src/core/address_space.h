@@ -4,6 +4,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 #include "common/enum.h"
 #include "common/types.h"
 
@@ -70,6 +71,18 @@ public:
 
     void Protect(VAddr virtual_addr, size_t size, MemoryPermission perms);
 
+    /// A single protection change for the batch overload below.
+    struct ProtectRange {
+        VAddr virtual_addr;
+        size_t size;
+        MemoryPermission perms;
+    };
+
+    /// Applies a set of protection changes, coalescing adjacent or overlapping
+    /// ranges with identical permissions so each contiguous run costs a single
+    /// kernel call instead of one per range.
+    void Protect(std::span<const ProtectRange> ranges);
+
 private:
     struct Impl;
     std::unique_ptr<Impl> impl;
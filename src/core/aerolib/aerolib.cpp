@@ -1,32 +1,80 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
 #include <cstring>
 #include "common/types.h"
 #include "core/aerolib/aerolib.h"
 
 namespace Core::AeroLib {
 
-// Use a direct table here + binary search as contents are static
+// Use a direct table here as contents are static
 static constexpr NidEntry NIDS[] = {
 #define STUB(nid, name) {nid, #name},
 #include "aerolib.inl"
 #undef STUB
 };
 
+static constexpr size_t NumNids = std::size(NIDS);
+
+// NIDs are 11 character base64 strings. Pack the first 10 characters into a 60-bit
+// key with a code that preserves the ASCII order of the base64 alphabet, so the key
+// array inherits the sort order of the table and buckets stay contiguous.
+static constexpr auto NidCharCode = [] {
+    std::array<u8, 256> codes{};
+    codes['+'] = 0;
+    codes['-'] = 1;
+    for (char c = '0'; c <= '9'; c++) {
+        codes[c] = 2 + c - '0';
+    }
+    for (char c = 'A'; c <= 'Z'; c++) {
+        codes[c] = 12 + c - 'A';
+    }
+    for (char c = 'a'; c <= 'z'; c++) {
+        codes[c] = 38 + c - 'a';
+    }
+    return codes;
+}();
+
+static constexpr u64 NidKey(const char* nid) {
+    u64 key = 0;
+    for (u32 i = 0; i < 10 && nid[i] != '\0'; i++) {
+        key |= static_cast<u64>(NidCharCode[static_cast<u8>(nid[i])]) << (54 - i * 6);
+    }
+    return key;
+}
+
+static constexpr auto KEYS = [] {
+    std::array<u64, NumNids> keys{};
+    for (size_t i = 0; i < NumNids; i++) {
+        keys[i] = NidKey(NIDS[i].nid);
+    }
+    return keys;
+}();
+
+// Index the key array by the top bits of the key. NIDs are truncated hashes, so the
+// buckets come out evenly filled with a handful of entries each and a lookup is one
+// bucket probe plus a short scan instead of a binary search over the whole table.
+static constexpr u32 BucketBits = 16;
+static constexpr u32 BucketShift = 60 - BucketBits;
+
+static constexpr auto BUCKETS = [] {
+    std::array<u32, (1u << BucketBits) + 1> buckets{};
+    for (size_t i = 0; i < NumNids; i++) {
+        buckets[(KEYS[i] >> BucketShift) + 1]++;
+    }
+    for (size_t i = 1; i < buckets.size(); i++) {
+        buckets[i] += buckets[i - 1];
+    }
+    return buckets;
+}();
+
 const NidEntry* FindByNid(const char* nid) {
-    s64 l = 0;
-    s64 r = sizeof(NIDS) / sizeof(NIDS[0]) - 1;
-
-    while (l <= r) {
-        const size_t m = l + (r - l) / 2;
-        const int cmp = std::strcmp(NIDS[m].nid, nid);
-        if (cmp == 0) {
-            return &NIDS[m];
-        } else if (cmp < 0) {
-            l = m + 1;
-        } else {
-            r = m - 1;
+    const u64 key = NidKey(nid);
+    const u32 bucket = key >> BucketShift;
+    for (u32 i = BUCKETS[bucket]; i < BUCKETS[bucket + 1]; i++) {
+        if (KEYS[i] == key && std::strcmp(NIDS[i].nid, nid) == 0) {
+            return &NIDS[i];
         }
     }
     return nullptr;
@@ -4,6 +4,14 @@
 #include <array>
 #include "crypto.h"
 
+#if defined(__x86_64__) || defined(_M_X64)
+#define PFS_XTS_AESNI 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
 CryptoPP::RSA::PrivateKey Crypto::key_pkg_derived_key3_keyset_init() {
     CryptoPP::InvertibleRSAFunction params;
     params.SetPrime1(CryptoPP::Integer(pkg_derived_key3_keyset.Prime1, 0x80));
@@ -74,21 +82,19 @@ CryptoPP::RSA::PrivateKey Crypto::DebugRifKeyset_init() {
 void Crypto::RSA2048Decrypt(std::span<CryptoPP::byte, 32> dec_key,
                             std::span<const CryptoPP::byte, 256> ciphertext,
                             bool is_dk3) { // RSAES_PKCS1v15_
-    // Create an RSA decryptor
-    CryptoPP::RSA::PrivateKey privateKey;
-    if (is_dk3) {
-        privateKey = key_pkg_derived_key3_keyset_init();
-    } else {
-        privateKey = FakeKeyset_keyset_init();
-    }
-
-    CryptoPP::RSAES_PKCS1v15_Decryptor rsaDecryptor(privateKey);
+    // The keysets are hardcoded, so parse the big integers and construct each
+    // decryptor only once; every PKG open after the first reuses the
+    // precomputed CRT state instead of rebuilding the private key.
+    static const CryptoPP::RSAES_PKCS1v15_Decryptor dk3_decryptor(
+        key_pkg_derived_key3_keyset_init());
+    static const CryptoPP::RSAES_PKCS1v15_Decryptor fake_decryptor(FakeKeyset_keyset_init());
+    const auto& rsaDecryptor = is_dk3 ? dk3_decryptor : fake_decryptor;
 
     // Allocate memory for the decrypted data
     std::array<CryptoPP::byte, 256> decrypted;
 
     // Perform the decryption
-    CryptoPP::AutoSeededRandomPool rng;
+    thread_local CryptoPP::AutoSeededRandomPool rng;
     CryptoPP::DecodingResult result =
         rsaDecryptor.Decrypt(rng, ciphertext.data(), decrypted.size(), decrypted.data());
     std::copy(decrypted.begin(), decrypted.begin() + dec_key.size(), dec_key.begin());
@@ -96,11 +102,11 @@ void Crypto::RSA2048Decrypt(std::span<CryptoPP::byte, 32> dec_key,
 
 void Crypto::ivKeyHASH256(std::span<const CryptoPP::byte, 64> cipher_input,
                           std::span<CryptoPP::byte, 32> ivkey_result) {
-    CryptoPP::SHA256 sha256;
+    // CalculateDigest leaves the hash reusable, so one instance per thread
+    // avoids the filter-chain allocations of the pipeline API.
+    thread_local CryptoPP::SHA256 sha256;
     std::array<CryptoPP::byte, CryptoPP::SHA256::DIGESTSIZE> hashResult;
-    auto array_sink = new CryptoPP::ArraySink(hashResult.data(), CryptoPP::SHA256::DIGESTSIZE);
-    auto filter = new CryptoPP::HashFilter(sha256, array_sink);
-    CryptoPP::ArraySource r(cipher_input.data(), cipher_input.size(), true, filter);
+    sha256.CalculateDigest(hashResult.data(), cipher_input.data(), cipher_input.size());
     std::copy(hashResult.begin(), hashResult.begin() + ivkey_result.size(), ivkey_result.begin());
 }
 
@@ -113,8 +119,10 @@ void Crypto::aesCbcCfb128Decrypt(std::span<const CryptoPP::byte, 32> ivkey,
     std::copy(ivkey.begin() + 16, ivkey.begin() + 16 + key.size(), key.begin());
     std::copy(ivkey.begin(), ivkey.begin() + iv.size(), iv.begin());
 
-    CryptoPP::AES::Decryption aesDecryption(key.data(), CryptoPP::AES::DEFAULT_KEYLENGTH);
-    CryptoPP::CBC_Mode_ExternalCipher::Decryption cbcDecryption(aesDecryption, iv.data());
+    // Rekeying a per-thread cipher skips the object construction; the AES key
+    // schedule itself still runs since every package uses a different key.
+    thread_local CryptoPP::CBC_Mode<CryptoPP::AES>::Decryption cbcDecryption;
+    cbcDecryption.SetKeyWithIV(key.data(), key.size(), iv.data());
 
     for (size_t i = 0; i < decrypted.size(); i += CryptoPP::AES::BLOCKSIZE) {
         cbcDecryption.ProcessData(decrypted.data() + i, ciphertext.data() + i,
@@ -131,8 +139,8 @@ void Crypto::aesCbcCfb128DecryptEntry(std::span<const CryptoPP::byte, 32> ivkey,
     std::copy(ivkey.begin() + 16, ivkey.begin() + 16 + key.size(), key.begin());
     std::copy(ivkey.begin(), ivkey.begin() + iv.size(), iv.begin());
 
-    CryptoPP::AES::Decryption aesDecryption(key.data(), CryptoPP::AES::DEFAULT_KEYLENGTH);
-    CryptoPP::CBC_Mode_ExternalCipher::Decryption cbcDecryption(aesDecryption, iv.data());
+    thread_local CryptoPP::CBC_Mode<CryptoPP::AES>::Decryption cbcDecryption;
+    cbcDecryption.SetKeyWithIV(key.data(), key.size(), iv.data());
 
     for (size_t i = 0; i < decrypted.size(); i += CryptoPP::AES::BLOCKSIZE) {
         cbcDecryption.ProcessData(decrypted.data() + i, ciphertext.data() + i,
@@ -148,14 +156,14 @@ void Crypto::decryptEFSM(std::span<CryptoPP::byte, 16> NPcommID,
                                              0xCA, 0x7A, 0xD5, 0x86, 0xC1, 0x01, 0xB7, 0xA9};
     std::vector<CryptoPP::byte> TrophyIV = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
     // step 1: Encrypt NPcommID
-    CryptoPP::CBC_Mode<CryptoPP::AES>::Encryption encrypt;
+    thread_local CryptoPP::CBC_Mode<CryptoPP::AES>::Encryption encrypt;
     encrypt.SetKeyWithIV(TrophyKey.data(), TrophyKey.size(), TrophyIV.data());
 
     std::vector<CryptoPP::byte> trpKey(16);
 
     encrypt.ProcessData(trpKey.data(), NPcommID.data(), 16);
     // step 2: decrypt efsm.
-    CryptoPP::CBC_Mode<CryptoPP::AES>::Decryption decrypt;
+    thread_local CryptoPP::CBC_Mode<CryptoPP::AES>::Decryption decrypt;
     decrypt.SetKeyWithIV(trpKey.data(), trpKey.size(), efsmIv.data());
 
     for (size_t i = 0; i < decrypted.size(); i += CryptoPP::AES::BLOCKSIZE) {
@@ -188,9 +196,125 @@ void Crypto::PfsGenCryptoKey(std::span<const CryptoPP::byte, 32> ekpfs,
               data_tweak_key.begin() + tweakKey.size() + dataKey.size(), dataKey.begin());
 }
 
+#ifdef PFS_XTS_AESNI
+
+#ifdef _MSC_VER
+#define TARGET_AES
+#else
+#define TARGET_AES __attribute__((target("aes")))
+#endif
+
+static bool CheckAesNiSupport() {
+#ifdef _MSC_VER
+    int regs[4];
+    __cpuid(regs, 1);
+    return (regs[2] & (1 << 25)) != 0;
+#else
+    return __builtin_cpu_supports("aes");
+#endif
+}
+
+static __m128i Aes128KeyExpAssist(__m128i key, __m128i keygened) {
+    keygened = _mm_shuffle_epi32(keygened, _MM_SHUFFLE(3, 3, 3, 3));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+    return _mm_xor_si128(key, keygened);
+}
+
+TARGET_AES static void Aes128ExpandKey(const CryptoPP::byte* key, __m128i* round_keys) {
+#define AES_128_KEY_EXP(idx, rcon)                                                                 \
+    round_keys[idx] =                                                                              \
+        Aes128KeyExpAssist(round_keys[idx - 1], _mm_aeskeygenassist_si128(round_keys[idx - 1], rcon))
+    round_keys[0] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+    AES_128_KEY_EXP(1, 0x01);
+    AES_128_KEY_EXP(2, 0x02);
+    AES_128_KEY_EXP(3, 0x04);
+    AES_128_KEY_EXP(4, 0x08);
+    AES_128_KEY_EXP(5, 0x10);
+    AES_128_KEY_EXP(6, 0x20);
+    AES_128_KEY_EXP(7, 0x40);
+    AES_128_KEY_EXP(8, 0x80);
+    AES_128_KEY_EXP(9, 0x1B);
+    AES_128_KEY_EXP(10, 0x36);
+#undef AES_128_KEY_EXP
+}
+
+// Multiplies the tweak by x in GF(2^128) with the XTS reduction polynomial.
+static __m128i XtsMultSse(__m128i tweak) {
+    __m128i carry = _mm_srai_epi32(tweak, 31);
+    carry = _mm_and_si128(carry, _mm_set_epi32(0x87, 1, 1, 1));
+    carry = _mm_shuffle_epi32(carry, _MM_SHUFFLE(2, 1, 0, 3));
+    return _mm_xor_si128(_mm_slli_epi32(tweak, 1), carry);
+}
+
+TARGET_AES static void DecryptSectorAesNi(const __m128i* dec_keys, const __m128i* tweak_keys,
+                                          const u8* src, CryptoPP::byte* dst, u64 sector) {
+    // Encrypt the sector number with the tweak key to get the initial tweak.
+    __m128i tweak = _mm_xor_si128(_mm_set_epi64x(0, sector), tweak_keys[0]);
+    for (int r = 1; r < 10; r++) {
+        tweak = _mm_aesenc_si128(tweak, tweak_keys[r]);
+    }
+    tweak = _mm_aesenclast_si128(tweak, tweak_keys[10]);
+
+    // Pipeline eight blocks at a time so the aesdec latency overlaps.
+    for (int off = 0; off < 0x1000; off += 16 * 8) {
+        __m128i t[8];
+        __m128i b[8];
+        for (int k = 0; k < 8; k++) {
+            t[k] = tweak;
+            tweak = XtsMultSse(tweak);
+        }
+        for (int k = 0; k < 8; k++) {
+            const auto c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + off + 16 * k));
+            b[k] = _mm_xor_si128(_mm_xor_si128(c, t[k]), dec_keys[0]);
+        }
+        for (int r = 1; r < 10; r++) {
+            for (int k = 0; k < 8; k++) {
+                b[k] = _mm_aesdec_si128(b[k], dec_keys[r]);
+            }
+        }
+        for (int k = 0; k < 8; k++) {
+            b[k] = _mm_aesdeclast_si128(b[k], dec_keys[10]);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + off + 16 * k),
+                             _mm_xor_si128(b[k], t[k]));
+        }
+    }
+}
+
+TARGET_AES static void DecryptPFSAesNi(std::span<const CryptoPP::byte, 16> dataKey,
+                                       std::span<const CryptoPP::byte, 16> tweakKey,
+                                       std::span<const u8> src_image,
+                                       std::span<CryptoPP::byte> dst_image, u64 sector) {
+    __m128i tweak_keys[11];
+    __m128i enc_keys[11];
+    __m128i dec_keys[11];
+    Aes128ExpandKey(tweakKey.data(), tweak_keys);
+    Aes128ExpandKey(dataKey.data(), enc_keys);
+    dec_keys[0] = enc_keys[10];
+    for (int i = 1; i < 10; i++) {
+        dec_keys[i] = _mm_aesimc_si128(enc_keys[10 - i]);
+    }
+    dec_keys[10] = enc_keys[0];
+
+    for (u64 i = 0; i < src_image.size(); i += 0x1000) {
+        DecryptSectorAesNi(dec_keys, tweak_keys, src_image.data() + i, dst_image.data() + i,
+                           sector + i / 0x1000);
+    }
+}
+
+#endif // PFS_XTS_AESNI
+
 void Crypto::decryptPFS(std::span<const CryptoPP::byte, 16> dataKey,
                         std::span<const CryptoPP::byte, 16> tweakKey, std::span<const u8> src_image,
                         std::span<CryptoPP::byte> dst_image, u64 sector) {
+#ifdef PFS_XTS_AESNI
+    static const bool has_aesni = CheckAesNiSupport();
+    if (has_aesni) {
+        DecryptPFSAesNi(dataKey, tweakKey, src_image, dst_image, sector);
+        return;
+    }
+#endif
     // Start at 0x10000 to keep the header when decrypting the whole pfs_image.
     for (int i = 0; i < src_image.size(); i += 0x1000) {
         const u64 current_sector = sector + (i / 0x1000);
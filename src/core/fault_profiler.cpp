@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <map>
+#include <vector>
+#include "common/logging/log.h"
+#include "core/fault_profiler.h"
+#include "core/linker.h"
+#include "core/module.h"
+
+namespace Core {
+
+/// Finds the closest exported symbol at or below the address, for labelling hot
+/// fault sites inside a module.
+static const Loader::SymbolRecord* NearestExport(const Module& module, VAddr address) {
+    const Loader::SymbolRecord* best = nullptr;
+    for (const auto& record : module.export_sym.GetSymbols()) {
+        if (record.virtual_address <= address &&
+            (!best || record.virtual_address > best->virtual_address)) {
+            best = &record;
+        }
+    }
+    return best;
+}
+
+void FaultProfiler::Report(Linker* linker) const {
+    const u64 total = num_faults.load(std::memory_order_relaxed);
+    const u64 sampled = std::min(head.load(std::memory_order_relaxed), Capacity);
+    if (sampled == 0) {
+        return;
+    }
+
+    struct ModuleStats {
+        u64 count{};
+        std::map<VAddr, u64> rips;
+    };
+    std::map<std::string, ModuleStats> aggregated;
+
+    for (u64 i = 0; i < sampled; i++) {
+        const VAddr rip = samples[i].rip.load(std::memory_order_acquire);
+        Module* module = linker->FindByAddress(rip);
+        auto& stats = aggregated[module ? module->name : "<unknown>"];
+        stats.count++;
+        stats.rips[rip]++;
+    }
+
+    LOG_INFO(Core, "Guest write-protection faults: {} total, {} sampled (1/{})", total, sampled,
+             SampleInterval);
+    for (const auto& [name, stats] : aggregated) {
+        LOG_INFO(Core, "  {}: {:.1f}% of samples", name, 100.0 * stats.count / sampled);
+
+        // Show the three hottest fault sites of the module with symbol+offset.
+        std::vector<std::pair<VAddr, u64>> sites{stats.rips.begin(), stats.rips.end()};
+        std::ranges::sort(sites, std::ranges::greater{}, &std::pair<VAddr, u64>::second);
+        for (size_t n = 0; n < std::min<size_t>(sites.size(), 3); n++) {
+            const VAddr rip = sites[n].first;
+            Module* module = linker->FindByAddress(rip);
+            if (!module) {
+                LOG_INFO(Core, "    rip={:#x} ({} samples)", rip, sites[n].second);
+                continue;
+            }
+            const VAddr offset = rip - module->GetBaseAddress();
+            if (const auto* symbol = NearestExport(*module, rip)) {
+                LOG_INFO(Core, "    rip={:#x} base+{:#x} near {} ({} samples)", rip, offset,
+                         symbol->name, sites[n].second);
+            } else {
+                LOG_INFO(Core, "    rip={:#x} base+{:#x} ({} samples)", rip, offset,
+                         sites[n].second);
+            }
+        }
+    }
+}
+
+} // namespace Core
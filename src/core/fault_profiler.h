@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include "common/types.h"
+
+namespace Core {
+
+class Linker;
+
+/**
+ * Samples guest memory protection faults so invalidation storms can be
+ * attributed to the game code that causes them. Record() runs inside the
+ * fault handler and must stay async-signal-safe: it only performs lock-free
+ * atomic operations and plain stores into a fixed ring. Every Nth fault is
+ * kept; Report() aggregates the ring by guest module at shutdown.
+ */
+class FaultProfiler {
+public:
+    /// Records one protection fault. Signal-safe; keeps every Nth sample.
+    void Record(VAddr fault_address, VAddr fault_rip) {
+        const u64 count = num_faults.fetch_add(1, std::memory_order_relaxed);
+        if ((count & (SampleInterval - 1)) != 0) {
+            return;
+        }
+        const u64 slot = head.fetch_add(1, std::memory_order_relaxed) % Capacity;
+        samples[slot].address.store(fault_address, std::memory_order_relaxed);
+        samples[slot].rip.store(fault_rip, std::memory_order_release);
+    }
+
+    /// Aggregates the sampled faults by module and logs the breakdown.
+    void Report(Linker* linker) const;
+
+private:
+    static constexpr u64 Capacity = 4096;
+    static constexpr u64 SampleInterval = 16; // Must be a power of two.
+
+    struct Sample {
+        std::atomic<VAddr> address{};
+        std::atomic<VAddr> rip{};
+    };
+
+    std::array<Sample, Capacity> samples{};
+    std::atomic<u64> head{};
+    std::atomic<u64> num_faults{};
+};
+
+} // namespace Core
@@ -112,6 +112,7 @@ struct pfs_fs_table {
     std::string name;
     u32 inode;
     u32 type;
+    u32 parent; // Inode of the directory this entry was listed in.
 };
 
 struct Dirent {
@@ -1,6 +1,9 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <barrier>
+#include <thread>
 #include <zlib-ng.h>
 #include "common/io_file.h"
 #include "core/file_format/pkg.h"
@@ -182,8 +185,8 @@ bool PKG::Extract(const std::filesystem::path& filepath, const std::filesystem::
         out.Close();
 
         // Decrypt Np stuff and overwrite.
-        if (entry.id == 0x400 || entry.id == 0x401 || entry.id == 0x402 ||
-            entry.id == 0x403) { // somehow 0x401 is not decrypting
+        if (GetEntryClassByType(entry.id) ==
+            PkgEntryClass::License) { // somehow 0x401 is not decrypting
             decNp.resize(entry.size);
             std::span<u8> cipherNp(pkg.data() + entry.offset, entry.size);
             std::array<u8, 64> concatenated_ivkey_dk3_;
@@ -240,6 +243,7 @@ bool PKG::Extract(const std::filesystem::path& filepath, const std::filesystem::
 
     u32 ent_size = 0;
     u32 ndinode = 0;
+    u32 current_ino = 0;
     int ndinode_counter = 0;
     bool dinode_reached = false;
     bool uroot_reached = false;
@@ -261,6 +265,8 @@ bool PKG::Extract(const std::filesystem::path& filepath, const std::filesystem::
 
         if (i == 0) {
             std::memcpy(&ndinode, decompressedData.data() + 0x30, 4); // number of folders and files
+            extractPaths.clear();
+            extractPaths.resize(ndinode + 1);
         }
 
         int occupied_blocks =
@@ -327,16 +333,14 @@ bool PKG::Extract(const std::filesystem::path& filepath, const std::filesystem::
                 table.inode = dirent.ino;
                 table.type = dirent.type;
 
+                // Only record the parent pointer here; the paths are
+                // materialized in one pass once the walk is done.
                 if (table.type == PFS_CURRENT_DIR) {
-                    current_dir = extractPaths[table.inode];
+                    current_ino = table.inode;
                 }
-                extractPaths[table.inode] =
-                    current_dir.string() / std::filesystem::path(table.name);
+                table.parent = current_ino;
 
                 if (table.type == PFS_FILE || table.type == PFS_DIR) {
-                    if (table.type == PFS_DIR) { // Create dirs.
-                        std::filesystem::create_directory(extractPaths[table.inode]);
-                    }
                     ndinode_counter++;
                     if ((ndinode_counter + 1) == ndinode) // 1 for the image itself (root).
                         end_reached = true;
@@ -347,6 +351,23 @@ bool PKG::Extract(const std::filesystem::path& filepath, const std::filesystem::
             }
         }
     }
+
+    // Materialize every extraction path from the flat index. The dirent walk
+    // lists a directory before its children, so a single forward pass always
+    // finds the parent path already resolved; this replaces the per-entry
+    // reassembly that copied the whole parent path for every dirent.
+    for (const auto& entry : fsTable) {
+        if (entry.type != PFS_FILE && entry.type != PFS_DIR) {
+            continue;
+        }
+        if (entry.inode >= extractPaths.size() || entry.parent >= extractPaths.size()) {
+            continue;
+        }
+        extractPaths[entry.inode] = extractPaths[entry.parent] / entry.name;
+        if (entry.type == PFS_DIR) { // Create dirs.
+            std::filesystem::create_directory(extractPaths[entry.inode]);
+        }
+    }
     return true;
 }
 
@@ -355,61 +376,113 @@ void PKG::ExtractFiles(const int& index) {
     int inode_type = fsTable[index].type;
     std::string inode_name = fsTable[index].name;
 
-    if (inode_type == PFS_FILE) {
-        int sector_loc = iNodeBuf[inode_number].loc;
-        int nblocks = iNodeBuf[inode_number].Blocks;
-        int bsize = iNodeBuf[inode_number].Size;
+    if (inode_type != PFS_FILE) {
+        return;
+    }
 
-        Common::FS::IOFile inflated;
-        inflated.Open(extractPaths[inode_number].string(), Common::FS::FileAccessMode::Write);
+    int sector_loc = iNodeBuf[inode_number].loc;
+    int nblocks = iNodeBuf[inode_number].Blocks;
+    int bsize = iNodeBuf[inode_number].Size;
 
-        Common::FS::IOFile pkgFile; // Open the file for each iteration to avoid conflict.
-        pkgFile.Open(pkgpath, Common::FS::FileAccessMode::Read);
+    Common::FS::IOFile inflated;
+    inflated.Open(extractPaths[inode_number].string(), Common::FS::FileAccessMode::Write);
 
-        int size_decompressed = 0;
+    // Scratch state owned by one decrypt worker. Every worker opens its own handle
+    // on the pkg file to avoid conflict.
+    struct WorkerContext {
+        Common::FS::IOFile pkg_file;
         std::vector<char> compressedData;
-        std::vector<char> decompressedData(0x10000);
+        std::vector<u8> pfsc;
+        std::vector<u8> pfs_decrypted;
+
+        explicit WorkerContext(const std::filesystem::path& pkgpath) {
+            u64 pfsc_buf_size = 0x11000; // extra 0x1000
+            pkg_file.Open(pkgpath, Common::FS::FileAccessMode::Read);
+            pfsc.resize(pfsc_buf_size);
+            pfs_decrypted.resize(pfsc_buf_size);
+        }
+    };
+
+    // Reads, decrypts and decompresses a single 0x10000 block of the file.
+    const auto extract_block = [&](WorkerContext& ctx, int j, std::span<char> decompressedData) {
+        u64 sectorOffset = sectorMap[sector_loc + j]; // offset into PFSC_image and not pfs_image.
+        u64 sectorSize = sectorMap[sector_loc + j + 1] -
+                         sectorOffset; // indicates if data is compressed or not.
+        u64 fileOffset = (pkgheader.pfs_image_offset + pfsc_offset + sectorOffset);
+        u64 currentSector1 =
+            (pfsc_offset + sectorOffset) / 0x1000; // block size is 0x1000 for xts decryption.
+
+        int sectorOffsetMask = (sectorOffset + pfsc_offset) & 0xFFFFF000;
+        int previousData = (sectorOffset + pfsc_offset) - sectorOffsetMask;
+
+        ctx.pkg_file.Seek(fileOffset - previousData);
+        ctx.pkg_file.Read(ctx.pfsc);
 
-        u64 pfsc_buf_size = 0x11000; // extra 0x1000
-        std::vector<u8> pfsc(pfsc_buf_size);
-        std::vector<u8> pfs_decrypted(pfsc_buf_size);
+        PKG::crypto.decryptPFS(dataKey, tweakKey, ctx.pfsc, ctx.pfs_decrypted, currentSector1);
 
+        ctx.compressedData.resize(sectorSize);
+        std::memcpy(ctx.compressedData.data(), ctx.pfs_decrypted.data() + previousData, sectorSize);
+
+        if (sectorSize == 0x10000) // Uncompressed data
+            std::memcpy(decompressedData.data(), ctx.compressedData.data(), 0x10000);
+        else if (sectorSize < 0x10000) // Compressed data
+            DecompressPFSC(ctx.compressedData, decompressedData);
+    };
+
+    const auto write_block = [&](const char* data, int j) {
+        if (j < nblocks - 1) {
+            inflated.WriteRaw<u8>(data, 0x10000);
+        } else {
+            // This is to remove the zeros at the end of the file.
+            const u32 write_size = 0x10000 - (nblocks * 0x10000 - bsize);
+            inflated.WriteRaw<u8>(data, write_size);
+        }
+    };
+
+    // The installer already extracts several files at once, so keep the per-file
+    // worker count modest.
+    const int num_workers = std::clamp(static_cast<int>(std::thread::hardware_concurrency()), 1, 8);
+
+    if (num_workers == 1 || nblocks < num_workers * 2) {
+        // Small file, the pipeline would only add overhead.
+        WorkerContext ctx(pkgpath);
+        std::vector<char> decompressedData(0x10000);
         for (int j = 0; j < nblocks; j++) {
-            u64 sectorOffset =
-                sectorMap[sector_loc + j]; // offset into PFSC_image and not pfs_image.
-            u64 sectorSize = sectorMap[sector_loc + j + 1] -
-                             sectorOffset; // indicates if data is compressed or not.
-            u64 fileOffset = (pkgheader.pfs_image_offset + pfsc_offset + sectorOffset);
-            u64 currentSector1 =
-                (pfsc_offset + sectorOffset) / 0x1000; // block size is 0x1000 for xts decryption.
-
-            int sectorOffsetMask = (sectorOffset + pfsc_offset) & 0xFFFFF000;
-            int previousData = (sectorOffset + pfsc_offset) - sectorOffsetMask;
-
-            pkgFile.Seek(fileOffset - previousData);
-            pkgFile.Read(pfsc);
-
-            PKG::crypto.decryptPFS(dataKey, tweakKey, pfsc, pfs_decrypted, currentSector1);
-
-            compressedData.resize(sectorSize);
-            std::memcpy(compressedData.data(), pfs_decrypted.data() + previousData, sectorSize);
-
-            if (sectorSize == 0x10000) // Uncompressed data
-                std::memcpy(decompressedData.data(), compressedData.data(), 0x10000);
-            else if (sectorSize < 0x10000) // Compressed data
-                DecompressPFSC(compressedData, decompressedData);
-
-            size_decompressed += 0x10000;
-
-            if (j < nblocks - 1) {
-                inflated.WriteRaw<u8>(decompressedData.data(), decompressedData.size());
-            } else {
-                // This is to remove the zeros at the end of the file.
-                const u32 write_size = decompressedData.size() - (size_decompressed - bsize);
-                inflated.WriteRaw<u8>(decompressedData.data(), write_size);
+            extract_block(ctx, j, decompressedData);
+            write_block(decompressedData.data(), j);
+        }
+    } else {
+        // Every round each decrypt worker fills its slot with one block, then the
+        // calling thread flushes the slots to disk in order while the workers wait.
+        std::barrier round_barrier(num_workers + 1);
+        std::vector<std::vector<char>> slots(num_workers, std::vector<char>(0x10000));
+        const int num_rounds = (nblocks + num_workers - 1) / num_workers;
+
+        std::vector<std::jthread> workers;
+        workers.reserve(num_workers);
+        for (int t = 0; t < num_workers; t++) {
+            workers.emplace_back([&, t] {
+                WorkerContext ctx(pkgpath);
+                for (int round = 0; round < num_rounds; round++) {
+                    const int j = round * num_workers + t;
+                    if (j < nblocks) {
+                        extract_block(ctx, j, slots[t]);
+                    }
+                    round_barrier.arrive_and_wait(); // Blocks are ready.
+                    round_barrier.arrive_and_wait(); // Writer is done with the slots.
+                }
+            });
+        }
+
+        for (int round = 0; round < num_rounds; round++) {
+            round_barrier.arrive_and_wait();
+            const int base = round * num_workers;
+            for (int t = 0; t < num_workers && base + t < nblocks; t++) {
+                write_block(slots[t].data(), base + t);
             }
+            round_barrier.arrive_and_wait();
         }
-        pkgFile.Close();
-        inflated.Close();
     }
+
+    inflated.Close();
 }
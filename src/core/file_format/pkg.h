@@ -155,7 +155,9 @@ private:
     PKGHeader pkgheader;
     std::string pkgFlags;
 
-    std::unordered_map<int, std::filesystem::path> extractPaths;
+    // Indexed by inode number; materialized in one pass from the flat dirent
+    // index after the PFS walk.
+    std::vector<std::filesystem::path> extractPaths;
     std::vector<pfs_fs_table> fsTable;
     std::vector<Inode> iNodeBuf;
     std::vector<u64> sectorMap;
@@ -170,6 +172,5 @@ private:
     std::vector<u8> decNp;
 
     std::filesystem::path pkgpath;
-    std::filesystem::path current_dir;
     std::filesystem::path extract_path;
 };
@@ -628,6 +628,11 @@ constexpr static std::array<PkgEntryValue, 611> PkgEntries = {{
     {0x17F9, "keymap_rp/30/010.png"},
 }};
 
+// The lookup below relies on the table being ordered by type; catch a
+// misplaced insertion at compile time rather than with a silent miss.
+static_assert(std::ranges::is_sorted(PkgEntries, {}, &PkgEntryValue::type),
+              "PkgEntries must be sorted by type");
+
 std::string_view GetEntryNameByType(u32 type) {
     const auto key = PkgEntryValue{type};
     const auto it = std::ranges::lower_bound(PkgEntries, key);
@@ -636,3 +641,20 @@ std::string_view GetEntryNameByType(u32 type) {
     }
     return "";
 }
+
+PkgEntryClass GetEntryClassByType(u32 type) {
+    switch (type) {
+    case 0x0001: // digests
+    case 0x0010: // entry_keys
+    case 0x0020: // image_key
+    case 0x0080: // general_digests
+        return PkgEntryClass::KeyMaterial;
+    case 0x0400: // license.dat
+    case 0x0401: // license.info
+    case 0x0402: // nptitle.dat
+    case 0x0403: // npbind.dat
+        return PkgEntryClass::License;
+    default:
+        return PkgEntryClass::PlainFile;
+    }
+}
@@ -8,3 +8,15 @@
 
 /// Retrieves the PKG entry name from its type identifier.
 std::string_view GetEntryNameByType(u32 type);
+
+/// Broad handling class of a PKG entry during extraction.
+enum class PkgEntryClass {
+    KeyMaterial, ///< Digest and key entries consumed by the crypto setup.
+    License,     ///< Np license files that are decrypted after extraction.
+    PlainFile,   ///< Entries copied to sce_sys verbatim.
+};
+
+/// Groups an entry type by how extraction has to handle it, letting an
+/// extractor partition the entry table up front instead of re-testing raw ids
+/// inline.
+PkgEntryClass GetEntryClassByType(u32 type);
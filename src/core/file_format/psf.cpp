@@ -27,8 +27,8 @@ bool PSF::open(const std::string& filepath, std::vector<u8> psfBuffer) {
     }
 
     // Parse file contents
-    PSFHeader header;
     std::memcpy(&header, psf.data(), sizeof(header));
+    dirty = false;
     for (u32 i = 0; i < header.index_table_entries; i++) {
         PSFEntry entry;
         std::memcpy(&entry, &psf[sizeof(PSFHeader) + i * sizeof(PSFEntry)], sizeof(entry));
@@ -60,3 +60,66 @@ u32 PSF::GetInteger(const std::string& key) {
     }
     return -1;
 }
+
+PSFEntry* PSF::FindEntry(const std::string& key) {
+    for (u32 i = 0; i < header.index_table_entries; i++) {
+        auto* entry = reinterpret_cast<PSFEntry*>(&psf[sizeof(PSFHeader) + i * sizeof(PSFEntry)]);
+        if (key == (char*)&psf[header.key_table_offset + entry->key_offset]) {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+bool PSF::SetString(const std::string& key, const std::string& value) {
+    PSFEntry* entry = FindEntry(key);
+    if (!entry ||
+        (entry->param_fmt != PSFEntry::Fmt::TextRaw && entry->param_fmt != PSFEntry::Fmt::TextNormal)) {
+        return false;
+    }
+    const bool terminated = entry->param_fmt == PSFEntry::Fmt::TextNormal;
+    const u32 needed = static_cast<u32>(value.size()) + (terminated ? 1 : 0);
+    if (needed > entry->param_max_len) {
+        // The string outgrew its reserved space; append fresh space at the end of
+        // the data table and retarget the entry, leaving every other entry where
+        // it is. The old bytes stay behind as a hole.
+        entry->data_offset = static_cast<u32>(psf.size()) - header.data_table_offset;
+        entry->param_max_len = needed;
+        psf.resize(psf.size() + needed);
+        // The table may have reallocated; relocate the entry before patching it.
+        entry = FindEntry(key);
+    }
+    u8* data = &psf[header.data_table_offset + entry->data_offset];
+    std::memset(data, 0, entry->param_max_len);
+    std::memcpy(data, value.data(), value.size());
+    entry->param_len = needed;
+    map_strings[key] = value;
+    dirty = true;
+    return true;
+}
+
+bool PSF::SetInteger(const std::string& key, u32 value) {
+    PSFEntry* entry = FindEntry(key);
+    if (!entry || entry->param_fmt != PSFEntry::Fmt::Integer) {
+        return false;
+    }
+    std::memcpy(&psf[header.data_table_offset + entry->data_offset], &value, sizeof(value));
+    map_integers[key] = value;
+    dirty = true;
+    return true;
+}
+
+bool PSF::encode(const std::string& filepath) {
+    if (!dirty) {
+        return true;
+    }
+    Common::FS::IOFile file(filepath, Common::FS::FileAccessMode::Write);
+    if (!file.IsOpen()) {
+        return false;
+    }
+    if (file.Write(psf) != psf.size()) {
+        return false;
+    }
+    dirty = false;
+    return true;
+}
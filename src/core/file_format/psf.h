@@ -40,9 +40,24 @@ public:
     std::string GetString(const std::string& key);
     u32 GetInteger(const std::string& key);
 
+    // Updates an existing entry by patching the retained file image in place.
+    // A string that outgrew the space reserved for it is appended to the end of
+    // the data table instead, so no other entry has to move. Returns false for
+    // keys the file does not contain.
+    bool SetString(const std::string& key, const std::string& value);
+    bool SetInteger(const std::string& key, u32 value);
+
+    // Writes the file image back, skipped entirely when no entry changed since
+    // it was opened or last encoded.
+    bool encode(const std::string& filepath);
+
     std::unordered_map<std::string, std::string> map_strings;
     std::unordered_map<std::string, u32> map_integers;
 
 private:
+    PSFEntry* FindEntry(const std::string& key);
+
     std::vector<u8> psf;
+    PSFHeader header{};
+    bool dirty{};
 };
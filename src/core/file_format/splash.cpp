@@ -5,6 +5,8 @@
 
 #include "common/assert.h"
 #include "common/io_file.h"
+#include "common/logging/log.h"
+#include "common/thread.h"
 #include "splash.h"
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -26,17 +28,25 @@ bool Splash::Open(const std::string& filepath) {
     file.Seek(0);
     file.Read(png_file);
 
-    auto* img_mem = stbi_load_from_memory(png_file.data(), png_file.size(),
-                                          reinterpret_cast<int*>(&img_info.width),
-                                          reinterpret_cast<int*>(&img_info.height),
-                                          reinterpret_cast<int*>(&img_info.num_channels), 4);
-    if (!img_mem) {
-        return false;
-    }
-
-    const auto img_size = img_info.GetSizeBytes();
-    img_data.resize(img_size);
-    std::memcpy(img_data.data(), img_mem, img_size);
-    stbi_image_free(img_mem);
+    // Decode off-thread; a full-resolution PNG takes long enough that doing it
+    // inline delays the first presented frame. The presenter polls IsLoaded()
+    // and simply skips the splash until the data is ready.
+    decode_thread = std::jthread([this, png_file = std::move(png_file), filepath] {
+        Common::SetCurrentThreadName("shadPS4:SplashDecode");
+        auto* img_mem = stbi_load_from_memory(png_file.data(), png_file.size(),
+                                              reinterpret_cast<int*>(&img_info.width),
+                                              reinterpret_cast<int*>(&img_info.height),
+                                              reinterpret_cast<int*>(&img_info.num_channels), 4);
+        if (!img_mem) {
+            LOG_ERROR(Loader, "Failed to decode splash image {}", filepath);
+            return;
+        }
+
+        const auto img_size = img_info.GetSizeBytes();
+        img_data.resize(img_size);
+        std::memcpy(img_data.data(), img_mem, img_size);
+        stbi_image_free(img_mem);
+        loaded.store(true, std::memory_order_release);
+    });
     return true;
 }
@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
+#include <thread>
 #include <vector>
 #include "common/types.h"
 
@@ -22,9 +24,19 @@ public:
     Splash() = default;
     ~Splash() = default;
 
+    /// Reads the file and queues the PNG decode on a worker thread, so boot is
+    /// not stalled behind it. Returns false when the file cannot be read.
     bool Open(const std::string& filepath);
+
+    /// Returns true once a decode has been queued or finished, so callers do
+    /// not start a second one for another candidate image.
+    [[nodiscard]] bool IsQueued() const {
+        return decode_thread.joinable() || IsLoaded();
+    }
+
+    /// Image data and info may only be read once this returns true.
     [[nodiscard]] bool IsLoaded() const {
-        return img_data.size();
+        return loaded.load(std::memory_order_acquire);
     }
 
     const auto& GetImageData() const {
@@ -38,4 +50,6 @@ public:
 private:
     ImageInfo img_info{};
     std::vector<u8> img_data{};
+    std::atomic_bool loaded{};
+    std::jthread decode_thread;
 };
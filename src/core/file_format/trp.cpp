@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include "trp.h"
 
 TRP::TRP() = default;
@@ -27,8 +28,9 @@ static void removePadding(std::vector<u8>& vec) {
     }
 }
 
-bool TRP::Extract(std::filesystem::path trophyPath) {
-    std::string title = trophyPath.filename().string();
+bool TRP::Open(std::filesystem::path trophyPath) {
+    toc.clear();
+    entry_cache.clear();
     std::filesystem::path gameSysDir = trophyPath / "sce_sys/trophy/";
     if (!std::filesystem::exists(gameSysDir)) {
         return false;
@@ -47,45 +49,90 @@ bool TRP::Extract(std::filesystem::path trophyPath) {
             if (header.magic != 0xDCA24D00)
                 return false;
 
+            // Only the table of contents is read here; payloads stay on disk
+            // until an entry is actually requested.
             s64 seekPos = sizeof(TrpHeader);
-            std::filesystem::path trpFilesPath(std::filesystem::current_path() / "game_data" /
-                                               title / "TrophyFiles" / it.path().stem());
-            std::filesystem::create_directories(trpFilesPath / "Icons");
-            std::filesystem::create_directory(trpFilesPath / "Xml");
-
             for (int i = 0; i < header.entry_num; i++) {
                 file.Seek(seekPos);
                 seekPos += (s64)header.entry_size;
                 TrpEntry entry;
                 file.Read(entry);
-                std::string_view name(entry.entry_name);
-                if (entry.flag == 0 && name.find("TROP") != std::string::npos) { // PNG
-                    file.Seek(entry.entry_pos);
-                    std::vector<u8> icon(entry.entry_len);
-                    file.Read(icon);
-                    Common::FS::IOFile::WriteBytes(trpFilesPath / "Icons" / name, icon);
-                }
-                if (entry.flag == 3 && np_comm_id[0] == 'N' &&
-                    np_comm_id[1] == 'P') { // ESFM, encrypted.
-                    file.Seek(entry.entry_pos);
-                    file.Read(esfmIv); // get iv key.
-                    // Skip the first 16 bytes which are the iv key on every entry as we want a
-                    // clean xml file.
-                    std::vector<u8> ESFM(entry.entry_len - iv_len);
-                    std::vector<u8> XML(entry.entry_len - iv_len);
-                    file.Seek(entry.entry_pos + iv_len);
-                    file.Read(ESFM);
-                    crypto.decryptEFSM(np_comm_id, esfmIv, ESFM, XML); // decrypt
-                    removePadding(XML);
-                    std::string xml_name = entry.entry_name;
-                    size_t pos = xml_name.find("ESFM");
-                    if (pos != std::string::npos)
-                        xml_name.replace(pos, xml_name.length(), "XML");
-                    Common::FS::IOFile::WriteBytes(trpFilesPath / "Xml" / xml_name, XML);
-                }
+                toc.push_back({
+                    .trp_file = it.path(),
+                    .trp_stem = it.path().stem().string(),
+                    .name = std::string{std::string_view(entry.entry_name)},
+                    .pos = entry.entry_pos,
+                    .len = entry.entry_len,
+                    .flag = entry.flag,
+                    .np_comm_id = np_comm_id,
+                });
             }
         }
         index++;
     }
     return true;
-}
\ No newline at end of file
+}
+
+std::vector<u8> TRP::ReadEntry(const TocEntry& entry) {
+    Common::FS::IOFile file(entry.trp_file, Common::FS::FileAccessMode::Read);
+    if (!file.IsOpen()) {
+        return {};
+    }
+    if (entry.flag == 3) { // ESFM, encrypted.
+        file.Seek(entry.pos);
+        file.Read(esfmIv); // get iv key.
+        // Skip the first 16 bytes which are the iv key on every entry as we want a
+        // clean xml file.
+        std::vector<u8> ESFM(entry.len - iv_len);
+        std::vector<u8> XML(entry.len - iv_len);
+        file.Seek(entry.pos + iv_len);
+        file.Read(ESFM);
+        std::array<u8, 16> comm_id = entry.np_comm_id;
+        crypto.decryptEFSM(comm_id, esfmIv, ESFM, XML); // decrypt
+        removePadding(XML);
+        return XML;
+    }
+    file.Seek(entry.pos);
+    std::vector<u8> data(entry.len);
+    file.Read(data);
+    return data;
+}
+
+const std::vector<u8>* TRP::GetEntry(const std::string& name) {
+    if (const auto it = entry_cache.find(name); it != entry_cache.end()) {
+        return &it->second;
+    }
+    const auto it = std::ranges::find(toc, name, &TocEntry::name);
+    if (it == toc.end()) {
+        return nullptr;
+    }
+    if (entry_cache.size() >= max_cached_entries) {
+        entry_cache.erase(entry_cache.begin());
+    }
+    return &entry_cache.emplace(name, ReadEntry(*it)).first->second;
+}
+
+bool TRP::Extract(std::filesystem::path trophyPath) {
+    if (!Open(trophyPath)) {
+        return false;
+    }
+    std::string title = trophyPath.filename().string();
+    for (const TocEntry& entry : toc) {
+        std::filesystem::path trpFilesPath(std::filesystem::current_path() / "game_data" / title /
+                                           "TrophyFiles" / entry.trp_stem);
+        std::filesystem::create_directories(trpFilesPath / "Icons");
+        std::filesystem::create_directory(trpFilesPath / "Xml");
+
+        if (entry.flag == 0 && entry.name.find("TROP") != std::string::npos) { // PNG
+            Common::FS::IOFile::WriteBytes(trpFilesPath / "Icons" / entry.name, ReadEntry(entry));
+        }
+        if (entry.flag == 3 && entry.np_comm_id[0] == 'N' && entry.np_comm_id[1] == 'P') {
+            std::string xml_name = entry.name;
+            size_t pos = xml_name.find("ESFM");
+            if (pos != std::string::npos)
+                xml_name.replace(pos, xml_name.length(), "XML");
+            Common::FS::IOFile::WriteBytes(trpFilesPath / "Xml" / xml_name, ReadEntry(entry));
+        }
+    }
+    return true;
+}
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <string>
+#include <unordered_map>
 #include <vector>
 #include "common/endian.h"
 #include "common/io_file.h"
@@ -33,14 +35,38 @@ class TRP {
 public:
     TRP();
     ~TRP();
+
+    /// Parses only the table of contents of every TRP file under the title;
+    /// entry payloads stay on disk until requested.
+    bool Open(std::filesystem::path trophyPath);
+
+    /// Returns the decoded contents of a TOC entry, reading and decrypting it
+    /// on first access. Returns nullptr when the entry is unknown.
+    const std::vector<u8>* GetEntry(const std::string& name);
+
     bool Extract(std::filesystem::path trophyPath);
     void GetNPcommID(std::filesystem::path trophyPath, int index);
 
 private:
+    struct TocEntry {
+        std::filesystem::path trp_file;
+        std::string trp_stem;
+        std::string name;
+        u64 pos;
+        u64 len;
+        u32 flag;
+        std::array<u8, 16> np_comm_id;
+    };
+
+    std::vector<u8> ReadEntry(const TocEntry& entry);
+
     Crypto crypto;
     std::vector<u8> NPcommID = std::vector<u8>(12);
     std::array<u8, 16> np_comm_id{};
     std::array<u8, 16> esfmIv{};
     std::filesystem::path trpFilesPath;
+    std::vector<TocEntry> toc;
+    std::unordered_map<std::string, std::vector<u8>> entry_cache;
     static constexpr int iv_len = 16;
-};
\ No newline at end of file
+    static constexpr size_t max_cached_entries = 16;
+};
@@ -18,6 +18,8 @@ void MntPoints::Mount(const std::filesystem::path& host_folder, const std::strin
     pair.guest_path = guest_folder;
 
     m_mnt_pairs.push_back(pair);
+    m_path_cache.clear();
+    m_path_lru.clear();
 }
 
 void MntPoints::Unmount(const std::string& path) {} // TODO!
@@ -25,6 +27,9 @@ void MntPoints::Unmount(const std::string& path) {} // TODO!
 void MntPoints::UnmountAll() {
     std::scoped_lock lock{m_mutex};
     m_mnt_pairs.clear();
+    m_image_mounts.clear();
+    m_path_cache.clear();
+    m_path_lru.clear();
 }
 
 std::string MntPoints::GetHostDirectory(const std::string& guest_directory) {
@@ -45,6 +50,22 @@ std::string MntPoints::GetHostDirectory(const std::string& guest_directory) {
 std::string MntPoints::GetHostFile(const std::string& guest_file) {
     std::scoped_lock lock{m_mutex};
 
+    if (const auto it = m_path_cache.find(guest_file); it != m_path_cache.end()) {
+        m_path_lru.splice(m_path_lru.begin(), m_path_lru, it->second);
+        return it->second->second;
+    }
+
+    auto host_file = TranslateHostFile(guest_file);
+    if (m_path_cache.size() >= MaxCachedPaths) {
+        m_path_cache.erase(m_path_lru.back().first);
+        m_path_lru.pop_back();
+    }
+    m_path_lru.emplace_front(guest_file, host_file);
+    m_path_cache.emplace(guest_file, m_path_lru.begin());
+    return host_file;
+}
+
+std::string MntPoints::TranslateHostFile(const std::string& guest_file) {
     for (auto& pair : m_mnt_pairs) {
         // horrible code but it works :D
         int find = guest_file.find(pair.guest_path);
@@ -70,6 +91,41 @@ std::string MntPoints::GetHostFile(const std::string& guest_file) {
     return "";
 }
 
+HandleTable::~HandleTable() {
+    for (auto& slot : m_files) {
+        delete slot.load(std::memory_order_relaxed);
+    }
+    for (auto* file : m_retired) {
+        delete file;
+    }
+}
+
+bool MntPoints::MountImage(const std::filesystem::path& image_path,
+                           const std::string& guest_folder) {
+    auto driver = std::make_unique<PfsDriver>();
+    if (!driver->Load(image_path)) {
+        return false;
+    }
+    std::scoped_lock lock{m_mutex};
+    m_image_mounts.push_back({guest_folder, std::move(driver)});
+    return true;
+}
+
+std::pair<PfsDriver*, std::string> MntPoints::GetPfsFile(const std::string& guest_file) {
+    std::scoped_lock lock{m_mutex};
+    for (auto& mount : m_image_mounts) {
+        if (guest_file.find(mount.guest_path) != 0) {
+            continue;
+        }
+        std::string rel = guest_file.substr(mount.guest_path.size());
+        while (!rel.empty() && rel.front() == '/') {
+            rel.erase(rel.begin());
+        }
+        return {mount.driver.get(), rel};
+    }
+    return {nullptr, ""};
+}
+
 int HandleTable::CreateHandle() {
     std::scoped_lock lock{m_mutex};
 
@@ -77,33 +133,41 @@ int HandleTable::CreateHandle() {
     file->is_directory = false;
     file->is_opened = false;
 
-    int existingFilesNum = m_files.size();
-
-    for (int index = 0; index < existingFilesNum; index++) {
-        if (m_files.at(index) == nullptr) {
-            m_files[index] = file;
-            return index + RESERVED_HANDLES;
+    for (size_t index = 0; index < m_files.size(); index++) {
+        if (m_files[index].load(std::memory_order_relaxed) == nullptr) {
+            m_files[index].store(file, std::memory_order_release);
+            return static_cast<int>(index) + RESERVED_HANDLES;
         }
     }
 
-    m_files.push_back(file);
-    return m_files.size() + RESERVED_HANDLES - 1;
+    delete file;
+    return -1;
 }
 
 void HandleTable::DeleteHandle(int d) {
     std::scoped_lock lock{m_mutex};
-    delete m_files.at(d - RESERVED_HANDLES);
-    m_files[d - RESERVED_HANDLES] = nullptr;
+    // Publish the slot as free, then retire the file instead of freeing it so
+    // an IO thread that looked the descriptor up just before the close can
+    // still complete its operation. The retirement ring keeps the file alive
+    // well past any such in-flight call before it is reclaimed.
+    auto* file = m_files[d - RESERVED_HANDLES].exchange(nullptr, std::memory_order_acq_rel);
+    delete m_retired[m_retired_index];
+    m_retired[m_retired_index] = file;
+    m_retired_index = (m_retired_index + 1) % m_retired.size();
 }
 
 File* HandleTable::GetFile(int d) {
-    std::scoped_lock lock{m_mutex};
-    return m_files.at(d - RESERVED_HANDLES);
+    const int index = d - RESERVED_HANDLES;
+    if (index < 0 || index >= static_cast<int>(m_files.size())) {
+        return nullptr;
+    }
+    return m_files[index].load(std::memory_order_acquire);
 }
 
 File* HandleTable::getFile(const std::string& host_name) {
     std::scoped_lock lock{m_mutex};
-    for (auto* file : m_files) {
+    for (auto& slot : m_files) {
+        auto* file = slot.load(std::memory_order_relaxed);
         if (file != nullptr && file->m_host_name == host_name) {
             return file;
         }
@@ -3,11 +3,17 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <list>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include "common/io_file.h"
+#include "core/file_sys/pfs_driver.h"
+#include "core/file_sys/save_committer.h"
 
 namespace Core::FileSys {
 
@@ -27,8 +33,31 @@ public:
     std::string GetHostDirectory(const std::string& guest_directory);
     std::string GetHostFile(const std::string& guest_file);
 
+    /// Mounts a decrypted PFS image at the guest folder; lookups that miss the
+    /// host directory are served straight from the image.
+    bool MountImage(const std::filesystem::path& image_path, const std::string& guest_folder);
+
+    /// Returns the driver and image-relative path for a guest file covered by
+    /// an image mount, or {nullptr, ""} when none applies.
+    std::pair<PfsDriver*, std::string> GetPfsFile(const std::string& guest_file);
+
 private:
+    std::string TranslateHostFile(const std::string& guest_file);
+
+    // Guest->host translations are cached LRU, including negative results ("")
+    // since some titles probe missing files constantly. Mount changes flush it.
+    static constexpr size_t MaxCachedPaths = 1024;
+    using PathCacheList = std::list<std::pair<std::string, std::string>>;
+
+    struct ImageMount {
+        std::string guest_path;
+        std::unique_ptr<PfsDriver> driver;
+    };
+
     std::vector<MntPair> m_mnt_pairs;
+    std::vector<ImageMount> m_image_mounts;
+    PathCacheList m_path_lru;
+    std::unordered_map<std::string, PathCacheList::iterator> m_path_cache;
     std::mutex m_mutex;
 };
 
@@ -37,6 +66,20 @@ struct DirEntry {
     bool isFile;
 };
 
+/// Per-file readahead state managed by ReadaheadEngine. The prefetched window
+/// lives in buffer and covers [buffer_offset, buffer_offset + buffer_size).
+struct FileReadahead {
+    std::mutex mutex;
+    std::vector<u8> buffer;
+    u64 buffer_offset{};
+    u64 buffer_size{};
+    u64 last_read_end{};
+    u32 sequential_streak{};
+    std::atomic_bool prefetch_pending{};
+    // Separate host handle so prefetch never contends with the guest's reads.
+    Common::FS::IOFile host_file;
+};
+
 struct File {
     std::atomic_bool is_opened{};
     std::atomic_bool is_directory{};
@@ -46,20 +89,38 @@ struct File {
     std::vector<DirEntry> dirents;
     u32 dirents_index;
     std::mutex m_mutex;
+    FileReadahead readahead;
+    // Set when the file is backed by a mounted PFS image instead of a host file.
+    PfsDriver* pfs{};
+    u32 pfs_inode{};
+    u64 pfs_offset{};
+    // Set when the file lives under a savedata mount; IO then goes through the
+    // write-behind overlay instead of the host file.
+    std::unique_ptr<SaveBuffer> save;
 };
 
 class HandleTable {
 public:
     HandleTable() = default;
-    virtual ~HandleTable() = default;
+    virtual ~HandleTable();
 
     int CreateHandle();
     void DeleteHandle(int d);
+
+    /// Resolves a descriptor without taking the table mutex, so concurrent
+    /// read/write/seek calls from the guest's IO threads never serialize here.
     File* GetFile(int d);
     File* getFile(const std::string& host_name);
 
 private:
-    std::vector<File*> m_files;
+    static constexpr size_t MaxHandles = 1024;
+    // Closed files are parked here instead of freed immediately so a reader
+    // that resolved the descriptor right before the close can finish with it.
+    static constexpr size_t NumRetiredFiles = 16;
+
+    std::array<std::atomic<File*>, MaxHandles> m_files{};
+    std::array<File*, NumRetiredFiles> m_retired{};
+    size_t m_retired_index = 0;
     std::mutex m_mutex;
 };
 
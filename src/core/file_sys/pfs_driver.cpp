@@ -0,0 +1,233 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <span>
+#include <zlib-ng.h>
+#include "common/logging/log.h"
+#include "core/file_sys/pfs_driver.h"
+
+namespace Core::FileSys {
+
+static void DecompressPFSC(std::span<const char> compressed_data,
+                           std::span<char> decompressed_data) {
+    zng_stream decompress_stream{};
+    decompress_stream.zalloc = Z_NULL;
+    decompress_stream.zfree = Z_NULL;
+    decompress_stream.opaque = Z_NULL;
+
+    if (zng_inflateInit(&decompress_stream) != Z_OK) {
+        return;
+    }
+    decompress_stream.avail_in = compressed_data.size();
+    decompress_stream.next_in = reinterpret_cast<const Bytef*>(compressed_data.data());
+    decompress_stream.avail_out = decompressed_data.size();
+    decompress_stream.next_out = reinterpret_cast<Bytef*>(decompressed_data.data());
+    zng_inflate(&decompress_stream, Z_FINISH);
+    zng_inflateEnd(&decompress_stream);
+}
+
+PfsDriver::PfsDriver() = default;
+PfsDriver::~PfsDriver() = default;
+
+bool PfsDriver::Load(const std::filesystem::path& image_path) {
+    image.Open(image_path, Common::FS::FileAccessMode::Read);
+    if (!image.IsOpen()) {
+        return false;
+    }
+
+    // Locate the PFSC container within the image.
+    static constexpr u32 PfscMagic = 0x43534650;
+    const u64 image_size = image.GetSize();
+    pfsc_base = 0;
+    for (u64 i = 0x20000; i + sizeof(u32) <= image_size; i += 0x10000) {
+        u32 magic{};
+        image.Seek(i);
+        image.Read(magic);
+        if (magic == PfscMagic) {
+            pfsc_base = i;
+            break;
+        }
+    }
+    if (pfsc_base == 0) {
+        LOG_ERROR(Kernel_Fs, "No PFSC container in {}", image_path.string());
+        return false;
+    }
+
+    image.Seek(pfsc_base);
+    image.Read(hdr);
+
+    const u64 num_blocks = static_cast<u64>(hdr.data_length / hdr.block_sz2);
+    sector_map.resize(num_blocks + 1); // Extra entry to get the last sector's size.
+    image.Seek(pfsc_base + hdr.block_offsets);
+    image.Read(sector_map);
+
+    sector_cache.resize(SectorSize);
+    compressed_scratch.resize(SectorSize);
+
+    // Walk the metadata sectors exactly like PKG::Extract does: the inode
+    // table first, then the dirent blocks that map names to inodes.
+    u32 ndinode = 0;
+    int ndinode_counter = 0;
+    bool dinode_reached = false;
+    bool uroot_reached = false;
+    u32 ent_size = 0;
+    std::unordered_map<u32, std::string> inode_paths;
+    std::string current_dir;
+
+    for (u64 i = 0; i < num_blocks; i++) {
+        const char* sector = GetSector(static_cast<u32>(i));
+        if (sector == nullptr) {
+            return false;
+        }
+
+        if (i == 0) {
+            std::memcpy(&ndinode, sector + 0x30, sizeof(ndinode));
+            inodes.reserve(ndinode);
+        }
+
+        u64 occupied_blocks = (u64(ndinode) * 0xA8) / SectorSize;
+        if ((u64(ndinode) * 0xA8) % SectorSize != 0) {
+            occupied_blocks += 1;
+        }
+
+        if (i >= 1 && i <= occupied_blocks) {
+            for (u64 p = 0; p + sizeof(Inode) <= SectorSize; p += 0xA8) {
+                Inode node;
+                std::memcpy(&node, sector + p, sizeof(node));
+                if (node.Mode == 0) {
+                    break;
+                }
+                inodes.push_back(node);
+            }
+        }
+
+        if (std::string_view(sector + 0x10, 15) == "flat_path_table") {
+            uroot_reached = true;
+        }
+        if (uroot_reached) {
+            for (u64 p = 0; p < SectorSize; p += ent_size) {
+                Dirent dirent;
+                std::memcpy(&dirent, sector + p, sizeof(dirent));
+                ent_size = dirent.entsize;
+                if (dirent.ino != 0) {
+                    ndinode_counter++;
+                } else {
+                    // The uroot inode(s) are the image root.
+                    inode_paths[ndinode_counter] = "";
+                    uroot_reached = false;
+                    break;
+                }
+            }
+        }
+
+        if (sector[0x10] == '.' && std::string_view(sector + 0x28, 2) == "..") {
+            dinode_reached = true;
+        }
+
+        bool end_reached = false;
+        if (dinode_reached) {
+            for (u64 p = 0; p < SectorSize; p += ent_size) {
+                Dirent dirent;
+                std::memcpy(&dirent, sector + p, sizeof(dirent));
+                if (dirent.ino == 0) {
+                    break;
+                }
+                ent_size = dirent.entsize;
+                const std::string name(dirent.name, dirent.namelen);
+
+                if (dirent.type == PFS_CURRENT_DIR) {
+                    current_dir = inode_paths[dirent.ino];
+                    continue;
+                }
+                const std::string path =
+                    current_dir.empty() ? name : current_dir + "/" + name;
+                inode_paths[dirent.ino] = path;
+
+                if (dirent.type == PFS_FILE || dirent.type == PFS_DIR) {
+                    paths.emplace(path, dirent.ino);
+                    ndinode_counter++;
+                    if ((ndinode_counter + 1) == ndinode) { // 1 for the root itself.
+                        end_reached = true;
+                    }
+                }
+            }
+            if (end_reached) {
+                break;
+            }
+        }
+    }
+
+    LOG_INFO(Kernel_Fs, "Mounted PFS image {} with {} entries", image_path.string(), paths.size());
+    return !paths.empty();
+}
+
+u32 PfsDriver::FindInode(const std::string& rel_path) const {
+    const auto it = paths.find(rel_path);
+    return it != paths.end() ? it->second : 0;
+}
+
+bool PfsDriver::IsDirectory(u32 ino) const {
+    return ino < inodes.size() && (inodes[ino].Mode & InodeMode::dir) != 0;
+}
+
+s64 PfsDriver::GetSize(u32 ino) const {
+    return ino < inodes.size() ? inodes[ino].Size : -1;
+}
+
+u64 PfsDriver::Read(u32 ino, u64 offset, void* buf, u64 size) {
+    if (ino >= inodes.size()) {
+        return 0;
+    }
+    const Inode& node = inodes[ino];
+    if (offset >= static_cast<u64>(node.Size)) {
+        return 0;
+    }
+    size = std::min(size, static_cast<u64>(node.Size) - offset);
+
+    std::scoped_lock lock{mutex};
+    u64 copied = 0;
+    auto* out = static_cast<u8*>(buf);
+    while (copied < size) {
+        const u64 pos = offset + copied;
+        const u32 sector = node.loc + static_cast<u32>(pos / SectorSize);
+        const u64 within = pos % SectorSize;
+        const u64 chunk = std::min(size - copied, SectorSize - within);
+
+        const char* data = GetSector(sector);
+        if (data == nullptr) {
+            break;
+        }
+        std::memcpy(out + copied, data + within, chunk);
+        copied += chunk;
+    }
+    return copied;
+}
+
+const char* PfsDriver::GetSector(u32 index) {
+    if (index == cached_sector) {
+        return sector_cache.data();
+    }
+    if (index + 1 >= sector_map.size()) {
+        return nullptr;
+    }
+    const u64 sector_offset = sector_map[index];
+    const u64 sector_size = sector_map[index + 1] - sector_offset;
+    image.Seek(pfsc_base + sector_offset);
+    if (sector_size == SectorSize) { // Uncompressed sector
+        if (image.ReadRaw<char>(sector_cache.data(), SectorSize) != SectorSize) {
+            return nullptr;
+        }
+    } else if (sector_size < SectorSize) {
+        if (image.ReadRaw<char>(compressed_scratch.data(), sector_size) != sector_size) {
+            return nullptr;
+        }
+        DecompressPFSC({compressed_scratch.data(), sector_size}, sector_cache);
+    } else {
+        return nullptr;
+    }
+    cached_sector = index;
+    return sector_cache.data();
+}
+
+} // namespace Core::FileSys
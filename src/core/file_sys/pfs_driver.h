@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "common/io_file.h"
+#include "core/file_format/pfs.h"
+
+namespace Core::FileSys {
+
+/**
+ * Read-only driver for a decrypted PFS image. Serves guest file reads straight
+ * from pfs_image.dat, so installed titles do not need the extraction pass that
+ * doubles their disk footprint. PFSC sectors are decompressed on demand with
+ * the hottest sector kept decoded.
+ */
+class PfsDriver {
+public:
+    PfsDriver();
+    ~PfsDriver();
+
+    /// Parses the PFSC sector map, inodes and directory entries of the image.
+    bool Load(const std::filesystem::path& image_path);
+
+    /// Returns the inode of an image-relative path, or 0 when it is absent.
+    u32 FindInode(const std::string& rel_path) const;
+
+    bool IsDirectory(u32 ino) const;
+    s64 GetSize(u32 ino) const;
+
+    /// Copies up to size bytes of the file at ino starting at offset.
+    u64 Read(u32 ino, u64 offset, void* buf, u64 size);
+
+private:
+    static constexpr u64 SectorSize = 0x10000;
+
+    const char* GetSector(u32 index);
+
+    Common::FS::IOFile image;
+    u64 pfsc_base{};
+    PFSCHdr hdr{};
+    std::vector<u64> sector_map;
+    std::vector<Inode> inodes;
+    std::unordered_map<std::string, u32> paths;
+    std::vector<char> sector_cache;
+    std::vector<char> compressed_scratch;
+    u32 cached_sector = ~0U;
+    std::mutex mutex;
+};
+
+} // namespace Core::FileSys
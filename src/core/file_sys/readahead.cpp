@@ -0,0 +1,111 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include "common/logging/log.h"
+#include "core/file_sys/readahead.h"
+
+namespace Core::FileSys {
+
+ReadaheadEngine::ReadaheadEngine() {
+    worker = std::thread([this] { Worker(); });
+}
+
+ReadaheadEngine::~ReadaheadEngine() {
+    {
+        std::scoped_lock lock{requests_mutex};
+        stop = true;
+    }
+    requests_cv.notify_one();
+    worker.join();
+}
+
+u64 ReadaheadEngine::TryServe(File* file, u64 offset, void* buf, u64 nbytes) {
+    auto& ra = file->readahead;
+    std::scoped_lock lock{ra.mutex};
+    if (nbytes == 0 || offset < ra.buffer_offset ||
+        offset + nbytes > ra.buffer_offset + ra.buffer_size) {
+        return 0;
+    }
+    std::memcpy(buf, ra.buffer.data() + (offset - ra.buffer_offset), nbytes);
+    ra.last_read_end = offset + nbytes;
+
+    // Keep the window ahead of the reader: once less than half of it is left,
+    // schedule the next one.
+    const u64 remaining = ra.buffer_offset + ra.buffer_size - ra.last_read_end;
+    if (remaining < WindowSize / 2 && !ra.prefetch_pending.exchange(true)) {
+        Kick(file, ra.buffer_offset + ra.buffer_size);
+    }
+    return nbytes;
+}
+
+void ReadaheadEngine::OnRead(File* file, u64 offset, u64 nbytes) {
+    auto& ra = file->readahead;
+    std::scoped_lock lock{ra.mutex};
+    if (offset == ra.last_read_end && nbytes != 0) {
+        ra.sequential_streak++;
+    } else {
+        ra.sequential_streak = 0;
+    }
+    ra.last_read_end = offset + nbytes;
+    if (ra.sequential_streak >= SequentialThreshold && !ra.prefetch_pending.exchange(true)) {
+        Kick(file, ra.last_read_end);
+    }
+}
+
+void ReadaheadEngine::Invalidate(File* file) {
+    auto& ra = file->readahead;
+    std::scoped_lock lock{ra.mutex};
+    ra.buffer_size = 0;
+    ra.sequential_streak = 0;
+}
+
+void ReadaheadEngine::Kick(File* file, u64 offset) {
+    {
+        std::scoped_lock lock{requests_mutex};
+        requests.emplace_back(file, offset);
+    }
+    requests_cv.notify_one();
+}
+
+void ReadaheadEngine::Worker() {
+    while (true) {
+        File* file{};
+        u64 offset{};
+        {
+            std::unique_lock lock{requests_mutex};
+            requests_cv.wait(lock, [this] { return stop || !requests.empty(); });
+            if (stop) {
+                return;
+            }
+            std::tie(file, offset) = requests.front();
+            requests.pop_front();
+        }
+
+        auto& ra = file->readahead;
+        if (!file->is_opened || file->is_directory) {
+            ra.prefetch_pending = false;
+            continue;
+        }
+        if (!ra.host_file.IsOpen()) {
+            ra.host_file.Open(file->m_host_name, Common::FS::FileAccessMode::Read);
+            if (!ra.host_file.IsOpen()) {
+                LOG_WARNING(Kernel_Fs, "Readahead failed to reopen {}", file->m_host_name);
+                ra.prefetch_pending = false;
+                continue;
+            }
+        }
+
+        std::vector<u8> window(WindowSize);
+        ra.host_file.Seek(offset);
+        const u64 read = ra.host_file.ReadRaw<u8>(window.data(), window.size());
+
+        std::scoped_lock lock{ra.mutex};
+        ra.buffer = std::move(window);
+        ra.buffer_offset = offset;
+        ra.buffer_size = read;
+        ra.prefetch_pending = false;
+    }
+}
+
+} // namespace Core::FileSys
@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include "core/file_sys/fs.h"
+
+namespace Core::FileSys {
+
+/**
+ * Detects sequential read patterns on guest files and prefetches the next
+ * window from the host disk on a background IO thread, so streaming reads are
+ * served from a warm buffer instead of stalling on the disk every call.
+ */
+class ReadaheadEngine {
+public:
+    ReadaheadEngine();
+    ~ReadaheadEngine();
+
+    /// Serves the read from the prefetched window when it is fully covered.
+    /// Returns the number of bytes copied, or 0 on a miss.
+    u64 TryServe(File* file, u64 offset, void* buf, u64 nbytes);
+
+    /// Records a completed synchronous read and schedules a prefetch once the
+    /// access pattern looks sequential.
+    void OnRead(File* file, u64 offset, u64 nbytes);
+
+    /// Drops the prefetched window, e.g. after a write through the same file.
+    void Invalidate(File* file);
+
+private:
+    void Worker();
+    void Kick(File* file, u64 offset);
+
+    static constexpr u64 WindowSize = 4_MB;
+    static constexpr u32 SequentialThreshold = 2;
+
+    std::deque<std::pair<File*, u64>> requests;
+    std::mutex requests_mutex;
+    std::condition_variable requests_cv;
+    std::thread worker;
+    bool stop = false;
+};
+
+} // namespace Core::FileSys
@@ -0,0 +1,157 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include "common/io_file.h"
+#include "common/logging/log.h"
+#include "common/thread.h"
+#include "core/file_sys/save_committer.h"
+
+namespace Core::FileSys {
+
+// Files carrying this suffix are in-progress journal writes; the final name
+// only ever appears through an atomic rename of a fully flushed temp file.
+constexpr std::string_view CommitSuffix = ".commit";
+
+SaveDataCommitter::SaveDataCommitter() {
+    worker = std::thread([this] { Worker(); });
+}
+
+SaveDataCommitter::~SaveDataCommitter() {
+    {
+        std::scoped_lock lock{mutex};
+        stop = true;
+    }
+    cv.notify_one();
+    worker.join();
+}
+
+void SaveDataCommitter::AddRoot(const std::filesystem::path& dir) {
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(dir, ec)) {
+        if (entry.path().string().ends_with(CommitSuffix)) {
+            LOG_WARNING(Kernel_Fs, "Discarding interrupted savedata commit {}",
+                        entry.path().string());
+            std::filesystem::remove(entry.path(), ec);
+        }
+    }
+    // Normalized the same way MntPoints stores host paths, so prefix checks
+    // against translated guest paths are exact.
+    std::string root = dir.string();
+    std::replace(root.begin(), root.end(), '\\', '/');
+    std::scoped_lock lock{mutex};
+    if (std::ranges::find(roots, root) == roots.end()) {
+        roots.push_back(root);
+    }
+}
+
+bool SaveDataCommitter::Covers(const std::string& host_path) const {
+    std::scoped_lock lock{mutex};
+    return std::ranges::any_of(roots,
+                               [&](const std::string& root) { return host_path.starts_with(root); });
+}
+
+std::unique_ptr<SaveBuffer> SaveDataCommitter::Open(const std::string& host_path, bool create,
+                                                    bool truncate) {
+    auto buffer = std::make_unique<SaveBuffer>();
+    buffer->host_path = host_path;
+    if (!truncate) {
+        std::scoped_lock lock{mutex};
+        if (const auto it = pending.find(host_path); it != pending.end()) {
+            buffer->data = it->second.data;
+            return buffer;
+        }
+    }
+    if (!truncate) {
+        Common::FS::IOFile file{host_path, Common::FS::FileAccessMode::Read};
+        if (file.IsOpen()) {
+            buffer->data.resize(file.GetSize());
+            file.ReadSpan<u8>(buffer->data);
+            return buffer;
+        }
+        if (!create) {
+            return nullptr;
+        }
+    }
+    return buffer;
+}
+
+void SaveDataCommitter::Commit(std::unique_ptr<SaveBuffer> buffer) {
+    std::scoped_lock lock{mutex};
+    auto& entry = pending[buffer->host_path];
+    entry.data = std::move(buffer->data);
+    entry.generation = next_generation++;
+    queue.push_back(std::move(buffer->host_path));
+    cv.notify_one();
+}
+
+std::optional<u64> SaveDataCommitter::PendingSize(const std::string& host_path) const {
+    std::scoped_lock lock{mutex};
+    if (const auto it = pending.find(host_path); it != pending.end()) {
+        return it->second.data.size();
+    }
+    return std::nullopt;
+}
+
+void SaveDataCommitter::WaitForIdle() {
+    std::unique_lock lock{mutex};
+    idle_cv.wait(lock, [this] { return queue.empty() && in_flight == 0; });
+}
+
+void SaveDataCommitter::Worker() {
+    Common::SetCurrentThreadName("shadPS4:SaveCommitter");
+    Common::SetCurrentThreadRole(Common::ThreadRole::Io);
+    std::unique_lock lock{mutex};
+    while (true) {
+        cv.wait(lock, [this] { return stop || !queue.empty(); });
+        if (queue.empty()) {
+            // Stop was requested and every pending commit has been flushed.
+            break;
+        }
+        const std::string host_path = std::move(queue.front());
+        queue.pop_front();
+        const auto it = pending.find(host_path);
+        if (it == pending.end()) {
+            // A newer commit for the same path already wrote this data.
+            continue;
+        }
+        // Snapshot under the lock, write without it so guest saves never block
+        // behind the disk.
+        const u64 generation = it->second.generation;
+        std::vector<u8> data = it->second.data;
+        in_flight++;
+        lock.unlock();
+        WriteDurable(host_path, data);
+        lock.lock();
+        in_flight--;
+        // Only drop the overlay entry if no newer write superseded it while the
+        // disk write was in progress.
+        if (const auto again = pending.find(host_path);
+            again != pending.end() && again->second.generation == generation) {
+            pending.erase(again);
+        }
+        if (queue.empty() && in_flight == 0) {
+            idle_cv.notify_all();
+        }
+    }
+}
+
+void SaveDataCommitter::WriteDurable(const std::string& host_path, const std::vector<u8>& data) {
+    const std::string temp_path = host_path + std::string{CommitSuffix};
+    {
+        Common::FS::IOFile file{temp_path, Common::FS::FileAccessMode::Write};
+        if (!file.IsOpen()) {
+            LOG_ERROR(Kernel_Fs, "Failed opening savedata journal file {}", temp_path);
+            return;
+        }
+        file.WriteSpan<u8>(data);
+        file.Flush();
+    }
+    std::error_code ec;
+    std::filesystem::rename(temp_path, host_path, ec);
+    if (ec) {
+        LOG_ERROR(Kernel_Fs, "Failed committing savedata file {}: {}", host_path, ec.message());
+    }
+}
+
+} // namespace Core::FileSys
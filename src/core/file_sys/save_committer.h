@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "common/types.h"
+
+namespace Core::FileSys {
+
+/// In-memory image of a savedata file while the guest has it open for writing.
+/// Handed back to the committer on close, which makes it durable off-thread.
+struct SaveBuffer {
+    std::string host_path;
+    std::vector<u8> data;
+    u64 pos{};
+    bool dirty{};
+};
+
+/**
+ * Write-behind commit layer for savedata mounts. Guest writes land in an
+ * in-memory overlay and complete immediately; the worker thread makes each
+ * closed file durable with a journaled write (temp file, flush, atomic rename),
+ * so autosaves no longer stall the guest thread on host disk IO. Reads always
+ * observe the overlay, including commits that have not reached the disk yet.
+ */
+class SaveDataCommitter {
+public:
+    SaveDataCommitter();
+    ~SaveDataCommitter();
+
+    /// Registers a mounted savedata directory and discards journal leftovers of
+    /// commits interrupted by a crash (their renames never happened, so the
+    /// previous file contents are still intact).
+    void AddRoot(const std::filesystem::path& dir);
+
+    /// Returns true when the host path lies under a registered savedata root.
+    bool Covers(const std::string& host_path) const;
+
+    /// Opens an overlay buffer seeded with the current file contents (pending
+    /// commit if one exists, the host file otherwise). Returns nullptr when the
+    /// file does not exist and create is not requested.
+    std::unique_ptr<SaveBuffer> Open(const std::string& host_path, bool create, bool truncate);
+
+    /// Queues the buffer for a durable commit and returns immediately.
+    void Commit(std::unique_ptr<SaveBuffer> buffer);
+
+    /// Returns the size of a commit still in flight for the path, so stat
+    /// observes files the disk has not caught up with yet.
+    std::optional<u64> PendingSize(const std::string& host_path) const;
+
+    /// Blocks until every queued commit has reached the disk.
+    void WaitForIdle();
+
+private:
+    void Worker();
+    void WriteDurable(const std::string& host_path, const std::vector<u8>& data);
+
+    struct PendingWrite {
+        std::vector<u8> data;
+        u64 generation{};
+    };
+
+    std::vector<std::string> roots;
+    // Latest guest-visible contents per path; entries are dropped once the
+    // matching generation has been committed.
+    std::unordered_map<std::string, PendingWrite> pending;
+    std::deque<std::string> queue;
+    u64 next_generation = 1;
+    u32 in_flight = 0;
+    mutable std::mutex mutex;
+    std::condition_variable cv;
+    std::condition_variable idle_cv;
+    std::thread worker;
+    bool stop = false;
+};
+
+} // namespace Core::FileSys
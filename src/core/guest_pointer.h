@@ -0,0 +1,93 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <span>
+#include "common/types.h"
+#include "core/memory.h"
+
+namespace Core {
+
+/**
+ * Typed view of a single guest structure. The whole object range is validated
+ * against the VMA tree once on construction; afterwards the pointer is a plain
+ * host reference, so HLE code can read and write fields directly without
+ * per-field checks or an intermediate copy.
+ */
+template <typename T>
+class GuestPtr {
+public:
+    GuestPtr() = default;
+
+    explicit GuestPtr(T* ptr) {
+        if (ptr && Memory::Instance()->IsValidRange(reinterpret_cast<VAddr>(ptr), sizeof(T))) {
+            host_ptr = ptr;
+        }
+    }
+
+    explicit operator bool() const noexcept {
+        return host_ptr != nullptr;
+    }
+
+    T* Get() const noexcept {
+        return host_ptr;
+    }
+
+    T* operator->() const noexcept {
+        return host_ptr;
+    }
+
+    T& operator*() const noexcept {
+        return *host_ptr;
+    }
+
+private:
+    T* host_ptr{};
+};
+
+/**
+ * Typed view of a guest array, validated in one VMA walk like GuestPtr. An
+ * invalid or partially unmapped range yields an empty span.
+ */
+template <typename T>
+class GuestSpan {
+public:
+    GuestSpan() = default;
+
+    GuestSpan(T* ptr, size_t count) {
+        if (ptr && count != 0 &&
+            Memory::Instance()->IsValidRange(reinterpret_cast<VAddr>(ptr), count * sizeof(T))) {
+            host_span = std::span<T>{ptr, count};
+        }
+    }
+
+    explicit operator bool() const noexcept {
+        return !host_span.empty();
+    }
+
+    std::span<T> Get() const noexcept {
+        return host_span;
+    }
+
+    T& operator[](size_t index) const noexcept {
+        return host_span[index];
+    }
+
+    size_t size() const noexcept {
+        return host_span.size();
+    }
+
+    auto begin() const noexcept {
+        return host_span.begin();
+    }
+
+    auto end() const noexcept {
+        return host_span.end();
+    }
+
+private:
+    std::span<T> host_span{};
+};
+
+} // namespace Core
@@ -11,27 +11,29 @@ class SymbolsResolver;
 
 namespace Libraries::Ajm {
 
-int PS4_SYSV_ABI sceAjmBatchCancel();
+int PS4_SYSV_ABI sceAjmBatchCancel(u32 context_id, u32 batch_id);
 int PS4_SYSV_ABI sceAjmBatchErrorDump();
 int PS4_SYSV_ABI sceAjmBatchJobControlBufferRa();
 int PS4_SYSV_ABI sceAjmBatchJobInlineBuffer();
 int PS4_SYSV_ABI sceAjmBatchJobRunBufferRa();
 int PS4_SYSV_ABI sceAjmBatchJobRunSplitBufferRa();
-int PS4_SYSV_ABI sceAjmBatchStartBuffer();
-int PS4_SYSV_ABI sceAjmBatchWait();
+int PS4_SYSV_ABI sceAjmBatchStartBuffer(u32 context_id, const u8* batch, u64 batch_size,
+                                        int priority, void* batch_error, u32* batch_id);
+int PS4_SYSV_ABI sceAjmBatchWait(u32 context_id, u32 batch_id, u32 timeout_ms,
+                                void* batch_error);
 int PS4_SYSV_ABI sceAjmDecAt9ParseConfigData();
 int PS4_SYSV_ABI sceAjmDecMp3ParseFrame();
-int PS4_SYSV_ABI sceAjmFinalize();
-int PS4_SYSV_ABI sceAjmInitialize();
+int PS4_SYSV_ABI sceAjmFinalize(u32 context_id);
+int PS4_SYSV_ABI sceAjmInitialize(s64 reserved, u32* context_id);
 int PS4_SYSV_ABI sceAjmInstanceCodecType();
-int PS4_SYSV_ABI sceAjmInstanceCreate();
-int PS4_SYSV_ABI sceAjmInstanceDestroy();
+int PS4_SYSV_ABI sceAjmInstanceCreate(u32 context_id, u32 codec, u64 flags, u32* instance_id);
+int PS4_SYSV_ABI sceAjmInstanceDestroy(u32 context_id, u32 instance_id);
 int PS4_SYSV_ABI sceAjmInstanceExtend();
 int PS4_SYSV_ABI sceAjmInstanceSwitch();
 int PS4_SYSV_ABI sceAjmMemoryRegister();
 int PS4_SYSV_ABI sceAjmMemoryUnregister();
-int PS4_SYSV_ABI sceAjmModuleRegister();
-int PS4_SYSV_ABI sceAjmModuleUnregister();
+int PS4_SYSV_ABI sceAjmModuleRegister(u32 context_id, u32 codec, s64 reserved);
+int PS4_SYSV_ABI sceAjmModuleUnregister(u32 context_id, u32 codec);
 int PS4_SYSV_ABI sceAjmStrError();
 
 void RegisterlibSceAjm(Core::Loader::SymbolsResolver* sym);
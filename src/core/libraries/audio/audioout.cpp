@@ -6,6 +6,7 @@
 #include <magic_enum.hpp>
 #include "audio_core/sdl_audio.h"
 #include "common/logging/log.h"
+#include "core/guest_pointer.h"
 #include "core/libraries/audio/audioout.h"
 #include "core/libraries/error_codes.h"
 #include "core/libraries/libs.h"
@@ -303,11 +304,14 @@ s32 PS4_SYSV_ABI sceAudioOutOutput(s32 handle, const void* ptr) {
 }
 
 int PS4_SYSV_ABI sceAudioOutOutputs(OrbisAudioOutOutputParam* param, u32 num) {
-    for (u32 i = 0; i < num; i++) {
-        if (auto err = audio->AudioOutOutput(param[i].handle, param[i].ptr); err != 0)
-            return err;
+    // One range check covers the whole parameter table; the mixer then reads the
+    // entries in place.
+    const Core::GuestSpan<OrbisAudioOutOutputParam> params{param, num};
+    if (!params) {
+        LOG_ERROR(Lib_AudioOut, "Output param table is null or unmapped");
+        return ORBIS_AUDIO_OUT_ERROR_INVALID_POINTER;
     }
-    return ORBIS_OK;
+    return audio->AudioOutOutputs(params.Get().data(), num);
 }
 
 int PS4_SYSV_ABI sceAudioOutPtClose() {
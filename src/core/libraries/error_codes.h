@@ -446,6 +446,36 @@ constexpr int ORBIS_USER_SERVICE_ERROR_BUFFER_TOO_SHORT = 0x8096000A;
 
 // SystemService library
 constexpr int ORBIS_SYSTEM_SERVICE_ERROR_PARAMETER = 0x80A10003;
+constexpr int ORBIS_SYSTEM_SERVICE_ERROR_NO_EVENT = 0x80A10004;
+
+// Net library
+constexpr int ORBIS_NET_ERROR_ENOENT = 0x80410102;
+constexpr int ORBIS_NET_ERROR_EINTR = 0x80410104;
+constexpr int ORBIS_NET_ERROR_EBADF = 0x80410109;
+constexpr int ORBIS_NET_ERROR_EEXIST = 0x80410111;
+constexpr int ORBIS_NET_ERROR_EINVAL = 0x80410116;
+
+// Ajm library
+constexpr int ORBIS_AJM_ERROR_INVALID_CONTEXT = 0x80930002;
+constexpr int ORBIS_AJM_ERROR_INVALID_INSTANCE = 0x80930003;
+constexpr int ORBIS_AJM_ERROR_INVALID_BATCH = 0x80930004;
+constexpr int ORBIS_AJM_ERROR_INVALID_PARAMETER = 0x80930005;
+constexpr int ORBIS_AJM_ERROR_CODEC_NOT_REGISTERED = 0x80930008;
+constexpr int ORBIS_AJM_ERROR_IN_PROGRESS = 0x80930010;
+
+// Http library
+constexpr int ORBIS_HTTP_ERROR_BEFORE_INIT = 0x80431001;
+constexpr int ORBIS_HTTP_ERROR_ALREADY_INITED = 0x80431020;
+constexpr int ORBIS_HTTP_ERROR_OUT_OF_MEMORY = 0x80431022;
+constexpr int ORBIS_HTTP_ERROR_UNKNOWN_SCHEME = 0x80431061;
+constexpr int ORBIS_HTTP_ERROR_NETWORK = 0x80431063;
+constexpr int ORBIS_HTTP_ERROR_BAD_RESPONSE = 0x80431064;
+constexpr int ORBIS_HTTP_ERROR_BEFORE_SEND = 0x80431065;
+constexpr int ORBIS_HTTP_ERROR_AFTER_SEND = 0x80431066;
+constexpr int ORBIS_HTTP_ERROR_UNKNOWN_METHOD = 0x8043106B;
+constexpr int ORBIS_HTTP_ERROR_INVALID_ID = 0x80431100;
+constexpr int ORBIS_HTTP_ERROR_INVALID_VALUE = 0x804311FE;
+constexpr int ORBIS_HTTP_ERROR_INVALID_URL = 0x80433060;
 
 // NpTrophy library
 constexpr int ORBIS_NP_TROPHY_ERROR_INVALID_ARGUMENT = 0x80551604;
@@ -453,3 +483,4 @@ constexpr int ORBIS_NP_TROPHY_ERROR_INVALID_HANDLE = 0x80551608;
 constexpr int ORBIS_NP_TROPHY_ERROR_HANDLE_EXCEEDS_MAX = 0x80551624;
 constexpr int ORBIS_NP_TROPHY_ERROR_CONTEXT_ALREADY_EXISTS = 0x80551613;
 constexpr int ORBIS_NP_TROPHY_ERROR_CONTEXT_EXCEEDS_MAX = 0x80551622;
+constexpr int ORBIS_NP_TROPHY_ERROR_ALREADY_UNLOCKED = 0x80551616;
@@ -1938,13 +1938,17 @@ s32 PS4_SYSV_ABI sceGnmSubmitCommandBuffers(u32 count, const u32* dcb_gpu_addrs[
         submission_lock = 0;
     }
 
+    // Queue every pair of the call (and the init sequence, if still due) as a single
+    // submit, so the command processor retires them as one unit instead of paying the
+    // scheduling overhead once per command buffer.
+    boost::container::small_vector<AmdGpu::Liverpool::GfxBufferPair, 8> batch;
     if (send_init_packet) {
         if (sdk_version <= 0x1ffffffu) {
-            liverpool->SubmitGfx(InitSequence, {});
+            batch.emplace_back(InitSequence, std::span<const u32>{});
         } else if (sdk_version <= 0x3ffffffu) {
-            liverpool->SubmitGfx(InitSequence200, {});
+            batch.emplace_back(InitSequence200, std::span<const u32>{});
         } else {
-            liverpool->SubmitGfx(InitSequence350, {});
+            batch.emplace_back(InitSequence350, std::span<const u32>{});
         }
         send_init_packet = false;
     }
@@ -1974,8 +1978,9 @@ s32 PS4_SYSV_ABI sceGnmSubmitCommandBuffers(u32 count, const u32* dcb_gpu_addrs[
             DumpCommandList(ccb_span, std::format("ccb_{}_{}", seq_num, cbpair));
         }
 
-        liverpool->SubmitGfx(dcb_span, ccb_span);
+        batch.emplace_back(dcb_span, ccb_span);
     }
+    liverpool->SubmitGfx(std::span{batch.data(), batch.size()});
 
     return ORBIS_OK;
 }
@@ -22,23 +22,39 @@ int EventFlagInternal::Wait(u64 bits, WaitMode wait_mode, ClearMode clear_mode,
 
     auto const start = std::chrono::system_clock::now();
     m_waiting_threads++;
-    auto waitFunc = [this, wait_mode, bits] {
-        return (m_status == Status::Canceled || m_status == Status::Deleted ||
-                (wait_mode == WaitMode::And && (m_bits & bits) == bits) ||
-                (wait_mode == WaitMode::Or && (m_bits & bits) != 0));
+
+    Waiter waiter{bits, wait_mode};
+    // Re-evaluated under the lock on every wakeup. A waiter whose pattern was
+    // consumed by another thread before it ran rearms itself for the setter.
+    auto waitFunc = [this, &waiter] {
+        if (m_status == Status::Canceled || m_status == Status::Deleted) {
+            return true;
+        }
+        if (waiter.IsSatisfied(m_bits)) {
+            return true;
+        }
+        waiter.signaled = false;
+        return false;
     };
 
-    if (infinitely) {
-        m_cond_var.wait(lock, waitFunc);
-    } else {
-        if (!m_cond_var.wait_for(lock, std::chrono::microseconds(micros), waitFunc)) {
-            if (result != nullptr) {
-                *result = m_bits;
-            }
-            *ptr_micros = 0;
-            --m_waiting_threads;
-            return ORBIS_KERNEL_ERROR_ETIMEDOUT;
+    bool timed_out = false;
+    if (!waitFunc()) {
+        m_waiters.push_back(&waiter);
+        if (infinitely) {
+            waiter.cv.wait(lock, waitFunc);
+        } else {
+            timed_out = !waiter.cv.wait_for(lock, std::chrono::microseconds(micros), waitFunc);
+        }
+        m_waiters.remove(&waiter);
+    }
+
+    if (timed_out) {
+        if (result != nullptr) {
+            *result = m_bits;
         }
+        *ptr_micros = 0;
+        --m_waiting_threads;
+        return ORBIS_KERNEL_ERROR_ETIMEDOUT;
     }
     --m_waiting_threads;
     if (result != nullptr) {
@@ -48,10 +64,6 @@ int EventFlagInternal::Wait(u64 bits, WaitMode wait_mode, ClearMode clear_mode,
     auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
                        std::chrono::system_clock::now() - start)
                        .count();
-    if (result != nullptr) {
-        *result = m_bits;
-    }
-
     if (ptr_micros != nullptr) {
         *ptr_micros = (elapsed >= micros ? 0 : micros - elapsed);
     }
@@ -87,7 +99,14 @@ void EventFlagInternal::Set(u64 bits) {
 
     m_bits |= bits;
 
-    m_cond_var.notify_all();
+    // Signal only the waiters this pattern satisfies in one pass under the
+    // lock; waiters with unsatisfied patterns keep sleeping.
+    for (auto* waiter : m_waiters) {
+        if (!waiter->signaled && waiter->IsSatisfied(m_bits)) {
+            waiter->signaled = true;
+            waiter->cv.notify_one();
+        }
+    }
 }
 
 void EventFlagInternal::Clear(u64 bits) {
@@ -3,6 +3,7 @@
 
 #pragma once
 #include <condition_variable>
+#include <list>
 #include <mutex>
 #include "common/types.h"
 
@@ -30,8 +31,23 @@ public:
 private:
     enum class Status { Set, Canceled, Deleted };
 
+    // One entry per blocked thread. The setter evaluates each waiter's pattern
+    // under the lock and only signals the ones the new bits satisfy, instead
+    // of waking every waiter to re-check its own pattern.
+    struct Waiter {
+        u64 bits;
+        WaitMode wait_mode;
+        std::condition_variable cv;
+        bool signaled = false;
+
+        bool IsSatisfied(u64 pattern) const {
+            return (wait_mode == WaitMode::And && (pattern & bits) == bits) ||
+                   (wait_mode == WaitMode::Or && (pattern & bits) != 0);
+        }
+    };
+
     std::mutex m_mutex;
-    std::condition_variable m_cond_var;
+    std::list<Waiter*> m_waiters;
     Status m_status = Status::Set;
     int m_waiting_threads = 0;
     std::string m_name;
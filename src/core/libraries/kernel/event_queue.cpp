@@ -29,19 +29,31 @@ int EqueueInternal::removeEvent(u64 id) {
 }
 
 int EqueueInternal::waitForEvents(SceKernelEvent* ev, int num, u32 micros) {
-    std::unique_lock lock{m_mutex};
     int ret = 0;
 
+    if (micros == 0) {
+        // Untimed waits take a futex-style fast path: sleep on the trigger counter
+        // without a mutex handoff and drain every pending event on a single wake.
+        while (true) {
+            u32 seq;
+            {
+                std::scoped_lock lock{m_mutex};
+                seq = m_trigger_seq.load();
+                ret = drainEvents(ev, num);
+            }
+            if (ret > 0) {
+                return ret;
+            }
+            m_trigger_seq.wait(seq);
+        }
+    }
+
+    std::unique_lock lock{m_mutex};
     const auto predicate = [&] {
-        ret = getTriggeredEvents(ev, num);
+        ret = drainEvents(ev, num);
         return ret > 0;
     };
-
-    if (micros == 0) {
-        m_cond.wait(lock, predicate);
-    } else {
-        m_cond.wait_for(lock, std::chrono::microseconds(micros), predicate);
-    }
+    m_cond.wait_for(lock, std::chrono::microseconds(micros), predicate);
     return ret;
 }
 
@@ -55,15 +67,26 @@ bool EqueueInternal::triggerEvent(u64 ident, s16 filter, void* trigger_data) {
             }
         }
     }
+    // Wake the futex fast path first, then any timed waiters on the condvar.
+    m_trigger_seq.fetch_add(1);
+    m_trigger_seq.notify_one();
     m_cond.notify_one();
 
     return true;
 }
 
 int EqueueInternal::getTriggeredEvents(SceKernelEvent* ev, int num) {
+    std::scoped_lock lock{m_mutex};
+    return drainEvents(ev, num);
+}
+
+int EqueueInternal::drainEvents(SceKernelEvent* ev, int num) {
     int ret = 0;
 
     for (auto& event : m_events) {
+        if (ret >= num) {
+            break;
+        }
         if (event.isTriggered) {
             ev[ret++] = event.event;
             event.reset();
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <string>
@@ -104,10 +105,13 @@ public:
     int getTriggeredEvents(SceKernelEvent* ev, int num);
 
 private:
+    int drainEvents(SceKernelEvent* ev, int num);
+
     std::string m_name;
     std::mutex m_mutex;
     std::vector<EqueueEvent> m_events;
     std::condition_variable m_cond;
+    std::atomic<u32> m_trigger_seq{};
 };
 
 } // namespace Libraries::Kernel
@@ -1,11 +1,14 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <cstring>
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "common/scope_exit.h"
 #include "common/singleton.h"
 #include "core/file_sys/fs.h"
+#include "core/file_sys/readahead.h"
 #include "core/libraries/error_codes.h"
 #include "core/libraries/kernel/file_system.h"
 #include "core/libraries/libs.h"
@@ -24,6 +27,16 @@ std::vector<Core::FileSys::DirEntry> GetDirectoryEntries(const std::string& path
     return files;
 }
 
+static u64 ReadSaveBuffer(const Core::FileSys::SaveBuffer& save, u64 offset, void* buf,
+                          u64 nbytes) {
+    if (offset >= save.data.size()) {
+        return 0;
+    }
+    const u64 read = std::min<u64>(nbytes, save.data.size() - offset);
+    std::memcpy(buf, save.data.data() + offset, read);
+    return read;
+}
+
 int PS4_SYSV_ABI sceKernelOpen(const char* path, int flags, u16 mode) {
     LOG_INFO(Kernel_Fs, "path = {} flags = {:#x} mode = {}", path, flags, mode);
     auto* h = Common::Singleton<Core::FileSys::HandleTable>::Instance();
@@ -55,6 +68,9 @@ int PS4_SYSV_ABI sceKernelOpen(const char* path, int flags, u16 mode) {
     }
     u32 handle = h->CreateHandle();
     auto* file = h->GetFile(handle);
+    if (file == nullptr) {
+        return ORBIS_KERNEL_ERROR_EMFILE;
+    }
     if (directory) {
         file->is_directory = true;
         file->m_guest_name = path;
@@ -73,8 +89,32 @@ int PS4_SYSV_ABI sceKernelOpen(const char* path, int flags, u16 mode) {
     } else {
         file->m_guest_name = path;
         file->m_host_name = mnt->GetHostFile(file->m_guest_name);
-        if (read) {
+        // Files under a savedata mount go through the write-behind overlay so
+        // the guest save completes without touching the host disk.
+        auto* committer = Common::Singleton<Core::FileSys::SaveDataCommitter>::Instance();
+        if (committer->Covers(file->m_host_name)) {
+            file->save = committer->Open(file->m_host_name, create, truncate);
+            if (file->save == nullptr) {
+                h->DeleteHandle(handle);
+                return read ? SCE_KERNEL_ERROR_ENOENT : SCE_KERNEL_ERROR_EACCES;
+            }
+            if (append) {
+                file->save->pos = file->save->data.size();
+            }
+        } else if (read) {
             file->f.Open(file->m_host_name, Common::FS::FileAccessMode::Read);
+            if (!file->f.IsOpen()) {
+                // No loose host file: fall back to a mounted PFS image if one
+                // covers this path.
+                const auto [pfs, rel] = mnt->GetPfsFile(file->m_guest_name);
+                if (pfs != nullptr) {
+                    if (const u32 ino = pfs->FindInode(rel); ino != 0 && !pfs->IsDirectory(ino)) {
+                        file->pfs = pfs;
+                        file->pfs_inode = ino;
+                        file->pfs_offset = 0;
+                    }
+                }
+            }
         } else if (write && create && truncate) {
             file->f.Open(file->m_host_name, Common::FS::FileAccessMode::Write);
         } else if (write && create && append) { // CUSA04729 (appends app0/shaderlist.txt)
@@ -88,7 +128,7 @@ int PS4_SYSV_ABI sceKernelOpen(const char* path, int flags, u16 mode) {
         } else {
             UNREACHABLE();
         }
-        if (!file->f.IsOpen()) {
+        if (!file->f.IsOpen() && file->pfs == nullptr && file->save == nullptr) {
             h->DeleteHandle(handle);
             return SCE_KERNEL_ERROR_EACCES;
         }
@@ -117,9 +157,20 @@ int PS4_SYSV_ABI sceKernelClose(int d) {
     if (file == nullptr) {
         return SCE_KERNEL_ERROR_EBADF;
     }
+    if (file->save != nullptr) {
+        // Hand modified overlay contents to the committer; durability is
+        // handled off-thread while the guest continues immediately.
+        if (file->save->dirty) {
+            auto* committer = Common::Singleton<Core::FileSys::SaveDataCommitter>::Instance();
+            committer->Commit(std::move(file->save));
+        } else {
+            file->save.reset();
+        }
+    }
     if (!file->is_directory) {
         file->f.Close();
     }
+    file->pfs = nullptr;
     file->is_opened = false;
     LOG_INFO(Kernel_Fs, "Closing {}", file->m_guest_name);
     h->DeleteHandle(d);
@@ -152,7 +203,21 @@ size_t PS4_SYSV_ABI sceKernelWrite(int d, const void* buf, size_t nbytes) {
         return SCE_KERNEL_ERROR_EBADF;
     }
 
+    if (file->pfs != nullptr) {
+        return SCE_KERNEL_ERROR_EROFS; // Image-backed files are read-only.
+    }
     std::scoped_lock lk{file->m_mutex};
+    if (file->save != nullptr) {
+        auto& save = *file->save;
+        if (save.pos + nbytes > save.data.size()) {
+            save.data.resize(save.pos + nbytes);
+        }
+        std::memcpy(save.data.data() + save.pos, buf, nbytes);
+        save.pos += nbytes;
+        save.dirty = true;
+        return nbytes;
+    }
+    Common::Singleton<Core::FileSys::ReadaheadEngine>::Instance()->Invalidate(file);
     return file->f.WriteRaw<u8>(buf, nbytes);
 }
 
@@ -162,6 +227,13 @@ size_t PS4_SYSV_ABI _readv(int d, const SceKernelIovec* iov, int iovcnt) {
     size_t total_read = 0;
     std::scoped_lock lk{file->m_mutex};
     for (int i = 0; i < iovcnt; i++) {
+        if (file->save != nullptr) {
+            const u64 read = ReadSaveBuffer(*file->save, file->save->pos, iov[i].iov_base,
+                                            iov[i].iov_len);
+            file->save->pos += read;
+            total_read += read;
+            continue;
+        }
         total_read += file->f.ReadRaw<u8>(iov[i].iov_base, iov[i].iov_len);
     }
     return total_read;
@@ -181,6 +253,26 @@ s64 PS4_SYSV_ABI sceKernelLseek(int d, s64 offset, int whence) {
     }
 
     std::scoped_lock lk{file->m_mutex};
+    if (file->pfs != nullptr) {
+        if (whence == 0) {
+            file->pfs_offset = offset;
+        } else if (whence == 1) {
+            file->pfs_offset += offset;
+        } else if (whence == 2) {
+            file->pfs_offset = file->pfs->GetSize(file->pfs_inode) + offset;
+        }
+        return file->pfs_offset;
+    }
+    if (file->save != nullptr) {
+        if (whence == 0) {
+            file->save->pos = offset;
+        } else if (whence == 1) {
+            file->save->pos += offset;
+        } else if (whence == 2) {
+            file->save->pos = file->save->data.size() + offset;
+        }
+        return file->save->pos;
+    }
     file->f.Seek(offset, origin);
     return file->f.Tell();
 }
@@ -202,8 +294,26 @@ s64 PS4_SYSV_ABI sceKernelRead(int d, void* buf, size_t nbytes) {
         return SCE_KERNEL_ERROR_EBADF;
     }
 
+    auto* readahead = Common::Singleton<Core::FileSys::ReadaheadEngine>::Instance();
     std::scoped_lock lk{file->m_mutex};
-    return file->f.ReadRaw<u8>(buf, nbytes);
+    if (file->pfs != nullptr) {
+        const u64 read = file->pfs->Read(file->pfs_inode, file->pfs_offset, buf, nbytes);
+        file->pfs_offset += read;
+        return read;
+    }
+    if (file->save != nullptr) {
+        const u64 read = ReadSaveBuffer(*file->save, file->save->pos, buf, nbytes);
+        file->save->pos += read;
+        return read;
+    }
+    const u64 pos = file->f.Tell();
+    if (const u64 served = readahead->TryServe(file, pos, buf, nbytes); served != 0) {
+        file->f.Seek(pos + served);
+        return served;
+    }
+    const size_t read = file->f.ReadRaw<u8>(buf, nbytes);
+    readahead->OnRead(file, pos, read);
+    return read;
 }
 
 int PS4_SYSV_ABI posix_read(int d, void* buf, size_t nbytes) {
@@ -252,6 +362,16 @@ int PS4_SYSV_ABI sceKernelStat(const char* path, OrbisKernelStat* sb) {
     auto* mnt = Common::Singleton<Core::FileSys::MntPoints>::Instance();
     const auto& path_name = mnt->GetHostFile(path);
     std::memset(sb, 0, sizeof(OrbisKernelStat));
+    // A freshly saved file may still be in flight to the disk; answer from the
+    // overlay so the title sees its own save immediately.
+    auto* committer = Common::Singleton<Core::FileSys::SaveDataCommitter>::Instance();
+    if (const auto pending_size = committer->PendingSize(path_name)) {
+        sb->st_mode = 0000777u | 0100000u;
+        sb->st_size = static_cast<int64_t>(*pending_size);
+        sb->st_blksize = 512;
+        sb->st_blocks = (sb->st_size + 511) / 512;
+        return ORBIS_OK;
+    }
     const bool is_dir = std::filesystem::is_directory(path_name);
     const bool is_file = std::filesystem::is_regular_file(path_name);
     if (!is_dir && !is_file) {
@@ -307,6 +427,12 @@ s64 PS4_SYSV_ABI sceKernelPread(int d, void* buf, size_t nbytes, s64 offset) {
     }
 
     std::scoped_lock lk{file->m_mutex};
+    if (file->pfs != nullptr) {
+        return file->pfs->Read(file->pfs_inode, offset, buf, nbytes);
+    }
+    if (file->save != nullptr) {
+        return ReadSaveBuffer(*file->save, offset, buf, nbytes);
+    }
     const s64 pos = file->f.Tell();
     SCOPE_EXIT {
         file->f.Seek(pos);
@@ -329,7 +455,13 @@ int PS4_SYSV_ABI sceKernelFStat(int fd, OrbisKernelStat* sb) {
         // TODO incomplete
     } else {
         sb->st_mode = 0000777u | 0100000u;
-        sb->st_size = file->f.GetSize();
+        if (file->pfs != nullptr) {
+            sb->st_size = file->pfs->GetSize(file->pfs_inode);
+        } else if (file->save != nullptr) {
+            sb->st_size = file->save->data.size();
+        } else {
+            sb->st_size = file->f.GetSize();
+        }
         sb->st_blksize = 512;
         sb->st_blocks = (sb->st_size + 511) / 512;
         // TODO incomplete
@@ -350,6 +482,11 @@ int PS4_SYSV_ABI posix_fstat(int fd, OrbisKernelStat* sb) {
 s32 PS4_SYSV_ABI sceKernelFsync(int fd) {
     auto* h = Common::Singleton<Core::FileSys::HandleTable>::Instance();
     auto* file = h->GetFile(fd);
+    if (file->save != nullptr) {
+        // Durability of overlay-backed files is the committer's job; returning
+        // immediately is the whole point of the write-behind layer.
+        return ORBIS_OK;
+    }
     file->f.Flush();
     return ORBIS_OK;
 }
@@ -407,6 +544,15 @@ s64 PS4_SYSV_ABI sceKernelPwrite(int d, void* buf, size_t nbytes, s64 offset) {
     }
 
     std::scoped_lock lk{file->m_mutex};
+    if (file->save != nullptr) {
+        auto& save = *file->save;
+        if (offset + nbytes > save.data.size()) {
+            save.data.resize(offset + nbytes);
+        }
+        std::memcpy(save.data.data() + offset, buf, nbytes);
+        save.dirty = true;
+        return nbytes;
+    }
     const s64 pos = file->f.Tell();
     SCOPE_EXIT {
         file->f.Seek(pos);
@@ -239,19 +239,20 @@ s32 PS4_SYSV_ABI sceKernelGetModuleInfoForUnwind(VAddr addr, int flags,
         return ORBIS_KERNEL_ERROR_EINVAL;
     }
 
-    // Find module that contains specified address.
-    LOG_INFO(Lib_Kernel, "called addr = {:#x}, flags = {:#x}", addr, flags);
+    // Find module that contains specified address. Titles that throw as
+    // control flow hit this on every unwind, so read the fields cached at
+    // load directly instead of building a full OrbisKernelModuleInfoEx.
+    LOG_TRACE(Lib_Kernel, "called addr = {:#x}, flags = {:#x}", addr, flags);
     auto* linker = Common::Singleton<Core::Linker>::Instance();
-    auto* module = linker->FindByAddress(addr);
-    const auto mod_info = module->GetModuleInfoEx();
+    const auto* module = linker->FindByAddress(addr);
 
     // Fill in module info.
-    info->name = mod_info.name;
-    info->eh_frame_hdr_addr = mod_info.eh_frame_hdr_addr;
-    info->eh_frame_addr = mod_info.eh_frame_addr;
-    info->eh_frame_size = mod_info.eh_frame_size;
-    info->seg0_addr = mod_info.segments[0].address;
-    info->seg0_size = mod_info.segments[0].size;
+    info->name = module->info.name;
+    info->eh_frame_hdr_addr = module->eh_frame_hdr_addr;
+    info->eh_frame_addr = module->eh_frame_addr;
+    info->eh_frame_size = module->eh_frame_size;
+    info->seg0_addr = module->info.segments[0].address;
+    info->seg0_size = module->info.segments[0].size;
     return ORBIS_OK;
 }
 
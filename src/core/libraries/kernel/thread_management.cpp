@@ -2,7 +2,9 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <mutex>
+#include <new>
 #include <thread>
+#include <utility>
 #include <semaphore.h>
 #include "common/alignment.h"
 #include "common/assert.h"
@@ -46,6 +48,7 @@ void init_pthreads() {
     g_pthread_cxt->setDefaultRwattr(default_rwattr);
 
     g_pthread_cxt->SetPthreadPool(new PThreadPool);
+    g_pthread_cxt->SetHostThreadPool(new HostThreadPool);
 }
 
 void pthreadInitSelfMainThread() {
@@ -453,7 +456,12 @@ int PS4_SYSV_ABI scePthreadMutexDestroy(ScePthreadMutex* mutex) {
 
     int result = pthread_mutex_destroy(&(*mutex)->pth_mutex);
 
-    LOG_INFO(Kernel_Pthread, "name={}, result={}", (*mutex)->name, result);
+    if (const u64 contended = (*mutex)->contention_count.load(std::memory_order_relaxed)) {
+        LOG_INFO(Kernel_Pthread, "name={}, result={}, contended={}", (*mutex)->name, result,
+                 contended);
+    } else {
+        LOG_INFO(Kernel_Pthread, "name={}, result={}", (*mutex)->name, result);
+    }
 
     delete *mutex;
     *mutex = nullptr;
@@ -533,21 +541,36 @@ int PS4_SYSV_ABI scePthreadMutexattrSetprotocol(ScePthreadMutexattr* attr, int p
     return result == 0 ? SCE_OK : SCE_KERNEL_ERROR_EINVAL;
 }
 
+static std::atomic<u64> g_mutex_contention_count{};
+
+u64 GuestMutexContentionCount() {
+    return g_mutex_contention_count.load(std::memory_order_relaxed);
+}
+
 int PS4_SYSV_ABI scePthreadMutexLock(ScePthreadMutex* mutex) {
     mutex = createMutex(mutex);
     if (mutex == nullptr) {
         return SCE_KERNEL_ERROR_EINVAL;
     }
 
-    (*mutex)->tracy_lock->BeforeLock();
+    // Uncontended locks are taken with the atomic fast path of trylock and
+    // skip the tracing bookkeeping entirely; only contended acquires fall
+    // into the blocking host call and are counted.
+    int result = pthread_mutex_trylock(&(*mutex)->pth_mutex);
+    if (result == EBUSY) {
+        (*mutex)->contention_count.fetch_add(1, std::memory_order_relaxed);
+        g_mutex_contention_count.fetch_add(1, std::memory_order_relaxed);
 
-    int result = pthread_mutex_lock(&(*mutex)->pth_mutex);
+        (*mutex)->tracy_lock->BeforeLock();
+        result = pthread_mutex_lock(&(*mutex)->pth_mutex);
+        (*mutex)->tracy_lock->AfterLock();
+    } else {
+        (*mutex)->tracy_lock->AfterTryLock(result == 0);
+    }
     if (result != 0) {
         LOG_TRACE(Kernel_Pthread, "Locked name={}, result={}", (*mutex)->name, result);
     }
 
-    (*mutex)->tracy_lock->AfterLock();
-
     switch (result) {
     case 0:
         return SCE_OK;
@@ -897,20 +920,84 @@ static void cleanup_thread(void* arg) {
         }
     }
     thread->is_almost_done = true;
+    // Joins are emulated against this state since the host thread is pooled
+    // and outlives the guest thread.
+    {
+        std::scoped_lock lock{thread->finish_mutex};
+        thread->is_done = true;
+    }
+    thread->finish_cv.notify_all();
+    if (thread->is_detached) {
+        thread->is_free = true;
+    }
 }
 
-static void* run_thread(void* arg) {
-    auto* thread = static_cast<ScePthread>(arg);
+static void run_thread(ScePthread thread) {
     Common::SetCurrentThreadName(thread->name.c_str());
     auto* linker = Common::Singleton<Core::Linker>::Instance();
     linker->InitTlsForThread(false);
-    void* ret = nullptr;
     g_pthread_self = thread;
     pthread_cleanup_push(cleanup_thread, thread);
     thread->is_started = true;
-    ret = thread->entry(thread->arg);
+    thread->ret_val = thread->entry(thread->arg);
     pthread_cleanup_pop(1);
-    return ret;
+}
+
+static void* pooled_worker(void* arg) {
+    auto* worker = static_cast<HostThreadPool::Worker*>(arg);
+    auto* pool = g_pthread_cxt->GetHostThreadPool();
+    while (true) {
+        ScePthread job{};
+        {
+            std::unique_lock lock{worker->mutex};
+            worker->cv.wait(lock, [worker] { return worker->shutdown || worker->job != nullptr; });
+            if (worker->shutdown) {
+                return nullptr;
+            }
+            job = std::exchange(worker->job, nullptr);
+        }
+        // A guest scePthreadExit unwinds through here and kills the host
+        // thread; only workers whose entry returned are parked for reuse.
+        run_thread(job);
+        pool->Park(worker);
+    }
+}
+
+int HostThreadPool::Launch(ScePthread thread) {
+    Worker* worker{};
+    {
+        std::scoped_lock lock{m_mutex};
+        if (!m_idle.empty()) {
+            worker = m_idle.back();
+            m_idle.pop_back();
+        }
+    }
+    if (worker != nullptr) {
+        thread->pth = worker->pth;
+        {
+            std::scoped_lock lock{worker->mutex};
+            worker->job = thread;
+        }
+        worker->cv.notify_one();
+        return 0;
+    }
+
+    auto new_worker = std::make_unique<Worker>();
+    worker = new_worker.get();
+    worker->job = thread;
+    const int result = pthread_create(&worker->pth, &thread->attr->pth_attr, pooled_worker, worker);
+    if (result != 0) {
+        return result;
+    }
+    thread->pth = worker->pth;
+    std::scoped_lock lock{m_mutex};
+    m_workers.push_back(std::move(new_worker));
+    return 0;
+}
+
+void HostThreadPool::Park(Worker* worker) {
+    std::scoped_lock lock{m_mutex};
+    m_idle.push_back(worker);
 }
 
 int PS4_SYSV_ABI scePthreadCreate(ScePthread* thread, const ScePthreadAttr* attr,
@@ -945,9 +1032,14 @@ int PS4_SYSV_ABI scePthreadCreate(ScePthread* thread, const ScePthreadAttr* attr
     (*thread)->is_almost_done = false;
     (*thread)->is_detached = (*attr)->detached;
     (*thread)->is_started = false;
+    (*thread)->is_done = false;
+    (*thread)->ret_val = nullptr;
 
-    pthread_attr_setstacksize(&(*attr)->pth_attr, 2_MB);
-    result = pthread_create(&(*thread)->pth, &(*attr)->pth_attr, run_thread, *thread);
+    // Every guest thread runs on the same forced stack size, so any parked
+    // worker can take the job and host thread creation is skipped entirely on
+    // reuse.
+    pthread_attr_setstacksize(&(*thread)->attr->pth_attr, 2_MB);
+    result = g_pthread_cxt->GetHostThreadPool()->Launch(*thread);
 
     LOG_INFO(Kernel_Pthread, "thread create name = {}", (*thread)->name);
 
@@ -986,6 +1078,9 @@ ScePthread PThreadPool::Create() {
         mmap(hint_address, sizeof(PthreadInternal), PROT_READ | PROT_WRITE,
              MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0));
     hint_address += Common::AlignUp(sizeof(PthreadInternal), 4_KB);
+    // The mapping is raw memory; the finish mutex/condvar need their
+    // constructors to run before anyone touches them.
+    new (ret) PthreadInternal{};
 #endif
 
     ret->is_free = false;
@@ -1017,18 +1112,28 @@ int PS4_SYSV_ABI scePthreadAttrGetstack(ScePthreadAttr* attr, void** addr, size_
     return SCE_KERNEL_ERROR_EINVAL;
 }
 
-int PS4_SYSV_ABI scePthreadJoin(ScePthread thread, void** res) {
-    int result = pthread_join(thread->pth, res);
-    LOG_INFO(Kernel_Pthread, "scePthreadJoin result = {}", result);
+// The host thread is pooled and keeps running after the guest entry returns,
+// so joining waits on the guest thread's finish state instead of the host
+// thread, then releases the control block for reuse.
+static int JoinPthread(ScePthread thread, void** res) {
+    std::unique_lock lock{thread->finish_mutex};
+    thread->finish_cv.wait(lock, [thread] { return thread->is_done.load(); });
+    if (res != nullptr) {
+        *res = thread->ret_val;
+    }
     thread->is_detached = false;
+    thread->is_free = true;
     return ORBIS_OK;
 }
 
+int PS4_SYSV_ABI scePthreadJoin(ScePthread thread, void** res) {
+    LOG_INFO(Kernel_Pthread, "scePthreadJoin name = {}", thread->name);
+    return JoinPthread(thread, res);
+}
+
 int PS4_SYSV_ABI posix_pthread_join(ScePthread thread, void** res) {
-    int result = pthread_join(thread->pth, res);
-    LOG_INFO(Kernel_Pthread, "posix_pthread_join result = {}", result);
-    thread->is_detached = false;
-    return ORBIS_OK;
+    LOG_INFO(Kernel_Pthread, "posix_pthread_join name = {}", thread->name);
+    return JoinPthread(thread, res);
 }
 
 int PS4_SYSV_ABI scePthreadDetach(ScePthread thread) {
@@ -1252,7 +1357,14 @@ int PS4_SYSV_ABI posix_pthread_setcancelstate(int state, int* oldstate) {
 }
 
 int PS4_SYSV_ABI posix_pthread_detach(ScePthread thread) {
-    return pthread_detach(thread->pth);
+    // The pooled host thread is never detached; only mark the guest thread so
+    // its control block is released once the entry finishes.
+    std::scoped_lock lock{thread->finish_mutex};
+    thread->is_detached = true;
+    if (thread->is_done) {
+        thread->is_free = true;
+    }
+    return ORBIS_OK;
 }
 
 int PS4_SYSV_ABI posix_sem_init(sem_t* sem, int pshared, unsigned int value) {
@@ -1288,6 +1400,10 @@ int PS4_SYSV_ABI scePthreadOnce(int* once_control, void (*init_routine)(void)) {
 }
 
 [[noreturn]] void PS4_SYSV_ABI scePthreadExit(void* value_ptr) {
+    // Terminates the host thread as well; the cleanup handler installed by
+    // run_thread publishes the result for joiners, and the worker is simply
+    // not returned to the pool.
+    g_pthread_self->ret_val = value_ptr;
     pthread_exit(value_ptr);
     UNREACHABLE();
 }
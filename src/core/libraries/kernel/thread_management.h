@@ -4,6 +4,8 @@
 #pragma once
 
 #include <atomic>
+#include <condition_variable>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -56,6 +58,10 @@ struct PthreadInternal {
     std::atomic_bool is_detached;
     std::atomic_bool is_almost_done;
     std::atomic_bool is_free;
+    std::atomic_bool is_done;
+    void* ret_val;
+    std::mutex finish_mutex;
+    std::condition_variable finish_cv;
     using Destructor = std::pair<OrbisPthreadKey, PthreadKeyDestructor>;
     std::vector<Destructor> key_destructors;
 };
@@ -73,6 +79,7 @@ struct PthreadMutexInternal {
     u8 reserved[256];
     std::string name;
     pthread_mutex_t pth_mutex;
+    std::atomic<u64> contention_count{};
     std::unique_ptr<tracy::LockableCtx> tracy_lock;
 };
 
@@ -113,6 +120,36 @@ private:
     std::mutex m_mutex;
 };
 
+/**
+ * Recycles host threads across guest thread lifetimes. Every guest thread runs
+ * with the same forced 2 MiB stack, so completed workers can pick up the next
+ * scePthreadCreate without paying host thread and stack creation again; TLS is
+ * reinitialized per incarnation. Joins are emulated through the finish state
+ * in PthreadInternal since the host thread outlives the guest thread.
+ */
+class HostThreadPool {
+public:
+    struct Worker {
+        pthread_t pth;
+        std::mutex mutex;
+        std::condition_variable cv;
+        ScePthread job{};
+        bool shutdown{};
+    };
+
+    /// Runs the prepared guest thread on an idle worker, creating a new host
+    /// thread only when none is parked. Returns 0 or the pthread_create error.
+    int Launch(ScePthread thread);
+
+    /// Returns a worker whose guest entry returned to the idle list.
+    void Park(Worker* worker);
+
+private:
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::vector<Worker*> m_idle;
+    std::mutex m_mutex;
+};
+
 class PThreadCxt {
 public:
     ScePthreadMutexattr* getDefaultMutexattr() {
@@ -139,6 +176,12 @@ public:
     void SetPthreadPool(PThreadPool* pool) {
         m_pthread_pool = pool;
     }
+    HostThreadPool* GetHostThreadPool() {
+        return m_host_thread_pool;
+    }
+    void SetHostThreadPool(HostThreadPool* pool) {
+        m_host_thread_pool = pool;
+    }
     OrbisPthreadRwlockattr* getDefaultRwattr() {
         return &m_default_Rwattr;
     }
@@ -151,12 +194,17 @@ private:
     ScePthreadCondattr m_default_condattr = nullptr;
     ScePthreadAttr m_default_attr = nullptr;
     PThreadPool* m_pthread_pool = nullptr;
+    HostThreadPool* m_host_thread_pool = nullptr;
     OrbisPthreadRwlockattr m_default_Rwattr = nullptr;
 };
 
 void init_pthreads();
 void pthreadInitSelfMainThread();
 
+/// Total number of guest mutex acquisitions that missed the uncontended fast
+/// path since boot; per-mutex counts are logged when a mutex is destroyed.
+u64 GuestMutexContentionCount();
+
 int PS4_SYSV_ABI scePthreadAttrInit(ScePthreadAttr* attr);
 int PS4_SYSV_ABI scePthreadAttrSetdetachstate(ScePthreadAttr* attr, int detachstate);
 int PS4_SYSV_ABI scePthreadAttrSetinheritsched(ScePthreadAttr* attr, int inheritSched);
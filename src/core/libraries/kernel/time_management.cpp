@@ -1,8 +1,12 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+#include <atomic>
 #include <thread>
 #include "common/assert.h"
+#include "common/config.h"
+#include "common/logging/log.h"
 #include "common/native_clock.h"
 #include "core/libraries/error_codes.h"
 #include "core/libraries/kernel/time_management.h"
@@ -21,11 +25,98 @@ static u32(__stdcall* NtDelayExecution)(BOOL Alertable, PLARGE_INTEGER DelayInte
 #include <unistd.h>
 #endif
 
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
 namespace Libraries::Kernel {
 
 static u64 initial_ptc;
+static u64 init_tsc_ns;
+static u64 init_realtime_ns;
+static u64 init_monotonic_ns;
 static std::unique_ptr<Common::NativeClock> clock;
 
+// Returns the host clock base advanced by the TSC time elapsed since calibration.
+// This keeps guest time queries at a rdtsc plus a fixed-point multiply, without
+// entering the kernel; games poll the clock tens of thousands of times per second.
+static u64 ClockFromTsc(u64 base_ns) {
+    return base_ns + clock->GetTimeNS() - init_tsc_ns;
+}
+
+// Puts the calling thread to sleep through the host scheduler.
+static void HostSleepNs(u64 ns) {
+#ifdef _WIN64
+    if (ns < 1'000'000u) {
+        LARGE_INTEGER interval{
+            .QuadPart = -1 * static_cast<s64>(ns / 100u),
+        };
+        NtDelayExecution(FALSE, &interval);
+    } else {
+        std::this_thread::sleep_for(std::chrono::nanoseconds(ns));
+    }
+#else
+    timespec start;
+    timespec remain;
+    start.tv_sec = ns / 1'000'000'000;
+    start.tv_nsec = ns % 1'000'000'000;
+    timespec* requested = &start;
+    while (nanosleep(requested, &remain) != 0) {
+        requested = &remain;
+    }
+#endif
+}
+
+// Overshoot histogram of the hybrid waiter (<1us, <10us, <100us, <1ms, >=1ms),
+// dumped every few thousand sleeps to validate pacing against the host timer.
+static std::array<std::atomic<u64>, 5> wait_error_buckets;
+static std::atomic<u64> wait_error_count;
+
+static void RecordWaitError(u64 error_ns) {
+    size_t bucket;
+    if (error_ns < 1'000) {
+        bucket = 0;
+    } else if (error_ns < 10'000) {
+        bucket = 1;
+    } else if (error_ns < 100'000) {
+        bucket = 2;
+    } else if (error_ns < 1'000'000) {
+        bucket = 3;
+    } else {
+        bucket = 4;
+    }
+    wait_error_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    if ((wait_error_count.fetch_add(1, std::memory_order_relaxed) + 1) % 8192 == 0) {
+        LOG_DEBUG(Kernel, "Sleep overshoot: <1us={} <10us={} <100us={} <1ms={} >=1ms={}",
+                  wait_error_buckets[0].load(), wait_error_buckets[1].load(),
+                  wait_error_buckets[2].load(), wait_error_buckets[3].load(),
+                  wait_error_buckets[4].load());
+    }
+}
+
+// Hybrid waiter: sleep the coarse remainder through the scheduler, then spin
+// the final stretch on the TSC. Titles pace frames with sleeps of a few
+// hundred microseconds, which plain host sleeps overshoot by the timer
+// granularity (~1 ms on Windows).
+static constexpr u64 SpinWindowNs = 50'000;
+
+static void PreciseSleepNs(u64 ns) {
+    const u64 deadline = clock->GetTimeNS() + ns;
+    if (ns > SpinWindowNs) {
+        HostSleepNs(ns - SpinWindowNs);
+    }
+    u64 now = clock->GetTimeNS();
+    while (now < deadline) {
+#if defined(__x86_64__) || defined(_M_X64)
+        _mm_pause();
+#else
+        std::this_thread::yield();
+#endif
+        now = clock->GetTimeNS();
+    }
+    RecordWaitError(now - deadline);
+}
+
 u64 PS4_SYSV_ABI sceKernelGetTscFrequency() {
     return clock->GetTscFrequency();
 }
@@ -47,6 +138,10 @@ u64 PS4_SYSV_ABI sceKernelReadTsc() {
 }
 
 int PS4_SYSV_ABI sceKernelUsleep(u32 microseconds) {
+    if (Config::preciseSleep()) {
+        PreciseSleepNs(static_cast<u64>(microseconds) * 1000);
+        return 0;
+    }
 #ifdef _WIN64
     if (microseconds < 1000u) {
         LARGE_INTEGER interval{
@@ -85,31 +180,26 @@ int PS4_SYSV_ABI sceKernelClockGettime(s32 clock_id, OrbisKernelTimespec* tp) {
     if (tp == nullptr) {
         return SCE_KERNEL_ERROR_EFAULT;
     }
-    clockid_t pclock_id = CLOCK_REALTIME;
+    u64 ns;
     switch (clock_id) {
     case ORBIS_CLOCK_REALTIME:
     case ORBIS_CLOCK_REALTIME_PRECISE:
     case ORBIS_CLOCK_REALTIME_FAST:
-        pclock_id = CLOCK_REALTIME;
+        ns = ClockFromTsc(init_realtime_ns);
         break;
     case ORBIS_CLOCK_SECOND:
     case ORBIS_CLOCK_MONOTONIC:
     case ORBIS_CLOCK_MONOTONIC_PRECISE:
     case ORBIS_CLOCK_MONOTONIC_FAST:
-        pclock_id = CLOCK_MONOTONIC;
+        ns = ClockFromTsc(init_monotonic_ns);
         break;
     default:
         UNREACHABLE();
     }
 
-    timespec t{};
-    int result = clock_gettime(pclock_id, &t);
-    tp->tv_sec = t.tv_sec;
-    tp->tv_nsec = t.tv_nsec;
-    if (result == 0) {
-        return SCE_OK;
-    }
-    return SCE_KERNEL_ERROR_EINVAL;
+    tp->tv_sec = ns / 1'000'000'000;
+    tp->tv_nsec = ns % 1'000'000'000;
+    return SCE_OK;
 }
 
 int PS4_SYSV_ABI posix_clock_gettime(s32 clock_id, OrbisKernelTimespec* time) {
@@ -121,6 +211,14 @@ int PS4_SYSV_ABI posix_clock_gettime(s32 clock_id, OrbisKernelTimespec* time) {
 }
 
 int PS4_SYSV_ABI posix_nanosleep(const OrbisKernelTimespec* rqtp, OrbisKernelTimespec* rmtp) {
+    if (Config::preciseSleep() && rqtp && rqtp->tv_sec >= 0 && rqtp->tv_nsec >= 0) {
+        PreciseSleepNs(rqtp->tv_sec * 1'000'000'000ULL + rqtp->tv_nsec);
+        if (rmtp) {
+            rmtp->tv_sec = 0;
+            rmtp->tv_nsec = 0;
+        }
+        return 0;
+    }
     const auto* request = reinterpret_cast<const timespec*>(rqtp);
     auto* remain = reinterpret_cast<timespec*>(rmtp);
     return nanosleep(request, remain);
@@ -143,13 +241,9 @@ int PS4_SYSV_ABI sceKernelGettimeofday(OrbisKernelTimeval* tp) {
         return ORBIS_KERNEL_ERROR_EFAULT;
     }
 
-    auto now = std::chrono::system_clock::now();
-    auto duration = now.time_since_epoch();
-    auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration);
-    auto microsecs = std::chrono::duration_cast<std::chrono::microseconds>(duration - seconds);
-
-    tp->tv_sec = seconds.count();
-    tp->tv_usec = microsecs.count();
+    const u64 us = ClockFromTsc(init_realtime_ns) / 1000;
+    tp->tv_sec = us / 1'000'000;
+    tp->tv_usec = us % 1'000'000;
     return ORBIS_OK;
 }
 
@@ -217,6 +311,15 @@ int PS4_SYSV_ABI posix_clock_getres(u32 clock_id, OrbisKernelTimespec* res) {
 void timeSymbolsRegister(Core::Loader::SymbolsResolver* sym) {
     clock = std::make_unique<Common::NativeClock>();
     initial_ptc = clock->GetUptime();
+
+    // Calibrate host clock bases against the TSC once; afterwards every guest
+    // time source is derived from rdtsc alone.
+    timespec now{};
+    clock_gettime(CLOCK_REALTIME, &now);
+    init_realtime_ns = now.tv_sec * 1'000'000'000ULL + now.tv_nsec;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    init_monotonic_ns = now.tv_sec * 1'000'000'000ULL + now.tv_nsec;
+    init_tsc_ns = clock->GetTimeNS();
     LIB_FUNCTION("4J2sUJmuHZQ", "libkernel", 1, "libkernel", 1, 1, sceKernelGetProcessTime);
     LIB_FUNCTION("fgxnMeTNUtY", "libkernel", 1, "libkernel", 1, 1, sceKernelGetProcessTimeCounter);
     LIB_FUNCTION("BNowx2l588E", "libkernel", 1, "libkernel", 1, 1,
@@ -1,27 +1,392 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cmath>
 #include "common/logging/log.h"
+#include "common/types.h"
 #include "core/libraries/error_codes.h"
 #include "core/libraries/libs.h"
 #include "libc_internal.h"
 
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#define LIBC_SIMD_KERNELS
+#endif
+
 namespace Libraries::LibcInternal {
 
-void* PS4_SYSV_ABI internal_memset(void* s, int c, size_t n) {
+namespace {
+
+using CopyFn = void* (*)(void* dest, const void* src, size_t n);
+using SetFn = void* (*)(void* s, int c, size_t n);
+
+// Guest memcpy/memset traffic is dominated by a few size classes (GPU staging
+// uploads on the large end, string/struct copies on the small end). Calls are
+// bucketed by log2 size both to pick a kernel and to feed the histogram that
+// lets us verify the kernels actually see the sizes they were built for.
+constexpr size_t NumSizeBuckets = sizeof(size_t) * 8 + 1;
+
+// Copies at least this large bypass the cache with streaming stores; they are
+// larger than any sane LLC share and would only evict hot data on the way
+// through.
+constexpr size_t NonTemporalThreshold = 2_MB;
+
+// Below this size the vector loop setup costs more than it saves and plain
+// memcpy (which compilers inline aggressively for small constants) wins.
+constexpr size_t VectorThreshold = 128;
+
+enum class Route : u8 {
+    Small,       ///< Host libc; size too small to amortize kernel entry.
+    Vector,      ///< Widest available cached vector kernel.
+    NonTemporal, ///< Streaming-store kernel; bypasses the cache hierarchy.
+};
+
+consteval std::array<Route, NumSizeBuckets> BuildRouteTable() {
+    std::array<Route, NumSizeBuckets> table{};
+    for (size_t bucket = 0; bucket < NumSizeBuckets; bucket++) {
+        const size_t max_size = bucket == 0 ? 0 : (size_t{1} << bucket) - 1;
+        if (max_size < VectorThreshold) {
+            table[bucket] = Route::Small;
+        } else if (max_size < NonTemporalThreshold) {
+            table[bucket] = Route::Vector;
+        } else {
+            table[bucket] = Route::NonTemporal;
+        }
+    }
+    return table;
+}
+
+constexpr std::array<Route, NumSizeBuckets> RouteTable = BuildRouteTable();
+
+std::array<std::atomic<u64>, NumSizeBuckets> size_histogram{};
+std::atomic<u64> total_calls{};
+
+void RecordSize(size_t n) {
+    size_histogram[std::bit_width(n)].fetch_add(1, std::memory_order_relaxed);
+    // Dump the histogram every so often; debug-only since the interesting
+    // number is the final distribution, not the trend.
+    constexpr u64 ReportInterval = 1ULL << 26;
+    if ((total_calls.fetch_add(1, std::memory_order_relaxed) + 1) % ReportInterval == 0) {
+        for (size_t bucket = 0; bucket < NumSizeBuckets; bucket++) {
+            const u64 count = size_histogram[bucket].load(std::memory_order_relaxed);
+            if (count != 0) {
+                LOG_DEBUG(Lib_LibC, "memcpy/memset sizes < 2^{}: {} calls", bucket, count);
+            }
+        }
+    }
+}
+
+void* CopySmall(void* dest, const void* src, size_t n) {
+    return std::memcpy(dest, src, n);
+}
+
+void* SetSmall(void* s, int c, size_t n) {
     return std::memset(s, c, n);
 }
 
+#ifdef LIBC_SIMD_KERNELS
+
+#ifdef _MSC_VER
+#define TARGET_AVX2
+#define TARGET_AVX512
+#else
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#define TARGET_AVX512 __attribute__((target("avx512f")))
+#endif
+
+bool CheckAvx2Support() {
+#ifdef _MSC_VER
+    int regs[4];
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+bool CheckAvx512Support() {
+#ifdef _MSC_VER
+    int regs[4];
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 16)) != 0;
+#else
+    return __builtin_cpu_supports("avx512f");
+#endif
+}
+
+// All vector kernels assume n >= one vector width; the dispatcher guarantees
+// it. Loads are unaligned (cheap on every AVX2 part), stores are aligned to
+// the destination after a small unaligned head, and the tail re-copies the
+// last vector's worth of bytes unaligned.
+
+TARGET_AVX2 void* CopyAvx2(void* dest, const void* src, size_t n) {
+    u8* d = static_cast<u8*>(dest);
+    const u8* s = static_cast<const u8*>(src);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d),
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)));
+    const size_t head = 32 - (reinterpret_cast<uintptr_t>(d) & 31);
+    d += head;
+    s += head;
+    size_t left = n - head;
+    while (left >= 128) {
+        const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+        const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 32));
+        const __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 64));
+        const __m256i v3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 96));
+        _mm256_store_si256(reinterpret_cast<__m256i*>(d), v0);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(d + 32), v1);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(d + 64), v2);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(d + 96), v3);
+        d += 128;
+        s += 128;
+        left -= 128;
+    }
+    while (left >= 32) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(d),
+                           _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)));
+        d += 32;
+        s += 32;
+        left -= 32;
+    }
+    if (left != 0) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + left - 32),
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + left - 32)));
+    }
+    return dest;
+}
+
+TARGET_AVX2 void* CopyAvx2Nt(void* dest, const void* src, size_t n) {
+    u8* d = static_cast<u8*>(dest);
+    const u8* s = static_cast<const u8*>(src);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d),
+                        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)));
+    const size_t head = 32 - (reinterpret_cast<uintptr_t>(d) & 31);
+    d += head;
+    s += head;
+    size_t left = n - head;
+    while (left >= 128) {
+        const __m256i v0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s));
+        const __m256i v1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 32));
+        const __m256i v2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 64));
+        const __m256i v3 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + 96));
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d), v0);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 32), v1);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 64), v2);
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d + 96), v3);
+        d += 128;
+        s += 128;
+        left -= 128;
+    }
+    _mm_sfence();
+    while (left >= 32) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d),
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s)));
+        d += 32;
+        s += 32;
+        left -= 32;
+    }
+    if (left != 0) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + left - 32),
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + left - 32)));
+    }
+    return dest;
+}
+
+TARGET_AVX512 void* CopyAvx512(void* dest, const void* src, size_t n) {
+    u8* d = static_cast<u8*>(dest);
+    const u8* s = static_cast<const u8*>(src);
+    _mm512_storeu_si512(d, _mm512_loadu_si512(s));
+    const size_t head = 64 - (reinterpret_cast<uintptr_t>(d) & 63);
+    d += head;
+    s += head;
+    size_t left = n - head;
+    while (left >= 256) {
+        const __m512i v0 = _mm512_loadu_si512(s);
+        const __m512i v1 = _mm512_loadu_si512(s + 64);
+        const __m512i v2 = _mm512_loadu_si512(s + 128);
+        const __m512i v3 = _mm512_loadu_si512(s + 192);
+        _mm512_store_si512(d, v0);
+        _mm512_store_si512(d + 64, v1);
+        _mm512_store_si512(d + 128, v2);
+        _mm512_store_si512(d + 192, v3);
+        d += 256;
+        s += 256;
+        left -= 256;
+    }
+    while (left >= 64) {
+        _mm512_store_si512(d, _mm512_loadu_si512(s));
+        d += 64;
+        s += 64;
+        left -= 64;
+    }
+    if (left != 0) {
+        _mm512_storeu_si512(d + left - 64, _mm512_loadu_si512(s + left - 64));
+    }
+    return dest;
+}
+
+TARGET_AVX512 void* CopyAvx512Nt(void* dest, const void* src, size_t n) {
+    u8* d = static_cast<u8*>(dest);
+    const u8* s = static_cast<const u8*>(src);
+    _mm512_storeu_si512(d, _mm512_loadu_si512(s));
+    const size_t head = 64 - (reinterpret_cast<uintptr_t>(d) & 63);
+    d += head;
+    s += head;
+    size_t left = n - head;
+    while (left >= 256) {
+        const __m512i v0 = _mm512_loadu_si512(s);
+        const __m512i v1 = _mm512_loadu_si512(s + 64);
+        const __m512i v2 = _mm512_loadu_si512(s + 128);
+        const __m512i v3 = _mm512_loadu_si512(s + 192);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(d), v0);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 64), v1);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 128), v2);
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(d + 192), v3);
+        d += 256;
+        s += 256;
+        left -= 256;
+    }
+    _mm_sfence();
+    while (left >= 64) {
+        _mm512_storeu_si512(d, _mm512_loadu_si512(s));
+        d += 64;
+        s += 64;
+        left -= 64;
+    }
+    if (left != 0) {
+        _mm512_storeu_si512(d + left - 64, _mm512_loadu_si512(s + left - 64));
+    }
+    return dest;
+}
+
+TARGET_AVX2 void* SetAvx2(void* dest, int c, size_t n) {
+    u8* d = static_cast<u8*>(dest);
+    const __m256i v = _mm256_set1_epi8(static_cast<char>(c));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), v);
+    const size_t head = 32 - (reinterpret_cast<uintptr_t>(d) & 31);
+    d += head;
+    size_t left = n - head;
+    while (left >= 128) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(d), v);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(d + 32), v);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(d + 64), v);
+        _mm256_store_si256(reinterpret_cast<__m256i*>(d + 96), v);
+        d += 128;
+        left -= 128;
+    }
+    while (left >= 32) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(d), v);
+        d += 32;
+        left -= 32;
+    }
+    if (left != 0) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + left - 32), v);
+    }
+    return dest;
+}
+
+TARGET_AVX2 void* SetAvx2Nt(void* dest, int c, size_t n) {
+    u8* d = static_cast<u8*>(dest);
+    const __m256i v = _mm256_set1_epi8(static_cast<char>(c));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(d), v);
+    const size_t head = 32 - (reinterpret_cast<uintptr_t>(d) & 31);
+    d += head;
+    size_t left = n - head;
+    while (left >= 32) {
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(d), v);
+        d += 32;
+        left -= 32;
+    }
+    _mm_sfence();
+    if (left != 0) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(d + left - 32), v);
+    }
+    return dest;
+}
+
+#endif // LIBC_SIMD_KERNELS
+
+/// Widest kernels the host supports, resolved once on first use.
+struct MemoryKernels {
+    CopyFn copy = CopySmall;
+    CopyFn copy_nt = CopySmall;
+    SetFn set = SetSmall;
+    SetFn set_nt = SetSmall;
+};
+
+MemoryKernels SelectKernels() {
+    MemoryKernels kernels{};
+#ifdef LIBC_SIMD_KERNELS
+    if (CheckAvx512Support()) {
+        kernels.copy = CopyAvx512;
+        kernels.copy_nt = CopyAvx512Nt;
+        kernels.set = SetAvx2;
+        kernels.set_nt = SetAvx2Nt;
+        LOG_INFO(Lib_LibC, "Using AVX-512 memcpy kernels");
+    } else if (CheckAvx2Support()) {
+        kernels.copy = CopyAvx2;
+        kernels.copy_nt = CopyAvx2Nt;
+        kernels.set = SetAvx2;
+        kernels.set_nt = SetAvx2Nt;
+        LOG_INFO(Lib_LibC, "Using AVX2 memcpy kernels");
+    }
+#endif
+    return kernels;
+}
+
+const MemoryKernels& GetKernels() {
+    static const MemoryKernels kernels = SelectKernels();
+    return kernels;
+}
+
+void* DispatchCopy(void* dest, const void* src, size_t n) {
+    RecordSize(n);
+    switch (RouteTable[std::bit_width(n)]) {
+    case Route::Vector:
+        return GetKernels().copy(dest, src, n);
+    case Route::NonTemporal:
+        return GetKernels().copy_nt(dest, src, n);
+    case Route::Small:
+    default:
+        return CopySmall(dest, src, n);
+    }
+}
+
+void* DispatchSet(void* s, int c, size_t n) {
+    RecordSize(n);
+    switch (RouteTable[std::bit_width(n)]) {
+    case Route::Vector:
+        return GetKernels().set(s, c, n);
+    case Route::NonTemporal:
+        return GetKernels().set_nt(s, c, n);
+    case Route::Small:
+    default:
+        return SetSmall(s, c, n);
+    }
+}
+
+} // Anonymous namespace
+
+void* PS4_SYSV_ABI internal_memset(void* s, int c, size_t n) {
+    return DispatchSet(s, c, n);
+}
+
 void* PS4_SYSV_ABI internal_memcpy(void* dest, const void* src, size_t n) {
-    return std::memcpy(dest, src, n);
+    return DispatchCopy(dest, src, n);
 }
 
 int PS4_SYSV_ABI internal_memcpy_s(void* dest, size_t destsz, const void* src, size_t count) {
 #ifdef _WIN64
-    return memcpy_s(dest, destsz, src, count);
+    if (count > destsz) {
+        return memcpy_s(dest, destsz, src, count);
+    }
+    DispatchCopy(dest, src, count);
+    return 0;
 #else
-    std::memcpy(dest, src, count);
+    DispatchCopy(dest, src, count);
     return 0; // ALL OK
 #endif
 }
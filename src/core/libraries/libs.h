@@ -22,20 +22,30 @@ struct wrapper_impl;
 
 template <StringLiteral name, class R, class... Args, PS4_SYSV_ABI R (*f)(Args...)>
 struct wrapper_impl<name, PS4_SYSV_ABI R (*)(Args...), f> {
+    // Functions called at millions-of-calls-per-second rates where even the
+    // logging checks of the debug wrapper are measurable. The exclusion is
+    // resolved at compile time, so these thunk straight to the implementation.
+    static constexpr bool is_hot_call = std::string_view(name.value) == "scePthreadEqual" ||
+                                        std::string_view(name.value) == "sceUserServiceGetEvent" ||
+                                        std::string_view(name.value) == "sceKernelClockGettime" ||
+                                        std::string_view(name.value) == "scePadReadState" ||
+                                        std::string_view(name.value) == "sceAudioOutOutput";
+
     static R PS4_SYSV_ABI wrap(Args... args) {
-        if (std::string_view(name.value) != "scePthreadEqual" &&
-            std::string_view(name.value) != "sceUserServiceGetEvent") {
+        if constexpr (is_hot_call) {
+            return f(args...);
+        } else {
             // LOG_WARNING(Core_Linker, "Function {} called", name.value);
-        }
-        if constexpr (std::is_same_v<R, s32> || std::is_same_v<R, u32>) {
-            const u32 ret = f(args...);
-            if (ret != 0 && std::string_view(name.value) != "scePthreadEqual") {
-                LOG_WARNING(Core_Linker, "Function {} returned {:#x}", name.value, ret);
+            if constexpr (std::is_same_v<R, s32> || std::is_same_v<R, u32>) {
+                const u32 ret = f(args...);
+                if (ret != 0) {
+                    LOG_WARNING(Core_Linker, "Function {} returned {:#x}", name.value, ret);
+                }
+                return ret;
+            } else {
+                return f(args...);
             }
-            return ret;
         }
-        // stuff
-        return f(args...);
     }
 };
 
@@ -1,13 +1,255 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <vector>
 #include "common/logging/log.h"
+#include "common/slot_vector.h"
 #include "core/libraries/error_codes.h"
 #include "core/libraries/libs.h"
 #include "core/libraries/network/http.h"
+#include "core/libraries/network/net_transport.h"
 
 namespace Libraries::Http {
 
+namespace {
+
+struct Template {
+    std::string user_agent;
+    int http_ver;
+};
+
+struct Connection {
+    std::string host;
+    u16 port{};
+    bool keep_alive{};
+};
+
+struct Request {
+    std::string method;
+    std::string host;
+    std::string path;
+    std::string user_agent;
+    u16 port{};
+    bool keep_alive{};
+    u64 request_body_length{};
+    std::vector<std::pair<std::string, std::string>> headers;
+
+    // Response state, valid once sceHttpSendRequest succeeded.
+    Net::NetSocket fd = Net::InvalidSocket;
+    bool sent{};
+    int status_code{};
+    int content_length_kind{}; // 0 = not present, 1 = present, 2 = chunked
+    u64 content_length{};
+    u64 body_remaining{};
+    u64 chunk_remaining{};
+    bool last_chunk{};
+    bool close_after{};
+    std::vector<u8> buffered;
+    size_t buffered_pos{};
+};
+
+std::mutex http_mutex;
+bool http_initialized = false;
+Common::SlotVector<Template> templates;
+Common::SlotVector<Connection> connections;
+Common::SlotVector<Request> requests;
+
+constexpr std::array<const char*, 8> MethodNames = {"GET", "POST",   "HEAD",  "OPTIONS",
+                                                    "PUT", "DELETE", "TRACE", "CONNECT"};
+
+bool ParseUrl(const char* url, std::string& host, u16& port, std::string& path) {
+    std::string_view view{url};
+    // Only plain HTTP can be carried until the SSL module grows a real TLS
+    // implementation.
+    if (!view.starts_with("http://")) {
+        return false;
+    }
+    view.remove_prefix(7);
+    const size_t path_pos = view.find('/');
+    std::string_view authority = view.substr(0, path_pos);
+    path = path_pos == std::string_view::npos ? "/" : std::string{view.substr(path_pos)};
+    port = 80;
+    if (const size_t colon = authority.rfind(':'); colon != std::string_view::npos) {
+        u32 parsed{};
+        const auto* end = authority.data() + authority.size();
+        if (std::from_chars(authority.data() + colon + 1, end, parsed).ptr != end) {
+            return false;
+        }
+        port = static_cast<u16>(parsed);
+        authority = authority.substr(0, colon);
+    }
+    host = std::string{authority};
+    return !host.empty();
+}
+
+bool SendAll(Net::NetSocket fd, const void* data, size_t size) {
+    const char* ptr = static_cast<const char*>(data);
+    while (size != 0) {
+        const auto sent = send(fd, ptr, static_cast<int>(size), 0);
+        if (sent <= 0) {
+            return false;
+        }
+        ptr += sent;
+        size -= sent;
+    }
+    return true;
+}
+
+/// Reads body bytes, draining the header read-ahead buffer before touching the
+/// socket; socket reads land directly in the caller's buffer.
+s64 ReadRaw(Request& req, void* out, u64 want) {
+    if (req.buffered_pos < req.buffered.size()) {
+        const u64 copied = std::min<u64>(want, req.buffered.size() - req.buffered_pos);
+        std::memcpy(out, req.buffered.data() + req.buffered_pos, copied);
+        req.buffered_pos += copied;
+        return static_cast<s64>(copied);
+    }
+    return recv(req.fd, static_cast<char*>(out), static_cast<int>(want), 0);
+}
+
+/// Consumes one "size CRLF" chunk header; the CRLF terminating the previous
+/// chunk is skipped as an empty line.
+bool ReadChunkHeader(Request& req) {
+    std::string line;
+    char byte;
+    while (ReadRaw(req, &byte, 1) == 1) {
+        if (byte == '\n') {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.empty()) {
+                continue;
+            }
+            u64 size{};
+            if (std::from_chars(line.data(), line.data() + line.size(), size, 16).ec !=
+                std::errc{}) {
+                return false;
+            }
+            req.chunk_remaining = size;
+            req.last_chunk = size == 0;
+            return true;
+        }
+        line.push_back(byte);
+        if (line.size() > 128) {
+            return false;
+        }
+    }
+    return false;
+}
+
+/// Returns the connection to the keep-alive pool when the body was fully
+/// drained, otherwise closes it.
+void FinishBody(Request& req) {
+    if (req.fd == Net::InvalidSocket) {
+        return;
+    }
+    const bool drained = (req.content_length_kind == 1 && req.body_remaining == 0) ||
+                         (req.content_length_kind == 2 && req.last_chunk);
+    if (req.keep_alive && drained && !req.close_after) {
+        Net::ConnectionPool::Instance().Release(req.host, req.port, req.fd);
+    } else {
+        Net::CloseSocket(req.fd);
+    }
+    req.fd = Net::InvalidSocket;
+}
+
+std::string BuildRequestHead(const Request& req, u64 body_size) {
+    std::string head =
+        fmt::format("{} {} HTTP/1.1\r\nHost: {}\r\n", req.method, req.path,
+                    req.port == 80 ? req.host : fmt::format("{}:{}", req.host, req.port));
+    if (!req.user_agent.empty()) {
+        head += fmt::format("User-Agent: {}\r\n", req.user_agent);
+    }
+    head += req.keep_alive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+    if (body_size != 0 || req.method == "POST" || req.method == "PUT") {
+        head += fmt::format("Content-Length: {}\r\n", body_size);
+    }
+    for (const auto& [name, value] : req.headers) {
+        head += fmt::format("{}: {}\r\n", name, value);
+    }
+    head += "\r\n";
+    return head;
+}
+
+/// Sends the request on fd and parses the response head into req. Returns
+/// false on transport failure (possibly a stale keep-alive connection).
+bool PerformOnSocket(Request& req, Net::NetSocket fd, const void* body, u64 body_size) {
+    req.fd = fd;
+    const std::string head = BuildRequestHead(req, body_size);
+    if (!SendAll(fd, head.data(), head.size())) {
+        return false;
+    }
+    if (body_size != 0 && !SendAll(fd, body, body_size)) {
+        return false;
+    }
+
+    // Read until the end of the header block; whatever follows it stays
+    // buffered as body read-ahead.
+    req.buffered.clear();
+    req.buffered_pos = 0;
+    size_t head_end = std::string::npos;
+    while (head_end == std::string::npos) {
+        std::array<char, 4096> chunk;
+        const auto received = recv(fd, chunk.data(), static_cast<int>(chunk.size()), 0);
+        if (received <= 0) {
+            return false;
+        }
+        req.buffered.insert(req.buffered.end(), chunk.data(), chunk.data() + received);
+        if (req.buffered.size() > 256_KB) {
+            return false;
+        }
+        const std::string_view view{reinterpret_cast<const char*>(req.buffered.data()),
+                                    req.buffered.size()};
+        head_end = view.find("\r\n\r\n");
+    }
+
+    const std::string_view view{reinterpret_cast<const char*>(req.buffered.data()), head_end};
+    const size_t status_pos = view.find(' ');
+    if (!view.starts_with("HTTP/") || status_pos == std::string_view::npos) {
+        return false;
+    }
+    req.status_code = 0;
+    std::from_chars(view.data() + status_pos + 1, view.data() + view.size(), req.status_code);
+
+    req.content_length_kind = 0;
+    req.close_after = !req.keep_alive;
+    for (size_t pos = view.find("\r\n"); pos != std::string_view::npos;) {
+        const size_t line_end = view.find("\r\n", pos + 2);
+        std::string line{view.substr(pos + 2, line_end - pos - 2)};
+        pos = line_end;
+        const size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        std::string name = line.substr(0, colon);
+        std::ranges::transform(name, name.begin(), [](char c) { return std::tolower(c); });
+        const size_t value_pos = line.find_first_not_of(' ', colon + 1);
+        const std::string value = value_pos == std::string::npos ? "" : line.substr(value_pos);
+        if (name == "content-length") {
+            req.content_length_kind = 1;
+            req.content_length = std::strtoull(value.c_str(), nullptr, 10);
+            req.body_remaining = req.content_length;
+        } else if (name == "transfer-encoding" && value.find("chunked") != std::string::npos) {
+            req.content_length_kind = 2;
+            req.chunk_remaining = 0;
+            req.last_chunk = false;
+        } else if (name == "connection" && value.find("close") != std::string::npos) {
+            req.close_after = true;
+        }
+    }
+    req.buffered_pos = head_end + 4;
+    return true;
+}
+
+} // namespace
+
 int PS4_SYSV_ABI sceHttpAbortRequest() {
     LOG_ERROR(Lib_Http, "(STUBBED) called");
     return ORBIS_OK;
@@ -33,8 +275,28 @@ int PS4_SYSV_ABI sceHttpAddQuery() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpAddRequestHeader() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpAddRequestHeader(int id, const char* name, const char* value, u32 mode) {
+    LOG_INFO(Lib_Http, "id = {} name = {} value = {}", id, name ? name : "(null)",
+             value ? value : "(null)");
+    std::scoped_lock lk{http_mutex};
+    if (!requests.is_allocated({static_cast<u32>(id)})) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    if (!name || !value) {
+        return ORBIS_HTTP_ERROR_INVALID_VALUE;
+    }
+    auto& headers = requests[{static_cast<u32>(id)}].headers;
+    if (mode != 0) { // SCE_HTTP_HEADER_ADD appends, overwrite is the default.
+        headers.emplace_back(name, value);
+        return ORBIS_OK;
+    }
+    for (auto& [existing_name, existing_value] : headers) {
+        if (existing_name == name) {
+            existing_value = value;
+            return ORBIS_OK;
+        }
+    }
+    headers.emplace_back(name, value);
     return ORBIS_OK;
 }
 
@@ -83,9 +345,21 @@ int PS4_SYSV_ABI sceHttpCreateConnection() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpCreateConnectionWithURL() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
-    return ORBIS_OK;
+int PS4_SYSV_ABI sceHttpCreateConnectionWithURL(int tmplId, const char* url,
+                                                int isEnableKeepalive) {
+    LOG_INFO(Lib_Http, "tmplId = {} url = {} keepalive = {}", tmplId, url ? url : "(null)",
+             isEnableKeepalive);
+    std::scoped_lock lk{http_mutex};
+    if (!templates.is_allocated({static_cast<u32>(tmplId)})) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    Connection connection{};
+    std::string path;
+    if (!url || !ParseUrl(url, connection.host, connection.port, path)) {
+        return ORBIS_HTTP_ERROR_INVALID_URL;
+    }
+    connection.keep_alive = isEnableKeepalive != 0;
+    return static_cast<int>(connections.insert(std::move(connection)).index);
 }
 
 int PS4_SYSV_ABI sceHttpCreateEpoll() {
@@ -103,9 +377,25 @@ int PS4_SYSV_ABI sceHttpCreateRequest2() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpCreateRequestWithURL() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
-    return ORBIS_OK;
+int PS4_SYSV_ABI sceHttpCreateRequestWithURL(int connId, int method, const char* url,
+                                             u64 contentLength) {
+    LOG_INFO(Lib_Http, "connId = {} method = {} url = {}", connId, method, url ? url : "(null)");
+    std::scoped_lock lk{http_mutex};
+    if (!connections.is_allocated({static_cast<u32>(connId)})) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    if (method < 0 || method >= static_cast<int>(MethodNames.size())) {
+        return ORBIS_HTTP_ERROR_UNKNOWN_METHOD;
+    }
+    Request request{};
+    if (!url || !ParseUrl(url, request.host, request.port, request.path)) {
+        return ORBIS_HTTP_ERROR_INVALID_URL;
+    }
+    const Connection& connection = connections[{static_cast<u32>(connId)}];
+    request.method = MethodNames[method];
+    request.keep_alive = connection.keep_alive;
+    request.request_body_length = contentLength;
+    return static_cast<int>(requests.insert(std::move(request)).index);
 }
 
 int PS4_SYSV_ABI sceHttpCreateRequestWithURL2() {
@@ -113,9 +403,14 @@ int PS4_SYSV_ABI sceHttpCreateRequestWithURL2() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpCreateTemplate() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
-    return ORBIS_OK;
+int PS4_SYSV_ABI sceHttpCreateTemplate(int libhttpCtxId, const char* userAgent, int httpVer,
+                                       int isAutoProxyConn) {
+    LOG_INFO(Lib_Http, "userAgent = {} httpVer = {}", userAgent ? userAgent : "(null)", httpVer);
+    std::scoped_lock lk{http_mutex};
+    if (!http_initialized) {
+        return ORBIS_HTTP_ERROR_BEFORE_INIT;
+    }
+    return static_cast<int>(templates.insert(userAgent ? userAgent : "", httpVer).index);
 }
 
 int PS4_SYSV_ABI sceHttpDbgEnableProfile() {
@@ -158,18 +453,34 @@ int PS4_SYSV_ABI sceHttpDbgShowStat() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpDeleteConnection() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpDeleteConnection(int connId) {
+    LOG_INFO(Lib_Http, "connId = {}", connId);
+    std::scoped_lock lk{http_mutex};
+    if (!connections.is_allocated({static_cast<u32>(connId)})) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    connections.erase({static_cast<u32>(connId)});
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpDeleteRequest() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpDeleteRequest(int reqId) {
+    LOG_INFO(Lib_Http, "reqId = {}", reqId);
+    std::scoped_lock lk{http_mutex};
+    if (!requests.is_allocated({static_cast<u32>(reqId)})) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    FinishBody(requests[{static_cast<u32>(reqId)}]);
+    requests.erase({static_cast<u32>(reqId)});
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpDeleteTemplate() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpDeleteTemplate(int tmplId) {
+    LOG_INFO(Lib_Http, "tmplId = {}", tmplId);
+    std::scoped_lock lk{http_mutex};
+    if (!templates.is_allocated({static_cast<u32>(tmplId)})) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    templates.erase({static_cast<u32>(tmplId)});
     return ORBIS_OK;
 }
 
@@ -248,19 +559,44 @@ int PS4_SYSV_ABI sceHttpGetRegisteredCtxIds() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpGetResponseContentLength() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpGetResponseContentLength(int reqId, int* result, u64* contentLength) {
+    std::scoped_lock lk{http_mutex};
+    if (!requests.is_allocated({static_cast<u32>(reqId)})) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    const Request& request = requests[{static_cast<u32>(reqId)}];
+    if (!request.sent) {
+        return ORBIS_HTTP_ERROR_BEFORE_SEND;
+    }
+    if (!result || !contentLength) {
+        return ORBIS_HTTP_ERROR_INVALID_VALUE;
+    }
+    *result = request.content_length_kind;
+    *contentLength = request.content_length_kind == 1 ? request.content_length : 0;
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpGetStatusCode() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpGetStatusCode(int reqId, int* statusCode) {
+    std::scoped_lock lk{http_mutex};
+    if (!requests.is_allocated({static_cast<u32>(reqId)})) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    const Request& request = requests[{static_cast<u32>(reqId)}];
+    if (!request.sent) {
+        return ORBIS_HTTP_ERROR_BEFORE_SEND;
+    }
+    if (!statusCode) {
+        return ORBIS_HTTP_ERROR_INVALID_VALUE;
+    }
+    *statusCode = request.status_code;
     return ORBIS_OK;
 }
 
 int PS4_SYSV_ABI sceHttpInit(int libnetMemId, int libsslCtxId, std::size_t poolSize) {
-    LOG_ERROR(Lib_Http, "(DUMMY) called libnetMemId = {} libsslCtxId = {} poolSize = {}",
-              libnetMemId, libsslCtxId, poolSize);
+    LOG_INFO(Lib_Http, "libnetMemId = {} libsslCtxId = {} poolSize = {}", libnetMemId, libsslCtxId,
+             poolSize);
+    std::scoped_lock lk{http_mutex};
+    http_initialized = true;
     // return a value >1
     static int id = 0;
     return ++id;
@@ -276,9 +612,53 @@ int PS4_SYSV_ABI sceHttpParseStatusLine() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpReadData() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
-    return ORBIS_OK;
+int PS4_SYSV_ABI sceHttpReadData(int reqId, void* data, u64 size) {
+    std::scoped_lock lk{http_mutex};
+    if (!requests.is_allocated({static_cast<u32>(reqId)})) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    Request& request = requests[{static_cast<u32>(reqId)}];
+    if (!request.sent) {
+        return ORBIS_HTTP_ERROR_BEFORE_SEND;
+    }
+    if (!data || request.fd == Net::InvalidSocket) {
+        return 0;
+    }
+
+    u8* out = static_cast<u8*>(data);
+    u64 total = 0;
+    while (total < size) {
+        u64 want = size - total;
+        if (request.content_length_kind == 1) {
+            if (request.body_remaining == 0) {
+                break;
+            }
+            want = std::min(want, request.body_remaining);
+        } else if (request.content_length_kind == 2) {
+            if (request.chunk_remaining == 0) {
+                if (request.last_chunk || !ReadChunkHeader(request) || request.last_chunk) {
+                    break;
+                }
+            }
+            want = std::min(want, request.chunk_remaining);
+        }
+        const s64 received = ReadRaw(request, out + total, want);
+        if (received <= 0) {
+            // Response delimited by connection close.
+            request.close_after = true;
+            break;
+        }
+        total += received;
+        if (request.content_length_kind == 1) {
+            request.body_remaining -= received;
+        } else if (request.content_length_kind == 2) {
+            request.chunk_remaining -= received;
+        }
+    }
+    if (total == 0) {
+        FinishBody(request);
+    }
+    return static_cast<int>(total);
 }
 
 int PS4_SYSV_ABI sceHttpRedirectCacheFlush() {
@@ -316,8 +696,42 @@ int PS4_SYSV_ABI sceHttpsEnableOptionPrivate() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpSendRequest() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpSendRequest(int reqId, const void* postData, u64 size) {
+    LOG_INFO(Lib_Http, "reqId = {} size = {}", reqId, size);
+    std::scoped_lock lk{http_mutex};
+    if (!requests.is_allocated({static_cast<u32>(reqId)})) {
+        return ORBIS_HTTP_ERROR_INVALID_ID;
+    }
+    Request& request = requests[{static_cast<u32>(reqId)}];
+    if (request.sent) {
+        return ORBIS_HTTP_ERROR_AFTER_SEND;
+    }
+
+    bool reused = false;
+    auto& pool = Net::ConnectionPool::Instance();
+    Net::NetSocket fd = pool.Acquire(request.host, request.port, &reused);
+    if (fd == Net::InvalidSocket) {
+        return ORBIS_HTTP_ERROR_NETWORK;
+    }
+    if (!PerformOnSocket(request, fd, postData, size)) {
+        Net::CloseSocket(fd);
+        request.fd = Net::InvalidSocket;
+        // A parked keep-alive connection can go stale between the reactor's
+        // liveness check and our send; retry exactly once on a fresh one.
+        if (reused) {
+            fd = pool.Acquire(request.host, request.port, &reused);
+            if (fd != Net::InvalidSocket && PerformOnSocket(request, fd, postData, size)) {
+                request.sent = true;
+                return ORBIS_OK;
+            }
+            if (fd != Net::InvalidSocket) {
+                Net::CloseSocket(fd);
+                request.fd = Net::InvalidSocket;
+            }
+        }
+        return request.status_code == 0 ? ORBIS_HTTP_ERROR_NETWORK : ORBIS_HTTP_ERROR_BAD_RESPONSE;
+    }
+    request.sent = true;
     return ORBIS_OK;
 }
 
@@ -526,8 +940,13 @@ int PS4_SYSV_ABI sceHttpsUnloadCert() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceHttpTerm() {
-    LOG_ERROR(Lib_Http, "(STUBBED) called");
+int PS4_SYSV_ABI sceHttpTerm(int libhttpCtxId) {
+    LOG_INFO(Lib_Http, "libhttpCtxId = {}", libhttpCtxId);
+    std::scoped_lock lk{http_mutex};
+    if (!http_initialized) {
+        return ORBIS_HTTP_ERROR_BEFORE_INIT;
+    }
+    http_initialized = false;
     return ORBIS_OK;
 }
 
@@ -8,7 +8,23 @@
 #include <winsock2.h>
 #else
 #include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
 #endif
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include <common/assert.h>
 #include "common/logging/log.h"
@@ -18,6 +34,80 @@
 
 namespace Libraries::Net {
 
+namespace {
+
+/// One sceNetEpoll instance. On Linux it wraps a host epoll object, so a
+/// blocked sceNetEpollWait sits directly in epoll_wait and events are copied
+/// once into the guest array; elsewhere the member list is polled per wait.
+struct EpollInstance {
+    std::string name;
+    struct Member {
+        OrbisNetId id;
+        u32 events;
+        OrbisNetEpollData data;
+    };
+    std::mutex mutex;
+    std::vector<Member> members;
+    std::atomic_bool aborted{};
+#ifdef __linux__
+    int epoll_fd = -1;
+    int wake_fd = -1;
+
+    EpollInstance() {
+        epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        epoll_event wake_event{.events = EPOLLIN, .data{.fd = wake_fd}};
+        epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &wake_event);
+    }
+    ~EpollInstance() {
+        close(epoll_fd);
+        close(wake_fd);
+    }
+#endif
+};
+
+std::mutex epolls_mutex;
+std::unordered_map<OrbisNetId, std::shared_ptr<EpollInstance>> epolls;
+OrbisNetId next_epoll_id = 1;
+
+std::shared_ptr<EpollInstance> FindEpoll(OrbisNetId eid) {
+    std::scoped_lock lk{epolls_mutex};
+    const auto it = epolls.find(eid);
+    return it == epolls.end() ? nullptr : it->second;
+}
+
+#ifdef __linux__
+u32 HostToEpollEvents(u32 host) {
+    u32 events = 0;
+    if (host & EPOLLIN) {
+        events |= ORBIS_NET_EPOLLIN;
+    }
+    if (host & EPOLLOUT) {
+        events |= ORBIS_NET_EPOLLOUT;
+    }
+    if (host & EPOLLERR) {
+        events |= ORBIS_NET_EPOLLERR;
+    }
+    if (host & EPOLLHUP) {
+        events |= ORBIS_NET_EPOLLHUP;
+    }
+    return events;
+}
+
+u32 EpollToHostEvents(u32 events) {
+    u32 host = 0;
+    if (events & ORBIS_NET_EPOLLIN) {
+        host |= EPOLLIN;
+    }
+    if (events & ORBIS_NET_EPOLLOUT) {
+        host |= EPOLLOUT;
+    }
+    return host;
+}
+#endif
+
+} // namespace
+
 int PS4_SYSV_ABI in6addr_any() {
     LOG_ERROR(Lib_Net, "(STUBBED) called");
     return ORBIS_OK;
@@ -538,29 +628,217 @@ int PS4_SYSV_ABI sceNetDuplicateIpStop() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceNetEpollAbort() {
-    LOG_ERROR(Lib_Net, "(STUBBED) called");
+int PS4_SYSV_ABI sceNetEpollAbort(OrbisNetId eid, int flags) {
+    LOG_INFO(Lib_Net, "eid = {} flags = {}", eid, flags);
+    const auto instance = FindEpoll(eid);
+    if (!instance) {
+        return ORBIS_NET_ERROR_EBADF;
+    }
+    instance->aborted = true;
+#ifdef __linux__
+    const u64 one = 1;
+    [[maybe_unused]] const auto written = write(instance->wake_fd, &one, sizeof(one));
+#endif
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceNetEpollControl() {
-    LOG_ERROR(Lib_Net, "(STUBBED) called");
-    return ORBIS_OK;
+int PS4_SYSV_ABI sceNetEpollControl(OrbisNetId eid, int op, OrbisNetId id,
+                                    const OrbisNetEpollEvent* event) {
+    LOG_DEBUG(Lib_Net, "eid = {} op = {} id = {}", eid, op, id);
+    const auto instance = FindEpoll(eid);
+    if (!instance) {
+        return ORBIS_NET_ERROR_EBADF;
+    }
+    if (op != ORBIS_NET_EPOLL_CTL_DEL && !event) {
+        return ORBIS_NET_ERROR_EINVAL;
+    }
+
+    std::scoped_lock lk{instance->mutex};
+    const auto it = std::ranges::find(instance->members, id, &EpollInstance::Member::id);
+    switch (op) {
+    case ORBIS_NET_EPOLL_CTL_ADD: {
+        if (it != instance->members.end()) {
+            return ORBIS_NET_ERROR_EEXIST;
+        }
+        instance->members.push_back({id, event->events, event->data});
+#ifdef __linux__
+        epoll_event host_event{.events = EpollToHostEvents(event->events), .data{.fd = id}};
+        epoll_ctl(instance->epoll_fd, EPOLL_CTL_ADD, id, &host_event);
+#endif
+        return ORBIS_OK;
+    }
+    case ORBIS_NET_EPOLL_CTL_MOD: {
+        if (it == instance->members.end()) {
+            return ORBIS_NET_ERROR_ENOENT;
+        }
+        it->events = event->events;
+        it->data = event->data;
+#ifdef __linux__
+        epoll_event host_event{.events = EpollToHostEvents(event->events), .data{.fd = id}};
+        epoll_ctl(instance->epoll_fd, EPOLL_CTL_MOD, id, &host_event);
+#endif
+        return ORBIS_OK;
+    }
+    case ORBIS_NET_EPOLL_CTL_DEL: {
+        if (it == instance->members.end()) {
+            return ORBIS_NET_ERROR_ENOENT;
+        }
+        instance->members.erase(it);
+#ifdef __linux__
+        epoll_ctl(instance->epoll_fd, EPOLL_CTL_DEL, id, nullptr);
+#endif
+        return ORBIS_OK;
+    }
+    default:
+        return ORBIS_NET_ERROR_EINVAL;
+    }
 }
 
-int PS4_SYSV_ABI sceNetEpollCreate() {
-    LOG_ERROR(Lib_Net, "(STUBBED) called");
-    return ORBIS_OK;
+int PS4_SYSV_ABI sceNetEpollCreate(const char* name, int flags) {
+    LOG_INFO(Lib_Net, "name = {} flags = {}", name ? name : "(null)", flags);
+    auto instance = std::make_shared<EpollInstance>();
+    instance->name = name ? name : "";
+    std::scoped_lock lk{epolls_mutex};
+    const OrbisNetId eid = next_epoll_id++;
+    epolls.emplace(eid, std::move(instance));
+    return eid;
 }
 
-int PS4_SYSV_ABI sceNetEpollDestroy() {
-    LOG_ERROR(Lib_Net, "(STUBBED) called");
+int PS4_SYSV_ABI sceNetEpollDestroy(OrbisNetId eid) {
+    LOG_INFO(Lib_Net, "eid = {}", eid);
+    std::scoped_lock lk{epolls_mutex};
+    if (epolls.erase(eid) == 0) {
+        return ORBIS_NET_ERROR_EBADF;
+    }
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceNetEpollWait() {
-    LOG_ERROR(Lib_Net, "(STUBBED) called");
-    return ORBIS_OK;
+int PS4_SYSV_ABI sceNetEpollWait(OrbisNetId eid, OrbisNetEpollEvent* events, int maxevents,
+                                 int timeout_usec) {
+    const auto instance = FindEpoll(eid);
+    if (!instance) {
+        return ORBIS_NET_ERROR_EBADF;
+    }
+    if (!events || maxevents <= 0) {
+        return ORBIS_NET_ERROR_EINVAL;
+    }
+    instance->aborted = false;
+
+#ifdef __linux__
+    // Wait directly on the host epoll object: the guest thread is the natural
+    // waiter, and readiness lands in the guest array with a single translation
+    // pass and no allocation.
+    std::array<epoll_event, 64> host_events;
+    const int capacity = std::min<int>(maxevents, static_cast<int>(host_events.size()));
+    const int timeout_ms = timeout_usec < 0 ? -1 : (timeout_usec + 999) / 1000;
+    int num = 0;
+    do {
+        num = epoll_wait(instance->epoll_fd, host_events.data(), capacity, timeout_ms);
+    } while (num < 0 && errno == EINTR && !instance->aborted);
+    if (instance->aborted) {
+        return ORBIS_NET_ERROR_EINTR;
+    }
+    if (num < 0) {
+        return ORBIS_NET_ERROR_EINVAL;
+    }
+
+    int num_out = 0;
+    std::scoped_lock lk{instance->mutex};
+    for (int i = 0; i < num; i++) {
+        if (host_events[i].data.fd == instance->wake_fd) {
+            u64 value;
+            [[maybe_unused]] const auto nread = read(instance->wake_fd, &value, sizeof(value));
+            if (instance->aborted) {
+                return ORBIS_NET_ERROR_EINTR;
+            }
+            continue;
+        }
+        const auto it = std::ranges::find(instance->members, host_events[i].data.fd,
+                                          &EpollInstance::Member::id);
+        if (it == instance->members.end()) {
+            continue;
+        }
+        events[num_out].events = HostToEpollEvents(host_events[i].events);
+        events[num_out].reserved = 0;
+        events[num_out].ident = 0;
+        events[num_out].data = it->data;
+        num_out++;
+    }
+    return num_out;
+#else
+    // Portable fallback: poll the member list in short slices so an abort can
+    // interrupt the wait.
+    const auto deadline = std::chrono::steady_clock::now() +
+                          std::chrono::microseconds(timeout_usec < 0 ? 0 : timeout_usec);
+    while (true) {
+        std::vector<pollfd> fds;
+        std::vector<const EpollInstance::Member*> members;
+        {
+            std::scoped_lock lk{instance->mutex};
+            fds.reserve(instance->members.size());
+            members.reserve(instance->members.size());
+            for (const auto& member : instance->members) {
+                short poll_events = 0;
+                if (member.events & ORBIS_NET_EPOLLIN) {
+                    poll_events |= POLLIN;
+                }
+                if (member.events & ORBIS_NET_EPOLLOUT) {
+                    poll_events |= POLLOUT;
+                }
+                fds.push_back({static_cast<decltype(pollfd::fd)>(member.id), poll_events, 0});
+                members.push_back(&member);
+            }
+        }
+        constexpr int SliceMs = 50;
+        int slice = SliceMs;
+        if (timeout_usec >= 0) {
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now());
+            slice = std::clamp<int>(static_cast<int>(remaining.count()), 0, SliceMs);
+        }
+#ifdef WIN32
+        const int num = WSAPoll(fds.data(), static_cast<u32>(fds.size()), slice);
+#else
+        const int num = poll(fds.data(), fds.size(), slice);
+#endif
+        if (instance->aborted) {
+            return ORBIS_NET_ERROR_EINTR;
+        }
+        if (num > 0) {
+            int num_out = 0;
+            std::scoped_lock lk{instance->mutex};
+            for (size_t i = 0; i < fds.size() && num_out < maxevents; i++) {
+                if (fds[i].revents == 0) {
+                    continue;
+                }
+                u32 ready = 0;
+                if (fds[i].revents & POLLIN) {
+                    ready |= ORBIS_NET_EPOLLIN;
+                }
+                if (fds[i].revents & POLLOUT) {
+                    ready |= ORBIS_NET_EPOLLOUT;
+                }
+                if (fds[i].revents & POLLERR) {
+                    ready |= ORBIS_NET_EPOLLERR;
+                }
+                if (fds[i].revents & POLLHUP) {
+                    ready |= ORBIS_NET_EPOLLHUP;
+                }
+                events[num_out].events = ready;
+                events[num_out].reserved = 0;
+                events[num_out].ident = 0;
+                events[num_out].data = members[i]->data;
+                num_out++;
+            }
+            if (num_out != 0) {
+                return num_out;
+            }
+        }
+        if (timeout_usec >= 0 && std::chrono::steady_clock::now() >= deadline) {
+            return 0;
+        }
+    }
+#endif
 }
 
 int PS4_SYSV_ABI sceNetErrnoLoc() {
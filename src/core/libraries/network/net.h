@@ -23,6 +23,29 @@ struct OrbisNetSockaddr {
     char sa_data[14];
 };
 
+union OrbisNetEpollData {
+    void* ptr;
+    u32 data_u32;
+    u64 data_u64;
+    OrbisNetId fd;
+};
+
+struct OrbisNetEpollEvent {
+    u32 events;
+    u32 reserved;
+    u64 ident; // System use.
+    OrbisNetEpollData data;
+};
+
+constexpr u32 ORBIS_NET_EPOLLIN = 0x1;
+constexpr u32 ORBIS_NET_EPOLLOUT = 0x2;
+constexpr u32 ORBIS_NET_EPOLLERR = 0x8;
+constexpr u32 ORBIS_NET_EPOLLHUP = 0x10;
+
+constexpr int ORBIS_NET_EPOLL_CTL_ADD = 1;
+constexpr int ORBIS_NET_EPOLL_CTL_MOD = 2;
+constexpr int ORBIS_NET_EPOLL_CTL_DEL = 3;
+
 int PS4_SYSV_ABI in6addr_any();
 int PS4_SYSV_ABI in6addr_loopback();
 int PS4_SYSV_ABI sce_net_dummy();
@@ -127,11 +150,13 @@ int PS4_SYSV_ABI sceNetDumpDestroy();
 int PS4_SYSV_ABI sceNetDumpRead();
 int PS4_SYSV_ABI sceNetDuplicateIpStart();
 int PS4_SYSV_ABI sceNetDuplicateIpStop();
-int PS4_SYSV_ABI sceNetEpollAbort();
-int PS4_SYSV_ABI sceNetEpollControl();
-int PS4_SYSV_ABI sceNetEpollCreate();
-int PS4_SYSV_ABI sceNetEpollDestroy();
-int PS4_SYSV_ABI sceNetEpollWait();
+int PS4_SYSV_ABI sceNetEpollAbort(OrbisNetId eid, int flags);
+int PS4_SYSV_ABI sceNetEpollControl(OrbisNetId eid, int op, OrbisNetId id,
+                                    const OrbisNetEpollEvent* event);
+int PS4_SYSV_ABI sceNetEpollCreate(const char* name, int flags);
+int PS4_SYSV_ABI sceNetEpollDestroy(OrbisNetId eid);
+int PS4_SYSV_ABI sceNetEpollWait(OrbisNetId eid, OrbisNetEpollEvent* events, int maxevents,
+                                 int timeout_usec);
 int PS4_SYSV_ABI sceNetErrnoLoc();
 int PS4_SYSV_ABI sceNetEtherNtostr();
 int PS4_SYSV_ABI sceNetEtherStrton();
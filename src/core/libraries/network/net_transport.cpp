@@ -0,0 +1,355 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#ifdef WIN32
+#define _WINSOCK_DEPRECATED_NO_WARNINGS
+#include <Ws2tcpip.h>
+#include <winsock2.h>
+#else
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
+#include <cstring>
+#include "common/logging/log.h"
+#include "common/thread.h"
+#include "core/libraries/network/net_transport.h"
+
+namespace Libraries::Net {
+
+static void InitSocketLayer() {
+#ifdef WIN32
+    static std::once_flag flag;
+    std::call_once(flag, [] {
+        WSADATA data;
+        WSAStartup(MAKEWORD(2, 2), &data);
+    });
+#endif
+}
+
+void CloseSocket(NetSocket fd) {
+#ifdef WIN32
+    closesocket(fd);
+#else
+    close(fd);
+#endif
+}
+
+static void SetNonBlocking(NetSocket fd, bool non_blocking) {
+#ifdef WIN32
+    u_long mode = non_blocking ? 1 : 0;
+    ioctlsocket(fd, FIONBIO, &mode);
+#else
+    const int flags = fcntl(fd, F_GETFL, 0);
+    fcntl(fd, F_SETFL, non_blocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK));
+#endif
+}
+
+Reactor& Reactor::Instance() {
+    static Reactor reactor;
+    return reactor;
+}
+
+Reactor::Reactor() {
+    InitSocketLayer();
+#ifdef __linux__
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event wake_event{.events = EPOLLIN, .data{.fd = wake_fd}};
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_fd, &wake_event);
+#else
+    // Self-connected UDP pair used to interrupt the poll loop.
+    wake_recv = socket(AF_INET, SOCK_DGRAM, 0);
+    wake_send = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    bind(wake_recv, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    int addr_len = sizeof(addr);
+    getsockname(wake_recv, reinterpret_cast<sockaddr*>(&addr),
+                reinterpret_cast<socklen_t*>(&addr_len));
+    connect(wake_send, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    SetNonBlocking(wake_recv, true);
+#endif
+    thread = std::jthread([this](std::stop_token stoken) { Loop(stoken); });
+}
+
+Reactor::~Reactor() {
+    thread.request_stop();
+    Wake();
+    thread.join();
+#ifdef __linux__
+    close(epoll_fd);
+    close(wake_fd);
+#else
+    CloseSocket(wake_recv);
+    CloseSocket(wake_send);
+#endif
+}
+
+void Reactor::Wake() {
+#ifdef __linux__
+    const u64 one = 1;
+    [[maybe_unused]] const auto written = write(wake_fd, &one, sizeof(one));
+#else
+    const char byte = 0;
+    send(wake_send, &byte, 1, 0);
+#endif
+}
+
+void Reactor::Register(NetSocket fd, u32 events, Callback callback) {
+    {
+        std::scoped_lock lk{mutex};
+        watches[fd] = {events, std::move(callback)};
+    }
+#ifdef __linux__
+    epoll_event event{.events = 0, .data{.fd = fd}};
+    if (events & Readable) {
+        event.events |= EPOLLIN | EPOLLRDHUP;
+    }
+    if (events & Writable) {
+        event.events |= EPOLLOUT;
+    }
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event);
+#else
+    Wake();
+#endif
+}
+
+void Reactor::Unregister(NetSocket fd) {
+    {
+        std::scoped_lock lk{mutex};
+        watches.erase(fd);
+    }
+#ifdef __linux__
+    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+#else
+    Wake();
+#endif
+}
+
+void Reactor::Loop(std::stop_token stoken) {
+    Common::SetCurrentThreadName("shadPS4:NetReactor");
+    Common::SetCurrentThreadRole(Common::ThreadRole::Io);
+
+    while (!stoken.stop_requested()) {
+#ifdef __linux__
+        std::array<epoll_event, 16> events;
+        const int num = epoll_wait(epoll_fd, events.data(), static_cast<int>(events.size()), -1);
+        for (int i = 0; i < num; i++) {
+            const int fd = events[i].data.fd;
+            if (fd == wake_fd) {
+                u64 value;
+                [[maybe_unused]] const auto nread = read(wake_fd, &value, sizeof(value));
+                continue;
+            }
+            u32 ready = 0;
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP)) {
+                ready |= Readable;
+            }
+            if (events[i].events & EPOLLOUT) {
+                ready |= Writable;
+            }
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                ready |= Error;
+            }
+            Callback callback;
+            {
+                std::scoped_lock lk{mutex};
+                const auto it = watches.find(fd);
+                if (it == watches.end()) {
+                    continue;
+                }
+                callback = it->second.second;
+            }
+            callback(fd, ready);
+        }
+#else
+        std::vector<pollfd> fds;
+        std::vector<NetSocket> sockets;
+        {
+            std::scoped_lock lk{mutex};
+            fds.reserve(watches.size() + 1);
+            sockets.reserve(watches.size());
+            for (const auto& [fd, watch] : watches) {
+                short poll_events = 0;
+                if (watch.first & Readable) {
+                    poll_events |= POLLIN;
+                }
+                if (watch.first & Writable) {
+                    poll_events |= POLLOUT;
+                }
+                fds.push_back({fd, poll_events, 0});
+                sockets.push_back(fd);
+            }
+        }
+        fds.push_back({wake_recv, POLLIN, 0});
+#ifdef WIN32
+        const int num = WSAPoll(fds.data(), static_cast<u32>(fds.size()), -1);
+#else
+        const int num = poll(fds.data(), fds.size(), -1);
+#endif
+        if (num <= 0) {
+            continue;
+        }
+        if (fds.back().revents & POLLIN) {
+            char drain[8];
+            recv(wake_recv, drain, sizeof(drain), 0);
+        }
+        for (size_t i = 0; i < sockets.size(); i++) {
+            if (fds[i].revents == 0) {
+                continue;
+            }
+            u32 ready = 0;
+            if (fds[i].revents & POLLIN) {
+                ready |= Readable;
+            }
+            if (fds[i].revents & POLLOUT) {
+                ready |= Writable;
+            }
+            if (fds[i].revents & (POLLERR | POLLHUP)) {
+                ready |= Error;
+            }
+            Callback callback;
+            {
+                std::scoped_lock lk{mutex};
+                const auto it = watches.find(sockets[i]);
+                if (it == watches.end()) {
+                    continue;
+                }
+                callback = it->second.second;
+            }
+            callback(sockets[i], ready);
+        }
+#endif
+    }
+}
+
+std::vector<ResolvedAddress> ResolverCache::Resolve(const std::string& host) {
+    InitSocketLayer();
+    const auto now = std::chrono::steady_clock::now();
+    {
+        std::scoped_lock lk{mutex};
+        const auto it = cache.find(host);
+        if (it != cache.end() && it->second.expires > now) {
+            return it->second.addresses;
+        }
+    }
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* result = nullptr;
+    std::vector<ResolvedAddress> addresses;
+    if (getaddrinfo(host.c_str(), nullptr, &hints, &result) == 0) {
+        for (const addrinfo* it = result; it != nullptr; it = it->ai_next) {
+            ResolvedAddress resolved{};
+            std::memcpy(&resolved.addr, it->ai_addr, it->ai_addrlen);
+            resolved.addr_len = static_cast<u32>(it->ai_addrlen);
+            addresses.push_back(resolved);
+        }
+        freeaddrinfo(result);
+    }
+
+    std::scoped_lock lk{mutex};
+    cache[host] = Entry{addresses, now + (addresses.empty() ? NegativeTtl : PositiveTtl)};
+    return addresses;
+}
+
+ConnectionPool& ConnectionPool::Instance() {
+    static ConnectionPool pool;
+    return pool;
+}
+
+NetSocket ConnectionPool::TakeIdle(const std::string& key) {
+    std::scoped_lock lk{mutex};
+    const auto it = idle.find(key);
+    if (it == idle.end() || it->second.empty()) {
+        return InvalidSocket;
+    }
+    const NetSocket fd = it->second.back().fd;
+    it->second.pop_back();
+    return fd;
+}
+
+void ConnectionPool::DropExpired() {
+    const auto now = std::chrono::steady_clock::now();
+    std::scoped_lock lk{mutex};
+    for (auto& [key, connections] : idle) {
+        std::erase_if(connections, [&](const IdleConnection& connection) {
+            if (connection.expires > now) {
+                return false;
+            }
+            Reactor::Instance().Unregister(connection.fd);
+            CloseSocket(connection.fd);
+            return true;
+        });
+    }
+}
+
+NetSocket ConnectionPool::Acquire(const std::string& host, u16 port, bool* reused) {
+    InitSocketLayer();
+    DropExpired();
+    const std::string key = fmt::format("{}:{}", host, port);
+    if (const NetSocket fd = TakeIdle(key); fd != InvalidSocket) {
+        Reactor::Instance().Unregister(fd);
+        *reused = true;
+        return fd;
+    }
+    *reused = false;
+
+    for (const ResolvedAddress& resolved : resolver.Resolve(host)) {
+        sockaddr_storage addr = resolved.addr;
+        if (addr.ss_family == AF_INET) {
+            reinterpret_cast<sockaddr_in*>(&addr)->sin_port = htons(port);
+        } else if (addr.ss_family == AF_INET6) {
+            reinterpret_cast<sockaddr_in6*>(&addr)->sin6_port = htons(port);
+        } else {
+            continue;
+        }
+        const NetSocket fd = socket(addr.ss_family, SOCK_STREAM, IPPROTO_TCP);
+        if (fd == InvalidSocket) {
+            continue;
+        }
+        const int no_delay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, reinterpret_cast<const char*>(&no_delay),
+                   sizeof(no_delay));
+        if (connect(fd, reinterpret_cast<const sockaddr*>(&addr), resolved.addr_len) == 0) {
+            return fd;
+        }
+        CloseSocket(fd);
+    }
+    LOG_ERROR(Lib_Net, "Unable to connect to {}", key);
+    return InvalidSocket;
+}
+
+void ConnectionPool::Release(const std::string& host, u16 port, NetSocket fd) {
+    const std::string key = fmt::format("{}:{}", host, port);
+    {
+        std::scoped_lock lk{mutex};
+        idle[key].push_back({fd, std::chrono::steady_clock::now() + IdleTimeout});
+    }
+    // A parked connection that becomes readable has either been closed by the
+    // peer or carries stray bytes; both make it unusable, so drop it.
+    Reactor::Instance().Register(fd, Reactor::Readable | Reactor::Error,
+                                 [this, key](NetSocket ready_fd, u32) {
+                                     std::scoped_lock lk{mutex};
+                                     auto& connections = idle[key];
+                                     std::erase_if(connections,
+                                                   [ready_fd](const IdleConnection& connection) {
+                                                       return connection.fd == ready_fd;
+                                                   });
+                                     Reactor::Instance().Unregister(ready_fd);
+                                     CloseSocket(ready_fd);
+                                 });
+}
+
+} // namespace Libraries::Net
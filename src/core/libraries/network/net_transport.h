@@ -0,0 +1,128 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "common/types.h"
+
+#ifdef WIN32
+#include <winsock2.h>
+#else
+#include <sys/socket.h>
+#endif
+
+namespace Libraries::Net {
+
+#ifdef WIN32
+using NetSocket = uintptr_t;
+#else
+using NetSocket = int;
+#endif
+constexpr NetSocket InvalidSocket = static_cast<NetSocket>(-1);
+
+void CloseSocket(NetSocket fd);
+
+/**
+ * Socket readiness reactor shared by the network HLE modules. One thread
+ * multiplexes every registered socket (epoll on Linux, poll elsewhere) and
+ * invokes the registered callback on readiness, so idle keep-alive connections
+ * and future non-blocking transfers do not need a thread each.
+ */
+class Reactor {
+public:
+    enum Event : u32 {
+        Readable = 1 << 0,
+        Writable = 1 << 1,
+        Error = 1 << 2,
+    };
+    using Callback = std::function<void(NetSocket fd, u32 events)>;
+
+    static Reactor& Instance();
+
+    void Register(NetSocket fd, u32 events, Callback callback);
+    void Unregister(NetSocket fd);
+
+private:
+    Reactor();
+    ~Reactor();
+
+    void Loop(std::stop_token stoken);
+    void Wake();
+
+    std::mutex mutex;
+    std::unordered_map<NetSocket, std::pair<u32, Callback>> watches;
+#ifdef __linux__
+    int epoll_fd = -1;
+    int wake_fd = -1;
+#else
+    NetSocket wake_recv = InvalidSocket;
+    NetSocket wake_send = InvalidSocket;
+#endif
+    std::jthread thread;
+};
+
+struct ResolvedAddress {
+    sockaddr_storage addr;
+    u32 addr_len;
+};
+
+/// Caches getaddrinfo results so repeated requests against the same host (the
+/// common telemetry pattern) do not pay a blocking DNS lookup each time.
+class ResolverCache {
+public:
+    /// Returns the resolved addresses for host, or an empty vector on failure.
+    std::vector<ResolvedAddress> Resolve(const std::string& host);
+
+private:
+    static constexpr std::chrono::seconds PositiveTtl{60};
+    static constexpr std::chrono::seconds NegativeTtl{5};
+
+    struct Entry {
+        std::vector<ResolvedAddress> addresses;
+        std::chrono::steady_clock::time_point expires;
+    };
+    std::mutex mutex;
+    std::unordered_map<std::string, Entry> cache;
+};
+
+/**
+ * Keep-alive connection pool keyed by host:port. Idle sockets are parked on
+ * the reactor, which closes them as soon as the peer drops the connection, so
+ * a reused socket is never known-stale.
+ */
+class ConnectionPool {
+public:
+    static ConnectionPool& Instance();
+
+    /// Returns a connected socket, reusing an idle keep-alive connection when
+    /// one exists. *reused tells the caller whether a retry with a fresh
+    /// connection is worthwhile on failure.
+    NetSocket Acquire(const std::string& host, u16 port, bool* reused);
+
+    /// Parks a healthy keep-alive connection for later reuse.
+    void Release(const std::string& host, u16 port, NetSocket fd);
+
+private:
+    static constexpr std::chrono::seconds IdleTimeout{30};
+
+    struct IdleConnection {
+        NetSocket fd;
+        std::chrono::steady_clock::time_point expires;
+    };
+
+    NetSocket TakeIdle(const std::string& key);
+    void DropExpired();
+
+    ResolverCache resolver;
+    std::mutex mutex;
+    std::unordered_map<std::string, std::vector<IdleConnection>> idle;
+};
+
+} // namespace Libraries::Net
@@ -5,6 +5,7 @@
 #include "core/libraries/error_codes.h"
 #include "core/libraries/libs.h"
 #include "core/libraries/network/ssl.h"
+#include "core/libraries/network/ssl_engine.h"
 
 namespace Libraries::Ssl {
 
@@ -746,7 +747,8 @@ int PS4_SYSV_ABI sceSslShowMemoryStat() {
 }
 
 int PS4_SYSV_ABI sceSslTerm() {
-    LOG_ERROR(Lib_Ssl, "(STUBBED) called");
+    LOG_INFO(Lib_Ssl, "called");
+    SslEngine::Instance().Flush();
     return ORBIS_OK;
 }
 
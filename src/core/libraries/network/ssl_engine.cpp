@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <condition_variable>
+#include <xxhash.h>
+#include "common/singleton.h"
+#include "common/thread_pool.h"
+#include "core/libraries/network/ssl_engine.h"
+
+namespace Libraries::Ssl {
+
+SslEngine& SslEngine::Instance() {
+    static SslEngine engine;
+    return engine;
+}
+
+void SslEngine::PutSessionTicket(const std::string& host_port, std::vector<u8> ticket,
+                                 std::chrono::seconds lifetime) {
+    const auto now = std::chrono::steady_clock::now();
+    std::scoped_lock lk{mutex};
+    if (tickets.size() >= MaxSessionTickets && !tickets.contains(host_port)) {
+        // Evict the entry closest to expiry; tickets are cheap to re-issue.
+        const auto victim = std::ranges::min_element(
+            tickets, {}, [](const auto& entry) { return entry.second.expires; });
+        tickets.erase(victim);
+    }
+    tickets[host_port] = TicketEntry{std::move(ticket), now + lifetime};
+}
+
+std::vector<u8> SslEngine::TakeSessionTicket(const std::string& host_port) {
+    std::scoped_lock lk{mutex};
+    const auto it = tickets.find(host_port);
+    if (it == tickets.end()) {
+        return {};
+    }
+    std::vector<u8> ticket;
+    if (it->second.expires > std::chrono::steady_clock::now()) {
+        ticket = std::move(it->second.ticket);
+    }
+    tickets.erase(it);
+    return ticket;
+}
+
+bool SslEngine::VerifyChainCached(std::span<const u8> der_chain, std::function<bool()> verify) {
+    const u64 key = XXH3_64bits(der_chain.data(), der_chain.size());
+    const auto now = std::chrono::steady_clock::now();
+    {
+        std::scoped_lock lk{mutex};
+        const auto it = verified_chains.find(key);
+        if (it != verified_chains.end() && it->second.expires > now) {
+            return it->second.trusted;
+        }
+    }
+    const bool trusted = verify();
+    std::scoped_lock lk{mutex};
+    verified_chains[key] = VerifyEntry{trusted, now + VerifyTtl};
+    return trusted;
+}
+
+void SslEngine::RunHandshake(std::function<void()> handshake) {
+    auto* pool = Common::Singleton<Common::ThreadPool>::Instance();
+    std::mutex done_mutex;
+    std::condition_variable done_cv;
+    bool done = false;
+    pool->Post([&] {
+        handshake();
+        std::scoped_lock lk{done_mutex};
+        done = true;
+        done_cv.notify_one();
+    });
+    std::unique_lock lk{done_mutex};
+    done_cv.wait(lk, [&] { return done; });
+}
+
+void SslEngine::Flush() {
+    std::scoped_lock lk{mutex};
+    tickets.clear();
+    verified_chains.clear();
+}
+
+} // namespace Libraries::Ssl
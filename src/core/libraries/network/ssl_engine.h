@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "common/types.h"
+
+namespace Libraries::Ssl {
+
+/**
+ * Shared state behind the ssl HLE, built so the CPU-heavy parts of TLS stay
+ * off the guest network threads once a record-layer backend is vendored:
+ *
+ * - Session tickets are cached per host:port so reconnects resume instead of
+ *   running a full handshake.
+ * - Certificate verification results are cached by a hash of the DER chain;
+ *   reconnect storms against the same endpoint verify the chain once.
+ * - Handshakes run on the shared worker pool, so a guest thread only blocks
+ *   on its own handshake completion rather than performing the crypto inline.
+ */
+class SslEngine {
+public:
+    static SslEngine& Instance();
+
+    /// Stores the session ticket issued for an endpoint. Replaces any older
+    /// ticket; tickets are single-use and taken on resumption.
+    void PutSessionTicket(const std::string& host_port, std::vector<u8> ticket,
+                          std::chrono::seconds lifetime);
+
+    /// Takes the cached ticket for an endpoint, or an empty vector when none
+    /// is valid. The ticket is removed, matching single-use semantics.
+    std::vector<u8> TakeSessionTicket(const std::string& host_port);
+
+    /// Returns the cached verification verdict for a certificate chain, or
+    /// runs verify() and caches its result. The key is a hash over the raw
+    /// DER chain, so any re-issued certificate verifies afresh.
+    bool VerifyChainCached(std::span<const u8> der_chain, std::function<bool()> verify);
+
+    /// Schedules work on the shared worker pool and blocks only the calling
+    /// thread until it completes.
+    void RunHandshake(std::function<void()> handshake);
+
+    /// Drops all cached tickets and verification results.
+    void Flush();
+
+private:
+    static constexpr size_t MaxSessionTickets = 64;
+    static constexpr std::chrono::minutes VerifyTtl{10};
+
+    struct TicketEntry {
+        std::vector<u8> ticket;
+        std::chrono::steady_clock::time_point expires;
+    };
+    struct VerifyEntry {
+        bool trusted;
+        std::chrono::steady_clock::time_point expires;
+    };
+
+    std::mutex mutex;
+    std::unordered_map<std::string, TicketEntry> tickets;
+    std::unordered_map<u64, VerifyEntry> verified_chains;
+};
+
+} // namespace Libraries::Ssl
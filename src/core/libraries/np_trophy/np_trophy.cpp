@@ -2,10 +2,21 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 // Generated By moduleGenerator
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 
+#include "common/io_file.h"
 #include "common/logging/log.h"
+#include "common/path_util.h"
+#include "common/singleton.h"
 #include "common/slot_vector.h"
+#include "core/file_format/psf.h"
 #include "core/libraries/error_codes.h"
 #include "core/libraries/libs.h"
 #include "np_trophy.h"
@@ -14,6 +25,76 @@ namespace Libraries::NpTrophy {
 
 static constexpr auto MaxTrophyHandles = 4u;
 static constexpr auto MaxTrophyContexts = 8u;
+static constexpr auto MaxTrophies = 128u;
+
+// Authoritative unlock state for the running title. Unlocks land on the guest
+// thread in the middle of gameplay, so they only flip a bit and nudge the
+// flusher; the flusher coalesces bursts and persists the whole bitset at once.
+static std::array<std::atomic<u64>, MaxTrophies / 64> g_unlocked{};
+static std::atomic<u64> g_dirty_gen{0};
+static std::mutex g_flush_mutex;
+static std::condition_variable_any g_flush_cv;
+static std::jthread g_flush_thread;
+static std::once_flag g_state_loaded;
+
+static std::filesystem::path TrophyStatePath() {
+    auto* param_sfo = Common::Singleton<PSF>::Instance();
+    const auto content_id = param_sfo->GetString("CONTENT_ID");
+    const std::string id = content_id.size() >= 16 ? content_id.substr(7, 9) : "UNKNOWN";
+    return Common::FS::GetUserPath(Common::FS::PathType::GameDataDir) / id / "trophies.bin";
+}
+
+static void FlushTrophyState(const std::filesystem::path& path) {
+    std::array<u64, MaxTrophies / 64> snapshot;
+    for (size_t i = 0; i < snapshot.size(); i++) {
+        snapshot[i] = g_unlocked[i].load(std::memory_order_relaxed);
+    }
+    Common::FS::IOFile file(path, Common::FS::FileAccessMode::Write);
+    if (!file.IsOpen()) {
+        LOG_ERROR(Lib_NpTrophy, "Failed to persist trophy state to {}",
+                  Common::FS::PathToUTF8String(path));
+        return;
+    }
+    file.WriteRaw<u8>(snapshot.data(), sizeof(snapshot));
+}
+
+static void EnsureTrophyStateLoaded() {
+    std::call_once(g_state_loaded, [] {
+        const auto path = TrophyStatePath();
+        std::filesystem::create_directories(path.parent_path());
+        if (Common::FS::IOFile file(path, Common::FS::FileAccessMode::Read); file.IsOpen()) {
+            std::array<u64, MaxTrophies / 64> snapshot{};
+            file.ReadRaw<u8>(snapshot.data(), sizeof(snapshot));
+            for (size_t i = 0; i < snapshot.size(); i++) {
+                g_unlocked[i].store(snapshot[i], std::memory_order_relaxed);
+            }
+        }
+        g_flush_thread = std::jthread([path](std::stop_token token) {
+            u64 flushed_gen = 0;
+            std::unique_lock lock{g_flush_mutex};
+            while (true) {
+                g_flush_cv.wait(lock, token, [&] {
+                    return g_dirty_gen.load(std::memory_order_acquire) != flushed_gen;
+                });
+                if (token.stop_requested()) {
+                    break;
+                }
+                // Give a burst of unlocks a moment to settle so it becomes
+                // one write instead of one per trophy.
+                lock.unlock();
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                const u64 gen = g_dirty_gen.load(std::memory_order_acquire);
+                FlushTrophyState(path);
+                lock.lock();
+                flushed_gen = gen;
+            }
+            // Final write so unlocks racing shutdown are not lost.
+            if (g_dirty_gen.load(std::memory_order_acquire) != flushed_gen) {
+                FlushTrophyState(path);
+            }
+        });
+    });
+}
 
 using ContextKey = std::pair<u32, u32>; // <user_id, service label>
 struct ContextKeyHash {
@@ -169,8 +250,17 @@ int PS4_SYSV_ABI sceNpTrophyGetTrophyInfo() {
 }
 
 s32 PS4_SYSV_ABI sceNpTrophyGetTrophyUnlockState(u32 context, u32 handle, u32* flags, u32* count) {
-    LOG_ERROR(Lib_NpTrophy, "(STUBBED) called");
-    *flags = 0u;
+    LOG_INFO(Lib_NpTrophy, "called context = {} handle = {}", context, handle);
+    if (!flags || !count) {
+        return ORBIS_NP_TROPHY_ERROR_INVALID_ARGUMENT;
+    }
+    EnsureTrophyStateLoaded();
+    // flags points to the guest's 128-bit OrbisNpTrophyFlagArray.
+    for (u32 i = 0; i < MaxTrophies / 32; i++) {
+        const u64 word = g_unlocked[i / 2].load(std::memory_order_relaxed);
+        flags[i] = static_cast<u32>(word >> ((i % 2) * 32));
+    }
+    // The real count comes from the TRP configuration, which is not parsed yet.
     *count = 0;
     return ORBIS_OK;
 }
@@ -241,7 +331,10 @@ int PS4_SYSV_ABI sceNpTrophyNumInfoGetTotal() {
 }
 
 int PS4_SYSV_ABI sceNpTrophyRegisterContext() {
-    LOG_ERROR(Lib_NpTrophy, "(STUBBED) called");
+    LOG_INFO(Lib_NpTrophy, "called");
+    // Titles register once during boot; load the persisted unlock state and
+    // start the flusher here so the first unlock mid-gameplay pays nothing.
+    EnsureTrophyStateLoaded();
     return ORBIS_OK;
 }
 
@@ -475,8 +568,24 @@ int PS4_SYSV_ABI sceNpTrophySystemSetDbgParamInt() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceNpTrophyUnlockTrophy() {
-    LOG_ERROR(Lib_NpTrophy, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceNpTrophyUnlockTrophy(u32 context, u32 handle, s32 trophy_id,
+                                         s32* platinum_id) {
+    LOG_INFO(Lib_NpTrophy, "called context = {} handle = {} trophy_id = {}", context, handle,
+             trophy_id);
+    if (trophy_id < 0 || trophy_id >= static_cast<s32>(MaxTrophies) || !platinum_id) {
+        return ORBIS_NP_TROPHY_ERROR_INVALID_ARGUMENT;
+    }
+    EnsureTrophyStateLoaded();
+    // Platinum chains need the TRP configuration; report none awarded.
+    *platinum_id = -1;
+    const u64 bit = 1ull << (trophy_id % 64);
+    const u64 prev = g_unlocked[trophy_id / 64].fetch_or(bit, std::memory_order_relaxed);
+    if (prev & bit) {
+        return ORBIS_NP_TROPHY_ERROR_ALREADY_UNLOCKED;
+    }
+    // The guest thread only flips the bit; persistence happens on the flusher.
+    g_dirty_gen.fetch_add(1, std::memory_order_release);
+    g_flush_cv.notify_one();
     return ORBIS_OK;
 }
 
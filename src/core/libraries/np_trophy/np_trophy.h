@@ -94,7 +94,7 @@ int PS4_SYSV_ABI sceNpTrophySystemRemoveTitleData();
 int PS4_SYSV_ABI sceNpTrophySystemRemoveUserData();
 int PS4_SYSV_ABI sceNpTrophySystemSetDbgParam();
 int PS4_SYSV_ABI sceNpTrophySystemSetDbgParamInt();
-int PS4_SYSV_ABI sceNpTrophyUnlockTrophy();
+s32 PS4_SYSV_ABI sceNpTrophyUnlockTrophy(u32 context, u32 handle, s32 trophy_id, s32* platinum_id);
 int PS4_SYSV_ABI Func_149656DA81D41C59();
 int PS4_SYSV_ABI Func_9F80071876FFA5F6();
 int PS4_SYSV_ABI Func_F8EF6F5350A91990();
@@ -262,12 +262,12 @@ int PS4_SYSV_ABI scePadRead(s32 handle, OrbisPadData* pData, s32 num) {
         pData[i].orientation.y = 0.0f;
         pData[i].orientation.z = 0.0f;
         pData[i].orientation.w = 1.0f;
-        pData[i].acceleration.x = 0.0f;
-        pData[i].acceleration.y = 0.0f;
-        pData[i].acceleration.z = 0.0f;
-        pData[i].angularVelocity.x = 0.0f;
-        pData[i].angularVelocity.y = 0.0f;
-        pData[i].angularVelocity.z = 0.0f;
+        pData[i].acceleration.x = states[i].accel[0];
+        pData[i].acceleration.y = states[i].accel[1];
+        pData[i].acceleration.z = states[i].accel[2];
+        pData[i].angularVelocity.x = states[i].gyro[0];
+        pData[i].angularVelocity.y = states[i].gyro[1];
+        pData[i].angularVelocity.z = states[i].gyro[2];
         pData[i].touchData.touchNum = 0;
         pData[i].touchData.touch[0].x = 0;
         pData[i].touchData.touch[0].y = 0;
@@ -323,12 +323,12 @@ int PS4_SYSV_ABI scePadReadState(s32 handle, OrbisPadData* pData) {
     pData->orientation.y = 0;
     pData->orientation.z = 0;
     pData->orientation.w = 0;
-    pData->acceleration.x = 0.0f;
-    pData->acceleration.y = 0.0f;
-    pData->acceleration.z = 0.0f;
-    pData->angularVelocity.x = 0.0f;
-    pData->angularVelocity.y = 0.0f;
-    pData->angularVelocity.z = 0.0f;
+    pData->acceleration.x = state.accel[0];
+    pData->acceleration.y = state.accel[1];
+    pData->acceleration.z = state.accel[2];
+    pData->angularVelocity.x = state.gyro[0];
+    pData->angularVelocity.y = state.gyro[1];
+    pData->angularVelocity.z = state.gyro[2];
     pData->touchData.touchNum = 0;
     pData->touchData.touch[0].x = 0;
     pData->touchData.touch[0].y = 0;
@@ -410,7 +410,13 @@ int PS4_SYSV_ABI scePadSetForceIntercepted() {
 }
 
 int PS4_SYSV_ABI scePadSetLightBar(s32 handle, const OrbisPadLightBarParam* pParam) {
-    LOG_ERROR(Lib_Pad, "(STUBBED) called");
+    if (pParam == nullptr) {
+        return ORBIS_PAD_ERROR_INVALID_ARG;
+    }
+    LOG_DEBUG(Lib_Pad, "called handle = {} rgb = {} {} {}", handle, pParam->r, pParam->g,
+              pParam->b);
+    auto* controller = Common::Singleton<Input::GameController>::Instance();
+    controller->SetLightBar(pParam->r, pParam->g, pParam->b);
     return ORBIS_OK;
 }
 
@@ -470,7 +476,13 @@ int PS4_SYSV_ABI scePadSetUserColor() {
 }
 
 int PS4_SYSV_ABI scePadSetVibration(s32 handle, const OrbisPadVibrationParam* pParam) {
-    LOG_ERROR(Lib_Pad, "(STUBBED) called");
+    if (pParam == nullptr) {
+        return ORBIS_PAD_ERROR_INVALID_ARG;
+    }
+    LOG_TRACE(Lib_Pad, "called handle = {} large = {} small = {}", handle, pParam->largeMotor,
+              pParam->smallMotor);
+    auto* controller = Common::Singleton<Input::GameController>::Instance();
+    controller->SetVibration(pParam->largeMotor, pParam->smallMotor);
     return ORBIS_OK;
 }
 
@@ -1,15 +1,72 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <mutex>
+#include <vector>
+#include "common/io_file.h"
 #include "common/logging/log.h"
 #include "common/singleton.h"
+#include "core/file_sys/fs.h"
 #include "core/libraries/error_codes.h"
 #include "core/libraries/libs.h"
 #include "playgo.h"
 
 namespace Libraries::PlayGo {
 // this lib is used to play as the game is being installed.
-// can be skipped by just returning and assigning the correct values.
+// Installs complete before boot in shadPS4, so every chunk that exists on disk
+// reports as locally installed; the chunk metadata itself is read from the
+// title's playgo-chunk.dat so ids, counts and progress totals are real.
+
+namespace {
+
+struct PlaygoHeader {
+    u32 magic; // 'plgo'
+    u16 version_major;
+    u16 version_minor;
+    u16 image_count;
+    u16 chunk_count;
+    u16 mchunk_count;
+    u16 scenario_count;
+};
+constexpr u32 PlaygoMagic = 0x6F676C70;
+
+struct PlaygoState {
+    std::mutex mutex;
+    bool initialized{};
+    bool opened{};
+    u16 chunk_count = 0;
+    u64 total_size = 0;
+    OrbisPlayGoInstallSpeed speed = ORBIS_PLAYGO_INSTALL_SPEED_FULL;
+    OrbisPlayGoLanguageMask language_mask = 1;
+    std::vector<OrbisPlayGoLocus> loci;
+    std::vector<OrbisPlayGoToDo> todo;
+};
+PlaygoState state;
+
+/// Reads the chunk table of the installed title. Returns false when the title
+/// ships without PlayGo metadata, in which case everything acts as one chunk.
+bool LoadChunkMetadata() {
+    auto* mnt = Common::Singleton<Core::FileSys::MntPoints>::Instance();
+    const auto host_path = mnt->GetHostFile("/app0/sce_sys/playgo-chunk.dat");
+    Common::FS::IOFile file(host_path, Common::FS::FileAccessMode::Read);
+    if (!file.IsOpen()) {
+        return false;
+    }
+    PlaygoHeader header{};
+    if (file.ReadRaw<PlaygoHeader>(&header, sizeof(header)) != sizeof(header) ||
+        header.magic != PlaygoMagic || header.chunk_count == 0) {
+        LOG_WARNING(Lib_PlayGo, "Malformed playgo-chunk.dat, assuming a single chunk");
+        return false;
+    }
+    state.chunk_count = header.chunk_count;
+    state.total_size = file.GetSize();
+    LOG_INFO(Lib_PlayGo, "Loaded PlayGo metadata: {} chunks, {} scenarios", header.chunk_count,
+             header.scenario_count);
+    return true;
+}
+
+} // namespace
 
 s32 PS4_SYSV_ABI sceDbgPlayGoRequestNextChunk() {
     LOG_ERROR(Lib_PlayGo, "(STUBBED)called");
@@ -21,60 +78,137 @@ s32 PS4_SYSV_ABI sceDbgPlayGoSnapshot() {
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI scePlayGoClose() {
-    LOG_ERROR(Lib_PlayGo, "(STUBBED)called");
+s32 PS4_SYSV_ABI scePlayGoClose(OrbisPlayGoHandle handle) {
+    LOG_INFO(Lib_PlayGo, "called");
+    if (handle != shadMagic) {
+        return ORBIS_PLAYGO_ERROR_BAD_HANDLE;
+    }
+    std::scoped_lock lk{state.mutex};
+    if (!state.opened) {
+        return ORBIS_PLAYGO_ERROR_NOT_STARTED;
+    }
+    state.opened = false;
+    state.todo.clear();
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI scePlayGoGetChunkId() {
-    LOG_ERROR(Lib_PlayGo, "(STUBBED)called");
+s32 PS4_SYSV_ABI scePlayGoGetChunkId(OrbisPlayGoHandle handle, OrbisPlayGoChunkId* outChunkIdList,
+                                     u32 numberOfEntries, u32* outEntries) {
+    LOG_DEBUG(Lib_PlayGo, "called");
+    if (handle != shadMagic) {
+        return ORBIS_PLAYGO_ERROR_BAD_HANDLE;
+    }
+    if (outEntries == nullptr) {
+        return ORBIS_PLAYGO_ERROR_BAD_POINTER;
+    }
+    std::scoped_lock lk{state.mutex};
+    if (outChunkIdList == nullptr) {
+        *outEntries = state.chunk_count;
+        return ORBIS_OK;
+    }
+    const u32 count = std::min<u32>(numberOfEntries, state.chunk_count);
+    for (u32 i = 0; i < count; i++) {
+        outChunkIdList[i] = static_cast<OrbisPlayGoChunkId>(i);
+    }
+    *outEntries = count;
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI scePlayGoGetEta() {
-    LOG_ERROR(Lib_PlayGo, "(STUBBED)called");
+s32 PS4_SYSV_ABI scePlayGoGetEta(OrbisPlayGoHandle handle, const OrbisPlayGoChunkId* chunkIds,
+                                 u32 numberOfEntries, OrbisPlayGoEta* outEta) {
+    LOG_DEBUG(Lib_PlayGo, "called");
+    if (handle != shadMagic) {
+        return ORBIS_PLAYGO_ERROR_BAD_HANDLE;
+    }
+    if (chunkIds == nullptr || outEta == nullptr) {
+        return ORBIS_PLAYGO_ERROR_BAD_POINTER;
+    }
+    // All chunk data is already on disk.
+    *outEta = 0;
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI scePlayGoGetInstallSpeed() {
-    LOG_ERROR(Lib_PlayGo, "(STUBBED)called");
+s32 PS4_SYSV_ABI scePlayGoGetInstallSpeed(OrbisPlayGoHandle handle,
+                                          OrbisPlayGoInstallSpeed* outSpeed) {
+    LOG_DEBUG(Lib_PlayGo, "called");
+    if (handle != shadMagic) {
+        return ORBIS_PLAYGO_ERROR_BAD_HANDLE;
+    }
+    if (outSpeed == nullptr) {
+        return ORBIS_PLAYGO_ERROR_BAD_POINTER;
+    }
+    std::scoped_lock lk{state.mutex};
+    *outSpeed = state.speed;
     return ORBIS_OK;
 }
 
 s32 PS4_SYSV_ABI scePlayGoGetLanguageMask(OrbisPlayGoHandle handle,
                                           OrbisPlayGoLanguageMask* languageMask) {
-    LOG_ERROR(Lib_PlayGo, "(STUBBED)called");
-    *languageMask = 1; // En, todo;
+    LOG_DEBUG(Lib_PlayGo, "called");
+    if (handle != shadMagic) {
+        return ORBIS_PLAYGO_ERROR_BAD_HANDLE;
+    }
+    if (languageMask == nullptr) {
+        return ORBIS_PLAYGO_ERROR_BAD_POINTER;
+    }
+    std::scoped_lock lk{state.mutex};
+    *languageMask = state.language_mask;
     return ORBIS_OK;
 }
 
 s32 PS4_SYSV_ABI scePlayGoGetLocus(OrbisPlayGoHandle handle, const OrbisPlayGoChunkId* chunkIds,
                                    uint32_t numberOfEntries, OrbisPlayGoLocus* outLoci) {
-    LOG_ERROR(Lib_PlayGo, "(STUBBED)called handle = {}, chunkIds = {}, numberOfEntries = {}",
-              handle, *chunkIds, numberOfEntries);
-    // assign all now so that scePlayGoGetLocus is not called again for every single entry
-    std::fill(outLoci, outLoci + numberOfEntries,
-              OrbisPlayGoLocusValue::ORBIS_PLAYGO_LOCUS_LOCAL_FAST);
+    LOG_DEBUG(Lib_PlayGo, "called handle = {}, numberOfEntries = {}", handle, numberOfEntries);
+    if (handle != shadMagic) {
+        return ORBIS_PLAYGO_ERROR_BAD_HANDLE;
+    }
+    if (chunkIds == nullptr || outLoci == nullptr) {
+        return ORBIS_PLAYGO_ERROR_BAD_POINTER;
+    }
+    std::scoped_lock lk{state.mutex};
+    for (u32 i = 0; i < numberOfEntries; i++) {
+        if (chunkIds[i] >= state.chunk_count) {
+            return ORBIS_PLAYGO_ERROR_BAD_CHUNK_ID;
+        }
+        outLoci[i] = state.loci[chunkIds[i]];
+    }
     return ORBIS_OK;
 }
 
 s32 PS4_SYSV_ABI scePlayGoGetProgress(OrbisPlayGoHandle handle, const OrbisPlayGoChunkId* chunkIds,
                                       uint32_t numberOfEntries, OrbisPlayGoProgress* outProgress) {
-    LOG_ERROR(Lib_PlayGo, "(STUBBED)called handle = {}, chunkIds = {}, numberOfEntries = {}",
-              handle, *chunkIds, numberOfEntries);
-    outProgress->progressSize = 0x10000; // todo?
-    outProgress->totalSize = 0x10000;
-    return 0;
+    LOG_DEBUG(Lib_PlayGo, "called handle = {}, numberOfEntries = {}", handle, numberOfEntries);
+    if (handle != shadMagic) {
+        return ORBIS_PLAYGO_ERROR_BAD_HANDLE;
+    }
+    if (chunkIds == nullptr || outProgress == nullptr) {
+        return ORBIS_PLAYGO_ERROR_BAD_POINTER;
+    }
+    std::scoped_lock lk{state.mutex};
+    for (u32 i = 0; i < numberOfEntries; i++) {
+        if (chunkIds[i] >= state.chunk_count) {
+            return ORBIS_PLAYGO_ERROR_BAD_CHUNK_ID;
+        }
+    }
+    // Chunk data is fully present on disk; report the queried share of the
+    // metadata total as both done and total so ratios come out as 1.
+    const u64 size = state.total_size * numberOfEntries / std::max<u32>(state.chunk_count, 1);
+    outProgress->progressSize = size;
+    outProgress->totalSize = size;
+    return ORBIS_OK;
 }
 
 s32 PS4_SYSV_ABI scePlayGoGetToDoList(OrbisPlayGoHandle handle, OrbisPlayGoToDo* outTodoList,
                                       u32 numberOfEntries, u32* outEntries) {
-    LOG_ERROR(Lib_PlayGo, "(STUBBED)called");
+    LOG_DEBUG(Lib_PlayGo, "called");
     if (handle != shadMagic)
         return ORBIS_PLAYGO_ERROR_BAD_HANDLE;
-    if (outTodoList == nullptr)
+    if (outTodoList == nullptr || outEntries == nullptr)
         return ORBIS_PLAYGO_ERROR_BAD_POINTER;
-    *outEntries = 0; // nothing to do
+    std::scoped_lock lk{state.mutex};
+    const u32 count = std::min<u32>(numberOfEntries, static_cast<u32>(state.todo.size()));
+    std::copy_n(state.todo.begin(), count, outTodoList);
+    *outEntries = count;
     return ORBIS_OK;
 }
 
@@ -83,40 +217,110 @@ s32 PS4_SYSV_ABI scePlayGoInitialize(OrbisPlayGoInitParams* param) {
         return ORBIS_PLAYGO_ERROR_BAD_POINTER;
     if (param->bufSize < 0x200000)
         return ORBIS_PLAYGO_ERROR_BAD_SIZE;
-    LOG_INFO(Lib_PlayGo, "(STUBBED)called, bufSize = {}", param->bufSize);
+    LOG_INFO(Lib_PlayGo, "called, bufSize = {}", param->bufSize);
+    std::scoped_lock lk{state.mutex};
+    if (state.initialized) {
+        return ORBIS_PLAYGO_ERROR_ALREADY_INITIALIZED;
+    }
+    if (!LoadChunkMetadata()) {
+        state.chunk_count = 1;
+        state.total_size = 0x10000;
+    }
+    state.loci.assign(state.chunk_count, ORBIS_PLAYGO_LOCUS_LOCAL_FAST);
+    state.initialized = true;
     return ORBIS_OK;
 }
 
 s32 PS4_SYSV_ABI scePlayGoOpen(OrbisPlayGoHandle* outHandle, const void* param) {
+    LOG_INFO(Lib_PlayGo, "called");
+    if (outHandle == nullptr) {
+        return ORBIS_PLAYGO_ERROR_BAD_POINTER;
+    }
+    std::scoped_lock lk{state.mutex};
+    if (!state.initialized) {
+        return ORBIS_PLAYGO_ERROR_NOT_INITIALIZED;
+    }
+    if (state.opened) {
+        return ORBIS_PLAYGO_ERROR_ALREADY_STARTED;
+    }
+    state.opened = true;
     *outHandle = shadMagic;
-    LOG_INFO(Lib_PlayGo, "(STUBBED)called");
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI scePlayGoPrefetch() {
-    LOG_ERROR(Lib_PlayGo, "(STUBBED)called");
+s32 PS4_SYSV_ABI scePlayGoPrefetch(OrbisPlayGoHandle handle, const OrbisPlayGoChunkId* chunkIds,
+                                   u32 numberOfEntries, OrbisPlayGoLocus minimumLocus) {
+    LOG_DEBUG(Lib_PlayGo, "called numberOfEntries = {}", numberOfEntries);
+    if (handle != shadMagic) {
+        return ORBIS_PLAYGO_ERROR_BAD_HANDLE;
+    }
+    if (chunkIds == nullptr) {
+        return ORBIS_PLAYGO_ERROR_BAD_POINTER;
+    }
+    std::scoped_lock lk{state.mutex};
+    for (u32 i = 0; i < numberOfEntries; i++) {
+        if (chunkIds[i] >= state.chunk_count) {
+            return ORBIS_PLAYGO_ERROR_BAD_CHUNK_ID;
+        }
+    }
+    // Data already resides on fast local storage, prefetch is satisfied as-is.
     return ORBIS_OK;
 }
 
-s32 PS4_SYSV_ABI scePlayGoSetInstallSpeed() {
-    LOG_ERROR(Lib_PlayGo, "(STUBBED)called");
+s32 PS4_SYSV_ABI scePlayGoSetInstallSpeed(OrbisPlayGoHandle handle,
+                                          OrbisPlayGoInstallSpeed speed) {
+    LOG_DEBUG(Lib_PlayGo, "called speed = {}", speed);
+    if (handle != shadMagic) {
+        return ORBIS_PLAYGO_ERROR_BAD_HANDLE;
+    }
+    if (speed < ORBIS_PLAYGO_INSTALL_SPEED_SUSPENDED || speed > ORBIS_PLAYGO_INSTALL_SPEED_FULL) {
+        return ORBIS_PLAYGO_ERROR_BAD_SPEED;
+    }
+    std::scoped_lock lk{state.mutex};
+    state.speed = speed;
     return ORBIS_OK;
 }
 
 s32 PS4_SYSV_ABI scePlayGoSetLanguageMask(OrbisPlayGoHandle handle,
                                           OrbisPlayGoLanguageMask languageMask) {
-    LOG_ERROR(Lib_PlayGo, "(STUBBED)called");
+    LOG_DEBUG(Lib_PlayGo, "called languageMask = {:#x}", languageMask);
+    if (handle != shadMagic) {
+        return ORBIS_PLAYGO_ERROR_BAD_HANDLE;
+    }
+    std::scoped_lock lk{state.mutex};
+    state.language_mask = languageMask;
     return ORBIS_OK;
 }
 
 s32 PS4_SYSV_ABI scePlayGoSetToDoList(OrbisPlayGoHandle handle, const OrbisPlayGoToDo* todoList,
                                       uint32_t numberOfEntries) {
-    LOG_ERROR(Lib_PlayGo, "(STUBBED)called");
+    LOG_DEBUG(Lib_PlayGo, "called numberOfEntries = {}", numberOfEntries);
+    if (handle != shadMagic) {
+        return ORBIS_PLAYGO_ERROR_BAD_HANDLE;
+    }
+    if (todoList == nullptr) {
+        return ORBIS_PLAYGO_ERROR_BAD_POINTER;
+    }
+    std::scoped_lock lk{state.mutex};
+    for (u32 i = 0; i < numberOfEntries; i++) {
+        if (todoList[i].chunkId >= state.chunk_count) {
+            return ORBIS_PLAYGO_ERROR_BAD_CHUNK_ID;
+        }
+    }
+    state.todo.assign(todoList, todoList + numberOfEntries);
     return ORBIS_OK;
 }
 
 s32 PS4_SYSV_ABI scePlayGoTerminate() {
-    LOG_ERROR(Lib_PlayGo, "(STUBBED)called");
+    LOG_INFO(Lib_PlayGo, "called");
+    std::scoped_lock lk{state.mutex};
+    if (!state.initialized) {
+        return ORBIS_PLAYGO_ERROR_NOT_INITIALIZED;
+    }
+    state.initialized = false;
+    state.opened = false;
+    state.loci.clear();
+    state.todo.clear();
     return ORBIS_OK;
 }
 
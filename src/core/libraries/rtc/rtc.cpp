@@ -2,7 +2,9 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 // Generated By moduleGenerator
+#include <atomic>
 #include <chrono>
+#include <ctime>
 #include "common/logging/log.h"
 #include "core/libraries/error_codes.h"
 #include "core/libraries/libs.h"
@@ -10,6 +12,91 @@
 
 namespace Libraries::Rtc {
 
+namespace {
+
+// Ticks follow sceRtcGetCurrentTick below: nanoseconds since the Unix epoch.
+constexpr u64 TicksPerSecond = 1'000'000'000ULL;
+constexpr u64 TicksPerMicrosecond = 1'000ULL;
+constexpr s64 SecondsPerDay = 86'400;
+
+/// Returns the local-time offset from UTC in seconds. Engines stamping every
+/// event convert in bursts, so the offset is derived from the C runtime only
+/// once a minute rather than per call; the short validity window still picks
+/// up DST transitions promptly.
+s64 CachedUtcOffsetSeconds() {
+    static std::atomic<s64> cached_offset{0};
+    static std::atomic<s64> valid_until{0};
+    const s64 now = static_cast<s64>(std::time(nullptr));
+    if (now < valid_until.load(std::memory_order_acquire)) {
+        return cached_offset.load(std::memory_order_relaxed);
+    }
+    const std::time_t time = static_cast<std::time_t>(now);
+    std::tm local{};
+    std::tm utc{};
+#ifdef _WIN32
+    localtime_s(&local, &time);
+    gmtime_s(&utc, &time);
+#else
+    localtime_r(&time, &local);
+    gmtime_r(&time, &utc);
+#endif
+    s64 offset = (local.tm_hour - utc.tm_hour) * 3600 + (local.tm_min - utc.tm_min) * 60;
+    // The civil dates can land on different days around midnight; the gap is
+    // never more than one day in either direction.
+    if (local.tm_year != utc.tm_year) {
+        offset += local.tm_year > utc.tm_year ? SecondsPerDay : -SecondsPerDay;
+    } else if (local.tm_yday != utc.tm_yday) {
+        offset += local.tm_yday > utc.tm_yday ? SecondsPerDay : -SecondsPerDay;
+    }
+    cached_offset.store(offset, std::memory_order_relaxed);
+    valid_until.store(now - now % 60 + 60, std::memory_order_release);
+    return offset;
+}
+
+/// Splits a tick into civil date fields without going through the C runtime.
+void TickToDateTime(u64 tick, OrbisRtcDateTime& out) {
+    const u64 micros = tick / TicksPerMicrosecond;
+    const s64 seconds = static_cast<s64>(micros / 1'000'000);
+    const s64 days = seconds / SecondsPerDay;
+    const s64 day_seconds = seconds % SecondsPerDay;
+
+    // Civil-from-days on the proleptic Gregorian calendar, era-based so the
+    // leap rules reduce to table-free arithmetic.
+    const s64 z = days + 719'468;
+    const s64 era = z / 146'097;
+    const u64 doe = static_cast<u64>(z - era * 146'097);
+    const u64 yoe = (doe - doe / 1460 + doe / 36'524 - doe / 146'096) / 365;
+    const s64 y = static_cast<s64>(yoe) + era * 400;
+    const u64 doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const u64 mp = (5 * doy + 2) / 153;
+    const u64 d = doy - (153 * mp + 2) / 5 + 1;
+    const u64 m = mp < 10 ? mp + 3 : mp - 9;
+
+    out.year = static_cast<u16>(m <= 2 ? y + 1 : y);
+    out.month = static_cast<u16>(m);
+    out.day = static_cast<u16>(d);
+    out.hour = static_cast<u16>(day_seconds / 3600);
+    out.minute = static_cast<u16>(day_seconds % 3600 / 60);
+    out.second = static_cast<u16>(day_seconds % 60);
+    out.microsecond = static_cast<u32>(micros % 1'000'000);
+}
+
+u64 CurrentTick() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::high_resolution_clock::now().time_since_epoch())
+        .count();
+}
+
+} // Anonymous namespace
+
+void ConvertTicksToDateTimes(std::span<const OrbisRtcTick> ticks, OrbisRtcDateTime* out,
+                             bool local_time) {
+    const s64 offset_ticks = local_time ? CachedUtcOffsetSeconds() * s64(TicksPerSecond) : 0;
+    for (size_t i = 0; i < ticks.size(); ++i) {
+        TickToDateTime(ticks[i].tick + offset_ticks, out[i]);
+    }
+}
+
 int PS4_SYSV_ABI sceRtcCheckValid() {
     LOG_ERROR(Lib_Rtc, "(STUBBED) called");
     return ORBIS_OK;
@@ -20,13 +107,19 @@ int PS4_SYSV_ABI sceRtcCompareTick() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceRtcConvertLocalTimeToUtc() {
-    LOG_ERROR(Lib_Rtc, "(STUBBED) called");
+int PS4_SYSV_ABI sceRtcConvertLocalTimeToUtc(const OrbisRtcTick* pLocalTime, OrbisRtcTick* pUtc) {
+    if (!pLocalTime || !pUtc) {
+        return ORBIS_KERNEL_ERROR_EINVAL;
+    }
+    pUtc->tick = pLocalTime->tick - CachedUtcOffsetSeconds() * s64(TicksPerSecond);
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceRtcConvertUtcToLocalTime() {
-    LOG_ERROR(Lib_Rtc, "(STUBBED) called");
+int PS4_SYSV_ABI sceRtcConvertUtcToLocalTime(const OrbisRtcTick* pUtc, OrbisRtcTick* pLocalTime) {
+    if (!pUtc || !pLocalTime) {
+        return ORBIS_KERNEL_ERROR_EINVAL;
+    }
+    pLocalTime->tick = pUtc->tick + CachedUtcOffsetSeconds() * s64(TicksPerSecond);
     return ORBIS_OK;
 }
 
@@ -70,13 +163,20 @@ int PS4_SYSV_ABI sceRtcGetCurrentAdNetworkTick() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceRtcGetCurrentClock() {
-    LOG_ERROR(Lib_Rtc, "(STUBBED) called");
+int PS4_SYSV_ABI sceRtcGetCurrentClock(OrbisRtcDateTime* pClock, int time_zone) {
+    if (!pClock) {
+        return ORBIS_KERNEL_ERROR_EINVAL;
+    }
+    // The timezone argument is an offset from UTC in minutes.
+    TickToDateTime(CurrentTick() + s64(time_zone) * 60 * s64(TicksPerSecond), *pClock);
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceRtcGetCurrentClockLocalTime() {
-    LOG_ERROR(Lib_Rtc, "(STUBBED) called");
+int PS4_SYSV_ABI sceRtcGetCurrentClockLocalTime(OrbisRtcDateTime* pClock) {
+    if (!pClock) {
+        return ORBIS_KERNEL_ERROR_EINVAL;
+    }
+    TickToDateTime(CurrentTick() + CachedUtcOffsetSeconds() * s64(TicksPerSecond), *pClock);
     return ORBIS_OK;
 }
 
@@ -96,9 +196,7 @@ int PS4_SYSV_ABI sceRtcGetCurrentRawNetworkTick() {
 }
 
 int PS4_SYSV_ABI sceRtcGetCurrentTick(OrbisRtcTick* pTick) {
-    pTick->tick = std::chrono::duration_cast<std::chrono::nanoseconds>(
-                      std::chrono::high_resolution_clock::now().time_since_epoch())
-                      .count();
+    pTick->tick = CurrentTick();
     return ORBIS_OK;
 }
 
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <span>
 #include "common/types.h"
 
 namespace Core::Loader {
@@ -15,10 +16,26 @@ struct OrbisRtcTick {
     u64 tick;
 };
 
+struct OrbisRtcDateTime {
+    u16 year;
+    u16 month;
+    u16 day;
+    u16 hour;
+    u16 minute;
+    u16 second;
+    u32 microsecond;
+};
+
+/// Converts a run of ticks into caller-provided date-time records, deriving
+/// the timezone offset once for the whole batch instead of per conversion.
+/// Internal helper for HLE code stamping many events at once.
+void ConvertTicksToDateTimes(std::span<const OrbisRtcTick> ticks, OrbisRtcDateTime* out,
+                             bool local_time);
+
 int PS4_SYSV_ABI sceRtcCheckValid();
 int PS4_SYSV_ABI sceRtcCompareTick();
-int PS4_SYSV_ABI sceRtcConvertLocalTimeToUtc();
-int PS4_SYSV_ABI sceRtcConvertUtcToLocalTime();
+int PS4_SYSV_ABI sceRtcConvertLocalTimeToUtc(const OrbisRtcTick* pLocalTime, OrbisRtcTick* pUtc);
+int PS4_SYSV_ABI sceRtcConvertUtcToLocalTime(const OrbisRtcTick* pUtc, OrbisRtcTick* pLocalTime);
 int PS4_SYSV_ABI sceRtcEnd();
 int PS4_SYSV_ABI sceRtcFormatRFC2822();
 int PS4_SYSV_ABI sceRtcFormatRFC2822LocalTime();
@@ -27,8 +44,8 @@ int PS4_SYSV_ABI sceRtcFormatRFC3339LocalTime();
 int PS4_SYSV_ABI sceRtcFormatRFC3339Precise();
 int PS4_SYSV_ABI sceRtcFormatRFC3339PreciseLocalTime();
 int PS4_SYSV_ABI sceRtcGetCurrentAdNetworkTick();
-int PS4_SYSV_ABI sceRtcGetCurrentClock();
-int PS4_SYSV_ABI sceRtcGetCurrentClockLocalTime();
+int PS4_SYSV_ABI sceRtcGetCurrentClock(OrbisRtcDateTime* pClock, int time_zone);
+int PS4_SYSV_ABI sceRtcGetCurrentClockLocalTime(OrbisRtcDateTime* pClock);
 int PS4_SYSV_ABI sceRtcGetCurrentDebugNetworkTick();
 int PS4_SYSV_ABI sceRtcGetCurrentNetworkTick();
 int PS4_SYSV_ABI sceRtcGetCurrentRawNetworkTick();
@@ -389,6 +389,9 @@ s32 saveDataMount(u32 user_id, std::string dir_name, u32 mount_mode,
     default:
         UNREACHABLE();
     }
+    // Route file IO under this mount through the write-behind commit layer, so
+    // guest saves complete in memory and reach the disk off-thread.
+    Common::Singleton<Core::FileSys::SaveDataCommitter>::Instance()->AddRoot(mount_dir);
     mount_result->required_blocks = 0;
 
     return ORBIS_OK;
@@ -6,6 +6,7 @@
 #include "core/libraries/error_codes.h"
 #include "core/libraries/libs.h"
 #include "screenshot.h"
+#include "video_core/renderer_vulkan/vk_capture.h"
 
 namespace Libraries::ScreenShot {
 
@@ -15,7 +16,8 @@ int PS4_SYSV_ABI _Z5dummyv() {
 }
 
 int PS4_SYSV_ABI sceScreenShotCapture() {
-    LOG_ERROR(Lib_Screenshot, "(STUBBED) called");
+    LOG_INFO(Lib_Screenshot, "called");
+    Vulkan::RequestFrameCapture();
     return ORBIS_OK;
 }
 
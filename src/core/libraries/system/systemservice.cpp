@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+#include <atomic>
 #include "common/config.h"
 #include "common/logging/log.h"
 #include "core/libraries/error_codes.h"
@@ -15,6 +17,25 @@ bool IsSplashVisible() {
     return Config::showSplash() && g_splash_status;
 }
 
+// Single-producer single-consumer event ring. Titles poll ReceiveEvent every
+// frame, so the empty check has to stay at a pair of atomic loads; events are
+// pushed from the emulator side (focus changes, invitations) far more rarely.
+static constexpr u32 MaxPendingEvents = 16;
+static std::array<OrbisSystemServiceEvent, MaxPendingEvents> g_event_ring{};
+static std::atomic<u32> g_event_write{0};
+static std::atomic<u32> g_event_read{0};
+
+void PushSystemServiceEvent(const OrbisSystemServiceEvent& event) {
+    const u32 write = g_event_write.load(std::memory_order_relaxed);
+    if (write - g_event_read.load(std::memory_order_acquire) >= MaxPendingEvents) {
+        LOG_WARNING(Lib_SystemService, "Event ring full, dropping event {}",
+                    static_cast<s32>(event.event_type));
+        return;
+    }
+    g_event_ring[write % MaxPendingEvents] = event;
+    g_event_write.store(write + 1, std::memory_order_release);
+}
+
 int PS4_SYSV_ABI sceAppMessagingClearEventFlag() {
     LOG_ERROR(Lib_SystemService, "(STUBBED) called");
     return ORBIS_OK;
@@ -1773,7 +1794,8 @@ s32 PS4_SYSV_ABI sceSystemServiceGetStatus(OrbisSystemServiceStatus* status) {
         return ORBIS_SYSTEM_SERVICE_ERROR_PARAMETER;
     }
     OrbisSystemServiceStatus st = {};
-    st.eventNum = 0;
+    st.eventNum = static_cast<s32>(g_event_write.load(std::memory_order_acquire) -
+                                   g_event_read.load(std::memory_order_relaxed));
     st.isSystemUiOverlaid = false;
     st.isInBackgroundExecution = false;
     st.isCpuMode7CpuNormal = true;
@@ -1942,8 +1964,17 @@ int PS4_SYSV_ABI sceSystemServiceRaiseExceptionLocalProcess() {
     return ORBIS_OK;
 }
 
-int PS4_SYSV_ABI sceSystemServiceReceiveEvent() {
-    LOG_ERROR(Lib_SystemService, "(STUBBED) called");
+s32 PS4_SYSV_ABI sceSystemServiceReceiveEvent(OrbisSystemServiceEvent* event) {
+    if (event == nullptr) {
+        return ORBIS_SYSTEM_SERVICE_ERROR_PARAMETER;
+    }
+    const u32 read = g_event_read.load(std::memory_order_relaxed);
+    if (read == g_event_write.load(std::memory_order_acquire)) {
+        return ORBIS_SYSTEM_SERVICE_ERROR_NO_EVENT;
+    }
+    *event = g_event_ring[read % MaxPendingEvents];
+    g_event_read.store(read + 1, std::memory_order_release);
+    LOG_INFO(Lib_SystemService, "delivered event {}", static_cast<s32>(event->event_type));
     return ORBIS_OK;
 }
 
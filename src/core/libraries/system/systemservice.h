@@ -102,8 +102,47 @@ struct OrbisSystemServiceDisplaySafeAreaInfo {
     uint8_t reserved[128];
 };
 
+enum class OrbisSystemServiceEventType : s32 {
+    OnResume = 0x10000000,
+    GameLiveStreamingStatusUpdate = 0x10000001,
+    SessionInvitation = 0x10000002,
+    EntitlementUpdate = 0x10000003,
+    GameCustomData = 0x10000004,
+    DisplaySafeAreaUpdate = 0x10000005,
+    UrlOpen = 0x10000006,
+    LaunchApp = 0x10000007,
+    AppLaunchLink = 0x10000008,
+    AddcontentInstall = 0x10000009,
+    ResetVrPosition = 0x1000000a,
+    JoinEvent = 0x1000000b,
+    PlaygoLocusUpdate = 0x1000000c,
+    PlayTogetherHost = 0x1000000d,
+    ServiceEntitlementUpdate = 0x1000000e,
+    EyeToEyeDistanceUpdate = 0x1000000f,
+    JointSpeakerVolumeControl = 0x10000010,
+    PlaybackControlWithRemotePlay = 0x10000011,
+    PortStatusChange = 0x10000012,
+    OpenShareMenu = 0x30000000,
+};
+
+struct OrbisSystemServiceEvent {
+    OrbisSystemServiceEventType event_type;
+    union {
+        char param[8192];
+        struct {
+            char source[1024];
+            char url[4096];
+        } url_open;
+        u8 reserved[8192];
+    } data;
+};
+
 bool IsSplashVisible();
 
+/// Queues an event for the title to drain with sceSystemServiceReceiveEvent.
+/// Must be called from a single producer thread.
+void PushSystemServiceEvent(const OrbisSystemServiceEvent& event);
+
 int PS4_SYSV_ABI sceAppMessagingClearEventFlag();
 int PS4_SYSV_ABI sceAppMessagingReceiveMsg();
 int PS4_SYSV_ABI sceAppMessagingSendMsg();
@@ -480,7 +519,7 @@ s32 PS4_SYSV_ABI sceSystemServiceParamGetInt(int param_id, int* value);
 int PS4_SYSV_ABI sceSystemServiceParamGetString();
 int PS4_SYSV_ABI sceSystemServicePowerTick();
 int PS4_SYSV_ABI sceSystemServiceRaiseExceptionLocalProcess();
-int PS4_SYSV_ABI sceSystemServiceReceiveEvent();
+s32 PS4_SYSV_ABI sceSystemServiceReceiveEvent(OrbisSystemServiceEvent* event);
 int PS4_SYSV_ABI sceSystemServiceReenableMusicPlayer();
 int PS4_SYSV_ABI sceSystemServiceRegisterDaemon();
 int PS4_SYSV_ABI sceSystemServiceReleaseFb0();
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
+#include <atomic>
 #include "common/logging/log.h"
 #include "core/libraries/error_codes.h"
 #include "core/libraries/libs.h"
@@ -8,6 +10,35 @@
 
 namespace Libraries::UserService {
 
+// Same single-producer ring shape as the system service events: the per-frame
+// guest poll must stay a couple of atomic loads in the empty case.
+static constexpr u32 MaxPendingEvents = 8;
+static std::array<OrbisUserServiceEvent, MaxPendingEvents> g_event_ring{};
+static std::atomic<u32> g_event_write{0};
+static std::atomic<u32> g_event_read{0};
+static std::atomic<bool> g_login_queued{false};
+
+static void PushUserServiceEvent(const OrbisUserServiceEvent& event) {
+    const u32 write = g_event_write.load(std::memory_order_relaxed);
+    if (write - g_event_read.load(std::memory_order_acquire) >= MaxPendingEvents) {
+        LOG_WARNING(Lib_UserService, "Event ring full, dropping event {}",
+                    static_cast<int>(event.event));
+        return;
+    }
+    g_event_ring[write % MaxPendingEvents] = event;
+    g_event_write.store(write + 1, std::memory_order_release);
+}
+
+static void QueueInitialLogin() {
+    if (g_login_queued.exchange(true, std::memory_order_relaxed)) {
+        return;
+    }
+    PushUserServiceEvent({
+        .event = SCE_USER_SERVICE_EVENT_TYPE_LOGIN,
+        .userId = 1,
+    });
+}
+
 int PS4_SYSV_ABI sceUserServiceInitializeForShellCore() {
     LOG_ERROR(Lib_UserService, "(STUBBED) called");
     return ORBIS_OK;
@@ -104,18 +135,19 @@ int PS4_SYSV_ABI sceUserServiceGetDiscPlayerFlag() {
 }
 
 s32 PS4_SYSV_ABI sceUserServiceGetEvent(OrbisUserServiceEvent* event) {
-    LOG_TRACE(Lib_UserService, "(DUMMY) called");
-    // fake a loggin event
-    static bool logged_in = false;
-
-    if (!logged_in) {
-        logged_in = true;
-        event->event = SCE_USER_SERVICE_EVENT_TYPE_LOGIN;
-        event->userId = 1;
-        return ORBIS_OK;
+    LOG_TRACE(Lib_UserService, "called");
+    if (event == nullptr) {
+        return ORBIS_USER_SERVICE_ERROR_INVALID_ARGUMENT;
     }
-
-    return ORBIS_USER_SERVICE_ERROR_NO_EVENT;
+    // Titles that skip sceUserServiceInitialize still expect the login event.
+    QueueInitialLogin();
+    const u32 read = g_event_read.load(std::memory_order_relaxed);
+    if (read == g_event_write.load(std::memory_order_acquire)) {
+        return ORBIS_USER_SERVICE_ERROR_NO_EVENT;
+    }
+    *event = g_event_ring[read % MaxPendingEvents];
+    g_event_read.store(read + 1, std::memory_order_release);
+    return ORBIS_OK;
 }
 
 int PS4_SYSV_ABI sceUserServiceGetEventCalendarType() {
@@ -1121,7 +1153,8 @@ int PS4_SYSV_ABI sceUserServiceGetVolumeForSidetone() {
 }
 
 s32 PS4_SYSV_ABI sceUserServiceInitialize(const OrbisUserServiceInitializeParams* initParams) {
-    LOG_WARNING(Lib_UserService, "(dummy) called");
+    LOG_INFO(Lib_UserService, "called");
+    QueueInitialLogin();
     return ORBIS_OK;
 }
 
@@ -3,6 +3,7 @@
 
 #include <pthread.h>
 #include "common/assert.h"
+#include "common/config.h"
 #include "core/libraries/error_codes.h"
 #include "core/libraries/kernel/time_management.h"
 #include "core/libraries/videoout/driver.h"
@@ -14,6 +15,13 @@ extern std::unique_ptr<Vulkan::RendererVulkan> renderer;
 
 namespace Libraries::VideoOut {
 
+// Period of the emulated 59.94 Hz display scanout.
+constexpr static u64 VblankPeriodUs = 16'683;
+
+// Cap on vblank events delivered by a single catch-up so a long stall
+// (loading screen, debugger) does not burst a backlog of events at the guest.
+constexpr static u64 MaxVblankCatchUp = 4;
+
 constexpr static bool Is32BppPixelFormat(PixelFormat format) {
     switch (format) {
     case PixelFormat::A8R8G8B8Srgb:
@@ -192,6 +200,7 @@ void VideoOutDriver::Flip(std::chrono::microseconds timeout) {
     flip_status.flipArg = req.flip_arg;
     flip_status.currentBuffer = req.index;
     flip_status.flipPendingNum = static_cast<int>(requests.size());
+    last_present_time = flip_status.processTime;
 
     // Trigger flip events for the port.
     for (auto& event : req.port->flip_events) {
@@ -220,7 +229,14 @@ bool VideoOutDriver::SubmitFlip(VideoOutPort* port, s32 index, s64 flip_arg,
         frame = renderer->PrepareFrame(group, buffer.address_left);
     }
 
-    if (index != -1 && requests.size() >= port->NumRegisteredBuffers()) {
+    // Zero keeps the legacy behavior of one pending request per registered buffer;
+    // lower values trade throughput for latency, the registered buffer count is an
+    // upper bound either way since a queued buffer cannot be rendered to again.
+    size_t queue_depth = port->NumRegisteredBuffers();
+    if (const u32 configured = Config::flipQueueDepth(); configured != 0) {
+        queue_depth = std::min<size_t>(configured, queue_depth);
+    }
+    if (index != -1 && requests.size() >= queue_depth) {
         LOG_ERROR(Lib_VideoOut, "Flip queue is full");
         return false;
     }
@@ -244,8 +260,35 @@ bool VideoOutDriver::SubmitFlip(VideoOutPort* port, s32 index, s64 flip_arg,
 void VideoOutDriver::Vblank() {
     std::scoped_lock lock{mutex};
 
+    // Pace the cadence off the process clock rather than the caller's loop rate.
+    // Early calls from a fast render loop are skipped, while a frame that overruns
+    // the period yields every vblank that became due, so a title just missing 60 Hz
+    // degrades gradually instead of dropping straight to half rate.
+    const u64 now = Libraries::Kernel::sceKernelGetProcessTime();
+    if (last_vblank_time == 0) {
+        last_vblank_time = now;
+    }
+    u64 num_due = (now - last_vblank_time) / VblankPeriodUs;
+    if (Config::headlessMode()) {
+        // Deterministic cadence for headless perf runs: every poll delivers
+        // exactly one vblank, so results do not depend on host scheduling or
+        // a compositor.
+        last_vblank_time = now;
+        num_due = 1;
+    } else if (num_due == 0) {
+        return;
+    } else if (num_due > MaxVblankCatchUp) {
+        num_due = MaxVblankCatchUp;
+        last_vblank_time = now;
+    } else {
+        last_vblank_time += num_due * VblankPeriodUs;
+        // Phase-lock to the last host present so guests waking on vblank right
+        // after a flip observe timings consistent with what is on screen.
+        last_vblank_time = std::max(last_vblank_time, last_present_time);
+    }
+
     auto& vblank_status = main_port.vblank_status;
-    vblank_status.count++;
+    vblank_status.count += num_due;
     vblank_status.processTime = Libraries::Kernel::sceKernelGetProcessTime();
     vblank_status.tsc = Libraries::Kernel::sceKernelReadTsc();
 
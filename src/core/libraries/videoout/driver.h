@@ -80,6 +80,8 @@ private:
 
     std::mutex mutex;
     VideoOutPort main_port{};
+    u64 last_vblank_time{};
+    u64 last_present_time{};
     std::condition_variable_any submit_cond;
     std::condition_variable done_cond;
     std::queue<Request> requests;
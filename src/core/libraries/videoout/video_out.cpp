@@ -4,6 +4,7 @@
 #include "common/assert.h"
 #include "common/config.h"
 #include "common/logging/log.h"
+#include "core/guest_pointer.h"
 #include "core/libraries/error_codes.h"
 #include "core/libraries/libs.h"
 #include "core/libraries/system/userservice.h"
@@ -25,14 +26,21 @@ void PS4_SYSV_ABI sceVideoOutSetBufferAttribute(BufferAttribute* attribute, Pixe
              GetPixelFormatString(pixelFormat), tilingMode, aspectRatio, width, height,
              pitchInPixel);
 
-    std::memset(attribute, 0, sizeof(BufferAttribute));
-    attribute->pixel_format = static_cast<PixelFormat>(pixelFormat);
-    attribute->tiling_mode = static_cast<TilingMode>(tilingMode);
-    attribute->aspect_ratio = aspectRatio;
-    attribute->width = width;
-    attribute->height = height;
-    attribute->pitch_in_pixel = pitchInPixel;
-    attribute->option = SCE_VIDEO_OUT_BUFFER_ATTRIBUTE_OPTION_NONE;
+    const Core::GuestPtr<BufferAttribute> attr{attribute};
+    if (!attr) {
+        LOG_ERROR(Lib_VideoOut, "Attribute is not a valid guest pointer");
+        return;
+    }
+
+    *attr = BufferAttribute{
+        .pixel_format = static_cast<PixelFormat>(pixelFormat),
+        .tiling_mode = static_cast<TilingMode>(tilingMode),
+        .aspect_ratio = aspectRatio,
+        .width = width,
+        .height = height,
+        .pitch_in_pixel = pitchInPixel,
+        .option = SCE_VIDEO_OUT_BUFFER_ATTRIBUTE_OPTION_NONE,
+    };
 }
 
 s32 PS4_SYSV_ABI sceVideoOutAddFlipEvent(Kernel::SceKernelEqueue eq, s32 handle, void* udata) {
@@ -87,8 +95,17 @@ s32 PS4_SYSV_ABI sceVideoOutAddVblankEvent(Kernel::SceKernelEqueue eq, s32 handl
 
 s32 PS4_SYSV_ABI sceVideoOutRegisterBuffers(s32 handle, s32 startIndex, void* const* addresses,
                                             s32 bufferNum, const BufferAttribute* attribute) {
-    if (!addresses || !attribute) {
-        LOG_ERROR(Lib_VideoOut, "Addresses are null");
+    if (bufferNum <= 0) {
+        LOG_ERROR(Lib_VideoOut, "Invalid buffer count = {}", bufferNum);
+        return ORBIS_VIDEO_OUT_ERROR_INVALID_VALUE;
+    }
+
+    // Validate the address table and the attribute block in one VMA walk each;
+    // past this point the driver dereferences them as plain host memory.
+    const Core::GuestSpan<void* const> address_table{addresses, static_cast<size_t>(bufferNum)};
+    const Core::GuestPtr<const BufferAttribute> attr{attribute};
+    if (!address_table || !attr) {
+        LOG_ERROR(Lib_VideoOut, "Addresses are null or unmapped");
         return ORBIS_VIDEO_OUT_ERROR_INVALID_ADDRESS;
     }
 
@@ -98,7 +115,8 @@ s32 PS4_SYSV_ABI sceVideoOutRegisterBuffers(s32 handle, s32 startIndex, void* co
         return ORBIS_VIDEO_OUT_ERROR_INVALID_HANDLE;
     }
 
-    return driver->RegisterBuffers(port, startIndex, addresses, bufferNum, attribute);
+    return driver->RegisterBuffers(port, startIndex, address_table.Get().data(), bufferNum,
+                                   attr.Get());
 }
 
 s32 PS4_SYSV_ABI sceVideoOutSetFlipRate(s32 handle, s32 rate) {
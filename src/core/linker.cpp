@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <unordered_map>
+#include <xbyak/xbyak.h>
 #include "common/alignment.h"
 #include "common/assert.h"
 #include "common/config.h"
@@ -49,7 +51,9 @@ static void RunMainEntry(VAddr addr, EntryParams* params, ExitFunc exit_func) {
 
 Linker::Linker() : memory{Memory::Instance()} {}
 
-Linker::~Linker() = default;
+Linker::~Linker() {
+    delete module_snapshot.load(std::memory_order_acquire);
+}
 
 void Linker::Execute() {
     if (Config::debugDump()) {
@@ -76,6 +80,7 @@ void Linker::Execute() {
 
     // Init primary thread.
     Common::SetCurrentThreadName("GAME_MainThread");
+    Common::SetCurrentThreadRole(Common::ThreadRole::Guest);
     Libraries::Kernel::pthreadInitSelfMainThread();
     InitTlsForThread(true);
 
@@ -114,20 +119,65 @@ s32 Linker::LoadModule(const std::filesystem::path& elf_name, bool is_dynamic) {
 
     num_static_modules += !is_dynamic;
     m_modules.emplace_back(std::move(module));
+    PublishModules();
     return m_modules.size() - 1;
 }
 
+void Linker::PublishModules() {
+    auto list = std::make_unique<std::vector<Module*>>();
+    list->reserve(m_modules.size());
+    for (const auto& module : m_modules) {
+        list->push_back(module.get());
+    }
+    const auto* old = module_snapshot.exchange(list.release(), std::memory_order_release);
+    if (old) {
+        retired_snapshots.emplace_back(old);
+    }
+}
+
 Module* Linker::FindByAddress(VAddr address) {
-    for (auto& module : m_modules) {
+    // Walks the published snapshot without locking; the exception handler hits
+    // this concurrently from many guest threads.
+    for (Module* module : GetModules()) {
         const VAddr base = module->GetBaseAddress();
         if (address >= base && address < base + module->aligned_base_size) {
-            return module.get();
+            return module;
         }
     }
     return nullptr;
 }
 
+// Applies every pending R_X86_64_RELATIVE entry of the main table in one tight
+// pass. They need no symbol lookup — the patched value is base + addend — and
+// linkers emit them as long consecutive runs, so this reduces to an add-store
+// loop over the table instead of a trip through the generic switch per entry.
+static void ApplyRelativeRelocations(Module* module) {
+    const VAddr base = module->GetBaseAddress();
+    auto* table = module->dynamic_info.relocation_table;
+    const u32 count = module->dynamic_info.relocation_table_size / sizeof(elf_relocation);
+    for (u32 i = 0; i < count; i++) {
+        const elf_relocation& rel = table[i];
+        if (rel.GetType() != R_X86_64_RELATIVE || module->TestRelaBit(i)) {
+            continue;
+        }
+        *reinterpret_cast<u64*>(base + rel.rel_offset) = base + rel.rel_addend;
+        module->SetRelaBit(i);
+    }
+}
+
 void Linker::Relocate(Module* module) {
+    const bool lazy_binding = Config::lazyJumpSlotBinding();
+    ApplyRelativeRelocations(module);
+
+    // Each unique (name, type) import is resolved once per pass; big titles
+    // reference the same few hundred symbols from hundreds of thousands of
+    // relocation slots.
+    struct CachedSymbol {
+        Loader::SymbolRecord rec{};
+        bool resolved{};
+    };
+    std::unordered_map<std::string, CachedSymbol> symbol_cache;
+
     module->ForEachRelocation([&](elf_relocation* rel, u32 i, bool isJmpRel) {
         const u32 bit_idx =
             (isJmpRel ? module->dynamic_info.relocation_table_size / sizeof(elf_relocation) : 0) +
@@ -135,6 +185,10 @@ void Linker::Relocate(Module* module) {
         if (module->TestRelaBit(bit_idx)) {
             return;
         }
+        if (lazy_binding && isJmpRel && rel->GetType() == R_X86_64_JUMP_SLOT) {
+            // Slot is bound on first call through the trampoline emitted below.
+            return;
+        }
         auto type = rel->GetType();
         auto symbol = rel->GetSymbol();
         auto addend = rel->rel_addend;
@@ -196,10 +250,16 @@ void Linker::Relocate(Module* module) {
             case STB_GLOBAL:
             case STB_WEAK: {
                 rel_name = namesTlb + sym.st_name;
-                if (Resolve(rel_name, rel_sym_type, module, &symrec)) {
+                auto [it, miss] = symbol_cache.try_emplace(
+                    rel_name + static_cast<char>(static_cast<u8>(rel_sym_type)));
+                if (miss) {
+                    it->second.resolved = Resolve(rel_name, rel_sym_type, module, &it->second.rec);
+                }
+                if (it->second.resolved) {
                     // Only set the rela bit if the symbol was actually resolved and not stubbed.
                     module->SetRelaBit(bit_idx);
                 }
+                symrec = it->second.rec;
                 symbol_vitrual_addr = symrec.virtual_address;
                 break;
             }
@@ -221,6 +281,139 @@ void Linker::Relocate(Module* module) {
             LOG_INFO(Core_Linker, "function not patched! {}", rel_name);
         }
     });
+
+    if (lazy_binding) {
+        EmitLazyStubs(module);
+    }
+}
+
+void Linker::EmitLazyStubs(Module* module) {
+    using namespace Xbyak::util;
+
+    const u32 num_jmp_slots =
+        module->dynamic_info.jmp_relocation_table_size / sizeof(elf_relocation);
+    if (num_jmp_slots == 0 ||
+        std::ranges::contains(lazy_stubs, module, &LazyStubInfo::module)) {
+        // Unbound slots of an already processed module still point at valid trampolines,
+        // so a rerun from RelocateAnyImports will pick up newly loaded exports on first call.
+        return;
+    }
+
+    // One trampoline per slot, so the slot index can be baked into the code.
+    static constexpr size_t MaxStubSize = 128;
+    auto& c = *lazy_stub_gens.emplace_back(
+        std::make_unique<Xbyak::CodeGenerator>(num_jmp_slots * MaxStubSize));
+
+    const u32 rel_table_count = module->dynamic_info.relocation_table_size / sizeof(elf_relocation);
+    const VAddr base_virtual_addr = module->GetBaseAddress();
+    for (u32 i = 0; i < num_jmp_slots; i++) {
+        if (module->TestRelaBit(rel_table_count + i)) {
+            continue;
+        }
+        auto& info = lazy_stubs.emplace_back(this, module, i);
+        const auto* stub = c.getCurr();
+
+        // Preserve the registers that carry arguments to the callee, bind the slot
+        // and tail call the resolved target. r11 is free real estate here, the SysV
+        // ABI reserves it as a scratch register for exactly this kind of linker code.
+        c.push(rax); // Holds the vector register count for variadic callees.
+        c.push(rdi);
+        c.push(rsi);
+        c.push(rdx);
+        c.push(rcx);
+        c.push(r8);
+        c.push(r9);
+        c.push(r10);     // Static chain pointer of nested functions.
+        c.sub(rsp, 136); // Room for xmm0-xmm7, keeps the stack 16 byte aligned.
+        for (int n = 0; n < 8; n++) {
+            c.movdqu(ptr[rsp + n * 16], Xbyak::Xmm(n));
+        }
+        c.mov(rdi, reinterpret_cast<size_t>(&info));
+        c.mov(rax, reinterpret_cast<size_t>(&Linker::LazyBindSlot));
+        c.call(rax);
+        c.mov(r11, rax);
+        for (int n = 0; n < 8; n++) {
+            c.movdqu(Xbyak::Xmm(n), ptr[rsp + n * 16]);
+        }
+        c.add(rsp, 136);
+        c.pop(r10);
+        c.pop(r9);
+        c.pop(r8);
+        c.pop(rcx);
+        c.pop(rdx);
+        c.pop(rsi);
+        c.pop(rdi);
+        c.pop(rax);
+        c.jmp(r11);
+
+        const auto* rel = &module->dynamic_info.jmp_relocation_table[i];
+        VirtualMemory::memory_patch(base_virtual_addr + rel->rel_offset,
+                                    reinterpret_cast<u64>(stub));
+    }
+}
+
+u64 PS4_SYSV_ABI Linker::LazyBindSlot(LazyStubInfo* info) {
+    return info->linker->ResolveLazy(info->module, info->jmprel_index);
+}
+
+u64 Linker::ResolveLazy(Module* module, u32 jmprel_index) {
+    std::scoped_lock lk{mutex};
+
+    const auto* rel = &module->dynamic_info.jmp_relocation_table[jmprel_index];
+    const u32 bit_idx =
+        module->dynamic_info.relocation_table_size / sizeof(elf_relocation) + jmprel_index;
+    const VAddr rel_base_virtual_addr = module->GetBaseAddress();
+    const VAddr rel_virtual_addr = rel_base_virtual_addr + rel->rel_offset;
+    if (module->TestRelaBit(bit_idx)) {
+        // Another thread won the race to bind this slot.
+        return *reinterpret_cast<u64*>(rel_virtual_addr);
+    }
+
+    ASSERT_MSG(rel->GetType() == R_X86_64_JUMP_SLOT, "unexpected relocation type {}",
+               rel->GetType());
+    const auto sym = module->dynamic_info.symbol_table[rel->GetSymbol()];
+    Loader::SymbolType sym_type{};
+    switch (sym.GetType()) {
+    case STT_FUN:
+        sym_type = Loader::SymbolType::Function;
+        break;
+    case STT_OBJECT:
+        sym_type = Loader::SymbolType::Object;
+        break;
+    case STT_NOTYPE:
+        sym_type = Loader::SymbolType::NoType;
+        break;
+    default:
+        ASSERT_MSG(0, "unknown symbol type {}", sym.GetType());
+    }
+
+    bool resolved = false;
+    u64 symbol_vitrual_addr = 0;
+    switch (sym.GetBind()) {
+    case STB_LOCAL:
+        symbol_vitrual_addr = rel_base_virtual_addr + sym.st_value;
+        resolved = true;
+        break;
+    case STB_GLOBAL:
+    case STB_WEAK: {
+        const std::string name = module->dynamic_info.str_table + sym.st_name;
+        Loader::SymbolRecord symrec{};
+        resolved = Resolve(name, sym_type, module, &symrec);
+        symbol_vitrual_addr = symrec.virtual_address;
+        break;
+    }
+    default:
+        ASSERT_MSG(0, "unknown bind type {}", sym.GetBind());
+    }
+
+    ASSERT_MSG(symbol_vitrual_addr != 0, "Unable to bind jump slot {}", jmprel_index);
+    if (resolved) {
+        // Only bind the slot when the symbol was not stubbed, so later calls retry
+        // the lookup once the exporting module has been loaded and relocated.
+        module->SetRelaBit(bit_idx);
+        VirtualMemory::memory_patch(rel_virtual_addr, symbol_vitrual_addr);
+    }
+    return symbol_vitrual_addr;
 }
 
 const Module* Linker::FindExportedModule(const ModuleInfo& module, const LibraryInfo& library) {
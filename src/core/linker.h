@@ -4,10 +4,17 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
 #include <mutex>
+#include <span>
 #include <vector>
 #include "core/module.h"
 
+namespace Xbyak {
+class CodeGenerator;
+}
+
 namespace Core {
 
 struct DynamicModuleInfo;
@@ -61,8 +68,16 @@ public:
         return m_modules[0]->GetProcParam<OrbisProcParam*>();
     }
 
+    /// Wait-free read-side view of the loaded modules. Module loads publish a
+    /// fresh copy and retire the old one, so exception handling and module
+    /// info queries never take the linker mutex.
+    std::span<Module* const> GetModules() const {
+        const auto* snapshot = module_snapshot.load(std::memory_order_acquire);
+        return snapshot ? std::span<Module* const>{*snapshot} : std::span<Module* const>{};
+    }
+
     Module* GetModule(s32 index) const {
-        return m_modules.at(index).get();
+        return GetModules()[index];
     }
 
     void RelocateAnyImports(Module* m) {
@@ -92,11 +107,22 @@ public:
     void Relocate(Module* module);
     bool Resolve(const std::string& name, Loader::SymbolType type, Module* module,
                  Loader::SymbolRecord* return_info);
+    u64 ResolveLazy(Module* module, u32 jmprel_index);
     void Execute();
     void DebugDump();
 
 private:
+    /// Bookkeeping passed to the lazy binding trampoline of a jump slot.
+    struct LazyStubInfo {
+        Linker* linker;
+        Module* module;
+        u32 jmprel_index;
+    };
+
     const Module* FindExportedModule(const ModuleInfo& m, const LibraryInfo& l);
+    void EmitLazyStubs(Module* module);
+    static u64 PS4_SYSV_ABI LazyBindSlot(LazyStubInfo* info);
+    void PublishModules();
 
     MemoryManager* memory;
     std::mutex mutex;
@@ -106,7 +132,13 @@ private:
     u32 num_static_modules{};
     HeapApiFunc heap_api_func{};
     std::vector<std::unique_ptr<Module>> m_modules;
+    // Retired snapshots stay alive until shutdown so concurrent readers are
+    // never left holding a freed vector; loads are rare and the lists tiny.
+    std::atomic<const std::vector<Module*>*> module_snapshot{};
+    std::vector<std::unique_ptr<const std::vector<Module*>>> retired_snapshots;
     Loader::SymbolsResolver m_hle_symbols{};
+    std::deque<LazyStubInfo> lazy_stubs; // Deque so trampolines can hold stable pointers.
+    std::vector<std::unique_ptr<Xbyak::CodeGenerator>> lazy_stub_gens;
 };
 
 } // namespace Core
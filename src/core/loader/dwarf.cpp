@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright (C) 2001-2024 Free Software Foundation, Inc.
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "core/loader/dwarf.h"
@@ -134,4 +135,61 @@ bool DecodeEHHdr(uintptr_t ehHdrStart, uintptr_t ehHdrEnd, EHHeaderInfo& ehHdrIn
     return true;
 }
 
+bool DecodeFdeTable(const EHHeaderInfo& ehHdrInfo, uintptr_t ehHdrStart, uintptr_t ehHdrEnd,
+                    std::vector<FdeTableEntry>& table) {
+    table.clear();
+    if (ehHdrInfo.fde_count == 0 || ehHdrInfo.table_enc == DW_EH_PE_omit) {
+        return false;
+    }
+    // The search table requires a fixed-width encoding (random access would be
+    // impossible otherwise), so LEB128 entries are rejected rather than decoded.
+    const u8 value_enc = ehHdrInfo.table_enc & 0x0F;
+    if (value_enc == DW_EH_PE_uleb128 || value_enc == DW_EH_PE_sleb128) {
+        LOG_ERROR(Core_Linker, "Unsupported .eh_frame_hdr table encoding: {:#x}",
+                  ehHdrInfo.table_enc);
+        return false;
+    }
+
+    table.reserve(ehHdrInfo.fde_count);
+    uintptr_t p = ehHdrInfo.table;
+    for (size_t i = 0; i < ehHdrInfo.fde_count && p < ehHdrEnd; i++) {
+        FdeTableEntry entry;
+        entry.pc_begin = getEncodedP(p, ehHdrEnd, ehHdrInfo.table_enc, ehHdrStart);
+        entry.fde_addr = getEncodedP(p, ehHdrEnd, ehHdrInfo.table_enc, ehHdrStart);
+        table.push_back(entry);
+    }
+
+    // Linkers emit the table sorted by initial PC; don't rely on it blindly.
+    if (!std::ranges::is_sorted(table, {}, &FdeTableEntry::pc_begin)) {
+        std::ranges::sort(table, {}, &FdeTableEntry::pc_begin);
+    }
+    return !table.empty();
+}
+
+size_t MeasureEhFrame(uintptr_t ehFrameStart, uintptr_t limit) {
+    uintptr_t p = ehFrameStart;
+    while (p + sizeof(u32) <= limit) {
+        u64 length = get<u32>(p);
+        uintptr_t next = p + sizeof(u32);
+        if (length == 0) {
+            // Zero length record terminates .eh_frame.
+            p = next;
+            break;
+        }
+        if (length == 0xFFFFFFFFu) {
+            // Extended length record.
+            if (next + sizeof(u64) > limit) {
+                break;
+            }
+            length = get<u64>(next);
+            next += sizeof(u64);
+        }
+        if (length > limit - next) {
+            break;
+        }
+        p = next + length;
+    }
+    return p - ehFrameStart;
+}
+
 } // namespace Dwarf
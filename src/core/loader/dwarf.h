@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <vector>
 #include "common/types.h"
 
 namespace Dwarf {
@@ -36,6 +37,25 @@ struct EHHeaderInfo {
     u8 table_enc;
 };
 
+/// One entry of the decoded .eh_frame_hdr binary search table: a function's
+/// initial PC mapped to the address of its FDE. Each entry covers the range up
+/// to the next entry's initial PC.
+struct FdeTableEntry {
+    uintptr_t pc_begin;
+    uintptr_t fde_addr;
+};
+
 bool DecodeEHHdr(uintptr_t ehHdrStart, uintptr_t ehHdrEnd, EHHeaderInfo& ehHdrInfo);
 
+/// Decodes the binary search table that follows a parsed EH frame header into
+/// a vector sorted by initial PC. Returns false if the table is absent or uses
+/// an encoding that cannot be decoded.
+bool DecodeFdeTable(const EHHeaderInfo& ehHdrInfo, uintptr_t ehHdrStart, uintptr_t ehHdrEnd,
+                    std::vector<FdeTableEntry>& table);
+
+/// Walks the length-prefixed CIE/FDE records starting at ehFrameStart and
+/// returns the size of the .eh_frame section up to its terminator record,
+/// never reading past limit. Returns 0 if no complete record was found.
+size_t MeasureEhFrame(uintptr_t ehFrameStart, uintptr_t limit);
+
 } // namespace Dwarf
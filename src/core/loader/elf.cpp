@@ -1,11 +1,19 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <cstring>
 #include <fmt/core.h>
+#include "common/alignment.h"
 #include "common/assert.h"
+#include "common/error.h"
 #include "common/logging/log.h"
 #include "core/loader/elf.h"
 
+#ifndef _WIN64
+#include <sys/mman.h>
+#endif
+
 namespace Core::Loader {
 
 using namespace Common::FS;
@@ -180,30 +188,56 @@ Elf::~Elf() = default;
 
 void Elf::Open(const std::filesystem::path& file_name) {
     m_f.Open(file_name, FileAccessMode::Read);
-    if (!m_f.ReadObject(m_self)) {
+    if (!m_f.IsOpen()) {
+        LOG_ERROR(Loader, "Unable to open {}", file_name.string());
+        return;
+    }
+
+    // All headers live at the start of the file, so slurp that region with a
+    // single read instead of a seek/read pair per table. This runs for every
+    // system module on boot, where the per-call IO overhead used to add up.
+    static constexpr u64 MaxHeaderBlock = 0x10000;
+    std::vector<u8> header_block(std::min<u64>(m_f.GetSize(), MaxHeaderBlock));
+    header_block.resize(m_f.ReadRaw<u8>(header_block.data(), header_block.size()));
+
+    const auto copy_from = [&header_block](void* dst, u64 offset, u64 size) {
+        if (offset + size > header_block.size()) {
+            return false;
+        }
+        std::memcpy(dst, header_block.data() + offset, size);
+        return true;
+    };
+
+    if (!copy_from(&m_self, 0, sizeof(m_self))) {
         LOG_ERROR(Loader, "Unable to read self header!");
         return;
     }
 
-    if (is_self = IsSelfFile(); !is_self) {
-        m_f.Seek(0, SeekOrigin::SetOrigin);
-    } else {
+    u64 elf_header_pos = 0;
+    if (is_self = IsSelfFile(); is_self) {
         m_self_segments.resize(m_self.segment_count);
-        m_f.Read(m_self_segments);
+        if (!copy_from(m_self_segments.data(), sizeof(self_header),
+                       m_self_segments.size() * sizeof(self_segment_header))) {
+            return;
+        }
+        elf_header_pos = sizeof(self_header) + m_self_segments.size() * sizeof(self_segment_header);
     }
 
-    const u64 elf_header_pos = m_f.Tell();
-    m_f.Read(m_elf_header);
-    if (!IsElfFile()) {
+    if (!copy_from(&m_elf_header, elf_header_pos, sizeof(m_elf_header)) || !IsElfFile()) {
         return;
     }
 
-    const auto load_headers = [this]<typename T>(std::vector<T>& out, u64 offset, u16 num) {
+    const auto load_headers = [&]<typename T>(std::vector<T>& out, u64 offset, u16 num) {
         if (!num) {
             return;
         }
 
         out.resize(num);
+        if (copy_from(out.data(), offset, num * sizeof(T))) {
+            return;
+        }
+        // Table sits past the slurped block (section headers of plain ELFs
+        // can live at the end of the file); fall back to a targeted read.
         m_f.Seek(offset, SeekOrigin::SetOrigin);
         m_f.Read(out);
     };
@@ -222,10 +256,15 @@ void Elf::Open(const std::filesystem::path& file_name) {
         header_size &= ~15; // Align
 
         if (m_elf_header.e_ehsize - header_size >= sizeof(elf_program_id_header)) {
-            m_f.Seek(header_size, SeekOrigin::SetOrigin);
-            m_f.ReadObject(m_self_id_header);
+            if (!copy_from(&m_self_id_header, header_size, sizeof(m_self_id_header))) {
+                m_f.Seek(header_size, SeekOrigin::SetOrigin);
+                m_f.ReadObject(m_self_id_header);
+            }
         }
     }
+
+    // Leave m_f open and positioned for the segment loader.
+    m_f.Seek(0, SeekOrigin::SetOrigin);
 }
 
 bool Elf::IsSelfFile() const {
@@ -462,6 +501,46 @@ std::string Elf::ElfPHeaderStr(u16 no) {
     return header;
 }
 
+bool Elf::MapSegment(u64 virtual_addr, u64 file_offset, u64 size) {
+#ifndef _WIN64
+    if (is_self) {
+        // SELF segments are decrypted while loading, there is no plain file data to map.
+        return false;
+    }
+
+    static constexpr u64 PageSize = 0x1000;
+    if ((virtual_addr & (PageSize - 1)) != 0 || (file_offset & (PageSize - 1)) != 0) {
+        return false;
+    }
+
+    // Only whole pages can come from the file. Everything past p_filesz must stay zero,
+    // so the last partial page is read through the regular path and the remainder keeps
+    // the zero pages of the initial module mapping.
+    const u64 map_size = Common::AlignDown(size, PageSize);
+    if (map_size == 0) {
+        return false;
+    }
+
+    // Copy-on-write mapping; relocations and TLS patches only dirty the pages they touch.
+    const int fd = static_cast<int>(m_f.GetFileMapping());
+    void* ret = mmap(reinterpret_cast<void*>(virtual_addr), map_size,
+                     PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_FIXED, fd, file_offset);
+    if (ret == MAP_FAILED) {
+        LOG_WARNING(Loader, "Unable to map segment: {}", Common::GetLastErrorMsg());
+        return false;
+    }
+
+    if (size > map_size) {
+        m_f.Seek(file_offset + map_size, SeekOrigin::SetOrigin);
+        m_f.ReadRaw<u8>(reinterpret_cast<u8*>(virtual_addr + map_size), size - map_size);
+    }
+    return true;
+#else
+    // The module region is not a placeholder anymore, so it cannot host file views.
+    return false;
+#endif
+}
+
 void Elf::LoadSegment(u64 virtual_addr, u64 file_offset, u64 size) {
     if (!is_self) {
         // It's elf file
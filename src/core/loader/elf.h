@@ -500,6 +500,7 @@ public:
     std::string_view ElfPheaderTypeStr(u32 type);
     std::string ElfPheaderFlagsStr(u32 flags);
 
+    bool MapSegment(u64 virtual_addr, u64 file_offset, u64 size);
     void LoadSegment(u64 virtual_addr, u64 file_offset, u64 size);
     bool IsSharedLib();
     void ElfHeaderDebugDump(const std::filesystem::path& file_name);
@@ -7,6 +7,7 @@
 #include <span>
 #include <string>
 #include <vector>
+#include <tsl/robin_map.h>
 #include "common/types.h"
 
 namespace Core::Loader {
@@ -73,6 +74,7 @@ public:
 
 private:
     std::vector<SymbolRecord> m_symbols;
+    tsl::robin_map<std::string, size_t> m_name_index;
 };
 
 } // namespace Core::Loader
@@ -15,11 +15,13 @@ namespace Core {
 MemoryManager::MemoryManager() {
     // Insert an area that covers direct memory physical block.
     dmem_map.emplace(0, DirectMemoryArea{0, SCE_KERNEL_MAIN_DMEM_SIZE});
+    InsertDmemFree(0, SCE_KERNEL_MAIN_DMEM_SIZE);
 
     // Insert a virtual memory area that covers the entire area we manage.
     const VAddr virtual_base = impl.VirtualBase();
     const size_t virtual_size = impl.VirtualSize();
     vma_map.emplace(virtual_base, VirtualMemoryArea{virtual_base, virtual_size});
+    vma_free_list.emplace(virtual_base, virtual_size);
 
     // Log initialization.
     LOG_INFO(Kernel_Vmm, "Usable memory address space {}_GB", virtual_size >> 30);
@@ -31,19 +33,29 @@ PAddr MemoryManager::Allocate(PAddr search_start, PAddr search_end, size_t size,
                               int memory_type) {
     std::scoped_lock lk{mutex};
 
-    auto dmem_area = FindDmemArea(search_start);
-
-    const auto is_suitable = [&] {
-        return dmem_area->second.is_free && dmem_area->second.size >= size;
-    };
-    while (!is_suitable() && dmem_area->second.GetEnd() <= search_end) {
-        dmem_area++;
+    // Best-fit: start from the smallest free area that could satisfy the
+    // request so large areas are preserved for large allocations. Usually the
+    // first candidate fits; later ones are only visited when the search range
+    // or alignment disqualify it.
+    bool found = false;
+    PAddr free_addr = 0;
+    for (auto candidate = dmem_free_by_size.lower_bound(std::make_pair(size, PAddr{0}));
+         candidate != dmem_free_by_size.end(); ++candidate) {
+        const auto [area_size, area_base] = *candidate;
+        PAddr addr = std::max<PAddr>(area_base, search_start);
+        addr = alignment > 0 ? Common::AlignUp(addr, alignment) : addr;
+        if (addr + size <= area_base + area_size && addr + size <= search_end) {
+            free_addr = addr;
+            found = true;
+            break;
+        }
     }
-    ASSERT_MSG(is_suitable(), "Unable to find free direct memory area");
-
-    // Align free position
-    PAddr free_addr = dmem_area->second.base;
-    free_addr = alignment > 0 ? Common::AlignUp(free_addr, alignment) : free_addr;
+    ASSERT_MSG(found,
+               "Unable to find free direct memory area: size={:#x} free_total={:#x} "
+               "free_largest={:#x} free_blocks={}",
+               size, dmem_free_total,
+               dmem_free_by_size.empty() ? 0 : dmem_free_by_size.rbegin()->first,
+               dmem_free_list.size());
 
     // Add the allocated region to the list and commit its pages.
     auto& area = AddDmemAllocation(free_addr, size);
@@ -59,28 +71,44 @@ void MemoryManager::Free(PAddr phys_addr, size_t size) {
     ASSERT(dmem_area != dmem_map.end() && dmem_area->second.base == phys_addr &&
            dmem_area->second.size == size);
 
-    // Release any dmem mappings that reference this physical block.
-    std::vector<std::pair<VAddr, u64>> remove_list;
-    for (const auto& [addr, mapping] : vma_map) {
-        if (mapping.type != VMAType::Direct) {
-            continue;
-        }
-        if (mapping.phys_base <= phys_addr && phys_addr < mapping.phys_base + mapping.size) {
+    // Release any dmem mappings that reference this physical block. The interval
+    // map gives them directly instead of walking every virtual mapping.
+    if (const auto mapping_it = direct_mappings.find(phys_addr);
+        mapping_it != direct_mappings.end()) {
+        // Copy the bases as unmapping mutates the interval map.
+        const std::set<VAddr> mapped_bases = mapping_it->second;
+        for (const VAddr addr : mapped_bases) {
+            const auto& mapping = vma_map.find(addr)->second;
             LOG_INFO(Kernel_Vmm, "Unmaping direct mapping {:#x} with size {:#x}", addr,
                      mapping.size);
-            // Unmaping might erase from vma_map. We can't do it here.
-            remove_list.emplace_back(addr, mapping.size);
+            UnmapMemoryImpl(addr, mapping.size);
         }
     }
-    for (const auto& [addr, size] : remove_list) {
-        UnmapMemory(addr, size);
-    }
 
     // Mark region as free and attempt to coalesce it with neighbours.
     auto& area = dmem_area->second;
     area.is_free = true;
     area.memory_type = 0;
-    MergeAdjacent(dmem_map, dmem_area);
+    const auto merged = MergeAdjacent(dmem_map, dmem_area);
+
+    // Replace any free list entries covered by the merged area with a single one.
+    const PAddr merged_base = merged->second.base;
+    const PAddr merged_end = merged_base + merged->second.size;
+    for (auto it = dmem_free_list.lower_bound(merged_base);
+         it != dmem_free_list.end() && it->first < merged_end;) {
+        const PAddr base = (it++)->first;
+        EraseDmemFree(base);
+    }
+    InsertDmemFree(merged_base, merged->second.size);
+}
+
+MemoryManager::DirectMemoryStats MemoryManager::GetDirectMemoryStats() {
+    std::shared_lock lk{mutex};
+    return DirectMemoryStats{
+        .free_total = dmem_free_total,
+        .free_largest = dmem_free_by_size.empty() ? 0 : dmem_free_by_size.rbegin()->first,
+        .free_blocks = dmem_free_list.size(),
+    };
 }
 
 int MemoryManager::MapMemory(void** out_addr, VAddr virtual_addr, size_t size, MemoryProt prot,
@@ -106,7 +134,9 @@ int MemoryManager::MapMemory(void** out_addr, VAddr virtual_addr, size_t size, M
 
         if (type == VMAType::Direct) {
             new_vma.phys_base = phys_addr;
-            MapVulkanMemory(mapped_addr, size);
+            direct_mappings += std::make_pair(
+                boost::icl::interval<PAddr>::right_open(phys_addr, phys_addr + size),
+                std::set<VAddr>{mapped_addr});
         }
         if (type == VMAType::Flexible) {
             flexible_usage += size;
@@ -128,13 +158,15 @@ int MemoryManager::MapMemory(void** out_addr, VAddr virtual_addr, size_t size, M
         if (it->second.type == VMAType::Free && it->second.Contains(virtual_addr, size)) {
             mapped_addr = virtual_addr;
         } else {
-            // Search for the first free VMA that fits our mapping.
-            while (it->second.type != VMAType::Free || it->second.size < size) {
-                it++;
+            // Search for the first free area that fits our mapping, skipping over
+            // mapped regions entirely.
+            auto free_it = vma_free_list.lower_bound(mapped_addr);
+            while (free_it != vma_free_list.end() && free_it->second < size) {
+                free_it++;
             }
-            ASSERT(it != vma_map.end());
-            const auto& vma = it->second;
-            mapped_addr = alignment > 0 ? Common::AlignUp(vma.base, alignment) : vma.base;
+            ASSERT(free_it != vma_free_list.end());
+            mapped_addr = alignment > 0 ? Common::AlignUp(free_it->first, alignment)
+                                        : free_it->first;
         }
     }
 
@@ -146,19 +178,21 @@ int MemoryManager::MapMemory(void** out_addr, VAddr virtual_addr, size_t size, M
 
 int MemoryManager::MapFile(void** out_addr, VAddr virtual_addr, size_t size, MemoryProt prot,
                            MemoryMapFlags flags, uintptr_t fd, size_t offset) {
+    std::scoped_lock lk{mutex};
+
     ASSERT(virtual_addr == 0);
     virtual_addr = impl.VirtualBase();
     const size_t size_aligned = Common::AlignUp(size, 16_KB);
 
     // Find first free area to map the file.
-    auto it = FindVMA(virtual_addr);
-    while (it->second.type != VMAType::Free || it->second.size < size_aligned) {
-        it++;
+    auto free_it = vma_free_list.lower_bound(virtual_addr);
+    while (free_it != vma_free_list.end() && free_it->second < size_aligned) {
+        free_it++;
     }
-    ASSERT(it != vma_map.end());
+    ASSERT(free_it != vma_free_list.end());
 
     // Map the file.
-    const VAddr mapped_addr = it->second.base;
+    const VAddr mapped_addr = free_it->first;
     impl.MapFile(mapped_addr, size, offset, fd);
 
     // Add virtual memory area
@@ -175,7 +209,10 @@ int MemoryManager::MapFile(void** out_addr, VAddr virtual_addr, size_t size, Mem
 
 void MemoryManager::UnmapMemory(VAddr virtual_addr, size_t size) {
     std::scoped_lock lk{mutex};
+    UnmapMemoryImpl(virtual_addr, size);
+}
 
+void MemoryManager::UnmapMemoryImpl(VAddr virtual_addr, size_t size) {
     // TODO: Partial unmaps are technically supported by the guest.
     const auto it = vma_map.find(virtual_addr);
     ASSERT_MSG(it != vma_map.end() && it->first == virtual_addr,
@@ -184,7 +221,11 @@ void MemoryManager::UnmapMemory(VAddr virtual_addr, size_t size) {
     const auto type = it->second.type;
     const bool has_backing = type == VMAType::Direct || type == VMAType::File;
     if (type == VMAType::Direct) {
-        UnmapVulkanMemory(virtual_addr, size);
+        const PAddr phys_base = it->second.phys_base;
+        direct_mappings.subtract(std::make_pair(
+            boost::icl::interval<PAddr>::right_open(phys_base, phys_base + size),
+            std::set<VAddr>{virtual_addr}));
+        // The unified buffer spans the whole address space; nothing to release.
     }
     if (type == VMAType::Flexible) {
         flexible_usage -= size;
@@ -195,7 +236,13 @@ void MemoryManager::UnmapMemory(VAddr virtual_addr, size_t size) {
     vma.type = VMAType::Free;
     vma.prot = MemoryProt::NoAccess;
     vma.phys_base = 0;
-    MergeAdjacent(vma_map, it);
+    const auto merged = MergeAdjacent(vma_map, it);
+
+    // Replace any free list entries covered by the merged area with a single one.
+    const VAddr merged_base = merged->second.base;
+    vma_free_list.erase(vma_free_list.lower_bound(merged_base),
+                        vma_free_list.lower_bound(merged_base + merged->second.size));
+    vma_free_list.emplace(merged_base, merged->second.size);
 
     // Unmap the memory region.
     impl.Unmap(virtual_addr, size, has_backing);
@@ -203,7 +250,7 @@ void MemoryManager::UnmapMemory(VAddr virtual_addr, size_t size) {
 }
 
 int MemoryManager::QueryProtection(VAddr addr, void** start, void** end, u32* prot) {
-    std::scoped_lock lk{mutex};
+    std::shared_lock lk{mutex};
 
     const auto it = FindVMA(addr);
     const auto& vma = it->second;
@@ -223,7 +270,7 @@ int MemoryManager::QueryProtection(VAddr addr, void** start, void** end, u32* pr
 
 int MemoryManager::VirtualQuery(VAddr addr, int flags,
                                 Libraries::Kernel::OrbisVirtualQueryInfo* info) {
-    std::scoped_lock lk{mutex};
+    std::shared_lock lk{mutex};
 
     auto it = FindVMA(addr);
     if (it->second.type == VMAType::Free && flags == 1) {
@@ -251,7 +298,7 @@ int MemoryManager::VirtualQuery(VAddr addr, int flags,
 
 int MemoryManager::DirectMemoryQuery(PAddr addr, bool find_next,
                                      Libraries::Kernel::OrbisQueryInfo* out_info) {
-    std::scoped_lock lk{mutex};
+    std::shared_lock lk{mutex};
 
     auto dmem_area = FindDmemArea(addr);
     while (dmem_area != dmem_map.end() && dmem_area->second.is_free && find_next) {
@@ -272,17 +319,18 @@ int MemoryManager::DirectMemoryQuery(PAddr addr, bool find_next,
 
 int MemoryManager::DirectQueryAvailable(PAddr search_start, PAddr search_end, size_t alignment,
                                         PAddr* phys_addr_out, size_t* size_out) {
-    std::scoped_lock lk{mutex};
+    std::shared_lock lk{mutex};
 
-    auto dmem_area = FindDmemArea(search_start);
+    // Only free areas can satisfy the query, so walk the free list directly.
+    auto free_area = dmem_free_list.lower_bound(search_start);
     PAddr paddr{};
     size_t max_size{};
-    while (dmem_area != dmem_map.end() && dmem_area->second.GetEnd() <= search_end) {
-        if (dmem_area->second.size > max_size) {
-            paddr = dmem_area->second.base;
-            max_size = dmem_area->second.size;
+    while (free_area != dmem_free_list.end() && free_area->first + free_area->second <= search_end) {
+        if (free_area->second > max_size) {
+            paddr = free_area->first;
+            max_size = free_area->second;
         }
-        dmem_area++;
+        free_area++;
     }
 
     *phys_addr_out = alignment > 0 ? Common::AlignUp(paddr, alignment) : paddr;
@@ -290,11 +338,35 @@ int MemoryManager::DirectQueryAvailable(PAddr search_start, PAddr search_end, si
     return ORBIS_OK;
 }
 
+bool MemoryManager::IsValidRange(VAddr virtual_addr, size_t size) {
+    const VAddr virtual_base = impl.VirtualBase();
+    if (size == 0 || virtual_addr < virtual_base ||
+        virtual_addr + size > virtual_base + impl.VirtualSize()) {
+        return false;
+    }
+
+    std::shared_lock lk{mutex};
+    const VAddr end_addr = virtual_addr + size;
+    auto vma = FindVMA(virtual_addr);
+    while (vma != vma_map.end()) {
+        const VirtualMemoryArea& area = vma->second;
+        if (area.type == VMAType::Free || area.type == VMAType::Reserved ||
+            virtual_addr < area.base) {
+            return false;
+        }
+        if (area.base + area.size >= end_addr) {
+            return true;
+        }
+        virtual_addr = area.base + area.size;
+        ++vma;
+    }
+    return false;
+}
+
 std::pair<vk::Buffer, size_t> MemoryManager::GetVulkanBuffer(VAddr addr) {
-    auto it = mapped_memories.upper_bound(addr);
-    it = std::prev(it);
-    ASSERT(it != mapped_memories.end() && it->first <= addr);
-    return std::make_pair(*it->second.buffer, addr - it->first);
+    EnsureUnifiedBuffer();
+    ASSERT(unified_buffer && addr >= unified_base && addr < unified_base + unified_size);
+    return std::make_pair(*unified_buffer, addr - unified_base);
 }
 
 VirtualMemoryArea& MemoryManager::AddMapping(VAddr virtual_addr, size_t size) {
@@ -318,6 +390,8 @@ VirtualMemoryArea& MemoryManager::AddMapping(VAddr virtual_addr, size_t size) {
         vma_handle = Split(vma_handle, start_in_vma);
     }
 
+    // The region is no longer free.
+    vma_free_list.erase(vma_handle->second.base);
     return vma_handle->second;
 }
 
@@ -342,9 +416,25 @@ DirectMemoryArea& MemoryManager::AddDmemAllocation(PAddr addr, size_t size) {
         dmem_handle = Split(dmem_handle, start_in_area);
     }
 
+    // The region is no longer free.
+    EraseDmemFree(dmem_handle->second.base);
     return dmem_handle->second;
 }
 
+void MemoryManager::InsertDmemFree(PAddr base, size_t size) {
+    dmem_free_list.emplace(base, size);
+    dmem_free_by_size.emplace(size, base);
+    dmem_free_total += size;
+}
+
+void MemoryManager::EraseDmemFree(PAddr base) {
+    const auto it = dmem_free_list.find(base);
+    ASSERT(it != dmem_free_list.end());
+    dmem_free_by_size.erase(std::make_pair(it->second, base));
+    dmem_free_total -= it->second;
+    dmem_free_list.erase(it);
+}
+
 MemoryManager::VMAHandle MemoryManager::Split(VMAHandle vma_handle, size_t offset_in_vma) {
     auto& old_vma = vma_handle->second;
     ASSERT(offset_in_vma < old_vma.size && offset_in_vma > 0);
@@ -357,6 +447,10 @@ MemoryManager::VMAHandle MemoryManager::Split(VMAHandle vma_handle, size_t offse
     if (new_vma.type == VMAType::Direct) {
         new_vma.phys_base += offset_in_vma;
     }
+    if (new_vma.type == VMAType::Free) {
+        vma_free_list[old_vma.base] = old_vma.size;
+        vma_free_list[new_vma.base] = new_vma.size;
+    }
     return vma_map.emplace_hint(std::next(vma_handle), new_vma.base, new_vma);
 }
 
@@ -369,14 +463,24 @@ MemoryManager::DMemHandle MemoryManager::Split(DMemHandle dmem_handle, size_t of
     new_area.base += offset_in_area;
     new_area.size -= offset_in_area;
 
+    if (new_area.is_free) {
+        EraseDmemFree(old_area.base);
+        InsertDmemFree(old_area.base, old_area.size);
+        InsertDmemFree(new_area.base, new_area.size);
+    }
     return dmem_map.emplace_hint(std::next(dmem_handle), new_area.base, new_area);
 };
 
-void MemoryManager::MapVulkanMemory(VAddr addr, size_t size) {
-    return;
+void MemoryManager::EnsureUnifiedBuffer() {
+    if (unified_buffer || instance == nullptr) {
+        return;
+    }
+
     const vk::Device device = instance->GetDevice();
     const auto memory_props = instance->GetPhysicalDevice().getMemoryProperties();
-    void* host_pointer = reinterpret_cast<void*>(addr);
+    unified_base = impl.VirtualBase();
+    unified_size = impl.VirtualSize();
+    void* host_pointer = reinterpret_cast<void*>(unified_base);
     const auto host_mem_props = device.getMemoryHostPointerPropertiesEXT(
         vk::ExternalMemoryHandleTypeFlagBits::eHostAllocationEXT, host_pointer);
     ASSERT(host_mem_props.memoryTypeBits != 0);
@@ -411,44 +515,36 @@ void MemoryManager::MapVulkanMemory(VAddr addr, size_t size) {
 
     const vk::StructureChain alloc_info = {
         vk::MemoryAllocateInfo{
-            .allocationSize = size,
+            .allocationSize = unified_size,
             .memoryTypeIndex = static_cast<uint32_t>(mapped_memory_type),
         },
+        vk::MemoryAllocateFlagsInfo{
+            .flags = vk::MemoryAllocateFlagBits::eDeviceAddress,
+        },
         vk::ImportMemoryHostPointerInfoEXT{
             .handleType = vk::ExternalMemoryHandleTypeFlagBits::eHostAllocationEXT,
             .pHostPointer = host_pointer,
         },
     };
-
-    const auto [it, new_memory] = mapped_memories.try_emplace(addr);
-    ASSERT_MSG(new_memory, "Attempting to remap already mapped vulkan memory");
-
-    auto& memory = it->second;
-    memory.backing = device.allocateMemoryUnique(alloc_info.get());
+    unified_backing = device.allocateMemoryUnique(alloc_info.get());
 
     constexpr vk::BufferUsageFlags MapFlags =
         vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eVertexBuffer |
         vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst |
-        vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eStorageBuffer;
+        vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eStorageBuffer |
+        vk::BufferUsageFlagBits::eShaderDeviceAddress;
 
     const vk::StructureChain buffer_info = {
         vk::BufferCreateInfo{
-            .size = size,
+            .size = unified_size,
             .usage = MapFlags,
             .sharingMode = vk::SharingMode::eExclusive,
         },
         vk::ExternalMemoryBufferCreateInfoKHR{
             .handleTypes = vk::ExternalMemoryHandleTypeFlagBits::eHostAllocationEXT,
         }};
-    memory.buffer = device.createBufferUnique(buffer_info.get());
-    device.bindBufferMemory(*memory.buffer, *memory.backing, 0);
-}
-
-void MemoryManager::UnmapVulkanMemory(VAddr addr, size_t size) {
-    return;
-    const auto it = mapped_memories.find(addr);
-    ASSERT(it != mapped_memories.end() && it->second.buffer_size == size);
-    mapped_memories.erase(it);
+    unified_buffer = device.createBufferUnique(buffer_info.get());
+    device.bindBufferMemory(*unified_buffer, *unified_backing, 0);
 }
 
 } // namespace Core
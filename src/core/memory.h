@@ -4,9 +4,13 @@
 #pragma once
 
 #include <functional>
+#include <map>
 #include <mutex>
+#include <set>
+#include <shared_mutex>
 #include <string_view>
 #include <vector>
+#include <boost/icl/interval_map.hpp>
 #include <boost/icl/split_interval_map.hpp>
 #include "common/enum.h"
 #include "common/singleton.h"
@@ -155,8 +159,22 @@ public:
     int DirectQueryAvailable(PAddr search_start, PAddr search_end, size_t alignment,
                              PAddr* phys_addr_out, size_t* size_out);
 
+    /// Snapshot of direct memory free space, usable as a fragmentation alarm.
+    struct DirectMemoryStats {
+        size_t free_total;
+        size_t free_largest;
+        size_t free_blocks;
+    };
+
+    DirectMemoryStats GetDirectMemoryStats();
+
+    /// Returns the unified guest-memory buffer and the offset of addr inside it.
     std::pair<vk::Buffer, size_t> GetVulkanBuffer(VAddr addr);
 
+    /// Checks that every byte of [virtual_addr, virtual_addr + size) is backed by a
+    /// committed mapping, walking adjacent VMAs when the range spans several.
+    bool IsValidRange(VAddr virtual_addr, size_t size);
+
 private:
     VMAHandle FindVMA(VAddr target) {
         return std::prev(vma_map.upper_bound(target));
@@ -190,28 +208,44 @@ private:
 
     DirectMemoryArea& AddDmemAllocation(PAddr addr, size_t size);
 
+    /// Keep the by-base and by-size free indices and the totals in sync.
+    void InsertDmemFree(PAddr base, size_t size);
+    void EraseDmemFree(PAddr base);
+
     VMAHandle Split(VMAHandle vma_handle, size_t offset_in_vma);
 
     DMemHandle Split(DMemHandle dmem_handle, size_t offset_in_area);
 
-    void MapVulkanMemory(VAddr addr, size_t size);
+    void UnmapMemoryImpl(VAddr virtual_addr, size_t size);
 
-    void UnmapVulkanMemory(VAddr addr, size_t size);
+    /// Imports the whole reserved guest address space as one buffer on first
+    /// use; every range after that resolves by offset arithmetic.
+    void EnsureUnifiedBuffer();
 
 private:
+    // Interval map of physical ranges to the virtual bases of the direct mappings
+    // that reference them, so releasing a direct block does not walk every VMA.
+    using DirectIntervalMap = boost::icl::interval_map<PAddr, std::set<VAddr>>;
+
     AddressSpace impl;
     DMemMap dmem_map;
     VMAMap vma_map;
-    std::recursive_mutex mutex;
+    DirectIntervalMap direct_mappings;
+    std::map<VAddr, size_t> vma_free_list;  ///< Free virtual areas ordered by base.
+    std::map<PAddr, size_t> dmem_free_list; ///< Free direct areas ordered by base.
+    std::set<std::pair<size_t, PAddr>> dmem_free_by_size; ///< Same areas, ordered for best-fit.
+    size_t dmem_free_total = 0;
+    std::shared_mutex mutex;
     size_t total_flexible_size = 448_MB;
     size_t flexible_usage{};
 
-    struct MappedMemory {
-        vk::UniqueBuffer buffer;
-        vk::UniqueDeviceMemory backing;
-        size_t buffer_size;
-    };
-    std::map<VAddr, MappedMemory> mapped_memories;
+    // One host-pointer import and buffer span the entire reserved guest range,
+    // so per-range lookups reduce to address arithmetic and the driver sees a
+    // single allocation no matter how many direct mappings the title makes.
+    vk::UniqueBuffer unified_buffer;
+    vk::UniqueDeviceMemory unified_backing;
+    VAddr unified_base{};
+    size_t unified_size{};
     const Vulkan::Instance* instance{};
 };
 
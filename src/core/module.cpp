@@ -2,6 +2,11 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <xbyak/xbyak.h>
+#ifdef _WIN64
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
 #include "common/alignment.h"
 #include "common/assert.h"
 #include "common/logging/log.h"
@@ -19,6 +24,24 @@ using EntryFunc = PS4_SYSV_ABI int (*)(size_t args, const void* argp, void* para
 static u64 LoadAddress = SYSTEM_RESERVED + CODE_BASE_OFFSET;
 static constexpr u64 CODE_BASE_INCR = 0x010000000u;
 
+/// Kicks off asynchronous readahead of a freshly loaded executable segment, so
+/// the first seconds of gameplay do not fault its pages in cold one miss at a
+/// time. Advisory only; failures are ignored.
+static void PrefetchSegment(VAddr addr, u64 size) {
+    if (size == 0) {
+        return;
+    }
+#ifdef _WIN64
+    WIN32_MEMORY_RANGE_ENTRY range{
+        .VirtualAddress = reinterpret_cast<PVOID>(addr),
+        .NumberOfBytes = size,
+    };
+    PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+    madvise(reinterpret_cast<void*>(addr), size, MADV_WILLNEED);
+#endif
+}
+
 static u64 GetAlignedSize(const elf_program_header& phdr) {
     return (phdr.p_align != 0 ? (phdr.p_memsz + (phdr.p_align - 1)) & ~(phdr.p_align - 1)
                               : phdr.p_memsz);
@@ -100,7 +123,11 @@ void Module::LoadModuleToMemory(u32& max_tls_index) {
     const auto add_segment = [this](const elf_program_header& phdr, bool do_map = true) {
         const VAddr segment_addr = base_virtual_addr + phdr.p_vaddr;
         if (do_map) {
-            elf.LoadSegment(segment_addr, phdr.p_offset, phdr.p_filesz);
+            // Map the segment file pages copy-on-write when possible to avoid the
+            // read and copy pass, otherwise fall back to buffered loading.
+            if (!elf.MapSegment(segment_addr, phdr.p_offset, phdr.p_filesz)) {
+                elf.LoadSegment(segment_addr, phdr.p_offset, phdr.p_filesz);
+            }
         }
         auto& segment = info.segments[info.num_segments++];
         segment.address = segment_addr;
@@ -131,6 +158,7 @@ void Module::LoadModuleToMemory(u32& max_tls_index) {
             add_segment(elf_pheader[i]);
             if (elf_pheader[i].p_flags & PF_EXEC) {
                 PatchTLS(segment_addr, segment_file_size, c);
+                PrefetchSegment(segment_addr, segment_file_size);
             }
             break;
         }
@@ -178,7 +206,16 @@ void Module::LoadModuleToMemory(u32& max_tls_index) {
                 if (eh_frame_hdr_addr > eh_frame_addr) {
                     eh_frame_size = (eh_frame_hdr_addr - eh_frame_addr);
                 } else {
-                    eh_frame_size = (aligned_base_size - eh_frame_hdr_addr);
+                    // No gap to infer the extent from; walk the length-prefixed
+                    // CIE/FDE records to find the real end of .eh_frame.
+                    const size_t measured = Dwarf::MeasureEhFrame(
+                        hdr_info.eh_frame_ptr, base_virtual_addr + aligned_base_size);
+                    eh_frame_size =
+                        measured != 0 ? measured : (aligned_base_size - eh_frame_hdr_addr);
+                }
+                if (Dwarf::DecodeFdeTable(hdr_info, eh_hdr_start, eh_hdr_end, fde_table)) {
+                    LOG_INFO(Core_Linker, "Pre-parsed {} FDE entries from .eh_frame_hdr",
+                             fde_table.size());
                 }
             }
             break;
@@ -3,9 +3,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <string>
 #include <vector>
 #include "common/types.h"
+#include "core/loader/dwarf.h"
 #include "core/loader/elf.h"
 #include "core/loader/symbols_resolver.h"
 
@@ -221,6 +223,22 @@ public:
     const ModuleInfo* FindModule(std::string_view id);
     const LibraryInfo* FindLibrary(std::string_view id);
 
+    /// FDE search table pre-parsed from .eh_frame_hdr at load, sorted by PC.
+    std::span<const Dwarf::FdeTableEntry> GetFdeTable() const noexcept {
+        return fde_table;
+    }
+
+    /// Binary searches the pre-parsed FDE table for the frame covering addr.
+    /// Returns 0 when the module has no unwind entry for the address.
+    uintptr_t FindFde(VAddr addr) const {
+        const auto it =
+            std::ranges::upper_bound(fde_table, addr, {}, &Dwarf::FdeTableEntry::pc_begin);
+        if (it == fde_table.begin()) {
+            return 0;
+        }
+        return std::prev(it)->fde_addr;
+    }
+
 public:
     Core::MemoryManager* memory;
     std::filesystem::path file;
@@ -233,6 +251,7 @@ public:
     VAddr eh_frame_addr{};
     u32 eh_frame_hdr_size{};
     u32 eh_frame_size{};
+    std::vector<Dwarf::FdeTableEntry> fde_table;
     DynamicModuleInfo dynamic_info{};
     std::vector<u8> m_dynamic;
     std::vector<u8> m_dynamic_data;
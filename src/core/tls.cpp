@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <mutex>
 #include <xbyak/xbyak.h>
 #include "common/assert.h"
 #include "common/types.h"
@@ -8,8 +9,6 @@
 
 #ifdef _WIN32
 #include <windows.h>
-#else
-#include <pthread.h>
 #endif
 
 namespace Core {
@@ -63,20 +62,32 @@ static void PatchFsAccess(u8* code, const TLSPattern& tls_pattern, Xbyak::CodeGe
     using namespace Xbyak::util;
     const auto total_size = tls_pattern.pattern_size + tls_pattern.imm_size;
 
+    // TEB layout constants, based on the wine implementation of TlsGetValue
+    // https://github.com/wine-mirror/wine/blob/a27b9551/dlls/kernelbase/thread.c#L719
+    static constexpr u32 TlsSlotsOffset = 0x1480;
+    static constexpr u32 TlsExpansionSlotsOffset = 0x1780;
+    static constexpr u32 TlsMinimumAvailable = 64;
+
+    // When our slot fits the inline TlsSlots array of the TEB, the access can be
+    // rewritten in place: switch the FS prefix to GS and point the displacement at
+    // the slot, which TlsSetValue fills once per thread. The guest load then stays
+    // a single mov with no trampoline.
+    if (slot < TlsMinimumAvailable) {
+        const u32 teb_offset = TlsSlotsOffset + slot * sizeof(LPVOID);
+        code[0] = 0x65; // Replace FS segment override with GS.
+        std::memcpy(code + tls_pattern.pattern_size, &teb_offset, sizeof(teb_offset));
+        return;
+    }
+
     // Replace mov instruction with near jump to the trampoline.
     static constexpr u32 NearJmpSize = 5;
     auto patch = Xbyak::CodeGenerator(total_size, code);
     patch.jmp(c.getCurr(), Xbyak::CodeGenerator::LabelType::T_NEAR);
     patch.nop(total_size - NearJmpSize);
 
-    // Write the trampoline.
-    // The following logic is based on the wine implementation of TlsGetValue
-    // https://github.com/wine-mirror/wine/blob/a27b9551/dlls/kernelbase/thread.c#L719
-    static constexpr u32 TlsSlotsOffset = 0x1480;
-    static constexpr u32 TlsExpansionSlotsOffset = 0x1780;
-    static constexpr u32 TlsMinimumAvailable = 64;
-    const u32 teb_offset = slot < TlsMinimumAvailable ? TlsSlotsOffset : TlsExpansionSlotsOffset;
-    const u32 tls_index = slot < TlsMinimumAvailable ? slot : slot - TlsMinimumAvailable;
+    // Write the trampoline for expansion slots.
+    const u32 teb_offset = TlsExpansionSlotsOffset;
+    const u32 tls_index = slot - TlsMinimumAvailable;
 
     const auto target_reg = Xbyak::Reg64(tls_pattern.target_reg);
     c.mov(target_reg, teb_offset);
@@ -89,47 +100,37 @@ static void PatchFsAccess(u8* code, const TLSPattern& tls_pattern, Xbyak::CodeGe
 
 #else
 
-static pthread_key_t slot = 0;
+// The guest TCB pointer is kept in an initial-exec thread local, so every thread
+// stores it at the same fixed offset from the host FS base. Patched accesses can
+// then load it with a single mov, the same cost as a host TLS access.
+static thread_local Tcb* guest_tcb __attribute__((tls_model("initial-exec"))){};
 
 void SetTcbBase(void* image_address) {
-    ASSERT(pthread_setspecific(slot, image_address) == 0);
+    guest_tcb = reinterpret_cast<Tcb*>(image_address);
 }
 
 Tcb* GetTcbBase() {
-    return reinterpret_cast<Tcb*>(pthread_getspecific(slot));
+    return guest_tcb;
 }
 
-static void AllocTcbKey() {
-    ASSERT(pthread_key_create(&slot, nullptr) == 0);
+static void AllocTcbKey() {}
+
+static u32 TcbFsOffset() {
+    // On x86-64 glibc the first qword of the thread control block is a self pointer,
+    // which gives us the FS base without a syscall.
+    uintptr_t fs_base;
+    asm("mov %%fs:0, %0" : "=r"(fs_base));
+    const s64 offset = static_cast<s64>(reinterpret_cast<uintptr_t>(&guest_tcb) - fs_base);
+    ASSERT_MSG(offset == static_cast<s32>(offset), "TLS offset does not fit in disp32");
+    return static_cast<u32>(offset);
 }
 
 static void PatchFsAccess(u8* code, const TLSPattern& tls_pattern, Xbyak::CodeGenerator& c) {
-    using namespace Xbyak::util;
-    const auto total_size = tls_pattern.pattern_size + tls_pattern.imm_size;
-
-    // Replace mov instruction with near jump to the trampoline.
-    static constexpr u32 NearJmpSize = 5;
-    auto patch = Xbyak::CodeGenerator(total_size, code);
-    patch.jmp(c.getCurr(), Xbyak::CodeGenerator::LabelType::T_NEAR);
-    patch.nop(total_size - NearJmpSize);
-
-    // Write the trampoline.
-    // The following logic is based on the glibc implementation of pthread_getspecific
-    // https://github.com/bminor/glibc/blob/29807a27/nptl/pthread_getspecific.c#L23
-    static constexpr u32 PthreadKeySecondLevelSize = 32;
-    static constexpr u32 PthreadSpecificOffset = 0x510;
-    static constexpr u32 PthreadKeyDataSize = 16;
-    ASSERT(slot >= PthreadKeySecondLevelSize);
-
-    const u32 idx1st = slot / PthreadKeySecondLevelSize;
-    const u32 idx2nd = slot % PthreadKeySecondLevelSize;
-    const auto target_reg = Xbyak::Reg64(tls_pattern.target_reg);
-    c.mov(target_reg, PthreadSpecificOffset);
-    c.putSeg(fs);
-    c.mov(target_reg, qword[target_reg + idx1st * 8]); // Load first level specific array.
-    c.mov(target_reg, qword[target_reg + idx2nd * 16 +
-                            8]); // Load data member of pthread_key_data our slot specifies.
-    c.jmp(code + total_size);    // Return to the instruction right after the mov.
+    // The guest instruction already is mov reg, qword ptr fs:[disp32]; retarget its
+    // displacement at the initial-exec slot holding the guest TCB. No trampoline and
+    // no instruction replacement is needed.
+    const u32 offset = TcbFsOffset();
+    std::memcpy(code + tls_pattern.pattern_size, &offset, sizeof(offset));
 }
 
 #endif
@@ -167,9 +168,8 @@ void PatchTLS(u64 segment_addr, u64 segment_size, Xbyak::CodeGenerator& c) {
             ASSERT(offset == 0);
 
             // Allocate slot in the process if not done already.
-            if (slot == 0) {
-                AllocTcbKey();
-            }
+            static std::once_flag alloc_flag;
+            std::call_once(alloc_flag, AllocTcbKey);
 
             // Replace bogus instruction prefix with nops if it exists.
             if (std::memcmp(code - BadPrefix.size(), BadPrefix.data(), sizeof(BadPrefix)) == 0) {
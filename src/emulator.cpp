@@ -14,7 +14,10 @@
 #include "common/debug.h"
 #include "common/logging/backend.h"
 #include "common/path_util.h"
+#include "common/profiler.h"
 #include "common/singleton.h"
+#include "common/thread.h"
+#include "core/fault_profiler.h"
 #include "core/file_sys/fs.h"
 #include "core/libraries/kernel/thread_management.h"
 #include "core/libraries/libs.h"
@@ -40,6 +43,10 @@ Emulator::Emulator()
     // Start logger.
     Common::Log::Initialize();
     Common::Log::Start();
+
+    // Watch for config edits so performance-relevant settings can be flipped
+    // live during soak tests.
+    Config::startWatcher(config_dir / "config.toml");
 }
 
 Emulator::~Emulator() {
@@ -52,6 +59,13 @@ void Emulator::Run(const std::filesystem::path& file) {
     auto* mnt = Common::Singleton<Core::FileSys::MntPoints>::Instance();
     mnt->Mount(file.parent_path(), "/app0");
 
+    // Installed titles that kept their PFS image get it mounted alongside, so
+    // assets missing from the host directory are read straight from the image.
+    if (const auto pfs_image = file.parent_path() / "pfs_image.dat";
+        std::filesystem::exists(pfs_image)) {
+        mnt->MountImage(pfs_image, "/app0");
+    }
+
     // Loading param.sfo file if exists
     std::string id;
     std::filesystem::path sce_sys_folder = file.parent_path() / "sce_sys";
@@ -69,7 +83,7 @@ void Emulator::Run(const std::filesystem::path& file) {
             } else if (entry.path().filename() == "pic0.png" ||
                        entry.path().filename() == "pic1.png") {
                 auto* splash = Common::Singleton<Splash>::Instance();
-                if (splash->IsLoaded()) {
+                if (splash->IsQueued()) {
                     continue;
                 }
                 if (!splash->Open(entry.path().string())) {
@@ -87,13 +101,27 @@ void Emulator::Run(const std::filesystem::path& file) {
     const auto& mount_temp_dir = Common::FS::GetUserPath(Common::FS::PathType::TempDataDir) / id;
     mnt->Mount(mount_temp_dir, "/temp0"); // called in app_content ==> stat/mkdir
 
-    // Initialize kernel and library facilities.
+    // Initialize kernel facilities first; the HLE registration below relies on
+    // the pthread defaults being in place.
     Libraries::Kernel::init_pthreads();
-    Libraries::InitHLELibs(&linker->GetHLESymbols());
+
+    // HLE registration is independent of the guest module: it only fills the
+    // linker's HLE symbol table and brings up the Vulkan renderer, whose
+    // instance creation and extension probing alone cost a few hundred
+    // milliseconds. Overlap it with ELF parsing and mapping so boot reaches
+    // the first frame sooner. It must complete before LoadSystemModules,
+    // which appends HLE fallbacks to the same symbol table, and long before
+    // relocation resolves against it in Execute().
+    std::jthread hle_init{[this] {
+        Common::SetCurrentThreadName("shadPS4:HLEInit");
+        Libraries::InitHLELibs(&linker->GetHLESymbols());
+    }};
 
     // Load the module with the linker
     linker->LoadModule(file);
 
+    hle_init.join();
+
     // check if we have system modules to load
     LoadSystemModules(file);
 
@@ -126,6 +154,9 @@ void Emulator::Run(const std::filesystem::path& file) {
     // Begin main window loop until the application exits
     static constexpr std::chrono::milliseconds FlipPeriod{16};
 
+    // This thread drives flips and presentation; keep it off efficiency cores.
+    Common::SetCurrentThreadRole(Common::ThreadRole::Present);
+
     while (window.isOpen()) {
         window.waitEvent();
         Libraries::VideoOut::Flip(FlipPeriod);
@@ -133,6 +164,14 @@ void Emulator::Run(const std::filesystem::path& file) {
         FRAME_END;
     }
 
+    // Dump the buffered profiler scopes for offline inspection in chrome://tracing.
+    if (Config::debugDump()) {
+        const auto log_dir = Common::FS::GetUserPath(Common::FS::PathType::LogDir);
+        Common::Singleton<Common::Profiler>::Instance()->SaveTrace(log_dir / "trace.json");
+        // Attribute sampled write-protection faults to guest modules.
+        Common::Singleton<Core::FaultProfiler>::Instance()->Report(linker);
+    }
+
     std::exit(0);
 }
 
@@ -1,22 +1,43 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
 #include "core/libraries/kernel/time_management.h"
 #include "core/libraries/pad/pad.h"
 #include "input/controller.h"
 namespace Input {
 
+static u64 HostClockNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
 GameController::GameController() {
     m_states_num = 0;
     m_last_state = State();
 }
 
 void GameController::ReadState(State* state, bool* isConnected, int* connectedCount) {
-    std::scoped_lock lock{m_mutex};
-
-    *isConnected = m_connected;
-    *connectedCount = m_connected_count;
-    *state = GetLastState();
+    // Wait-free sequence-lock read: retry while the event thread is mid-publish
+    // (odd sequence) or published in between (sequence changed).
+    Snapshot snapshot;
+    u32 seq;
+    do {
+        seq = m_snapshot_seq.load(std::memory_order_acquire);
+        if (seq & 1) {
+            continue;
+        }
+        snapshot = m_snapshot;
+        std::atomic_thread_fence(std::memory_order_acquire);
+    } while (seq != m_snapshot_seq.load(std::memory_order_relaxed));
+
+    *isConnected = snapshot.connected;
+    *connectedCount = snapshot.connected_count;
+    *state = snapshot.state;
+    if (snapshot.host_event_ns != 0) {
+        m_last_polled_event_ns.store(snapshot.host_event_ns, std::memory_order_relaxed);
+    }
 }
 
 int GameController::ReadStates(State* states, int states_num, bool* isConnected,
@@ -47,6 +68,10 @@ int GameController::ReadStates(State* states, int states_num, bool* isConnected,
         }
     }
 
+    if (ret_num != 0 && m_snapshot.host_event_ns != 0) {
+        // Holding m_mutex excludes publishers, so m_snapshot is stable here.
+        m_last_polled_event_ns.store(m_snapshot.host_event_ns, std::memory_order_relaxed);
+    }
     return ret_num;
 }
 
@@ -72,6 +97,62 @@ void GameController::AddState(const State& state) {
     m_last_state = state;
     m_private[index].obtained = false;
     m_states_num++;
+
+    PublishSnapshot();
+}
+
+void GameController::PublishSnapshot() {
+    // Called with m_mutex held, so there is exactly one writer and the odd/even
+    // sequence protocol is enough for readers.
+    m_snapshot_seq.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    m_snapshot.state = m_last_state;
+    m_snapshot.host_event_ns = HostClockNs();
+    m_snapshot.connected = m_connected;
+    m_snapshot.connected_count = m_connected_count;
+    m_snapshot_seq.fetch_add(1, std::memory_order_release);
+}
+
+void GameController::SetVibration(u8 large_motor, u8 small_motor) {
+    u64 state = m_output_state.load(std::memory_order_relaxed);
+    u64 desired;
+    do {
+        desired = (state & ~0xFFFFull) | (u64(small_motor) << 8) | u64(large_motor);
+    } while (!m_output_state.compare_exchange_weak(state, desired, std::memory_order_relaxed));
+    m_output_dirty.store(true, std::memory_order_release);
+}
+
+void GameController::SetLightBar(u8 r, u8 g, u8 b) {
+    u64 state = m_output_state.load(std::memory_order_relaxed);
+    u64 desired;
+    do {
+        desired = (state & 0xFFFFull) | (u64(r) << 16) | (u64(g) << 24) | (u64(b) << 32);
+    } while (!m_output_state.compare_exchange_weak(state, desired, std::memory_order_relaxed));
+    m_output_dirty.store(true, std::memory_order_release);
+}
+
+bool GameController::PollOutput(u8& large_motor, u8& small_motor, u8& r, u8& g, u8& b) {
+    if (!m_output_dirty.exchange(false, std::memory_order_acquire)) {
+        return false;
+    }
+    const u64 state = m_output_state.load(std::memory_order_relaxed);
+    large_motor = static_cast<u8>(state);
+    small_motor = static_cast<u8>(state >> 8);
+    r = static_cast<u8>(state >> 16);
+    g = static_cast<u8>(state >> 24);
+    b = static_cast<u8>(state >> 32);
+    return true;
+}
+
+void GameController::UpdateSensors(const float accel[3], const float gyro[3]) {
+    std::scoped_lock lock{m_mutex};
+    // Sensor refreshes update the resting state in place instead of queueing a
+    // new one; the buffered scePadRead path only cares about button edges.
+    for (int i = 0; i < 3; i++) {
+        m_last_state.accel[i] = accel[i];
+        m_last_state.gyro[i] = gyro[i];
+    }
+    PublishSnapshot();
 }
 
 void GameController::CheckButton(int id, u32 button, bool isPressed) {
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <mutex>
 #include "common/types.h"
 
@@ -23,6 +24,8 @@ struct State {
     u32 buttonsState = 0;
     u64 time = 0;
     int axes[static_cast<int>(Axis::AxisMax)] = {128, 128, 128, 128, 0, 0};
+    float accel[3] = {};
+    float gyro[3] = {};
 };
 
 inline int GetAxis(int min, int max, int value) {
@@ -44,11 +47,42 @@ public:
     void AddState(const State& state);
     void Axis(int id, Input::Axis axis, int value);
 
+    /// Host timestamp (steady clock, ns) of the newest input event the guest has
+    /// polled, or 0 if nothing was polled yet. Consumed by the presenter to
+    /// measure input-to-flip latency.
+    u64 LastPolledEventNs() const {
+        return m_last_polled_event_ns.load(std::memory_order_relaxed);
+    }
+
+    // Guest-facing output state. Writers pack the whole value into one atomic
+    // word so haptics-heavy titles that set vibration per frame per motor stay
+    // wait-free; only the newest value survives until the SDL thread flushes it.
+    void SetVibration(u8 large_motor, u8 small_motor);
+    void SetLightBar(u8 r, u8 g, u8 b);
+
+    /// Returns the coalesced output state, or false when nothing changed since
+    /// the last poll. Called once per event-loop pass by the SDL thread.
+    bool PollOutput(u8& large_motor, u8& small_motor, u8& r, u8& g, u8& b);
+
+    /// Publishes freshly sampled IMU values into the same snapshot the button
+    /// state lives in, so scePadReadState picks both up with one seqlock read.
+    void UpdateSensors(const float accel[3], const float gyro[3]);
+
 private:
     struct StateInternal {
         bool obtained = false;
     };
 
+    /// Everything a state poll returns, packed so a reader touches one cacheline.
+    struct alignas(64) Snapshot {
+        State state{};
+        u64 host_event_ns = 0;
+        int connected_count = 0;
+        bool connected = true;
+    };
+
+    void PublishSnapshot();
+
     std::mutex m_mutex;
     bool m_connected = true;
     State m_last_state;
@@ -57,6 +91,17 @@ private:
     u32 m_first_state = 0;
     std::array<State, MAX_STATES> m_states;
     std::array<StateInternal, MAX_STATES> m_private;
+
+    // Sequence-locked snapshot refreshed by the SDL event thread. Guest polls
+    // (scePadReadState) run per-frame per-port from latency-sensitive loops, so
+    // they read this wait-free instead of contending on m_mutex.
+    Snapshot m_snapshot{};
+    std::atomic<u32> m_snapshot_seq{0};
+    std::atomic<u64> m_last_polled_event_ns{0};
+
+    // Packed large/small motor and light bar values, newest-wins.
+    std::atomic<u64> m_output_state{0};
+    std::atomic<bool> m_output_dirty{false};
 };
 
 } // namespace Input
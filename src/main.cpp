@@ -1,15 +1,52 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
+#include <cstring>
 #include <emulator.h>
 #include <fmt/core.h>
+#include "common/logging/backend.h"
+#include "core/memory.h"
+#include "video_core/amdgpu/liverpool.h"
+#include "video_core/amdgpu/pm4_capture.h"
+
+// Feeds a PM4 capture back through a bare command processor with no rasterizer
+// bound, for reproducing decode and state-processing behavior without the game.
+static int ReplayPm4(const char* path) {
+    Common::Log::Initialize();
+    Common::Log::Start();
+
+    // Reserve the guest address space so fence and EOP writes in the stream
+    // land in valid memory even though no module is loaded.
+    [[maybe_unused]] auto* memory = Core::Memory::Instance();
+
+    AmdGpu::Liverpool liverpool;
+    const auto start = std::chrono::steady_clock::now();
+    if (!AmdGpu::Pm4Capture::Replay(path, liverpool)) {
+        return -1;
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    fmt::print("Replayed {} in {} ms\n", path,
+               std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count());
+    return 0;
+}
 
 int main(int argc, char* argv[]) {
     if (argc == 1) {
-        fmt::print("Usage: {} <elf or eboot.bin path>\n", argv[0]);
+        fmt::print("Usage: {} <elf or eboot.bin path>\n"
+                   "       {} --replay-pm4 <capture file>\n",
+                   argv[0], argv[0]);
         return -1;
     }
 
+    if (std::strcmp(argv[1], "--replay-pm4") == 0) {
+        if (argc < 3) {
+            fmt::print("Usage: {} --replay-pm4 <capture file>\n", argv[0]);
+            return -1;
+        }
+        return ReplayPm4(argv[2]);
+    }
+
     Core::Emulator emulator;
     emulator.Run(argv[1]);
     return 0;
@@ -3,12 +3,76 @@
 
 #include <future>
 #include <thread>
-#include <QProgressDialog>
 #include <QtConcurrent/QtConcurrent>
 #include "game_info.h"
+#include "icon_cache.h"
 
-GameInfoClass::GameInfoClass() = default;
-GameInfoClass::~GameInfoClass() = default;
+namespace {
+
+GameInfo FromIndexEntry(const GameLibraryIndex::Entry& entry) {
+    GameInfo game;
+    game.path = entry.path;
+    game.icon_path = entry.icon_path;
+    game.icon = IconCache::Load(entry.icon_path);
+    game.pic_path = entry.pic_path;
+    game.size = entry.size;
+    game.name = entry.name;
+    game.serial = entry.serial;
+    game.version = entry.version;
+    game.region = entry.region;
+    game.category = entry.category;
+    game.fw = entry.fw;
+    return game;
+}
+
+GameLibraryIndex::Entry ToIndexEntry(const GameInfo& game, u64 sfo_mtime) {
+    return {
+        .sfo_mtime = sfo_mtime,
+        .path = game.path,
+        .icon_path = game.icon_path,
+        .pic_path = game.pic_path,
+        .size = game.size,
+        .name = game.name,
+        .serial = game.serial,
+        .version = game.version,
+        .region = game.region,
+        .category = game.category,
+        .fw = game.fw,
+    };
+}
+
+} // Anonymous namespace
+
+GameInfoClass::GameInfoClass() {
+    connect(&m_scan_watcher, &QFutureWatcher<GameInfo>::resultReadyAt, this, [this](int index) {
+        m_games.push_back(m_scan_watcher.resultAt(index));
+        emit GamesChanged();
+    });
+    connect(&m_scan_watcher, &QFutureWatcher<GameInfo>::finished, this, [this]() {
+        // Folder sizes of indexed titles are reused; only rescanned games walk the tree.
+        m_size_watcher.setFuture(QtConcurrent::map(m_games, [](GameInfo& game) {
+            if (game.size.empty()) {
+                GameListUtils::GetFolderSize(game);
+            }
+        }));
+    });
+    connect(&m_size_watcher, &QFutureWatcher<void>::finished, this, [this]() {
+        std::sort(m_games.begin(), m_games.end(), CompareStrings);
+        for (const GameInfo& game : m_games) {
+            m_index.Update(ToIndexEntry(game, GameLibraryIndex::SfoMtime(game.path)));
+        }
+        m_index.Save();
+        emit GamesChanged();
+        emit ScanFinished();
+    });
+}
+
+GameInfoClass::~GameInfoClass() {
+    m_scan_watcher.cancel();
+    m_size_watcher.cancel();
+    m_scan_watcher.waitForFinished();
+    m_size_watcher.waitForFinished();
+}
 
 void GameInfoClass::GetGameInfo(QWidget* parent) {
     QString installDir = QString::fromStdString(Config::getGameInstallDir());
@@ -20,26 +84,19 @@ void GameInfoClass::GetGameInfo(QWidget* parent) {
             filePaths.append(fileInfo.absoluteFilePath());
         }
     }
-    m_games = QtConcurrent::mapped(filePaths, [&](const QString& path) {
-                  return readGameInfo(path.toStdString());
-              }).results();
-
-    // Progress bar, please be patient :)
-    QProgressDialog dialog("Loading game list, please wait :3", "Cancel", 0, 0, parent);
-    dialog.setWindowTitle("Loading...");
-
-    QFutureWatcher<void> futureWatcher;
-    GameListUtils game_util;
-    bool finished = false;
-    futureWatcher.setFuture(QtConcurrent::map(m_games, game_util.GetFolderSize));
-    connect(&futureWatcher, &QFutureWatcher<void>::finished, [&]() {
-        dialog.reset();
-        std::sort(m_games.begin(), m_games.end(), CompareStrings);
-    });
-    connect(&dialog, &QProgressDialog::canceled, &futureWatcher, &QFutureWatcher<void>::cancel);
-    dialog.setRange(0, m_games.size());
-    connect(&futureWatcher, &QFutureWatcher<void>::progressValueChanged, &dialog,
-            &QProgressDialog::setValue);
 
-    dialog.exec();
+    // Titles whose param.sfo is unchanged since the previous scan are served
+    // from the library index instead of re-parsing every directory. The scan
+    // runs across the global thread pool and streams results in through
+    // m_scan_watcher, so the caller stays interactive while it completes.
+    m_games.clear();
+    m_index.Load();
+    m_scan_watcher.setFuture(QtConcurrent::mapped(filePaths, [this](const QString& path) {
+        const std::string dir = path.toStdString();
+        const u64 sfo_mtime = GameLibraryIndex::SfoMtime(dir);
+        if (const auto* entry = m_index.Find(dir, sfo_mtime)) {
+            return FromIndexEntry(*entry);
+        }
+        return readGameInfo(dir);
+    }));
 }
\ No newline at end of file
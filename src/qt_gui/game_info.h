@@ -4,18 +4,28 @@
 #pragma once
 
 #include <QFuture>
+#include <QFutureWatcher>
 #include <QObject>
 #include <QPixmap>
 #include <QtConcurrent/QtConcurrent>
 #include "common/config.h"
 #include "core/file_format/psf.h"
+#include "game_library_index.h"
 #include "game_list_utils.h"
+#include "icon_cache.h"
 
 class GameInfoClass : public QObject {
     Q_OBJECT
 public:
     GameInfoClass();
     ~GameInfoClass();
+
+    /**
+     * Starts an asynchronous library scan. Directory parsing, icon decoding
+     * and folder-size computation run on the global thread pool; GamesChanged
+     * fires as titles stream into m_games and ScanFinished once the sorted
+     * list is complete.
+     */
     void GetGameInfo(QWidget* parent = nullptr);
     QVector<GameInfo> m_games;
 
@@ -30,8 +40,7 @@ public:
         PSF psf;
         if (psf.open(game.path + "/sce_sys/param.sfo", {})) {
             game.icon_path = game.path + "/sce_sys/icon0.png";
-            QString iconpath = QString::fromStdString(game.icon_path);
-            game.icon = QImage(iconpath);
+            game.icon = IconCache::Load(game.icon_path);
             game.pic_path = game.path + "/sce_sys/pic1.png";
             game.name = psf.GetString("TITLE");
             game.serial = psf.GetString("TITLE_ID");
@@ -46,4 +55,13 @@ public:
         }
         return game;
     }
+
+signals:
+    void GamesChanged();
+    void ScanFinished();
+
+private:
+    QFutureWatcher<GameInfo> m_scan_watcher;
+    QFutureWatcher<void> m_size_watcher;
+    GameLibraryIndex m_index;
 };
\ No newline at end of file
@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "common/io_file.h"
+#include "common/logging/log.h"
+#include "common/path_util.h"
+#include "game_library_index.h"
+
+namespace {
+
+struct IndexHeader {
+    u32 magic;
+    u32 version;
+    u32 num_entries;
+};
+constexpr u32 IndexMagic = 0x58494C47; // 'GLIX'
+constexpr u32 IndexVersion = 1;
+
+} // Anonymous namespace
+
+u64 GameLibraryIndex::SfoMtime(const std::string& game_path) {
+    std::error_code ec{};
+    const auto mtime =
+        std::filesystem::last_write_time(game_path + "/sce_sys/param.sfo", ec);
+    if (ec) {
+        return 0;
+    }
+    return static_cast<u64>(mtime.time_since_epoch().count());
+}
+
+void GameLibraryIndex::Load() {
+    using namespace Common::FS;
+    index_file = GetUserPath(PathType::UserDir) / "library_index.bin";
+    if (!std::filesystem::exists(index_file)) {
+        return;
+    }
+
+    const IOFile file{index_file, FileAccessMode::Read};
+    IndexHeader header{};
+    if (!file.ReadObject(header) || header.magic != IndexMagic ||
+        header.version != IndexVersion) {
+        LOG_INFO(Loader, "Discarding game library index with incompatible layout");
+        return;
+    }
+
+    const auto read_string = [&file](std::string& out) {
+        u32 length{};
+        if (!file.ReadObject(length)) {
+            return false;
+        }
+        out = file.ReadString(length);
+        return out.size() == length;
+    };
+    for (u32 i = 0; i < header.num_entries; i++) {
+        Entry entry{};
+        bool ok = file.ReadObject(entry.sfo_mtime);
+        for (auto* field : {&entry.path, &entry.icon_path, &entry.pic_path, &entry.size,
+                            &entry.name, &entry.serial, &entry.version, &entry.region,
+                            &entry.category, &entry.fw}) {
+            ok = ok && read_string(*field);
+        }
+        if (!ok) {
+            LOG_WARNING(Loader, "Game library index truncated after {} entries", i);
+            entries.clear();
+            return;
+        }
+        entries.emplace(entry.path, std::move(entry));
+    }
+}
+
+void GameLibraryIndex::Save() {
+    if (!dirty) {
+        return;
+    }
+    using namespace Common::FS;
+    const IOFile file{index_file, FileAccessMode::Write};
+    const IndexHeader header{
+        .magic = IndexMagic,
+        .version = IndexVersion,
+        .num_entries = static_cast<u32>(entries.size()),
+    };
+    file.WriteObject(header);
+    const auto write_string = [&file](const std::string& str) {
+        file.WriteObject(static_cast<u32>(str.size()));
+        file.WriteString(str);
+    };
+    for (const auto& [path, entry] : entries) {
+        file.WriteObject(entry.sfo_mtime);
+        for (const auto* field : {&entry.path, &entry.icon_path, &entry.pic_path, &entry.size,
+                                  &entry.name, &entry.serial, &entry.version, &entry.region,
+                                  &entry.category, &entry.fw}) {
+            write_string(*field);
+        }
+    }
+    dirty = false;
+}
+
+const GameLibraryIndex::Entry* GameLibraryIndex::Find(const std::string& path,
+                                                      u64 sfo_mtime) const {
+    const auto it = entries.find(path);
+    if (it == entries.end() || sfo_mtime == 0 || it->second.sfo_mtime != sfo_mtime) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+void GameLibraryIndex::Update(Entry entry) {
+    const auto it = entries.find(entry.path);
+    if (it != entries.end() && it->second.sfo_mtime == entry.sfo_mtime &&
+        it->second.size == entry.size) {
+        return;
+    }
+    dirty = true;
+    entries.insert_or_assign(entry.path, std::move(entry));
+}
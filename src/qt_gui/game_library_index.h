@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include "common/types.h"
+
+/**
+ * Persistent cache of parsed param.sfo metadata for the game library. Entries
+ * are validated against the modification time of each title's param.sfo, so a
+ * library scan only parses the directories that actually changed since the
+ * previous run.
+ */
+class GameLibraryIndex {
+public:
+    struct Entry {
+        u64 sfo_mtime;
+        std::string path;
+        std::string icon_path;
+        std::string pic_path;
+        std::string size;
+        std::string name;
+        std::string serial;
+        std::string version;
+        std::string region;
+        std::string category;
+        std::string fw;
+    };
+
+    /// Returns the modification time of a title's param.sfo, or 0 when absent.
+    static u64 SfoMtime(const std::string& game_path);
+
+    /// Reads the whole index file into memory with a single IO request.
+    void Load();
+
+    /// Writes the index back to disk when any entry changed since Load().
+    void Save();
+
+    /// Returns the cached entry for the path when its param.sfo is unchanged.
+    const Entry* Find(const std::string& path, u64 sfo_mtime) const;
+
+    /// Inserts or refreshes the entry for a title.
+    void Update(Entry entry);
+
+private:
+    std::unordered_map<std::string, Entry> entries;
+    std::filesystem::path index_file;
+    bool dirty{};
+};
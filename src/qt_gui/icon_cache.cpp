@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <filesystem>
+#include <fmt/format.h>
+#include <xxhash.h>
+#include "common/path_util.h"
+#include "common/types.h"
+#include "icon_cache.h"
+
+namespace {
+
+std::filesystem::path CacheDir() {
+    using namespace Common::FS;
+    return GetUserPath(PathType::UserDir) / "icon_cache";
+}
+
+u64 IconMtime(const std::string& path) {
+    std::error_code ec{};
+    const auto mtime = std::filesystem::last_write_time(path, ec);
+    return ec ? 0 : static_cast<u64>(mtime.time_since_epoch().count());
+}
+
+} // Anonymous namespace
+
+QImage IconCache::Load(const std::string& icon_path) {
+    const u64 mtime = IconMtime(icon_path);
+    if (mtime == 0) {
+        // Source is missing or unreadable; fall back to a direct load attempt.
+        return QImage(QString::fromStdString(icon_path));
+    }
+
+    const auto dir = CacheDir();
+    const u64 path_hash = XXH3_64bits(icon_path.data(), icon_path.size());
+    const std::string stem = fmt::format("{:016x}", path_hash);
+    const auto cache_file = dir / fmt::format("{}_{:x}.png", stem, mtime);
+
+    QImage icon;
+    if (icon.load(QString::fromStdString(cache_file.string()))) {
+        return icon;
+    }
+
+    icon = QImage(QString::fromStdString(icon_path));
+    if (icon.isNull()) {
+        return icon;
+    }
+    if (icon.width() > CachedIconSize || icon.height() > CachedIconSize) {
+        icon = icon.scaled(CachedIconSize, CachedIconSize, Qt::KeepAspectRatio,
+                           Qt::SmoothTransformation);
+    }
+
+    std::error_code ec{};
+    std::filesystem::create_directories(dir, ec);
+    // Drop entries for older revisions of the same source before writing the
+    // fresh one, so the cache does not accumulate one file per modification.
+    for (const auto& existing : std::filesystem::directory_iterator{dir, ec}) {
+        if (existing.path().filename().string().starts_with(stem)) {
+            std::filesystem::remove(existing.path(), ec);
+        }
+    }
+    icon.save(QString::fromStdString(cache_file.string()));
+    return icon;
+}
@@ -0,0 +1,23 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <QImage>
+
+/**
+ * Disk cache of pre-decoded, pre-scaled title icons. Decoding every icon0.png
+ * at full size dominates library scan time on large installs, so icons are
+ * stored pre-scaled in the user directory, keyed by source path and
+ * modification time. Stale entries are replaced when the source changes.
+ */
+class IconCache {
+public:
+    /// Icons are cached at this edge length; the UI only ever scales down from it.
+    static constexpr int CachedIconSize = 256;
+
+    /// Returns the icon for the source path, served from the cache when fresh
+    /// and decoded, scaled and cached otherwise.
+    static QImage Load(const std::string& icon_path);
+};
@@ -48,10 +48,9 @@ bool MainWindow::Init() {
     auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
     statusBar.reset(new QStatusBar);
     this->setStatusBar(statusBar.data());
-    // Update status bar
-    int numGames = m_game_info->m_games.size();
-    QString statusMessage = "Games: " + QString::number(numGames) + " (" +
-                            QString::number(duration.count()) + "ms). Ready.";
+    // Update status bar; the game count follows once the scan finishes.
+    QString statusMessage =
+        "Window ready in " + QString::number(duration.count()) + "ms. Loading games...";
     statusBar->showMessage(statusMessage);
     return true;
 }
@@ -147,13 +146,21 @@ void MainWindow::CreateDockWindows() {
 }
 
 void MainWindow::LoadGameLists() {
+    // Repopulate the visible frame as scan results stream in.
+    connect(m_game_info.get(), &GameInfoClass::GamesChanged, this, [this]() {
+        if (isTableList) {
+            m_game_list_frame->PopulateGameList();
+        } else {
+            m_game_grid_frame->PopulateGameGrid(m_game_info->m_games, false);
+        }
+    });
+    connect(m_game_info.get(), &GameInfoClass::ScanFinished, this, [this]() {
+        QString statusMessage =
+            "Games: " + QString::number(m_game_info->m_games.size()) + ". Ready.";
+        statusBar->showMessage(statusMessage);
+    });
     // Get game info from game folders.
     m_game_info->GetGameInfo(this);
-    if (isTableList) {
-        m_game_list_frame->PopulateGameList();
-    } else {
-        m_game_grid_frame->PopulateGameGrid(m_game_info->m_games, false);
-    }
 }
 
 void MainWindow::CreateConnects() {
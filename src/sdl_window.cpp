@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <SDL3/SDL_events.h>
+#include <SDL3/SDL_gamepad.h>
 #include <SDL3/SDL_init.h>
 #include <SDL3/SDL_properties.h>
 #include <SDL3/SDL_video.h>
@@ -20,6 +21,7 @@ WindowSDL::WindowSDL(s32 width_, s32 height_, Input::GameController* controller_
         UNREACHABLE_MSG("Failed to initialize SDL video subsystem: {}", SDL_GetError());
     }
     SDL_InitSubSystem(SDL_INIT_AUDIO);
+    SDL_InitSubSystem(SDL_INIT_GAMEPAD);
 
     const std::string title = "shadPS4 v" + std::string(Common::VERSION);
     SDL_PropertiesID props = SDL_CreateProperties();
@@ -58,41 +60,112 @@ WindowSDL::WindowSDL(s32 width_, s32 height_, Input::GameController* controller_
 #endif
 }
 
-WindowSDL::~WindowSDL() = default;
+WindowSDL::~WindowSDL() {
+    if (gamepad) {
+        SDL_CloseGamepad(gamepad);
+    }
+}
 
 void WindowSDL::waitEvent() {
-    // Called on main thread
+    // Called on main thread; SDL requires event pumping on the thread that
+    // initialized the video subsystem, so presentation shares it. Drain the
+    // whole queue every pass - handling one event per frame let UI bursts
+    // (live resize, focus churn) backlog at a frame apiece and starve input.
     SDL_Event event;
+    bool resized = false;
 
-    if (!SDL_PollEvent(&event)) {
-        return;
+    updateGamepad();
+
+    while (SDL_PollEvent(&event)) {
+        switch (event.type) {
+        case SDL_EVENT_WINDOW_RESIZED:
+        case SDL_EVENT_WINDOW_MAXIMIZED:
+        case SDL_EVENT_WINDOW_RESTORED:
+            resized = true;
+            break;
+        case SDL_EVENT_WINDOW_MINIMIZED:
+        case SDL_EVENT_WINDOW_EXPOSED:
+            is_shown = event.type == SDL_EVENT_WINDOW_EXPOSED;
+            resized = true;
+            break;
+        case SDL_EVENT_KEY_DOWN:
+        case SDL_EVENT_KEY_UP:
+            onKeyPress(&event);
+            break;
+        case SDL_EVENT_GAMEPAD_ADDED:
+        case SDL_EVENT_GAMEPAD_REMOVED:
+            onGamepadEvent(&event);
+            break;
+        case SDL_EVENT_QUIT:
+            is_open = false;
+            break;
+        default:
+            break;
+        }
     }
 
-    switch (event.type) {
-    case SDL_EVENT_WINDOW_RESIZED:
-    case SDL_EVENT_WINDOW_MAXIMIZED:
-    case SDL_EVENT_WINDOW_RESTORED:
-        onResize();
-        break;
-    case SDL_EVENT_WINDOW_MINIMIZED:
-    case SDL_EVENT_WINDOW_EXPOSED:
-        is_shown = event.type == SDL_EVENT_WINDOW_EXPOSED;
+    // A live resize delivers a stream of size events; querying the window once
+    // after the drain is enough.
+    if (resized) {
         onResize();
+    }
+}
+
+void WindowSDL::setTitle(const std::string& title) {
+    SDL_SetWindowTitle(window, title.c_str());
+}
+
+void WindowSDL::onResize() {
+    SDL_GetWindowSizeInPixels(window, &width, &height);
+}
+
+void WindowSDL::onGamepadEvent(const SDL_Event* event) {
+    switch (event->type) {
+    case SDL_EVENT_GAMEPAD_ADDED:
+        if (!gamepad) {
+            gamepad = SDL_OpenGamepad(event->gdevice.which);
+            if (gamepad) {
+                gamepad_sensors =
+                    SDL_SetGamepadSensorEnabled(gamepad, SDL_SENSOR_ACCEL, SDL_TRUE) == 0 &&
+                    SDL_SetGamepadSensorEnabled(gamepad, SDL_SENSOR_GYRO, SDL_TRUE) == 0;
+            }
+        }
         break;
-    case SDL_EVENT_KEY_DOWN:
-    case SDL_EVENT_KEY_UP:
-        onKeyPress(&event);
-        break;
-    case SDL_EVENT_QUIT:
-        is_open = false;
+    case SDL_EVENT_GAMEPAD_REMOVED:
+        if (gamepad && event->gdevice.which == SDL_GetGamepadID(gamepad)) {
+            SDL_CloseGamepad(gamepad);
+            gamepad = nullptr;
+            gamepad_sensors = false;
+        }
         break;
     default:
         break;
     }
 }
 
-void WindowSDL::onResize() {
-    SDL_GetWindowSizeInPixels(window, &width, &height);
+void WindowSDL::updateGamepad() {
+    if (!gamepad) {
+        return;
+    }
+    // Only the newest batched value reaches the device; intermediate guest
+    // writes within a frame were already coalesced on the controller side.
+    u8 large, small, r, g, b;
+    if (controller->PollOutput(large, small, r, g, b)) {
+        SDL_RumbleGamepad(gamepad, large * 257, small * 257, 1000);
+        SDL_SetGamepadLED(gamepad, r, g, b);
+    }
+    if (gamepad_sensors) {
+        float accel[3]{};
+        float gyro[3]{};
+        if (SDL_GetGamepadSensorData(gamepad, SDL_SENSOR_ACCEL, accel, 3) == 0 &&
+            SDL_GetGamepadSensorData(gamepad, SDL_SENSOR_GYRO, gyro, 3) == 0) {
+            // SDL reports acceleration in m/s^2; the guest expects g units.
+            for (float& v : accel) {
+                v /= SDL_STANDARD_GRAVITY;
+            }
+            controller->UpdateSensors(accel, gyro);
+        }
+    }
 }
 
 void WindowSDL::onKeyPress(const SDL_Event* event) {
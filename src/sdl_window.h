@@ -3,9 +3,11 @@
 
 #pragma once
 
+#include <string>
 #include "common/types.h"
 
 struct SDL_Window;
+struct SDL_Gamepad;
 union SDL_Event;
 
 namespace Input {
@@ -59,10 +61,17 @@ public:
     }
 
     void waitEvent();
+    void setTitle(const std::string& title);
 
 private:
     void onResize();
     void onKeyPress(const SDL_Event* event);
+    void onGamepadEvent(const SDL_Event* event);
+
+    // Flushes the batched vibration/light bar values to the gamepad and samples
+    // its IMU into the controller snapshot; runs once per waitEvent pass so
+    // per-frame guest haptics calls collapse into a single SDL command.
+    void updateGamepad();
 
 private:
     s32 width;
@@ -70,6 +79,8 @@ private:
     Input::GameController* controller;
     WindowSystemInfo window_info{};
     SDL_Window* window{};
+    SDL_Gamepad* gamepad{};
+    bool gamepad_sensors{};
     bool is_shown{};
     bool is_open{true};
 };
@@ -78,14 +78,19 @@ void Invoke(EmitContext& ctx, IR::Inst* inst) {
 }
 
 void EmitInst(EmitContext& ctx, IR::Inst* inst) {
-    switch (inst->GetOpcode()) {
-#define OPCODE(name, result_type, ...)                                                             \
-    case IR::Opcode::name:                                                                         \
-        return Invoke<&Emit##name>(ctx, inst);
+    // Emission runs once per IR instruction, tens of thousands of times per
+    // shader; dispatch through a table built at compile time so the call is a
+    // single indexed jump with no range check.
+    using EmitFunc = void (*)(EmitContext&, IR::Inst*);
+    static constexpr auto emit_table = [] {
+        std::array<EmitFunc, IR::NumOpcodes> table{};
+        size_t index{};
+#define OPCODE(name, result_type, ...) table[index++] = &Invoke<&Emit##name>;
 #include "shader_recompiler/ir/opcodes.inc"
 #undef OPCODE
-    }
-    UNREACHABLE_MSG("Invalid opcode {}", inst->GetOpcode());
+        return table;
+    }();
+    emit_table[static_cast<size_t>(inst->GetOpcode())](ctx, inst);
 }
 
 Id TypeId(const EmitContext& ctx, IR::Type type) {
@@ -182,6 +187,11 @@ void DefineEntryPoint(const IR::Program& program, EmitContext& ctx, Id main) {
     ctx.AddCapability(spv::Capability::Int16);
     ctx.AddCapability(spv::Capability::StorageImageWriteWithoutFormat);
     ctx.AddCapability(spv::Capability::StorageImageExtendedFormats);
+    if (program.info.use_bindless_textures) {
+        ctx.AddCapability(spv::Capability::RuntimeDescriptorArray);
+        ctx.AddCapability(spv::Capability::SampledImageArrayDynamicIndexing);
+        ctx.AddCapability(spv::Capability::StorageImageArrayDynamicIndexing);
+    }
     switch (program.info.stage) {
     case Stage::Compute: {
         const std::array<u32, 3> workgroup_size{program.info.workgroup_size};
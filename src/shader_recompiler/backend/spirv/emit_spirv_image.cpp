@@ -21,8 +21,8 @@ struct ImageOperands {
 Id EmitImageSampleImplicitLod(EmitContext& ctx, IR::Inst* inst, u32 handle, Id coords, Id bias_lc,
                               Id offset) {
     const auto& texture = ctx.images[handle & 0xFFFF];
-    const Id image = ctx.OpLoad(texture.image_type, texture.id);
-    const Id sampler = ctx.OpLoad(ctx.sampler_type, ctx.samplers[handle >> 16]);
+    const Id image = ctx.OpLoad(texture.image_type, ctx.ImagePointer(handle & 0xFFFF));
+    const Id sampler = ctx.OpLoad(ctx.sampler_type, ctx.SamplerPointer(handle >> 16));
     const Id sampled_image = ctx.OpSampledImage(texture.sampled_type, image, sampler);
     ImageOperands operands;
     if (Sirit::ValidId(offset)) {
@@ -35,8 +35,8 @@ Id EmitImageSampleImplicitLod(EmitContext& ctx, IR::Inst* inst, u32 handle, Id c
 Id EmitImageSampleExplicitLod(EmitContext& ctx, IR::Inst* inst, u32 handle, Id coords, Id bias_lc,
                               Id offset) {
     const auto& texture = ctx.images[handle & 0xFFFF];
-    const Id image = ctx.OpLoad(texture.image_type, texture.id);
-    const Id sampler = ctx.OpLoad(ctx.sampler_type, ctx.samplers[handle >> 16]);
+    const Id image = ctx.OpLoad(texture.image_type, ctx.ImagePointer(handle & 0xFFFF));
+    const Id sampler = ctx.OpLoad(ctx.sampler_type, ctx.SamplerPointer(handle >> 16));
     const Id sampled_image = ctx.OpSampledImage(texture.sampled_type, image, sampler);
     return ctx.OpImageSampleExplicitLod(ctx.F32[4], sampled_image, coords,
                                         spv::ImageOperandsMask::Lod, ctx.ConstF32(0.f));
@@ -45,8 +45,8 @@ Id EmitImageSampleExplicitLod(EmitContext& ctx, IR::Inst* inst, u32 handle, Id c
 Id EmitImageSampleDrefImplicitLod(EmitContext& ctx, IR::Inst* inst, u32 handle, Id coords, Id dref,
                                   Id bias_lc, const IR::Value& offset) {
     const auto& texture = ctx.images[handle & 0xFFFF];
-    const Id image = ctx.OpLoad(texture.image_type, texture.id);
-    const Id sampler = ctx.OpLoad(ctx.sampler_type, ctx.samplers[handle >> 16]);
+    const Id image = ctx.OpLoad(texture.image_type, ctx.ImagePointer(handle & 0xFFFF));
+    const Id sampler = ctx.OpLoad(ctx.sampler_type, ctx.SamplerPointer(handle >> 16));
     const Id sampled_image = ctx.OpSampledImage(texture.sampled_type, image, sampler);
     return ctx.OpImageSampleDrefImplicitLod(ctx.F32[1], sampled_image, coords, dref);
 }
@@ -54,8 +54,8 @@ Id EmitImageSampleDrefImplicitLod(EmitContext& ctx, IR::Inst* inst, u32 handle,
 Id EmitImageSampleDrefExplicitLod(EmitContext& ctx, IR::Inst* inst, u32 handle, Id coords, Id dref,
                                   Id bias_lc, Id offset) {
     const auto& texture = ctx.images[handle & 0xFFFF];
-    const Id image = ctx.OpLoad(texture.image_type, texture.id);
-    const Id sampler = ctx.OpLoad(ctx.sampler_type, ctx.samplers[handle >> 16]);
+    const Id image = ctx.OpLoad(texture.image_type, ctx.ImagePointer(handle & 0xFFFF));
+    const Id sampler = ctx.OpLoad(ctx.sampler_type, ctx.SamplerPointer(handle >> 16));
     const Id sampled_image = ctx.OpSampledImage(texture.sampled_type, image, sampler);
     return ctx.OpImageSampleDrefExplicitLod(ctx.F32[1], sampled_image, coords, dref,
                                             spv::ImageOperandsMask::Lod, ctx.ConstF32(0.f));
@@ -69,8 +69,8 @@ Id EmitImageGather(EmitContext& ctx, IR::Inst* inst, const IR::Value& index, Id
 Id EmitImageGatherDref(EmitContext& ctx, IR::Inst* inst, u32 handle, Id coords,
                        const IR::Value& offset, const IR::Value& offset2, Id dref) {
     const auto& texture = ctx.images[handle & 0xFFFF];
-    const Id image = ctx.OpLoad(texture.image_type, texture.id);
-    const Id sampler = ctx.OpLoad(ctx.sampler_type, ctx.samplers[handle >> 16]);
+    const Id image = ctx.OpLoad(texture.image_type, ctx.ImagePointer(handle & 0xFFFF));
+    const Id sampler = ctx.OpLoad(ctx.sampler_type, ctx.SamplerPointer(handle >> 16));
     const Id sampled_image = ctx.OpSampledImage(texture.sampled_type, image, sampler);
     return ctx.OpImageDrefGather(ctx.F32[4], sampled_image, coords, dref);
 }
@@ -78,7 +78,7 @@ Id EmitImageGatherDref(EmitContext& ctx, IR::Inst* inst, u32 handle, Id coords,
 Id EmitImageFetch(EmitContext& ctx, IR::Inst* inst, u32 handle, Id coords, Id offset, Id lod,
                   Id ms) {
     const auto& texture = ctx.images[handle & 0xFFFF];
-    const Id image = ctx.OpLoad(texture.image_type, texture.id);
+    const Id image = ctx.OpLoad(texture.image_type, ctx.ImagePointer(handle & 0xFFFF));
     const Id result_type = texture.data_types->Get(4);
     if (Sirit::ValidId(lod)) {
         return ctx.OpBitcast(ctx.F32[4], ctx.OpImageFetch(result_type, image, coords,
@@ -90,7 +90,7 @@ Id EmitImageFetch(EmitContext& ctx, IR::Inst* inst, u32 handle, Id coords, Id of
 
 Id EmitImageQueryDimensions(EmitContext& ctx, IR::Inst* inst, u32 handle, Id lod, bool skip_mips) {
     const auto& texture = ctx.images[handle & 0xFFFF];
-    const Id image = ctx.OpLoad(texture.image_type, texture.id);
+    const Id image = ctx.OpLoad(texture.image_type, ctx.ImagePointer(handle & 0xFFFF));
     const auto type = ctx.info.images[handle & 0xFFFF].type;
     const Id zero = ctx.u32_zero_value;
     const auto mips{[&] { return skip_mips ? zero : ctx.OpImageQueryLevels(ctx.U32[1], image); }};
@@ -117,8 +117,8 @@ Id EmitImageQueryDimensions(EmitContext& ctx, IR::Inst* inst, u32 handle, Id lod
 
 Id EmitImageQueryLod(EmitContext& ctx, IR::Inst* inst, u32 handle, Id coords) {
     const auto& texture = ctx.images[handle & 0xFFFF];
-    const Id image = ctx.OpLoad(texture.image_type, texture.id);
-    const Id sampler = ctx.OpLoad(ctx.sampler_type, ctx.samplers[handle >> 16]);
+    const Id image = ctx.OpLoad(texture.image_type, ctx.ImagePointer(handle & 0xFFFF));
+    const Id sampler = ctx.OpLoad(ctx.sampler_type, ctx.SamplerPointer(handle >> 16));
     const Id sampled_image = ctx.OpSampledImage(texture.sampled_type, image, sampler);
     const Id zero{ctx.f32_zero_value};
     return ctx.OpImageQueryLod(ctx.F32[2], sampled_image, coords);
@@ -135,7 +135,7 @@ Id EmitImageRead(EmitContext& ctx, IR::Inst* inst, const IR::Value& index, Id co
 
 void EmitImageWrite(EmitContext& ctx, IR::Inst* inst, u32 handle, Id coords, Id color) {
     const auto& texture = ctx.images[handle & 0xFFFF];
-    const Id image = ctx.OpLoad(texture.image_type, texture.id);
+    const Id image = ctx.OpLoad(texture.image_type, ctx.ImagePointer(handle & 0xFFFF));
     const Id color_type = texture.data_types->Get(4);
     ctx.OpImageWrite(image, coords, ctx.OpBitcast(color_type, color));
 }
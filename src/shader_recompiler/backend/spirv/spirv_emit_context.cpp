@@ -372,6 +372,28 @@ Id ImageType(EmitContext& ctx, const ImageResource& desc, Id sampled_type) {
 }
 
 void EmitContext::DefineImagesAndSamplers(const Info& info) {
+    const bool bindless = info.use_bindless_textures;
+    if (bindless && (!info.images.empty() || !info.samplers.empty())) {
+        // Per-draw indices into the global descriptor arrays of set 1. The
+        // member offset places this stage's table inside the shared 128-byte
+        // push-constant block, see BindlessIndexBase.
+        const u32 num_indices = static_cast<u32>(info.images.size() + info.samplers.size());
+        const Id index_array{TypeArray(U32[1], ConstU32(num_indices))};
+        Decorate(index_array, spv::Decoration::ArrayStride, 4U);
+        const Id block{TypeStruct(index_array)};
+        Decorate(block, spv::Decoration::Block);
+        MemberDecorate(block, 0, spv::Decoration::Offset,
+                       BindlessIndexBase(stage) * static_cast<u32>(sizeof(u32)));
+        MemberName(block, 0, "indices");
+        bindless_index_pointer = TypePointer(spv::StorageClass::PushConstant, U32[1]);
+        const Id block_pointer{TypePointer(spv::StorageClass::PushConstant, block)};
+        bindless_index_block =
+            AddGlobalVariable(block_pointer, spv::StorageClass::PushConstant);
+        Name(bindless_index_block, "bindless_indices");
+        interfaces.push_back(bindless_index_block);
+    }
+
+    u32 bindless_slot{};
     for (const auto& image_desc : info.images) {
         const VectorIds* data_types = [&] {
             switch (image_desc.nfmt) {
@@ -386,9 +408,22 @@ void EmitContext::DefineImagesAndSamplers(const Info& info) {
         const Id sampled_type = data_types->Get(1);
         const Id image_type{ImageType(*this, image_desc, sampled_type)};
         const Id pointer_type{TypePointer(spv::StorageClass::UniformConstant, image_type)};
-        const Id id{AddGlobalVariable(pointer_type, spv::StorageClass::UniformConstant)};
-        Decorate(id, spv::Decoration::Binding, binding);
-        Decorate(id, spv::Decoration::DescriptorSet, 0U);
+        Id id;
+        if (bindless) {
+            // Every image aliases one of the two descriptor-indexing array
+            // bindings; aliasing the same binding with different image types is
+            // valid as long as each accessed descriptor matches its view.
+            const Id array_type{TypeRuntimeArray(image_type)};
+            const Id array_pointer{TypePointer(spv::StorageClass::UniformConstant, array_type)};
+            id = AddGlobalVariable(array_pointer, spv::StorageClass::UniformConstant);
+            Decorate(id, spv::Decoration::Binding, image_desc.is_storage ? 1U : 0U);
+            Decorate(id, spv::Decoration::DescriptorSet, 1U);
+        } else {
+            id = AddGlobalVariable(pointer_type, spv::StorageClass::UniformConstant);
+            Decorate(id, spv::Decoration::Binding, binding);
+            Decorate(id, spv::Decoration::DescriptorSet, 0U);
+            ++binding;
+        }
         Name(id, fmt::format("{}_{}{}_{:02x}", stage, "img", image_desc.sgpr_base,
                              image_desc.dword_offset));
         images.push_back({
@@ -397,9 +432,9 @@ void EmitContext::DefineImagesAndSamplers(const Info& info) {
             .sampled_type = image_desc.is_storage ? sampled_type : TypeSampledImage(image_type),
             .pointer_type = pointer_type,
             .image_type = image_type,
+            .bindless_slot = bindless_slot++,
         });
         interfaces.push_back(id);
-        ++binding;
     }
 
     image_u32 = TypePointer(spv::StorageClass::Image, U32[1]);
@@ -410,16 +445,54 @@ void EmitContext::DefineImagesAndSamplers(const Info& info) {
 
     sampler_type = TypeSampler();
     sampler_pointer_type = TypePointer(spv::StorageClass::UniformConstant, sampler_type);
+    if (bindless) {
+        const Id array_type{TypeRuntimeArray(sampler_type)};
+        const Id array_pointer{TypePointer(spv::StorageClass::UniformConstant, array_type)};
+        bindless_sampler_array =
+            AddGlobalVariable(array_pointer, spv::StorageClass::UniformConstant);
+        Decorate(bindless_sampler_array, spv::Decoration::Binding, 2U);
+        Decorate(bindless_sampler_array, spv::Decoration::DescriptorSet, 1U);
+        Name(bindless_sampler_array, "bindless_samplers");
+        interfaces.push_back(bindless_sampler_array);
+    }
     for (const auto& samp_desc : info.samplers) {
-        const Id id{AddGlobalVariable(sampler_pointer_type, spv::StorageClass::UniformConstant)};
-        Decorate(id, spv::Decoration::Binding, binding);
-        Decorate(id, spv::Decoration::DescriptorSet, 0U);
-        Name(id, fmt::format("{}_{}{}_{:02x}", stage, "samp", samp_desc.sgpr_base,
-                             samp_desc.dword_offset));
-        samplers.push_back(id);
-        interfaces.push_back(id);
-        ++binding;
+        Id id;
+        if (bindless) {
+            id = bindless_sampler_array;
+        } else {
+            id = AddGlobalVariable(sampler_pointer_type, spv::StorageClass::UniformConstant);
+            Decorate(id, spv::Decoration::Binding, binding);
+            Decorate(id, spv::Decoration::DescriptorSet, 0U);
+            Name(id, fmt::format("{}_{}{}_{:02x}", stage, "samp", samp_desc.sgpr_base,
+                                 samp_desc.dword_offset));
+            interfaces.push_back(id);
+            ++binding;
+        }
+        samplers.push_back({
+            .id = id,
+            .bindless_slot = bindless_slot++,
+        });
+    }
+}
+
+Id EmitContext::ImagePointer(u32 index) {
+    const auto& texture = images[index];
+    if (!info.use_bindless_textures) {
+        return texture.id;
+    }
+    const Id slot_pointer{OpAccessChain(bindless_index_pointer, bindless_index_block,
+                                        u32_zero_value, ConstU32(texture.bindless_slot))};
+    return OpAccessChain(texture.pointer_type, texture.id, OpLoad(U32[1], slot_pointer));
+}
+
+Id EmitContext::SamplerPointer(u32 index) {
+    const auto& sampler = samplers[index];
+    if (!info.use_bindless_textures) {
+        return sampler.id;
     }
+    const Id slot_pointer{OpAccessChain(bindless_index_pointer, bindless_index_block,
+                                        u32_zero_value, ConstU32(sampler.bindless_slot))};
+    return OpAccessChain(sampler_pointer_type, sampler.id, OpLoad(U32[1], slot_pointer));
 }
 
 void EmitContext::DefineSharedMemory(const Info& info) {
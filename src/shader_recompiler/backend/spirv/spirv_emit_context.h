@@ -193,6 +193,7 @@ public:
         Id sampled_type;
         Id pointer_type;
         Id image_type;
+        u32 bindless_slot{};
     };
 
     struct BufferDefinition {
@@ -201,13 +202,29 @@ public:
         Id pointer_type;
     };
 
+    struct SamplerDefinition {
+        Id id;
+        u32 bindless_slot{};
+    };
+
+    /// Returns a pointer to the image variable; in bindless mode this is an
+    /// access chain into the global descriptor array of set 1, addressed by the
+    /// push-constant index table.
+    [[nodiscard]] Id ImagePointer(u32 index);
+
+    /// Returns a pointer to the sampler variable, see ImagePointer.
+    [[nodiscard]] Id SamplerPointer(u32 index);
+
     u32& binding;
     boost::container::small_vector<BufferDefinition, 4> buffers;
     boost::container::small_vector<TextureDefinition, 4> images;
-    boost::container::small_vector<Id, 4> samplers;
+    boost::container::small_vector<SamplerDefinition, 4> samplers;
 
     Id sampler_type{};
     Id sampler_pointer_type{};
+    Id bindless_index_block{};
+    Id bindless_index_pointer{};
+    Id bindless_sampler_array{};
 
     struct SpirvAttribute {
         Id id;
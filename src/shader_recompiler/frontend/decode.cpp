@@ -249,7 +249,7 @@ uint32_t GcnDecodeContext::mapEncodingOp(InstEncoding encoding, Opcode opcode) {
 
 void GcnDecodeContext::updateInstructionMeta(InstEncoding encoding) {
     uint32_t encodingOp = mapEncodingOp(encoding, m_instruction.opcode);
-    InstFormat instFormat = InstructionFormat(encoding, encodingOp);
+    const InstFormat& instFormat = InstructionFormat(encoding, encodingOp);
 
     ASSERT_MSG(instFormat.src_type != ScalarType::Undefined &&
                    instFormat.dst_type != ScalarType::Undefined,
@@ -389,7 +389,7 @@ void GcnDecodeContext::decodeInstruction64(InstEncoding encoding, GcnCodeSlice&
 void GcnDecodeContext::decodeLiteralConstant(InstEncoding encoding, GcnCodeSlice& code) {
     if (HasAdditionalLiteral(encoding, m_instruction.opcode)) {
         u32 encoding_op = mapEncodingOp(encoding, m_instruction.opcode);
-        InstFormat instFormat = InstructionFormat(encoding, encoding_op);
+        const InstFormat& instFormat = InstructionFormat(encoding, encoding_op);
         m_instruction.src[m_instruction.src_count].field = OperandField::LiteralConst;
         m_instruction.src[m_instruction.src_count].type = instFormat.src_type;
         m_instruction.src[m_instruction.src_count].code = code.readu32();
@@ -1039,7 +1039,7 @@ void GcnDecodeContext::decodeInstructionDS(uint64_t hexInstruction) {
 
     m_instruction.control.ds = *reinterpret_cast<InstControlDS*>(&hexInstruction);
 
-    auto instFormat = InstructionFormat(InstEncoding::DS, (u32)op);
+    const InstFormat& instFormat = InstructionFormat(InstEncoding::DS, (u32)op);
 
     m_instruction.control.ds.dual =
         op == OpcodeDS::DS_WRITE2_B32 || op == OpcodeDS::DS_WRXCHG2_RTN_B32 ||
@@ -20,7 +20,7 @@ InstEncoding GetInstructionEncoding(u32 token);
 
 u32 GetEncodingLength(InstEncoding encoding);
 
-InstFormat InstructionFormat(InstEncoding encoding, u32 opcode);
+const InstFormat& InstructionFormat(InstEncoding encoding, u32 opcode);
 
 Opcode DecodeOpcode(u32 token);
 
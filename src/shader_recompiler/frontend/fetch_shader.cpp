@@ -1,7 +1,10 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <mutex>
+#include <unordered_map>
 #include <boost/container/static_vector.hpp>
+#include <xxhash.h>
 #include "shader_recompiler/frontend/decode.h"
 #include "shader_recompiler/frontend/fetch_shader.h"
 
@@ -32,7 +35,22 @@ namespace Shader::Gcn {
  * We take the reverse way, extract the original input semantics from these instructions.
  **/
 
-std::vector<VertexAttribute> ParseFetchShader(const u32* code, u32* out_size) {
+namespace {
+
+struct CachedFetchShader {
+    std::vector<VertexAttribute> attributes;
+    u32 size;
+    u64 hash;
+};
+
+/// The runtime generates few distinct fetch shaders but references them from many vertex
+/// shader variants, so the same byte code gets decoded over and over during translation.
+/// Cache parsed layouts keyed by code address; a hash of the code guards against the
+/// guest reusing an address for a different fetch shader.
+std::mutex fetch_cache_mutex;
+std::unordered_map<const u32*, CachedFetchShader> fetch_cache;
+
+std::vector<VertexAttribute> ParseFetchShaderImpl(const u32* code, u32* out_size) {
     std::vector<VertexAttribute> attributes;
     GcnCodeSlice code_slice(code, code + std::numeric_limits<u32>::max());
     GcnDecodeContext decoder;
@@ -85,4 +103,26 @@ std::vector<VertexAttribute> ParseFetchShader(const u32* code, u32* out_size) {
     return attributes;
 }
 
+} // Anonymous namespace
+
+std::vector<VertexAttribute> ParseFetchShader(const u32* code, u32* out_size) {
+    {
+        std::scoped_lock lk{fetch_cache_mutex};
+        const auto it = fetch_cache.find(code);
+        if (it != fetch_cache.end() && XXH3_64bits(code, it->second.size) == it->second.hash) {
+            *out_size += it->second.size;
+            return it->second.attributes;
+        }
+    }
+
+    u32 size{};
+    auto attributes = ParseFetchShaderImpl(code, &size);
+    *out_size += size;
+
+    std::scoped_lock lk{fetch_cache_mutex};
+    fetch_cache.insert_or_assign(code,
+                                 CachedFetchShader{attributes, size, XXH3_64bits(code, size)});
+    return attributes;
+}
+
 } // namespace Shader::Gcn
@@ -3687,7 +3687,7 @@ constexpr std::array<InstFormat, 1> InstructionFormatEXP = {{
     {InstClass::Exp, InstCategory::Export, 4, 1, ScalarType::Float32, ScalarType::Any},
 }};
 
-InstFormat InstructionFormat(InstEncoding encoding, uint32_t opcode) {
+const InstFormat& InstructionFormat(InstEncoding encoding, uint32_t opcode) {
     switch (encoding) {
     case InstEncoding::SOP1:
         return InstructionFormatSOP1[opcode];
@@ -3723,7 +3723,8 @@ InstFormat InstructionFormat(InstEncoding encoding, uint32_t opcode) {
         return InstructionFormatVOP2[opcode];
     }
     UNREACHABLE();
-    return {};
+    static constexpr InstFormat null_format{};
+    return null_format;
 }
 
 } // namespace Shader::Gcn
@@ -265,13 +265,26 @@ Node SiblingFromNephew(Node uncle, Node nephew) noexcept {
 }
 
 bool AreOrdered(Node left_sibling, Node right_sibling) noexcept {
+    // Walk from both nodes at once so the cost is bounded by the distance between
+    // them instead of the length of the sibling list; gotos usually sit close to
+    // their labels while the root list grows with every block of the shader.
     const Node end{right_sibling->up->children.end()};
-    for (auto it = right_sibling; it != end; ++it) {
-        if (it == left_sibling) {
+    Node left_it{left_sibling};
+    Node right_it{right_sibling};
+    while (true) {
+        if (left_it == right_sibling) {
+            return true;
+        }
+        if (right_it == left_sibling) {
             return false;
         }
+        if (left_it != end) {
+            ++left_it;
+        }
+        if (right_it != end) {
+            ++right_it;
+        }
     }
-    return true;
 }
 
 bool NeedsLift(Node goto_stmt, Node label_stmt) noexcept {
@@ -333,10 +346,11 @@ private:
                 }
             }
         }
-        // Expensive operation:
-        if (!AreSiblings(goto_stmt, label_stmt)) {
-            UNREACHABLE_MSG("Goto is not a sibling with the label");
-        }
+        // Verifying siblingship walks the whole sibling list, which is quadratic over
+        // all gotos of a deeply branching shader; the transformations above guarantee
+        // it, so only pay for the check in debug builds.
+        DEBUG_ASSERT_MSG(AreSiblings(goto_stmt, label_stmt),
+                         "Goto is not a sibling with the label");
         // goto_stmt and label_stmt are guaranteed to be siblings, eliminate
         if (std::next(goto_stmt) == label_stmt) {
             // Simply eliminate the goto if the label is next to it
@@ -353,6 +367,8 @@ private:
     std::vector<Node> BuildTree(CFG& cfg) {
         u32 label_id{0};
         std::vector<Node> gotos;
+        // Every block emits at most two gotos (conditional and fallthrough).
+        gotos.reserve(cfg.blocks.size() * 2);
         BuildTree(cfg, label_id, gotos, root_stmt.children.end(), std::nullopt);
         return gotos;
     }
@@ -819,7 +835,10 @@ private:
 
 IR::AbstractSyntaxList BuildASL(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Block>& block_pool,
                                 CFG& cfg, Info& info) {
-    ObjectPool<Statement> stmt_pool{64};
+    // Statements are arena-owned and never individually destroyed, so the pool can
+    // be reset and reused by the next translation on this worker thread.
+    thread_local ObjectPool<Statement> stmt_pool{64};
+    stmt_pool.ReleaseContents();
     GotoPass goto_pass{cfg, stmt_pool};
     Statement& root{goto_pass.RootStatement()};
     IR::AbstractSyntaxList syntax_list;
@@ -145,9 +145,15 @@ public:
         return instructions.crend();
     }
 
-    /// Intrusively store the value of a register in the block.
-    std::array<Value, NumScalarRegs> ssa_sreg_values;
-    std::array<Value, NumVectorRegs> ssa_vreg_values;
+    /// Row of this block in the flattened register-definition tables of the SSA pass.
+    static constexpr u32 NoSsaDefRow = ~u32{0};
+
+    void SetSsaDefRow(u32 row) noexcept {
+        ssa_def_row = row;
+    }
+    [[nodiscard]] u32 SsaDefRow() const noexcept {
+        return ssa_def_row;
+    }
 
 private:
     /// Memory pool for instruction list
@@ -163,6 +169,8 @@ private:
 
     /// Intrusively store if the block is sealed in the SSA pass.
     bool is_ssa_sealed{false};
+    /// Intrusively store the definition table row of the block in the SSA pass.
+    u32 ssa_def_row{NoSsaDefRow};
 
     /// Intrusively stored host definition of this block.
     u32 definition{};
@@ -75,6 +75,9 @@ constexpr u8 NUM_ARGS[]{
 };
 } // namespace Detail
 
+/// Number of opcodes in the Opcode enum
+constexpr size_t NumOpcodes = std::size(Detail::META_TABLE);
+
 /// Get return type of an opcode
 [[nodiscard]] inline Type TypeOf(Opcode op) noexcept {
     return Detail::META_TABLE[static_cast<size_t>(op)].type;
@@ -1,11 +1,14 @@
 // SPDX-FileCopyrightText: Copyright 2021 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <bit>
 #include <optional>
 #include <type_traits>
+#include <vector>
 #include "common/func_traits.h"
 #include "shader_recompiler/ir/basic_block.h"
+#include "shader_recompiler/ir/program.h"
 
 namespace Shader::Optimization {
 
@@ -252,6 +255,35 @@ void ConstantPropagation(IR::Block& block, IR::Inst& inst) {
     case IR::Opcode::ShiftRightArithmetic32:
         FoldWhenAllImmediates(inst, [](s32 a, s32 b) { return static_cast<u32>(a >> b); });
         return;
+    case IR::Opcode::ShiftLeftLogical32:
+        FoldWhenAllImmediates(inst, [](u32 a, u32 b) { return a << b; });
+        return;
+    case IR::Opcode::ShiftRightLogical32:
+        FoldWhenAllImmediates(inst, [](u32 a, u32 b) { return a >> b; });
+        return;
+    case IR::Opcode::SMin32:
+        FoldWhenAllImmediates(inst,
+                              [](s32 a, s32 b) { return static_cast<u32>(std::min(a, b)); });
+        return;
+    case IR::Opcode::UMin32:
+        FoldWhenAllImmediates(inst, [](u32 a, u32 b) { return std::min(a, b); });
+        return;
+    case IR::Opcode::SMax32:
+        FoldWhenAllImmediates(inst,
+                              [](s32 a, s32 b) { return static_cast<u32>(std::max(a, b)); });
+        return;
+    case IR::Opcode::UMax32:
+        FoldWhenAllImmediates(inst, [](u32 a, u32 b) { return std::max(a, b); });
+        return;
+    case IR::Opcode::FPAdd32:
+        FoldWhenAllImmediates(inst, [](f32 a, f32 b) { return a + b; });
+        return;
+    case IR::Opcode::FPSub32:
+        FoldWhenAllImmediates(inst, [](f32 a, f32 b) { return a - b; });
+        return;
+    case IR::Opcode::FPMul32:
+        FoldWhenAllImmediates(inst, [](f32 a, f32 b) { return a * b; });
+        return;
     case IR::Opcode::BitCastF32U32:
         return FoldBitCast<IR::Opcode::BitCastF32U32, f32, u32>(inst, IR::Opcode::BitCastU32F32);
     case IR::Opcode::BitCastU32F32:
@@ -387,14 +419,55 @@ void ConstantPropagation(IR::Block& block, IR::Inst& inst) {
     }
 }
 
-void ConstantPropagationPass(IR::BlockList& program) {
-    const auto end{program.rend()};
-    for (auto it = program.rbegin(); it != end; ++it) {
+void ConstantPropagationDeadCodePass(IR::Program& program) {
+    auto& blocks{program.post_order_blocks};
+
+    // Fold in reverse post order so producers are visited before their consumers;
+    // a single sweep then reaches the fixpoint for forward use chains and no
+    // instruction has to be revisited.
+    for (auto it = blocks.rbegin(); it != blocks.rend(); ++it) {
         IR::Block* const block{*it};
         for (IR::Inst& inst : block->Instructions()) {
             ConstantPropagation(*block, inst);
         }
     }
+
+    // Clean up in post order (uses before definitions): rewire arguments through the
+    // identities created by folding, then erase identities and unused side-effect-free
+    // instructions. Invalidating an instruction releases its arguments, so use counts
+    // hit zero before the backward walk reaches the producer and the whole cascade
+    // completes without a rescan. Identities that still have uses at this point are
+    // referenced through a loop back edge; their users are rewired later in the walk,
+    // so only their invalidation needs to be deferred.
+    std::vector<IR::Inst*> loop_identities;
+    for (IR::Block* const block : blocks) {
+        auto it{block->end()};
+        while (it != block->begin()) {
+            --it;
+            const size_t num_args{it->NumArgs()};
+            for (size_t i = 0; i < num_args; ++i) {
+                IR::Value arg;
+                while ((arg = it->Arg(i)).IsIdentity()) {
+                    it->SetArg(i, arg.Inst()->Arg(0));
+                }
+            }
+            const auto opcode{it->GetOpcode()};
+            if (opcode == IR::Opcode::Identity || opcode == IR::Opcode::Void) {
+                if (it->HasUses()) {
+                    loop_identities.push_back(&*it);
+                } else {
+                    it->Invalidate();
+                }
+                it = block->Instructions().erase(it);
+            } else if (!it->HasUses() && !it->MayHaveSideEffects()) {
+                it->Invalidate();
+                it = block->Instructions().erase(it);
+            }
+        }
+    }
+    for (IR::Inst* const inst : loop_identities) {
+        inst->Invalidate();
+    }
 }
 
 } // namespace Shader::Optimization
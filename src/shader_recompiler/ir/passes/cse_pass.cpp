@@ -0,0 +1,181 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <bit>
+#include <unordered_map>
+#include <vector>
+#include "shader_recompiler/ir/basic_block.h"
+#include "shader_recompiler/ir/passes/ir_passes.h"
+#include "shader_recompiler/ir/program.h"
+
+namespace Shader::Optimization {
+namespace {
+
+/// Identifies a pure instruction by opcode, modifier flags and arguments. Two
+/// eligible instructions with equal keys always compute the same value, so the
+/// later one can reuse the result of the earlier one.
+struct InstKey {
+    IR::Opcode op;
+    u32 flags;
+    std::array<IR::Value, 5> args;
+
+    bool operator==(const InstKey& other) const {
+        return op == other.op && flags == other.flags && args == other.args;
+    }
+};
+
+u64 HashValue(const IR::Value& value) {
+    if (!value.IsImmediate()) {
+        return reinterpret_cast<u64>(value.Inst());
+    }
+    switch (value.Type()) {
+    case IR::Type::U1:
+        return value.U1();
+    case IR::Type::U8:
+        return value.U8();
+    case IR::Type::U16:
+        return value.U16();
+    case IR::Type::U32:
+        return value.U32();
+    case IR::Type::U64:
+        return value.U64();
+    case IR::Type::F32:
+        return std::bit_cast<u32>(value.F32());
+    case IR::Type::F64:
+        return std::bit_cast<u64>(value.F64());
+    case IR::Type::ScalarReg:
+        return static_cast<u64>(value.ScalarReg());
+    case IR::Type::VectorReg:
+        return static_cast<u64>(value.VectorReg());
+    case IR::Type::Attribute:
+        return static_cast<u64>(value.Attribute());
+    default:
+        // Hash collisions are tolerable; equality comparison stays exact.
+        return 0;
+    }
+}
+
+struct InstKeyHash {
+    size_t operator()(const InstKey& key) const {
+        u64 hash = static_cast<u64>(key.op) | (static_cast<u64>(key.flags) << 32);
+        for (const IR::Value& arg : key.args) {
+            hash = (hash ^ HashValue(arg)) * 0x100000001B3ULL;
+        }
+        return static_cast<size_t>(hash);
+    }
+};
+
+using ValueTable = std::unordered_map<InstKey, IR::Inst*, InstKeyHash>;
+
+bool IsEligible(IR::Opcode op) {
+    // The opcode table lays out the pure ALU operations (composites, selects,
+    // bit casts, packing, floating point, integer, logical and conversions)
+    // contiguously between these two entries.
+    if (op >= IR::Opcode::CompositeConstructU32x2 && op <= IR::Opcode::ConvertU16U32) {
+        return true;
+    }
+    // Reads of state that cannot change within an invocation are also pure.
+    // Memory loads, image operations and shuffles are deliberately excluded.
+    switch (op) {
+    case IR::Opcode::ReadConst:
+    case IR::Opcode::ReadConstBuffer:
+    case IR::Opcode::ReadConstBufferU32:
+    case IR::Opcode::GetUserData:
+    case IR::Opcode::GetAttribute:
+    case IR::Opcode::GetAttributeU32:
+    case IR::Opcode::LaneId:
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // Anonymous namespace
+
+void CommonSubexpressionEliminationPass(IR::Program& program) {
+    // Walk the structured syntax list with a scoped value table. Definitions
+    // recorded before an If or Loop construct dominate every block inside it
+    // and the code after the merge, so they stay visible; definitions made
+    // inside the construct are dropped when its scope closes since the body
+    // may not execute on every path reaching the merge.
+    ValueTable table;
+    std::vector<std::vector<InstKey>> scopes(1);
+    for (const IR::AbstractSyntaxNode& node : program.syntax_list) {
+        switch (node.type) {
+        case IR::AbstractSyntaxNode::Type::If:
+        case IR::AbstractSyntaxNode::Type::Loop:
+            scopes.emplace_back();
+            break;
+        case IR::AbstractSyntaxNode::Type::EndIf:
+        case IR::AbstractSyntaxNode::Type::Repeat:
+            for (const InstKey& key : scopes.back()) {
+                table.erase(key);
+            }
+            scopes.pop_back();
+            break;
+        case IR::AbstractSyntaxNode::Type::Block: {
+            for (IR::Inst& inst : node.data.block->Instructions()) {
+                // This is the last whole-program walk of the pipeline, so
+                // Shader::Info is filled here instead of by a separate pass.
+                CollectInstructionInfo(program.info, inst);
+                if (!IsEligible(inst.GetOpcode())) {
+                    continue;
+                }
+                InstKey key{.op = inst.GetOpcode(), .flags = inst.Flags<u32>(), .args = {}};
+                const size_t num_args = inst.NumArgs();
+                for (size_t i = 0; i < num_args; ++i) {
+                    // Resolve through identities left by earlier replacements so
+                    // users of a replaced value key the same as users of the
+                    // canonical definition.
+                    IR::Value arg;
+                    while ((arg = inst.Arg(i)).IsIdentity()) {
+                        inst.SetArg(i, arg.Inst()->Arg(0));
+                    }
+                    key.args[i] = arg;
+                }
+                const auto [it, is_new] = table.try_emplace(key, &inst);
+                if (is_new) {
+                    scopes.back().push_back(key);
+                } else {
+                    inst.ReplaceUsesWith(IR::Value{it->second});
+                }
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    // Erase the identity husks left by the replacements, rewiring remaining
+    // users in post order the same way the dead code sweep does. Identities
+    // still used here are referenced through a loop back edge; their users are
+    // rewired later in the walk so only invalidation is deferred.
+    std::vector<IR::Inst*> loop_identities;
+    for (IR::Block* const block : program.post_order_blocks) {
+        auto it{block->end()};
+        while (it != block->begin()) {
+            --it;
+            const size_t num_args{it->NumArgs()};
+            for (size_t i = 0; i < num_args; ++i) {
+                IR::Value arg;
+                while ((arg = it->Arg(i)).IsIdentity()) {
+                    it->SetArg(i, arg.Inst()->Arg(0));
+                }
+            }
+            if (it->GetOpcode() == IR::Opcode::Identity) {
+                if (it->HasUses()) {
+                    loop_identities.push_back(&*it);
+                } else {
+                    it->Invalidate();
+                }
+                it = block->Instructions().erase(it);
+            }
+        }
+    }
+    for (IR::Inst* const inst : loop_identities) {
+        inst->Invalidate();
+    }
+}
+
+} // namespace Shader::Optimization
@@ -9,10 +9,19 @@
 namespace Shader::Optimization {
 
 void SsaRewritePass(IR::BlockList& program);
-void IdentityRemovalPass(IR::BlockList& program);
-void DeadCodeEliminationPass(IR::Program& program);
-void ConstantPropagationPass(IR::BlockList& program);
+void ConstantPropagationDeadCodePass(IR::Program& program);
+void CommonSubexpressionEliminationPass(IR::Program& program);
 void ResourceTrackingPass(IR::Program& program);
-void CollectShaderInfoPass(IR::Program& program);
+
+/// Re-strides LDS offsets whose access pattern provably hits a single bank
+/// period, padding one dword per 128-byte block. Applied only when every
+/// shared access is aligned to its size, so no access can straddle a block.
+void SharedMemoryStridePass(IR::Program& program);
+
+/// Accumulates the facts Shader::Info tracks about one instruction. The CSE
+/// pass invokes this during its walk so no dedicated collection pass runs;
+/// rewrites inserting instructions afterwards update Info incrementally with
+/// the same call.
+void CollectInstructionInfo(Info& info, IR::Inst& inst);
 
 } // namespace Shader::Optimization
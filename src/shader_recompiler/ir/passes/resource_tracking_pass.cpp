@@ -143,6 +143,7 @@ public:
         auto& buffer = buffer_resources[index];
         ASSERT(buffer.stride == desc.stride && buffer.num_records == desc.num_records);
         buffer.is_storage |= desc.is_storage;
+        buffer.is_written |= desc.is_written;
         buffer.used_types |= desc.used_types;
         return index;
     }
@@ -306,6 +307,7 @@ s32 TryHandleInlineCbuf(IR::Inst& inst, Info& info, Descriptors& descriptors,
         .used_types = BufferDataType(inst),
         .inline_cbuf = cbuf,
         .is_storage = IsBufferStore(inst) || cbuf.GetSize() > MaxUboSize,
+        .is_written = IsBufferStore(inst),
     });
 }
 
@@ -325,6 +327,7 @@ void PatchBufferInstruction(IR::Block& block, IR::Inst& inst, Info& info,
             .num_records = u32(buffer.num_records),
             .used_types = BufferDataType(inst),
             .is_storage = IsBufferStore(inst) || buffer.GetSize() > MaxUboSize,
+            .is_written = IsBufferStore(inst),
         });
     }
 
@@ -5,7 +5,10 @@
 
 namespace Shader::Optimization {
 
-void Visit(Info& info, IR::Inst& inst) {
+// Called from the CSE walk for every surviving instruction, so filling
+// Shader::Info costs no extra pass. The flags are monotone, making the update
+// safe to invoke again from rewrites that insert instructions later.
+void CollectInstructionInfo(Info& info, IR::Inst& inst) {
     switch (inst.GetOpcode()) {
     case IR::Opcode::GetAttribute:
     case IR::Opcode::GetAttributeU32: {
@@ -34,13 +37,4 @@ void Visit(Info& info, IR::Inst& inst) {
     }
 }
 
-void CollectShaderInfoPass(IR::Program& program) {
-    Info& info{program.info};
-    for (IR::Block* const block : program.post_order_blocks) {
-        for (IR::Inst& inst : block->Instructions()) {
-            Visit(info, inst);
-        }
-    }
-}
-
 } // namespace Shader::Optimization
@@ -0,0 +1,171 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <bit>
+#include <utility>
+#include <vector>
+#include "common/div_ceil.h"
+#include "shader_recompiler/ir/basic_block.h"
+#include "shader_recompiler/ir/ir_emitter.h"
+#include "shader_recompiler/ir/passes/ir_passes.h"
+#include "shader_recompiler/ir/program.h"
+
+namespace Shader::Optimization {
+namespace {
+
+// GCN LDS has 32 banks of 4 bytes, so lane offsets that differ by a multiple
+// of 128 bytes land on the same bank. Titles tuned for that banking commonly
+// use row pitches that are exact multiples of it, which serialize just as
+// badly on host GPUs. Inserting one dword of padding per 128-byte block
+// spreads such strides across banks again.
+constexpr u32 BankBlockSize = 128;
+constexpr u32 BankBlockShift = 7;
+constexpr u32 BlockPadding = 4;
+
+u32 AccessSize(IR::Opcode opcode) {
+    switch (opcode) {
+    case IR::Opcode::LoadSharedU8:
+    case IR::Opcode::LoadSharedS8:
+    case IR::Opcode::WriteSharedU8:
+        return 1;
+    case IR::Opcode::LoadSharedU16:
+    case IR::Opcode::LoadSharedS16:
+    case IR::Opcode::WriteSharedU16:
+        return 2;
+    case IR::Opcode::LoadSharedU32:
+    case IR::Opcode::WriteSharedU32:
+        return 4;
+    case IR::Opcode::LoadSharedU64:
+    case IR::Opcode::WriteSharedU64:
+        return 8;
+    case IR::Opcode::LoadSharedU128:
+    case IR::Opcode::WriteSharedU128:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+/// Returns the number of low offset bits provably zero, walking the value
+/// through the arithmetic GCN address computations are built from.
+u32 OffsetAlignment(const IR::Value& value, u32 depth) {
+    if (value.IsImmediate()) {
+        const u32 imm = value.U32();
+        return imm == 0 ? 32 : static_cast<u32>(std::countr_zero(imm));
+    }
+    if (depth == 0) {
+        return 0;
+    }
+    const IR::Inst* inst = value.InstRecursive();
+    switch (inst->GetOpcode()) {
+    case IR::Opcode::IAdd32:
+        return std::min(OffsetAlignment(inst->Arg(0), depth - 1),
+                        OffsetAlignment(inst->Arg(1), depth - 1));
+    case IR::Opcode::IMul32:
+        return std::min(32u, OffsetAlignment(inst->Arg(0), depth - 1) +
+                                 OffsetAlignment(inst->Arg(1), depth - 1));
+    case IR::Opcode::ShiftLeftLogical32: {
+        const IR::Value shift = inst->Arg(1);
+        if (!shift.IsImmediate()) {
+            return 0;
+        }
+        return std::min(32u, OffsetAlignment(inst->Arg(0), depth - 1) + shift.U32());
+    }
+    case IR::Opcode::BitwiseAnd32: {
+        // A mask can only clear bits, so either operand's alignment survives.
+        return std::max(OffsetAlignment(inst->Arg(0), depth - 1),
+                        OffsetAlignment(inst->Arg(1), depth - 1));
+    }
+    case IR::Opcode::BitwiseOr32:
+        return std::min(OffsetAlignment(inst->Arg(0), depth - 1),
+                        OffsetAlignment(inst->Arg(1), depth - 1));
+    default:
+        return 0;
+    }
+}
+
+/// Detects a bank-conflicting term in the offset expression: any factor that
+/// is a non-zero multiple of the 128-byte bank period.
+bool HasConflictStride(const IR::Value& value, u32 depth) {
+    if (value.IsImmediate() || depth == 0) {
+        return false;
+    }
+    const IR::Inst* inst = value.InstRecursive();
+    switch (inst->GetOpcode()) {
+    case IR::Opcode::ShiftLeftLogical32: {
+        const IR::Value shift = inst->Arg(1);
+        if (shift.IsImmediate() && shift.U32() >= BankBlockShift) {
+            return true;
+        }
+        return HasConflictStride(inst->Arg(0), depth - 1);
+    }
+    case IR::Opcode::IMul32: {
+        for (u32 i = 0; i < 2; ++i) {
+            const IR::Value arg = inst->Arg(i);
+            if (arg.IsImmediate() && arg.U32() != 0 && arg.U32() % BankBlockSize == 0) {
+                return true;
+            }
+        }
+        return HasConflictStride(inst->Arg(0), depth - 1) ||
+               HasConflictStride(inst->Arg(1), depth - 1);
+    }
+    case IR::Opcode::IAdd32:
+    case IR::Opcode::BitwiseAnd32:
+    case IR::Opcode::BitwiseOr32:
+        return HasConflictStride(inst->Arg(0), depth - 1) ||
+               HasConflictStride(inst->Arg(1), depth - 1);
+    default:
+        return false;
+    }
+}
+
+} // Anonymous namespace
+
+void SharedMemoryStridePass(IR::Program& program) {
+    auto& info = program.info;
+    if (info.stage != Stage::Compute || info.shared_memory_size == 0) {
+        return;
+    }
+    // The remap must leave room for the padding within the 64 KiB LDS budget.
+    const u32 padded_size = info.shared_memory_size +
+                            Common::DivCeil(info.shared_memory_size, BankBlockSize) * BlockPadding;
+    if (padded_size > 64_KB) {
+        return;
+    }
+
+    constexpr u32 AnalysisDepth = 8;
+    std::vector<std::pair<IR::Block*, IR::Inst*>> shared_ops;
+    bool conflict_found = false;
+    for (IR::Block* const block : program.blocks) {
+        for (IR::Inst& inst : block->Instructions()) {
+            const u32 size = AccessSize(inst.GetOpcode());
+            if (size == 0) {
+                continue;
+            }
+            // Remapping offset o to o + (o >> 7) * 4 is only sound when no
+            // access straddles a 128-byte block, i.e. when each offset is
+            // provably aligned to its access size.
+            if (OffsetAlignment(inst.Arg(0), AnalysisDepth) <
+                static_cast<u32>(std::countr_zero(size))) {
+                return;
+            }
+            conflict_found |= HasConflictStride(inst.Arg(0), AnalysisDepth);
+            shared_ops.emplace_back(block, &inst);
+        }
+    }
+    if (!conflict_found) {
+        return;
+    }
+
+    for (const auto& [block, inst] : shared_ops) {
+        IR::IREmitter ir{*block, IR::Block::InstructionList::s_iterator_to(*inst)};
+        const IR::U32 offset{inst->Arg(0)};
+        const IR::U32 block_index{ir.ShiftRightLogical(offset, ir.Imm32(BankBlockShift))};
+        const IR::U32 padded{
+            ir.IAdd(offset, ir.ShiftLeftLogical(block_index, ir.Imm32(2U)))};
+        inst->SetArg(0, padded);
+    }
+    info.shared_memory_size = padded_size;
+}
+
+} // namespace Shader::Optimization
@@ -13,10 +13,13 @@
 //      https://link.springer.com/chapter/10.1007/978-3-642-37051-9_6
 //
 
-#include <map>
+#include <algorithm>
 #include <span>
 #include <unordered_map>
 #include <variant>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
 
 #include "shader_recompiler/ir/basic_block.h"
 #include "shader_recompiler/ir/opcodes.h"
@@ -49,18 +52,24 @@ using Variant = std::variant<IR::ScalarReg, IR::VectorReg, GotoVariable, SccFlag
 using ValueMap = std::unordered_map<IR::Block*, IR::Value>;
 
 struct DefTable {
+    explicit DefTable(size_t num_blocks) {
+        sreg_values.reserve(num_blocks * IR::NumScalarRegs);
+        vreg_values.reserve(num_blocks * IR::NumVectorRegs);
+        flag_values.reserve(num_blocks * NumFlags);
+    }
+
     const IR::Value& Def(IR::Block* block, IR::ScalarReg variable) {
-        return block->ssa_sreg_values[RegIndex(variable)];
+        return sreg_values[Row(block) * IR::NumScalarRegs + RegIndex(variable)];
     }
     void SetDef(IR::Block* block, IR::ScalarReg variable, const IR::Value& value) {
-        block->ssa_sreg_values[RegIndex(variable)] = value;
+        sreg_values[Row(block) * IR::NumScalarRegs + RegIndex(variable)] = value;
     }
 
     const IR::Value& Def(IR::Block* block, IR::VectorReg variable) {
-        return block->ssa_vreg_values[RegIndex(variable)];
+        return vreg_values[Row(block) * IR::NumVectorRegs + RegIndex(variable)];
     }
     void SetDef(IR::Block* block, IR::VectorReg variable, const IR::Value& value) {
-        block->ssa_vreg_values[RegIndex(variable)] = value;
+        vreg_values[Row(block) * IR::NumVectorRegs + RegIndex(variable)] = value;
     }
 
     const IR::Value& Def(IR::Block* block, GotoVariable variable) {
@@ -70,55 +79,62 @@ struct DefTable {
         goto_vars[variable.index].insert_or_assign(block, value);
     }
 
-    const IR::Value& Def(IR::Block* block, SccFlagTag) {
-        return scc_flag[block];
-    }
-    void SetDef(IR::Block* block, SccFlagTag, const IR::Value& value) {
-        scc_flag.insert_or_assign(block, value);
-    }
+    // The hardware flags form a small fixed register file of their own, so they share
+    // the flat row storage with the scalar and vector registers instead of going
+    // through one hash map per flag.
+    static constexpr size_t NumFlags = 6;
 
-    const IR::Value& Def(IR::Block* block, ExecFlagTag) {
-        return exec_flag[block];
+    static constexpr size_t FlagIndex(SccFlagTag) noexcept {
+        return 0;
     }
-    void SetDef(IR::Block* block, ExecFlagTag, const IR::Value& value) {
-        exec_flag.insert_or_assign(block, value);
+    static constexpr size_t FlagIndex(ExecFlagTag) noexcept {
+        return 1;
     }
-
-    const IR::Value& Def(IR::Block* block, SccLoTag) {
-        return scc_lo_flag[block];
+    static constexpr size_t FlagIndex(VccFlagTag) noexcept {
+        return 2;
     }
-    void SetDef(IR::Block* block, SccLoTag, const IR::Value& value) {
-        scc_lo_flag.insert_or_assign(block, value);
+    static constexpr size_t FlagIndex(SccLoTag) noexcept {
+        return 3;
     }
-
-    const IR::Value& Def(IR::Block* block, VccLoTag) {
-        return vcc_lo_flag[block];
+    static constexpr size_t FlagIndex(VccLoTag) noexcept {
+        return 4;
     }
-    void SetDef(IR::Block* block, VccLoTag, const IR::Value& value) {
-        vcc_lo_flag.insert_or_assign(block, value);
+    static constexpr size_t FlagIndex(VccHiTag) noexcept {
+        return 5;
     }
 
-    const IR::Value& Def(IR::Block* block, VccHiTag) {
-        return vcc_hi_flag[block];
+    template <typename Flag>
+        requires(std::is_base_of_v<FlagTag, Flag> && !std::is_same_v<Flag, GotoVariable>)
+    const IR::Value& Def(IR::Block* block, Flag flag) {
+        return flag_values[Row(block) * NumFlags + FlagIndex(flag)];
     }
-    void SetDef(IR::Block* block, VccHiTag, const IR::Value& value) {
-        vcc_hi_flag.insert_or_assign(block, value);
+    template <typename Flag>
+        requires(std::is_base_of_v<FlagTag, Flag> && !std::is_same_v<Flag, GotoVariable>)
+    void SetDef(IR::Block* block, Flag flag, const IR::Value& value) {
+        flag_values[Row(block) * NumFlags + FlagIndex(flag)] = value;
     }
 
-    const IR::Value& Def(IR::Block* block, VccFlagTag) {
-        return vcc_flag[block];
-    }
-    void SetDef(IR::Block* block, VccFlagTag, const IR::Value& value) {
-        vcc_flag.insert_or_assign(block, value);
+    /// Assigns the block a row in the flattened tables on first use, so registers of
+    /// the whole program live in two contiguous allocations instead of per-block
+    /// arrays scattered across pool chunks.
+    size_t Row(IR::Block* block) {
+        u32 row = block->SsaDefRow();
+        if (row == IR::Block::NoSsaDefRow) {
+            row = static_cast<u32>(num_rows++);
+            block->SetSsaDefRow(row);
+            sreg_values.resize(num_rows * IR::NumScalarRegs);
+            vreg_values.resize(num_rows * IR::NumVectorRegs);
+            flag_values.resize(num_rows * NumFlags);
+        }
+        return row;
     }
 
+    size_t num_rows{};
+    std::vector<IR::Value> sreg_values;
+    std::vector<IR::Value> vreg_values;
+    std::vector<IR::Value> flag_values;
+
     std::unordered_map<u32, ValueMap> goto_vars;
-    ValueMap scc_flag;
-    ValueMap exec_flag;
-    ValueMap vcc_flag;
-    ValueMap scc_lo_flag;
-    ValueMap vcc_lo_flag;
-    ValueMap vcc_hi_flag;
 };
 
 IR::Opcode UndefOpcode(IR::ScalarReg) noexcept {
@@ -167,6 +183,8 @@ struct ReadState {
 
 class Pass {
 public:
+    explicit Pass(size_t num_blocks) : current_def{num_blocks} {}
+
     template <typename Type>
     void WriteVariable(Type variable, IR::Block* block, const IR::Value& value) {
         current_def.SetDef(block, variable, value);
@@ -203,7 +221,7 @@ public:
                     IR::Inst* phi{&*block->PrependNewInst(block->begin(), IR::Opcode::Phi)};
                     phi->SetFlags(IR::TypeOf(UndefOpcode(variable)));
 
-                    incomplete_phis[block].insert_or_assign(variable, phi);
+                    SetIncompletePhi(block, variable, phi);
                     stack.back().result = IR::Value{&*phi};
                 } else if (const std::span imm_preds = block->ImmPredecessors();
                            imm_preds.size() == 1) {
@@ -250,16 +268,29 @@ public:
     void SealBlock(IR::Block* block) {
         const auto it{incomplete_phis.find(block)};
         if (it != incomplete_phis.end()) {
-            for (auto& pair : it->second) {
-                auto& variant{pair.first};
-                auto& phi{pair.second};
-                std::visit([&](auto& variable) { AddPhiOperands(variable, *phi, block); }, variant);
+            for (auto& [variant, phi] : it->second) {
+                std::visit([&, phi = phi](auto& variable) { AddPhiOperands(variable, *phi, block); },
+                           variant);
             }
         }
         block->SsaSeal();
     }
 
 private:
+    using IncompletePhiList = boost::container::small_vector<std::pair<Variant, IR::Inst*>, 8>;
+
+    template <typename Type>
+    void SetIncompletePhi(IR::Block* block, Type variable, IR::Inst* phi) {
+        IncompletePhiList& phis{incomplete_phis[block]};
+        const Variant variant{variable};
+        const auto it{std::ranges::find(phis, variant, &std::pair<Variant, IR::Inst*>::first)};
+        if (it != phis.end()) {
+            it->second = phi;
+        } else {
+            phis.emplace_back(variant, phi);
+        }
+    }
+
     template <typename Type>
     IR::Value AddPhiOperands(Type variable, IR::Inst& phi, IR::Block* block) {
         for (IR::Block* const imm_pred : block->ImmPredecessors()) {
@@ -304,7 +335,7 @@ private:
         return same;
     }
 
-    std::unordered_map<IR::Block*, std::map<Variant, IR::Inst*>> incomplete_phis;
+    std::unordered_map<IR::Block*, IncompletePhiList> incomplete_phis;
     DefTable current_def;
 };
 
@@ -390,7 +421,7 @@ void VisitBlock(Pass& pass, IR::Block* block) {
 } // Anonymous namespace
 
 void SsaRewritePass(IR::BlockList& program) {
-    Pass pass;
+    Pass pass{program.size()};
     const auto end{program.rend()};
     for (auto block = program.rbegin(); block != end; ++block) {
         VisitBlock(pass, *block);
@@ -4,7 +4,6 @@
 #pragma once
 
 #include <string>
-#include "shader_recompiler/frontend/instruction.h"
 #include "shader_recompiler/ir/abstract_syntax_list.h"
 #include "shader_recompiler/ir/basic_block.h"
 #include "shader_recompiler/runtime_info.h"
@@ -15,7 +14,6 @@ struct Program {
     AbstractSyntaxList syntax_list;
     BlockList blocks;
     BlockList post_order_blocks;
-    std::vector<Gcn::GcnInst> ins_list;
     Info info;
 };
 
@@ -77,7 +77,8 @@ private:
         }
 
         void Release() {
-            std::destroy_n(storage.get(), used_objects);
+            // Storage has a deliberately empty destructor: pooled objects are arena-owned
+            // and never individually destroyed, so resetting a chunk is O(1).
             used_objects = 0;
         }
 
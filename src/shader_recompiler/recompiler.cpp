@@ -1,14 +1,66 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <tsl/robin_map.h>
+#include <xxhash.h>
+#include "common/config.h"
 #include "shader_recompiler/frontend/control_flow_graph.h"
 #include "shader_recompiler/frontend/decode.h"
 #include "shader_recompiler/frontend/structured_control_flow.h"
 #include "shader_recompiler/ir/passes/ir_passes.h"
 #include "shader_recompiler/ir/post_order.h"
+#include "shader_recompiler/recompiler.h"
 
 namespace Shader {
 
+namespace {
+
+/// Decode and control flow graph construction depend only on the code bytes,
+/// while the translation that follows is specialized by runtime info. Pipeline
+/// permutations of the same shader therefore share this artifact, keyed by code
+/// hash, and only re-run the specialized part.
+struct DecodedProgram {
+    std::vector<Gcn::GcnInst> ins_list;
+    ObjectPool<Gcn::Block> block_pool{64};
+    std::unique_ptr<Gcn::CFG> cfg;
+};
+
+DecodedProgram& DecodeShader(std::span<const u32> token) {
+    static std::mutex decode_mutex;
+    static tsl::robin_map<u64, std::unique_ptr<DecodedProgram>> decode_cache;
+
+    const u64 hash = XXH3_64bits(token.data(), token.size_bytes());
+    {
+        std::scoped_lock lock{decode_mutex};
+        if (const auto it = decode_cache.find(hash); it != decode_cache.end()) {
+            return *it->second;
+        }
+    }
+
+    // Decode outside the lock; concurrent stages miss on different hashes and
+    // should not serialize on each other's decode.
+    auto decoded = std::make_unique<DecodedProgram>();
+    Gcn::GcnCodeSlice slice(token.data(), token.data() + token.size());
+    Gcn::GcnDecodeContext decoder;
+    decoded->ins_list.reserve(token.size());
+    while (!slice.atEnd()) {
+        decoded->ins_list.emplace_back(decoder.decodeInstruction(slice));
+    }
+    decoded->cfg = std::make_unique<Gcn::CFG>(decoded->block_pool, decoded->ins_list);
+
+    std::scoped_lock lock{decode_mutex};
+    const auto [it, is_new] = decode_cache.try_emplace(hash);
+    if (is_new) {
+        it.value() = std::move(decoded);
+    }
+    return *it->second;
+}
+
+} // Anonymous namespace
+
 IR::BlockList GenerateBlocks(const IR::AbstractSyntaxList& syntax_list) {
     size_t num_syntax_blocks{};
     for (const auto& node : syntax_list) {
@@ -28,41 +80,56 @@ IR::BlockList GenerateBlocks(const IR::AbstractSyntaxList& syntax_list) {
 }
 
 IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool, ObjectPool<IR::Block>& block_pool,
-                             std::span<const u32> token, const Info&& info) {
+                             std::span<const u32> token, const Info&& info,
+                             TranslateStats* stats) {
     // Ensure first instruction is expected.
     constexpr u32 token_mov_vcchi = 0xBEEB03FF;
     ASSERT_MSG(token[0] == token_mov_vcchi, "First instruction is not s_mov_b32 vcc_hi, #imm");
 
-    Gcn::GcnCodeSlice slice(token.data(), token.data() + token.size());
-    Gcn::GcnDecodeContext decoder;
+    auto phase_start = std::chrono::steady_clock::now();
+    const auto phase_ns = [&phase_start] {
+        const auto now = std::chrono::steady_clock::now();
+        const u64 ns =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - phase_start).count();
+        phase_start = now;
+        return ns;
+    };
 
-    // Decode and save instructions
-    IR::Program program;
-    program.ins_list.reserve(token.size());
-    while (!slice.atEnd()) {
-        program.ins_list.emplace_back(decoder.decodeInstruction(slice));
+    // Fetch the decoded instructions and control flow graph, decoding on first
+    // sight of this code. BuildASL below only reads the graph so the shared
+    // artifact can serve concurrent translations.
+    Gcn::CFG& cfg = *DecodeShader(token).cfg;
+    if (stats) {
+        stats->decode_ns = phase_ns();
     }
 
-    // Create control flow graph
-    ObjectPool<Gcn::Block> gcn_block_pool{64};
-    Gcn::CFG cfg{gcn_block_pool, program.ins_list};
-
     // Structurize control flow graph and create program.
+    IR::Program program;
     program.info = std::move(info);
     program.syntax_list = Shader::Gcn::BuildASL(inst_pool, block_pool, cfg, program.info);
     program.blocks = GenerateBlocks(program.syntax_list);
     program.post_order_blocks = Shader::IR::PostOrder(program.syntax_list.front());
+    if (stats) {
+        stats->structurize_ns = phase_ns();
+    }
 
     // Run optimization passes
     Shader::Optimization::SsaRewritePass(program.post_order_blocks);
     Shader::Optimization::ResourceTrackingPass(program);
-    Shader::Optimization::ConstantPropagationPass(program.post_order_blocks);
-    Shader::Optimization::IdentityRemovalPass(program.blocks);
-    Shader::Optimization::DeadCodeEliminationPass(program);
-    Shader::Optimization::CollectShaderInfoPass(program);
+    Shader::Optimization::ConstantPropagationDeadCodePass(program);
+    // Runs after constant folding so shared offsets are canonical, and before
+    // CSE so the inserted remap arithmetic is deduplicated and collected.
+    Shader::Optimization::SharedMemoryStridePass(program);
+    // The CSE walk also fills Shader::Info, so no collection pass follows.
+    Shader::Optimization::CommonSubexpressionEliminationPass(program);
+    if (stats) {
+        stats->passes_ns = phase_ns();
+    }
 
-    fmt::print("Post passes\n\n{}\n", Shader::IR::DumpProgram(program));
-    std::fflush(stdout);
+    if (Config::dumpShaders()) {
+        fmt::print("Post passes\n\n{}\n", Shader::IR::DumpProgram(program));
+        std::fflush(stdout);
+    }
 
     return program;
 }
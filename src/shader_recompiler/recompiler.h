@@ -9,8 +9,17 @@
 
 namespace Shader {
 
+/// Wall-clock nanoseconds spent in each translation phase, filled when a stats
+/// pointer is passed to TranslateProgram.
+struct TranslateStats {
+    u64 decode_ns{};
+    u64 structurize_ns{};
+    u64 passes_ns{};
+};
+
 [[nodiscard]] IR::Program TranslateProgram(ObjectPool<IR::Inst>& inst_pool,
                                            ObjectPool<IR::Block>& block_pool,
-                                           std::span<const u32> code, const Info&& info);
+                                           std::span<const u32> code, const Info&& info,
+                                           TranslateStats* stats = nullptr);
 
 } // namespace Shader
@@ -30,6 +30,16 @@ constexpr u32 MaxStageTypes = 6;
     return static_cast<Stage>(static_cast<size_t>(Stage::Vertex) + index);
 }
 
+/// Per-stage dword budget of the bindless index table pushed as constants.
+/// The base offsets are fixed per stage so a cached shader module stays valid
+/// regardless of which other stages it is paired with.
+constexpr u32 BindlessIndexBudget = 16;
+constexpr u32 BindlessPushSize = 2 * BindlessIndexBudget * sizeof(u32);
+
+[[nodiscard]] constexpr u32 BindlessIndexBase(Stage stage) noexcept {
+    return stage == Stage::Fragment ? BindlessIndexBudget : 0;
+}
+
 enum class TextureType : u32 {
     Color1D,
     ColorArray1D,
@@ -78,6 +88,7 @@ struct BufferResource {
     IR::Type used_types;
     AmdGpu::Buffer inline_cbuf;
     bool is_storage;
+    bool is_written;
 
     constexpr AmdGpu::Buffer GetVsharp(const Info& info) const noexcept;
 };
@@ -173,6 +184,10 @@ struct Info {
     bool uses_shared_u8{};
     bool uses_shared_u16{};
     bool translation_failed{}; // indicates that shader has unsupported instructions
+    // When set images and samplers live in the global descriptor-indexing arrays
+    // of set 1 and are addressed through the push-constant index table instead of
+    // receiving per-draw descriptor writes in set 0.
+    bool use_bindless_textures{};
 
     template <typename T>
     T ReadUd(u32 ptr_index, u32 dword_offset) const noexcept {
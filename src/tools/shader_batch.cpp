@@ -0,0 +1,158 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fmt/core.h>
+#include "common/io_file.h"
+#include "common/types.h"
+#include "shader_recompiler/backend/spirv/emit_spirv.h"
+#include "shader_recompiler/recompiler.h"
+#include "shader_recompiler/runtime_info.h"
+
+// Batch-recompiles a directory of dumped GCN binaries (the files dumpShaders
+// writes as <stage>_<hash>.bin) and reports per-phase timing plus aggregate
+// throughput, so recompiler changes can be validated against a shader corpus
+// without booting titles. Shaders are translated with an empty user-data
+// block; programs whose resource tracking needs live guest sharps fail
+// translation and are counted as errors.
+
+namespace {
+
+std::optional<Shader::Stage> StageFromPrefix(const std::string& filename) {
+    static constexpr std::array<std::string_view, 6> Names = {"vs", "tc", "te", "gs", "fs", "cs"};
+    for (size_t i = 0; i < Names.size(); i++) {
+        if (filename.starts_with(Names[i]) && filename.size() > 2 && filename[2] == '_') {
+            return Shader::StageFromIndex(i);
+        }
+    }
+    return std::nullopt;
+}
+
+struct Totals {
+    std::atomic<u64> decode_ns{};
+    std::atomic<u64> structurize_ns{};
+    std::atomic<u64> passes_ns{};
+    std::atomic<u64> emit_ns{};
+    std::atomic<u64> code_bytes{};
+    std::atomic<u32> num_ok{};
+    std::atomic<u32> num_failed{};
+};
+
+void CompileOne(const std::filesystem::path& path, Shader::Stage stage, const Shader::Profile& profile,
+                Totals& totals) {
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read};
+    if (!file.IsOpen()) {
+        ++totals.num_failed;
+        return;
+    }
+    std::vector<u32> code(file.GetSize() / sizeof(u32));
+    file.ReadSpan<u32>(code);
+
+    // All user-data registers read as zero; see the note at the top.
+    static constexpr std::array<u32, Shader::NumUserDataRegs> NullUserData{};
+
+    thread_local Shader::ObjectPool<Shader::IR::Inst> inst_pool{8192};
+    thread_local Shader::ObjectPool<Shader::IR::Block> block_pool{512};
+    inst_pool.ReleaseContents();
+    block_pool.ReleaseContents();
+
+    try {
+        Shader::Info info{};
+        info.stage = stage;
+        info.num_user_data = NullUserData.size();
+        info.user_data = NullUserData;
+
+        Shader::TranslateStats stats{};
+        auto program =
+            Shader::TranslateProgram(inst_pool, block_pool, code, std::move(info), &stats);
+
+        const auto emit_start = std::chrono::steady_clock::now();
+        u32 binding{};
+        const auto spv = Shader::Backend::SPIRV::EmitSPIRV(profile, program, binding);
+        const u64 emit_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                std::chrono::steady_clock::now() - emit_start)
+                                .count();
+
+        totals.decode_ns += stats.decode_ns;
+        totals.structurize_ns += stats.structurize_ns;
+        totals.passes_ns += stats.passes_ns;
+        totals.emit_ns += emit_ns;
+        totals.code_bytes += code.size() * sizeof(u32);
+        ++totals.num_ok;
+    } catch (const std::exception& e) {
+        fmt::print("FAIL {}: {}\n", path.filename().string(), e.what());
+        ++totals.num_failed;
+    }
+}
+
+} // Anonymous namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        fmt::print("Usage: {} <dump directory> [num threads]\n", argv[0]);
+        return -1;
+    }
+
+    std::vector<std::pair<std::filesystem::path, Shader::Stage>> shaders;
+    for (const auto& entry : std::filesystem::directory_iterator(argv[1])) {
+        const auto filename = entry.path().filename().string();
+        if (!filename.ends_with(".bin")) {
+            continue;
+        }
+        if (const auto stage = StageFromPrefix(filename)) {
+            shaders.emplace_back(entry.path(), *stage);
+        }
+    }
+    if (shaders.empty()) {
+        fmt::print("No dumped shader binaries found in {}\n", argv[1]);
+        return -1;
+    }
+
+    const u32 num_threads = argc > 2 ? std::max(1, std::atoi(argv[2]))
+                                     : std::max(1u, std::thread::hardware_concurrency());
+
+    // Conservative host profile; emission cost barely depends on the optional
+    // capability set and keeping it fixed makes runs comparable across hosts.
+    Shader::Profile profile{
+        .supported_spirv = 0x00010600U,
+    };
+
+    Totals totals;
+    std::atomic<size_t> next{0};
+    const auto start = std::chrono::steady_clock::now();
+    {
+        std::vector<std::jthread> workers;
+        for (u32 i = 0; i < num_threads; i++) {
+            workers.emplace_back([&] {
+                while (true) {
+                    const size_t index = next.fetch_add(1, std::memory_order_relaxed);
+                    if (index >= shaders.size()) {
+                        break;
+                    }
+                    CompileOne(shaders[index].first, shaders[index].second, profile, totals);
+                }
+            });
+        }
+    }
+    const f64 elapsed_s = std::chrono::duration_cast<std::chrono::duration<f64>>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+
+    const auto ms = [](u64 ns) { return f64(ns) / 1e6; };
+    fmt::print("Compiled {} shaders ({} failed) with {} threads in {:.2f} s\n",
+               totals.num_ok.load(), totals.num_failed.load(), num_threads, elapsed_s);
+    fmt::print("CPU time per phase: decode {:.1f} ms, structurize {:.1f} ms, passes {:.1f} ms, "
+               "emit {:.1f} ms\n",
+               ms(totals.decode_ns), ms(totals.structurize_ns), ms(totals.passes_ns),
+               ms(totals.emit_ns));
+    fmt::print("Throughput: {:.1f} shaders/s, {:.2f} MB/s of GCN code\n",
+               totals.num_ok.load() / elapsed_s, f64(totals.code_bytes.load()) / 1e6 / elapsed_s);
+    return totals.num_failed != 0 ? 1 : 0;
+}
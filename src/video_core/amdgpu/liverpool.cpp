@@ -1,10 +1,19 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
 #include "common/assert.h"
+#include "common/config.h"
 #include "common/debug.h"
+#include "common/profiler.h"
+#include "common/singleton.h"
 #include "common/thread.h"
 #include "video_core/amdgpu/liverpool.h"
+#include "video_core/amdgpu/pm4_capture.h"
 #include "video_core/amdgpu/pm4_cmds.h"
 #include "video_core/renderer_vulkan/vk_rasterizer.h"
 
@@ -15,54 +24,116 @@ static const char* ccb_task_name{"CCB_TASK"};
 static const char* acb_task_name{"ACB_TASK"};
 
 std::array<u8, 48_KB> Liverpool::ConstantEngine::constants_heap;
+Common::BumpArena Liverpool::submit_arena;
 
 Liverpool::Liverpool() {
     process_thread = std::jthread{std::bind_front(&Liverpool::Process, this)};
+
+    const u32 num_workers = std::min(Config::computeThreads(), NumTotalQueues - NumGfxRings);
+    for (u32 i = 0; i < num_workers; ++i) {
+        compute_threads.emplace_back([this, i, num_workers](std::stop_token stoken) {
+            ProcessComputeWorker(stoken, i, num_workers);
+        });
+    }
 }
 
 Liverpool::~Liverpool() {
+    for (auto& thread : compute_threads) {
+        thread.request_stop();
+    }
+    compute_threads.clear();
     process_thread.request_stop();
     process_thread.join();
 }
 
-void Liverpool::Process(std::stop_token stoken) {
-    Common::SetCurrentThreadName("GPU_CommandProcessor");
-
-    while (!stoken.stop_requested()) {
-        {
-            std::unique_lock lk{submit_mutex};
-            submit_cv.wait(lk, stoken, [this] { return num_submits != 0; });
-        }
-        if (stoken.stop_requested()) {
-            break;
+bool Liverpool::HasPendingSubmits(u32 first_qid, u32 last_qid, u32 stride) {
+    for (u32 qid = first_qid; qid < last_qid; qid += stride) {
+        if (mapped_queues[qid].pending != 0) {
+            return true;
         }
+    }
+    return false;
+}
 
-        int qid = -1;
+bool Liverpool::StepQueue(u32 qid) {
+    auto& queue = mapped_queues[qid];
 
-        while (num_submits) {
-            qid = (qid + 1) % NumTotalQueues;
+    if (!queue.current && !queue.submits.TryPop(queue.current)) {
+        return false;
+    }
 
-            auto& queue = mapped_queues[qid];
+    {
+        std::scoped_lock exec_lock{exec_mutex};
+        // Time the resumed slice rather than the whole coroutine, which spans
+        // suspensions while waiting for rasterizer state.
+        auto* profiler = Common::Singleton<Common::Profiler>::Instance();
+        const u64 start = profiler->Now();
+        queue.current.resume();
+        profiler->RecordScope(qid < NumGfxRings ? "Liverpool::ProcessGraphics"
+                                                : "Liverpool::ProcessCompute",
+                              start, profiler->Now());
+    }
 
-            Task::Handle task{};
-            {
-                std::scoped_lock lock{queue.m_access};
+    if (queue.current.done()) {
+        queue.current.destroy();
+        queue.current = {};
+        --queue.pending;
 
-                if (queue.submits.empty()) {
-                    continue;
-                }
+        if (--num_submits == 0) {
+            std::scoped_lock lk{submit_mutex};
+            submit_cv.notify_all();
+        }
+    }
+    return true;
+}
 
-                task = queue.submits.front();
-            }
-            task.resume();
+bool Liverpool::WaitForSubmits(std::stop_token& stoken, u32 first_qid, u32 last_qid, u32 stride) {
+    // Guest-submit-to-dispatch latency is dominated by the mutex/condvar wakeup,
+    // not by the queue walk, so spin on the pending counters first: a submit that
+    // lands within the window is picked up with no syscall at all. Busy-poll mode
+    // never blocks, trading one spinning core for minimal dispatch latency on
+    // dedicated hosts.
+    constexpr u32 SpinIterations = 2048;
+    const bool busy_poll = Config::gpuBusyPoll();
+    u32 remaining = SpinIterations;
+    while (busy_poll || remaining-- != 0) {
+        if (HasPendingSubmits(first_qid, last_qid, stride)) {
+            return true;
+        }
+        if (stoken.stop_requested()) {
+            return false;
+        }
+#if defined(__x86_64__) || defined(_M_X64)
+        _mm_pause();
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    std::unique_lock lk{submit_mutex};
+    ++num_idle_consumers;
+    submit_cv.wait(lk, stoken,
+                   [&] { return HasPendingSubmits(first_qid, last_qid, stride); });
+    --num_idle_consumers;
+    return !stoken.stop_requested();
+}
 
-            if (task.done()) {
-                task.destroy();
+void Liverpool::Process(std::stop_token stoken) {
+    Common::SetCurrentThreadName("GPU_CommandProcessor");
+    Common::SetCurrentThreadRole(Common::ThreadRole::GpuCommand);
 
-                std::scoped_lock lock{queue.m_access};
-                queue.submits.pop();
+    // When compute worker threads are active the main processor only drains the gfx ring(s),
+    // otherwise it walks every mapped queue as before.
+    const u32 last_qid = compute_threads.empty() ? NumTotalQueues : NumGfxRings;
 
-                --num_submits;
+    while (!stoken.stop_requested()) {
+        if (!WaitForSubmits(stoken, 0, last_qid)) {
+            break;
+        }
+
+        while (HasPendingSubmits(0, last_qid)) {
+            for (u32 qid = 0; qid < last_qid; ++qid) {
+                StepQueue(qid);
             }
         }
 
@@ -74,6 +145,27 @@ void Liverpool::Process(std::stop_token stoken) {
     }
 }
 
+void Liverpool::ProcessComputeWorker(std::stop_token stoken, u32 worker_id, u32 num_workers) {
+    Common::SetCurrentThreadName("GPU_AscProcessor");
+    Common::SetCurrentThreadRole(Common::ThreadRole::GpuCommand);
+
+    // Each worker owns a disjoint, strided subset of the ASC queues, so per-queue
+    // submission order is naturally preserved.
+    const u32 first_qid = NumGfxRings + worker_id;
+
+    while (!stoken.stop_requested()) {
+        if (!WaitForSubmits(stoken, first_qid, NumTotalQueues, num_workers)) {
+            break;
+        }
+
+        while (HasPendingSubmits(first_qid, NumTotalQueues, num_workers)) {
+            for (u32 qid = first_qid; qid < NumTotalQueues; qid += num_workers) {
+                StepQueue(qid);
+            }
+        }
+    }
+}
+
 void Liverpool::WaitGpuIdle() {
     RENDERER_TRACE;
 
@@ -103,12 +195,14 @@ Liverpool::Task Liverpool::ProcessCeUpdate(std::span<const u32> ccb) {
             const auto* write_const = reinterpret_cast<const PM4WriteConstRam*>(header);
             memcpy(cblock.constants_heap.data() + write_const->Offset(), &write_const->data,
                    write_const->Size());
+            cblock.MarkDirty(write_const->Offset(), write_const->Size());
             break;
         }
         case PM4ItOpcode::DumpConstRam: {
             const auto* dump_const = reinterpret_cast<const PM4DumpConstRam*>(header);
-            memcpy(dump_const->Address<void*>(),
-                   cblock.constants_heap.data() + dump_const->Offset(), dump_const->Size());
+            cblock.DumpRam(dump_const->Address<void*>(), dump_const->Offset(),
+                           dump_const->Size());
+            dirty_state |= DirtyGpuMemory;
             break;
         }
         case PM4ItOpcode::IncrementCeCounter: {
@@ -116,12 +210,14 @@ Liverpool::Task Liverpool::ProcessCeUpdate(std::span<const u32> ccb) {
             break;
         }
         case PM4ItOpcode::WaitOnDeCounterDiff: {
-            const auto diff = it_body[0];
-            while ((cblock.de_count - cblock.ce_count) >= diff) {
-                TracyFiberLeave;
-                co_yield {};
-                TracyFiberEnter(ccb_task_name);
-            }
+            // Park until the DE task consumes enough; its counter bump wakes us.
+            TracyFiberLeave;
+            co_await ce_sched.Until(
+                [](const ConstantEngine& cb, u32 diff) {
+                    return (cb.de_count - cb.ce_count) < diff;
+                },
+                it_body[0]);
+            TracyFiberEnter(ccb_task_name);
             break;
         }
         default:
@@ -135,10 +231,119 @@ Liverpool::Task Liverpool::ProcessCeUpdate(std::span<const u32> ccb) {
     TracyFiberLeave;
 }
 
+static constexpr u32 InvalidRegBase = ~0U;
+
+void Liverpool::TrackRegDirty(u32 reg_addr, u32 num_words) {
+    const auto overlaps = [&](u32 base, u32 size) {
+        return reg_addr < base + size && base < reg_addr + num_words;
+    };
+    if (overlaps(GFX6_3D_REG_INDEX(viewports), sizeof(Regs::viewports) / sizeof(u32)) ||
+        overlaps(GFX6_3D_REG_INDEX(viewport_depths), sizeof(Regs::viewport_depths) / sizeof(u32)) ||
+        overlaps(GFX6_3D_REG_INDEX(screen_scissor), sizeof(Regs::screen_scissor) / sizeof(u32)) ||
+        overlaps(GFX6_3D_REG_INDEX(clipper_control), 1)) {
+        dirty_state |= DirtyViewportScissor;
+    }
+    if (overlaps(GFX6_3D_REG_INDEX(blend_constants), sizeof(Regs::blend_constants) / sizeof(u32))) {
+        dirty_state |= DirtyBlendConstants;
+    }
+}
+
+void Liverpool::ProcessContextRegHint(const PM4Header* header, const u32* payload, u32 reg_addr) {
+    // In the case of HW, render target memory has alignment as color block operates on
+    // tiles. There is no information of actual resource extents stored in CB context
+    // regs, so any deduction of it from slices/pitch will lead to a larger surface created.
+    // The same applies to the depth targets. Fortunatelly, the guest always sends
+    // a trailing NOP packet right after the context regs setup, so we can use the heuristic
+    // below and extract the hint to determine actual resource dims.
+
+    switch (reg_addr) {
+    case ContextRegs::CbColor0Base:
+        [[fallthrough]];
+    case ContextRegs::CbColor1Base:
+        [[fallthrough]];
+    case ContextRegs::CbColor2Base:
+        [[fallthrough]];
+    case ContextRegs::CbColor3Base:
+        [[fallthrough]];
+    case ContextRegs::CbColor4Base:
+        [[fallthrough]];
+    case ContextRegs::CbColor5Base:
+        [[fallthrough]];
+    case ContextRegs::CbColor6Base:
+        [[fallthrough]];
+    case ContextRegs::CbColor7Base: {
+        const auto col_buf_id = (reg_addr - ContextRegs::CbColor0Base) /
+                                (ContextRegs::CbColor1Base - ContextRegs::CbColor0Base);
+        ASSERT(col_buf_id < NumColorBuffers);
+
+        const auto nop_offset = header->type3.count;
+        if (nop_offset == 0x0e || nop_offset == 0x0d) {
+            ASSERT_MSG(payload[nop_offset] == 0xc0001000,
+                       "NOP hint is missing in CB setup sequence");
+            last_cb_extent[col_buf_id].raw = payload[nop_offset + 1];
+        } else {
+            last_cb_extent[col_buf_id].raw = 0;
+        }
+        break;
+    }
+    case ContextRegs::DbZInfo: {
+        if (header->type3.count == 8) {
+            ASSERT_MSG(payload[20] == 0xc0001000, "NOP hint is missing in DB setup sequence");
+            last_db_extent.raw = payload[21];
+        } else {
+            last_db_extent.raw = 0;
+        }
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+bool Liverpool::PredicationSkipsDraw() const {
+    if (!predication.active) {
+        return false;
+    }
+    using Operation = PM4CmdSetPredication::Operation;
+    bool visible = true;
+    switch (static_cast<Operation>(predication.op)) {
+    case Operation::Zpass: {
+        // The predicate points at occlusion results: one (begin, end) counter
+        // pair per render backend with bit 63 flagging a written slot. A slot
+        // the GPU has not produced yet leaves the predicate unknown, in which
+        // case the draw proceeds; skipping is only safe on proven-zero samples.
+        static constexpr u32 NumZpassSlots = 8;
+        static constexpr u64 ResultValidBit = 1ULL << 63;
+        const u64* results = reinterpret_cast<const u64*>(predication.addr);
+        u64 samples_passed = 0;
+        for (u32 slot = 0; slot < NumZpassSlots; ++slot) {
+            const u64 begin = results[slot * 2];
+            const u64 end = results[slot * 2 + 1];
+            if (!(begin & ResultValidBit) || !(end & ResultValidBit)) {
+                return false;
+            }
+            samples_passed += (end & ~ResultValidBit) - (begin & ~ResultValidBit);
+        }
+        visible = samples_passed != 0;
+        break;
+    }
+    case Operation::Bool64: {
+        visible = *reinterpret_cast<const u64*>(predication.addr) != 0;
+        break;
+    }
+    default:
+        // PrimCount predicates compare streamout counters; until those queries
+        // are emulated the predicate is unknowable, so never skip on it.
+        return false;
+    }
+    return visible != predication.draw_visible;
+}
+
 Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<const u32> ccb) {
     TracyFiberEnter(dcb_task_name);
 
     cblock.Reset();
+    predication = {};
 
     // TODO: potentially, ASCs also can depend on CE and in this case the
     // CE task should be moved into more global scope
@@ -152,6 +357,23 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
         TracyFiberEnter(dcb_task_name);
     }
 
+    // Maps the Set*Reg opcodes to the base word offset they write, so runs of
+    // register upload packets can share one validation and copy loop.
+    const auto set_reg_base = [](PM4ItOpcode opcode) -> u32 {
+        switch (opcode) {
+        case PM4ItOpcode::SetConfigReg:
+            return ConfigRegWordOffset;
+        case PM4ItOpcode::SetContextReg:
+            return ContextRegWordOffset;
+        case PM4ItOpcode::SetShReg:
+            return ShRegWordOffset;
+        case PM4ItOpcode::SetUconfigReg:
+            return UconfigRegWordOffset;
+        default:
+            return InvalidRegBase;
+        }
+    };
+
     while (!dcb.empty()) {
         const auto* header = reinterpret_cast<const PM4Header*>(dcb.data());
         const u32 type = header->type;
@@ -161,7 +383,41 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
         }
 
         const u32 count = header->type3.NumWords();
+        ASSERT_MSG(count + 1 <= dcb.size(), "PM4 packet {} spans past the end of the buffer",
+                   static_cast<u32>(header->type3.opcode.Value()));
         const PM4ItOpcode opcode = header->type3.opcode;
+
+        // Register uploads arrive as bursts of thousands of dwords per frame. Copy
+        // whole runs of Set*Reg packets into the register file in one pass instead
+        // of taking the opcode switch for each packet of the burst.
+        if (set_reg_base(opcode) != InvalidRegBase) {
+            size_t consumed = 0;
+            while (consumed < dcb.size()) {
+                const auto* pkt = reinterpret_cast<const PM4Header*>(dcb.data() + consumed);
+                if (pkt->type != 3) {
+                    break;
+                }
+                const u32 base = set_reg_base(pkt->type3.opcode);
+                if (base == InvalidRegBase) {
+                    break;
+                }
+                const u32 num_words = pkt->type3.NumWords();
+                ASSERT_MSG(consumed + num_words + 1 <= dcb.size(),
+                           "PM4 register write spans past the end of the buffer");
+                const auto* set_data = reinterpret_cast<const PM4CmdSetData*>(pkt);
+                const auto* payload = reinterpret_cast<const u32*>(pkt + 2);
+                const u32 reg_addr = base + set_data->reg_offset;
+                std::memcpy(&regs.reg_array[reg_addr], payload, (num_words - 1) * sizeof(u32));
+                TrackRegDirty(reg_addr, num_words - 1);
+                if (base == ContextRegWordOffset) {
+                    ProcessContextRegHint(pkt, payload, reg_addr);
+                }
+                consumed += num_words + 1;
+            }
+            dcb = dcb.subspan(consumed);
+            continue;
+        }
+
         switch (opcode) {
         case PM4ItOpcode::Nop: {
             const auto* nop = reinterpret_cast<const PM4CmdNop*>(header);
@@ -187,82 +443,26 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
         case PM4ItOpcode::ClearState: {
             break;
         }
-        case PM4ItOpcode::SetConfigReg: {
-            const auto* set_data = reinterpret_cast<const PM4CmdSetData*>(header);
-            const auto reg_addr = ConfigRegWordOffset + set_data->reg_offset;
-            const auto* payload = reinterpret_cast<const u32*>(header + 2);
-            std::memcpy(&regs.reg_array[reg_addr], payload, (count - 1) * sizeof(u32));
-            break;
-        }
-        case PM4ItOpcode::SetContextReg: {
-            const auto* set_data = reinterpret_cast<const PM4CmdSetData*>(header);
-            const auto reg_addr = ContextRegWordOffset + set_data->reg_offset;
-            const auto* payload = reinterpret_cast<const u32*>(header + 2);
-
-            std::memcpy(&regs.reg_array[reg_addr], payload, (count - 1) * sizeof(u32));
-
-            // In the case of HW, render target memory has alignment as color block operates on
-            // tiles. There is no information of actual resource extents stored in CB context
-            // regs, so any deduction of it from slices/pitch will lead to a larger surface created.
-            // The same applies to the depth targets. Fortunatelly, the guest always sends
-            // a trailing NOP packet right after the context regs setup, so we can use the heuristic
-            // below and extract the hint to determine actual resource dims.
-
-            switch (reg_addr) {
-            case ContextRegs::CbColor0Base:
-                [[fallthrough]];
-            case ContextRegs::CbColor1Base:
-                [[fallthrough]];
-            case ContextRegs::CbColor2Base:
-                [[fallthrough]];
-            case ContextRegs::CbColor3Base:
-                [[fallthrough]];
-            case ContextRegs::CbColor4Base:
-                [[fallthrough]];
-            case ContextRegs::CbColor5Base:
-                [[fallthrough]];
-            case ContextRegs::CbColor6Base:
-                [[fallthrough]];
-            case ContextRegs::CbColor7Base: {
-                const auto col_buf_id = (reg_addr - ContextRegs::CbColor0Base) /
-                                        (ContextRegs::CbColor1Base - ContextRegs::CbColor0Base);
-                ASSERT(col_buf_id < NumColorBuffers);
-
-                const auto nop_offset = header->type3.count;
-                if (nop_offset == 0x0e || nop_offset == 0x0d) {
-                    ASSERT_MSG(payload[nop_offset] == 0xc0001000,
-                               "NOP hint is missing in CB setup sequence");
-                    last_cb_extent[col_buf_id].raw = payload[nop_offset + 1];
-                } else {
-                    last_cb_extent[col_buf_id].raw = 0;
-                }
-                break;
-            }
-            case ContextRegs::DbZInfo: {
-                if (header->type3.count == 8) {
-                    ASSERT_MSG(payload[20] == 0xc0001000,
-                               "NOP hint is missing in DB setup sequence");
-                    last_db_extent.raw = payload[21];
-                } else {
-                    last_db_extent.raw = 0;
-                }
+        case PM4ItOpcode::SetPredication: {
+            const auto* pred = reinterpret_cast<const PM4CmdSetPredication*>(header);
+            using Operation = PM4CmdSetPredication::Operation;
+            if (pred->pred_op.Value() == Operation::Clear || pred->Address() == 0) {
+                predication = {};
                 break;
             }
-            default:
+            if (pred->continue_bit) {
+                // A continued predicate ORs several query buffers together; tracking
+                // only the first address could drop visible draws, so the chain
+                // disables predication instead. Skipping less is always safe.
+                predication = {};
                 break;
             }
-            break;
-        }
-        case PM4ItOpcode::SetShReg: {
-            const auto* set_data = reinterpret_cast<const PM4CmdSetData*>(header);
-            std::memcpy(&regs.reg_array[ShRegWordOffset + set_data->reg_offset], header + 2,
-                        (count - 1) * sizeof(u32));
-            break;
-        }
-        case PM4ItOpcode::SetUconfigReg: {
-            const auto* set_data = reinterpret_cast<const PM4CmdSetData*>(header);
-            std::memcpy(&regs.reg_array[UconfigRegWordOffset + set_data->reg_offset], header + 2,
-                        (count - 1) * sizeof(u32));
+            predication = {
+                .addr = pred->Address(),
+                .op = static_cast<u32>(pred->pred_op.Value()),
+                .draw_visible = pred->pred_bool.Value() != 0,
+                .active = true,
+            };
             break;
         }
         case PM4ItOpcode::IndexType: {
@@ -277,7 +477,7 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
             regs.index_base_address.base_addr_hi.Assign(draw_index->index_base_hi);
             regs.num_indices = draw_index->index_count;
             regs.draw_initiator = draw_index->draw_initiator;
-            if (rasterizer) {
+            if (rasterizer && !PredicationSkipsDraw()) {
                 rasterizer->Draw(true);
             }
             break;
@@ -287,7 +487,7 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
             regs.max_index_size = draw_index_off->max_size;
             regs.num_indices = draw_index_off->index_count;
             regs.draw_initiator = draw_index_off->draw_initiator;
-            if (rasterizer) {
+            if (rasterizer && !PredicationSkipsDraw()) {
                 rasterizer->Draw(true, draw_index_off->index_offset);
             }
             break;
@@ -296,7 +496,7 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
             const auto* draw_index = reinterpret_cast<const PM4CmdDrawIndexAuto*>(header);
             regs.num_indices = draw_index->index_count;
             regs.draw_initiator = draw_index->draw_initiator;
-            if (rasterizer) {
+            if (rasterizer && !PredicationSkipsDraw()) {
                 rasterizer->Draw(false);
             }
             break;
@@ -339,11 +539,42 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
         }
         case PM4ItOpcode::EventWriteEop: {
             const auto* event_eop = reinterpret_cast<const PM4CmdEventWriteEop*>(header);
-            event_eop->SignalFence();
+            if (rasterizer) {
+                // Write the release-mem label back only once the GPU timeline
+                // reaches this point, so guest polls on label memory observe
+                // real completion without the emulator draining its queues.
+                // The packet is copied as the guest ring may be reused before
+                // the signal fires.
+                rasterizer->SignalFence([packet = *event_eop] { packet.SignalFence(); });
+            } else {
+                event_eop->SignalFence();
+            }
             break;
         }
         case PM4ItOpcode::DmaData: {
             const auto* dma_data = reinterpret_cast<const PM4DmaData*>(header);
+            const u32 num_bytes = dma_data->command & 0x1fffffu;
+            if (num_bytes == 0) {
+                break;
+            }
+            const VAddr dst_addr =
+                dma_data->dst_addr_lo | (VAddr(dma_data->dst_addr_hi & 0xffff) << 32);
+            if (dma_data->src_sel == 2u) {
+                // Immediate data as source fills the destination with one dword.
+                std::fill_n(reinterpret_cast<u32*>(dst_addr), num_bytes >> 2, dma_data->data);
+                dirty_state |= DirtyGpuMemory;
+                break;
+            }
+            const VAddr src_addr =
+                dma_data->src_addr_lo | (VAddr(dma_data->src_addr_hi & 0xffff) << 32);
+            // When both endpoints live in tracked device buffers the transfer is recorded
+            // as a vkCmdCopyBuffer and never touches the CPU; the host copy of the
+            // destination goes stale, which only matters if the CPU reads it back.
+            if (!rasterizer || !rasterizer->CpDmaCopy(dst_addr, src_addr, num_bytes)) {
+                std::memcpy(reinterpret_cast<void*>(dst_addr),
+                            reinterpret_cast<const void*>(src_addr), num_bytes);
+                dirty_state |= DirtyGpuMemory;
+            }
             break;
         }
         case PM4ItOpcode::WriteData: {
@@ -352,6 +583,7 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
             const u32 data_size = (header->type3.count.Value() - 2) * 4;
             if (!write_data->wr_one_addr.Value()) {
                 std::memcpy(write_data->Address<void*>(), write_data->data, data_size);
+                dirty_state |= DirtyGpuMemory;
             } else {
                 UNREACHABLE();
             }
@@ -373,12 +605,16 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
         }
         case PM4ItOpcode::IncrementDeCounter: {
             ++cblock.de_count;
+            // Wake the CE task if this bump satisfied its watermark wait.
+            TracyFiberLeave;
+            ce_sched.Notify();
+            TracyFiberEnter(dcb_task_name);
             break;
         }
         case PM4ItOpcode::WaitOnCeCounter: {
             while (cblock.ce_count <= cblock.de_count) {
                 TracyFiberLeave;
-                ce_task.handle.resume();
+                ce_sched.Run(ce_task.handle);
                 TracyFiberEnter(dcb_task_name);
             }
             break;
@@ -398,10 +634,40 @@ Liverpool::Task Liverpool::ProcessGraphics(std::span<const u32> dcb, std::span<c
     TracyFiberLeave;
 }
 
+Liverpool::Task Liverpool::ProcessGfxBatch(boost::container::small_vector<GfxBufferPair, 8> pairs) {
+    // Trampoline the per-pair task so a whole multi-buffer submit occupies a single
+    // queue slot and is retired as one unit; inner suspensions (e.g. WaitRegMem)
+    // are propagated to StepQueue.
+    for (const auto& pair : pairs) {
+        auto task = ProcessGraphics(pair.dcb, pair.ccb);
+        while (true) {
+            task.handle.resume();
+            if (task.handle.done()) {
+                break;
+            }
+            co_yield {};
+        }
+        task.handle.destroy();
+    }
+}
+
 Liverpool::Task Liverpool::ProcessCompute(std::span<const u32> acb) {
     TracyFiberEnter(acb_task_name);
 
+    // Long dispatch batches would otherwise hold the execution lock for their
+    // entire slice, delaying flip-critical graphics submissions. Suspending
+    // every so many packets while the gfx ring has work bounds that latency;
+    // the consumer loop resumes the compute task on its next pass.
+    constexpr u32 PreemptionInterval = 128;
+    u32 packets_since_yield = 0;
+
     while (!acb.empty()) {
+        if (++packets_since_yield >= PreemptionInterval && HasPendingSubmits(0, NumGfxRings)) {
+            packets_since_yield = 0;
+            TracyFiberLeave;
+            co_yield {};
+            TracyFiberEnter(acb_task_name);
+        }
         const auto* header = reinterpret_cast<const PM4Header*>(acb.data());
         const u32 type = header->type;
         if (type != 3) {
@@ -488,33 +754,59 @@ Liverpool::Task Liverpool::ProcessCompute(std::span<const u32> acb) {
 }
 
 void Liverpool::SubmitGfx(std::span<const u32> dcb, std::span<const u32> ccb) {
+    const GfxBufferPair pair{dcb, ccb};
+    SubmitGfx(std::span{&pair, 1});
+}
+
+void Liverpool::SubmitGfx(std::span<const GfxBufferPair> pairs) {
     static constexpr u32 GfxQueueId = 0u;
     auto& queue = mapped_queues[GfxQueueId];
 
-    auto task = ProcessGraphics(dcb, ccb);
-    {
-        std::unique_lock lock{queue.m_access};
-        queue.submits.emplace(task.handle);
+    if (pairs.empty()) {
+        return;
+    }
+
+    if (Config::capturePM4()) {
+        auto* capture = Common::Singleton<Pm4Capture>::Instance();
+        for (const auto& [dcb, ccb] : pairs) {
+            capture->RecordGfx(dcb, ccb);
+        }
     }
 
+    // Creating the task allocates its frame from submit_arena; holding
+    // submit_mutex orders the allocation against the arena rewind in
+    // NotifySubmitDone().
     std::scoped_lock lk{submit_mutex};
+    auto task = ProcessGfxBatch({pairs.begin(), pairs.end()});
+    // Account for the submit before pushing so consumers never retire a task they
+    // haven't been charged with yet; a transiently failed pop is retried by the poll loop.
     ++num_submits;
-    submit_cv.notify_one();
+    ++queue.pending;
+    queue.submits.EmplaceWait(task.handle);
+
+    if (num_idle_consumers != 0) {
+        submit_cv.notify_all();
+    }
 }
 
 void Liverpool::SubmitAsc(u32 vqid, std::span<const u32> acb) {
     ASSERT_MSG(vqid >= 0 && vqid < NumTotalQueues, "Invalid virtual ASC queue index");
     auto& queue = mapped_queues[vqid];
 
-    const auto& task = ProcessCompute(acb);
-    {
-        std::unique_lock lock{queue.m_access};
-        queue.submits.emplace(task.handle);
+    if (Config::capturePM4()) {
+        Common::Singleton<Pm4Capture>::Instance()->RecordAsc(vqid, acb);
     }
 
+    // See SubmitGfx for why task creation happens under submit_mutex.
     std::scoped_lock lk{submit_mutex};
+    const auto& task = ProcessCompute(acb);
     ++num_submits;
-    submit_cv.notify_one();
+    ++queue.pending;
+    queue.submits.EmplaceWait(task.handle);
+
+    if (num_idle_consumers != 0) {
+        submit_cv.notify_all();
+    }
 }
 
 } // namespace AmdGpu
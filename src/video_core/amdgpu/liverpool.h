@@ -3,19 +3,25 @@
 
 #pragma once
 
+#include <boost/container/small_vector.hpp>
+#include "common/arena.h"
 #include "common/assert.h"
 #include "common/bit_field.h"
+#include "common/bounded_threadsafe_queue.h"
 #include "common/types.h"
 #include "resource.h"
 #include "video_core/amdgpu/pixel_format.h"
 
 #include <array>
+#include <atomic>
 #include <condition_variable>
 #include <coroutine>
+#include <cstring>
 #include <mutex>
 #include <span>
 #include <thread>
-#include <queue>
+#include <utility>
+#include <vector>
 
 namespace Vulkan {
 class Rasterizer;
@@ -23,6 +29,8 @@ class Rasterizer;
 
 namespace AmdGpu {
 
+union PM4Header;
+
 #define GFX6_3D_REG_INDEX(field_name) (offsetof(AmdGpu::Liverpool::Regs, field_name) / sizeof(u32))
 
 #define CONCAT2(x, y) DO_CONCAT2(x, y)
@@ -935,7 +943,14 @@ public:
     Liverpool();
     ~Liverpool();
 
+    /// One dcb/ccb pair of a (potentially multi-buffer) guest submit call.
+    struct GfxBufferPair {
+        std::span<const u32> dcb;
+        std::span<const u32> ccb;
+    };
+
     void SubmitGfx(std::span<const u32> dcb, std::span<const u32> ccb);
+    void SubmitGfx(std::span<const GfxBufferPair> pairs);
     void SubmitAsc(u32 vqid, std::span<const u32> acb);
 
     void WaitGpuIdle();
@@ -947,6 +962,12 @@ public:
     void NotifySubmitDone() {
         std::scoped_lock lk{submit_mutex};
         submit_done = true;
+        // Once the GPU is idle every submit task frame has been retired, so
+        // the arena backing them can be rewound for the next frame. Tasks are
+        // created under submit_mutex, so none can appear concurrently.
+        if (IsGpuIdle()) {
+            submit_arena.Reset();
+        }
         submit_cv.notify_all();
     }
 
@@ -954,6 +975,18 @@ public:
         rasterizer = rasterizer_;
     }
 
+    // Dirty masks maintained at PM4 register-write time so the rasterizer only
+    // re-emits the dynamic state groups that changed since the previous draw.
+    enum DirtyState : u32 {
+        DirtyViewportScissor = 1 << 0,
+        DirtyBlendConstants = 1 << 1,
+        // A PM4 packet has written guest memory since the previous draw, so
+        // resource uploads recorded for it can no longer be reused.
+        DirtyGpuMemory = 1 << 2,
+        DirtyAll = 0xFFFFFFFFU,
+    };
+    u32 dirty_state = DirtyAll;
+
 private:
     struct Task {
         struct promise_type {
@@ -977,6 +1010,14 @@ private:
             std::suspend_always yield_value(empty&&) {
                 return {};
             }
+
+            // Task frames churn at every submit; carve them out of the frame
+            // arena instead of the heap and let the rewind in
+            // NotifySubmitDone() reclaim them wholesale.
+            static void* operator new(std::size_t size) {
+                return submit_arena.Allocate(size);
+            }
+            static void operator delete(void*, std::size_t) {}
         };
 
         using Handle = std::coroutine_handle<promise_type>;
@@ -984,14 +1025,33 @@ private:
     };
 
     Task ProcessGraphics(std::span<const u32> dcb, std::span<const u32> ccb);
+    Task ProcessGfxBatch(boost::container::small_vector<GfxBufferPair, 8> pairs);
     Task ProcessCeUpdate(std::span<const u32> ccb);
     Task ProcessCompute(std::span<const u32> acb);
 
     void Process(std::stop_token stoken);
+    void ProcessComputeWorker(std::stop_token stoken, u32 worker_id, u32 num_workers);
+
+    /// Applies the trailing NOP extent hints of CB/DB context register uploads.
+    void ProcessContextRegHint(const PM4Header* header, const u32* payload, u32 reg_addr);
+
+    /// Flags the dynamic state groups covered by a register write as dirty.
+    void TrackRegDirty(u32 reg_addr, u32 num_words);
+    bool HasPendingSubmits(u32 first_qid, u32 last_qid, u32 stride = 1);
+    bool StepQueue(u32 qid);
+
+    /// Waits until the queue range has work, spinning briefly (or indefinitely in
+    /// busy-poll mode) before falling back to submit_cv. Returns false on stop.
+    bool WaitForSubmits(std::stop_token& stoken, u32 first_qid, u32 last_qid, u32 stride = 1);
 
     struct GpuQueue {
-        std::mutex m_access{};
-        std::queue<Task::Handle> submits{};
+        // Submissions in flight are bounded by the ring the driver maps for the queue,
+        // so a modest capacity suffices before producers have to wait.
+        static constexpr size_t MaxPendingSubmits = 512;
+
+        Common::MPSCQueue<Task::Handle, MaxPendingSubmits> submits{};
+        std::atomic<u32> pending{}; // Pushed minus retired, emptiness check for consumers.
+        Task::Handle current{};     // Task being stepped, only touched by the owning consumer.
     };
     std::array<GpuQueue, NumTotalQueues> mapped_queues{};
 
@@ -1000,6 +1060,8 @@ private:
             ce_count = 0;
             de_count = 0;
             ce_compare_count = 0;
+            dirty_ranges.clear();
+            last_dump_dest = nullptr;
         }
 
         [[nodiscard]] u32 Diff() const {
@@ -1007,18 +1069,160 @@ private:
             return ce_count - de_count;
         }
 
+        /// Records a CE RAM write, coalescing it with overlapping or adjacent
+        /// spans so the dirty list stays short and sorted.
+        void MarkDirty(u32 offset, u32 size) {
+            u32 begin = offset;
+            u32 end = offset + size;
+            auto it = dirty_ranges.begin();
+            while (it != dirty_ranges.end() && it->second < begin) {
+                ++it;
+            }
+            while (it != dirty_ranges.end() && it->first <= end) {
+                begin = std::min(begin, it->first);
+                end = std::max(end, it->second);
+                it = dirty_ranges.erase(it);
+            }
+            dirty_ranges.insert(it, {begin, end});
+        }
+
+        /// Applies a IT_DUMP_CONST_RAM window to guest memory. A repeat dump of
+        /// the same window to the same destination copies only the spans written
+        /// since the previous dump; anything else falls back to a full copy.
+        void DumpRam(void* dest, u32 offset, u32 size) {
+            u8* const out = static_cast<u8*>(dest);
+            const bool same_window =
+                dest == last_dump_dest && offset == last_dump_offset && size == last_dump_size;
+            if (!same_window) {
+                std::memcpy(out, constants_heap.data() + offset, size);
+            } else {
+                for (const auto& [begin, end] : dirty_ranges) {
+                    const u32 copy_begin = std::max(begin, offset);
+                    const u32 copy_end = std::min(end, offset + size);
+                    if (copy_begin < copy_end) {
+                        std::memcpy(out + (copy_begin - offset),
+                                    constants_heap.data() + copy_begin, copy_end - copy_begin);
+                    }
+                }
+            }
+            last_dump_dest = dest;
+            last_dump_offset = offset;
+            last_dump_size = size;
+            ClearDirty(offset, offset + size);
+        }
+
         u32 ce_compare_count{};
         u32 ce_count{};
         u32 de_count{};
         static std::array<u8, 48_KB> constants_heap;
+
+    private:
+        /// Removes the dumped window from the dirty list, keeping the parts of
+        /// spans that stick out on either side.
+        void ClearDirty(u32 window_begin, u32 window_end) {
+            boost::container::small_vector<std::pair<u32, u32>, 16> kept;
+            for (const auto& [begin, end] : dirty_ranges) {
+                if (begin < window_begin) {
+                    kept.emplace_back(begin, std::min(end, window_begin));
+                }
+                if (end > window_end) {
+                    kept.emplace_back(std::max(begin, window_end), end);
+                }
+            }
+            dirty_ranges = std::move(kept);
+        }
+
+        /// Sorted, non-overlapping CE RAM spans written since the last dump.
+        boost::container::small_vector<std::pair<u32, u32>, 16> dirty_ranges;
+        const void* last_dump_dest{};
+        u32 last_dump_offset{};
+        u32 last_dump_size{};
     } cblock{};
 
+    /// Backs the coroutine frames of submit tasks; rewound between frames.
+    static Common::BumpArena submit_arena;
+
+    /// Cooperative scheduler for the tasks of one submit. A task parks itself
+    /// on a predicate over the CE/DE counters and is resumed by Notify() once
+    /// a counter bump satisfies it, replacing the resume/re-suspend ping-pong
+    /// the DE loop used to run per packet while a watermark was unmet.
+    class CeScheduler {
+    public:
+        explicit CeScheduler(ConstantEngine& cblock_) : cblock{cblock_} {}
+
+        using Predicate = bool (*)(const ConstantEngine&, u32 arg);
+
+        struct Awaiter {
+            CeScheduler& sched;
+            Predicate pred;
+            u32 arg;
+
+            bool await_ready() const {
+                return pred(sched.cblock, arg);
+            }
+            void await_suspend(std::coroutine_handle<> handle) {
+                ASSERT_MSG(!sched.parked.handle, "Only one task can park on the counters");
+                sched.parked = {handle, pred, arg};
+            }
+            void await_resume() const {}
+        };
+
+        /// Suspends the calling task until pred(cblock, arg) holds.
+        Awaiter Until(Predicate pred, u32 arg = 0) {
+            return Awaiter{*this, pred, arg};
+        }
+
+        /// Resumes the parked task if a counter bump made its wait condition true.
+        void Notify() {
+            if (parked.handle && parked.pred(cblock, parked.arg)) {
+                const auto handle = std::exchange(parked.handle, {});
+                handle.resume();
+            }
+        }
+
+        /// Steps a task that must be runnable; a parked sibling here means the
+        /// counters can never advance.
+        void Run(Task::Handle handle) {
+            ASSERT_MSG(!parked.handle, "Stepping a task while its sibling is parked");
+            handle.resume();
+        }
+
+    private:
+        struct Parked {
+            std::coroutine_handle<> handle{};
+            Predicate pred{};
+            u32 arg{};
+        };
+        ConstantEngine& cblock;
+        Parked parked{};
+    };
+    CeScheduler ce_sched{cblock};
+
+    // Predicate state set by IT_SET_PREDICATION; evaluated CPU-side per draw
+    // since the predicate buffer lives in host-resident guest memory. Only the
+    // gfx queue issues the packet, so plain members are safe.
+    struct Predication {
+        VAddr addr{};
+        u32 op{}; ///< PM4CmdSetPredication::Operation
+        bool draw_visible{};
+        bool active{};
+    } predication{};
+
+    /// Returns true when the active predicate proves the next draw invisible.
+    bool PredicationSkipsDraw() const;
+
     Vulkan::Rasterizer* rasterizer{};
     std::jthread process_thread{};
-    u32 num_submits{};
+    std::atomic<u32> num_submits{};
     std::mutex submit_mutex;
     std::condition_variable_any submit_cv;
     std::atomic<bool> submit_done{};
+    // Consumers waiting on submit_cv; producers only take submit_mutex to wake them.
+    std::atomic<u32> num_idle_consumers{};
+    // Tasks mutate the shared register file and record into the same rasterizer, so execution
+    // is serialized; threading still overlaps fence waits of independent ASC queues.
+    std::mutex exec_mutex;
+    std::vector<std::jthread> compute_threads{};
 };
 
 static_assert(GFX6_3D_REG_INDEX(ps_program) == 0x2C08);
@@ -2,9 +2,15 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <array>
+#include <cmath>
+#include <cstring>
 #include "common/assert.h"
 #include "video_core/amdgpu/pixel_format.h"
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 namespace AmdGpu {
 
 std::string_view NameOf(NumberFormat fmt) {
@@ -66,4 +72,126 @@ int NumBits(DataFormat format) {
     return num_bits_per_element[index];
 }
 
+namespace {
+
+// Byte-wide gamma transfer is a 256-entry table per direction; a table lookup
+// beats gather-based SIMD for this width, so only the layout-changing kernels
+// below use vector code.
+const std::array<u8, 256>& SrgbToUnormLut() {
+    static const auto lut = [] {
+        std::array<u8, 256> table{};
+        for (u32 i = 0; i < table.size(); i++) {
+            const float srgb = i / 255.0f;
+            const float linear =
+                srgb <= 0.04045f ? srgb / 12.92f : std::pow((srgb + 0.055f) / 1.055f, 2.4f);
+            table[i] = static_cast<u8>(std::lround(linear * 255.0f));
+        }
+        return table;
+    }();
+    return lut;
+}
+
+const std::array<u8, 256>& UnormToSrgbLut() {
+    static const auto lut = [] {
+        std::array<u8, 256> table{};
+        for (u32 i = 0; i < table.size(); i++) {
+            const float linear = i / 255.0f;
+            const float srgb = linear <= 0.0031308f
+                                   ? linear * 12.92f
+                                   : 1.055f * std::pow(linear, 1.0f / 2.4f) - 0.055f;
+            table[i] = static_cast<u8>(std::lround(srgb * 255.0f));
+        }
+        return table;
+    }();
+    return lut;
+}
+
+void ConvertGamma8888(u8* dst, const u8* src, size_t count, const std::array<u8, 256>& lut) {
+    for (size_t i = 0; i < count; i++) {
+        dst[0] = lut[src[0]];
+        dst[1] = lut[src[1]];
+        dst[2] = lut[src[2]];
+        dst[3] = src[3]; // Alpha is linear in both encodings.
+        dst += 4;
+        src += 4;
+    }
+}
+
+void ConvertSrgbToUnorm8888(u8* dst, const u8* src, size_t count) {
+    ConvertGamma8888(dst, src, count, SrgbToUnormLut());
+}
+
+void ConvertUnormToSrgb8888(u8* dst, const u8* src, size_t count) {
+    ConvertGamma8888(dst, src, count, UnormToSrgbLut());
+}
+
+void ConvertUnorm565To8888(u8* dst, const u8* src, size_t count) {
+    size_t i = 0;
+#ifdef __SSE2__
+    // Expand eight texels per iteration: split out the 5/6/5 fields, rescale
+    // them to 8 bits with the usual (x * 527 + 23) >> 6 / (x * 259 + 33) >> 6
+    // fixed-point factors and interleave with opaque alpha.
+    for (; i + 8 <= count; i += 8) {
+        const __m128i texels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+        const __m128i r5 = _mm_srli_epi16(texels, 11);
+        const __m128i g6 = _mm_and_si128(_mm_srli_epi16(texels, 5), _mm_set1_epi16(0x3F));
+        const __m128i b5 = _mm_and_si128(texels, _mm_set1_epi16(0x1F));
+        const __m128i r8 =
+            _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(r5, _mm_set1_epi16(527)),
+                                         _mm_set1_epi16(23)),
+                           6);
+        const __m128i g8 =
+            _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(g6, _mm_set1_epi16(259)),
+                                         _mm_set1_epi16(33)),
+                           6);
+        const __m128i b8 =
+            _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(b5, _mm_set1_epi16(527)),
+                                         _mm_set1_epi16(23)),
+                           6);
+        const __m128i rg = _mm_or_si128(r8, _mm_slli_epi16(g8, 8));
+        const __m128i ba = _mm_or_si128(b8, _mm_set1_epi16(static_cast<s16>(0xFF00)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), _mm_unpacklo_epi16(rg, ba));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4 + 16),
+                         _mm_unpackhi_epi16(rg, ba));
+    }
+#endif
+    for (; i < count; i++) {
+        u16 texel;
+        std::memcpy(&texel, src + i * 2, sizeof(texel));
+        dst[i * 4 + 0] = static_cast<u8>((((texel >> 11) & 0x1F) * 527 + 23) >> 6);
+        dst[i * 4 + 1] = static_cast<u8>((((texel >> 5) & 0x3F) * 259 + 33) >> 6);
+        dst[i * 4 + 2] = static_cast<u8>(((texel & 0x1F) * 527 + 23) >> 6);
+        dst[i * 4 + 3] = 0xFF;
+    }
+}
+
+struct ConverterEntry {
+    DataFormat data_format;
+    NumberFormat src_format;
+    NumberFormat dst_format;
+    PixelConverter converter;
+};
+
+constexpr std::array ConverterTable = {
+    ConverterEntry{DataFormat::Format8_8_8_8, NumberFormat::Srgb, NumberFormat::Unorm,
+                   &ConvertSrgbToUnorm8888},
+    ConverterEntry{DataFormat::Format8_8_8_8, NumberFormat::Unorm, NumberFormat::Srgb,
+                   &ConvertUnormToSrgb8888},
+    ConverterEntry{DataFormat::Format5_6_5, NumberFormat::Unorm, NumberFormat::Unorm,
+                   &ConvertUnorm565To8888},
+};
+
+} // Anonymous namespace
+
+PixelConverter GetConverter(DataFormat data_format, NumberFormat src_format,
+                            NumberFormat dst_format) {
+    for (const auto& entry : ConverterTable) {
+        if (entry.data_format == data_format && entry.src_format == src_format &&
+            entry.dst_format == dst_format) {
+            return entry.converter;
+        }
+    }
+    return nullptr;
+}
+
 } // namespace AmdGpu
@@ -66,6 +66,16 @@ enum class NumberFormat : u32 {
 int NumComponents(DataFormat format);
 int NumBits(DataFormat format);
 
+/// Signature of a CPU-side pixel conversion kernel. Converts count texels from
+/// src to dst; the buffers must not overlap.
+using PixelConverter = void (*)(u8* dst, const u8* src, size_t count);
+
+/// Returns the conversion kernel for the given format pair, or nullptr when no
+/// CPU kernel exists. Expansion kernels (e.g. Format5_6_5) write tightly packed
+/// 8_8_8_8 texels.
+[[nodiscard]] PixelConverter GetConverter(DataFormat data_format, NumberFormat src_format,
+                                          NumberFormat dst_format);
+
 } // namespace AmdGpu
 
 template <>
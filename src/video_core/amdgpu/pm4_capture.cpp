@@ -0,0 +1,130 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <deque>
+#include <vector>
+#include "common/logging/log.h"
+#include "common/path_util.h"
+#include "video_core/amdgpu/liverpool.h"
+#include "video_core/amdgpu/pm4_capture.h"
+
+namespace AmdGpu {
+
+constexpr u32 CaptureMagic = 0x43344D50; // 'PM4C'
+constexpr u32 CaptureVersion = 1;
+
+enum RecordKind : u32 {
+    KindGfx = 0,
+    KindAsc = 1,
+};
+
+// One per captured buffer (pair); the dword payloads follow back to back.
+struct RecordHeader {
+    u32 kind;
+    u32 vqid;
+    u32 first_dw;
+    u32 second_dw;
+};
+
+bool Pm4Capture::EnsureOpen() {
+    if (file.IsOpen()) {
+        return true;
+    }
+    if (open_failed) {
+        return false;
+    }
+    const auto dump_dir = Common::FS::GetUserPath(Common::FS::PathType::PM4Dir);
+    if (!std::filesystem::exists(dump_dir)) {
+        std::filesystem::create_directories(dump_dir);
+    }
+    file.Open(dump_dir / "stream.pm4c", Common::FS::FileAccessMode::Write);
+    if (!file.IsOpen()) {
+        LOG_ERROR(Render, "Unable to open PM4 capture file for writing");
+        open_failed = true;
+        return false;
+    }
+    file.Write(CaptureMagic);
+    file.Write(CaptureVersion);
+    return true;
+}
+
+void Pm4Capture::Write(u32 kind, u32 vqid, std::span<const u32> first,
+                       std::span<const u32> second) {
+    std::scoped_lock lock{mutex};
+    if (!EnsureOpen()) {
+        return;
+    }
+    const RecordHeader header{
+        .kind = kind,
+        .vqid = vqid,
+        .first_dw = static_cast<u32>(first.size()),
+        .second_dw = static_cast<u32>(second.size()),
+    };
+    file.Write(header);
+    file.WriteSpan(first);
+    file.WriteSpan(second);
+}
+
+void Pm4Capture::RecordGfx(std::span<const u32> dcb, std::span<const u32> ccb) {
+    Write(KindGfx, 0, dcb, ccb);
+}
+
+void Pm4Capture::RecordAsc(u32 vqid, std::span<const u32> acb) {
+    Write(KindAsc, vqid, acb, {});
+}
+
+bool Pm4Capture::Replay(const std::filesystem::path& path, Liverpool& liverpool) {
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read};
+    if (!file.IsOpen()) {
+        LOG_ERROR(Render, "Unable to open PM4 capture {}", path.string());
+        return false;
+    }
+
+    u32 magic{};
+    u32 version{};
+    file.Read(magic);
+    file.Read(version);
+    if (magic != CaptureMagic || version != CaptureVersion) {
+        LOG_ERROR(Render, "File {} is not a version {} PM4 capture", path.string(),
+                  CaptureVersion);
+        return false;
+    }
+
+    // Buffers must stay alive until the processor drains every submit, so they
+    // are owned here and submitted as spans just like live submissions.
+    std::deque<std::vector<u32>> storage;
+    const u64 size = file.GetSize();
+    u32 num_records = 0;
+    while (static_cast<u64>(file.Tell()) + sizeof(RecordHeader) <= size) {
+        RecordHeader header{};
+        file.Read(header);
+        if (static_cast<u64>(file.Tell()) + (u64(header.first_dw) + header.second_dw) * sizeof(u32) >
+            size) {
+            LOG_ERROR(Render, "PM4 capture {} is truncated", path.string());
+            return false;
+        }
+        auto& first = storage.emplace_back(header.first_dw);
+        file.ReadSpan<u32>(first);
+        auto& second = storage.emplace_back(header.second_dw);
+        file.ReadSpan<u32>(second);
+
+        switch (header.kind) {
+        case KindGfx:
+            liverpool.SubmitGfx(first, second);
+            break;
+        case KindAsc:
+            liverpool.SubmitAsc(header.vqid, first);
+            break;
+        default:
+            LOG_ERROR(Render, "Unknown record kind {} in PM4 capture", header.kind);
+            return false;
+        }
+        ++num_records;
+    }
+
+    liverpool.WaitGpuIdle();
+    LOG_INFO(Render, "Replayed {} submits from {}", num_records, path.string());
+    return true;
+}
+
+} // namespace AmdGpu
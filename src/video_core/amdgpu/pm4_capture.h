@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <filesystem>
+#include <mutex>
+#include <span>
+#include "common/io_file.h"
+#include "common/types.h"
+
+namespace AmdGpu {
+
+class Liverpool;
+
+/**
+ * Streaming capture of submitted PM4 command buffers and their replay. Every
+ * gfx pair and ASC buffer is appended to one file in submission order, so a
+ * capture can be fed back through the command processor without the game,
+ * giving reproducible decode and state-processing runs for offline bisects.
+ * Guest memory referenced by the packets (index buffers, indirect args) is
+ * not serialized, so replays run with no rasterizer bound.
+ */
+class Pm4Capture {
+public:
+    /// Appends one gfx dcb/ccb pair in submission order.
+    void RecordGfx(std::span<const u32> dcb, std::span<const u32> ccb);
+
+    /// Appends an ASC buffer along with its virtual queue id.
+    void RecordAsc(u32 vqid, std::span<const u32> acb);
+
+    /// Feeds a capture back through the given command processor and waits for
+    /// it to drain. Returns false when the file is missing or malformed.
+    static bool Replay(const std::filesystem::path& path, Liverpool& liverpool);
+
+private:
+    bool EnsureOpen();
+    void Write(u32 kind, u32 vqid, std::span<const u32> first, std::span<const u32> second);
+
+    Common::FS::IOFile file;
+    std::mutex mutex;
+    bool open_failed{};
+};
+
+} // namespace AmdGpu
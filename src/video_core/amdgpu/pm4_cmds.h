@@ -377,6 +377,33 @@ struct PM4DmaData {
     u32 command;
 };
 
+struct PM4CmdSetPredication {
+    enum class Operation : u32 {
+        Clear = 0u,
+        Zpass = 1u,
+        PrimCount = 2u,
+        Bool64 = 3u,
+    };
+
+    PM4Type3Header header;
+    union {
+        BitField<4, 28, u32> start_addr_lo;
+        u32 raw1;
+    };
+    union {
+        BitField<0, 8, u32> start_addr_hi;
+        BitField<8, 1, u32> pred_bool;   ///< 1 = render when the predicate indicates visible
+        BitField<12, 1, u32> hint;       ///< 1 = draw without waiting for the predicate write
+        BitField<16, 3, Operation> pred_op;
+        BitField<31, 1, u32> continue_bit; ///< OR the predicate into the previous one
+        u32 raw2;
+    };
+
+    VAddr Address() const {
+        return (VAddr(start_addr_hi.Value()) << 32) | (VAddr(start_addr_lo.Value()) << 4);
+    }
+};
+
 struct PM4CmdWaitRegMem {
     enum class Engine : u32 { Me = 0u, Pfp = 1u };
     enum class MemSpace : u32 { Register = 0u, Memory = 1u };
@@ -0,0 +1,340 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include "common/assert.h"
+#include "core/virtual_memory.h"
+#include "video_core/buffer_cache/buffer_cache.h"
+#include "video_core/renderer_vulkan/vk_instance.h"
+#include "video_core/renderer_vulkan/vk_scheduler.h"
+
+#include <vk_mem_alloc.h>
+
+#ifndef _WIN64
+#include <sys/mman.h>
+
+#define PAGE_READWRITE (PROT_READ | PROT_WRITE)
+#define PAGE_READONLY PROT_READ
+#else
+#include <windows.h>
+
+// Defined in texture_cache.cpp on top of VirtualProtect.
+void mprotect(void* addr, size_t len, int prot);
+#endif
+
+namespace VideoCore {
+
+static BufferCache* g_buffer_cache = nullptr;
+
+static constexpr u64 StagingBufferSize = 256_MB;
+static constexpr u64 PageShift = 12;
+static constexpr u64 NumProtectWords = (USER_MAX >> PageShift) / 64 + 1;
+
+// Number of CPU writes after which a range is considered dynamic and handed back
+// to the stream buffer. Static geometry is written once (or a handful of times
+// while loading) and then pays for protection only on reupload.
+static constexpr u32 StreamInvalidationThreshold = 8;
+
+BufferCache* BufferCache::Instance() {
+    return g_buffer_cache;
+}
+
+BufferCache::BufferCache(const Vulkan::Instance& instance_, Vulkan::Scheduler& scheduler_)
+    : instance{instance_}, scheduler{scheduler_},
+      staging{instance, scheduler, vk::BufferUsageFlagBits::eTransferSrc, StagingBufferSize,
+              Vulkan::BufferType::Upload} {
+    protected_pages = std::make_unique<std::atomic<u64>[]>(NumProtectWords);
+    g_buffer_cache = this;
+}
+
+BufferCache::~BufferCache() {
+    g_buffer_cache = nullptr;
+}
+
+void BufferCache::OnCpuWrite(VAddr address) {
+    if (!IsPageProtected(address)) {
+        // Protection has already been lifted or the write targets an image; the
+        // texture cache handles its own pages.
+        return;
+    }
+    std::unique_lock lock{m_page_table};
+    ForEachBufferInRegion(address, 1 << PageShift, [&](BufferId buffer_id, Buffer& buffer) {
+        // Ensure the buffer is reuploaded when used again and let the write proceed.
+        buffer.flags |= BufferFlagBits::CpuModified;
+        ++buffer.num_invalidations;
+        UntrackBuffer(buffer);
+    });
+}
+
+std::pair<vk::Buffer, u32> BufferCache::ObtainBuffer(VAddr cpu_addr, u32 size) {
+    std::unique_lock lock{m_page_table};
+    BufferId buffer_id{};
+    ForEachBufferInRegion(cpu_addr, size, [&](BufferId id, Buffer& buffer) {
+        if (buffer.cpu_addr <= cpu_addr && cpu_addr + size <= buffer.cpu_addr + buffer.size) {
+            buffer_id = id;
+        }
+    });
+
+    if (!buffer_id) {
+        // Grow the new buffer over any partially overlapping ones so a range is never
+        // backed by two device copies, and keep the invalidation count so dynamic
+        // ranges are not rejuvenated by a resize.
+        VAddr start = cpu_addr;
+        VAddr end = cpu_addr + size;
+        u32 num_invalidations = 0;
+        boost::container::small_vector<BufferId, 4> overlaps;
+        ForEachBufferInRegion(cpu_addr, size, [&](BufferId id, Buffer& buffer) {
+            start = std::min(start, buffer.cpu_addr);
+            end = std::max<VAddr>(end, buffer.cpu_addr + buffer.size);
+            num_invalidations = std::max(num_invalidations, buffer.num_invalidations);
+            overlaps.push_back(id);
+        });
+        for (const BufferId id : overlaps) {
+            DeleteBuffer(id);
+        }
+        buffer_id = CreateBuffer(start, static_cast<u32>(end - start));
+        slot_buffers[buffer_id].num_invalidations = num_invalidations;
+    }
+
+    Buffer& buffer = slot_buffers[buffer_id];
+    if (True(buffer.flags & BufferFlagBits::CpuModified)) {
+        if (buffer.num_invalidations > StreamInvalidationThreshold) {
+            // The range is rewritten nearly every use; caching it would just bounce
+            // between fault and reupload. Leave it untracked and let the caller stream.
+            return {};
+        }
+        UploadBuffer(buffer);
+    }
+    TrackBuffer(buffer);
+    return {buffer.handle, static_cast<u32>(cpu_addr - buffer.cpu_addr)};
+}
+
+std::pair<vk::Buffer, u32> BufferCache::TryObtainTrackedBuffer(VAddr cpu_addr, u32 size) {
+    std::unique_lock lock{m_page_table};
+    const Buffer* match = nullptr;
+    ForEachBufferInRegion(cpu_addr, size, [&](BufferId, Buffer& buffer) {
+        if (buffer.cpu_addr <= cpu_addr && cpu_addr + size <= buffer.cpu_addr + buffer.size) {
+            match = &buffer;
+        }
+    });
+    if (!match || True(match->flags & BufferFlagBits::CpuModified)) {
+        return {};
+    }
+    return {match->handle, static_cast<u32>(cpu_addr - match->cpu_addr)};
+}
+
+BufferCache::Buffer::~Buffer() {
+    if (handle) {
+        vmaDestroyBuffer(allocator, handle, allocation);
+    }
+}
+
+BufferCache::Buffer& BufferCache::Buffer::operator=(Buffer&& other) noexcept {
+    if (handle) {
+        vmaDestroyBuffer(allocator, handle, allocation);
+    }
+    cpu_addr = other.cpu_addr;
+    size = other.size;
+    flags = other.flags;
+    num_invalidations = other.num_invalidations;
+    handle = std::exchange(other.handle, vk::Buffer{});
+    allocator = std::exchange(other.allocator, nullptr);
+    allocation = std::exchange(other.allocation, nullptr);
+    return *this;
+}
+
+BufferId BufferCache::CreateBuffer(VAddr cpu_addr, u32 size) {
+    Buffer buffer{};
+    buffer.cpu_addr = cpu_addr;
+    buffer.size = size;
+    buffer.flags = BufferFlagBits::CpuModified;
+    buffer.allocator = instance.GetAllocator();
+
+    const vk::BufferCreateInfo buffer_ci = {
+        .size = size,
+        .usage = vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst |
+                 vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eIndexBuffer |
+                 vk::BufferUsageFlagBits::eStorageBuffer,
+    };
+    VmaAllocationCreateInfo alloc_ci = {
+        .flags = VMA_ALLOCATION_CREATE_WITHIN_BUDGET_BIT,
+        .usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+        .pool = instance.GetBufferMemoryPool(),
+    };
+
+    const VkBufferCreateInfo buffer_ci_unsafe = static_cast<VkBufferCreateInfo>(buffer_ci);
+    VkBuffer unsafe_buffer{};
+    VkResult result = vmaCreateBuffer(buffer.allocator, &buffer_ci_unsafe, &alloc_ci,
+                                      &unsafe_buffer, &buffer.allocation, nullptr);
+    if (result != VK_SUCCESS && alloc_ci.pool != VK_NULL_HANDLE) {
+        // Incompatible with the dedicated pool; retry against the shared pools.
+        alloc_ci.pool = VK_NULL_HANDLE;
+        result = vmaCreateBuffer(buffer.allocator, &buffer_ci_unsafe, &alloc_ci, &unsafe_buffer,
+                                 &buffer.allocation, nullptr);
+    }
+    ASSERT_MSG(result == VK_SUCCESS, "Failed allocating buffer with error {}",
+               vk::to_string(vk::Result{result}));
+    buffer.handle = vk::Buffer{unsafe_buffer};
+
+    const BufferId buffer_id = slot_buffers.insert(std::move(buffer));
+    RegisterBuffer(buffer_id);
+    return buffer_id;
+}
+
+void BufferCache::UploadBuffer(Buffer& buffer) {
+    // Mark buffer as validated.
+    buffer.flags &= ~BufferFlagBits::CpuModified;
+
+    const u64 offset = staging.Copy(buffer.cpu_addr, buffer.size, 4);
+
+    scheduler.EndRendering();
+    const auto cmdbuf = scheduler.CommandBuffer();
+    // Order the reupload against any previous GPU work still writing the buffer,
+    // such as a dispatch whose results the CPU has since overwritten.
+    const vk::BufferMemoryBarrier pre_barrier = {
+        .srcAccessMask = vk::AccessFlagBits::eMemoryWrite,
+        .dstAccessMask = vk::AccessFlagBits::eTransferWrite,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .buffer = buffer.handle,
+        .offset = 0,
+        .size = buffer.size,
+    };
+    cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands,
+                           vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlagBits{}, {},
+                           pre_barrier, {});
+    const vk::BufferCopy copy = {
+        .srcOffset = offset,
+        .dstOffset = 0,
+        .size = buffer.size,
+    };
+    cmdbuf.copyBuffer(staging.Handle(), buffer.handle, copy);
+
+    const vk::BufferMemoryBarrier barrier = {
+        .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+        .dstAccessMask = vk::AccessFlagBits::eVertexAttributeRead | vk::AccessFlagBits::eIndexRead |
+                         vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .buffer = buffer.handle,
+        .offset = 0,
+        .size = buffer.size,
+    };
+    cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                           vk::PipelineStageFlagBits::eVertexInput |
+                               vk::PipelineStageFlagBits::eComputeShader,
+                           vk::DependencyFlagBits{}, {}, barrier, {});
+}
+
+void BufferCache::RegisterBuffer(BufferId buffer_id) {
+    Buffer& buffer = slot_buffers[buffer_id];
+    ASSERT_MSG(False(buffer.flags & BufferFlagBits::Registered),
+               "Trying to register an already registered buffer");
+    buffer.flags |= BufferFlagBits::Registered;
+    ForEachPage(buffer.cpu_addr, buffer.size,
+                [this, buffer_id](u64 page) { page_table[page].push_back(buffer_id); });
+}
+
+void BufferCache::UnregisterBuffer(BufferId buffer_id) {
+    Buffer& buffer = slot_buffers[buffer_id];
+    ASSERT_MSG(True(buffer.flags & BufferFlagBits::Registered),
+               "Trying to unregister an already unregistered buffer");
+    buffer.flags &= ~BufferFlagBits::Registered;
+    ForEachPage(buffer.cpu_addr, buffer.size, [this, buffer_id](u64 page) {
+        const auto page_it = page_table.find(page);
+        if (page_it == page_table.end()) {
+            ASSERT_MSG(false, "Unregistering unregistered page=0x{:x}", page << PageBits);
+            return;
+        }
+        auto& buffer_ids = page_it.value();
+        const auto vector_it = std::ranges::find(buffer_ids, buffer_id);
+        if (vector_it == buffer_ids.end()) {
+            ASSERT_MSG(false, "Unregistering unregistered buffer in page=0x{:x}",
+                       page << PageBits);
+            return;
+        }
+        buffer_ids.erase(vector_it);
+    });
+}
+
+void BufferCache::DeleteBuffer(BufferId buffer_id) {
+    Buffer& buffer = slot_buffers[buffer_id];
+    UntrackBuffer(buffer);
+    UnregisterBuffer(buffer_id);
+    // The GPU might still be reading from the buffer, delay the destruction of its
+    // backing memory until the current tick has been reached.
+    scheduler.DeferOperation([this, buffer_id] { slot_buffers.erase(buffer_id); });
+}
+
+void BufferCache::TrackBuffer(Buffer& buffer) {
+    if (True(buffer.flags & BufferFlagBits::Tracked)) {
+        return;
+    }
+    buffer.flags |= BufferFlagBits::Tracked;
+    UpdatePagesCachedCount(buffer.cpu_addr, buffer.size, 1);
+}
+
+void BufferCache::UntrackBuffer(Buffer& buffer) {
+    if (False(buffer.flags & BufferFlagBits::Tracked)) {
+        return;
+    }
+    buffer.flags &= ~BufferFlagBits::Tracked;
+    UpdatePagesCachedCount(buffer.cpu_addr, buffer.size, -1);
+}
+
+void BufferCache::UpdatePagesCachedCount(VAddr addr, u64 size, s32 delta) {
+    std::scoped_lock lk{mutex};
+    const u64 num_pages = ((addr + size - 1) >> PageShift) - (addr >> PageShift) + 1;
+    const u64 page_start = addr >> PageShift;
+    const u64 page_end = page_start + num_pages;
+
+    const auto pages_interval =
+        decltype(cached_pages)::interval_type::right_open(page_start, page_end);
+    if (delta > 0) {
+        cached_pages.add({pages_interval, delta});
+    }
+
+    const auto& range = cached_pages.equal_range(pages_interval);
+    for (const auto& [range, count] : boost::make_iterator_range(range)) {
+        const auto interval = range & pages_interval;
+        const VAddr interval_start_addr = boost::icl::first(interval) << PageShift;
+        const VAddr interval_end_addr = boost::icl::last_next(interval) << PageShift;
+        const u32 interval_size = interval_end_addr - interval_start_addr;
+        void* addr = reinterpret_cast<void*>(interval_start_addr);
+        if (delta > 0 && count == delta) {
+            // Publish the bits before revoking write access so a fault raised right
+            // after the mprotect always observes the page as protected.
+            MarkPagesProtected(interval_start_addr, interval_size, true);
+            mprotect(addr, interval_size, PAGE_READONLY);
+        } else if (delta < 0 && count == -delta) {
+            mprotect(addr, interval_size, PAGE_READWRITE);
+            MarkPagesProtected(interval_start_addr, interval_size, false);
+        } else {
+            ASSERT(count >= 0);
+        }
+    }
+
+    if (delta < 0) {
+        cached_pages.add({pages_interval, delta});
+    }
+}
+
+bool BufferCache::IsPageProtected(VAddr address) const {
+    const u64 page = address >> PageShift;
+    const u64 word = protected_pages[page >> 6].load(std::memory_order_acquire);
+    return (word >> (page & 63)) & 1;
+}
+
+void BufferCache::MarkPagesProtected(VAddr addr, u64 size, bool protect) {
+    const u64 page_end = ((addr + size - 1) >> PageShift) + 1;
+    for (u64 page = addr >> PageShift; page < page_end; ++page) {
+        const u64 mask = 1ULL << (page & 63);
+        if (protect) {
+            protected_pages[page >> 6].fetch_or(mask, std::memory_order_release);
+        } else {
+            protected_pages[page >> 6].fetch_and(~mask, std::memory_order_release);
+        }
+    }
+}
+
+} // namespace VideoCore
@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <boost/container/small_vector.hpp>
+#include <boost/icl/interval_map.hpp>
+#include <tsl/robin_map.h>
+
+#include "common/enum.h"
+#include "common/slot_vector.h"
+#include "common/types.h"
+#include "video_core/renderer_vulkan/vk_stream_buffer.h"
+
+VK_DEFINE_HANDLE(VmaAllocation)
+VK_DEFINE_HANDLE(VmaAllocator)
+
+namespace Vulkan {
+class Instance;
+class Scheduler;
+} // namespace Vulkan
+
+namespace VideoCore {
+
+using BufferId = Common::SlotId;
+
+enum class BufferFlagBits : u32 {
+    CpuModified = 1 << 0, ///< Contents have been modified from the CPU
+    Tracked = 1 << 1,     ///< Writes are being hooked from the CPU
+    Registered = 1 << 2,  ///< True when the buffer is registered
+    Picked = 1 << 3,      ///< Temporary flag to mark the buffer as picked
+};
+DECLARE_ENUM_FLAG_OPERATORS(BufferFlagBits)
+
+class BufferCache {
+    // Follows the same convention as the texture cache page table; see the
+    // explanation there for the choice of shift.
+    static constexpr u64 PageBits = 20;
+
+public:
+    explicit BufferCache(const Vulkan::Instance& instance, Vulkan::Scheduler& scheduler);
+    ~BufferCache();
+
+    /// Returns the global buffer cache, used by the guest fault handler to dispatch writes.
+    static BufferCache* Instance();
+
+    /// Invalidates any buffer in the logical page range.
+    void OnCpuWrite(VAddr address);
+
+    /// Returns a device local buffer containing the guest range together with the offset
+    /// of the range inside it. Returns a null handle when the range is rewritten by the
+    /// CPU too frequently to be worth caching and should be streamed instead.
+    [[nodiscard]] std::pair<vk::Buffer, u32> ObtainBuffer(VAddr cpu_addr, u32 size);
+
+    /// Returns the device local buffer already covering the guest range, without creating
+    /// or uploading one. Returns a null handle when the range is untracked or its device
+    /// copy is stale; CP DMA uses this to decide whether a transfer can stay on the GPU.
+    [[nodiscard]] std::pair<vk::Buffer, u32> TryObtainTrackedBuffer(VAddr cpu_addr, u32 size);
+
+private:
+    /// Owns a VMA suballocation the same way UniqueImage does in the texture
+    /// cache, so cached buffers pack into large memory blocks instead of each
+    /// holding a dedicated vkAllocateMemory allocation.
+    struct Buffer {
+        VAddr cpu_addr{};
+        u32 size{};
+        BufferFlagBits flags{};
+        u32 num_invalidations{};
+        vk::Buffer handle{};
+        VmaAllocator allocator{};
+        VmaAllocation allocation{};
+
+        Buffer() = default;
+        ~Buffer();
+
+        Buffer(const Buffer&) = delete;
+        Buffer& operator=(const Buffer&) = delete;
+
+        Buffer(Buffer&& other) noexcept
+            : cpu_addr{other.cpu_addr}, size{other.size}, flags{other.flags},
+              num_invalidations{other.num_invalidations},
+              handle{std::exchange(other.handle, vk::Buffer{})},
+              allocator{std::exchange(other.allocator, nullptr)},
+              allocation{std::exchange(other.allocation, nullptr)} {}
+        Buffer& operator=(Buffer&& other) noexcept;
+    };
+
+    /// Iterate over all page indices in a range
+    template <typename Func>
+    static void ForEachPage(VAddr addr, size_t size, Func&& func) {
+        const u64 page_end = (addr + size - 1) >> PageBits;
+        for (u64 page = addr >> PageBits; page <= page_end; ++page) {
+            func(page);
+        }
+    }
+
+    template <typename Func>
+    void ForEachBufferInRegion(VAddr cpu_addr, size_t size, Func&& func) {
+        boost::container::small_vector<BufferId, 8> buffers;
+        ForEachPage(cpu_addr, size, [this, &buffers, &func](u64 page) {
+            const auto it = page_table.find(page);
+            if (it == page_table.end()) {
+                return;
+            }
+            for (const BufferId buffer_id : it->second) {
+                Buffer& buffer = slot_buffers[buffer_id];
+                if (True(buffer.flags & BufferFlagBits::Picked)) {
+                    continue;
+                }
+                buffer.flags |= BufferFlagBits::Picked;
+                buffers.push_back(buffer_id);
+                func(buffer_id, buffer);
+            }
+        });
+        for (const BufferId buffer_id : buffers) {
+            slot_buffers[buffer_id].flags &= ~BufferFlagBits::Picked;
+        }
+    }
+
+    /// Creates a device local buffer covering the given guest range.
+    [[nodiscard]] BufferId CreateBuffer(VAddr cpu_addr, u32 size);
+
+    /// Copies the guest range into the buffer through the staging ring.
+    void UploadBuffer(Buffer& buffer);
+
+    /// Register/unregister buffer in the page table
+    void RegisterBuffer(BufferId buffer_id);
+    void UnregisterBuffer(BufferId buffer_id);
+
+    /// Unregisters the buffer and defers destruction until the GPU is done with it.
+    void DeleteBuffer(BufferId buffer_id);
+
+    /// Start/stop tracking CPU writes for the buffer
+    void TrackBuffer(Buffer& buffer);
+    void UntrackBuffer(Buffer& buffer);
+
+    /// Increase/decrease the number of buffers in pages touching the specified region
+    void UpdatePagesCachedCount(VAddr addr, u64 size, s32 delta);
+
+    /// Returns true if the page containing the address is currently write protected
+    bool IsPageProtected(VAddr address) const;
+
+    /// Sets or clears the protection bits for all pages in the region
+    void MarkPagesProtected(VAddr addr, u64 size, bool protect);
+
+private:
+    const Vulkan::Instance& instance;
+    Vulkan::Scheduler& scheduler;
+    Vulkan::StreamBuffer staging;
+    Common::SlotVector<Buffer> slot_buffers;
+    tsl::robin_pg_map<u64, std::vector<BufferId>> page_table;
+    boost::icl::interval_map<VAddr, s32> cached_pages;
+    // Same scheme as the texture cache: one bit per write protected guest page so the
+    // fault handler can reject unrelated writes without taking the page table lock.
+    std::unique_ptr<std::atomic<u64>[]> protected_pages;
+    std::mutex mutex;
+    std::mutex m_page_table;
+};
+
+} // namespace VideoCore
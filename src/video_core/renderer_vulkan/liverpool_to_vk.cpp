@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
 #include "common/assert.h"
 #include "video_core/amdgpu/pixel_format.h"
 #include "video_core/renderer_vulkan/liverpool_to_vk.h"
@@ -9,6 +10,11 @@ namespace Vulkan::LiverpoolToVK {
 
 using DepthBuffer = Liverpool::DepthBuffer;
 
+// The hot converters below are dense constexpr tables indexed by the raw enum
+// value instead of switches; RefreshGraphicsKey calls them dozens of times per
+// draw. Holes in the register encodings map to an invalid sentinel so unknown
+// values still trip the same assert a switch default would.
+
 vk::StencilOp StencilOp(Liverpool::StencilFunc op) {
     switch (op) {
     case Liverpool::StencilFunc::Keep:
@@ -35,61 +41,70 @@ vk::StencilOp StencilOp(Liverpool::StencilFunc op) {
     }
 }
 
+static constexpr std::array CompareOpTable = [] {
+    using CompareFunc = Liverpool::CompareFunc;
+    std::array<vk::CompareOp, 8> table{};
+    const auto set = [&table](CompareFunc func, vk::CompareOp op) {
+        table[static_cast<u32>(func)] = op;
+    };
+    set(CompareFunc::Never, vk::CompareOp::eNever);
+    set(CompareFunc::Less, vk::CompareOp::eLess);
+    set(CompareFunc::Equal, vk::CompareOp::eEqual);
+    set(CompareFunc::LessEqual, vk::CompareOp::eLessOrEqual);
+    set(CompareFunc::Greater, vk::CompareOp::eGreater);
+    set(CompareFunc::NotEqual, vk::CompareOp::eNotEqual);
+    set(CompareFunc::GreaterEqual, vk::CompareOp::eGreaterOrEqual);
+    set(CompareFunc::Always, vk::CompareOp::eAlways);
+    return table;
+}();
+static_assert(CompareOpTable[static_cast<u32>(Liverpool::CompareFunc::Never)] ==
+              vk::CompareOp::eNever);
+static_assert(CompareOpTable[static_cast<u32>(Liverpool::CompareFunc::NotEqual)] ==
+              vk::CompareOp::eNotEqual);
+static_assert(CompareOpTable[static_cast<u32>(Liverpool::CompareFunc::Always)] ==
+              vk::CompareOp::eAlways);
+
 vk::CompareOp CompareOp(Liverpool::CompareFunc func) {
-    switch (func) {
-    case Liverpool::CompareFunc::Always:
-        return vk::CompareOp::eAlways;
-    case Liverpool::CompareFunc::Equal:
-        return vk::CompareOp::eEqual;
-    case Liverpool::CompareFunc::GreaterEqual:
-        return vk::CompareOp::eGreaterOrEqual;
-    case Liverpool::CompareFunc::Greater:
-        return vk::CompareOp::eGreater;
-    case Liverpool::CompareFunc::LessEqual:
-        return vk::CompareOp::eLessOrEqual;
-    case Liverpool::CompareFunc::Less:
-        return vk::CompareOp::eLess;
-    case Liverpool::CompareFunc::NotEqual:
-        return vk::CompareOp::eNotEqual;
-    case Liverpool::CompareFunc::Never:
-        return vk::CompareOp::eNever;
-    default:
-        UNREACHABLE();
-        return vk::CompareOp::eAlways;
-    }
+    const u32 index = static_cast<u32>(func);
+    ASSERT(index < CompareOpTable.size());
+    return CompareOpTable[index];
 }
 
+static constexpr auto InvalidTopology = static_cast<vk::PrimitiveTopology>(~0u);
+
+static constexpr std::array PrimitiveTypeTable = [] {
+    using PrimitiveType = Liverpool::PrimitiveType;
+    std::array<vk::PrimitiveTopology, 22> table{};
+    table.fill(InvalidTopology);
+    const auto set = [&table](PrimitiveType type, vk::PrimitiveTopology topology) {
+        table[static_cast<u32>(type)] = topology;
+    };
+    set(PrimitiveType::PointList, vk::PrimitiveTopology::ePointList);
+    set(PrimitiveType::LineList, vk::PrimitiveTopology::eLineList);
+    set(PrimitiveType::LineStrip, vk::PrimitiveTopology::eLineStrip);
+    set(PrimitiveType::TriangleList, vk::PrimitiveTopology::eTriangleList);
+    set(PrimitiveType::TriangleFan, vk::PrimitiveTopology::eTriangleFan);
+    set(PrimitiveType::TriangleStrip, vk::PrimitiveTopology::eTriangleStrip);
+    set(PrimitiveType::AdjLineList, vk::PrimitiveTopology::eLineListWithAdjacency);
+    set(PrimitiveType::AdjLineStrip, vk::PrimitiveTopology::eLineStripWithAdjacency);
+    set(PrimitiveType::AdjTriangleList, vk::PrimitiveTopology::eTriangleListWithAdjacency);
+    set(PrimitiveType::AdjTriangleStrip, vk::PrimitiveTopology::eTriangleStripWithAdjacency);
+    // Needs to generate index buffer on the fly.
+    set(PrimitiveType::QuadList, vk::PrimitiveTopology::eTriangleList);
+    set(PrimitiveType::RectList, vk::PrimitiveTopology::eTriangleStrip);
+    return table;
+}();
+static_assert(PrimitiveTypeTable[static_cast<u32>(Liverpool::PrimitiveType::PointList)] ==
+              vk::PrimitiveTopology::ePointList);
+static_assert(PrimitiveTypeTable[static_cast<u32>(Liverpool::PrimitiveType::None)] ==
+              InvalidTopology);
+static_assert(PrimitiveTypeTable[static_cast<u32>(Liverpool::PrimitiveType::RectList)] ==
+              vk::PrimitiveTopology::eTriangleStrip);
+
 vk::PrimitiveTopology PrimitiveType(Liverpool::PrimitiveType type) {
-    switch (type) {
-    case Liverpool::PrimitiveType::PointList:
-        return vk::PrimitiveTopology::ePointList;
-    case Liverpool::PrimitiveType::LineList:
-        return vk::PrimitiveTopology::eLineList;
-    case Liverpool::PrimitiveType::LineStrip:
-        return vk::PrimitiveTopology::eLineStrip;
-    case Liverpool::PrimitiveType::TriangleList:
-        return vk::PrimitiveTopology::eTriangleList;
-    case Liverpool::PrimitiveType::TriangleFan:
-        return vk::PrimitiveTopology::eTriangleFan;
-    case Liverpool::PrimitiveType::TriangleStrip:
-        return vk::PrimitiveTopology::eTriangleStrip;
-    case Liverpool::PrimitiveType::AdjLineList:
-        return vk::PrimitiveTopology::eLineListWithAdjacency;
-    case Liverpool::PrimitiveType::AdjLineStrip:
-        return vk::PrimitiveTopology::eLineStripWithAdjacency;
-    case Liverpool::PrimitiveType::AdjTriangleList:
-        return vk::PrimitiveTopology::eTriangleListWithAdjacency;
-    case Liverpool::PrimitiveType::AdjTriangleStrip:
-        return vk::PrimitiveTopology::eTriangleStripWithAdjacency;
-    case Liverpool::PrimitiveType::QuadList:
-        // Needs to generate index buffer on the fly.
-        return vk::PrimitiveTopology::eTriangleList;
-    case Liverpool::PrimitiveType::RectList:
-        return vk::PrimitiveTopology::eTriangleStrip;
-    default:
-        UNREACHABLE();
-        return vk::PrimitiveTopology::eTriangleList;
-    }
+    const u32 index = static_cast<u32>(type);
+    ASSERT(index < PrimitiveTypeTable.size() && PrimitiveTypeTable[index] != InvalidTopology);
+    return PrimitiveTypeTable[index];
 }
 
 vk::PolygonMode PolygonMode(Liverpool::PolygonMode mode) {
@@ -122,50 +137,49 @@ vk::CullModeFlags CullMode(Liverpool::CullMode mode) {
     }
 }
 
-vk::BlendFactor BlendFactor(Liverpool::BlendControl::BlendFactor factor) {
+static constexpr auto InvalidBlendFactor = static_cast<vk::BlendFactor>(~0u);
+
+static constexpr std::array BlendFactorTable = [] {
     using BlendFactor = Liverpool::BlendControl::BlendFactor;
-    switch (factor) {
-    case BlendFactor::Zero:
-        return vk::BlendFactor::eZero;
-    case BlendFactor::One:
-        return vk::BlendFactor::eOne;
-    case BlendFactor::SrcColor:
-        return vk::BlendFactor::eSrcColor;
-    case BlendFactor::OneMinusSrcColor:
-        return vk::BlendFactor::eOneMinusSrcColor;
-    case BlendFactor::SrcAlpha:
-        return vk::BlendFactor::eSrcAlpha;
-    case BlendFactor::OneMinusSrcAlpha:
-        return vk::BlendFactor::eOneMinusSrcAlpha;
-    case BlendFactor::DstAlpha:
-        return vk::BlendFactor::eDstAlpha;
-    case BlendFactor::OneMinusDstAlpha:
-        return vk::BlendFactor::eOneMinusDstAlpha;
-    case BlendFactor::DstColor:
-        return vk::BlendFactor::eDstColor;
-    case BlendFactor::OneMinusDstColor:
-        return vk::BlendFactor::eOneMinusDstColor;
-    case BlendFactor::SrcAlphaSaturate:
-        return vk::BlendFactor::eSrcAlphaSaturate;
-    case BlendFactor::ConstantColor:
-        return vk::BlendFactor::eConstantColor;
-    case BlendFactor::OneMinusConstantColor:
-        return vk::BlendFactor::eOneMinusConstantColor;
-    case BlendFactor::Src1Color:
-        return vk::BlendFactor::eSrc1Color;
-    case BlendFactor::InvSrc1Color:
-        return vk::BlendFactor::eOneMinusSrc1Color;
-    case BlendFactor::Src1Alpha:
-        return vk::BlendFactor::eSrc1Alpha;
-    case BlendFactor::InvSrc1Alpha:
-        return vk::BlendFactor::eOneMinusSrc1Alpha;
-    case BlendFactor::ConstantAlpha:
-        return vk::BlendFactor::eConstantAlpha;
-    case BlendFactor::OneMinusConstantAlpha:
-        return vk::BlendFactor::eOneMinusConstantAlpha;
-    default:
-        UNREACHABLE();
-    }
+    std::array<vk::BlendFactor, 21> table{};
+    table.fill(InvalidBlendFactor);
+    const auto set = [&table](BlendFactor factor, vk::BlendFactor vk_factor) {
+        table[static_cast<u32>(factor)] = vk_factor;
+    };
+    set(BlendFactor::Zero, vk::BlendFactor::eZero);
+    set(BlendFactor::One, vk::BlendFactor::eOne);
+    set(BlendFactor::SrcColor, vk::BlendFactor::eSrcColor);
+    set(BlendFactor::OneMinusSrcColor, vk::BlendFactor::eOneMinusSrcColor);
+    set(BlendFactor::SrcAlpha, vk::BlendFactor::eSrcAlpha);
+    set(BlendFactor::OneMinusSrcAlpha, vk::BlendFactor::eOneMinusSrcAlpha);
+    set(BlendFactor::DstAlpha, vk::BlendFactor::eDstAlpha);
+    set(BlendFactor::OneMinusDstAlpha, vk::BlendFactor::eOneMinusDstAlpha);
+    set(BlendFactor::DstColor, vk::BlendFactor::eDstColor);
+    set(BlendFactor::OneMinusDstColor, vk::BlendFactor::eOneMinusDstColor);
+    set(BlendFactor::SrcAlphaSaturate, vk::BlendFactor::eSrcAlphaSaturate);
+    set(BlendFactor::ConstantColor, vk::BlendFactor::eConstantColor);
+    set(BlendFactor::OneMinusConstantColor, vk::BlendFactor::eOneMinusConstantColor);
+    set(BlendFactor::Src1Color, vk::BlendFactor::eSrc1Color);
+    set(BlendFactor::InvSrc1Color, vk::BlendFactor::eOneMinusSrc1Color);
+    set(BlendFactor::Src1Alpha, vk::BlendFactor::eSrc1Alpha);
+    set(BlendFactor::InvSrc1Alpha, vk::BlendFactor::eOneMinusSrc1Alpha);
+    set(BlendFactor::ConstantAlpha, vk::BlendFactor::eConstantAlpha);
+    set(BlendFactor::OneMinusConstantAlpha, vk::BlendFactor::eOneMinusConstantAlpha);
+    return table;
+}();
+static_assert(BlendFactorTable[static_cast<u32>(Liverpool::BlendControl::BlendFactor::Zero)] ==
+              vk::BlendFactor::eZero);
+static_assert(
+    BlendFactorTable[static_cast<u32>(Liverpool::BlendControl::BlendFactor::SrcAlphaSaturate)] ==
+    vk::BlendFactor::eSrcAlphaSaturate);
+static_assert(BlendFactorTable[static_cast<u32>(
+                  Liverpool::BlendControl::BlendFactor::OneMinusConstantAlpha)] ==
+              vk::BlendFactor::eOneMinusConstantAlpha);
+
+vk::BlendFactor BlendFactor(Liverpool::BlendControl::BlendFactor factor) {
+    const u32 index = static_cast<u32>(factor);
+    ASSERT(index < BlendFactorTable.size() && BlendFactorTable[index] != InvalidBlendFactor);
+    return BlendFactorTable[index];
 }
 
 vk::BlendOp BlendOp(Liverpool::BlendControl::BlendFunc func) {
@@ -279,150 +293,86 @@ vk::BorderColor BorderColor(AmdGpu::BorderColor color) {
     }
 }
 
-vk::Format SurfaceFormat(AmdGpu::DataFormat data_format, AmdGpu::NumberFormat num_format) {
+// Data format and number format combined into one table index; NumberFormat
+// values fit in 4 bits.
+static constexpr u32 SurfaceFormatKey(AmdGpu::DataFormat data_format,
+                                      AmdGpu::NumberFormat num_format) {
+    return (static_cast<u32>(data_format) << 4) | static_cast<u32>(num_format);
+}
 
-    if (data_format == AmdGpu::DataFormat::Format32_32_32_32 &&
-        num_format == AmdGpu::NumberFormat::Float) {
-        return vk::Format::eR32G32B32A32Sfloat;
-    }
-    if (data_format == AmdGpu::DataFormat::Format32_32_32 &&
-        num_format == AmdGpu::NumberFormat::Uint) {
-        return vk::Format::eR32G32B32Uint;
-    }
-    if (data_format == AmdGpu::DataFormat::Format8_8_8_8 &&
-        num_format == AmdGpu::NumberFormat::Unorm) {
-        return vk::Format::eR8G8B8A8Unorm;
-    }
-    if (data_format == AmdGpu::DataFormat::Format8_8_8_8 &&
-        num_format == AmdGpu::NumberFormat::Srgb) {
-        return vk::Format::eR8G8B8A8Srgb;
-    }
-    if (data_format == AmdGpu::DataFormat::Format32_32_32 &&
-        num_format == AmdGpu::NumberFormat::Float) {
-        return vk::Format::eR32G32B32Sfloat;
-    }
-    if (data_format == AmdGpu::DataFormat::Format32_32 &&
-        num_format == AmdGpu::NumberFormat::Float) {
-        return vk::Format::eR32G32Sfloat;
-    }
-    if (data_format == AmdGpu::DataFormat::Format5_6_5 &&
-        num_format == AmdGpu::NumberFormat::Unorm) {
-        return vk::Format::eB5G6R5UnormPack16;
-    }
-    if (data_format == AmdGpu::DataFormat::Format8 && num_format == AmdGpu::NumberFormat::Unorm) {
-        return vk::Format::eR8Unorm;
-    }
-    if (data_format == AmdGpu::DataFormat::FormatBc3 && num_format == AmdGpu::NumberFormat::Srgb) {
-        return vk::Format::eBc3SrgbBlock;
-    }
-    if (data_format == AmdGpu::DataFormat::FormatBc3 && num_format == AmdGpu::NumberFormat::Unorm) {
-        return vk::Format::eBc3UnormBlock;
-    }
-    if (data_format == AmdGpu::DataFormat::FormatBc4 && num_format == AmdGpu::NumberFormat::Unorm) {
-        return vk::Format::eBc4UnormBlock;
-    }
-    if (data_format == AmdGpu::DataFormat::Format16_16_16_16 &&
-        num_format == AmdGpu::NumberFormat::Sint) {
-        return vk::Format::eR16G16B16A16Sint;
-    }
-    if (data_format == AmdGpu::DataFormat::Format16_16 &&
-        num_format == AmdGpu::NumberFormat::Float) {
-        return vk::Format::eR16G16Sfloat;
-    }
-    if (data_format == AmdGpu::DataFormat::Format10_11_11 &&
-        num_format == AmdGpu::NumberFormat::Float) {
-        return vk::Format::eB10G11R11UfloatPack32;
-    }
-    if (data_format == AmdGpu::DataFormat::Format2_10_10_10 &&
-        num_format == AmdGpu::NumberFormat::Unorm) {
-        return vk::Format::eA2B10G10R10UnormPack32;
-    }
-    if (data_format == AmdGpu::DataFormat::FormatBc7 && num_format == AmdGpu::NumberFormat::Srgb) {
-        return vk::Format::eBc7SrgbBlock;
-    }
-    if (data_format == AmdGpu::DataFormat::FormatBc1 && num_format == AmdGpu::NumberFormat::Unorm) {
-        return vk::Format::eBc1RgbaUnormBlock;
-    }
-    if (data_format == AmdGpu::DataFormat::Format8_8_8_8 &&
-        num_format == AmdGpu::NumberFormat::Uint) {
-        return vk::Format::eR8G8B8A8Uint;
-    }
-    if (data_format == AmdGpu::DataFormat::Format16 && num_format == AmdGpu::NumberFormat::Float) {
-        return vk::Format::eR16Sfloat;
-    }
-    if (data_format == AmdGpu::DataFormat::Format32 && num_format == AmdGpu::NumberFormat::Float) {
-        return vk::Format::eR32Sfloat;
-    }
-    if (data_format == AmdGpu::DataFormat::Format16_16_16_16 &&
-        num_format == AmdGpu::NumberFormat::Float) {
-        return vk::Format::eR16G16B16A16Sfloat;
-    }
-    if (data_format == AmdGpu::DataFormat::Format32 && num_format == AmdGpu::NumberFormat::Uint) {
-        return vk::Format::eR32Uint;
-    }
-    if (data_format == AmdGpu::DataFormat::Format32 && num_format == AmdGpu::NumberFormat::Sint) {
-        return vk::Format::eR32Sint;
-    }
-    if (data_format == AmdGpu::DataFormat::Format8_8 && num_format == AmdGpu::NumberFormat::Unorm) {
-        return vk::Format::eR8G8Unorm;
-    }
-    if (data_format == AmdGpu::DataFormat::FormatBc7 && num_format == AmdGpu::NumberFormat::Unorm) {
-        return vk::Format::eBc7UnormBlock;
-    }
-    if (data_format == AmdGpu::DataFormat::FormatBc2 && num_format == AmdGpu::NumberFormat::Unorm) {
-        return vk::Format::eBc2UnormBlock;
-    }
-    if (data_format == AmdGpu::DataFormat::Format16_16 &&
-        num_format == AmdGpu::NumberFormat::Snorm) {
-        return vk::Format::eR16G16Snorm;
-    }
-    if (data_format == AmdGpu::DataFormat::Format2_10_10_10 &&
-        num_format == AmdGpu::NumberFormat::Unorm) {
-        return vk::Format::eA2R10G10B10UnormPack32;
-    }
-    if (data_format == AmdGpu::DataFormat::Format2_10_10_10 &&
-        num_format == AmdGpu::NumberFormat::Snorm) {
-        return vk::Format::eA2R10G10B10SnormPack32;
-    }
-    if (data_format == AmdGpu::DataFormat::Format10_11_11 &&
-        num_format == AmdGpu::NumberFormat::Float) {
-        return vk::Format::eB10G11R11UfloatPack32;
-    }
-    if (data_format == AmdGpu::DataFormat::Format16_16 &&
-        num_format == AmdGpu::NumberFormat::Float) {
-        return vk::Format::eR16G16Sfloat;
-    }
-    if (data_format == AmdGpu::DataFormat::Format16_16_16_16 &&
-        num_format == AmdGpu::NumberFormat::Snorm) {
-        return vk::Format::eR16G16B16A16Snorm;
-    }
-    if (data_format == AmdGpu::DataFormat::Format32_32 &&
-        num_format == AmdGpu::NumberFormat::Uint) {
-        return vk::Format::eR32G32Uint;
-    }
-    if (data_format == AmdGpu::DataFormat::Format4_4_4_4 &&
-        num_format == AmdGpu::NumberFormat::Unorm) {
-        return vk::Format::eR4G4B4A4UnormPack16;
-    }
-    if (data_format == AmdGpu::DataFormat::Format16_16_16_16 &&
-        num_format == AmdGpu::NumberFormat::Uint) {
-        return vk::Format::eR16G16B16A16Uint;
-    }
-    if (data_format == AmdGpu::DataFormat::Format32_32_32_32 &&
-        num_format == AmdGpu::NumberFormat::Uint) {
-        return vk::Format::eR32G32B32A32Uint;
-    }
-    if (data_format == AmdGpu::DataFormat::Format8 && num_format == AmdGpu::NumberFormat::Sint) {
-        return vk::Format::eR8Sint;
-    }
-    if (data_format == AmdGpu::DataFormat::FormatBc1 && num_format == AmdGpu::NumberFormat::Srgb) {
-        return vk::Format::eBc1RgbaSrgbBlock;
-    }
-    if (data_format == AmdGpu::DataFormat::Format16_16 &&
-        num_format == AmdGpu::NumberFormat::Sint) {
-        return vk::Format::eR16G16Sint;
-    }
-    UNREACHABLE_MSG("Unknown data_format={} and num_format={}", u32(data_format), u32(num_format));
+static constexpr std::array SurfaceFormatTable = [] {
+    using AmdGpu::DataFormat;
+    using AmdGpu::NumberFormat;
+    // Unmapped combinations stay eUndefined; no supported pair maps to it.
+    std::array<vk::Format, SurfaceFormatKey(DataFormat::FormatBc7, NumberFormat::Ubscaled) + 1>
+        table{};
+    const auto set = [&table](DataFormat data_format, NumberFormat num_format, vk::Format format) {
+        table[SurfaceFormatKey(data_format, num_format)] = format;
+    };
+    set(DataFormat::Format8, NumberFormat::Unorm, vk::Format::eR8Unorm);
+    set(DataFormat::Format8, NumberFormat::Sint, vk::Format::eR8Sint);
+    set(DataFormat::Format16, NumberFormat::Float, vk::Format::eR16Sfloat);
+    set(DataFormat::Format8_8, NumberFormat::Unorm, vk::Format::eR8G8Unorm);
+    set(DataFormat::Format32, NumberFormat::Float, vk::Format::eR32Sfloat);
+    set(DataFormat::Format32, NumberFormat::Uint, vk::Format::eR32Uint);
+    set(DataFormat::Format32, NumberFormat::Sint, vk::Format::eR32Sint);
+    set(DataFormat::Format16_16, NumberFormat::Float, vk::Format::eR16G16Sfloat);
+    set(DataFormat::Format16_16, NumberFormat::Snorm, vk::Format::eR16G16Snorm);
+    set(DataFormat::Format16_16, NumberFormat::Sint, vk::Format::eR16G16Sint);
+    set(DataFormat::Format10_11_11, NumberFormat::Float, vk::Format::eB10G11R11UfloatPack32);
+    set(DataFormat::Format2_10_10_10, NumberFormat::Unorm, vk::Format::eA2B10G10R10UnormPack32);
+    set(DataFormat::Format2_10_10_10, NumberFormat::Snorm, vk::Format::eA2R10G10B10SnormPack32);
+    set(DataFormat::Format8_8_8_8, NumberFormat::Unorm, vk::Format::eR8G8B8A8Unorm);
+    set(DataFormat::Format8_8_8_8, NumberFormat::Srgb, vk::Format::eR8G8B8A8Srgb);
+    set(DataFormat::Format8_8_8_8, NumberFormat::Uint, vk::Format::eR8G8B8A8Uint);
+    set(DataFormat::Format32_32, NumberFormat::Float, vk::Format::eR32G32Sfloat);
+    set(DataFormat::Format32_32, NumberFormat::Uint, vk::Format::eR32G32Uint);
+    set(DataFormat::Format16_16_16_16, NumberFormat::Float, vk::Format::eR16G16B16A16Sfloat);
+    set(DataFormat::Format16_16_16_16, NumberFormat::Snorm, vk::Format::eR16G16B16A16Snorm);
+    set(DataFormat::Format16_16_16_16, NumberFormat::Uint, vk::Format::eR16G16B16A16Uint);
+    set(DataFormat::Format16_16_16_16, NumberFormat::Sint, vk::Format::eR16G16B16A16Sint);
+    set(DataFormat::Format32_32_32, NumberFormat::Float, vk::Format::eR32G32B32Sfloat);
+    set(DataFormat::Format32_32_32, NumberFormat::Uint, vk::Format::eR32G32B32Uint);
+    set(DataFormat::Format32_32_32_32, NumberFormat::Float, vk::Format::eR32G32B32A32Sfloat);
+    set(DataFormat::Format32_32_32_32, NumberFormat::Uint, vk::Format::eR32G32B32A32Uint);
+    set(DataFormat::Format5_6_5, NumberFormat::Unorm, vk::Format::eB5G6R5UnormPack16);
+    set(DataFormat::Format4_4_4_4, NumberFormat::Unorm, vk::Format::eR4G4B4A4UnormPack16);
+    set(DataFormat::FormatBc1, NumberFormat::Unorm, vk::Format::eBc1RgbaUnormBlock);
+    set(DataFormat::FormatBc1, NumberFormat::Srgb, vk::Format::eBc1RgbaSrgbBlock);
+    set(DataFormat::FormatBc2, NumberFormat::Unorm, vk::Format::eBc2UnormBlock);
+    set(DataFormat::FormatBc2, NumberFormat::Srgb, vk::Format::eBc2SrgbBlock);
+    set(DataFormat::FormatBc3, NumberFormat::Unorm, vk::Format::eBc3UnormBlock);
+    set(DataFormat::FormatBc3, NumberFormat::Srgb, vk::Format::eBc3SrgbBlock);
+    set(DataFormat::FormatBc4, NumberFormat::Unorm, vk::Format::eBc4UnormBlock);
+    set(DataFormat::FormatBc4, NumberFormat::Snorm, vk::Format::eBc4SnormBlock);
+    set(DataFormat::FormatBc5, NumberFormat::Unorm, vk::Format::eBc5UnormBlock);
+    set(DataFormat::FormatBc5, NumberFormat::Snorm, vk::Format::eBc5SnormBlock);
+    set(DataFormat::FormatBc6, NumberFormat::Unorm, vk::Format::eBc6HUfloatBlock);
+    set(DataFormat::FormatBc6, NumberFormat::Snorm, vk::Format::eBc6HSfloatBlock);
+    set(DataFormat::FormatBc7, NumberFormat::Unorm, vk::Format::eBc7UnormBlock);
+    set(DataFormat::FormatBc7, NumberFormat::Srgb, vk::Format::eBc7SrgbBlock);
+    return table;
+}();
+static_assert(SurfaceFormatTable[SurfaceFormatKey(AmdGpu::DataFormat::Format8,
+                                                  AmdGpu::NumberFormat::Unorm)] ==
+              vk::Format::eR8Unorm);
+static_assert(SurfaceFormatTable[SurfaceFormatKey(AmdGpu::DataFormat::Format8_8_8_8,
+                                                  AmdGpu::NumberFormat::Srgb)] ==
+              vk::Format::eR8G8B8A8Srgb);
+static_assert(SurfaceFormatTable[SurfaceFormatKey(AmdGpu::DataFormat::FormatBc7,
+                                                  AmdGpu::NumberFormat::Srgb)] ==
+              vk::Format::eBc7SrgbBlock);
+static_assert(SurfaceFormatTable[SurfaceFormatKey(AmdGpu::DataFormat::FormatInvalid,
+                                                  AmdGpu::NumberFormat::Unorm)] ==
+              vk::Format::eUndefined);
+
+vk::Format SurfaceFormat(AmdGpu::DataFormat data_format, AmdGpu::NumberFormat num_format) {
+    const u32 key = SurfaceFormatKey(data_format, num_format);
+    const vk::Format format = key < SurfaceFormatTable.size() ? SurfaceFormatTable[key]
+                                                              : vk::Format::eUndefined;
+    ASSERT_MSG(format != vk::Format::eUndefined, "Unknown data_format={} and num_format={}",
+               u32(data_format), u32(num_format));
+    return format;
 }
 
 vk::Format AdjustColorBufferFormat(vk::Format base_format,
@@ -1,11 +1,18 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
 #include "common/config.h"
 #include "common/debug.h"
+#include "common/path_util.h"
+#include "common/profiler.h"
 #include "common/singleton.h"
+#include "common/version.h"
 #include "core/file_format/splash.h"
 #include "core/libraries/system/systemservice.h"
+#include "input/controller.h"
 #include "sdl_window.h"
 #include "video_core/renderer_vulkan/renderer_vulkan.h"
 #include "video_core/renderer_vulkan/vk_rasterizer.h"
@@ -65,29 +72,29 @@ bool CanBlitToSwapchain(const vk::PhysicalDevice physical_device, vk::Format for
 
 RendererVulkan::RendererVulkan(Frontend::WindowSDL& window_, AmdGpu::Liverpool* liverpool)
     : window{window_}, instance{window, Config::getGpuId(), Config::vkValidationEnabled()},
-      scheduler{instance}, swapchain{instance, window}, texture_cache{instance, scheduler} {
+      scheduler{instance}, swapchain{instance, window}, texture_cache{instance, scheduler},
+      capture_engine{instance} {
     rasterizer = std::make_unique<Rasterizer>(instance, scheduler, texture_cache, liverpool);
     const u32 num_images = swapchain.GetImageCount();
     const vk::Device device = instance.GetDevice();
 
+    // Each frame owns its command pool, so recording frame N+1 never has to
+    // synchronize with pool resources still referenced by frame N on the GPU.
     const vk::CommandPoolCreateInfo pool_info = {
-        .flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer |
-                 vk::CommandPoolCreateFlagBits::eTransient,
+        .flags = vk::CommandPoolCreateFlagBits::eTransient,
         .queueFamilyIndex = instance.GetGraphicsQueueFamilyIndex(),
     };
-    command_pool = device.createCommandPoolUnique(pool_info);
 
-    const vk::CommandBufferAllocateInfo alloc_info = {
-        .commandPool = *command_pool,
-        .level = vk::CommandBufferLevel::ePrimary,
-        .commandBufferCount = num_images,
-    };
-
-    const auto cmdbuffers = device.allocateCommandBuffers(alloc_info);
     present_frames.resize(num_images);
     for (u32 i = 0; i < num_images; i++) {
         Frame& frame = present_frames[i];
-        frame.cmdbuf = cmdbuffers[i];
+        frame.cmdpool = device.createCommandPool(pool_info);
+        const vk::CommandBufferAllocateInfo alloc_info = {
+            .commandPool = frame.cmdpool,
+            .level = vk::CommandBufferLevel::ePrimary,
+            .commandBufferCount = 1,
+        };
+        frame.cmdbuf = device.allocateCommandBuffers(alloc_info)[0];
         frame.render_ready = device.createSemaphore({});
         frame.present_done = device.createFence({.flags = vk::FenceCreateFlagBits::eSignaled});
         free_queue.push(&frame);
@@ -102,6 +109,7 @@ RendererVulkan::~RendererVulkan() {
         device.destroyImageView(frame.image_view);
         device.destroySemaphore(frame.render_ready);
         device.destroyFence(frame.present_done);
+        device.destroyCommandPool(frame.cmdpool);
     }
 }
 
@@ -166,7 +174,9 @@ void RendererVulkan::RecreateFrame(Frame* frame, u32 width, u32 height) {
 
 bool RendererVulkan::ShowSplash(Frame* frame /*= nullptr*/) {
     const auto* splash = Common::Singleton<Splash>::Instance();
-    if (splash->GetImageData().empty()) {
+    if (!splash->IsLoaded()) {
+        // Decode may still be in flight on its worker thread; skip the splash
+        // rather than stall the presenter behind it.
         return false;
     }
 
@@ -254,7 +264,92 @@ Frame* RendererVulkan::PrepareFrameInternal(VideoCore::Image& image) {
     return frame;
 }
 
+void RendererVulkan::PresentHeadless(Frame* frame) {
+    PROFILE_SCOPE("RendererVulkan::PresentHeadless");
+
+    // No swapchain to blit into; the frame image is only transitioned so an
+    // optional capture readback can copy it, then the submission exists solely
+    // to retire render_ready and pace the frame ring.
+    const vk::CommandBufferBeginInfo begin_info = {
+        .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit,
+    };
+    const vk::CommandBuffer cmdbuf = frame->cmdbuf;
+    bool captured = false;
+    cmdbuf.begin(begin_info);
+    {
+        const vk::ImageMemoryBarrier barrier{
+            .srcAccessMask = vk::AccessFlagBits::eColorAttachmentWrite,
+            .dstAccessMask = vk::AccessFlagBits::eTransferRead,
+            .oldLayout = vk::ImageLayout::eGeneral,
+            .newLayout = vk::ImageLayout::eTransferSrcOptimal,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = frame->image,
+            .subresourceRange{
+                .aspectMask = vk::ImageAspectFlagBits::eColor,
+                .baseMipLevel = 0,
+                .levelCount = 1,
+                .baseArrayLayer = 0,
+                .layerCount = VK_REMAINING_ARRAY_LAYERS,
+            },
+        };
+        cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eColorAttachmentOutput,
+                               vk::PipelineStageFlagBits::eTransfer,
+                               vk::DependencyFlagBits::eByRegion, {}, {}, barrier);
+        if (capture_engine.ShouldCapture()) {
+            captured = capture_engine.RecordCapture(cmdbuf, frame->image, frame->width,
+                                                    frame->height,
+                                                    swapchain.GetSurfaceFormat().format);
+        }
+    }
+    cmdbuf.end();
+
+    static constexpr vk::PipelineStageFlags wait_stage_mask =
+        vk::PipelineStageFlagBits::eAllCommands;
+    const vk::Semaphore capture_semaphore = capture_engine.Semaphore();
+    static constexpr u64 wait_value = 0;
+    const u64 signal_value = capture_engine.SignalValue();
+    const vk::TimelineSemaphoreSubmitInfo timeline_info = {
+        .waitSemaphoreValueCount = 1,
+        .pWaitSemaphoreValues = &wait_value,
+        .signalSemaphoreValueCount = 1,
+        .pSignalSemaphoreValues = &signal_value,
+    };
+    const vk::SubmitInfo submit_info = {
+        .pNext = captured ? &timeline_info : nullptr,
+        .waitSemaphoreCount = 1,
+        .pWaitSemaphores = &frame->render_ready,
+        .pWaitDstStageMask = &wait_stage_mask,
+        .commandBufferCount = 1u,
+        .pCommandBuffers = &cmdbuf,
+        .signalSemaphoreCount = captured ? 1u : 0u,
+        .pSignalSemaphores = &capture_semaphore,
+    };
+
+    {
+        std::scoped_lock submit_lock{scheduler.submit_mutex};
+        try {
+            instance.GetGraphicsQueue().submit(submit_info, frame->present_done);
+        } catch (vk::DeviceLostError& err) {
+            LOG_CRITICAL(Render_Vulkan, "Device lost during headless submit: {}", err.what());
+            UNREACHABLE();
+        }
+    }
+
+    UpdateFrameStats();
+
+    std::scoped_lock fl{free_mutex};
+    free_queue.push(frame);
+    free_cv.notify_one();
+}
+
 void RendererVulkan::Present(Frame* frame) {
+    if (Config::headlessMode()) {
+        PresentHeadless(frame);
+        return;
+    }
+
+    PROFILE_SCOPE("RendererVulkan::Present");
     swapchain.AcquireNextImage();
 
     const vk::Image swapchain_image = swapchain.Image();
@@ -263,6 +358,7 @@ void RendererVulkan::Present(Frame* frame) {
         .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit,
     };
     const vk::CommandBuffer cmdbuf = frame->cmdbuf;
+    bool captured = false;
     cmdbuf.begin(begin_info);
     {
         auto* profiler_ctx = instance.GetProfilerContext();
@@ -334,6 +430,13 @@ void RendererVulkan::Present(Frame* frame) {
                                vk::PipelineStageFlagBits::eAllCommands,
                                vk::DependencyFlagBits::eByRegion, {}, {}, post_barrier);
 
+        // The frame image is already in TransferSrcOptimal for the blit above, so
+        // capturing it only costs one extra copy on the present command buffer.
+        if (capture_engine.ShouldCapture()) {
+            captured = capture_engine.RecordCapture(cmdbuf, frame->image, frame->width,
+                                                    frame->height, swapchain.GetSurfaceFormat().format);
+        }
+
         if (profiler_ctx) {
             TracyVkCollect(profiler_ctx, cmdbuf);
         }
@@ -349,14 +452,28 @@ void RendererVulkan::Present(Frame* frame) {
     const vk::Semaphore image_acquired = swapchain.GetImageAcquiredSemaphore();
     const std::array wait_semaphores = {image_acquired, frame->render_ready};
 
+    const std::array signal_semaphores = {present_ready, capture_engine.Semaphore()};
+
+    // Binary semaphore entries ignore their timeline value; only the capture
+    // semaphore entry is meaningful when a capture copy was recorded.
+    static constexpr std::array<u64, 2> wait_values{};
+    const std::array signal_values = {u64{0}, capture_engine.SignalValue()};
+    const vk::TimelineSemaphoreSubmitInfo timeline_info = {
+        .waitSemaphoreValueCount = static_cast<u32>(wait_values.size()),
+        .pWaitSemaphoreValues = wait_values.data(),
+        .signalSemaphoreValueCount = static_cast<u32>(signal_values.size()),
+        .pSignalSemaphoreValues = signal_values.data(),
+    };
+
     vk::SubmitInfo submit_info = {
+        .pNext = captured ? &timeline_info : nullptr,
         .waitSemaphoreCount = static_cast<u32>(wait_semaphores.size()),
         .pWaitSemaphores = wait_semaphores.data(),
         .pWaitDstStageMask = wait_stage_masks.data(),
         .commandBufferCount = 1u,
         .pCommandBuffers = &cmdbuf,
-        .signalSemaphoreCount = 1,
-        .pSignalSemaphores = &present_ready,
+        .signalSemaphoreCount = captured ? static_cast<u32>(signal_semaphores.size()) : 1,
+        .pSignalSemaphores = signal_semaphores.data(),
     };
 
     std::scoped_lock submit_lock{scheduler.submit_mutex};
@@ -369,12 +486,138 @@ void RendererVulkan::Present(Frame* frame) {
 
     swapchain.Present();
 
+    UpdateFrameStats();
+
     // Free the frame for reuse
     std::scoped_lock fl{free_mutex};
     free_queue.push(frame);
     free_cv.notify_one();
 }
 
+void RendererVulkan::UpdateFrameStats() {
+    using Counter = Common::Profiler::Counter;
+    const auto stats = Common::Singleton<Common::Profiler>::Instance()->EndFrame();
+    hud_accum_time_ms += stats.frame_time_ms;
+    hud_frames++;
+    hud_draws += stats.Get(Counter::DrawCalls);
+    hud_cache_hits += stats.Get(Counter::ImageCacheHits);
+    hud_cache_misses += stats.Get(Counter::ImageCacheMisses);
+    hud_refresh_bytes += stats.Get(Counter::ImageRefreshBytes);
+
+    if (Config::dumpFrameStats()) {
+        if (!stats_csv.IsOpen()) {
+            const auto log_dir = Common::FS::GetUserPath(Common::FS::PathType::LogDir);
+            stats_csv.Open(log_dir / "frame_stats.csv", Common::FS::FileAccessMode::Write,
+                           Common::FS::FileType::TextFile);
+            stats_csv.WriteString("frame,time_ms,draws,dispatches,cache_hits,cache_misses,"
+                                  "refresh_bytes,bcn_passthrough_bytes,detiles_cpu,detiles_gpu,"
+                                  "cpu_write_faults,images_evicted,pipelines_compiled\n");
+        }
+        stats_csv.WriteString(fmt::format(
+            "{},{:.3f},{},{},{},{},{},{},{},{},{},{},{}\n", stats_frame_index++,
+            stats.frame_time_ms, stats.Get(Counter::DrawCalls), stats.Get(Counter::DispatchCalls),
+            stats.Get(Counter::ImageCacheHits), stats.Get(Counter::ImageCacheMisses),
+            stats.Get(Counter::ImageRefreshBytes), stats.Get(Counter::ImageBcnPassthroughBytes),
+            stats.Get(Counter::ImageDetilesCpu), stats.Get(Counter::ImageDetilesGpu),
+            stats.Get(Counter::ImageCpuWriteFaults), stats.Get(Counter::ImagesEvicted),
+            stats.Get(Counter::PipelinesCompiled)));
+    }
+
+    // Sample input-to-flip latency: time from the newest input event the guest
+    // polled to this frame hitting the presentation engine. Idle frames (no new
+    // event consumed since the last one) are skipped so held buttons don't skew
+    // the average upwards.
+    auto* controller = Common::Singleton<Input::GameController>::Instance();
+    const u64 input_marker = controller->LastPolledEventNs();
+    if (input_marker != 0 && input_marker != last_input_marker_ns) {
+        const u64 now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::steady_clock::now().time_since_epoch())
+                               .count();
+        hud_input_latency_ns += now_ns - input_marker;
+        hud_input_samples++;
+        last_input_marker_ns = input_marker;
+    }
+
+    // Refresh the title statistics line roughly once a second.
+    if (hud_accum_time_ms < 1000.0) {
+        return;
+    }
+    const f64 avg_time = hud_accum_time_ms / hud_frames;
+    const u64 lookups = hud_cache_hits + hud_cache_misses;
+    const f64 hit_rate = lookups != 0 ? 100.0 * hud_cache_hits / lookups : 100.0;
+
+    const auto latency = swapchain.TakePresentLatencyStats();
+    const f64 avg_present_ms =
+        latency.count != 0 ? latency.total_us / (1000.0 * latency.count) : 0.0;
+    LOG_DEBUG(Render_Vulkan, "Present latency histogram (<1/<2/<4/<8/<16/>=16 ms): {}",
+              fmt::join(latency.histogram, "/"));
+
+    // GPU time measured by the scheduler's timestamp queries, attributed per
+    // render pass and per compute pipeline. The log ranks the heaviest scopes
+    // so a pass or translated shader blowing the frame budget is identifiable
+    // without attaching an external profiler.
+    auto gpu_timings = scheduler.TakeGpuTimings();
+    std::ranges::sort(gpu_timings, std::ranges::greater{},
+                      &Scheduler::GpuScopeStat::total_ns);
+    f64 gpu_busy_ms = 0.0;
+    for (const auto& stat : gpu_timings) {
+        gpu_busy_ms += stat.total_ns / 1e6;
+    }
+    for (size_t i = 0; i < std::min<size_t>(gpu_timings.size(), 5); ++i) {
+        const auto& stat = gpu_timings[i];
+        LOG_DEBUG(Render_Vulkan, "GPU {} {:#018x}: {:.2f} ms over {} scopes", stat.name, stat.key,
+                  stat.total_ns / 1e6, stat.samples);
+    }
+
+    if (Config::dynamicResolutionEnabled() && rasterizer) {
+        // Feedback controller for the render scale: step down when measured GPU
+        // time approaches the 60 Hz budget, step back up only once ample
+        // headroom returns. The asymmetric thresholds give the controller
+        // hysteresis so it does not oscillate between neighbouring steps.
+        static constexpr std::array<u32, 5> ScaleSteps = {100, 90, 80, 66, 50};
+        constexpr f64 FrameBudgetMs = 16.6;
+        const f64 avg_gpu_ms = gpu_busy_ms / hud_frames;
+        if (avg_gpu_ms > FrameBudgetMs * 0.95 && render_scale_index + 1 < ScaleSteps.size()) {
+            ++render_scale_index;
+            LOG_INFO(Render_Vulkan, "GPU load {:.2f} ms, lowering render scale to {}%", avg_gpu_ms,
+                     ScaleSteps[render_scale_index]);
+        } else if (avg_gpu_ms < FrameBudgetMs * 0.70 && render_scale_index > 0) {
+            --render_scale_index;
+            LOG_INFO(Render_Vulkan, "GPU load {:.2f} ms, raising render scale to {}%", avg_gpu_ms,
+                     ScaleSteps[render_scale_index]);
+        }
+        rasterizer->SetRenderScale(ScaleSteps[render_scale_index]);
+    }
+    if (hud_input_samples != 0) {
+        LOG_DEBUG(Render_Vulkan, "Input-to-flip latency: {:.2f} ms over {} samples",
+                  hud_input_latency_ns / (1e6 * hud_input_samples), hud_input_samples);
+    }
+
+    if (Config::vkPresentMode() == "auto") {
+        // Uncapped titles keep every FIFO slot occupied and back-pressure the
+        // renderer; mailbox lets them run ahead and drops stale images instead.
+        // Titles pacing themselves to vblank stay on FIFO for clean frame times.
+        const bool above_refresh = avg_time < 15.0;
+        swapchain.SetPresentMode(above_refresh ? vk::PresentModeKHR::eMailbox
+                                               : vk::PresentModeKHR::eFifo);
+    }
+
+    window.setTitle(fmt::format(
+        "shadPS4 v{} | {:.2f} ms ({:.0f} FPS) | gpu {:.2f} ms | {} draws/frame | "
+        "image cache {:.0f}% | tex up {:.1f} MB/s | present {:.2f} ms",
+        Common::VERSION, avg_time, 1000.0 / avg_time, gpu_busy_ms / hud_frames,
+        hud_draws / hud_frames, hit_rate, hud_refresh_bytes / (1000.0 * hud_accum_time_ms),
+        avg_present_ms));
+    hud_accum_time_ms = 0.0;
+    hud_frames = 0;
+    hud_draws = 0;
+    hud_cache_hits = 0;
+    hud_cache_misses = 0;
+    hud_refresh_bytes = 0;
+    hud_input_latency_ns = 0;
+    hud_input_samples = 0;
+}
+
 Frame* RendererVulkan::GetRenderFrame() {
     // Wait for free presentation frames
     Frame* frame;
@@ -407,6 +650,9 @@ Frame* RendererVulkan::GetRenderFrame() {
     // Reset fence for next queue submission.
     device.resetFences(frame->present_done);
 
+    // The GPU is done with the previous present, recycle the whole pool at once.
+    device.resetCommandPool(frame->cmdpool);
+
     // If the window dimentions changed, recreate this frame
     if (frame->width != window.getWidth() || frame->height != window.getHeight()) {
         RecreateFrame(frame, window.getWidth(), window.getHeight());
@@ -4,7 +4,9 @@
 #pragma once
 
 #include <condition_variable>
+#include "common/io_file.h"
 #include "video_core/amdgpu/liverpool.h"
+#include "video_core/renderer_vulkan/vk_capture.h"
 #include "video_core/renderer_vulkan/vk_instance.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_swapchain.h"
@@ -28,6 +30,7 @@ struct Frame {
     vk::ImageView image_view;
     vk::Semaphore render_ready;
     vk::Fence present_done;
+    vk::CommandPool cmdpool;
     vk::CommandBuffer cmdbuf;
 };
 
@@ -54,6 +57,7 @@ public:
     VideoCore::Image& RegisterVideoOutSurface(
         const Libraries::VideoOut::BufferAttributeGroup& attribute, VAddr cpu_address) {
         vo_buffers_addr.emplace_back(cpu_address);
+        texture_cache.MarkVoSurface(cpu_address);
         const auto info = VideoCore::ImageInfo{attribute};
         const auto image_id = texture_cache.FindImage(info, cpu_address);
         return texture_cache.GetImage(image_id);
@@ -71,7 +75,9 @@ public:
 
 private:
     Frame* PrepareFrameInternal(VideoCore::Image& image);
+    void PresentHeadless(Frame* frame);
     Frame* GetRenderFrame();
+    void UpdateFrameStats();
 
 private:
     Frontend::WindowSDL& window;
@@ -80,7 +86,7 @@ private:
     Swapchain swapchain;
     std::unique_ptr<Rasterizer> rasterizer;
     VideoCore::TextureCache texture_cache;
-    vk::UniqueCommandPool command_pool;
+    CaptureEngine capture_engine;
     std::vector<Frame> present_frames;
     std::queue<Frame*> free_queue;
     std::mutex free_mutex;
@@ -88,6 +94,27 @@ private:
     std::condition_variable_any frame_cv;
     std::optional<VideoCore::Image> splash_img;
     std::vector<VAddr> vo_buffers_addr;
+
+    // Accumulators for the statistics line shown in the window title.
+    f64 hud_accum_time_ms{};
+    u64 hud_frames{};
+    u64 hud_draws{};
+    u64 hud_cache_hits{};
+    u64 hud_cache_misses{};
+    u64 hud_refresh_bytes{};
+
+    // Per-frame counter rows written when GPU.dumpFrameStats is enabled, so perf
+    // CI can diff texture upload behavior between runs of a replayed capture.
+    Common::FS::IOFile stats_csv;
+    u64 stats_frame_index{};
+
+    // Current step of the dynamic-resolution feedback controller.
+    u32 render_scale_index{};
+
+    // Input-to-flip latency tracking for the cloud-play latency budget.
+    u64 hud_input_latency_ns{};
+    u64 hud_input_samples{};
+    u64 last_input_marker_ns{};
 };
 
 } // namespace Vulkan
@@ -0,0 +1,242 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <bit>
+#include <cstring>
+#include <vector>
+#include <zlib-ng.h>
+#include "common/config.h"
+#include "common/io_file.h"
+#include "common/logging/log.h"
+#include "common/path_util.h"
+#include "common/thread.h"
+#include "video_core/renderer_vulkan/vk_capture.h"
+#include "video_core/renderer_vulkan/vk_instance.h"
+
+namespace Vulkan {
+
+static std::atomic_bool one_shot_request{};
+
+void RequestFrameCapture() {
+    one_shot_request.store(true, std::memory_order_relaxed);
+}
+
+static void AppendChunk(std::vector<u8>& out, const char* tag, const u8* data, size_t size) {
+    const auto append_be = [&out](u32 value) {
+        const u32 be = std::byteswap(value);
+        const u8* bytes = reinterpret_cast<const u8*>(&be);
+        out.insert(out.end(), bytes, bytes + sizeof(be));
+    };
+    append_be(static_cast<u32>(size));
+    out.insert(out.end(), tag, tag + 4);
+    if (size != 0) {
+        out.insert(out.end(), data, data + size);
+    }
+    u32 crc = zng_crc32(0, reinterpret_cast<const u8*>(tag), 4);
+    crc = zng_crc32(crc, data, size);
+    append_be(crc);
+}
+
+/// Minimal RGBA8 PNG encoder; fast compression since per-frame capture favors
+/// throughput over file size.
+static std::vector<u8> EncodePng(const u8* rgba, u32 width, u32 height) {
+    // Every scanline is prefixed with filter type 0 (none).
+    std::vector<u8> raw((size_t(width) * 4 + 1) * height);
+    for (u32 y = 0; y < height; y++) {
+        u8* row = raw.data() + y * (size_t(width) * 4 + 1);
+        row[0] = 0;
+        std::memcpy(row + 1, rgba + size_t(y) * width * 4, size_t(width) * 4);
+    }
+
+    size_t compressed_size = zng_compressBound(raw.size());
+    std::vector<u8> compressed(compressed_size);
+    if (zng_compress2(compressed.data(), &compressed_size, raw.data(), raw.size(), 1) != Z_OK) {
+        return {};
+    }
+
+    std::vector<u8> out{0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    std::array<u8, 13> ihdr{};
+    const u32 width_be = std::byteswap(width);
+    const u32 height_be = std::byteswap(height);
+    std::memcpy(ihdr.data(), &width_be, sizeof(width_be));
+    std::memcpy(ihdr.data() + 4, &height_be, sizeof(height_be));
+    ihdr[8] = 8; // Bit depth
+    ihdr[9] = 6; // Truecolor with alpha; compression/filter/interlace stay 0
+    AppendChunk(out, "IHDR", ihdr.data(), ihdr.size());
+    AppendChunk(out, "IDAT", compressed.data(), compressed_size);
+    AppendChunk(out, "IEND", nullptr, 0);
+    return out;
+}
+
+CaptureEngine::CaptureEngine(const Instance& instance_) : instance{instance_} {
+    const vk::StructureChain semaphore_chain = {
+        vk::SemaphoreCreateInfo{},
+        vk::SemaphoreTypeCreateInfo{
+            .semaphoreType = vk::SemaphoreType::eTimeline,
+            .initialValue = 0,
+        },
+    };
+    semaphore = instance.GetDevice().createSemaphoreUnique(semaphore_chain.get());
+    worker = std::jthread([this](std::stop_token stoken) { EncodeWorker(stoken); });
+}
+
+CaptureEngine::~CaptureEngine() {
+    worker.request_stop();
+    encode_cv.notify_all();
+    worker.join();
+    if (num_saved != 0 || num_dropped != 0) {
+        LOG_INFO(Render_Vulkan, "Captured {} frames, dropped {}", num_saved, num_dropped);
+    }
+}
+
+bool CaptureEngine::ShouldCapture() const {
+    return Config::captureFrames() || one_shot_request.load(std::memory_order_relaxed);
+}
+
+void CaptureEngine::EnsureCapacity(Slot& slot, u64 size) {
+    if (slot.capacity >= size) {
+        return;
+    }
+    const vk::Device device = instance.GetDevice();
+    if (slot.mapped) {
+        device.unmapMemory(*slot.memory);
+        slot.mapped = nullptr;
+    }
+    slot.buffer = device.createBufferUnique({
+        .size = size,
+        .usage = vk::BufferUsageFlagBits::eTransferDst,
+    });
+    const auto requirements = device.getBufferMemoryRequirements(*slot.buffer);
+    const auto memory_properties = instance.GetPhysicalDevice().getMemoryProperties();
+    constexpr auto host_flags =
+        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+    u32 type_index = 0;
+    for (u32 i = 0; i < memory_properties.memoryTypeCount; i++) {
+        if ((requirements.memoryTypeBits & (1U << i)) &&
+            (memory_properties.memoryTypes[i].propertyFlags & host_flags) == host_flags) {
+            type_index = i;
+            break;
+        }
+    }
+    slot.memory = device.allocateMemoryUnique({
+        .allocationSize = requirements.size,
+        .memoryTypeIndex = type_index,
+    });
+    device.bindBufferMemory(*slot.buffer, *slot.memory, 0);
+    slot.mapped = static_cast<u8*>(device.mapMemory(*slot.memory, 0, VK_WHOLE_SIZE));
+    slot.capacity = size;
+}
+
+bool CaptureEngine::RecordCapture(vk::CommandBuffer cmdbuf, vk::Image image, u32 width, u32 height,
+                                  vk::Format format) {
+    Slot* slot = nullptr;
+    for (auto& candidate : slots) {
+        if (!candidate.pending.load(std::memory_order_acquire)) {
+            slot = &candidate;
+            break;
+        }
+    }
+    if (!slot) {
+        // Every slot is still encoding; skip the frame instead of stalling.
+        num_dropped++;
+        return false;
+    }
+    one_shot_request.store(false, std::memory_order_relaxed);
+
+    EnsureCapacity(*slot, u64(width) * height * 4);
+
+    const vk::BufferImageCopy copy = {
+        .bufferOffset = 0,
+        .bufferRowLength = 0,
+        .bufferImageHeight = 0,
+        .imageSubresource{
+            .aspectMask = vk::ImageAspectFlagBits::eColor,
+            .mipLevel = 0,
+            .baseArrayLayer = 0,
+            .layerCount = 1,
+        },
+        .imageOffset = {0, 0, 0},
+        .imageExtent = {width, height, 1},
+    };
+    cmdbuf.copyImageToBuffer(image, vk::ImageLayout::eTransferSrcOptimal, *slot->buffer, copy);
+
+    slot->width = width;
+    slot->height = height;
+    slot->format = format;
+    slot->ready_value = ++signal_value;
+    slot->pending.store(true, std::memory_order_release);
+    encode_cv.notify_one();
+    return true;
+}
+
+void CaptureEngine::SaveSlot(const Slot& slot) {
+    // The blit target inherits the swapchain format, commonly BGRA; PNG wants
+    // RGBA so swizzle while copying out of the mapped slot.
+    std::vector<u8> rgba(slot.mapped, slot.mapped + u64(slot.width) * slot.height * 4);
+    if (slot.format == vk::Format::eB8G8R8A8Unorm || slot.format == vk::Format::eB8G8R8A8Srgb) {
+        for (size_t i = 0; i < rgba.size(); i += 4) {
+            std::swap(rgba[i], rgba[i + 2]);
+        }
+    }
+
+    const auto png = EncodePng(rgba.data(), slot.width, slot.height);
+    if (png.empty()) {
+        LOG_ERROR(Render_Vulkan, "Failed to compress captured frame");
+        return;
+    }
+
+    const auto dir = Common::FS::GetUserPath(Common::FS::PathType::ScreenshotsDir);
+    const auto path = dir / fmt::format("frame_{:06}.png", num_saved);
+    Common::FS::IOFile file{path, Common::FS::FileAccessMode::Write};
+    if (!file.IsOpen()) {
+        LOG_ERROR(Render_Vulkan, "Unable to open {}", path.string());
+        return;
+    }
+    file.WriteSpan<u8>(png);
+    num_saved++;
+}
+
+void CaptureEngine::EncodeWorker(std::stop_token stoken) {
+    Common::SetCurrentThreadName("shadPS4:FrameCapture");
+    Common::SetCurrentThreadRole(Common::ThreadRole::Io);
+
+    while (!stoken.stop_requested()) {
+        Slot* slot = nullptr;
+        {
+            std::unique_lock lock{mutex};
+            encode_cv.wait(lock, stoken, [&] {
+                // Encode in submission order so the video sequence stays sorted.
+                for (auto& candidate : slots) {
+                    if (candidate.pending.load(std::memory_order_acquire) &&
+                        (!slot || candidate.ready_value < slot->ready_value)) {
+                        slot = &candidate;
+                    }
+                }
+                return slot != nullptr;
+            });
+        }
+        if (stoken.stop_requested()) {
+            break;
+        }
+
+        // Wait for the present submission to finish the copy.
+        const vk::SemaphoreWaitInfo wait_info = {
+            .semaphoreCount = 1,
+            .pSemaphores = &semaphore.get(),
+            .pValues = &slot->ready_value,
+        };
+        constexpr u64 WaitTimeoutNs = 100'000'000;
+        while (instance.GetDevice().waitSemaphores(&wait_info, WaitTimeoutNs) !=
+               vk::Result::eSuccess) {
+            if (stoken.stop_requested()) {
+                return;
+            }
+        }
+
+        SaveSlot(*slot);
+        slot->pending.store(false, std::memory_order_release);
+    }
+}
+
+} // namespace Vulkan
@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include "common/types.h"
+#include "video_core/renderer_vulkan/vk_common.h"
+
+namespace Vulkan {
+
+class Instance;
+
+/// Requests a one-shot capture of the next presented frame, e.g. from the
+/// screenshot HLE. Per-frame capture is controlled by GPU.captureFrames.
+void RequestFrameCapture();
+
+/**
+ * Asynchronous frame capture. The present command buffer records a copy of the
+ * frame image into one of a few host-visible slots; the present submission
+ * signals a timeline semaphore when the copy is done and a worker thread then
+ * encodes the pixels as PNG off the critical path. When every slot is still
+ * busy encoding, the frame is skipped rather than stalling presentation.
+ */
+class CaptureEngine {
+public:
+    explicit CaptureEngine(const Instance& instance);
+    ~CaptureEngine();
+
+    /// True when the frame being presented should be captured.
+    bool ShouldCapture() const;
+
+    /// Records a copy of the frame image (expected in TransferSrcOptimal) into
+    /// a free slot. Returns false when all slots are busy; on success the
+    /// present submit must signal Semaphore() with SignalValue().
+    bool RecordCapture(vk::CommandBuffer cmdbuf, vk::Image image, u32 width, u32 height,
+                       vk::Format format);
+
+    vk::Semaphore Semaphore() const {
+        return *semaphore;
+    }
+
+    u64 SignalValue() const {
+        return signal_value;
+    }
+
+private:
+    struct Slot {
+        vk::UniqueBuffer buffer;
+        vk::UniqueDeviceMemory memory;
+        u8* mapped{};
+        u64 capacity{};
+        u32 width{};
+        u32 height{};
+        vk::Format format{};
+        u64 ready_value{};
+        std::atomic_bool pending{};
+    };
+
+    void EnsureCapacity(Slot& slot, u64 size);
+    void EncodeWorker(std::stop_token stoken);
+    void SaveSlot(const Slot& slot);
+
+private:
+    static constexpr size_t NumSlots = 4;
+
+    const Instance& instance;
+    vk::UniqueSemaphore semaphore;
+    std::array<Slot, NumSlots> slots;
+    u64 signal_value{};
+    u64 num_saved{};
+    u64 num_dropped{};
+    std::mutex mutex;
+    std::condition_variable_any encode_cv;
+    std::jthread worker;
+};
+
+} // namespace Vulkan
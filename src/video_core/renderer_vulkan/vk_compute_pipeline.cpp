@@ -4,8 +4,10 @@
 #include <boost/container/small_vector.hpp>
 #include "common/alignment.h"
 #include "core/memory.h"
+#include "video_core/buffer_cache/buffer_cache.h"
 #include "video_core/renderer_vulkan/vk_compute_pipeline.h"
 #include "video_core/renderer_vulkan/vk_instance.h"
+#include "video_core/renderer_vulkan/vk_layout_cache.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_stream_buffer.h"
 #include "video_core/texture_cache/texture_cache.h"
@@ -13,8 +15,10 @@
 namespace Vulkan {
 
 ComputePipeline::ComputePipeline(const Instance& instance_, Scheduler& scheduler_,
-                                 vk::PipelineCache pipeline_cache, const Shader::Info* info_,
-                                 u64 compute_key_, vk::ShaderModule module)
+                                 vk::PipelineCache pipeline_cache, LayoutCache& layout_cache,
+                                 vk::DescriptorSetLayout bindless_layout,
+                                 const Shader::Info* info_,
+                                 const ComputePipelineKey& compute_key_, vk::ShaderModule module)
     : instance{instance_}, scheduler{scheduler_}, compute_key{compute_key_}, info{*info_} {
     const vk::PipelineShaderStageCreateInfo shader_ci = {
         .stage = vk::ShaderStageFlagBits::eCompute,
@@ -33,43 +37,35 @@ ComputePipeline::ComputePipeline(const Instance& instance_, Scheduler& scheduler
             .stageFlags = vk::ShaderStageFlagBits::eCompute,
         });
     }
-    for (const auto& image : info.images) {
-        bindings.push_back({
-            .binding = binding++,
-            .descriptorType = image.is_storage ? vk::DescriptorType::eStorageImage
-                                               : vk::DescriptorType::eSampledImage,
-            .descriptorCount = 1,
-            .stageFlags = vk::ShaderStageFlagBits::eCompute,
-        });
-    }
-    for (const auto& sampler : info.samplers) {
-        bindings.push_back({
-            .binding = binding++,
-            .descriptorType = vk::DescriptorType::eSampler,
-            .descriptorCount = 1,
-            .stageFlags = vk::ShaderStageFlagBits::eCompute,
-        });
+    if (!info.use_bindless_textures) {
+        for (const auto& image : info.images) {
+            bindings.push_back({
+                .binding = binding++,
+                .descriptorType = image.is_storage ? vk::DescriptorType::eStorageImage
+                                                   : vk::DescriptorType::eSampledImage,
+                .descriptorCount = 1,
+                .stageFlags = vk::ShaderStageFlagBits::eCompute,
+            });
+        }
+        for (const auto& sampler : info.samplers) {
+            bindings.push_back({
+                .binding = binding++,
+                .descriptorType = vk::DescriptorType::eSampler,
+                .descriptorCount = 1,
+                .stageFlags = vk::ShaderStageFlagBits::eCompute,
+            });
+        }
     }
 
-    const vk::DescriptorSetLayoutCreateInfo desc_layout_ci = {
-        .flags = vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptorKHR,
-        .bindingCount = static_cast<u32>(bindings.size()),
-        .pBindings = bindings.data(),
-    };
-    desc_layout = instance.GetDevice().createDescriptorSetLayoutUnique(desc_layout_ci);
-
-    const vk::DescriptorSetLayout set_layout = *desc_layout;
-    const vk::PipelineLayoutCreateInfo layout_info = {
-        .setLayoutCount = 1U,
-        .pSetLayouts = &set_layout,
-        .pushConstantRangeCount = 0,
-        .pPushConstantRanges = nullptr,
-    };
-    pipeline_layout = instance.GetDevice().createPipelineLayoutUnique(layout_info);
+    const auto layouts = layout_cache.Get(
+        bindings, info.use_bindless_textures ? bindless_layout : vk::DescriptorSetLayout{},
+        vk::ShaderStageFlagBits::eCompute);
+    desc_layout = layouts.desc_layout;
+    pipeline_layout = layouts.pipeline_layout;
 
     const vk::ComputePipelineCreateInfo compute_pipeline_ci = {
         .stage = shader_ci,
-        .layout = *pipeline_layout,
+        .layout = pipeline_layout,
     };
     auto result =
         instance.GetDevice().createComputePipelineUnique(pipeline_cache, compute_pipeline_ci);
@@ -83,11 +79,15 @@ ComputePipeline::ComputePipeline(const Instance& instance_, Scheduler& scheduler
 ComputePipeline::~ComputePipeline() = default;
 
 bool ComputePipeline::BindResources(Core::MemoryManager* memory, StreamBuffer& staging,
-                                    VideoCore::TextureCache& texture_cache) const {
+                                    VideoCore::BufferCache& buffer_cache,
+                                    VideoCore::TextureCache& texture_cache,
+                                    ComputeBufferAccessList& accesses) const {
     // Bind resource buffers and textures.
     boost::container::static_vector<vk::DescriptorBufferInfo, 16> buffer_infos;
     boost::container::static_vector<vk::DescriptorImageInfo, 16> image_infos;
     boost::container::small_vector<vk::WriteDescriptorSet, 16> set_writes;
+    std::array<u32, Shader::BindlessPushSize / sizeof(u32)> bindless_indices{};
+    u32 slot = Shader::BindlessIndexBase(Shader::Stage::Compute);
     u32 binding{};
 
     for (const auto& buffer : info.buffers) {
@@ -95,10 +95,30 @@ bool ComputePipeline::BindResources(Core::MemoryManager* memory, StreamBuffer& s
         const u32 size = vsharp.GetSize();
         const VAddr address = vsharp.base_address;
         texture_cache.OnCpuWrite(address);
-        const u32 offset = staging.Copy(address, size,
-                                        buffer.is_storage ? instance.StorageMinAlignment()
-                                                          : instance.UniformMinAlignment());
-        buffer_infos.emplace_back(staging.Handle(), offset, size);
+        const u32 alignment =
+            buffer.is_storage ? instance.StorageMinAlignment() : instance.UniformMinAlignment();
+        // Storage buffers bind the cache resident copy when one is available so results
+        // written by a dispatch stay on the device for the next one to consume; the
+        // recorded access lets the rasterizer barrier only the ranges that overlap.
+        bool use_cached = false;
+        if (buffer.is_storage) {
+            const auto [cached, cached_offset] = buffer_cache.ObtainBuffer(address, size);
+            if (cached && cached_offset % alignment == 0) {
+                buffer_infos.emplace_back(cached, cached_offset, size);
+                accesses.push_back({
+                    .address = address,
+                    .size = size,
+                    .buffer = cached,
+                    .offset = cached_offset,
+                    .is_written = buffer.is_written,
+                });
+                use_cached = true;
+            }
+        }
+        if (!use_cached) {
+            const u32 offset = staging.Copy(address, size, alignment);
+            buffer_infos.emplace_back(staging.Handle(), offset, size);
+        }
         set_writes.push_back({
             .dstSet = VK_NULL_HANDLE,
             .dstBinding = binding++,
@@ -125,21 +145,28 @@ bool ComputePipeline::BindResources(Core::MemoryManager* memory, StreamBuffer& s
         }
     }
 
+    // In bindless mode the textures resolve through the global descriptor arrays of
+    // set 1; only their elements need to be named in the push constant index table.
+    // Slot order matches SPIR-V emission: images first, then samplers.
     for (const auto& image_desc : info.images) {
         const auto tsharp =
             info.ReadUd<AmdGpu::Image>(image_desc.sgpr_base, image_desc.dword_offset);
-        const auto& image_view = texture_cache.FindImageView(tsharp, image_desc.is_storage);
-        const auto& image = texture_cache.GetImage(image_view.image_id);
-        image_infos.emplace_back(VK_NULL_HANDLE, *image_view.image_view, image.layout);
-        set_writes.push_back({
-            .dstSet = VK_NULL_HANDLE,
-            .dstBinding = binding++,
-            .dstArrayElement = 0,
-            .descriptorCount = 1,
-            .descriptorType = image_desc.is_storage ? vk::DescriptorType::eStorageImage
-                                                    : vk::DescriptorType::eSampledImage,
-            .pImageInfo = &image_infos.back(),
-        });
+        auto& image_view = texture_cache.FindImageView(tsharp, image_desc.is_storage);
+        if (info.use_bindless_textures) {
+            bindless_indices[slot++] = texture_cache.BindlessSlot(image_view);
+        } else {
+            const auto& image = texture_cache.GetImage(image_view.image_id);
+            image_infos.emplace_back(VK_NULL_HANDLE, *image_view.image_view, image.layout);
+            set_writes.push_back({
+                .dstSet = VK_NULL_HANDLE,
+                .dstBinding = binding++,
+                .dstArrayElement = 0,
+                .descriptorCount = 1,
+                .descriptorType = image_desc.is_storage ? vk::DescriptorType::eStorageImage
+                                                        : vk::DescriptorType::eSampledImage,
+                .pImageInfo = &image_infos.back(),
+            });
+        }
 
         if (texture_cache.IsMeta(tsharp.Address())) {
             LOG_WARNING(Render_Vulkan, "Unexpected metadata read by a CS shader (texture)");
@@ -148,6 +175,10 @@ bool ComputePipeline::BindResources(Core::MemoryManager* memory, StreamBuffer& s
     for (const auto& sampler : info.samplers) {
         const auto ssharp = info.ReadUd<AmdGpu::Sampler>(sampler.sgpr_base, sampler.dword_offset);
         const auto vk_sampler = texture_cache.GetSampler(ssharp);
+        if (info.use_bindless_textures) {
+            bindless_indices[slot++] = texture_cache.BindlessSamplerSlot(vk_sampler);
+            continue;
+        }
         image_infos.emplace_back(vk_sampler, VK_NULL_HANDLE, vk::ImageLayout::eGeneral);
         set_writes.push_back({
             .dstSet = VK_NULL_HANDLE,
@@ -159,12 +190,23 @@ bool ComputePipeline::BindResources(Core::MemoryManager* memory, StreamBuffer& s
         });
     }
 
-    if (set_writes.empty()) {
+    const bool uses_bindless =
+        info.use_bindless_textures && !(info.images.empty() && info.samplers.empty());
+    if (set_writes.empty() && !uses_bindless) {
         return false;
     }
 
     const auto cmdbuf = scheduler.CommandBuffer();
-    cmdbuf.pushDescriptorSetKHR(vk::PipelineBindPoint::eCompute, *pipeline_layout, 0, set_writes);
+    if (!set_writes.empty()) {
+        cmdbuf.pushDescriptorSetKHR(vk::PipelineBindPoint::eCompute, pipeline_layout, 0,
+                                    set_writes);
+    }
+    if (uses_bindless) {
+        cmdbuf.bindDescriptorSets(vk::PipelineBindPoint::eCompute, pipeline_layout, 1,
+                                  texture_cache.BindlessSet(), {});
+        cmdbuf.pushConstants(pipeline_layout, vk::ShaderStageFlagBits::eCompute, 0,
+                             Shader::BindlessPushSize, bindless_indices.data());
+    }
     return true;
 }
 
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <cstring>
+#include <boost/container/small_vector.hpp>
+#include <xxhash.h>
 #include "shader_recompiler/runtime_info.h"
 #include "video_core/renderer_vulkan/vk_common.h"
 
@@ -11,37 +14,77 @@ class MemoryManager;
 }
 
 namespace VideoCore {
+class BufferCache;
 class TextureCache;
-}
+} // namespace VideoCore
 
 namespace Vulkan {
 
 class Instance;
+class LayoutCache;
 class Scheduler;
 class StreamBuffer;
 
+/// Guest range a dispatch accesses through a cache resident buffer, recorded by
+/// BindResources so the rasterizer can compute hazards between dispatches.
+struct ComputeBufferAccess {
+    VAddr address;
+    u32 size;
+    vk::Buffer buffer;
+    u32 offset;
+    bool is_written;
+};
+using ComputeBufferAccessList = boost::container::small_vector<ComputeBufferAccess, 8>;
+
+struct ComputePipelineKey {
+    u64 code_hash;
+    u32 num_thread_x;
+    u32 num_thread_y;
+    u32 num_thread_z;
+    u32 num_user_regs;
+    u32 shared_mem_size;
+
+    bool operator==(const ComputePipelineKey& key) const noexcept {
+        return std::memcmp(this, &key, sizeof(key)) == 0;
+    }
+};
+
 class ComputePipeline {
 public:
     explicit ComputePipeline(const Instance& instance, Scheduler& scheduler,
-                             vk::PipelineCache pipeline_cache, const Shader::Info* info,
-                             u64 compute_key, vk::ShaderModule module);
+                             vk::PipelineCache pipeline_cache, LayoutCache& layout_cache,
+                             vk::DescriptorSetLayout bindless_layout, const Shader::Info* info,
+                             const ComputePipelineKey& compute_key, vk::ShaderModule module);
     ~ComputePipeline();
 
     [[nodiscard]] vk::Pipeline Handle() const noexcept {
         return *pipeline;
     }
 
+    [[nodiscard]] const ComputePipelineKey& GetKey() const noexcept {
+        return compute_key;
+    }
+
     bool BindResources(Core::MemoryManager* memory, StreamBuffer& staging,
-                       VideoCore::TextureCache& texture_cache) const;
+                       VideoCore::BufferCache& buffer_cache,
+                       VideoCore::TextureCache& texture_cache,
+                       ComputeBufferAccessList& accesses) const;
 
 private:
     const Instance& instance;
     Scheduler& scheduler;
     vk::UniquePipeline pipeline;
-    vk::UniquePipelineLayout pipeline_layout;
-    vk::UniqueDescriptorSetLayout desc_layout;
-    u64 compute_key;
+    vk::PipelineLayout pipeline_layout;
+    vk::DescriptorSetLayout desc_layout;
+    ComputePipelineKey compute_key;
     Shader::Info info{};
 };
 
 } // namespace Vulkan
+
+template <>
+struct std::hash<Vulkan::ComputePipelineKey> {
+    std::size_t operator()(const Vulkan::ComputePipelineKey& key) const noexcept {
+        return XXH3_64bits(&key, sizeof(key));
+    }
+};
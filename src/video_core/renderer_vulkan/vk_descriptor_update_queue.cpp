@@ -1,18 +1,89 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "common/alignment.h"
+#include "common/assert.h"
 #include "video_core/renderer_vulkan/vk_descriptor_update_queue.h"
 #include "video_core/renderer_vulkan/vk_instance.h"
 
 namespace Vulkan {
 
-DescriptorUpdateQueue::DescriptorUpdateQueue(const Instance& instance, u32 descriptor_write_max_)
-    : device{instance.GetDevice()}, descriptor_write_max{descriptor_write_max_} {
+DescriptorUpdateQueue::DescriptorUpdateQueue(const Instance& instance_, u32 descriptor_write_max_)
+    : instance{instance_}, device{instance.GetDevice()},
+      descriptor_write_max{descriptor_write_max_} {
+    if (instance.IsDescriptorBufferSupported()) {
+        CreateDescriptorArena();
+        return;
+    }
     descriptor_infos = std::make_unique<DescriptorInfoUnion[]>(descriptor_write_max);
     descriptor_writes = std::make_unique<vk::WriteDescriptorSet[]>(descriptor_write_max);
 }
 
+DescriptorUpdateQueue::~DescriptorUpdateQueue() {
+    if (arena_data) {
+        device.unmapMemory(arena_memory);
+        device.destroyBuffer(arena_buffer);
+        device.freeMemory(arena_memory);
+    }
+}
+
+void DescriptorUpdateQueue::CreateDescriptorArena() {
+    constexpr vk::DeviceSize ArenaSize = 8_MB;
+
+    arena_buffer = device.createBuffer({
+        .size = ArenaSize,
+        .usage = vk::BufferUsageFlagBits::eResourceDescriptorBufferEXT |
+                 vk::BufferUsageFlagBits::eSamplerDescriptorBufferEXT |
+                 vk::BufferUsageFlagBits::eShaderDeviceAddress,
+    });
+
+    const auto memory_properties = instance.GetPhysicalDevice().getMemoryProperties();
+    const auto requirements = device.getBufferMemoryRequirements(arena_buffer);
+    constexpr auto wanted =
+        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent;
+    u32 memory_type{~0u};
+    for (u32 i = 0; i < memory_properties.memoryTypeCount; ++i) {
+        const auto flags = memory_properties.memoryTypes[i].propertyFlags;
+        if ((requirements.memoryTypeBits & (1u << i)) && (flags & wanted) == wanted) {
+            memory_type = i;
+            break;
+        }
+    }
+    ASSERT_MSG(memory_type != ~0u, "No host visible memory type for descriptor arena");
+
+    const vk::StructureChain alloc_chain = {
+        vk::MemoryAllocateInfo{
+            .allocationSize = requirements.size,
+            .memoryTypeIndex = memory_type,
+        },
+        vk::MemoryAllocateFlagsInfo{
+            .flags = vk::MemoryAllocateFlagBits::eDeviceAddress,
+        },
+    };
+    arena_memory = device.allocateMemory(alloc_chain.get());
+    device.bindBufferMemory(arena_buffer, arena_memory, 0);
+    arena_data = static_cast<u8*>(device.mapMemory(arena_memory, 0, VK_WHOLE_SIZE));
+    arena_address = device.getBufferAddress({.buffer = arena_buffer});
+    arena_size = ArenaSize;
+}
+
+vk::DeviceSize DescriptorUpdateQueue::WriteArenaDescriptor(const vk::DescriptorGetInfoEXT& desc_info,
+                                                           size_t size) {
+    const auto& props = instance.GetDescriptorBufferProperties();
+    const auto alignment = props.descriptorBufferOffsetAlignment;
+    ASSERT_MSG(arena_offset + size <= arena_size, "Descriptor arena exhausted");
+
+    const vk::DeviceSize offset = arena_offset;
+    device.getDescriptorEXT(&desc_info, size, arena_data + offset);
+    arena_offset = Common::AlignUp(arena_offset + size, alignment);
+    return offset;
+}
+
 void DescriptorUpdateQueue::Flush() {
+    if (UsesDescriptorBuffer()) {
+        // Arena writes are visible immediately, sets are bound by offset instead.
+        return;
+    }
     if (descriptor_write_end == 0) {
         return;
     }
@@ -23,6 +94,20 @@ void DescriptorUpdateQueue::Flush() {
 void DescriptorUpdateQueue::AddStorageImage(vk::DescriptorSet target, u8 binding,
                                             vk::ImageView image_view,
                                             vk::ImageLayout image_layout) {
+    if (UsesDescriptorBuffer()) {
+        const vk::DescriptorImageInfo image_info = {
+            .imageView = image_view,
+            .imageLayout = image_layout,
+        };
+        WriteArenaDescriptor(
+            {
+                .type = vk::DescriptorType::eStorageImage,
+                .data = {.pStorageImage = &image_info},
+            },
+            instance.GetDescriptorBufferProperties().storageImageDescriptorSize);
+        return;
+    }
+
     if (descriptor_write_end >= descriptor_write_max) [[unlikely]] {
         Flush();
     }
@@ -45,6 +130,31 @@ void DescriptorUpdateQueue::AddStorageImage(vk::DescriptorSet target, u8 binding
 void DescriptorUpdateQueue::AddImageSampler(vk::DescriptorSet target, u8 binding, u8 array_index,
                                             vk::ImageView image_view, vk::Sampler sampler,
                                             vk::ImageLayout image_layout) {
+    if (UsesDescriptorBuffer()) {
+        const auto& props = instance.GetDescriptorBufferProperties();
+        const vk::DescriptorImageInfo image_info = {
+            .sampler = sampler,
+            .imageView = image_view,
+            .imageLayout = image_layout,
+        };
+        if (sampler) {
+            WriteArenaDescriptor(
+                {
+                    .type = vk::DescriptorType::eCombinedImageSampler,
+                    .data = {.pCombinedImageSampler = &image_info},
+                },
+                props.combinedImageSamplerDescriptorSize);
+        } else {
+            WriteArenaDescriptor(
+                {
+                    .type = vk::DescriptorType::eSampledImage,
+                    .data = {.pSampledImage = &image_info},
+                },
+                props.sampledImageDescriptorSize);
+        }
+        return;
+    }
+
     if (descriptor_write_end >= descriptor_write_max) [[unlikely]] {
         Flush();
     }
@@ -68,6 +178,34 @@ void DescriptorUpdateQueue::AddImageSampler(vk::DescriptorSet target, u8 binding
 void DescriptorUpdateQueue::AddBuffer(vk::DescriptorSet target, u8 binding, vk::Buffer buffer,
                                       vk::DeviceSize offset, vk::DeviceSize size,
                                       vk::DescriptorType type) {
+    if (UsesDescriptorBuffer()) {
+        // Buffer descriptors are addressed, thus the target buffer must have been created
+        // with the shader device address usage flag.
+        const auto& props = instance.GetDescriptorBufferProperties();
+        const vk::DescriptorAddressInfoEXT address_info = {
+            .address = device.getBufferAddress({.buffer = buffer}) + offset,
+            .range = size,
+        };
+        const bool is_storage = type == vk::DescriptorType::eStorageBuffer ||
+                                type == vk::DescriptorType::eStorageBufferDynamic;
+        if (is_storage) {
+            WriteArenaDescriptor(
+                {
+                    .type = vk::DescriptorType::eStorageBuffer,
+                    .data = {.pStorageBuffer = &address_info},
+                },
+                props.storageBufferDescriptorSize);
+        } else {
+            WriteArenaDescriptor(
+                {
+                    .type = vk::DescriptorType::eUniformBuffer,
+                    .data = {.pUniformBuffer = &address_info},
+                },
+                props.uniformBufferDescriptorSize);
+        }
+        return;
+    }
+
     if (descriptor_write_end >= descriptor_write_max) [[unlikely]] {
         Flush();
     }
@@ -89,6 +227,12 @@ void DescriptorUpdateQueue::AddBuffer(vk::DescriptorSet target, u8 binding, vk::
 
 void DescriptorUpdateQueue::AddTexelBuffer(vk::DescriptorSet target, u8 binding,
                                            vk::BufferView buffer_view) {
+    if (UsesDescriptorBuffer()) {
+        // Texel buffer descriptors need an address and format which a vk::BufferView
+        // handle does not expose.
+        UNREACHABLE_MSG("Texel buffers are unsupported with the descriptor buffer backend");
+    }
+
     if (descriptor_write_end >= descriptor_write_max) [[unlikely]] {
         Flush();
     }
@@ -23,7 +23,7 @@ struct DescriptorInfoUnion {
 class DescriptorUpdateQueue {
 public:
     explicit DescriptorUpdateQueue(const Instance& instance, u32 descriptor_write_max = 2048);
-    ~DescriptorUpdateQueue() = default;
+    ~DescriptorUpdateQueue();
 
     void Flush();
 
@@ -40,12 +40,49 @@ public:
 
     void AddTexelBuffer(vk::DescriptorSet target, u8 binding, vk::BufferView buffer_view);
 
+    /// Returns true when descriptors are written into the host-visible arena instead of
+    /// being flushed through vkUpdateDescriptorSets.
+    bool UsesDescriptorBuffer() const {
+        return arena_data != nullptr;
+    }
+
+    /// Returns the buffer backing the descriptor arena.
+    vk::Buffer ArenaHandle() const {
+        return arena_buffer;
+    }
+
+    /// Returns the device address of the descriptor arena.
+    vk::DeviceAddress ArenaAddress() const {
+        return arena_address;
+    }
+
+    /// Returns the arena offset the next descriptor will be written to.
+    vk::DeviceSize ArenaOffset() const {
+        return arena_offset;
+    }
+
+    /// Discards all previously written arena descriptors.
+    void ResetArena() {
+        arena_offset = 0;
+    }
+
+private:
+    void CreateDescriptorArena();
+    vk::DeviceSize WriteArenaDescriptor(const vk::DescriptorGetInfoEXT& desc_info, size_t size);
+
 private:
+    const Instance& instance;
     const vk::Device device;
     const u32 descriptor_write_max;
     std::unique_ptr<DescriptorInfoUnion[]> descriptor_infos;
     std::unique_ptr<vk::WriteDescriptorSet[]> descriptor_writes;
     u32 descriptor_write_end = 0;
+    vk::Buffer arena_buffer{};
+    vk::DeviceMemory arena_memory{};
+    vk::DeviceAddress arena_address{};
+    u8* arena_data{};
+    vk::DeviceSize arena_size{};
+    vk::DeviceSize arena_offset{};
 };
 
 } // namespace Vulkan
@@ -0,0 +1,174 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include "common/alignment.h"
+#include "common/assert.h"
+#include "video_core/renderer_vulkan/vk_frame_graph.h"
+
+namespace Vulkan {
+
+FrameGraph::PassId FrameGraph::AddPass(PassType type, std::string_view name,
+                                       std::function<void()>&& execute) {
+    const PassId id = static_cast<PassId>(passes.size());
+    auto& pass = passes.emplace_back();
+    pass.type = type;
+    pass.name = name;
+    pass.execute = std::move(execute);
+    return id;
+}
+
+void FrameGraph::AddRead(PassId pass, VAddr addr, u64 size) {
+    passes[pass].reads.emplace_back(addr, size);
+}
+
+void FrameGraph::AddWrite(PassId pass, VAddr addr, u64 size) {
+    passes[pass].writes.emplace_back(addr, size);
+}
+
+void FrameGraph::DeclareTransient(PassId first_pass, PassId last_pass, u64 size, u64 alignment) {
+    ASSERT(first_pass <= last_pass && last_pass < passes.size());
+    transients.push_back({
+        .first_pass = first_pass,
+        .last_pass = last_pass,
+        .size = size,
+        .alignment = alignment,
+    });
+}
+
+bool FrameGraph::PassesConflict(const Pass& earlier, const Pass& later) {
+    static constexpr auto overlaps = [](const std::pair<VAddr, u64>& a,
+                                        const std::pair<VAddr, u64>& b) {
+        return a.first < b.first + b.second && b.first < a.first + a.second;
+    };
+    const auto any_overlap = [](const auto& lhs, const auto& rhs) {
+        return std::ranges::any_of(lhs, [&rhs](const auto& range) {
+            return std::ranges::any_of(rhs, [&range](const auto& other) { //
+                return overlaps(range, other);
+            });
+        });
+    };
+    // Read-after-write, write-after-write and write-after-read all order the
+    // passes; two readers of the same range stay independent.
+    return any_overlap(earlier.writes, later.reads) || any_overlap(earlier.writes, later.writes) ||
+           any_overlap(earlier.reads, later.writes);
+}
+
+void FrameGraph::Compile() {
+    const u32 num_passes = static_cast<u32>(passes.size());
+
+    // Build dependency edges. Recording order is program order, so only
+    // earlier passes can be depended on; frames hold at most a few hundred
+    // passes and access lists are short, so the quadratic sweep stays cheap.
+    for (u32 later = 0; later < num_passes; ++later) {
+        for (u32 earlier = 0; earlier < later; ++earlier) {
+            if (PassesConflict(passes[earlier], passes[later])) {
+                passes[later].depends_on.push_back(earlier);
+            }
+        }
+    }
+
+    // List-schedule a topological order that prefers continuing runs of the
+    // current pass type, so independent passes of the same kind land adjacent
+    // and become merge candidates instead of interleaving with other work.
+    schedule.clear();
+    schedule.reserve(num_passes);
+    std::vector<u32> num_unscheduled_deps(num_passes);
+    std::vector<bool> scheduled(num_passes, false);
+    for (u32 id = 0; id < num_passes; ++id) {
+        num_unscheduled_deps[id] = static_cast<u32>(passes[id].depends_on.size());
+    }
+    while (schedule.size() < num_passes) {
+        const PassType prev_type =
+            schedule.empty() ? PassType::Graphics : passes[schedule.back()].type;
+        PassId picked = num_passes;
+        for (u32 id = 0; id < num_passes; ++id) {
+            if (scheduled[id] || num_unscheduled_deps[id] != 0) {
+                continue;
+            }
+            // Recording order breaks ties, keeping the schedule stable.
+            if (picked == num_passes || passes[id].type == prev_type) {
+                picked = id;
+                if (passes[id].type == prev_type) {
+                    break;
+                }
+            }
+        }
+        ASSERT_MSG(picked != num_passes, "Dependency cycle in frame graph");
+        scheduled[picked] = true;
+        schedule.push_back(picked);
+        for (u32 id = picked + 1; id < num_passes; ++id) {
+            const auto& deps = passes[id].depends_on;
+            if (std::ranges::find(deps, picked) != deps.end()) {
+                --num_unscheduled_deps[id];
+            }
+        }
+    }
+
+    // Mark passes that can merge with their scheduled predecessor: same type,
+    // and no ordering edge between them, so they can share one rendering
+    // scope or dispatch stretch without an intervening barrier.
+    for (size_t i = 1; i < schedule.size(); ++i) {
+        const Pass& prev = passes[schedule[i - 1]];
+        Pass& curr = passes[schedule[i]];
+        const auto& deps = curr.depends_on;
+        curr.merge_with_prev =
+            curr.type == prev.type && std::ranges::find(deps, schedule[i - 1]) == deps.end();
+    }
+
+    // Assign transient heap offsets with a linear scan over schedule-order
+    // lifetimes; regions of attachments whose last pass already ran are free
+    // for reuse, which is what collapses hundreds of MB of render targets.
+    std::vector<u32> schedule_pos(num_passes);
+    for (u32 pos = 0; pos < num_passes; ++pos) {
+        schedule_pos[schedule[pos]] = pos;
+    }
+    struct LiveRegion {
+        u64 offset;
+        u64 size;
+        u32 last_pos;
+    };
+    std::vector<LiveRegion> live;
+    std::vector<Transient*> order(transients.size());
+    std::ranges::transform(transients, order.begin(), [](Transient& t) { return &t; });
+    std::ranges::sort(order, {}, [&schedule_pos](const Transient* t) { //
+        return schedule_pos[t->first_pass];
+    });
+    transient_heap_size = 0;
+    for (Transient* transient : order) {
+        const u32 first_pos = schedule_pos[transient->first_pass];
+        const u32 last_pos = schedule_pos[transient->last_pass];
+        std::erase_if(live, [first_pos](const LiveRegion& r) { return r.last_pos < first_pos; });
+        // First-fit into the gaps between live regions, falling back to the
+        // end of the heap when nothing expired is large enough.
+        u64 offset = 0;
+        std::ranges::sort(live, {}, &LiveRegion::offset);
+        for (const LiveRegion& region : live) {
+            const u64 aligned = Common::AlignUp(offset, transient->alignment);
+            if (aligned + transient->size <= region.offset) {
+                offset = aligned;
+                break;
+            }
+            offset = std::max(offset, region.offset + region.size);
+        }
+        offset = Common::AlignUp(offset, transient->alignment);
+        transient->heap_offset = offset;
+        live.push_back({offset, transient->size, last_pos});
+        transient_heap_size = std::max(transient_heap_size, offset + transient->size);
+    }
+}
+
+void FrameGraph::Execute() {
+    for (const PassId id : schedule) {
+        passes[id].execute();
+    }
+}
+
+void FrameGraph::Reset() {
+    passes.clear();
+    transients.clear();
+    schedule.clear();
+    transient_heap_size = 0;
+}
+
+} // namespace Vulkan
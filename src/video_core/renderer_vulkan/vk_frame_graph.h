@@ -0,0 +1,110 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <boost/container/small_vector.hpp>
+
+#include "common/types.h"
+
+namespace Vulkan {
+
+/**
+ * Records the passes of a frame before any of them reach a command buffer,
+ * giving submission a global view the immediate PM4 translation lacks. After
+ * recording, Compile() derives dependencies from the guest address ranges each
+ * pass touches, reorders independent passes so compatible ones become
+ * adjacent, marks mergeable neighbors, and assigns transient attachments
+ * aliased offsets in a shared heap based on their pass lifetimes. Execute()
+ * then replays the pass callbacks in the planned order.
+ *
+ * This is the structural layer; the rasterizer adopts it incrementally by
+ * recording its draw and dispatch batches as passes instead of emitting
+ * commands directly, which is what unlocks barrier minimization, transient
+ * memory aliasing and multi-queue overlap from one place.
+ */
+class FrameGraph {
+public:
+    using PassId = u32;
+    static constexpr u32 InvalidOffset = ~0U;
+
+    enum class PassType : u32 {
+        Graphics,
+        Compute,
+        Transfer,
+    };
+
+    struct Pass {
+        PassType type;
+        std::string_view name;
+        std::function<void()> execute;
+        boost::container::small_vector<std::pair<VAddr, u64>, 8> reads;
+        boost::container::small_vector<std::pair<VAddr, u64>, 8> writes;
+        // Filled by Compile().
+        boost::container::small_vector<PassId, 4> depends_on;
+        bool merge_with_prev{};
+    };
+
+    struct Transient {
+        PassId first_pass;
+        PassId last_pass;
+        u64 size;
+        u64 alignment;
+        // Filled by Compile(); offset into the shared transient heap.
+        u64 heap_offset{};
+    };
+
+    /// Appends a pass executing the given callback; accesses are declared
+    /// afterwards with AddRead/AddWrite against the returned id.
+    PassId AddPass(PassType type, std::string_view name, std::function<void()>&& execute);
+
+    void AddRead(PassId pass, VAddr addr, u64 size);
+    void AddWrite(PassId pass, VAddr addr, u64 size);
+
+    /// Declares backing memory only alive between the two passes; Compile()
+    /// places it in the transient heap, reusing regions of attachments whose
+    /// lifetimes ended.
+    void DeclareTransient(PassId first_pass, PassId last_pass, u64 size, u64 alignment);
+
+    /// Builds the dependency graph, reorders independent passes to make
+    /// compatible neighbors adjacent, marks merge candidates and assigns
+    /// aliased transient offsets.
+    void Compile();
+
+    /// Runs the pass callbacks in the order Compile() planned.
+    void Execute();
+
+    /// Discards all recorded state for the next frame.
+    void Reset();
+
+    /// Total bytes the transient heap needs after aliasing; without aliasing
+    /// this would be the sum of all declared transient sizes.
+    u64 TransientHeapSize() const noexcept {
+        return transient_heap_size;
+    }
+
+    const Pass& GetPass(PassId id) const {
+        return passes[id];
+    }
+
+    std::span<const PassId> Schedule() const noexcept {
+        return schedule;
+    }
+
+private:
+    /// Returns true when any declared access of the two passes overlaps with
+    /// at least one side writing.
+    static bool PassesConflict(const Pass& earlier, const Pass& later);
+
+    std::vector<Pass> passes;
+    std::vector<Transient> transients;
+    std::vector<PassId> schedule;
+    u64 transient_heap_size{};
+};
+
+} // namespace Vulkan
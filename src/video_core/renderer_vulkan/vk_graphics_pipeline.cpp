@@ -8,8 +8,10 @@
 #include "common/assert.h"
 #include "core/memory.h"
 #include "video_core/amdgpu/resource.h"
+#include "video_core/buffer_cache/buffer_cache.h"
 #include "video_core/renderer_vulkan/vk_graphics_pipeline.h"
 #include "video_core/renderer_vulkan/vk_instance.h"
+#include "video_core/renderer_vulkan/vk_layout_cache.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_stream_buffer.h"
 #include "video_core/texture_cache/texture_cache.h"
@@ -19,6 +21,8 @@ namespace Vulkan {
 GraphicsPipeline::GraphicsPipeline(const Instance& instance_, Scheduler& scheduler_,
                                    const GraphicsPipelineKey& key_,
                                    vk::PipelineCache pipeline_cache,
+                                   PipelineLibraryCache* library_cache, LayoutCache& layout_cache,
+                                   vk::DescriptorSetLayout bindless_layout,
                                    std::span<const Shader::Info*, MaxShaderStages> infos,
                                    std::array<vk::ShaderModule, MaxShaderStages> modules)
     : instance{instance_}, scheduler{scheduler_}, key{key_} {
@@ -29,15 +33,7 @@ GraphicsPipeline::GraphicsPipeline(const Instance& instance_, Scheduler& schedul
         }
         stages[i] = *infos[i];
     }
-    BuildDescSetLayout();
-    const vk::DescriptorSetLayout set_layout = *desc_layout;
-    const vk::PipelineLayoutCreateInfo layout_info = {
-        .setLayoutCount = 1U,
-        .pSetLayouts = &set_layout,
-        .pushConstantRangeCount = 0,
-        .pPushConstantRanges = nullptr,
-    };
-    pipeline_layout = instance.GetDevice().createPipelineLayoutUnique(layout_info);
+    BuildDescSetLayout(layout_cache, bindless_layout);
 
     boost::container::static_vector<vk::VertexInputBindingDescription, 32> bindings;
     boost::container::static_vector<vk::VertexInputAttributeDescription, 32> attributes;
@@ -250,6 +246,96 @@ GraphicsPipeline::GraphicsPipeline(const Instance& instance_, Scheduler& schedul
         .blendConstants = std::array{1.0f, 1.0f, 1.0f, 1.0f},
     };
 
+    if (instance.IsGraphicsPipelineLibrarySupported() && library_cache != nullptr) {
+        // Split the pipeline into the shader-dependent half and the output
+        // interface. Both halves are cached, so a blend or attachment change
+        // reuses the compiled shaders and only pays for the link below.
+        const auto get_library = [&](tsl::robin_map<size_t, vk::UniquePipeline>& libs, size_t hash,
+                                     const vk::GraphicsPipelineCreateInfo& ci) {
+            std::scoped_lock lock{library_cache->mutex};
+            const auto [it, is_new] = libs.try_emplace(hash);
+            if (is_new) {
+                auto result = device.createGraphicsPipelineUnique(pipeline_cache, ci);
+                ASSERT_MSG(result.result == vk::Result::eSuccess,
+                           "Graphics pipeline library creation failed!");
+                it.value() = std::move(result.value);
+            }
+            return *it->second;
+        };
+
+        // Hash only the key fields each half actually consumes, so permutations
+        // of the other half map to the same library.
+        GraphicsPipelineKey shader_part = key;
+        shader_part.color_formats.fill(vk::Format::eUndefined);
+        shader_part.depth_format = vk::Format::eUndefined;
+        shader_part.blend_controls = {};
+        shader_part.write_masks = {};
+        shader_part.cb_shader_mask = {};
+        GraphicsPipelineKey output_part{};
+        output_part.color_formats = key.color_formats;
+        output_part.depth_format = key.depth_format;
+        output_part.blend_controls = key.blend_controls;
+        output_part.write_masks = key.write_masks;
+        output_part.cb_shader_mask = key.cb_shader_mask;
+        output_part.num_samples = key.num_samples;
+
+        const vk::GraphicsPipelineLibraryCreateInfoEXT shader_lib_flags = {
+            .flags = vk::GraphicsPipelineLibraryFlagBitsEXT::eVertexInputInterface |
+                     vk::GraphicsPipelineLibraryFlagBitsEXT::ePreRasterizationShaders |
+                     vk::GraphicsPipelineLibraryFlagBitsEXT::eFragmentShader,
+        };
+        const vk::GraphicsPipelineCreateInfo shader_lib_ci = {
+            .pNext = &shader_lib_flags,
+            .flags = vk::PipelineCreateFlagBits::eLibraryKHR,
+            .stageCount = shader_count,
+            .pStages = shader_stages.data(),
+            .pVertexInputState = &vertex_input_info,
+            .pInputAssemblyState = &input_assembly,
+            .pViewportState = &viewport_info,
+            .pRasterizationState = &raster_state,
+            .pMultisampleState = &multisampling,
+            .pDepthStencilState = &depth_info,
+            .pDynamicState = &dynamic_info,
+            .layout = pipeline_layout,
+        };
+        const vk::StructureChain output_lib_flags = {
+            vk::GraphicsPipelineLibraryCreateInfoEXT{
+                .flags = vk::GraphicsPipelineLibraryFlagBitsEXT::eFragmentOutputInterface,
+            },
+            pipeline_rendering_ci,
+        };
+        const vk::GraphicsPipelineCreateInfo output_lib_ci = {
+            .pNext = &output_lib_flags.get(),
+            .flags = vk::PipelineCreateFlagBits::eLibraryKHR,
+            .pMultisampleState = &multisampling,
+            .pColorBlendState = &color_blending,
+            .pDynamicState = &dynamic_info,
+            .layout = pipeline_layout,
+        };
+
+        const std::array libraries = {
+            get_library(library_cache->shader_libs,
+                        std::hash<GraphicsPipelineKey>{}(shader_part), shader_lib_ci),
+            get_library(library_cache->output_libs,
+                        std::hash<GraphicsPipelineKey>{}(output_part), output_lib_ci),
+        };
+        const vk::PipelineLibraryCreateInfoKHR link_info = {
+            .libraryCount = static_cast<u32>(libraries.size()),
+            .pLibraries = libraries.data(),
+        };
+        const vk::GraphicsPipelineCreateInfo pipeline_info = {
+            .pNext = &link_info,
+            .layout = pipeline_layout,
+        };
+        auto result = device.createGraphicsPipelineUnique(pipeline_cache, pipeline_info);
+        if (result.result == vk::Result::eSuccess) {
+            pipeline = std::move(result.value);
+        } else {
+            UNREACHABLE_MSG("Graphics pipeline link failed!");
+        }
+        return;
+    }
+
     const vk::GraphicsPipelineCreateInfo pipeline_info = {
         .pNext = &pipeline_rendering_ci,
         .stageCount = shader_count,
@@ -262,7 +348,7 @@ GraphicsPipeline::GraphicsPipeline(const Instance& instance_, Scheduler& schedul
         .pDepthStencilState = &depth_info,
         .pColorBlendState = &color_blending,
         .pDynamicState = &dynamic_info,
-        .layout = *pipeline_layout,
+        .layout = pipeline_layout,
     };
 
     auto result = device.createGraphicsPipelineUnique(pipeline_cache, pipeline_info);
@@ -275,8 +361,10 @@ GraphicsPipeline::GraphicsPipeline(const Instance& instance_, Scheduler& schedul
 
 GraphicsPipeline::~GraphicsPipeline() = default;
 
-void GraphicsPipeline::BuildDescSetLayout() {
+void GraphicsPipeline::BuildDescSetLayout(LayoutCache& layout_cache,
+                                          vk::DescriptorSetLayout bindless_layout) {
     u32 binding{};
+    bool uses_bindless = false;
     boost::container::small_vector<vk::DescriptorSetLayoutBinding, 32> bindings;
     for (const auto& stage : stages) {
         for (const auto& buffer : stage.buffers) {
@@ -288,6 +376,13 @@ void GraphicsPipeline::BuildDescSetLayout() {
                 .stageFlags = vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,
             });
         }
+        if (stage.use_bindless_textures) {
+            // Images and samplers live in the global arrays of set 1 and occupy no
+            // set 0 bindings; SPIR-V emission skips them the same way so buffer
+            // binding numbers stay in sync.
+            uses_bindless = true;
+            continue;
+        }
         for (const auto& image : stage.images) {
             bindings.push_back({
                 .binding = binding++,
@@ -306,22 +401,24 @@ void GraphicsPipeline::BuildDescSetLayout() {
             });
         }
     }
-    const vk::DescriptorSetLayoutCreateInfo desc_layout_ci = {
-        .flags = vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptorKHR,
-        .bindingCount = static_cast<u32>(bindings.size()),
-        .pBindings = bindings.data(),
-    };
-    desc_layout = instance.GetDevice().createDescriptorSetLayoutUnique(desc_layout_ci);
+    const auto layouts = layout_cache.Get(
+        bindings, uses_bindless ? bindless_layout : vk::DescriptorSetLayout{},
+        vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment);
+    desc_layout = layouts.desc_layout;
+    pipeline_layout = layouts.pipeline_layout;
 }
 
 void GraphicsPipeline::BindResources(Core::MemoryManager* memory, StreamBuffer& staging,
+                                     VideoCore::BufferCache& buffer_cache,
                                      VideoCore::TextureCache& texture_cache) const {
-    BindVertexBuffers(staging);
+    BindVertexBuffers(staging, buffer_cache);
 
     // Bind resource buffers and textures.
     boost::container::static_vector<vk::DescriptorBufferInfo, 16> buffer_infos;
     boost::container::static_vector<vk::DescriptorImageInfo, 32> image_infos;
     boost::container::small_vector<vk::WriteDescriptorSet, 16> set_writes;
+    std::array<u32, Shader::BindlessPushSize / sizeof(u32)> bindless_indices{};
+    bool uses_bindless = false;
     u32 binding{};
 
     for (const auto& stage : stages) {
@@ -349,21 +446,30 @@ void GraphicsPipeline::BindResources(Core::MemoryManager* memory, StreamBuffer&
         }
 
         boost::container::static_vector<AmdGpu::Image, 16> tsharps;
+        // In bindless stages the textures resolve through the global descriptor
+        // arrays; only their elements need to be named in the push constant index
+        // table. Slot order matches SPIR-V emission: images first, then samplers.
+        u32 slot = Shader::BindlessIndexBase(stage.stage);
+        uses_bindless |= stage.use_bindless_textures;
         for (const auto& image_desc : stage.images) {
             const auto& tsharp = tsharps.emplace_back(
                 stage.ReadUd<AmdGpu::Image>(image_desc.sgpr_base, image_desc.dword_offset));
-            const auto& image_view = texture_cache.FindImageView(tsharp, image_desc.is_storage);
-            const auto& image = texture_cache.GetImage(image_view.image_id);
-            image_infos.emplace_back(VK_NULL_HANDLE, *image_view.image_view, image.layout);
-            set_writes.push_back({
-                .dstSet = VK_NULL_HANDLE,
-                .dstBinding = binding++,
-                .dstArrayElement = 0,
-                .descriptorCount = 1,
-                .descriptorType = image_desc.is_storage ? vk::DescriptorType::eStorageImage
-                                                        : vk::DescriptorType::eSampledImage,
-                .pImageInfo = &image_infos.back(),
-            });
+            auto& image_view = texture_cache.FindImageView(tsharp, image_desc.is_storage);
+            if (stage.use_bindless_textures) {
+                bindless_indices[slot++] = texture_cache.BindlessSlot(image_view);
+            } else {
+                const auto& image = texture_cache.GetImage(image_view.image_id);
+                image_infos.emplace_back(VK_NULL_HANDLE, *image_view.image_view, image.layout);
+                set_writes.push_back({
+                    .dstSet = VK_NULL_HANDLE,
+                    .dstBinding = binding++,
+                    .dstArrayElement = 0,
+                    .descriptorCount = 1,
+                    .descriptorType = image_desc.is_storage ? vk::DescriptorType::eStorageImage
+                                                            : vk::DescriptorType::eSampledImage,
+                    .pImageInfo = &image_infos.back(),
+                });
+            }
 
             if (texture_cache.IsMeta(tsharp.Address())) {
                 LOG_WARNING(Render_Vulkan, "Unexpected metadata read by a PS shader (texture)");
@@ -378,6 +484,10 @@ void GraphicsPipeline::BindResources(Core::MemoryManager* memory, StreamBuffer&
                 }
             }
             const auto vk_sampler = texture_cache.GetSampler(ssharp);
+            if (stage.use_bindless_textures) {
+                bindless_indices[slot++] = texture_cache.BindlessSamplerSlot(vk_sampler);
+                continue;
+            }
             image_infos.emplace_back(vk_sampler, VK_NULL_HANDLE, vk::ImageLayout::eGeneral);
             set_writes.push_back({
                 .dstSet = VK_NULL_HANDLE,
@@ -390,14 +500,22 @@ void GraphicsPipeline::BindResources(Core::MemoryManager* memory, StreamBuffer&
         }
     }
 
+    const auto cmdbuf = scheduler.CommandBuffer();
     if (!set_writes.empty()) {
-        const auto cmdbuf = scheduler.CommandBuffer();
-        cmdbuf.pushDescriptorSetKHR(vk::PipelineBindPoint::eGraphics, *pipeline_layout, 0,
+        cmdbuf.pushDescriptorSetKHR(vk::PipelineBindPoint::eGraphics, pipeline_layout, 0,
                                     set_writes);
     }
+    if (uses_bindless) {
+        cmdbuf.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, pipeline_layout, 1,
+                                  texture_cache.BindlessSet(), {});
+        cmdbuf.pushConstants(pipeline_layout,
+                             vk::ShaderStageFlagBits::eVertex | vk::ShaderStageFlagBits::eFragment,
+                             0, Shader::BindlessPushSize, bindless_indices.data());
+    }
 }
 
-void GraphicsPipeline::BindVertexBuffers(StreamBuffer& staging) const {
+void GraphicsPipeline::BindVertexBuffers(StreamBuffer& staging,
+                                         VideoCore::BufferCache& buffer_cache) const {
     const auto& vs_info = stages[0];
     if (vs_info.vs_inputs.empty()) {
         return;
@@ -410,7 +528,8 @@ void GraphicsPipeline::BindVertexBuffers(StreamBuffer& staging) const {
     struct BufferRange {
         VAddr base_address;
         VAddr end_address;
-        u64 offset; // offset in the mapped memory
+        vk::Buffer handle;
+        u64 offset; // offset in the bound buffer
 
         size_t GetSize() const {
             return end_address - base_address;
@@ -441,9 +560,17 @@ void GraphicsPipeline::BindVertexBuffers(StreamBuffer& staging) const {
         }
     }
 
-    // Map buffers
+    // Map buffers, preferring a cached GPU resident copy over streaming the range.
     for (auto& range : ranges_merged) {
-        range.offset = staging.Copy(range.base_address, range.GetSize(), 4);
+        const auto [buffer, offset] = buffer_cache.ObtainBuffer(range.base_address,
+                                                                static_cast<u32>(range.GetSize()));
+        if (buffer) {
+            range.handle = buffer;
+            range.offset = offset;
+        } else {
+            range.handle = staging.Handle();
+            range.offset = staging.Copy(range.base_address, range.GetSize(), 4);
+        }
     }
 
     // Bind vertex buffers
@@ -457,7 +584,7 @@ void GraphicsPipeline::BindVertexBuffers(StreamBuffer& staging) const {
             });
         assert(host_buffer != ranges_merged.cend());
 
-        host_buffers[i] = staging.Handle();
+        host_buffers[i] = host_buffer->handle;
         host_offsets[i] = host_buffer->offset + buffer.base_address - host_buffer->base_address;
     }
 
@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <mutex>
+#include <tsl/robin_map.h>
 #include <xxhash.h>
 #include "common/types.h"
 #include "shader_recompiler/runtime_info.h"
@@ -12,8 +14,9 @@ class MemoryManager;
 }
 
 namespace VideoCore {
+class BufferCache;
 class TextureCache;
-}
+} // namespace VideoCore
 
 namespace Vulkan {
 
@@ -21,6 +24,7 @@ static constexpr u32 MaxVertexBufferCount = 32;
 static constexpr u32 MaxShaderStages = 5;
 
 class Instance;
+class LayoutCache;
 class Scheduler;
 class StreamBuffer;
 
@@ -56,15 +60,28 @@ struct GraphicsPipelineKey {
     }
 };
 
+/// Cached VK_EXT_graphics_pipeline_library halves shared by all pipelines:
+/// the shader-dependent part (vertex input, pre-rasterization, fragment) and
+/// the output-interface part (blend state, attachment formats). A new blend
+/// permutation then only links against an already compiled shader half.
+struct PipelineLibraryCache {
+    tsl::robin_map<size_t, vk::UniquePipeline> shader_libs;
+    tsl::robin_map<size_t, vk::UniquePipeline> output_libs;
+    std::mutex mutex;
+};
+
 class GraphicsPipeline {
 public:
     explicit GraphicsPipeline(const Instance& instance, Scheduler& scheduler,
                               const GraphicsPipelineKey& key, vk::PipelineCache pipeline_cache,
+                              PipelineLibraryCache* library_cache, LayoutCache& layout_cache,
+                              vk::DescriptorSetLayout bindless_layout,
                               std::span<const Shader::Info*, MaxShaderStages> infos,
                               std::array<vk::ShaderModule, MaxShaderStages> modules);
     ~GraphicsPipeline();
 
     void BindResources(Core::MemoryManager* memory, StreamBuffer& staging,
+                       VideoCore::BufferCache& buffer_cache,
                        VideoCore::TextureCache& texture_cache) const;
 
     [[nodiscard]] vk::Pipeline Handle() const noexcept {
@@ -85,15 +102,15 @@ public:
     }
 
 private:
-    void BuildDescSetLayout();
-    void BindVertexBuffers(StreamBuffer& staging) const;
+    void BuildDescSetLayout(LayoutCache& layout_cache, vk::DescriptorSetLayout bindless_layout);
+    void BindVertexBuffers(StreamBuffer& staging, VideoCore::BufferCache& buffer_cache) const;
 
 private:
     const Instance& instance;
     Scheduler& scheduler;
     vk::UniquePipeline pipeline;
-    vk::UniquePipelineLayout pipeline_layout;
-    vk::UniqueDescriptorSetLayout desc_layout;
+    vk::PipelineLayout pipeline_layout;
+    vk::DescriptorSetLayout desc_layout;
     std::array<Shader::Info, MaxShaderStages> stages{};
     GraphicsPipelineKey key;
 };
@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "common/assert.h"
+#include "video_core/host_shaders/quad_to_tri_indices_comp.h"
+#include "video_core/renderer_vulkan/vk_index_converter.h"
+#include "video_core/renderer_vulkan/vk_instance.h"
+#include "video_core/renderer_vulkan/vk_scheduler.h"
+#include "video_core/renderer_vulkan/vk_shader_util.h"
+#include "video_core/renderer_vulkan/vk_stream_buffer.h"
+
+namespace Vulkan {
+
+struct IndexEmitParams {
+    u32 num_quads;
+};
+
+IndexConverter::IndexConverter(const Instance& instance_, Scheduler& scheduler_)
+    : instance{instance_}, scheduler{scheduler_} {
+    const auto module = Compile(HostShaders::QUAD_TO_TRI_INDICES_COMP,
+                                vk::ShaderStageFlagBits::eCompute, instance.GetDevice());
+    SetObjectName(instance.GetDevice(), module, "QuadToTriIndices");
+
+    const vk::PipelineShaderStageCreateInfo shader_ci = {
+        .stage = vk::ShaderStageFlagBits::eCompute,
+        .module = module,
+        .pName = "main",
+    };
+
+    const vk::DescriptorSetLayoutBinding binding = {
+        .binding = 0,
+        .descriptorType = vk::DescriptorType::eStorageBuffer,
+        .descriptorCount = 1,
+        .stageFlags = vk::ShaderStageFlagBits::eCompute,
+    };
+
+    const vk::DescriptorSetLayoutCreateInfo desc_layout_ci = {
+        .flags = vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptorKHR,
+        .bindingCount = 1,
+        .pBindings = &binding,
+    };
+    desc_layout = instance.GetDevice().createDescriptorSetLayoutUnique(desc_layout_ci);
+
+    const vk::PushConstantRange push_constants = {
+        .stageFlags = vk::ShaderStageFlagBits::eCompute,
+        .offset = 0,
+        .size = sizeof(IndexEmitParams),
+    };
+
+    const vk::DescriptorSetLayout set_layout = *desc_layout;
+    const vk::PipelineLayoutCreateInfo layout_info = {
+        .setLayoutCount = 1U,
+        .pSetLayouts = &set_layout,
+        .pushConstantRangeCount = 1,
+        .pPushConstantRanges = &push_constants,
+    };
+    pipeline_layout = instance.GetDevice().createPipelineLayoutUnique(layout_info);
+
+    const vk::ComputePipelineCreateInfo compute_pipeline_ci = {
+        .stage = shader_ci,
+        .layout = *pipeline_layout,
+    };
+    auto result =
+        instance.GetDevice().createComputePipelineUnique(/*pipeline_cache*/ {}, compute_pipeline_ci);
+    ASSERT_MSG(result.result == vk::Result::eSuccess, "Index converter pipeline creation failed!");
+    pipeline = std::move(result.value);
+
+    // Once pipeline is compiled, we don't need the shader module anymore
+    instance.GetDevice().destroyShaderModule(module);
+}
+
+IndexConverter::~IndexConverter() = default;
+
+u64 IndexConverter::EmitQuadListIndices(StreamBuffer& out_buffer, u32 num_vertices) {
+    const u32 num_quads = num_vertices / 4;
+    const u32 size = num_quads * 6 * sizeof(u16);
+
+    // Reserve the output region; the contents are produced by the dispatch.
+    const auto [data, offset, _] = out_buffer.Map(size, instance.StorageMinAlignment());
+    out_buffer.Commit(size);
+
+    // The dispatch cannot be recorded inside a render pass.
+    scheduler.EndRendering();
+    const auto cmdbuf = scheduler.CommandBuffer();
+    cmdbuf.bindPipeline(vk::PipelineBindPoint::eCompute, *pipeline);
+
+    const vk::DescriptorBufferInfo output_buffer_info = {
+        .buffer = out_buffer.Handle(),
+        .offset = offset,
+        .range = size,
+    };
+    const vk::WriteDescriptorSet set_write = {
+        .dstSet = VK_NULL_HANDLE,
+        .dstBinding = 0,
+        .dstArrayElement = 0,
+        .descriptorCount = 1,
+        .descriptorType = vk::DescriptorType::eStorageBuffer,
+        .pBufferInfo = &output_buffer_info,
+    };
+    cmdbuf.pushDescriptorSetKHR(vk::PipelineBindPoint::eCompute, *pipeline_layout, 0, set_write);
+
+    const IndexEmitParams params = {
+        .num_quads = num_quads,
+    };
+    cmdbuf.pushConstants(*pipeline_layout, vk::ShaderStageFlagBits::eCompute, 0u, sizeof(params),
+                         &params);
+    cmdbuf.dispatch((num_quads + 63) / 64, 1, 1);
+
+    // Make the generated indices visible to the index fetch of the draw.
+    const vk::BufferMemoryBarrier barrier = {
+        .srcAccessMask = vk::AccessFlagBits::eShaderWrite,
+        .dstAccessMask = vk::AccessFlagBits::eIndexRead,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .buffer = out_buffer.Handle(),
+        .offset = offset,
+        .size = size,
+    };
+    cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader,
+                           vk::PipelineStageFlagBits::eVertexInput, vk::DependencyFlagBits{}, {},
+                           barrier, {});
+    return offset;
+}
+
+} // namespace Vulkan
@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "common/types.h"
+#include "video_core/renderer_vulkan/vk_common.h"
+
+namespace Vulkan {
+
+class Instance;
+class Scheduler;
+class StreamBuffer;
+
+/// Generates host index buffers for guest topologies Vulkan cannot consume
+/// directly. The conversion runs as a compute dispatch writing into the
+/// caller's stream buffer, so large draws avoid a synchronous CPU emit pass.
+class IndexConverter {
+public:
+    explicit IndexConverter(const Instance& instance, Scheduler& scheduler);
+    ~IndexConverter();
+
+    /// Emits the 16-bit quad-list to triangle-list index pattern for
+    /// num_vertices vertices on the GPU, including the barrier that makes the
+    /// result visible to vertex input. Returns the byte offset of the indices
+    /// inside out_buffer.
+    u64 EmitQuadListIndices(StreamBuffer& out_buffer, u32 num_vertices);
+
+private:
+    const Instance& instance;
+    Scheduler& scheduler;
+    vk::UniquePipeline pipeline;
+    vk::UniquePipelineLayout pipeline_layout;
+    vk::UniqueDescriptorSetLayout desc_layout;
+};
+
+} // namespace Vulkan
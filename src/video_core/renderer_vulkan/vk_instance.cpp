@@ -1,6 +1,7 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <filesystem>
 #include <ranges>
 #include <span>
 #include <boost/container/static_vector.hpp>
@@ -8,6 +9,8 @@
 #include <fmt/ranges.h>
 
 #include "common/assert.h"
+#include "common/io_file.h"
+#include "common/path_util.h"
 #include "sdl_window.h"
 #include "video_core/renderer_vulkan/vk_instance.h"
 #include "video_core/renderer_vulkan/vk_platform.h"
@@ -18,13 +21,70 @@ namespace Vulkan {
 
 namespace {
 
-std::vector<std::string> GetSupportedExtensions(vk::PhysicalDevice physical) {
+std::filesystem::path DeviceProbeCachePath() {
+    const auto cache_dir = Common::FS::GetUserPath(Common::FS::PathType::ShaderDir) / "cache";
+    if (!std::filesystem::exists(cache_dir)) {
+        std::filesystem::create_directories(cache_dir);
+    }
+    return cache_dir / "device_probe.txt";
+}
+
+std::vector<std::string> LoadCachedExtensions(const std::filesystem::path& path,
+                                              const std::string& probe_key) {
+    if (!std::filesystem::exists(path)) {
+        return {};
+    }
+    const Common::FS::IOFile file{path, Common::FS::FileAccessMode::Read};
+    const std::string data = file.ReadString(file.GetSize());
+
+    std::vector<std::string> extensions;
+    size_t pos = 0;
+    while (pos < data.size()) {
+        size_t end = data.find('\n', pos);
+        if (end == std::string::npos) {
+            end = data.size();
+        }
+        extensions.emplace_back(data.substr(pos, end - pos));
+        pos = end + 1;
+    }
+    // The first line carries the probe key; anything else means the cache was
+    // written by a different device or driver and must be re-probed.
+    if (extensions.size() < 2 || extensions.front() != probe_key) {
+        return {};
+    }
+    extensions.erase(extensions.begin());
+    return extensions;
+}
+
+std::vector<std::string> GetSupportedExtensions(vk::PhysicalDevice physical,
+                                                const vk::PhysicalDeviceProperties& properties) {
+    // Enumerating device extensions is one of the slower boot-time probes on some
+    // drivers, so the result is cached on disk keyed by vendor, device and driver
+    // version. The properties query that validates the key already ran, which
+    // makes a warm-cache boot skip the enumeration entirely.
+    const auto cache_path = DeviceProbeCachePath();
+    const std::string probe_key = fmt::format("{:#x} {:#x} {:#x}", properties.vendorID,
+                                              properties.deviceID, properties.driverVersion);
+    if (auto cached = LoadCachedExtensions(cache_path, probe_key); !cached.empty()) {
+        LOG_INFO(Render_Vulkan, "Using cached device extension probe with {} extensions",
+                 cached.size());
+        return cached;
+    }
+
     const std::vector extensions = physical.enumerateDeviceExtensionProperties();
     std::vector<std::string> supported_extensions;
     supported_extensions.reserve(extensions.size());
     for (const auto& extension : extensions) {
         supported_extensions.emplace_back(extension.extensionName.data());
     }
+
+    std::string blob = probe_key + '\n';
+    for (const auto& extension : supported_extensions) {
+        blob += extension;
+        blob += '\n';
+    }
+    const Common::FS::IOFile file{cache_path, Common::FS::FileAccessMode::Write};
+    file.WriteString(blob);
     return supported_extensions;
 }
 
@@ -72,8 +132,8 @@ Instance::Instance(Frontend::WindowSDL& window, s32 physical_device_index,
         physical_device = physical_devices[physical_device_index];
     }
 
-    available_extensions = GetSupportedExtensions(physical_device);
     properties = physical_device.getProperties();
+    available_extensions = GetSupportedExtensions(physical_device, properties);
     CollectDeviceParameters();
     ASSERT_MSG(properties.apiVersion >= TargetVulkanApiVersion,
                "Vulkan {}.{} is required, but only {}.{} is supported by device!",
@@ -85,6 +145,9 @@ Instance::Instance(Frontend::WindowSDL& window, s32 physical_device_index,
 }
 
 Instance::~Instance() {
+    vmaDestroyPool(allocator, buffer_pool);
+    vmaDestroyPool(allocator, texture_pool);
+    vmaDestroyPool(allocator, attachment_pool);
     vmaDestroyAllocator(allocator);
 }
 
@@ -109,7 +172,8 @@ std::string Instance::GetDriverVersionName() {
 
 bool Instance::CreateDevice() {
     const vk::StructureChain feature_chain = physical_device.getFeatures2<
-        vk::PhysicalDeviceFeatures2, vk::PhysicalDevicePortabilitySubsetFeaturesKHR,
+        vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceVulkan12Features,
+        vk::PhysicalDevicePortabilitySubsetFeaturesKHR,
         vk::PhysicalDeviceExtendedDynamicStateFeaturesEXT,
         vk::PhysicalDeviceExtendedDynamicState2FeaturesEXT,
         vk::PhysicalDeviceExtendedDynamicState3FeaturesEXT,
@@ -118,19 +182,30 @@ bool Instance::CreateDevice() {
         vk::PhysicalDeviceFragmentShaderInterlockFeaturesEXT,
         vk::PhysicalDevicePipelineCreationCacheControlFeaturesEXT,
         vk::PhysicalDeviceColorWriteEnableFeaturesEXT,
-        vk::PhysicalDeviceFragmentShaderBarycentricFeaturesKHR>();
+        vk::PhysicalDeviceFragmentShaderBarycentricFeaturesKHR,
+        vk::PhysicalDeviceGraphicsPipelineLibraryFeaturesEXT>();
     const vk::StructureChain properties_chain =
         physical_device.getProperties2<vk::PhysicalDeviceProperties2,
                                        vk::PhysicalDevicePortabilitySubsetPropertiesKHR,
-                                       vk::PhysicalDeviceExternalMemoryHostPropertiesEXT>();
+                                       vk::PhysicalDeviceExternalMemoryHostPropertiesEXT,
+                                       vk::PhysicalDeviceDescriptorBufferPropertiesEXT>();
 
     features = feature_chain.get().features;
+    // The bindless texture path needs runtime descriptor arrays that stay
+    // partially bound and can be updated after the set was bound.
+    const auto& vk12_features = feature_chain.get<vk::PhysicalDeviceVulkan12Features>();
+    bindless_textures = vk12_features.runtimeDescriptorArray &&
+                        vk12_features.descriptorBindingPartiallyBound &&
+                        vk12_features.descriptorBindingSampledImageUpdateAfterBind &&
+                        vk12_features.descriptorBindingStorageImageUpdateAfterBind &&
+                        features.shaderSampledImageArrayDynamicIndexing &&
+                        features.shaderStorageImageArrayDynamicIndexing;
     if (available_extensions.empty()) {
         LOG_CRITICAL(Render_Vulkan, "No extensions supported by device.");
         return false;
     }
 
-    boost::container::static_vector<const char*, 13> enabled_extensions;
+    boost::container::static_vector<const char*, 20> enabled_extensions;
     const auto add_extension = [&](std::string_view extension) -> bool {
         const auto result =
             std::find_if(available_extensions.begin(), available_extensions.end(),
@@ -160,7 +235,20 @@ bool Instance::CreateDevice() {
     // The next two extensions are required to be available together in order to support write masks
     color_write_en = add_extension(VK_EXT_COLOR_WRITE_ENABLE_EXTENSION_NAME);
     color_write_en &= add_extension(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME);
+    // Pipeline libraries let blend-state permutations link against a cached
+    // shader half instead of recompiling the whole pipeline.
+    graphics_pipeline_library = add_extension(VK_KHR_PIPELINE_LIBRARY_EXTENSION_NAME);
+    graphics_pipeline_library &= add_extension(VK_EXT_GRAPHICS_PIPELINE_LIBRARY_EXTENSION_NAME);
+    graphics_pipeline_library &=
+        static_cast<bool>(feature_chain.get<vk::PhysicalDeviceGraphicsPipelineLibraryFeaturesEXT>()
+                              .graphicsPipelineLibrary);
     const auto calibrated_timestamps = add_extension(VK_EXT_CALIBRATED_TIMESTAMPS_EXTENSION_NAME);
+    memory_budget = add_extension(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    descriptor_buffer = add_extension(VK_EXT_DESCRIPTOR_BUFFER_EXTENSION_NAME);
+    if (descriptor_buffer) {
+        descriptor_buffer_props =
+            properties_chain.get<vk::PhysicalDeviceDescriptorBufferPropertiesEXT>();
+    }
 
     const auto family_properties = physical_device.getQueueFamilyProperties();
     if (family_properties.empty()) {
@@ -182,18 +270,39 @@ bool Instance::CreateDevice() {
         return false;
     }
 
+    // Prefer a DMA-only family for out-of-band uploads so texture streaming can
+    // overlap with rendering instead of competing for the graphics queue.
+    for (std::size_t i = 0; i < family_properties.size(); i++) {
+        const auto flags = family_properties[i].queueFlags;
+        if ((flags & vk::QueueFlagBits::eTransfer) && !(flags & vk::QueueFlagBits::eGraphics) &&
+            !(flags & vk::QueueFlagBits::eCompute)) {
+            transfer_queue_family_index = static_cast<u32>(i);
+            has_transfer_queue = true;
+            break;
+        }
+    }
+
     static constexpr std::array<f32, 1> queue_priorities = {1.0f};
 
-    const vk::DeviceQueueCreateInfo queue_info = {
-        .queueFamilyIndex = queue_family_index,
-        .queueCount = static_cast<u32>(queue_priorities.size()),
-        .pQueuePriorities = queue_priorities.data(),
+    boost::container::static_vector<vk::DeviceQueueCreateInfo, 2> queue_infos = {
+        vk::DeviceQueueCreateInfo{
+            .queueFamilyIndex = queue_family_index,
+            .queueCount = static_cast<u32>(queue_priorities.size()),
+            .pQueuePriorities = queue_priorities.data(),
+        },
     };
+    if (has_transfer_queue) {
+        queue_infos.push_back(vk::DeviceQueueCreateInfo{
+            .queueFamilyIndex = transfer_queue_family_index,
+            .queueCount = static_cast<u32>(queue_priorities.size()),
+            .pQueuePriorities = queue_priorities.data(),
+        });
+    }
 
     vk::StructureChain device_chain = {
         vk::DeviceCreateInfo{
-            .queueCreateInfoCount = 1u,
-            .pQueueCreateInfos = &queue_info,
+            .queueCreateInfoCount = static_cast<u32>(queue_infos.size()),
+            .pQueueCreateInfos = queue_infos.data(),
             .enabledExtensionCount = static_cast<u32>(enabled_extensions.size()),
             .ppEnabledExtensionNames = enabled_extensions.data(),
         },
@@ -245,12 +354,34 @@ bool Instance::CreateDevice() {
             .workgroupMemoryExplicitLayoutScalarBlockLayout = true,
             .workgroupMemoryExplicitLayout8BitAccess = true,
             .workgroupMemoryExplicitLayout16BitAccess = true,
+        },
+        vk::PhysicalDeviceDescriptorBufferFeaturesEXT{
+            .descriptorBuffer = true,
+        },
+        vk::PhysicalDeviceGraphicsPipelineLibraryFeaturesEXT{
+            .graphicsPipelineLibrary = true,
         }};
 
+    if (bindless_textures) {
+        auto& features2 = device_chain.get<vk::PhysicalDeviceFeatures2>().features;
+        features2.shaderSampledImageArrayDynamicIndexing = true;
+        features2.shaderStorageImageArrayDynamicIndexing = true;
+        auto& vk12 = device_chain.get<vk::PhysicalDeviceVulkan12Features>();
+        vk12.descriptorBindingSampledImageUpdateAfterBind = true;
+        vk12.descriptorBindingStorageImageUpdateAfterBind = true;
+        vk12.descriptorBindingPartiallyBound = true;
+        vk12.runtimeDescriptorArray = true;
+    }
     if (!color_write_en) {
         device_chain.unlink<vk::PhysicalDeviceColorWriteEnableFeaturesEXT>();
         device_chain.unlink<vk::PhysicalDeviceExtendedDynamicState3FeaturesEXT>();
     }
+    if (!descriptor_buffer) {
+        device_chain.unlink<vk::PhysicalDeviceDescriptorBufferFeaturesEXT>();
+    }
+    if (!graphics_pipeline_library) {
+        device_chain.unlink<vk::PhysicalDeviceGraphicsPipelineLibraryFeaturesEXT>();
+    }
 
     try {
         device = physical_device.createDeviceUnique(device_chain.get());
@@ -263,6 +394,9 @@ bool Instance::CreateDevice() {
 
     graphics_queue = device->getQueue(queue_family_index, 0);
     present_queue = device->getQueue(queue_family_index, 0);
+    if (has_transfer_queue) {
+        transfer_queue = device->getQueue(transfer_queue_family_index, 0);
+    }
 
     if (calibrated_timestamps) {
         const auto& time_domains = physical_device.getCalibrateableTimeDomainsEXT();
@@ -296,6 +430,8 @@ void Instance::CreateAllocator() {
     };
 
     const VmaAllocatorCreateInfo allocator_info = {
+        .flags = memory_budget ? VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT
+                               : VmaAllocatorCreateFlags{},
         .physicalDevice = physical_device,
         .device = *device,
         .pVulkanFunctions = &functions,
@@ -308,6 +444,93 @@ void Instance::CreateAllocator() {
         UNREACHABLE_MSG("Failed to initialize VMA with error {}",
                         vk::to_string(vk::Result{result}));
     }
+
+    CreateMemoryPools();
+}
+
+void Instance::CreateMemoryPools() {
+    // Keep the long-lived resource classes in dedicated pools so render targets,
+    // sampled textures and cached buffers each suballocate from their own slabs.
+    // Attachments have very different lifetimes and sizes than streamed textures;
+    // mixing them in the shared pools fragments the slabs and forces extra
+    // vkAllocateMemory calls once holes no longer fit.
+    const VmaAllocationCreateInfo alloc_ci = {
+        .usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
+    };
+    const auto create_pool = [&](u32 memory_type_index) -> VmaPool {
+        const VmaPoolCreateInfo pool_ci = {
+            .memoryTypeIndex = memory_type_index,
+        };
+        VmaPool pool{};
+        if (vmaCreatePool(allocator, &pool_ci, &pool) != VK_SUCCESS) {
+            // Resources fall back to the shared pools; only batching is lost.
+            return VmaPool{};
+        }
+        return pool;
+    };
+
+    // Representative create infos pick the memory type each pool serves. If a
+    // resource later reports incompatible requirements its allocation retries
+    // against the shared pools, so an unusual driver layout only loses batching.
+    const VkImageCreateInfo attachment_ci = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .imageType = VK_IMAGE_TYPE_2D,
+        .format = VK_FORMAT_R8G8B8A8_UNORM,
+        .extent = {1920, 1080, 1},
+        .mipLevels = 1,
+        .arrayLayers = 1,
+        .samples = VK_SAMPLE_COUNT_1_BIT,
+        .usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT |
+                 VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+    };
+    u32 type_index{};
+    if (vmaFindMemoryTypeIndexForImageInfo(allocator, &attachment_ci, &alloc_ci, &type_index) ==
+        VK_SUCCESS) {
+        attachment_pool = create_pool(type_index);
+    }
+
+    const VkImageCreateInfo texture_ci = {
+        .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        .imageType = VK_IMAGE_TYPE_2D,
+        .format = VK_FORMAT_R8G8B8A8_UNORM,
+        .extent = {256, 256, 1},
+        .mipLevels = 1,
+        .arrayLayers = 1,
+        .samples = VK_SAMPLE_COUNT_1_BIT,
+        .usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT,
+    };
+    if (vmaFindMemoryTypeIndexForImageInfo(allocator, &texture_ci, &alloc_ci, &type_index) ==
+        VK_SUCCESS) {
+        texture_pool = create_pool(type_index);
+    }
+
+    const VkBufferCreateInfo buffer_ci = {
+        .sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        .size = 1_MB,
+        .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                 VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+    };
+    if (vmaFindMemoryTypeIndexForBufferInfo(allocator, &buffer_ci, &alloc_ci, &type_index) ==
+        VK_SUCCESS) {
+        buffer_pool = create_pool(type_index);
+    }
+}
+
+std::pair<u64, u64> Instance::GetMemoryBudget() const {
+    // VMA feeds from VK_EXT_memory_budget when available and falls back to its own
+    // accounting against the heap sizes otherwise.
+    std::array<VmaBudget, VK_MAX_MEMORY_HEAPS> budgets{};
+    vmaGetHeapBudgets(allocator, budgets.data());
+    const vk::PhysicalDeviceMemoryProperties props = physical_device.getMemoryProperties();
+    u64 budget{};
+    u64 usage{};
+    for (u32 heap = 0; heap < props.memoryHeapCount; ++heap) {
+        if (props.memoryHeaps[heap].flags & vk::MemoryHeapFlagBits::eDeviceLocal) {
+            budget += budgets[heap].budget;
+            usage += budgets[heap].usage;
+        }
+    }
+    return {budget, usage};
 }
 
 void Instance::CollectDeviceParameters() {
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <span>
+#include <utility>
 
 #include "video_core/renderer_vulkan/vk_platform.h"
 
@@ -15,6 +16,7 @@ class WindowSDL;
 }
 
 VK_DEFINE_HANDLE(VmaAllocator)
+VK_DEFINE_HANDLE(VmaPool)
 
 namespace Vulkan {
 
@@ -48,6 +50,24 @@ public:
         return allocator;
     }
 
+    /// Returns the dedicated memory pool for render and depth targets, or null
+    /// to fall back to the shared VMA pools.
+    VmaPool GetAttachmentMemoryPool() const {
+        return attachment_pool;
+    }
+
+    /// Returns the dedicated memory pool for sampled textures, or null to fall
+    /// back to the shared VMA pools.
+    VmaPool GetTextureMemoryPool() const {
+        return texture_pool;
+    }
+
+    /// Returns the dedicated memory pool for cached device-local buffers, or
+    /// null to fall back to the shared VMA pools.
+    VmaPool GetBufferMemoryPool() const {
+        return buffer_pool;
+    }
+
     /// Returns a list of the available physical devices
     std::span<const vk::PhysicalDevice> GetPhysicalDevices() const {
         return physical_devices;
@@ -70,6 +90,19 @@ public:
         return present_queue;
     }
 
+    /// Returns true when the device exposes a DMA-only queue family.
+    bool HasTransferQueue() const {
+        return has_transfer_queue;
+    }
+
+    u32 GetTransferQueueFamilyIndex() const {
+        return transfer_queue_family_index;
+    }
+
+    vk::Queue GetTransferQueue() const {
+        return transfer_queue;
+    }
+
     TracyVkCtx GetProfilerContext() const {
         return profiler_context;
     }
@@ -114,11 +147,40 @@ public:
         return external_memory_host;
     }
 
+    /// Returns true when VK_EXT_memory_budget is supported
+    bool IsMemoryBudgetSupported() const {
+        return memory_budget;
+    }
+
+    /// Returns the budget and current usage of device-local memory in bytes.
+    std::pair<u64, u64> GetMemoryBudget() const;
+
     /// Returns true when VK_EXT_color_write_enable is supported
     bool IsColorWriteEnableSupported() const {
         return color_write_en;
     }
 
+    /// Returns true when VK_EXT_descriptor_buffer is supported by the device
+    bool IsDescriptorBufferSupported() const {
+        return descriptor_buffer;
+    }
+
+    /// Returns true when the descriptor-indexing features needed for the
+    /// bindless texture path are supported by the device
+    bool IsBindlessTexturesSupported() const {
+        return bindless_textures;
+    }
+
+    /// Returns true when VK_EXT_graphics_pipeline_library is supported
+    bool IsGraphicsPipelineLibrarySupported() const {
+        return graphics_pipeline_library;
+    }
+
+    /// Returns the descriptor layout and alignment properties of the descriptor buffer extension
+    const vk::PhysicalDeviceDescriptorBufferPropertiesEXT& GetDescriptorBufferProperties() const {
+        return descriptor_buffer_props;
+    }
+
     /// Returns the vendor ID of the physical device
     u32 GetVendorID() const {
         return properties.vendorID;
@@ -201,6 +263,9 @@ private:
     /// Creates the VMA allocator handle
     void CreateAllocator();
 
+    /// Creates the dedicated memory pools for each resource class
+    void CreateMemoryPools();
+
     /// Collects telemetry information from the device.
     void CollectDeviceParameters();
     void CollectToolingInfo();
@@ -216,12 +281,18 @@ private:
     vk::UniqueDebugUtilsMessengerEXT debug_callback{};
     std::string vendor_name;
     VmaAllocator allocator{};
+    VmaPool attachment_pool{};
+    VmaPool texture_pool{};
+    VmaPool buffer_pool{};
     vk::Queue present_queue;
     vk::Queue graphics_queue;
+    vk::Queue transfer_queue;
     std::vector<vk::PhysicalDevice> physical_devices;
     std::vector<std::string> available_extensions;
     TracyVkCtx profiler_context{};
     u32 queue_family_index{0};
+    u32 transfer_queue_family_index{0};
+    bool has_transfer_queue{false};
     bool image_view_reinterpretation{true};
     bool timeline_semaphores{};
     bool custom_border_color{};
@@ -232,6 +303,11 @@ private:
     bool shader_stencil_export{};
     bool external_memory_host{};
     bool color_write_en{};
+    bool descriptor_buffer{};
+    bool memory_budget{};
+    bool graphics_pipeline_library{};
+    bool bindless_textures{};
+    vk::PhysicalDeviceDescriptorBufferPropertiesEXT descriptor_buffer_props{};
     u64 min_imported_host_pointer_alignment{};
     bool tooling_info{};
     bool debug_utils_supported{};
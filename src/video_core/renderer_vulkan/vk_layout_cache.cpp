@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <xxhash.h>
+#include "shader_recompiler/runtime_info.h"
+#include "video_core/renderer_vulkan/vk_instance.h"
+#include "video_core/renderer_vulkan/vk_layout_cache.h"
+
+namespace Vulkan {
+
+LayoutCache::LayoutCache(const Instance& instance_) : instance{instance_} {}
+
+LayoutCache::~LayoutCache() = default;
+
+LayoutCache::Layouts LayoutCache::Get(std::span<const vk::DescriptorSetLayoutBinding> bindings,
+                                      vk::DescriptorSetLayout bindless_layout,
+                                      vk::ShaderStageFlags bindless_stages) {
+    // No binding uses immutable samplers so the pointer member is always null and
+    // hashing the raw structs is well defined. The bindless layout is itself
+    // hash-consed by the texture cache so its handle value identifies it.
+    const u64 seed = reinterpret_cast<u64>(static_cast<VkDescriptorSetLayout>(bindless_layout)) ^
+                     static_cast<u64>(static_cast<VkShaderStageFlags>(bindless_stages));
+    const size_t hash = XXH3_64bits_withSeed(bindings.data(), bindings.size_bytes(), seed);
+    std::scoped_lock lock{mutex};
+    const auto [it, is_new] = entries.try_emplace(hash);
+    if (is_new) {
+        auto& entry = it.value();
+        const vk::DescriptorSetLayoutCreateInfo desc_layout_ci = {
+            .flags = vk::DescriptorSetLayoutCreateFlagBits::ePushDescriptorKHR,
+            .bindingCount = static_cast<u32>(bindings.size()),
+            .pBindings = bindings.data(),
+        };
+        entry.desc_layout = instance.GetDevice().createDescriptorSetLayoutUnique(desc_layout_ci);
+        const std::array set_layouts = {*entry.desc_layout, bindless_layout};
+        const vk::PushConstantRange push_range = {
+            .stageFlags = bindless_stages,
+            .offset = 0,
+            .size = Shader::BindlessPushSize,
+        };
+        const vk::PipelineLayoutCreateInfo layout_info = {
+            .setLayoutCount = bindless_layout ? 2U : 1U,
+            .pSetLayouts = set_layouts.data(),
+            .pushConstantRangeCount = bindless_layout ? 1U : 0U,
+            .pPushConstantRanges = bindless_layout ? &push_range : nullptr,
+        };
+        entry.pipeline_layout = instance.GetDevice().createPipelineLayoutUnique(layout_info);
+    }
+    const auto& entry = it->second;
+    return {*entry.desc_layout, *entry.pipeline_layout};
+}
+
+} // namespace Vulkan
@@ -0,0 +1,51 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <mutex>
+#include <span>
+#include <tsl/robin_map.h>
+
+#include "common/types.h"
+#include "video_core/renderer_vulkan/vk_common.h"
+
+namespace Vulkan {
+
+class Instance;
+
+/// Hash-conses descriptor set layouts and the pipeline layouts built from them,
+/// keyed by the binding vector. Pipelines with identical resource interfaces
+/// (a common case as many shaders share the same buffer/image mix) then receive
+/// the same handles instead of each creating their own, which also makes the
+/// layouts comparable by handle for descriptor set reuse.
+class LayoutCache {
+public:
+    struct Layouts {
+        vk::DescriptorSetLayout desc_layout;
+        vk::PipelineLayout pipeline_layout;
+    };
+
+    explicit LayoutCache(const Instance& instance);
+    ~LayoutCache();
+
+    /// Returns the layouts for the given binding vector, creating them on first use.
+    /// The returned handles are owned by the cache and stay valid for its lifetime.
+    /// When a bindless set layout is provided it is appended as set 1 and a push
+    /// constant range for the bindless index table is added for the given stages.
+    Layouts Get(std::span<const vk::DescriptorSetLayoutBinding> bindings,
+                vk::DescriptorSetLayout bindless_layout = {},
+                vk::ShaderStageFlags bindless_stages = {});
+
+private:
+    struct Entry {
+        vk::UniqueDescriptorSetLayout desc_layout;
+        vk::UniquePipelineLayout pipeline_layout;
+    };
+
+    const Instance& instance;
+    tsl::robin_map<size_t, Entry> entries;
+    std::mutex mutex;
+};
+
+} // namespace Vulkan
@@ -1,16 +1,17 @@
 // SPDX-FileCopyrightText: Copyright 2020 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
 #include <limits>
 #include <mutex>
+#include <boost/container/static_vector.hpp>
 #include "common/assert.h"
+#include "common/thread.h"
 #include "video_core/renderer_vulkan/vk_instance.h"
 #include "video_core/renderer_vulkan/vk_master_semaphore.h"
 
 namespace Vulkan {
 
-constexpr u64 WAIT_TIMEOUT = std::numeric_limits<u64>::max();
-
 MasterSemaphore::MasterSemaphore(const Instance& instance_) : instance{instance_} {
     const vk::StructureChain semaphore_chain = {
         vk::SemaphoreCreateInfo{},
@@ -20,10 +21,88 @@ MasterSemaphore::MasterSemaphore(const Instance& instance_) : instance{instance_
         },
     };
     semaphore = instance.GetDevice().createSemaphoreUnique(semaphore_chain.get());
+    doorbell = instance.GetDevice().createSemaphoreUnique(semaphore_chain.get());
+    wait_thread = std::jthread([this](std::stop_token stoken) { WaitThread(stoken); });
 }
 
 MasterSemaphore::~MasterSemaphore() = default;
 
+void MasterSemaphore::RegisterEopSignal(u64 tick, std::function<void()>&& callback) {
+    if (IsFree(tick)) {
+        callback();
+        return;
+    }
+    {
+        std::scoped_lock lk{wait_mutex};
+        eop_callbacks.emplace(tick, std::move(callback));
+        RingDoorbell();
+    }
+    wait_cv.notify_one();
+}
+
+void MasterSemaphore::RingDoorbell() {
+    // Host-signals the auxiliary timeline so a waiter thread parked inside
+    // vkWaitSemaphores re-evaluates its earliest tick. Signal values must be
+    // monotonic, so callers hold wait_mutex to serialize rings.
+    const u64 value = doorbell_tick.fetch_add(1, std::memory_order_relaxed) + 1;
+    instance.GetDevice().signalSemaphore({
+        .semaphore = doorbell.get(),
+        .value = value,
+    });
+}
+
+void MasterSemaphore::WaitThread(std::stop_token stoken) {
+    Common::SetCurrentThreadName("shadPS4:GpuTimeline");
+
+    std::unique_lock lock{wait_mutex};
+    while (!stoken.stop_requested()) {
+        if (!wait_cv.wait(lock, stoken,
+                          [this] { return !eop_callbacks.empty() || !wait_ticks.empty(); })) {
+            break;
+        }
+        // Ticks are monotonic, so waiting for the earliest requirement covers
+        // every entry that becomes signalable in the meantime.
+        u64 tick = std::numeric_limits<u64>::max();
+        if (!eop_callbacks.empty()) {
+            tick = eop_callbacks.begin()->first;
+        }
+        if (!wait_ticks.empty()) {
+            tick = std::min(tick, *wait_ticks.begin());
+        }
+        // The doorbell baseline is latched under the lock, so a registration
+        // slipping in after the earliest tick was computed is guaranteed to
+        // wake the device wait below and have it re-evaluated.
+        const u64 doorbell_base = doorbell_tick.load(std::memory_order_relaxed);
+        lock.unlock();
+
+        const std::array wait_semaphores{semaphore.get(), doorbell.get()};
+        const std::array wait_values{tick, doorbell_base + 1};
+        const vk::SemaphoreWaitInfo wait_info = {
+            .flags = vk::SemaphoreWaitFlagBits::eAny,
+            .semaphoreCount = static_cast<u32>(wait_semaphores.size()),
+            .pSemaphores = wait_semaphores.data(),
+            .pValues = wait_values.data(),
+        };
+        // Bounded waits so shutdown is never stuck on a tick that will not signal.
+        while (!stoken.stop_requested() &&
+               instance.GetDevice().waitSemaphores(&wait_info, 100'000'000) ==
+                   vk::Result::eTimeout) {
+        }
+        Refresh();
+        lock.lock();
+        // One broadcast releases every waiter whose tick is now known reached.
+        free_cv.notify_all();
+        while (!eop_callbacks.empty() && eop_callbacks.begin()->first <= KnownGpuTick()) {
+            auto callback = std::move(eop_callbacks.begin()->second);
+            eop_callbacks.erase(eop_callbacks.begin());
+            lock.unlock();
+            callback();
+            lock.lock();
+        }
+    }
+    free_cv.notify_all();
+}
+
 void MasterSemaphore::Refresh() {
     u64 this_tick{};
     u64 counter{};
@@ -48,34 +127,42 @@ void MasterSemaphore::Wait(u64 tick) {
         return;
     }
 
-    // If none of the above is hit, fallback to a regular wait
-    const vk::SemaphoreWaitInfo wait_info = {
-        .semaphoreCount = 1,
-        .pSemaphores = &semaphore.get(),
-        .pValues = &tick,
-    };
-
-    while (instance.GetDevice().waitSemaphores(&wait_info, WAIT_TIMEOUT) != vk::Result::eSuccess) {
-    }
-    Refresh();
+    // Hand the device wait to the waiter thread and sleep on its broadcast;
+    // concurrent waiters then share one vkWaitSemaphores call instead of each
+    // entering the driver separately.
+    std::unique_lock lock{wait_mutex};
+    const auto it = wait_ticks.insert(tick);
+    RingDoorbell();
+    wait_cv.notify_one();
+    free_cv.wait(lock, [this, tick] { return IsFree(tick); });
+    wait_ticks.erase(it);
 }
 
 void MasterSemaphore::SubmitWork(vk::CommandBuffer cmdbuf, vk::Semaphore wait, vk::Semaphore signal,
-                                 u64 signal_value) {
+                                 u64 signal_value, vk::Semaphore timeline_wait,
+                                 u64 timeline_wait_value) {
     cmdbuf.end();
 
     const u32 num_signal_semaphores = signal ? 2U : 1U;
     const std::array signal_values{signal_value, u64(0)};
     const std::array signal_semaphores{Handle(), signal};
 
-    const u32 num_wait_semaphores = wait ? 2U : 1U;
-    const std::array wait_values{signal_value - 1, u64(1)};
-    const std::array wait_semaphores{Handle(), wait};
-
-    static constexpr std::array<vk::PipelineStageFlags, 2> wait_stage_masks = {
+    boost::container::static_vector<u64, 3> wait_values{signal_value - 1};
+    boost::container::static_vector<vk::Semaphore, 3> wait_semaphores{Handle()};
+    boost::container::static_vector<vk::PipelineStageFlags, 3> wait_stage_masks{
         vk::PipelineStageFlagBits::eAllCommands,
-        vk::PipelineStageFlagBits::eColorAttachmentOutput,
     };
+    if (wait) {
+        wait_values.push_back(u64(1));
+        wait_semaphores.push_back(wait);
+        wait_stage_masks.push_back(vk::PipelineStageFlagBits::eColorAttachmentOutput);
+    }
+    if (timeline_wait) {
+        wait_values.push_back(timeline_wait_value);
+        wait_semaphores.push_back(timeline_wait);
+        wait_stage_masks.push_back(vk::PipelineStageFlagBits::eAllCommands);
+    }
+    const u32 num_wait_semaphores = static_cast<u32>(wait_semaphores.size());
 
     const vk::TimelineSemaphoreSubmitInfo timeline_si = {
         .waitSemaphoreValueCount = num_wait_semaphores,
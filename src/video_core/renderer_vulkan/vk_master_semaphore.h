@@ -5,6 +5,10 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
 #include <thread>
 #include <queue>
 #include "common/types.h"
@@ -43,18 +47,37 @@ public:
     /// Refresh the known GPU tick
     void Refresh();
 
-    /// Waits for a tick to be hit on the GPU
+    /// Registers a callback invoked as soon as the GPU timeline reaches the tick.
+    /// Used for end-of-pipe label write-back without draining the queue.
+    void RegisterEopSignal(u64 tick, std::function<void()>&& callback);
+
+    /// Waits for a tick to be hit on the GPU. The device wait is delegated to
+    /// the waiter thread so concurrent waiters share one vkWaitSemaphores call
+    /// and are all released by a single broadcast.
     void Wait(u64 tick);
 
-    /// Submits the provided command buffer for execution
+    /// Submits the provided command buffer for execution. An additional timeline
+    /// wait can be attached, e.g. to order against out-of-band transfer work.
     void SubmitWork(vk::CommandBuffer cmdbuf, vk::Semaphore wait, vk::Semaphore signal,
-                    u64 signal_value);
+                    u64 signal_value, vk::Semaphore timeline_wait = nullptr,
+                    u64 timeline_wait_value = 0);
 
 protected:
+    void WaitThread(std::stop_token stoken);
+    void RingDoorbell();
+
     const Instance& instance;
     vk::UniqueSemaphore semaphore;    ///< Timeline semaphore.
+    vk::UniqueSemaphore doorbell;     ///< Host-signaled timeline that wakes the waiter thread.
     std::atomic<u64> gpu_tick{0};     ///< Current known GPU tick.
     std::atomic<u64> current_tick{1}; ///< Current logical tick.
+    std::atomic<u64> doorbell_tick{0};
+    std::mutex wait_mutex;
+    std::condition_variable_any wait_cv;
+    std::condition_variable free_cv;
+    std::multiset<u64> wait_ticks;
+    std::multimap<u64, std::function<void()>> eop_callbacks;
+    std::jthread wait_thread;
 };
 
 } // namespace Vulkan
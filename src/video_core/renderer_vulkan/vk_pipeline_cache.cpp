@@ -1,9 +1,25 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <latch>
+#include <boost/container/small_vector.hpp>
+#include <xxhash.h>
+#include <zlib-ng.h>
+
+#include "common/alignment.h"
 #include "common/config.h"
 #include "common/io_file.h"
 #include "common/path_util.h"
+#include "common/polyfill_thread.h"
+#include "common/profiler.h"
+#include "common/singleton.h"
+#include "common/thread.h"
+#include "common/thread_pool.h"
+#include "core/file_format/psf.h"
 #include "shader_recompiler/backend/spirv/emit_spirv.h"
 #include "shader_recompiler/exception.h"
 #include "shader_recompiler/recompiler.h"
@@ -13,6 +29,7 @@
 #include "video_core/renderer_vulkan/vk_pipeline_cache.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_shader_util.h"
+#include "video_core/texture_cache/texture_cache.h"
 
 extern std::unique_ptr<Vulkan::RendererVulkan> renderer;
 
@@ -101,40 +118,200 @@ Shader::Info MakeShaderInfo(Shader::Stage stage, std::span<const u32, 16> user_d
     return info;
 }
 
+namespace {
+
+constexpr u32 ManifestVersion = 3;
+constexpr u32 ManifestIndexCapacity = 1 << 16;
+
+// Layout tag stored in the index header; bumping the version or changing any
+// serialized struct invalidates the index (and with it every record) at once.
+constexpr u32 ManifestLayoutTag() {
+    return ManifestVersion ^ static_cast<u32>(sizeof(GraphicsPipelineKey) << 4) ^
+           static_cast<u32>(sizeof(AmdGpu::Liverpool::Regs) << 12);
+}
+
+template <typename T>
+void AppendObject(std::vector<u8>& buffer, const T& object) {
+    const auto* bytes = reinterpret_cast<const u8*>(&object);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T>
+bool ConsumeObject(std::span<const u8>& buffer, T* object) {
+    if (buffer.size() < sizeof(T)) {
+        return false;
+    }
+    std::memcpy(object, buffer.data(), sizeof(T));
+    buffer = buffer.subspan(sizeof(T));
+    return true;
+}
+
+} // Anonymous namespace
+
 PipelineCache::PipelineCache(const Instance& instance_, Scheduler& scheduler_,
-                             AmdGpu::Liverpool* liverpool_)
-    : instance{instance_}, scheduler{scheduler_}, liverpool{liverpool_}, inst_pool{8192},
-      block_pool{512} {
-    pipeline_cache = instance.GetDevice().createPipelineCacheUnique({});
+                             AmdGpu::Liverpool* liverpool_,
+                             VideoCore::TextureCache& texture_cache_)
+    : instance{instance_}, scheduler{scheduler_}, liverpool{liverpool_},
+      texture_cache{texture_cache_}, layout_cache{instance_} {
+    LoadPipelineCache();
     profile = Shader::Profile{
         .supported_spirv = 0x00010600U,
         .support_explicit_workgroup_layout = true,
     };
+    LoadManifest();
+    PrecompileManifest();
+    if (Config::asyncShaderCompilation()) {
+        async_thread = std::jthread{[this](std::stop_token token) { AsyncCompileLoop(token); }};
+    }
+    if (Config::dumpShaders()) {
+        dump_thread = std::jthread{[this](std::stop_token token) { DumpWriterLoop(token); }};
+    }
+}
+
+PipelineCache::~PipelineCache() {
+    SavePipelineCache();
 }
 
 const GraphicsPipeline* PipelineCache::GetGraphicsPipeline() {
     RefreshGraphicsKey();
+    std::scoped_lock lk{pipeline_mutex};
     const auto [it, is_new] = graphics_pipelines.try_emplace(graphics_key);
     if (is_new) {
-        it.value() = CreateGraphicsPipeline();
+        RecordManifestEntry(false);
+        if (async_thread.joinable()) {
+            // Hand compilation to the worker and skip the draw until the pipeline is published.
+            EnqueueAsyncJob(false);
+            return nullptr;
+        }
+        it.value() = CreateGraphicsPipeline(liverpool->regs, graphics_key);
     }
     const GraphicsPipeline* pipeline = it->second.get();
     return pipeline;
 }
 
 const ComputePipeline* PipelineCache::GetComputePipeline() {
-    const auto& cs_pgm = liverpool->regs.cs_program;
-    ASSERT(cs_pgm.Address() != nullptr);
-    const auto* bininfo = Liverpool::GetBinaryInfo(cs_pgm);
-    compute_key = bininfo->shader_hash;
+    RefreshComputeKey();
+    std::scoped_lock lk{pipeline_mutex};
     const auto [it, is_new] = compute_pipelines.try_emplace(compute_key);
     if (is_new) {
-        it.value() = CreateComputePipeline();
+        RecordManifestEntry(true);
+        if (async_thread.joinable()) {
+            EnqueueAsyncJob(true);
+            return nullptr;
+        }
+        it.value() = CreateComputePipeline(liverpool->regs, compute_key);
     }
     const ComputePipeline* pipeline = it->second.get();
     return pipeline;
 }
 
+void PipelineCache::EnqueueAsyncJob(bool is_compute) {
+    AsyncJob job{
+        .regs = std::make_unique<AmdGpu::Liverpool::Regs>(liverpool->regs),
+        .graphics_key = graphics_key,
+        .compute_key = compute_key,
+        .is_compute = is_compute,
+    };
+    std::scoped_lock lk{queue_mutex};
+    job_queue.push_back(std::move(job));
+    queue_cv.notify_one();
+}
+
+void PipelineCache::RecordManifestEntry(bool is_compute) {
+    // Called with pipeline_mutex held, right after a previously unseen key was inserted.
+    // The register snapshot alone is not replayable as the program pointers reference
+    // guest memory, so the GCN byte code of each active stage is captured alongside it.
+    if (!manifest_index.IsOpen()) {
+        return;
+    }
+    const u64 key_hash = is_compute
+                             ? XXH3_64bits_withSeed(&compute_key, sizeof(compute_key), 1)
+                             : XXH3_64bits_withSeed(&graphics_key, sizeof(graphics_key), 0);
+    u64 offset{};
+    u32 length{};
+    if (manifest_index.Lookup(key_hash, &offset, &length)) {
+        // Already on disk, possibly written by another instance sharing the cache.
+        return;
+    }
+
+    std::vector<u8> record;
+    record.reserve(sizeof(AmdGpu::Liverpool::Regs) + 4096);
+    AppendObject(record, u8(is_compute ? 1 : 0));
+    AppendObject(record, graphics_key);
+    AppendObject(record, compute_key);
+    AppendObject(record, liverpool->regs);
+    const auto append_code = [&record](std::span<const u32> code) {
+        AppendObject(record, static_cast<u32>(code.size()));
+        const auto* bytes = reinterpret_cast<const u8*>(code.data());
+        record.insert(record.end(), bytes, bytes + code.size_bytes());
+    };
+    for (u32 i = 0; i < MaxShaderStages; i++) {
+        if (is_compute) {
+            append_code(i == 0 ? liverpool->regs.cs_program.Code() : std::span<const u32>{});
+        } else {
+            append_code(graphics_key.stage_hashes[i] ? liverpool->regs.ProgramForStage(i)->Code()
+                                                     : std::span<const u32>{});
+        }
+    }
+
+    // A single append-mode write lands the record contiguously even when other
+    // processes append to the same data file; our own record starts at the
+    // resulting position minus its size. The file is closed (and thus flushed)
+    // before the index publishes the record to concurrent readers.
+    u64 record_offset{};
+    {
+        const IOFile file{manifest_data_file, FileAccessMode::Append};
+        if (!file.IsOpen() || file.WriteSpan<u8>(record) != record.size()) {
+            LOG_WARNING(Render_Vulkan, "Failed to append pipeline manifest record");
+            return;
+        }
+        record_offset = static_cast<u64>(file.Tell()) - record.size();
+    }
+    manifest_index.Insert(key_hash, record_offset, static_cast<u32>(record.size()));
+}
+
+void PipelineCache::AsyncCompileLoop(std::stop_token stop_token) {
+    Common::SetCurrentThreadName("shadPS4:ShaderCompiler");
+    while (!stop_token.stop_requested()) {
+        AsyncJob job;
+        {
+            std::unique_lock lk{queue_mutex};
+            Common::CondvarWait(queue_cv, lk, stop_token, [this] { return !job_queue.empty(); });
+            if (stop_token.stop_requested()) {
+                break;
+            }
+            job = std::move(job_queue.front());
+            job_queue.pop_front();
+        }
+        if (job.is_compute) {
+            auto pipeline = CreateComputePipeline(*job.regs, job.compute_key);
+            std::scoped_lock lk{pipeline_mutex};
+            compute_pipelines[job.compute_key] = std::move(pipeline);
+        } else {
+            auto pipeline = CreateGraphicsPipeline(*job.regs, job.graphics_key);
+            std::scoped_lock lk{pipeline_mutex};
+            graphics_pipelines[job.graphics_key] = std::move(pipeline);
+        }
+    }
+}
+
+void PipelineCache::RefreshComputeKey() {
+    const auto& cs_pgm = liverpool->regs.cs_program;
+    ASSERT(cs_pgm.Address() != nullptr);
+    [[maybe_unused]] const auto* bininfo = Liverpool::GetBinaryInfo(cs_pgm);
+    const auto code = cs_pgm.Code();
+    // The dispatch state below feeds the translated program, so shaders sharing
+    // byte code but dispatched with a different layout must not alias.
+    compute_key = ComputePipelineKey{
+        .code_hash = XXH3_64bits(code.data(), code.size_bytes()),
+        .num_thread_x = cs_pgm.num_thread_x.full,
+        .num_thread_y = cs_pgm.num_thread_y.full,
+        .num_thread_z = cs_pgm.num_thread_z.full,
+        .num_user_regs = static_cast<u32>(cs_pgm.settings.num_user_regs.Value()),
+        .shared_mem_size = cs_pgm.SharedMemSize(),
+    };
+}
+
 void PipelineCache::RefreshGraphicsKey() {
     auto& regs = liverpool->regs;
     auto& key = graphics_key;
@@ -206,13 +383,21 @@ void PipelineCache::RefreshGraphicsKey() {
             key.stage_hashes[i] = 0;
             continue;
         }
-        const auto* bininfo = Liverpool::GetBinaryInfo(*pgm);
-        key.stage_hashes[i] = bininfo->shader_hash;
+        // Validate the binary header before touching the code span.
+        [[maybe_unused]] const auto* bininfo = Liverpool::GetBinaryInfo(*pgm);
+        // Hash the code itself rather than trusting the hash embedded by the shader
+        // compiler, so identical byte code reached through different addresses (or
+        // rebuilt binaries with stale embedded hashes) maps to the same module.
+        const auto code = pgm->Code();
+        key.stage_hashes[i] = XXH3_64bits(code.data(), code.size_bytes());
     }
 }
 
-std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline() {
-    const auto& regs = liverpool->regs;
+std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline(
+    const AmdGpu::Liverpool::Regs& regs, const GraphicsPipelineKey& key) {
+    PROFILE_SCOPE("PipelineCache::CreateGraphicsPipeline");
+    Common::Singleton<Common::Profiler>::Instance()->AddCounter(
+        Common::Profiler::Counter::PipelinesCompiled);
 
     // There are several cases (e.g. FCE, FMask/HTile decompression) where we don't need to do an
     // actual draw hence can skip pipeline creation.
@@ -228,18 +413,33 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline() {
     }
 
     u32 binding{};
+    std::array<vk::ShaderModule, MaxShaderStages> stages{};
     std::array<Shader::IR::Program, MaxShaderStages> programs;
     std::array<const Shader::Info*, MaxShaderStages> infos{};
 
+    // Thread-local so concurrent compile workers never serialize on the arenas, and
+    // the chunks stay warm across translations instead of being reallocated.
+    thread_local Shader::ObjectPool<Shader::IR::Inst> inst_pool{8192};
+    thread_local Shader::ObjectPool<Shader::IR::Block> block_pool{512};
+
+    struct PendingStage {
+        u32 index;
+        Shader::Stage stage;
+        u64 hash;
+        std::span<const u32> code;
+        const Liverpool::ShaderProgram* pgm;
+    };
+    boost::container::small_vector<PendingStage, MaxShaderStages> pending;
+
     for (u32 i = 0; i < MaxShaderStages; i++) {
-        if (!graphics_key.stage_hashes[i]) {
+        if (!key.stage_hashes[i]) {
             stages[i] = VK_NULL_HANDLE;
             continue;
         }
         auto* pgm = regs.ProgramForStage(i);
         const auto code = pgm->Code();
 
-        const auto it = module_map.find(graphics_key.stage_hashes[i]);
+        const auto it = module_map.find(key.stage_hashes[i]);
         if (it != module_map.end()) {
             stages[i] = *it->second;
             continue;
@@ -247,90 +447,452 @@ std::unique_ptr<GraphicsPipeline> PipelineCache::CreateGraphicsPipeline() {
 
         // Dump shader code if requested.
         const auto stage = Shader::Stage{i};
-        const u64 hash = graphics_key.stage_hashes[i];
+        const u64 hash = key.stage_hashes[i];
         if (Config::dumpShaders()) {
             DumpShader(code, hash, stage, "bin");
         }
+        pending.push_back({i, stage, hash, code, pgm});
+    }
+
+    // Recompile shaders to IR.
+    const auto translate_stage = [&regs, &programs](const PendingStage& ps,
+                                                    Shader::ObjectPool<Shader::IR::Inst>& insts,
+                                                    Shader::ObjectPool<Shader::IR::Block>& blocks) {
+        try {
+            LOG_INFO(Render_Vulkan, "Compiling {} shader {:#x}", ps.stage, ps.hash);
+            Shader::Info info = MakeShaderInfo(ps.stage, ps.pgm->user_data, regs);
+            info.pgm_base = ps.pgm->Address<uintptr_t>();
+            info.pgm_hash = ps.hash;
+            programs[ps.index] = Shader::TranslateProgram(insts, blocks, ps.code, std::move(info));
+        } catch (const Shader::Exception& e) {
+            UNREACHABLE_MSG("{}", e.what());
+        }
+    };
 
+    // Stages are independent until SPIR-V emission joins them below (descriptor
+    // bindings are handed out in stage order), so fan the translations out to the
+    // worker pool when several stages miss the module cache. Forking from inside a
+    // pool task would block a worker on work only other workers can execute.
+    struct StagePools {
+        Shader::ObjectPool<Shader::IR::Inst> inst_pool{8192};
+        Shader::ObjectPool<Shader::IR::Block> block_pool{512};
+    };
+    std::unique_ptr<StagePools[]> stage_pools;
+    if (pending.size() > 1 && !Common::ThreadPool::IsWorkerThread()) {
+        // Task-local arenas: worker-local pools could be recycled by the next task
+        // on that worker before the emission loop has consumed the IR.
+        stage_pools = std::make_unique<StagePools[]>(pending.size());
+        auto* worker_pool = Common::Singleton<Common::ThreadPool>::Instance();
+        std::latch done{static_cast<std::ptrdiff_t>(pending.size() - 1)};
+        for (size_t i = 1; i < pending.size(); ++i) {
+            worker_pool->Post([&, i] {
+                translate_stage(pending[i], stage_pools[i].inst_pool, stage_pools[i].block_pool);
+                done.count_down();
+            });
+        }
+        translate_stage(pending[0], stage_pools[0].inst_pool, stage_pools[0].block_pool);
+        done.wait();
+    } else {
         block_pool.ReleaseContents();
         inst_pool.ReleaseContents();
+        for (const auto& ps : pending) {
+            translate_stage(ps, inst_pool, block_pool);
+        }
+    }
 
-        // Recompile shader to IR.
+    // Compile IR to SPIR-V.
+    for (const auto& ps : pending) {
         try {
-            LOG_INFO(Render_Vulkan, "Compiling {} shader {:#x}", stage, hash);
-            Shader::Info info = MakeShaderInfo(stage, pgm->user_data, regs);
-            info.pgm_base = pgm->Address<uintptr_t>();
-            info.pgm_hash = hash;
-            programs[i] = Shader::TranslateProgram(inst_pool, block_pool, code, std::move(info));
-
-            // Compile IR to SPIR-V
-            auto spv_code = Shader::Backend::SPIRV::EmitSPIRV(profile, programs[i], binding);
+            // The decision depends only on this stage's own resources so the
+            // resulting module stays valid for every pipeline sharing its hash.
+            auto& info = programs[ps.index].info;
+            const u32 num_textures = static_cast<u32>(info.images.size() + info.samplers.size());
+            info.use_bindless_textures = instance.IsBindlessTexturesSupported() &&
+                                         num_textures > 0 &&
+                                         num_textures <= Shader::BindlessIndexBudget;
+            auto spv_code = Shader::Backend::SPIRV::EmitSPIRV(profile, programs[ps.index], binding);
             if (Config::dumpShaders()) {
-                DumpShader(spv_code, hash, stage, "spv");
+                DumpShader(spv_code, ps.hash, ps.stage, "spv");
             }
-            stages[i] = CompileSPV(spv_code, instance.GetDevice());
-            infos[i] = &programs[i].info;
+            stages[ps.index] = CompileSPV(spv_code, instance.GetDevice());
+            infos[ps.index] = &programs[ps.index].info;
         } catch (const Shader::Exception& e) {
             UNREACHABLE_MSG("{}", e.what());
         }
 
         // Set module name to hash in renderdoc
-        const auto name = fmt::format("{}_{:#x}", stage, hash);
-        Vulkan::SetObjectName(instance.GetDevice(), stages[i], name);
+        const auto name = fmt::format("{}_{:#x}", ps.stage, ps.hash);
+        Vulkan::SetObjectName(instance.GetDevice(), stages[ps.index], name);
     }
 
-    return std::make_unique<GraphicsPipeline>(instance, scheduler, graphics_key, *pipeline_cache,
-                                              infos, stages);
+    return std::make_unique<GraphicsPipeline>(instance, scheduler, key, *pipeline_cache,
+                                              &library_cache, layout_cache,
+                                              texture_cache.BindlessSetLayout(), infos, stages);
 }
 
-std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline() {
-    const auto& cs_pgm = liverpool->regs.cs_program;
+std::unique_ptr<ComputePipeline> PipelineCache::CreateComputePipeline(
+    const AmdGpu::Liverpool::Regs& regs, const ComputePipelineKey& key) {
+    PROFILE_SCOPE("PipelineCache::CreateComputePipeline");
+    Common::Singleton<Common::Profiler>::Instance()->AddCounter(
+        Common::Profiler::Counter::PipelinesCompiled);
+
+    const auto& cs_pgm = regs.cs_program;
     const auto code = cs_pgm.Code();
 
     // Dump shader code if requested.
     if (Config::dumpShaders()) {
-        DumpShader(code, compute_key, Shader::Stage::Compute, "bin");
+        DumpShader(code, key.code_hash, Shader::Stage::Compute, "bin");
     }
 
+    thread_local Shader::ObjectPool<Shader::IR::Inst> inst_pool{8192};
+    thread_local Shader::ObjectPool<Shader::IR::Block> block_pool{512};
     block_pool.ReleaseContents();
     inst_pool.ReleaseContents();
 
     // Recompile shader to IR.
     try {
-        LOG_INFO(Render_Vulkan, "Compiling cs shader {:#x}", compute_key);
-        Shader::Info info =
-            MakeShaderInfo(Shader::Stage::Compute, cs_pgm.user_data, liverpool->regs);
+        LOG_INFO(Render_Vulkan, "Compiling cs shader {:#x}", key.code_hash);
+        Shader::Info info = MakeShaderInfo(Shader::Stage::Compute, cs_pgm.user_data, regs);
         info.pgm_base = cs_pgm.Address<uintptr_t>();
         auto program = Shader::TranslateProgram(inst_pool, block_pool, code, std::move(info));
 
         // Compile IR to SPIR-V
         u32 binding{};
+        const u32 num_textures =
+            static_cast<u32>(program.info.images.size() + program.info.samplers.size());
+        program.info.use_bindless_textures = instance.IsBindlessTexturesSupported() &&
+                                             num_textures > 0 &&
+                                             num_textures <= Shader::BindlessIndexBudget;
         const auto spv_code = Shader::Backend::SPIRV::EmitSPIRV(profile, program, binding);
         if (Config::dumpShaders()) {
-            DumpShader(spv_code, compute_key, Shader::Stage::Compute, "spv");
+            DumpShader(spv_code, key.code_hash, Shader::Stage::Compute, "spv");
         }
         const auto module = CompileSPV(spv_code, instance.GetDevice());
         // Set module name to hash in renderdoc
-        const auto name = fmt::format("cs_{:#x}", compute_key);
+        const auto name = fmt::format("cs_{:#x}", key.code_hash);
         Vulkan::SetObjectName(instance.GetDevice(), module, name);
-        return std::make_unique<ComputePipeline>(instance, scheduler, *pipeline_cache,
-                                                 &program.info, compute_key, module);
+        return std::make_unique<ComputePipeline>(instance, scheduler, *pipeline_cache, layout_cache,
+                                                 texture_cache.BindlessSetLayout(), &program.info,
+                                                 key, module);
     } catch (const Shader::Exception& e) {
         UNREACHABLE_MSG("{}", e.what());
         return nullptr;
     }
 }
 
+void PipelineCache::LoadPipelineCache() {
+    using namespace Common::FS;
+    // Cache stores are per-title, keyed by the serial from param.sfo, so one
+    // title's pipelines never churn another's when the directory is shared.
+    const auto* param_sfo = Common::Singleton<PSF>::Instance();
+    const std::string content_id = param_sfo->GetString("CONTENT_ID");
+    const std::string serial = content_id.size() >= 16 ? content_id.substr(7, 9) : "default";
+    cache_dir = GetUserPath(PathType::ShaderDir) / "cache" / serial;
+    if (!std::filesystem::exists(cache_dir)) {
+        std::filesystem::create_directories(cache_dir);
+    }
+    pipeline_cache_file = cache_dir / "pipeline_cache.bin";
+
+    std::vector<u8> cache_data;
+    if (std::filesystem::exists(pipeline_cache_file)) {
+        const IOFile file{pipeline_cache_file, FileAccessMode::Read};
+        cache_data.resize(file.GetSize());
+        file.ReadSpan<u8>(cache_data);
+    }
+
+    // The driver only accepts initial data that was produced by the same device and driver
+    // version, so validate the blob header before handing it back.
+    const bool is_valid = [&] {
+        vk::PipelineCacheHeaderVersionOne header;
+        if (cache_data.size() < sizeof(header)) {
+            return false;
+        }
+        std::memcpy(&header, cache_data.data(), sizeof(header));
+        return header.headerVersion == vk::PipelineCacheHeaderVersion::eOne &&
+               header.vendorID == instance.GetVendorID() &&
+               header.deviceID == instance.GetDeviceID() &&
+               std::memcmp(header.pipelineCacheUUID.data(),
+                           instance.GetPipelineCacheUUID().data(), VK_UUID_SIZE) == 0;
+    }();
+    if (!is_valid && !cache_data.empty()) {
+        LOG_INFO(Render_Vulkan, "Discarding pipeline cache data from a different device or driver");
+        cache_data.clear();
+    }
+
+    pipeline_cache = instance.GetDevice().createPipelineCacheUnique({
+        .initialDataSize = cache_data.size(),
+        .pInitialData = cache_data.data(),
+    });
+    if (!cache_data.empty()) {
+        LOG_INFO(Render_Vulkan, "Loaded pipeline cache with {} bytes", cache_data.size());
+    }
+}
+
+void PipelineCache::SavePipelineCache() const {
+    const auto cache_data = instance.GetDevice().getPipelineCacheData(*pipeline_cache);
+    if (cache_data.empty()) {
+        return;
+    }
+    const IOFile file{pipeline_cache_file, FileAccessMode::Write};
+    file.WriteSpan<u8>(cache_data);
+    LOG_INFO(Render_Vulkan, "Saved pipeline cache with {} bytes", cache_data.size());
+}
+
+void PipelineCache::LoadManifest() {
+    // The manifest is an append-only data file of self-contained records with a
+    // memory-mapped (key hash -> offset, length) index over it. A record enters
+    // the index only after its append write completed, so several emulator
+    // instances can share one cache directory (including over NFS) without a
+    // writer ever corrupting what another reads.
+    manifest_data_file = cache_dir / "pipeline_manifest.bin";
+    if (!manifest_index.Open(cache_dir / "pipeline_manifest.idx", ManifestIndexCapacity,
+                             ManifestLayoutTag())) {
+        LOG_WARNING(Render_Vulkan, "Failed to map pipeline manifest index, manifest disabled");
+        return;
+    }
+    if (!std::filesystem::exists(manifest_data_file)) {
+        return;
+    }
+
+    // Gather the published records and replay them in file order, which keeps
+    // the reads sequential regardless of where hashing scattered the slots.
+    std::vector<ManifestRecordRef> records;
+    manifest_index.ForEach([&records](u64 hash, u64 offset, u32 length) {
+        records.push_back({hash, offset, length});
+    });
+    std::ranges::sort(records, {}, &ManifestRecordRef::offset);
+
+    CompactManifest(records);
+
+    const IOFile file{manifest_data_file, FileAccessMode::Read};
+    manifest.reserve(records.size());
+    std::vector<u8> buffer;
+    for (const auto& [hash, offset, length] : records) {
+        buffer.resize(length);
+        if (!file.Seek(static_cast<s64>(offset)) || file.ReadSpan<u8>(buffer) != length) {
+            LOG_WARNING(Render_Vulkan, "Pipeline manifest record at {:#x} unreadable", offset);
+            continue;
+        }
+        std::span<const u8> record{buffer};
+        ManifestEntry entry{
+            .regs = std::make_unique<AmdGpu::Liverpool::Regs>(),
+        };
+        u8 is_compute{};
+        bool ok = ConsumeObject(record, &is_compute) &&
+                  ConsumeObject(record, &entry.graphics_key) &&
+                  ConsumeObject(record, &entry.compute_key) &&
+                  ConsumeObject(record, entry.regs.get());
+        entry.is_compute = is_compute != 0;
+        for (auto& blob : entry.code) {
+            u32 num_dwords{};
+            if (!ok || !ConsumeObject(record, &num_dwords) ||
+                record.size() < num_dwords * sizeof(u32)) {
+                ok = false;
+                break;
+            }
+            blob.resize(num_dwords);
+            std::memcpy(blob.data(), record.data(), num_dwords * sizeof(u32));
+            record = record.subspan(num_dwords * sizeof(u32));
+        }
+        if (!ok) {
+            LOG_WARNING(Render_Vulkan, "Pipeline manifest record at {:#x} corrupted", offset);
+            continue;
+        }
+        manifest.push_back(std::move(entry));
+    }
+}
+
+void PipelineCache::CompactManifest(std::vector<ManifestRecordRef>& records) {
+    // Dead bytes accumulate in the data file because the index drops records
+    // without reclaiming them: a layout tag change orphans every record at
+    // once, and records published by newer emulator versions are unreadable to
+    // older ones. Once the dead share dominates, the live records are rewritten
+    // into a fresh data file and a rebuilt index is swapped in, which keeps
+    // both files proportional to the live set after months of version churn.
+    constexpr u64 MinManifestGarbage = 1_MB;
+    std::error_code ec;
+    const u64 file_size = std::filesystem::file_size(manifest_data_file, ec);
+    if (ec) {
+        return;
+    }
+    u64 live_bytes = 0;
+    for (const auto& record : records) {
+        live_bytes += record.length;
+    }
+    const u64 dead_bytes = file_size > live_bytes ? file_size - live_bytes : 0;
+    if (dead_bytes < MinManifestGarbage || dead_bytes * 2 < file_size) {
+        return;
+    }
+
+    const auto index_path = cache_dir / "pipeline_manifest.idx";
+    auto data_tmp = manifest_data_file;
+    data_tmp += ".tmp";
+    auto index_tmp = index_path;
+    index_tmp += ".tmp";
+    std::filesystem::remove(data_tmp, ec);
+    std::filesystem::remove(index_tmp, ec);
+
+    {
+        const IOFile src{manifest_data_file, FileAccessMode::Read};
+        const IOFile dst{data_tmp, FileAccessMode::Write};
+        if (!src.IsOpen() || !dst.IsOpen()) {
+            return;
+        }
+        std::vector<u8> buffer;
+        u64 new_offset = 0;
+        for (auto& record : records) {
+            buffer.resize(record.length);
+            if (!src.Seek(static_cast<s64>(record.offset)) ||
+                src.ReadSpan<u8>(buffer) != record.length) {
+                // Unreadable records are orphans; compaction is where they die.
+                record.length = 0;
+                continue;
+            }
+            if (dst.WriteSpan<u8>(buffer) != record.length) {
+                LOG_WARNING(Render_Vulkan, "Pipeline manifest compaction aborted, disk full?");
+                return;
+            }
+            record.offset = new_offset;
+            new_offset += record.length;
+        }
+    }
+    std::erase_if(records, [](const ManifestRecordRef& record) { return record.length == 0; });
+
+    {
+        Common::MmapIndex new_index;
+        if (!new_index.Open(index_tmp, ManifestIndexCapacity, ManifestLayoutTag())) {
+            return;
+        }
+        for (const auto& record : records) {
+            new_index.Insert(record.hash, record.offset, record.length);
+        }
+    }
+
+    // Swap the data file in before the index: an instance racing the rename
+    // reads stale offsets out of the compacted file, which parses as corrupt
+    // records and degrades to cache misses rather than wrong pipelines.
+    manifest_index.Close();
+    std::filesystem::rename(data_tmp, manifest_data_file, ec);
+    if (!ec) {
+        std::filesystem::rename(index_tmp, index_path, ec);
+    }
+    if (!manifest_index.Open(index_path, ManifestIndexCapacity, ManifestLayoutTag())) {
+        LOG_WARNING(Render_Vulkan, "Failed to remap pipeline manifest index after compaction");
+        return;
+    }
+    LOG_INFO(Render_Vulkan, "Compacted pipeline manifest: {} live records, {} -> {} bytes",
+             records.size(), file_size, live_bytes);
+}
+
+void PipelineCache::PrecompileManifest() {
+    if (manifest.empty()) {
+        return;
+    }
+    LOG_INFO(Render_Vulkan, "Precompiling {} pipelines from manifest", manifest.size());
+
+    // Rebase the snapshotted program addresses onto the serialized byte code so the
+    // translator reads from our buffers instead of (yet unmapped) guest memory. The
+    // address fields can only encode 256-byte-aligned pointers, so every blob is first
+    // copied into a buffer with enough slack to align its start. The buffers outlive
+    // the warmup since Shader::Info::pgm_base keeps pointing into them.
+    const auto patch_program = [this](auto& pgm, const std::vector<u32>& blob) {
+        auto& storage = precompile_code.emplace_back(blob.size() + 64);
+        u32* const code = reinterpret_cast<u32*>(
+            Common::AlignUp(reinterpret_cast<uintptr_t>(storage.data()), 256));
+        std::memcpy(code, blob.data(), blob.size() * sizeof(u32));
+        const auto addr = reinterpret_cast<uintptr_t>(code);
+        pgm.address_lo = static_cast<u32>(addr >> 8);
+        pgm.address_hi.Assign(static_cast<u32>(addr >> 40));
+    };
+    for (auto& entry : manifest) {
+        if (entry.is_compute) {
+            patch_program(entry.regs->cs_program, entry.code[0]);
+            continue;
+        }
+        for (u32 i = 0; i < MaxShaderStages; i++) {
+            if (entry.code[i].empty()) {
+                continue;
+            }
+            auto* pgm = const_cast<Liverpool::ShaderProgram*>(entry.regs->ProgramForStage(i));
+            patch_program(*pgm, entry.code[i]);
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    auto* pool = Common::Singleton<Common::ThreadPool>::Instance();
+    for (const auto& entry : manifest) {
+        pool->Post([this, &entry] {
+            if (entry.is_compute) {
+                auto pipeline = CreateComputePipeline(*entry.regs, entry.compute_key);
+                std::scoped_lock lk{pipeline_mutex};
+                compute_pipelines.try_emplace(entry.compute_key, std::move(pipeline));
+            } else {
+                auto pipeline = CreateGraphicsPipeline(*entry.regs, entry.graphics_key);
+                std::scoped_lock lk{pipeline_mutex};
+                graphics_pipelines.try_emplace(entry.graphics_key, std::move(pipeline));
+            }
+        });
+    }
+    pool->WaitForIdle();
+    const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    LOG_INFO(Render_Vulkan, "Pipeline warmup finished in {} ms", elapsed.count());
+}
+
 void PipelineCache::DumpShader(std::span<const u32> code, u64 hash, Shader::Stage stage,
                                std::string_view ext) {
+    // Hand the blob to the writer thread; compressing and writing on the render
+    // thread costs frames when dumping is left enabled for triage.
+    static constexpr size_t MaxPendingDumps = 128;
+    DumpJob job{
+        .code = {code.begin(), code.end()},
+        .filename = fmt::format("{}_{:#018x}.{}", stage, hash, ext),
+    };
+    std::scoped_lock lk{dump_mutex};
+    if (dump_queue.size() >= MaxPendingDumps) {
+        // Dropping a dump is preferable to stalling the frame behind disk IO.
+        LOG_WARNING(Render_Vulkan, "Shader dump queue full, dropping {}", job.filename);
+        return;
+    }
+    dump_queue.push_back(std::move(job));
+    dump_cv.notify_one();
+}
+
+void PipelineCache::DumpWriterLoop(std::stop_token stop_token) {
+    Common::SetCurrentThreadName("shadPS4:ShaderDumper");
+    Common::SetCurrentThreadRole(Common::ThreadRole::Io);
     using namespace Common::FS;
     const auto dump_dir = GetUserPath(PathType::ShaderDir) / "dumps";
     if (!std::filesystem::exists(dump_dir)) {
         std::filesystem::create_directories(dump_dir);
     }
-    const auto filename = fmt::format("{}_{:#018x}.{}", stage, hash, ext);
-    const auto file = IOFile{dump_dir / filename, FileAccessMode::Write};
-    file.WriteSpan(code);
+    while (true) {
+        DumpJob job;
+        {
+            std::unique_lock lk{dump_mutex};
+            Common::CondvarWait(dump_cv, lk, stop_token, [this] { return !dump_queue.empty(); });
+            if (dump_queue.empty()) {
+                // Stop was requested and every pending dump has been flushed.
+                break;
+            }
+            job = std::move(dump_queue.front());
+            dump_queue.pop_front();
+        }
+        const size_t src_size = job.code.size() * sizeof(u32);
+        std::vector<u8> compressed(zng_compressBound(src_size));
+        size_t compressed_size = compressed.size();
+        const int result =
+            zng_compress2(compressed.data(), &compressed_size,
+                          reinterpret_cast<const u8*>(job.code.data()), src_size,
+                          Z_DEFAULT_COMPRESSION);
+        if (result != Z_OK) {
+            LOG_ERROR(Render_Vulkan, "Failed compressing shader dump {}: {}", job.filename,
+                      result);
+            continue;
+        }
+        const auto file = IOFile{dump_dir / (job.filename + ".z"), FileAccessMode::Write};
+        file.WriteRaw<u8>(compressed.data(), compressed_size);
+    }
 }
 
 } // namespace Vulkan
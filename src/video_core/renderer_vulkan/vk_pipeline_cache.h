@@ -3,12 +3,19 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 #include <tsl/robin_map.h>
-#include "shader_recompiler/ir/basic_block.h"
-#include "shader_recompiler/object_pool.h"
+#include "common/mmap_index.h"
 #include "shader_recompiler/profile.h"
 #include "video_core/renderer_vulkan/vk_compute_pipeline.h"
 #include "video_core/renderer_vulkan/vk_graphics_pipeline.h"
+#include "video_core/renderer_vulkan/vk_layout_cache.h"
 
 namespace Shader {
 struct Info;
@@ -24,35 +31,88 @@ class PipelineCache {
 
 public:
     explicit PipelineCache(const Instance& instance, Scheduler& scheduler,
-                           AmdGpu::Liverpool* liverpool);
-    ~PipelineCache() = default;
+                           AmdGpu::Liverpool* liverpool, VideoCore::TextureCache& texture_cache);
+    ~PipelineCache();
 
     const GraphicsPipeline* GetGraphicsPipeline();
 
     const ComputePipeline* GetComputePipeline();
 
 private:
+    struct AsyncJob {
+        std::unique_ptr<AmdGpu::Liverpool::Regs> regs;
+        GraphicsPipelineKey graphics_key;
+        ComputePipelineKey compute_key;
+        bool is_compute;
+    };
+
+    struct ManifestEntry {
+        std::unique_ptr<AmdGpu::Liverpool::Regs> regs;
+        GraphicsPipelineKey graphics_key;
+        ComputePipelineKey compute_key;
+        bool is_compute;
+        std::array<std::vector<u32>, MaxShaderStages> code;
+    };
+
+    struct DumpJob {
+        std::vector<u32> code;
+        std::string filename;
+    };
+
+    struct ManifestRecordRef {
+        u64 hash;
+        u64 offset;
+        u32 length;
+    };
+
     void RefreshGraphicsKey();
+    void RefreshComputeKey();
+    void LoadPipelineCache();
+    void SavePipelineCache() const;
+    void RecordManifestEntry(bool is_compute);
+    void LoadManifest();
+    void CompactManifest(std::vector<ManifestRecordRef>& records);
+    void PrecompileManifest();
+    void DumpWriterLoop(std::stop_token stop_token);
+    void EnqueueAsyncJob(bool is_compute);
+    void AsyncCompileLoop(std::stop_token stop_token);
     void DumpShader(std::span<const u32> code, u64 hash, Shader::Stage stage, std::string_view ext);
 
-    std::unique_ptr<GraphicsPipeline> CreateGraphicsPipeline();
-    std::unique_ptr<ComputePipeline> CreateComputePipeline();
+    std::unique_ptr<GraphicsPipeline> CreateGraphicsPipeline(const AmdGpu::Liverpool::Regs& regs,
+                                                             const GraphicsPipelineKey& key);
+    std::unique_ptr<ComputePipeline> CreateComputePipeline(const AmdGpu::Liverpool::Regs& regs,
+                                                           const ComputePipelineKey& key);
 
 private:
     const Instance& instance;
     Scheduler& scheduler;
     AmdGpu::Liverpool* liverpool;
+    VideoCore::TextureCache& texture_cache;
     vk::UniquePipelineCache pipeline_cache;
+    PipelineLibraryCache library_cache;
+    LayoutCache layout_cache;
+    std::filesystem::path pipeline_cache_file;
     vk::UniquePipelineLayout pipeline_layout;
     tsl::robin_map<size_t, vk::UniqueShaderModule> module_map;
-    std::array<vk::ShaderModule, MaxShaderStages> stages{};
-    tsl::robin_map<size_t, std::unique_ptr<ComputePipeline>> compute_pipelines;
+    tsl::robin_map<ComputePipelineKey, std::unique_ptr<ComputePipeline>> compute_pipelines;
     tsl::robin_map<GraphicsPipelineKey, std::unique_ptr<GraphicsPipeline>> graphics_pipelines;
     Shader::Profile profile{};
     GraphicsPipelineKey graphics_key{};
-    u64 compute_key{};
-    Shader::ObjectPool<Shader::IR::Inst> inst_pool;
-    Shader::ObjectPool<Shader::IR::Block> block_pool;
+    ComputePipelineKey compute_key{};
+    std::mutex pipeline_mutex;
+    std::mutex queue_mutex;
+    std::condition_variable_any queue_cv;
+    std::deque<AsyncJob> job_queue;
+    std::jthread async_thread;
+    std::mutex dump_mutex;
+    std::condition_variable_any dump_cv;
+    std::deque<DumpJob> dump_queue;
+    std::jthread dump_thread;
+    std::filesystem::path cache_dir;
+    std::filesystem::path manifest_data_file;
+    Common::MmapIndex manifest_index;
+    std::vector<ManifestEntry> manifest;
+    std::vector<std::vector<u32>> precompile_code;
 };
 
 } // namespace Vulkan
@@ -1,8 +1,12 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
+#include <xxhash.h>
 #include "common/config.h"
 #include "common/debug.h"
+#include "common/profiler.h"
+#include "common/singleton.h"
 #include "core/memory.h"
 #include "video_core/amdgpu/liverpool.h"
 #include "video_core/renderer_vulkan/vk_instance.h"
@@ -18,12 +22,18 @@ static constexpr vk::BufferUsageFlags VertexIndexFlags =
     vk::BufferUsageFlagBits::eTransferDst | vk::BufferUsageFlagBits::eUniformBuffer |
     vk::BufferUsageFlagBits::eStorageBuffer;
 
+// Below this vertex count QuadList index emission stays on the CPU; the
+// compute path has to end the current render pass, which the dispatch only
+// amortizes for larger draws.
+static constexpr u32 MinVerticesForGpuIndexEmit = 1024;
+
 Rasterizer::Rasterizer(const Instance& instance_, Scheduler& scheduler_,
                        VideoCore::TextureCache& texture_cache_, AmdGpu::Liverpool* liverpool_)
     : instance{instance_}, scheduler{scheduler_}, texture_cache{texture_cache_},
       liverpool{liverpool_}, memory{Core::Memory::Instance()},
-      pipeline_cache{instance, scheduler, liverpool},
-      vertex_index_buffer{instance, scheduler, VertexIndexFlags, 3_GB, BufferType::Upload} {
+      pipeline_cache{instance, scheduler, liverpool, texture_cache},
+      vertex_index_buffer{instance, scheduler, VertexIndexFlags, 3_GB, BufferType::Upload},
+      index_converter{instance, scheduler}, buffer_cache{instance, scheduler} {
     if (!Config::nullGpu()) {
         liverpool->BindRasterizer(this);
     }
@@ -35,25 +45,68 @@ Rasterizer::~Rasterizer() = default;
 
 void Rasterizer::Draw(bool is_indexed, u32 index_offset) {
     RENDERER_TRACE;
+    Common::Singleton<Common::Profiler>::Instance()->AddCounter(
+        Common::Profiler::Counter::DrawCalls);
 
     const auto cmdbuf = scheduler.CommandBuffer();
     const auto& regs = liverpool->regs;
+
+    // FCE and FMask decompression passes have no host-side equivalent draw; resolve
+    // any fast clear still pending on the bound targets instead.
+    if (regs.color_control.mode == Liverpool::ColorControl::OperationMode::EliminateFastClear ||
+        regs.color_control.mode == Liverpool::ColorControl::OperationMode::FmaskDecompress) {
+        EliminateFastClear();
+        return;
+    }
+
+    // A resolve draw copies the multisampled MRT0 into the single-sampled MRT1
+    // through the color block without running a shader; emit a host resolve so
+    // the samples never leave the device.
+    if (regs.color_control.mode == Liverpool::ColorControl::OperationMode::Resolve) {
+        ResolveMsaaTarget();
+        return;
+    }
+
     const u32 num_indices = SetupIndexBuffer(is_indexed, index_offset);
     const GraphicsPipeline* pipeline = pipeline_cache.GetGraphicsPipeline();
     if (!pipeline) {
         return;
     }
 
-    try {
-        pipeline->BindResources(memory, vertex_index_buffer, texture_cache);
-    } catch (...) {
-        UNREACHABLE();
+    // Merge runs of identical-state draws: when the pipeline and the user-data
+    // registers feeding its bindings match the previous draw in this command
+    // buffer, and no PM4 packet has written guest memory in between, the
+    // descriptor pushes and pipeline bind already recorded still apply.
+    struct BindState {
+        const GraphicsPipeline* pipeline;
+        Liverpool::UserData vs_data;
+        Liverpool::UserData ps_data;
+    } bind_state{pipeline, regs.vs_program.user_data, regs.ps_program.user_data};
+    const u64 bind_hash = XXH3_64bits(&bind_state, sizeof(bind_state));
+    const bool merge_bindings = bind_hash == merged_bind_hash &&
+                                !(liverpool->dirty_state & Liverpool::DirtyGpuMemory) &&
+                                scheduler.CurrentTick() == dynamic_state_tick;
+
+    // Dispatches may have written buffers this draw consumes through the cache;
+    // make them visible before any binding reads or reuploads the ranges.
+    FlushComputeWrites();
+
+    if (!merge_bindings) {
+        try {
+            pipeline->BindResources(memory, vertex_index_buffer, buffer_cache, texture_cache);
+        } catch (...) {
+            UNREACHABLE();
+        }
     }
 
     BeginRendering();
     UpdateDynamicState(*pipeline);
 
-    cmdbuf.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline->Handle());
+    if (!merge_bindings) {
+        cmdbuf.bindPipeline(vk::PipelineBindPoint::eGraphics, pipeline->Handle());
+    }
+    merged_bind_hash = bind_hash;
+    liverpool->dirty_state &= ~Liverpool::DirtyGpuMemory;
     if (is_indexed) {
         cmdbuf.drawIndexed(num_indices, regs.num_instances.NumInstances(), 0, 0, 0);
     } else {
@@ -66,6 +119,8 @@ void Rasterizer::Draw(bool is_indexed, u32 index_offset) {
 
 void Rasterizer::DispatchDirect() {
     RENDERER_TRACE;
+    Common::Singleton<Common::Profiler>::Instance()->AddCounter(
+        Common::Profiler::Counter::DispatchCalls);
 
     const auto cmdbuf = scheduler.CommandBuffer();
     const auto& cs_program = liverpool->regs.cs_program;
@@ -74,9 +129,10 @@ void Rasterizer::DispatchDirect() {
         return;
     }
 
+    ComputeBufferAccessList accesses;
     try {
-        const auto has_resources =
-            pipeline->BindResources(memory, vertex_index_buffer, texture_cache);
+        const auto has_resources = pipeline->BindResources(memory, vertex_index_buffer,
+                                                           buffer_cache, texture_cache, accesses);
         if (!has_resources) {
             return;
         }
@@ -84,15 +140,266 @@ void Rasterizer::DispatchDirect() {
         UNREACHABLE();
     }
 
+    scheduler.FlushImageBarriers();
     scheduler.EndRendering();
+    EmitComputeBufferBarriers(accesses);
     cmdbuf.bindPipeline(vk::PipelineBindPoint::eCompute, pipeline->Handle());
+    scheduler.BeginGpuScope("dispatch", std::hash<ComputePipelineKey>{}(pipeline->GetKey()));
     cmdbuf.dispatch(cs_program.dim_x, cs_program.dim_y, cs_program.dim_z);
+    scheduler.EndGpuScope();
+    // The dispatch may write buffers the next draw reads, so stop merging.
+    merged_bind_hash = 0;
+}
+
+void Rasterizer::EmitComputeBufferBarriers(const ComputeBufferAccessList& accesses) {
+    boost::container::small_vector<vk::BufferMemoryBarrier, 8> barriers;
+    for (const auto& write : pending_compute_writes) {
+        const bool overlaps = std::ranges::any_of(accesses, [&](const ComputeBufferAccess& access) {
+            return write.address < access.address + access.size &&
+                   access.address < write.address + write.size;
+        });
+        if (!overlaps) {
+            continue;
+        }
+        // The cache may have replaced the buffer since the write; the reupload
+        // into its successor is ordered by the transfer barriers already.
+        const auto [live, live_offset] = buffer_cache.TryObtainTrackedBuffer(write.address, 1);
+        if (live != write.buffer) {
+            continue;
+        }
+        barriers.push_back({
+            .srcAccessMask = vk::AccessFlagBits::eShaderWrite,
+            .dstAccessMask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .buffer = write.buffer,
+            .offset = write.offset,
+            .size = write.size,
+        });
+    }
+    if (!barriers.empty()) {
+        scheduler.CommandBuffer().pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader,
+                                                  vk::PipelineStageFlagBits::eComputeShader,
+                                                  vk::DependencyFlagBits{}, {}, barriers, {});
+    }
+    // Record the writes of the dispatch about to be recorded. A rewrite of the
+    // same range supersedes the previous entry instead of stacking onto it.
+    for (const auto& access : accesses) {
+        if (!access.is_written) {
+            continue;
+        }
+        const auto it =
+            std::ranges::find_if(pending_compute_writes, [&](const ComputeBufferAccess& write) {
+                return write.address == access.address && write.size == access.size;
+            });
+        if (it != pending_compute_writes.end()) {
+            *it = access;
+        } else {
+            pending_compute_writes.push_back(access);
+        }
+    }
+}
+
+void Rasterizer::FlushComputeWrites() {
+    if (pending_compute_writes.empty()) {
+        return;
+    }
+    boost::container::small_vector<vk::BufferMemoryBarrier, 8> barriers;
+    for (const auto& write : pending_compute_writes) {
+        const auto [live, live_offset] = buffer_cache.TryObtainTrackedBuffer(write.address, 1);
+        if (live != write.buffer) {
+            continue;
+        }
+        barriers.push_back({
+            .srcAccessMask = vk::AccessFlagBits::eShaderWrite,
+            .dstAccessMask = vk::AccessFlagBits::eMemoryRead | vk::AccessFlagBits::eMemoryWrite,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .buffer = write.buffer,
+            .offset = write.offset,
+            .size = write.size,
+        });
+    }
+    pending_compute_writes.clear();
+    if (barriers.empty()) {
+        return;
+    }
+    scheduler.EndRendering();
+    scheduler.CommandBuffer().pipelineBarrier(vk::PipelineStageFlagBits::eComputeShader,
+                                              vk::PipelineStageFlagBits::eAllCommands,
+                                              vk::DependencyFlagBits{}, {}, barriers, {});
+}
+
+void Rasterizer::SignalFence(std::function<void()>&& signal) {
+    scheduler.SignalFence(std::move(signal));
+}
+
+bool Rasterizer::CpDmaCopy(VAddr dst_addr, VAddr src_addr, u32 num_bytes) {
+    FlushComputeWrites();
+    const auto [src_buffer, src_offset] = buffer_cache.TryObtainTrackedBuffer(src_addr, num_bytes);
+    const auto [dst_buffer, dst_offset] = buffer_cache.TryObtainTrackedBuffer(dst_addr, num_bytes);
+    if (!src_buffer || !dst_buffer) {
+        return false;
+    }
+
+    scheduler.EndRendering();
+    const auto cmdbuf = scheduler.CommandBuffer();
+    const vk::BufferMemoryBarrier pre_barrier = {
+        .srcAccessMask = vk::AccessFlagBits::eMemoryWrite,
+        .dstAccessMask = vk::AccessFlagBits::eTransferRead,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .buffer = src_buffer,
+        .offset = src_offset,
+        .size = num_bytes,
+    };
+    cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eAllCommands,
+                           vk::PipelineStageFlagBits::eTransfer, vk::DependencyFlagBits{}, {},
+                           pre_barrier, {});
+    const vk::BufferCopy copy = {
+        .srcOffset = src_offset,
+        .dstOffset = dst_offset,
+        .size = num_bytes,
+    };
+    cmdbuf.copyBuffer(src_buffer, dst_buffer, copy);
+    const vk::BufferMemoryBarrier post_barrier = {
+        .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+        .dstAccessMask = vk::AccessFlagBits::eMemoryRead,
+        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+        .buffer = dst_buffer,
+        .offset = dst_offset,
+        .size = num_bytes,
+    };
+    cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                           vk::PipelineStageFlagBits::eAllCommands, vk::DependencyFlagBits{}, {},
+                           post_barrier, {});
+    return true;
+}
+
+void Rasterizer::EliminateFastClear() {
+    const auto& regs = liverpool->regs;
+    for (auto col_buf_id = 0u; col_buf_id < Liverpool::NumColorBuffers; ++col_buf_id) {
+        const auto& col_buf = regs.color_buffers[col_buf_id];
+        if (!col_buf || !texture_cache.IsMetaCleared(col_buf.CmaskAddress())) {
+            continue;
+        }
+        // The metadata still carries a deferred fast clear that no render pass has
+        // consumed. Write the clear color into the target now so anything sampling
+        // it afterwards observes decompressed contents, keeping the surface
+        // resident instead of falling back to a guest memory refresh.
+        const auto& hint = liverpool->last_cb_extent[col_buf_id];
+        const auto& image_view =
+            texture_cache.RenderTarget(col_buf, hint, TargetScale(col_buf.Address()));
+        auto& image = texture_cache.GetImage(image_view.image_id);
+        scheduler.EndRendering();
+        image.Transit(vk::ImageLayout::eTransferDstOptimal, vk::AccessFlagBits::eTransferWrite);
+        const vk::ImageSubresourceRange range = {
+            .aspectMask = vk::ImageAspectFlagBits::eColor,
+            .baseMipLevel = 0,
+            .levelCount = VK_REMAINING_MIP_LEVELS,
+            .baseArrayLayer = 0,
+            .layerCount = VK_REMAINING_ARRAY_LAYERS,
+        };
+        const auto cmdbuf = scheduler.CommandBuffer();
+        cmdbuf.clearColorImage(image.image, vk::ImageLayout::eTransferDstOptimal,
+                               LiverpoolToVK::ColorBufferClearValue(col_buf).color, range);
+        texture_cache.TouchMeta(col_buf.CmaskAddress(), false);
+    }
+}
+
+void Rasterizer::ResolveMsaaTarget() {
+    const auto& regs = liverpool->regs;
+    const auto& src_buf = regs.color_buffers[0];
+    const auto& dst_buf = regs.color_buffers[1];
+    if (!src_buf || !dst_buf) {
+        LOG_WARNING(Render_Vulkan, "Resolve draw without a valid MRT0/MRT1 pair, skipping");
+        return;
+    }
+
+    // Consume any fast clear still pending on either target first so the
+    // resolve reads and produces decompressed contents.
+    EliminateFastClear();
+
+    const auto& src_view = texture_cache.RenderTarget(src_buf, liverpool->last_cb_extent[0],
+                                                      TargetScale(src_buf.Address()));
+    const auto& dst_view = texture_cache.RenderTarget(dst_buf, liverpool->last_cb_extent[1],
+                                                      TargetScale(dst_buf.Address()));
+    auto& src_image = texture_cache.GetImage(src_view.image_id);
+    auto& dst_image = texture_cache.GetImage(dst_view.image_id);
+
+    scheduler.EndRendering();
+    src_image.Transit(vk::ImageLayout::eTransferSrcOptimal, vk::AccessFlagBits::eTransferRead);
+    dst_image.Transit(vk::ImageLayout::eTransferDstOptimal, vk::AccessFlagBits::eTransferWrite);
+
+    const vk::ImageSubresourceLayers subresource = {
+        .aspectMask = vk::ImageAspectFlagBits::eColor,
+        .mipLevel = 0,
+        .baseArrayLayer = 0,
+        .layerCount = 1,
+    };
+    const vk::Extent3D extent = {
+        .width = std::min(src_image.info.size.width, dst_image.info.size.width),
+        .height = std::min(src_image.info.size.height, dst_image.info.size.height),
+        .depth = 1,
+    };
+    const auto cmdbuf = scheduler.CommandBuffer();
+    if (src_image.info.num_samples > 1) {
+        const vk::ImageResolve region = {
+            .srcSubresource = subresource,
+            .srcOffset = {},
+            .dstSubresource = subresource,
+            .dstOffset = {},
+            .extent = extent,
+        };
+        cmdbuf.resolveImage(src_image.image, vk::ImageLayout::eTransferSrcOptimal, dst_image.image,
+                            vk::ImageLayout::eTransferDstOptimal, region);
+    } else {
+        // Titles also issue resolve draws over single-sampled targets as a
+        // fixed-function copy; the color block treats them the same way.
+        const vk::ImageCopy region = {
+            .srcSubresource = subresource,
+            .srcOffset = {},
+            .dstSubresource = subresource,
+            .dstOffset = {},
+            .extent = extent,
+        };
+        cmdbuf.copyImage(src_image.image, vk::ImageLayout::eTransferSrcOptimal, dst_image.image,
+                         vk::ImageLayout::eTransferDstOptimal, region);
+    }
+
+    // The destination now holds expanded contents, so any clear still recorded
+    // against its metadata no longer applies.
+    texture_cache.TouchMeta(dst_buf.CmaskAddress(), false);
+}
+
+u32 Rasterizer::TargetScale(VAddr address) {
+    const u32 scale = render_scale_pct.load(std::memory_order_relaxed);
+    if (scale == 100) {
+        return 100;
+    }
+    // Presentation looks video-out surfaces up with guest dimensions, so
+    // targets backed by one must stay at native size.
+    return texture_cache.IsVideoOutSurface(address) ? 100 : scale;
 }
 
 void Rasterizer::BeginRendering() {
     const auto& regs = liverpool->regs;
     RenderState state;
 
+    // All attachments of a pass share one scale; any bound video-out surface
+    // pins the whole pass to native resolution.
+    pass_scale = render_scale_pct.load(std::memory_order_relaxed);
+    if (pass_scale != 100) {
+        for (auto col_buf_id = 0u; col_buf_id < Liverpool::NumColorBuffers; ++col_buf_id) {
+            const auto& col_buf = regs.color_buffers[col_buf_id];
+            if (col_buf && texture_cache.IsVideoOutSurface(col_buf.Address())) {
+                pass_scale = 100;
+                break;
+            }
+        }
+    }
+
     for (auto col_buf_id = 0u; col_buf_id < Liverpool::NumColorBuffers; ++col_buf_id) {
         const auto& col_buf = regs.color_buffers[col_buf_id];
         if (!col_buf) {
@@ -100,7 +407,7 @@ void Rasterizer::BeginRendering() {
         }
 
         const auto& hint = liverpool->last_cb_extent[col_buf_id];
-        const auto& image_view = texture_cache.RenderTarget(col_buf, hint);
+        const auto& image_view = texture_cache.RenderTarget(col_buf, hint, pass_scale);
         const auto& image = texture_cache.GetImage(image_view.image_id);
         state.width = std::min<u32>(state.width, image.info.size.width);
         state.height = std::min<u32>(state.height, image.info.size.height);
@@ -123,8 +430,9 @@ void Rasterizer::BeginRendering() {
         const bool is_clear = regs.depth_render_control.depth_clear_enable ||
                               texture_cache.IsMetaCleared(htile_address);
         const auto& hint = liverpool->last_db_extent;
-        const auto& image_view = texture_cache.DepthTarget(regs.depth_buffer, htile_address, hint,
-                                                           regs.depth_control.depth_write_enable);
+        const auto& image_view =
+            texture_cache.DepthTarget(regs.depth_buffer, htile_address, hint,
+                                      regs.depth_control.depth_write_enable, pass_scale);
         const auto& image = texture_cache.GetImage(image_view.image_id);
         state.width = std::min<u32>(state.width, image.info.size.width);
         state.height = std::min<u32>(state.height, image.info.size.height);
@@ -148,9 +456,20 @@ u32 Rasterizer::SetupIndexBuffer(bool& is_indexed, u32 index_offset) {
     if (liverpool->regs.primitive_type == Liverpool::PrimitiveType::QuadList) {
         // ASSERT_MSG(!is_indexed, "Using QuadList primitive with indexed draw");
         is_indexed = true;
+        const u32 index_size = 3 * regs.num_indices;
+
+        // Large draws generate the index pattern with a compute dispatch;
+        // small ones are cheaper to emit on the CPU than to interrupt the
+        // render pass for.
+        if (regs.num_indices >= MinVerticesForGpuIndexEmit) {
+            const u64 offset =
+                index_converter.EmitQuadListIndices(vertex_index_buffer, regs.num_indices);
+            const auto cmdbuf = scheduler.CommandBuffer();
+            cmdbuf.bindIndexBuffer(vertex_index_buffer.Handle(), offset, vk::IndexType::eUint16);
+            return index_size / sizeof(u16);
+        }
 
         // Emit indices.
-        const u32 index_size = 3 * regs.num_indices;
         const auto [data, offset, _] = vertex_index_buffer.Map(index_size);
         LiverpoolToVK::EmitQuadToTriangleListIndices(data, regs.num_indices);
         vertex_index_buffer.Commit(index_size);
@@ -169,28 +488,56 @@ u32 Rasterizer::SetupIndexBuffer(bool& is_indexed, u32 index_offset) {
     const vk::IndexType index_type = is_index16 ? vk::IndexType::eUint16 : vk::IndexType::eUint32;
     const u32 index_size = is_index16 ? sizeof(u16) : sizeof(u32);
 
-    // Upload index data to stream buffer.
     const auto index_address = regs.index_base_address.Address<const void*>();
     const u32 index_buffer_size = (index_offset + regs.num_indices) * index_size;
+    const auto cmdbuf = scheduler.CommandBuffer();
+
+    // Bind the cached GPU resident copy if the data hasn't changed since the last draw.
+    const auto [cached_buffer, cached_offset] = buffer_cache.ObtainBuffer(
+        reinterpret_cast<VAddr>(index_address), index_buffer_size);
+    if (cached_buffer) {
+        cmdbuf.bindIndexBuffer(cached_buffer, cached_offset + index_offset * index_size,
+                               index_type);
+        return regs.num_indices;
+    }
+
+    // Upload index data to stream buffer.
     const auto [data, offset, _] = vertex_index_buffer.Map(index_buffer_size);
     std::memcpy(data, index_address, index_buffer_size);
     vertex_index_buffer.Commit(index_buffer_size);
 
     // Bind index buffer.
-    const auto cmdbuf = scheduler.CommandBuffer();
     cmdbuf.bindIndexBuffer(vertex_index_buffer.Handle(), offset + index_offset * index_size,
                            index_type);
     return regs.num_indices;
 }
 
 void Rasterizer::UpdateDynamicState(const GraphicsPipeline& pipeline) {
-    UpdateViewportScissorState();
+    // Dynamic state does not carry over between command buffers, so everything
+    // is considered dirty again once the scheduler has moved to a new one.
+    if (scheduler.CurrentTick() != dynamic_state_tick) {
+        dynamic_state_tick = scheduler.CurrentTick();
+        liverpool->dirty_state = Liverpool::DirtyAll;
+        write_mask_pipeline = nullptr;
+    }
 
     auto& regs = liverpool->regs;
     const auto cmdbuf = scheduler.CommandBuffer();
-    cmdbuf.setBlendConstants(&regs.blend_constants.red);
 
-    if (instance.IsColorWriteEnableSupported()) {
+    // The render scale folds into the viewport, so a pass rendering at a
+    // different scale must refresh it even when the guest registers are clean.
+    if ((liverpool->dirty_state & Liverpool::DirtyViewportScissor) ||
+        applied_viewport_scale != pass_scale) {
+        UpdateViewportScissorState();
+        applied_viewport_scale = pass_scale;
+    }
+    if (liverpool->dirty_state & Liverpool::DirtyBlendConstants) {
+        cmdbuf.setBlendConstants(&regs.blend_constants.red);
+    }
+    liverpool->dirty_state = 0;
+
+    if (instance.IsColorWriteEnableSupported() && write_mask_pipeline != &pipeline) {
+        write_mask_pipeline = &pipeline;
         const auto& write_masks = pipeline.GetWriteMasks();
         std::array<vk::Bool32, Liverpool::NumColorBuffers> write_ens{};
         std::transform(write_masks.cbegin(), write_masks.cend(), write_ens.begin(),
@@ -207,6 +554,10 @@ void Rasterizer::UpdateViewportScissorState() {
     boost::container::static_vector<vk::Viewport, Liverpool::NumViewports> viewports;
     boost::container::static_vector<vk::Rect2D, Liverpool::NumViewports> scissors;
 
+    // Guest viewports address native target pixels; when the pass renders into
+    // scaled-down attachments the raster window shrinks by the same factor.
+    const float xy_scale = pass_scale / 100.0f;
+
     const float reduce_z =
         regs.clipper_control.clip_space == AmdGpu::Liverpool::ClipSpace::MinusWToW ? 1.0f : 0.0f;
     for (u32 i = 0; i < Liverpool::NumViewports; i++) {
@@ -216,18 +567,19 @@ void Rasterizer::UpdateViewportScissorState() {
             continue;
         }
         viewports.push_back({
-            .x = vp.xoffset - vp.xscale,
-            .y = vp.yoffset - vp.yscale,
-            .width = vp.xscale * 2.0f,
-            .height = vp.yscale * 2.0f,
+            .x = (vp.xoffset - vp.xscale) * xy_scale,
+            .y = (vp.yoffset - vp.yscale) * xy_scale,
+            .width = vp.xscale * 2.0f * xy_scale,
+            .height = vp.yscale * 2.0f * xy_scale,
             .minDepth = vp.zoffset - vp.zscale * reduce_z,
             .maxDepth = vp.zscale + vp.zoffset,
         });
     }
     const auto& sc = regs.screen_scissor;
     scissors.push_back({
-        .offset = {sc.top_left_x, sc.top_left_y},
-        .extent = {sc.GetWidth(), sc.GetHeight()},
+        .offset = {static_cast<s32>(sc.top_left_x * pass_scale / 100),
+                   static_cast<s32>(sc.top_left_y * pass_scale / 100)},
+        .extent = {sc.GetWidth() * pass_scale / 100, sc.GetHeight() * pass_scale / 100},
     });
     const auto cmdbuf = scheduler.CommandBuffer();
     cmdbuf.setViewport(0, viewports);
@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
+#include "video_core/buffer_cache/buffer_cache.h"
+#include "video_core/renderer_vulkan/vk_index_converter.h"
 #include "video_core/renderer_vulkan/vk_pipeline_cache.h"
 #include "video_core/renderer_vulkan/vk_stream_buffer.h"
 
@@ -33,11 +37,36 @@ public:
 
     void DispatchDirect();
 
+    /// Records a CP DMA transfer as a device copy when both endpoints are GPU-tracked.
+    /// Returns false when either range is untracked and the copy must run on the CPU.
+    bool CpDmaCopy(VAddr dst_addr, VAddr src_addr, u32 num_bytes);
+
+    /// Invokes the callback once all work recorded so far has executed on the GPU.
+    void SignalFence(std::function<void()>&& signal);
+
+    /// Sets the render scale applied to non-presented targets, in percent.
+    /// Called from the present thread by the resolution feedback controller.
+    void SetRenderScale(u32 scale_pct) {
+        render_scale_pct.store(scale_pct, std::memory_order_relaxed);
+    }
+
 private:
     u32 SetupIndexBuffer(bool& is_indexed, u32 index_offset);
     void MapMemory(VAddr addr, size_t size);
 
     void BeginRendering();
+    void EliminateFastClear();
+    void ResolveMsaaTarget();
+
+    /// Emits buffer barriers for ranges of previous dispatch writes the next
+    /// dispatch touches; chains over disjoint ranges record no barrier at all.
+    void EmitComputeBufferBarriers(const ComputeBufferAccessList& accesses);
+
+    /// Makes all outstanding dispatch writes visible to every later stage.
+    void FlushComputeWrites();
+
+    /// Returns the scale to allocate the target backed by address at.
+    u32 TargetScale(VAddr address);
 
     void UpdateDynamicState(const GraphicsPipeline& pipeline);
     void UpdateViewportScissorState();
@@ -51,6 +80,20 @@ private:
     Core::MemoryManager* memory;
     PipelineCache pipeline_cache;
     StreamBuffer vertex_index_buffer;
+    IndexConverter index_converter;
+    VideoCore::BufferCache buffer_cache;
+    u64 dynamic_state_tick{};
+    const GraphicsPipeline* write_mask_pipeline{};
+    // Render scale requested by the feedback controller and the scale the
+    // current pass actually renders at (100 when a video-out surface is bound).
+    std::atomic<u32> render_scale_pct{100};
+    u32 pass_scale{100};
+    u32 applied_viewport_scale{100};
+    // Hash of the pipeline and user-data state of the previous draw; a match
+    // lets a run of identical-state draws skip rebinding resources entirely.
+    u64 merged_bind_hash{};
+    // Guest ranges written by dispatches that no barrier has made visible yet.
+    boost::container::small_vector<ComputeBufferAccess, 8> pending_compute_writes;
 };
 
 } // namespace Vulkan
@@ -61,46 +61,67 @@ std::size_t ResourcePool::ManageOverflow() {
 
 constexpr std::size_t COMMAND_BUFFER_POOL_SIZE = 4;
 
-CommandPool::CommandPool(const Instance& instance, MasterSemaphore* master_semaphore)
-    : ResourcePool{master_semaphore, COMMAND_BUFFER_POOL_SIZE}, instance{instance} {
+CommandPool::CommandPool(const Instance& instance_, MasterSemaphore* master_semaphore_)
+    : instance{instance_}, master_semaphore{master_semaphore_} {
     const vk::CommandPoolCreateInfo pool_create_info = {
-        .flags = vk::CommandPoolCreateFlagBits::eTransient |
-                 vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
+        .flags = vk::CommandPoolCreateFlagBits::eTransient,
         .queueFamilyIndex = instance.GetGraphicsQueueFamilyIndex(),
     };
     const vk::Device device = instance.GetDevice();
-    cmd_pool = device.createCommandPoolUnique(pool_create_info);
-    if (instance.HasDebuggingToolAttached()) {
-        SetObjectName(device, *cmd_pool, "CommandPool");
+    for (std::size_t i = 0; i < RingDepth; ++i) {
+        ring[i].pool = device.createCommandPoolUnique(pool_create_info);
+        if (instance.HasDebuggingToolAttached()) {
+            SetObjectName(device, *ring[i].pool, "CommandPool: Tick Pool {}", i);
+        }
+        Grow(ring[i]);
     }
 }
 
 CommandPool::~CommandPool() = default;
 
-void CommandPool::Allocate(std::size_t begin, std::size_t end) {
-    cmd_buffers.resize(end);
+void CommandPool::Grow(TickPool& slot) {
+    const std::size_t begin = slot.cmd_buffers.size();
+    slot.cmd_buffers.resize(begin + COMMAND_BUFFER_POOL_SIZE);
 
     const vk::CommandBufferAllocateInfo buffer_alloc_info = {
-        .commandPool = *cmd_pool,
+        .commandPool = *slot.pool,
         .level = vk::CommandBufferLevel::ePrimary,
         .commandBufferCount = COMMAND_BUFFER_POOL_SIZE,
     };
 
     const vk::Device device = instance.GetDevice();
     const auto result =
-        device.allocateCommandBuffers(&buffer_alloc_info, cmd_buffers.data() + begin);
+        device.allocateCommandBuffers(&buffer_alloc_info, slot.cmd_buffers.data() + begin);
     ASSERT(result == vk::Result::eSuccess);
 
     if (instance.HasDebuggingToolAttached()) {
-        for (std::size_t i = begin; i < end; ++i) {
-            SetObjectName(device, cmd_buffers[i], "CommandPool: Command Buffer {}", i);
+        for (std::size_t i = begin; i < slot.cmd_buffers.size(); ++i) {
+            SetObjectName(device, slot.cmd_buffers[i], "CommandPool: Command Buffer {}", i);
         }
     }
 }
 
 vk::CommandBuffer CommandPool::Commit() {
-    const std::size_t index = CommitResource();
-    return cmd_buffers[index];
+    const u64 tick = master_semaphore->CurrentTick();
+    TickPool& slot = ring[tick % RingDepth];
+    if (slot.tick != tick) {
+        // The ring wrapped back into this slot: everything recorded against
+        // its previous tick must have retired before its buffers can be
+        // recycled with one bulk reset.
+        if (master_semaphore->KnownGpuTick() < slot.tick) {
+            master_semaphore->Refresh();
+            if (master_semaphore->KnownGpuTick() < slot.tick) {
+                master_semaphore->Wait(slot.tick);
+            }
+        }
+        instance.GetDevice().resetCommandPool(*slot.pool);
+        slot.used = 0;
+        slot.tick = tick;
+    }
+    if (slot.used == slot.cmd_buffers.size()) {
+        Grow(slot);
+    }
+    return slot.cmd_buffers[slot.used++];
 }
 
 constexpr u32 DESCRIPTOR_SET_BATCH = 32;
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <vector>
 #include <tsl/robin_map.h>
 
@@ -47,19 +48,35 @@ protected:
     std::vector<u64> ticks;        ///< Ticks for each resource
 };
 
-class CommandPool final : public ResourcePool {
+/**
+ * Ring of command pools indexed by submission tick. Each slot owns one Vulkan
+ * command pool whose buffers are recycled with a single bulk reset once the
+ * tick that recorded them has retired, so acquisition never scans for a free
+ * slot and never resets buffers individually.
+ */
+class CommandPool final {
 public:
     explicit CommandPool(const Instance& instance, MasterSemaphore* master_semaphore);
-    ~CommandPool() override;
-
-    void Allocate(std::size_t begin, std::size_t end) override;
+    ~CommandPool();
 
     vk::CommandBuffer Commit();
 
 private:
+    struct TickPool {
+        vk::UniqueCommandPool pool;
+        std::vector<vk::CommandBuffer> cmd_buffers;
+        std::size_t used = 0; ///< Buffers handed out since the last bulk reset
+        u64 tick = 0;         ///< Tick the pool was last committed against
+    };
+
+    /// Grows the slot's buffer array by one allocation batch.
+    void Grow(TickPool& slot);
+
+    static constexpr std::size_t RingDepth = 8;
+
     const Instance& instance;
-    vk::UniqueCommandPool cmd_pool;
-    std::vector<vk::CommandBuffer> cmd_buffers;
+    MasterSemaphore* master_semaphore;
+    std::array<TickPool, RingDepth> ring;
 };
 
 class DescriptorHeap final : public ResourcePool {
@@ -1,16 +1,64 @@
 // SPDX-FileCopyrightText: Copyright 2019 yuzu Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <algorithm>
 #include <mutex>
+#include <xxhash.h>
 #include "common/debug.h"
 #include "video_core/renderer_vulkan/vk_instance.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 
 namespace Vulkan {
 
+namespace {
+
+/// Returns true when the open rendering scope already covers the incoming state:
+/// every attachment targets the same view and the incoming pass loads the
+/// contents the open pass stores. Continuing the scope instead of restarting it
+/// spares tile-based GPUs a full load/store cycle per draw group.
+bool CanContinueRendering(const RenderState& open, const RenderState& next) {
+    if (open.num_color_attachments != next.num_color_attachments ||
+        open.num_depth_attachments != next.num_depth_attachments || open.width != next.width ||
+        open.height != next.height) {
+        return false;
+    }
+    const auto covered = [](const vk::RenderingAttachmentInfo& open_att,
+                            const vk::RenderingAttachmentInfo& next_att) {
+        return open_att.imageView == next_att.imageView &&
+               open_att.imageLayout == next_att.imageLayout &&
+               next_att.loadOp == vk::AttachmentLoadOp::eLoad &&
+               open_att.storeOp == vk::AttachmentStoreOp::eStore;
+    };
+    for (u32 i = 0; i < open.num_color_attachments; ++i) {
+        if (!covered(open.color_attachments[i], next.color_attachments[i])) {
+            return false;
+        }
+    }
+    if (open.num_depth_attachments != 0 && !covered(open.depth_attachment, next.depth_attachment)) {
+        return false;
+    }
+    return true;
+}
+
+} // Anonymous namespace
+
 Scheduler::Scheduler(const Instance& instance)
     : instance{instance}, master_semaphore{instance}, command_pool{instance, &master_semaphore} {
     profiler_scope = reinterpret_cast<tracy::VkCtxScope*>(std::malloc(sizeof(tracy::VkCtxScope)));
+
+    const auto& limits = instance.GetPhysicalDevice().getProperties().limits;
+    timing_supported = limits.timestampComputeAndGraphics != 0;
+    timestamp_period = limits.timestampPeriod;
+    if (timing_supported) {
+        const vk::QueryPoolCreateInfo pool_ci = {
+            .queryType = vk::QueryType::eTimestamp,
+            .queryCount = MaxGpuScopes * 2,
+        };
+        for (auto& slot : timing_ring) {
+            slot.pool = instance.GetDevice().createQueryPoolUnique(pool_ci);
+        }
+    }
+
     AllocateWorkerCommandBuffers();
 }
 
@@ -18,14 +66,52 @@ Scheduler::~Scheduler() {
     std::free(profiler_scope);
 }
 
+void Scheduler::BatchImageBarrier(const vk::ImageMemoryBarrier& barrier,
+                                  vk::PipelineStageFlags src_stage,
+                                  vk::PipelineStageFlags dst_stage) {
+    // Two queued transitions of the same image must not be merged into one
+    // dependency; issue the pending batch first to keep them ordered.
+    const auto same_image = [&barrier](const vk::ImageMemoryBarrier& pending) {
+        return pending.image == barrier.image;
+    };
+    if (std::ranges::any_of(batched_image_barriers, same_image)) {
+        FlushImageBarriers();
+    }
+    batched_image_barriers.push_back(barrier);
+    batched_src_stages |= src_stage;
+    batched_dst_stages |= dst_stage;
+}
+
+void Scheduler::FlushImageBarriers() {
+    if (batched_image_barriers.empty()) {
+        return;
+    }
+    EndRendering();
+    current_cmdbuf.pipelineBarrier(batched_src_stages, batched_dst_stages,
+                                   vk::DependencyFlagBits::eByRegion, {}, {},
+                                   batched_image_barriers);
+    batched_image_barriers.clear();
+    batched_src_stages = {};
+    batched_dst_stages = {};
+}
+
 void Scheduler::BeginRendering(const RenderState& new_state) {
-    if (is_rendering && render_state == new_state) {
+    FlushImageBarriers();
+    // Keep the scope open for identical state and for state that only re-loads
+    // what the open pass renders; clears or retargeted attachments still force
+    // a restart.
+    if (is_rendering &&
+        (render_state == new_state || CanContinueRendering(render_state, new_state))) {
         return;
     }
     EndRendering();
     is_rendering = true;
     render_state = new_state;
 
+    // Key pass timings on the attachment set so every distinct target
+    // combination shows up as its own row in the aggregated timings.
+    BeginGpuScope("pass", XXH3_64bits(&render_state, sizeof(render_state)));
+
     const vk::RenderingInfo rendering_info = {
         .renderArea =
             {
@@ -48,6 +134,63 @@ void Scheduler::EndRendering() {
     }
     is_rendering = false;
     current_cmdbuf.endRendering();
+    EndGpuScope();
+}
+
+void Scheduler::BeginGpuScope(const char* name, u64 key) {
+    if (!timing_supported || open_scope >= 0 || current_timing->used == MaxGpuScopes) {
+        return;
+    }
+    open_scope = static_cast<s32>(current_timing->used++);
+    current_timing->records[open_scope] = {name, key};
+    current_cmdbuf.writeTimestamp(vk::PipelineStageFlagBits::eTopOfPipe, *current_timing->pool,
+                                  open_scope * 2);
+}
+
+void Scheduler::EndGpuScope() {
+    if (open_scope < 0) {
+        return;
+    }
+    current_cmdbuf.writeTimestamp(vk::PipelineStageFlagBits::eBottomOfPipe, *current_timing->pool,
+                                  open_scope * 2 + 1);
+    current_timing->needs_readback = true;
+    open_scope = -1;
+}
+
+void Scheduler::ReadbackGpuScopes(TimingSlot& slot) {
+    slot.needs_readback = false;
+    std::array<u64, MaxGpuScopes * 2> timestamps;
+    const vk::Result result = instance.GetDevice().getQueryPoolResults(
+        *slot.pool, 0, slot.used * 2, slot.used * 2 * sizeof(u64), timestamps.data(), sizeof(u64),
+        vk::QueryResultFlagBits::e64);
+    if (result != vk::Result::eSuccess) {
+        return;
+    }
+    std::scoped_lock lock{gpu_stats_mutex};
+    for (u32 i = 0; i < slot.used; ++i) {
+        const u64 begin = timestamps[i * 2];
+        const u64 end = timestamps[i * 2 + 1];
+        if (end <= begin) {
+            continue;
+        }
+        const GpuScopeRecord& record = slot.records[i];
+        auto& stat = gpu_stats[record.key];
+        stat.name = record.name;
+        stat.key = record.key;
+        stat.total_ns += static_cast<u64>((end - begin) * timestamp_period);
+        stat.samples++;
+    }
+}
+
+std::vector<Scheduler::GpuScopeStat> Scheduler::TakeGpuTimings() {
+    std::scoped_lock lock{gpu_stats_mutex};
+    std::vector<GpuScopeStat> timings;
+    timings.reserve(gpu_stats.size());
+    for (const auto& [key, stat] : gpu_stats) {
+        timings.push_back(stat);
+    }
+    gpu_stats.clear();
+    return timings;
 }
 
 void Scheduler::Flush(vk::Semaphore signal, vk::Semaphore wait) {
@@ -55,6 +198,11 @@ void Scheduler::Flush(vk::Semaphore signal, vk::Semaphore wait) {
     SubmitExecution(signal, wait);
 }
 
+void Scheduler::SignalFence(std::function<void()>&& fence) {
+    master_semaphore.RegisterEopSignal(CurrentTick(), std::move(fence));
+    Flush();
+}
+
 void Scheduler::Finish(vk::Semaphore signal, vk::Semaphore wait) {
     // When finishing, we need to wait for the submission to have executed on the device.
     const u64 presubmit_tick = CurrentTick();
@@ -62,12 +210,31 @@ void Scheduler::Finish(vk::Semaphore signal, vk::Semaphore wait) {
     Wait(presubmit_tick);
 }
 
+void Scheduler::WaitExternal(vk::Semaphore semaphore, u64 value) {
+    // All external waits currently come from the same upload timeline, so keeping
+    // the largest requested value is enough to cover every pending upload.
+    if (semaphore == external_wait_semaphore) {
+        external_wait_value = std::max(external_wait_value, value);
+    } else {
+        external_wait_semaphore = semaphore;
+        external_wait_value = value;
+    }
+}
+
 void Scheduler::Wait(u64 tick) {
     if (tick >= master_semaphore.CurrentTick()) {
         // Make sure we are not waiting for the current tick without signalling
         Flush();
     }
     master_semaphore.Wait(tick);
+    ProcessDeferredOperations();
+}
+
+void Scheduler::ProcessDeferredOperations() {
+    while (!pending_ops.empty() && master_semaphore.IsFree(pending_ops.front().gpu_tick)) {
+        pending_ops.front().callback();
+        pending_ops.pop();
+    }
 }
 
 void Scheduler::AllocateWorkerCommandBuffers() {
@@ -78,6 +245,19 @@ void Scheduler::AllocateWorkerCommandBuffers() {
     current_cmdbuf = command_pool.Commit();
     current_cmdbuf.begin(begin_info);
 
+    if (timing_supported) {
+        TimingSlot& slot = timing_ring[CurrentTick() % TimingRingDepth];
+        if (slot.needs_readback) {
+            // The command pool commit above already waited for this tick's slot
+            // to retire, so the results are available without a stall.
+            ReadbackGpuScopes(slot);
+        }
+        current_cmdbuf.resetQueryPool(*slot.pool, 0, MaxGpuScopes * 2);
+        slot.used = 0;
+        current_timing = &slot;
+        open_scope = -1;
+    }
+
     auto* profiler_ctx = instance.GetProfilerContext();
     if (profiler_ctx) {
         static const auto scope_loc =
@@ -96,9 +276,17 @@ void Scheduler::SubmitExecution(vk::Semaphore signal_semaphore, vk::Semaphore wa
         TracyVkCollect(profiler_ctx, current_cmdbuf);
     }
 
+    FlushImageBarriers();
     EndRendering();
-    master_semaphore.SubmitWork(current_cmdbuf, wait_semaphore, signal_semaphore, signal_value);
+    // Close any timing scope still open so every begun query pair is written
+    // before the buffer is submitted.
+    EndGpuScope();
+    master_semaphore.SubmitWork(current_cmdbuf, wait_semaphore, signal_semaphore, signal_value,
+                                external_wait_semaphore, external_wait_value);
+    external_wait_semaphore = nullptr;
+    external_wait_value = 0;
     master_semaphore.Refresh();
+    ProcessDeferredOperations();
     AllocateWorkerCommandBuffers();
 }
 
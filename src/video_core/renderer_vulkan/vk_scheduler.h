@@ -4,7 +4,12 @@
 #pragma once
 
 #include <condition_variable>
+#include <functional>
+#include <queue>
+#include <vector>
+#include <boost/container/small_vector.hpp>
 #include <boost/container/static_vector.hpp>
+#include <tsl/robin_map.h>
 #include "common/types.h"
 #include "video_core/renderer_vulkan/vk_master_semaphore.h"
 #include "video_core/renderer_vulkan/vk_resource_pool.h"
@@ -34,12 +39,20 @@ public:
     /// Sends the current execution context to the GPU.
     void Flush(vk::Semaphore signal = nullptr, vk::Semaphore wait = nullptr);
 
+    /// Flushes pending work and invokes the callback once the GPU has executed
+    /// it, without blocking the caller or draining the queue.
+    void SignalFence(std::function<void()>&& fence);
+
     /// Sends the current execution context to the GPU and waits for it to complete.
     void Finish(vk::Semaphore signal = nullptr, vk::Semaphore wait = nullptr);
 
     /// Waits for the given tick to trigger on the GPU.
     void Wait(u64 tick);
 
+    /// Makes the next submission wait for the provided timeline semaphore value,
+    /// used to order draws against out-of-band transfer queue uploads.
+    void WaitExternal(vk::Semaphore semaphore, u64 value);
+
     /// Starts a new rendering scope with provided state.
     void BeginRendering(const RenderState& new_state);
 
@@ -51,11 +64,40 @@ public:
         return render_state;
     }
 
-    /// Returns the current command buffer.
-    vk::CommandBuffer CommandBuffer() const {
+    /// GPU time attributed to one timing scope key since the last take.
+    struct GpuScopeStat {
+        const char* name = nullptr;
+        u64 key = 0;
+        u64 total_ns = 0;
+        u64 samples = 0;
+    };
+
+    /// Opens a timestamp-bracketed timing scope on the current command buffer.
+    /// Scopes do not nest; a begin while one is open is ignored, as is any
+    /// scope past the per-submission query budget.
+    void BeginGpuScope(const char* name, u64 key);
+
+    /// Closes the open timing scope, if any.
+    void EndGpuScope();
+
+    /// Returns the GPU times accumulated per scope key and resets them.
+    std::vector<GpuScopeStat> TakeGpuTimings();
+
+    /// Returns the current command buffer, flushing any queued image transitions
+    /// so commands recorded on it observe them.
+    vk::CommandBuffer CommandBuffer() {
+        FlushImageBarriers();
         return current_cmdbuf;
     }
 
+    /// Queues an image layout/access transition. Transitions accumulate until the
+    /// next command is recorded and are then issued as a single barrier command.
+    void BatchImageBarrier(const vk::ImageMemoryBarrier& barrier, vk::PipelineStageFlags src_stage,
+                           vk::PipelineStageFlags dst_stage);
+
+    /// Flushes queued image transitions into one vkCmdPipelineBarrier.
+    void FlushImageBarriers();
+
     /// Returns the current command buffer tick.
     [[nodiscard]] u64 CurrentTick() const noexcept {
         return master_semaphore.CurrentTick();
@@ -71,6 +113,12 @@ public:
         return &master_semaphore;
     }
 
+    /// Defers an operation until the current tick has been reached by the GPU.
+    template <typename Func>
+    void DeferOperation(Func&& func) {
+        pending_ops.emplace(std::forward<Func>(func), CurrentTick());
+    }
+
     std::mutex submit_mutex;
 
 private:
@@ -78,15 +126,56 @@ private:
 
     void SubmitExecution(vk::Semaphore signal_semaphore, vk::Semaphore wait_semaphore);
 
+    /// Runs all deferred operations whose tick the GPU has passed.
+    void ProcessDeferredOperations();
+
+    /// Reads back the retired slot's queries and folds them into the stats.
+    void ReadbackGpuScopes(struct TimingSlot& slot);
+
 private:
+    struct PendingOp {
+        std::function<void()> callback;
+        u64 gpu_tick;
+    };
+
+    static constexpr u32 MaxGpuScopes = 128; ///< Timestamp pairs per submission
+
+    struct GpuScopeRecord {
+        const char* name;
+        u64 key;
+    };
+
+    /// One query pool per in-flight submission, reused on the same cadence as
+    /// the command pool ring so results are always retired before reuse.
+    struct TimingSlot {
+        vk::UniqueQueryPool pool;
+        std::array<GpuScopeRecord, MaxGpuScopes> records;
+        u32 used = 0;
+        bool needs_readback = false;
+    };
+    static constexpr u32 TimingRingDepth = 8;
+
     const Instance& instance;
     MasterSemaphore master_semaphore;
     CommandPool command_pool;
     vk::CommandBuffer current_cmdbuf;
+    vk::Semaphore external_wait_semaphore{};
+    u64 external_wait_value{};
+    std::queue<PendingOp> pending_ops;
+    boost::container::small_vector<vk::ImageMemoryBarrier, 8> batched_image_barriers;
+    vk::PipelineStageFlags batched_src_stages{};
+    vk::PipelineStageFlags batched_dst_stages{};
     std::condition_variable_any event_cv;
     RenderState render_state;
     bool is_rendering = false;
     tracy::VkCtxScope* profiler_scope{};
+    std::array<TimingSlot, TimingRingDepth> timing_ring;
+    TimingSlot* current_timing{};
+    s32 open_scope = -1;
+    f32 timestamp_period{};
+    bool timing_supported{};
+    std::mutex gpu_stats_mutex;
+    tsl::robin_map<u64, GpuScopeStat> gpu_stats;
 };
 
 } // namespace Vulkan
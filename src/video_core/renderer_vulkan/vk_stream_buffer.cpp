@@ -41,21 +41,38 @@ vk::MemoryPropertyFlags MakePropertyFlags(BufferType type) {
     }
 }
 
+// Minimum heap size before a host-visible device-local heap is assumed to come from a
+// resizable BAR rather than the classic 256 MiB BAR window.
+constexpr vk::DeviceSize ReBarMinHeapSize = 256_MB;
+
 static std::optional<u32> FindMemoryType(const vk::PhysicalDeviceMemoryProperties& properties,
-                                         vk::MemoryPropertyFlags wanted) {
+                                         vk::MemoryPropertyFlags wanted, u64 size) {
+    std::optional<u32> best;
+    s32 best_score = -1;
     for (u32 i = 0; i < properties.memoryTypeCount; ++i) {
         const auto flags = properties.memoryTypes[i].propertyFlags;
-        if ((flags & wanted) == wanted) {
-            return i;
+        if ((flags & wanted) != wanted) {
+            continue;
+        }
+        // Prefer writing directly into VRAM when the device exposes a resizable BAR
+        // heap large enough for the buffer; it saves the later copy on the GPU.
+        const auto& heap = properties.memoryHeaps[properties.memoryTypes[i].heapIndex];
+        const bool direct_vram = (flags & vk::MemoryPropertyFlagBits::eDeviceLocal) &&
+                                 heap.size >= ReBarMinHeapSize && size <= heap.size / 2;
+        const s32 score = direct_vram ? 1 : 0;
+        if (score > best_score) {
+            best_score = score;
+            best = i;
         }
     }
-    return std::nullopt;
+    return best;
 }
 
 /// Get the preferred host visible memory type.
-u32 GetMemoryType(const vk::PhysicalDeviceMemoryProperties& properties, BufferType type) {
+u32 GetMemoryType(const vk::PhysicalDeviceMemoryProperties& properties, BufferType type,
+                  u64 size) {
     vk::MemoryPropertyFlags flags = MakePropertyFlags(type);
-    std::optional preferred_type = FindMemoryType(properties, flags);
+    std::optional preferred_type = FindMemoryType(properties, flags, size);
 
     constexpr std::array remove_flags = {
         vk::MemoryPropertyFlagBits::eHostCached,
@@ -64,7 +81,7 @@ u32 GetMemoryType(const vk::PhysicalDeviceMemoryProperties& properties, BufferTy
 
     for (u32 i = 0; i < remove_flags.size() && !preferred_type; i++) {
         flags &= ~remove_flags[i];
-        preferred_type = FindMemoryType(properties, flags);
+        preferred_type = FindMemoryType(properties, flags, size);
     }
     ASSERT_MSG(preferred_type, "No suitable memory type found");
     return preferred_type.value();
@@ -73,6 +90,13 @@ u32 GetMemoryType(const vk::PhysicalDeviceMemoryProperties& properties, BufferTy
 constexpr u64 WATCHES_INITIAL_RESERVE = 0x4000;
 constexpr u64 WATCHES_RESERVE_CHUNK = 0x1000;
 
+// Number of stalled wraps within one instrumentation window after which the
+// ring is grown instead of waiting on in-flight regions again.
+constexpr u64 StallGrowThreshold = 8;
+// Wraps per instrumentation window; the high-water mark and stall counter are
+// reported and the stall window restarted at this cadence.
+constexpr u64 WrapReportInterval = 64;
+
 } // Anonymous namespace
 
 StreamBuffer::StreamBuffer(const Instance& instance_, Scheduler& scheduler_,
@@ -104,16 +128,44 @@ std::tuple<u8*, u64, bool> StreamBuffer::Map(u64 size, u64 alignment) {
 
     bool invalidate{false};
     if (offset + size > stream_buffer_size) {
-        // The buffer would overflow, save the amount of used watches and reset the state.
         invalidate = true;
-        invalidation_mark = current_watch_cursor;
-        current_watch_cursor = 0;
-        offset = 0;
-
-        // Swap watches and reset waiting cursors.
-        std::swap(previous_watches, current_watches);
-        wait_cursor = 0;
-        wait_bound = 0;
+        wrap_count++;
+        high_water_mark = std::max(high_water_mark, cycle_committed);
+        cycle_committed = 0;
+
+        if (stall_count >= StallGrowThreshold && !growth_exhausted) {
+            // The ring keeps running into in-flight regions; grow it so the
+            // streaming spike absorbs into memory instead of stalling the
+            // recorder. The fresh allocation has nothing in flight, so every
+            // watch and waiting cursor resets. Offsets handed out before this
+            // point have all been consumed already, as callers bind or copy
+            // right after Commit and never hold one across a Map.
+            const u64 old_size = stream_buffer_size;
+            GrowBuffer(old_size * 2);
+            growth_exhausted = stream_buffer_size <= old_size;
+            stall_count = 0;
+            current_watch_cursor = 0;
+            invalidation_mark.reset();
+            offset = 0;
+            wait_cursor = 0;
+            wait_bound = 0;
+        } else {
+            // The buffer would overflow, save the amount of used watches and reset the state.
+            invalidation_mark = current_watch_cursor;
+            current_watch_cursor = 0;
+            offset = 0;
+
+            // Swap watches and reset waiting cursors.
+            std::swap(previous_watches, current_watches);
+            wait_cursor = 0;
+            wait_bound = 0;
+        }
+
+        if (wrap_count % WrapReportInterval == 0) {
+            LOG_DEBUG(Render_Vulkan, "{} ring wrapped {} times, high water {} KiB, {} stalls",
+                      BufferTypeName(type), wrap_count, high_water_mark / 1024, stall_count);
+            stall_count = 0;
+        }
     }
 
     const u64 mapped_upper_bound = offset + size;
@@ -143,6 +195,7 @@ void StreamBuffer::Commit(u64 size) {
     }
 
     offset += size;
+    cycle_committed += size;
 
     if (current_watch_cursor + 1 >= current_watches.size()) {
         // Ensure that there are enough watches.
@@ -156,7 +209,7 @@ void StreamBuffer::Commit(u64 size) {
 void StreamBuffer::CreateBuffers(u64 prefered_size) {
     const vk::Device device = instance.GetDevice();
     const auto memory_properties = instance.GetPhysicalDevice().getMemoryProperties();
-    const u32 preferred_type = GetMemoryType(memory_properties, type);
+    const u32 preferred_type = GetMemoryType(memory_properties, type, prefered_size);
     const vk::MemoryType mem_type = memory_properties.memoryTypes[preferred_type];
     const u32 preferred_heap = mem_type.heapIndex;
     is_coherent =
@@ -181,8 +234,8 @@ void StreamBuffer::CreateBuffers(u64 prefered_size) {
 
     stream_buffer_size = static_cast<u64>(requirements.memoryRequirements.size);
 
-    LOG_INFO(Render_Vulkan, "Creating {} buffer with size {} KiB with flags {}",
-             BufferTypeName(type), stream_buffer_size / 1024,
+    LOG_INFO(Render_Vulkan, "Creating {} buffer with size {} KiB on heap {} ({} MiB) with flags {}",
+             BufferTypeName(type), stream_buffer_size / 1024, preferred_heap, heap_size >> 20,
              vk::to_string(mem_type.propertyFlags));
 
     if (dedicated_requirements.prefersDedicatedAllocation) {
@@ -215,6 +268,19 @@ void StreamBuffer::CreateBuffers(u64 prefered_size) {
     }
 }
 
+void StreamBuffer::GrowBuffer(u64 new_size) {
+    // Previously recorded commands still reference the old handle, so its
+    // destruction waits until the GPU has caught up with the current tick.
+    scheduler.DeferOperation([device = device, buffer = buffer, memory = memory] {
+        device.unmapMemory(memory);
+        device.destroyBuffer(buffer);
+        device.freeMemory(memory);
+    });
+    LOG_INFO(Render_Vulkan, "{} buffer stalling on wrap, growing from {} KiB to {} KiB",
+             BufferTypeName(type), stream_buffer_size / 1024, new_size / 1024);
+    CreateBuffers(new_size);
+}
+
 void StreamBuffer::ReserveWatches(std::vector<Watch>& watches, std::size_t grow_size) {
     watches.resize(watches.size() + grow_size);
 }
@@ -226,6 +292,9 @@ void StreamBuffer::WaitPendingOperations(u64 requested_upper_bound) {
     while (requested_upper_bound > wait_bound && wait_cursor < *invalidation_mark) {
         auto& watch = previous_watches[wait_cursor];
         wait_bound = watch.upper_bound;
+        if (!scheduler.GetMasterSemaphore()->IsFree(watch.tick)) {
+            ++stall_count;
+        }
         scheduler.Wait(watch.tick);
         ++wait_cursor;
     }
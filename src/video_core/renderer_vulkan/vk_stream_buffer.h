@@ -56,6 +56,10 @@ private:
     /// Creates Vulkan buffer handles committing the required the required memory.
     void CreateBuffers(u64 prefered_size);
 
+    /// Replaces the backing allocation with a larger one, retiring the old
+    /// buffer once the GPU has caught up with commands that reference it.
+    void GrowBuffer(u64 new_size);
+
     /// Increases the amount of watches available.
     void ReserveWatches(std::vector<Watch>& watches, std::size_t grow_size);
 
@@ -84,6 +88,12 @@ private:
     std::vector<Watch> previous_watches; ///< Watches used in the previous iteration.
     std::size_t wait_cursor{};           ///< Last watch being waited for completion.
     u64 wait_bound{};                    ///< Highest offset being watched for completion.
+
+    u64 wrap_count{};        ///< Times the ring wrapped back to offset zero.
+    u64 stall_count{};       ///< Waits on in-flight regions in the current window.
+    u64 cycle_committed{};   ///< Bytes committed since the last wrap.
+    u64 high_water_mark{};   ///< Largest per-cycle usage observed so far.
+    bool growth_exhausted{}; ///< True once the heap clamp stopped further growth.
 };
 
 } // namespace Vulkan
@@ -2,8 +2,11 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include <algorithm>
+#include <bit>
+#include <chrono>
 #include <limits>
 #include "common/assert.h"
+#include "common/config.h"
 #include "common/logging/log.h"
 #include "sdl_window.h"
 #include "video_core/renderer_vulkan/vk_instance.h"
@@ -11,13 +14,39 @@
 
 namespace Vulkan {
 
+static vk::PresentModeKHR ConfiguredPresentMode() {
+    const std::string mode = Config::vkPresentMode();
+    if (mode == "mailbox") {
+        return vk::PresentModeKHR::eMailbox;
+    }
+    if (mode == "immediate") {
+        return vk::PresentModeKHR::eImmediate;
+    }
+    // "auto" starts on FIFO until the frame statistics justify switching.
+    return vk::PresentModeKHR::eFifo;
+}
+
 Swapchain::Swapchain(const Instance& instance_, const Frontend::WindowSDL& window)
-    : instance{instance_}, surface{CreateSurface(instance.GetInstance(), window)} {
+    : instance{instance_} {
+    if (Config::headlessMode()) {
+        // No surface or swapchain; frames stay in the offscreen ring and Present
+        // is skipped entirely. Only the properties other code queries are set.
+        width = window.getWidth();
+        height = window.getHeight();
+        surface_format = {vk::Format::eB8G8R8A8Unorm, vk::ColorSpaceKHR::eSrgbNonlinear};
+        image_count = 3;
+        return;
+    }
+    surface = CreateSurface(instance.GetInstance(), window);
+    wanted_mode = ConfiguredPresentMode();
     FindPresentFormat();
     Create(window.getWidth(), window.getHeight(), surface);
 }
 
 Swapchain::~Swapchain() {
+    if (!surface) {
+        return;
+    }
     Destroy();
     instance.GetInstance().destroySurfaceKHR(surface);
 }
@@ -28,9 +57,12 @@ void Swapchain::Create(u32 width_, u32 height_, vk::SurfaceKHR surface_) {
     surface = surface_;
     needs_recreation = false;
 
-    Destroy();
+    // Pass the previous swapchain as oldSwapchain so in-flight presents retire
+    // naturally instead of stalling the queue during recreation.
+    const vk::SwapchainKHR old_swapchain = swapchain;
 
     SetSurfaceProperties();
+    present_mode = SelectPresentMode();
 
     const std::array queue_family_indices = {
         instance.GetGraphicsQueueFamilyIndex(),
@@ -55,9 +87,9 @@ void Swapchain::Create(u32 width_, u32 height_, vk::SurfaceKHR surface_) {
         .pQueueFamilyIndices = queue_family_indices.data(),
         .preTransform = transform,
         .compositeAlpha = composite_alpha,
-        .presentMode = vk::PresentModeKHR::eFifo,
+        .presentMode = present_mode,
         .clipped = true,
-        .oldSwapchain = nullptr,
+        .oldSwapchain = old_swapchain,
     };
 
     try {
@@ -66,12 +98,21 @@ void Swapchain::Create(u32 width_, u32 height_, vk::SurfaceKHR surface_) {
         LOG_CRITICAL(Render_Vulkan, "{}", err.what());
         UNREACHABLE();
     }
+    if (old_swapchain) {
+        instance.GetDevice().destroySwapchainKHR(old_swapchain);
+    }
 
     SetupImages();
     RefreshSemaphores();
+    frame_index = 0;
+    image_index = 0;
 }
 
 bool Swapchain::AcquireNextImage() {
+    if (needs_recreation) {
+        Create(width, height, surface);
+    }
+
     vk::Device device = instance.GetDevice();
     vk::Result result =
         device.acquireNextImageKHR(swapchain, std::numeric_limits<u64>::max(),
@@ -108,6 +149,7 @@ void Swapchain::Present() {
         .pImageIndices = &image_index,
     };
 
+    const auto start = std::chrono::steady_clock::now();
     try {
         [[maybe_unused]] vk::Result result = instance.GetPresentQueue().presentKHR(present_info);
     } catch (vk::OutOfDateKHRError&) {
@@ -117,9 +159,42 @@ void Swapchain::Present() {
         UNREACHABLE();
     }
 
+    // The time spent inside vkQueuePresentKHR is where FIFO back-pressure shows
+    // up, making it a good proxy for presentation latency.
+    const u64 elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+    const size_t bucket =
+        std::min<size_t>(NumLatencyBuckets - 1, std::bit_width(elapsed_us / 1000));
+    present_latency[bucket]++;
+    present_latency_total_us += elapsed_us;
+    present_latency_count++;
+
     frame_index = (frame_index + 1) % image_count;
 }
 
+void Swapchain::SetPresentMode(vk::PresentModeKHR mode) {
+    if (mode == wanted_mode) {
+        return;
+    }
+    LOG_INFO(Render_Vulkan, "Switching present mode from {} to {}", vk::to_string(wanted_mode),
+             vk::to_string(mode));
+    wanted_mode = mode;
+    needs_recreation = true;
+}
+
+Swapchain::PresentLatencyStats Swapchain::TakePresentLatencyStats() {
+    PresentLatencyStats stats{
+        .histogram = present_latency,
+        .total_us = present_latency_total_us,
+        .count = present_latency_count,
+    };
+    present_latency.fill(0);
+    present_latency_total_us = 0;
+    present_latency_count = 0;
+    return stats;
+}
+
 void Swapchain::FindPresentFormat() {
     const auto formats = instance.GetPhysicalDevice().getSurfaceFormatsKHR(surface);
 
@@ -146,6 +221,15 @@ void Swapchain::FindPresentFormat() {
     UNREACHABLE_MSG("Unable to find required swapchain format!");
 }
 
+vk::PresentModeKHR Swapchain::SelectPresentMode() const {
+    const auto modes = instance.GetPhysicalDevice().getSurfacePresentModesKHR(surface);
+    if (std::ranges::find(modes, wanted_mode) != modes.end()) {
+        return wanted_mode;
+    }
+    // FIFO is the only mode the specification guarantees.
+    return vk::PresentModeKHR::eFifo;
+}
+
 void Swapchain::SetSurfaceProperties() {
     const vk::SurfaceCapabilitiesKHR capabilities =
         instance.GetPhysicalDevice().getSurfaceCapabilitiesKHR(surface);
@@ -192,6 +276,12 @@ void Swapchain::Destroy() {
 
 void Swapchain::RefreshSemaphores() {
     const vk::Device device = instance.GetDevice();
+    for (vk::Semaphore semaphore : image_acquired) {
+        device.destroySemaphore(semaphore);
+    }
+    for (vk::Semaphore semaphore : present_ready) {
+        device.destroySemaphore(semaphore);
+    }
     image_acquired.resize(image_count);
     present_ready.resize(image_count);
 
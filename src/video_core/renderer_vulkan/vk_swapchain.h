@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <array>
 #include <mutex>
 #include <vector>
 #include "common/types.h"
@@ -31,6 +32,26 @@ public:
     /// Presents the current image and move to the next one
     void Present();
 
+    /// Requests a new present mode; the swapchain is recreated lazily on the
+    /// next image acquire so the switch never stalls presentation.
+    void SetPresentMode(vk::PresentModeKHR mode);
+
+    static constexpr size_t NumLatencyBuckets = 6;
+
+    /// Histogram and running sum of the time spent in vkQueuePresentKHR.
+    struct PresentLatencyStats {
+        std::array<u64, NumLatencyBuckets> histogram{};
+        u64 total_us{};
+        u64 count{};
+    };
+
+    /// Returns the latency statistics accumulated since the last call and resets them.
+    PresentLatencyStats TakePresentLatencyStats();
+
+    vk::PresentModeKHR GetPresentMode() const {
+        return present_mode;
+    }
+
     vk::SurfaceKHR GetSurface() const {
         return surface;
     }
@@ -79,6 +100,9 @@ private:
     /// Selects the best available swapchain image format
     void FindPresentFormat();
 
+    /// Returns the wanted present mode when the surface supports it, FIFO otherwise
+    vk::PresentModeKHR SelectPresentMode() const;
+
     /// Sets the surface properties according to device capabilities
     void SetSurfaceProperties();
 
@@ -99,6 +123,11 @@ private:
     vk::Extent2D extent;
     vk::SurfaceTransformFlagBitsKHR transform;
     vk::CompositeAlphaFlagBitsKHR composite_alpha;
+    vk::PresentModeKHR present_mode = vk::PresentModeKHR::eFifo;
+    vk::PresentModeKHR wanted_mode = vk::PresentModeKHR::eFifo;
+    std::array<u64, NumLatencyBuckets> present_latency{};
+    u64 present_latency_total_us = 0;
+    u64 present_latency_count = 0;
     std::vector<vk::Image> images;
     std::vector<vk::Semaphore> image_acquired;
     std::vector<vk::Semaphore> present_ready;
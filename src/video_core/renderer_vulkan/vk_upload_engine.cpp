@@ -0,0 +1,209 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+#include "common/alignment.h"
+#include "common/assert.h"
+#include "common/config.h"
+#include "video_core/renderer_vulkan/vk_instance.h"
+#include "video_core/renderer_vulkan/vk_upload_engine.h"
+
+#include <vk_mem_alloc.h>
+
+namespace Vulkan {
+
+constexpr u64 WAIT_TIMEOUT = std::numeric_limits<u64>::max();
+
+UploadEngine::UploadEngine(const Instance& instance_, u64 staging_size)
+    : instance{instance_}, buffer_size{staging_size} {
+    if (!instance.HasTransferQueue()) {
+        return;
+    }
+    queue = instance.GetTransferQueue();
+
+    const auto device = instance.GetDevice();
+    cmd_pool = device.createCommandPoolUnique({
+        .flags = vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
+        .queueFamilyIndex = instance.GetTransferQueueFamilyIndex(),
+    });
+    const vk::CommandBufferAllocateInfo alloc_info = {
+        .commandPool = *cmd_pool,
+        .level = vk::CommandBufferLevel::ePrimary,
+        .commandBufferCount = static_cast<u32>(cmdbufs.size()),
+    };
+    const auto result = device.allocateCommandBuffers(&alloc_info, cmdbufs.data());
+    ASSERT_MSG(result == vk::Result::eSuccess, "Failed to allocate transfer command buffers: {}",
+               vk::to_string(result));
+
+    const vk::StructureChain semaphore_chain = {
+        vk::SemaphoreCreateInfo{},
+        vk::SemaphoreTypeCreateInfo{
+            .semaphoreType = vk::SemaphoreType::eTimeline,
+            .initialValue = 0,
+        },
+    };
+    semaphore = device.createSemaphoreUnique(semaphore_chain.get());
+
+    const vk::BufferCreateInfo buffer_ci = {
+        .size = buffer_size,
+        .usage = vk::BufferUsageFlagBits::eTransferSrc,
+    };
+    const VmaAllocationCreateInfo alloc_ci = {
+        .flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT |
+                 VMA_ALLOCATION_CREATE_MAPPED_BIT,
+        .usage = VMA_MEMORY_USAGE_AUTO_PREFER_HOST,
+        .requiredFlags = 0,
+        .preferredFlags = 0,
+        .pool = VK_NULL_HANDLE,
+        .pUserData = nullptr,
+    };
+    const VkBufferCreateInfo buffer_ci_unsafe = static_cast<VkBufferCreateInfo>(buffer_ci);
+    VkBuffer unsafe_buffer{};
+    VmaAllocationInfo allocation_info{};
+    const VkResult buffer_result =
+        vmaCreateBuffer(instance.GetAllocator(), &buffer_ci_unsafe, &alloc_ci, &unsafe_buffer,
+                        &allocation, &allocation_info);
+    ASSERT_MSG(buffer_result == VK_SUCCESS, "Failed allocating staging ring with error {}",
+               vk::to_string(vk::Result{buffer_result}));
+    buffer = vk::Buffer{unsafe_buffer};
+    mapped = reinterpret_cast<u8*>(allocation_info.pMappedData);
+
+    // Multi-tenant hosts cap how fast one instance may push staging data so a
+    // streaming burst cannot starve other instances' frame deadlines. A quarter
+    // second of burst headroom keeps isolated spikes unthrottled.
+    budget_bytes_per_sec = static_cast<u64>(Config::transferBudgetMbPerSec()) * 1_MB;
+    bucket_bytes = budget_bytes_per_sec / 4;
+    bucket_time = std::chrono::steady_clock::now();
+}
+
+UploadEngine::~UploadEngine() {
+    if (!IsAvailable()) {
+        return;
+    }
+    WaitForTick(signal_value);
+    vmaDestroyBuffer(instance.GetAllocator(), buffer, allocation);
+}
+
+std::pair<u8*, u64> UploadEngine::Map(u64 size, u64 alignment) {
+    ASSERT_MSG(size <= buffer_size, "Upload of {} bytes exceeds staging ring size", size);
+    ThrottleToBudget(size);
+    batch_bytes += size;
+    if (alignment > 0) {
+        offset = Common::AlignUp(offset, alignment);
+    }
+    if (offset + size > buffer_size) {
+        // The ring wrapped; everything submitted so far wrote into the region we
+        // are about to reuse, so drain the transfer queue before overwriting it.
+        Flush();
+        WaitForTick(signal_value);
+        offset = 0;
+    }
+    const u64 mapped_offset = offset;
+    offset += size;
+    return {mapped + mapped_offset, mapped_offset};
+}
+
+vk::CommandBuffer UploadEngine::CommandBuffer() {
+    if (!is_recording) {
+        cmdbuf_index = (cmdbuf_index + 1) % static_cast<u32>(cmdbufs.size());
+        WaitForTick(cmdbuf_ticks[cmdbuf_index]);
+        cmdbufs[cmdbuf_index].begin(vk::CommandBufferBeginInfo{
+            .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit,
+        });
+        is_recording = true;
+    }
+    return cmdbufs[cmdbuf_index];
+}
+
+void UploadEngine::Flush() {
+    if (!is_recording) {
+        return;
+    }
+    const auto cmdbuf = cmdbufs[cmdbuf_index];
+    cmdbuf.end();
+
+    const u64 timeline_value = ++signal_value;
+    const vk::Semaphore timeline = *semaphore;
+    const vk::TimelineSemaphoreSubmitInfo timeline_si = {
+        .signalSemaphoreValueCount = 1,
+        .pSignalSemaphoreValues = &timeline_value,
+    };
+    const vk::SubmitInfo submit_info = {
+        .pNext = &timeline_si,
+        .commandBufferCount = 1,
+        .pCommandBuffers = &cmdbuf,
+        .signalSemaphoreCount = 1,
+        .pSignalSemaphores = &timeline,
+    };
+    try {
+        queue.submit(submit_info);
+    } catch (vk::DeviceLostError& err) {
+        UNREACHABLE_MSG("Device lost during transfer submit: {}", err.what());
+    }
+    cmdbuf_ticks[cmdbuf_index] = timeline_value;
+    cmdbuf_bytes[cmdbuf_index] = batch_bytes;
+    batch_bytes = 0;
+    is_recording = false;
+}
+
+u64 UploadEngine::InFlightBytes() {
+    u64 bytes = batch_bytes;
+    for (size_t i = 0; i < cmdbufs.size(); ++i) {
+        if (cmdbuf_ticks[i] != 0 && !IsFree(cmdbuf_ticks[i])) {
+            bytes += cmdbuf_bytes[i];
+        }
+    }
+    return bytes;
+}
+
+void UploadEngine::ThrottleToBudget(u64 size) {
+    if (budget_bytes_per_sec == 0) {
+        return;
+    }
+    using namespace std::chrono;
+    const u64 capacity = std::max(budget_bytes_per_sec / 4, size);
+    const auto now = steady_clock::now();
+    const u64 elapsed_ns = duration_cast<nanoseconds>(now - bucket_time).count();
+    const u64 refill = elapsed_ns / 1000 * budget_bytes_per_sec / 1'000'000;
+    bucket_bytes = std::min(capacity, bucket_bytes + refill);
+    bucket_time = now;
+    if (size <= bucket_bytes) {
+        bucket_bytes -= size;
+        return;
+    }
+    // Sleep until the deficit has refilled; the producer is the texture cache
+    // on the GPU command thread, so this back-pressures streaming at its
+    // source instead of queueing unbounded staging writes.
+    const u64 deficit = size - bucket_bytes;
+    std::this_thread::sleep_for(nanoseconds(deficit * 1'000'000 / (budget_bytes_per_sec / 1000)));
+    bucket_bytes = 0;
+    bucket_time = steady_clock::now();
+}
+
+bool UploadEngine::IsFree(u64 tick) {
+    if (tick <= gpu_tick) {
+        return true;
+    }
+    gpu_tick = instance.GetDevice().getSemaphoreCounterValue(*semaphore);
+    return tick <= gpu_tick;
+}
+
+void UploadEngine::WaitForTick(u64 tick) {
+    if (IsFree(tick)) {
+        return;
+    }
+    const vk::Semaphore timeline = *semaphore;
+    const vk::SemaphoreWaitInfo wait_info = {
+        .semaphoreCount = 1,
+        .pSemaphores = &timeline,
+        .pValues = &tick,
+    };
+    while (instance.GetDevice().waitSemaphores(&wait_info, WAIT_TIMEOUT) !=
+           vk::Result::eSuccess) {
+    }
+    gpu_tick = std::max(gpu_tick, tick);
+}
+
+} // namespace Vulkan
@@ -0,0 +1,98 @@
+// SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <utility>
+#include "common/types.h"
+#include "video_core/renderer_vulkan/vk_common.h"
+
+VK_DEFINE_HANDLE(VmaAllocation)
+
+namespace Vulkan {
+
+class Instance;
+
+/**
+ * Records buffer-to-image copies on the dedicated transfer queue, out-of-band
+ * from the graphics queue. CPU data lands in a persistent host-visible staging
+ * ring; recorded copies are batched into a single transfer submission that
+ * signals the engine's timeline semaphore. Consumers make the graphics queue
+ * wait on the corresponding timeline value only when the uploaded resource is
+ * actually used, so texture streaming overlaps with rendering.
+ */
+class UploadEngine {
+public:
+    explicit UploadEngine(const Instance& instance, u64 staging_size);
+    ~UploadEngine();
+
+    /// Returns true when the device exposes a DMA-only queue to record on.
+    bool IsAvailable() const noexcept {
+        return queue != nullptr;
+    }
+
+    /// Reserves a region of the staging ring, returning the write pointer and
+    /// the buffer offset for the copy command.
+    std::pair<u8*, u64> Map(u64 size, u64 alignment);
+
+    /// Returns the transfer command buffer of the currently open batch.
+    vk::CommandBuffer CommandBuffer();
+
+    /// Returns the timeline value the currently open batch will signal.
+    u64 CurrentTick() const noexcept {
+        return signal_value + 1;
+    }
+
+    /// Submits the open batch, if any, signaling CurrentTick() on completion.
+    void Flush();
+
+    /// Returns true when the given timeline value has been signaled.
+    bool IsFree(u64 tick);
+
+    vk::Semaphore Semaphore() const noexcept {
+        return *semaphore;
+    }
+
+    vk::Buffer Handle() const noexcept {
+        return buffer;
+    }
+
+    /// Returns the bytes recorded into batches the GPU has not completed yet,
+    /// including the currently open one.
+    u64 InFlightBytes();
+
+private:
+    /// Blocks the host until the given timeline value is signaled.
+    void WaitForTick(u64 tick);
+
+    /// Delays the reservation until the configured PCIe budget admits it.
+    /// Reservations are the only throttle point: flushes a frame is already
+    /// waiting on are never delayed further.
+    void ThrottleToBudget(u64 size);
+
+    const Instance& instance;
+    vk::Queue queue{};
+    vk::UniqueCommandPool cmd_pool;
+    std::array<vk::CommandBuffer, 2> cmdbufs{};
+    std::array<u64, 2> cmdbuf_ticks{};
+    std::array<u64, 2> cmdbuf_bytes{};
+    u32 cmdbuf_index{};
+    u64 batch_bytes{}; ///< Bytes mapped into the currently open batch.
+    // Token bucket limiting staged bytes per second; zero budget disables it.
+    u64 budget_bytes_per_sec{};
+    u64 bucket_bytes{};
+    std::chrono::steady_clock::time_point bucket_time{};
+    bool is_recording{};
+    vk::UniqueSemaphore semaphore; ///< Timeline semaphore for upload completion.
+    u64 signal_value{};            ///< Last submitted timeline value.
+    vk::Buffer buffer{};
+    VmaAllocation allocation{};
+    u8* mapped{};
+    u64 buffer_size{};
+    u64 offset{};
+    u64 gpu_tick{}; ///< Last timeline value known to be signaled.
+};
+
+} // namespace Vulkan
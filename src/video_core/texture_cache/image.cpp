@@ -142,7 +142,8 @@ ImageInfo::ImageInfo(const Libraries::VideoOut::BufferAttributeGroup& group) noe
 }
 
 ImageInfo::ImageInfo(const AmdGpu::Liverpool::ColorBuffer& buffer,
-                     const AmdGpu::Liverpool::CbDbExtent& hint /*= {}*/) noexcept {
+                     const AmdGpu::Liverpool::CbDbExtent& hint /*= {}*/,
+                     u32 scale_pct /*= 100*/) noexcept {
     is_tiled = buffer.IsTiled();
     tiling_mode = buffer.GetTilingMode();
     pixel_format = LiverpoolToVK::SurfaceFormat(buffer.info.format, buffer.NumFormat());
@@ -151,6 +152,12 @@ ImageInfo::ImageInfo(const AmdGpu::Liverpool::ColorBuffer& buffer,
     size.width = hint.Valid() ? hint.width : buffer.Pitch();
     size.height = hint.Valid() ? hint.height : buffer.Height();
     size.depth = 1;
+    if (scale_pct != 100) {
+        // Render-scale only the device allocation; guest_size_bytes keeps
+        // covering the native guest range for address tracking.
+        size.width = std::max<u32>(1, size.width * scale_pct / 100);
+        size.height = std::max<u32>(1, size.height * scale_pct / 100);
+    }
     pitch = size.width;
     guest_size_bytes = buffer.GetSizeAligned();
     meta_info.cmask_addr = buffer.info.fast_clear ? buffer.CmaskAddress() : 0;
@@ -159,7 +166,8 @@ ImageInfo::ImageInfo(const AmdGpu::Liverpool::ColorBuffer& buffer,
 }
 
 ImageInfo::ImageInfo(const AmdGpu::Liverpool::DepthBuffer& buffer, VAddr htile_address,
-                     const AmdGpu::Liverpool::CbDbExtent& hint) noexcept {
+                     const AmdGpu::Liverpool::CbDbExtent& hint /*= {}*/,
+                     u32 scale_pct /*= 100*/) noexcept {
     is_tiled = false;
     pixel_format = LiverpoolToVK::DepthFormat(buffer.z_info.format, buffer.stencil_info.format);
     type = vk::ImageType::e2D;
@@ -167,6 +175,10 @@ ImageInfo::ImageInfo(const AmdGpu::Liverpool::DepthBuffer& buffer, VAddr htile_a
     size.width = hint.Valid() ? hint.width : buffer.Pitch();
     size.height = hint.Valid() ? hint.height : buffer.Height();
     size.depth = 1;
+    if (scale_pct != 100) {
+        size.width = std::max<u32>(1, size.width * scale_pct / 100);
+        size.height = std::max<u32>(1, size.height * scale_pct / 100);
+    }
     pitch = size.width;
     guest_size_bytes = buffer.GetSizeAligned();
     meta_info.htile_addr = buffer.z_info.tile_surface_en ? htile_address : 0;
@@ -197,23 +209,32 @@ UniqueImage::~UniqueImage() {
     }
 }
 
-void UniqueImage::Create(const vk::ImageCreateInfo& image_ci) {
-    const VmaAllocationCreateInfo alloc_info = {
+void UniqueImage::Create(const vk::ImageCreateInfo& image_ci, VmaPool pool) {
+    VmaAllocationCreateInfo alloc_info = {
         .flags = VMA_ALLOCATION_CREATE_WITHIN_BUDGET_BIT,
         .usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE,
         .requiredFlags = 0,
         .preferredFlags = 0,
-        .pool = VK_NULL_HANDLE,
+        .pool = pool,
         .pUserData = nullptr,
     };
 
     const VkImageCreateInfo image_ci_unsafe = static_cast<VkImageCreateInfo>(image_ci);
     VkImage unsafe_image{};
+    VmaAllocationInfo alloc_result{};
     VkResult result = vmaCreateImage(allocator, &image_ci_unsafe, &alloc_info, &unsafe_image,
-                                     &allocation, nullptr);
+                                     &allocation, &alloc_result);
+    if (result != VK_SUCCESS && pool != VK_NULL_HANDLE) {
+        // The image's memory requirements are incompatible with the class pool;
+        // retry against the shared pools rather than failing outright.
+        alloc_info.pool = VK_NULL_HANDLE;
+        result = vmaCreateImage(allocator, &image_ci_unsafe, &alloc_info, &unsafe_image,
+                                &allocation, &alloc_result);
+    }
     ASSERT_MSG(result == VK_SUCCESS, "Failed allocating image with error {}",
                vk::to_string(vk::Result{result}));
     image = vk::Image{unsafe_image};
+    mem_size = alloc_result.size;
 }
 
 Image::Image(const Vulkan::Instance& instance_, Vulkan::Scheduler& scheduler_,
@@ -244,6 +265,11 @@ Image::Image(const Vulkan::Instance& instance_, Vulkan::Scheduler& scheduler_,
         aspect_mask = vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil;
     }
 
+    // When a dedicated transfer queue is available uploads are recorded on it, so
+    // share the image between both families to avoid explicit ownership transfers.
+    const std::array queue_families = {instance->GetGraphicsQueueFamilyIndex(),
+                                       instance->GetTransferQueueFamilyIndex()};
+    const bool shared_with_transfer = instance->HasTransferQueue();
     const vk::ImageCreateInfo image_ci = {
         .flags = flags,
         .imageType = info.type,
@@ -258,10 +284,17 @@ Image::Image(const Vulkan::Instance& instance_, Vulkan::Scheduler& scheduler_,
         .samples = LiverpoolToVK::NumSamples(info.num_samples),
         .tiling = vk::ImageTiling::eOptimal,
         .usage = usage,
+        .sharingMode =
+            shared_with_transfer ? vk::SharingMode::eConcurrent : vk::SharingMode::eExclusive,
+        .queueFamilyIndexCount = shared_with_transfer ? static_cast<u32>(queue_families.size()) : 0,
+        .pQueueFamilyIndices = shared_with_transfer ? queue_families.data() : nullptr,
         .initialLayout = vk::ImageLayout::eUndefined,
     };
 
-    image.Create(image_ci);
+    const VmaPool pool = info.usage.render_target || info.usage.depth_target
+                             ? instance->GetAttachmentMemoryPool()
+                             : instance->GetTextureMemoryPool();
+    image.Create(image_ci, pool);
 
     // Create a special view for detiler
     if (info.is_tiled) {
@@ -304,21 +337,51 @@ void Image::Transit(vk::ImageLayout dst_layout, vk::Flags<vk::AccessFlagBits> ds
             : vk::PipelineStageFlagBits::eAllGraphics | vk::PipelineStageFlagBits::eComputeShader;
 
     if (!cmdbuf) {
+        // Transitions between draws are queued on the scheduler and issued as
+        // one batched barrier command right before the next recorded command.
+        scheduler->BatchImageBarrier(barrier, pl_stage, dst_pl_stage);
+    } else {
         // When using external cmdbuf you are responsible for ending rp.
-        scheduler->EndRendering();
-        cmdbuf = scheduler->CommandBuffer();
+        cmdbuf.pipelineBarrier(pl_stage, dst_pl_stage, vk::DependencyFlagBits::eByRegion, {}, {},
+                               barrier);
     }
-    cmdbuf.pipelineBarrier(pl_stage, dst_pl_stage, vk::DependencyFlagBits::eByRegion, {}, {},
-                           barrier);
 
     layout = dst_layout;
     access_mask = dst_mask;
     pl_stage = dst_pl_stage;
 }
 
-void Image::Upload(vk::Buffer buffer, u64 offset) {
-    scheduler->EndRendering();
-    Transit(vk::ImageLayout::eTransferDstOptimal, vk::AccessFlagBits::eTransferWrite);
+void Image::Upload(vk::Buffer buffer, u64 offset, vk::CommandBuffer cmdbuf) {
+    // Transfer-only queues cannot express graphics pipeline stages in barriers, so an
+    // external command buffer gets transitions with universal stages instead of Transit.
+    // The previous contents can be discarded since the upload overwrites them anyway.
+    const bool is_external = static_cast<bool>(cmdbuf);
+    if (!is_external) {
+        scheduler->EndRendering();
+        cmdbuf = scheduler->CommandBuffer();
+    }
+    if (is_external) {
+        const vk::ImageMemoryBarrier barrier = {
+            .srcAccessMask = vk::AccessFlagBits::eNone,
+            .dstAccessMask = vk::AccessFlagBits::eTransferWrite,
+            .oldLayout = vk::ImageLayout::eUndefined,
+            .newLayout = vk::ImageLayout::eTransferDstOptimal,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = image,
+            .subresourceRange{
+                .aspectMask = aspect_mask,
+                .baseMipLevel = 0,
+                .levelCount = VK_REMAINING_MIP_LEVELS,
+                .baseArrayLayer = 0,
+                .layerCount = VK_REMAINING_ARRAY_LAYERS,
+            },
+        };
+        cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe,
+                               vk::PipelineStageFlagBits::eTransfer, {}, {}, {}, barrier);
+    } else {
+        Transit(vk::ImageLayout::eTransferDstOptimal, vk::AccessFlagBits::eTransferWrite, cmdbuf);
+    }
 
     // Copy to the image.
     const auto aspect = aspect_mask & vk::ImageAspectFlagBits::eStencil
@@ -338,11 +401,37 @@ void Image::Upload(vk::Buffer buffer, u64 offset) {
         .imageExtent = {info.size.width, info.size.height, 1},
     };
 
-    const auto cmdbuf = scheduler->CommandBuffer();
     cmdbuf.copyBufferToImage(buffer, image, vk::ImageLayout::eTransferDstOptimal, image_copy);
 
+    if (is_external) {
+        const vk::ImageMemoryBarrier barrier = {
+            .srcAccessMask = vk::AccessFlagBits::eTransferWrite,
+            .dstAccessMask = vk::AccessFlagBits::eNone,
+            .oldLayout = vk::ImageLayout::eTransferDstOptimal,
+            .newLayout = vk::ImageLayout::eGeneral,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = image,
+            .subresourceRange{
+                .aspectMask = aspect_mask,
+                .baseMipLevel = 0,
+                .levelCount = VK_REMAINING_MIP_LEVELS,
+                .baseArrayLayer = 0,
+                .layerCount = VK_REMAINING_ARRAY_LAYERS,
+            },
+        };
+        cmdbuf.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer,
+                               vk::PipelineStageFlagBits::eBottomOfPipe, {}, {}, {}, barrier);
+        // The timeline semaphore wait makes the transfer writes visible to the
+        // graphics queue, so no access mask needs to carry over.
+        layout = vk::ImageLayout::eGeneral;
+        access_mask = vk::AccessFlagBits::eNone;
+        pl_stage = vk::PipelineStageFlagBits::eTransfer;
+        return;
+    }
+
     Transit(vk::ImageLayout::eGeneral,
-            vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eTransferRead);
+            vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eTransferRead, cmdbuf);
 }
 
 Image::~Image() = default;
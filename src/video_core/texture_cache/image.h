@@ -21,6 +21,7 @@ class Scheduler;
 
 VK_DEFINE_HANDLE(VmaAllocation)
 VK_DEFINE_HANDLE(VmaAllocator)
+VK_DEFINE_HANDLE(VmaPool)
 
 namespace VideoCore {
 
@@ -38,9 +39,11 @@ struct ImageInfo {
     ImageInfo() = default;
     explicit ImageInfo(const Libraries::VideoOut::BufferAttributeGroup& group) noexcept;
     explicit ImageInfo(const AmdGpu::Liverpool::ColorBuffer& buffer,
-                       const AmdGpu::Liverpool::CbDbExtent& hint = {}) noexcept;
+                       const AmdGpu::Liverpool::CbDbExtent& hint = {},
+                       u32 scale_pct = 100) noexcept;
     explicit ImageInfo(const AmdGpu::Liverpool::DepthBuffer& buffer, VAddr htile_address,
-                       const AmdGpu::Liverpool::CbDbExtent& hint = {}) noexcept;
+                       const AmdGpu::Liverpool::CbDbExtent& hint = {},
+                       u32 scale_pct = 100) noexcept;
     explicit ImageInfo(const AmdGpu::Image& image) noexcept;
 
     bool IsTiled() const {
@@ -85,15 +88,22 @@ struct UniqueImage {
     UniqueImage(UniqueImage&& other)
         : image{std::exchange(other.image, VK_NULL_HANDLE)},
           allocator{std::exchange(other.allocator, VK_NULL_HANDLE)},
-          allocation{std::exchange(other.allocation, VK_NULL_HANDLE)} {}
+          allocation{std::exchange(other.allocation, VK_NULL_HANDLE)},
+          mem_size{std::exchange(other.mem_size, 0)} {}
     UniqueImage& operator=(UniqueImage&& other) {
         image = std::exchange(other.image, VK_NULL_HANDLE);
         allocator = std::exchange(other.allocator, VK_NULL_HANDLE);
         allocation = std::exchange(other.allocation, VK_NULL_HANDLE);
+        mem_size = std::exchange(other.mem_size, 0);
         return *this;
     }
 
-    void Create(const vk::ImageCreateInfo& image_ci);
+    void Create(const vk::ImageCreateInfo& image_ci, VmaPool pool);
+
+    /// Returns the size of the backing device allocation in bytes.
+    [[nodiscard]] u64 MemSize() const noexcept {
+        return mem_size;
+    }
 
     operator vk::Image() const {
         return image;
@@ -104,6 +114,7 @@ private:
     VmaAllocator allocator;
     VmaAllocation allocation;
     vk::Image image{};
+    u64 mem_size{};
 };
 
 constexpr Common::SlotId NULL_IMAGE_ID{0};
@@ -134,7 +145,21 @@ struct Image {
 
     void Transit(vk::ImageLayout dst_layout, vk::Flags<vk::AccessFlagBits> dst_mask,
                  vk::CommandBuffer cmdbuf = {});
-    void Upload(vk::Buffer buffer, u64 offset);
+    void Upload(vk::Buffer buffer, u64 offset, vk::CommandBuffer cmdbuf = {});
+
+    /// Expands the guest range that must be revalidated before the next use.
+    void MarkCpuDirty(VAddr addr, u64 size) noexcept {
+        const VAddr begin = std::max(addr, cpu_addr);
+        const VAddr end = std::min(addr + size, cpu_addr_end);
+        if (begin >= end) {
+            return;
+        }
+        dirty_begin = dirty_begin == dirty_end ? begin : std::min(dirty_begin, begin);
+        dirty_end = std::max(dirty_end, end);
+    }
+
+    /// Guest data is hashed for change detection at this granularity.
+    static constexpr u64 HashBlockSize = 256_KB;
 
     const Vulkan::Instance* instance;
     Vulkan::Scheduler* scheduler;
@@ -148,7 +173,16 @@ struct Image {
     std::vector<ImageViewId> image_view_ids;
     std::optional<ImageView> view_for_detiler;
 
+    // Contents validation: per-block hashes of guest memory plus the faulted
+    // range accumulated since the last validation. Empty hashes mean the image
+    // has never been validated and the whole surface must be hashed.
+    std::vector<u64> block_hashes;
+    VAddr dirty_begin = 0;
+    VAddr dirty_end = 0;
+
     // Resource state tracking
+    u64 upload_tick = 0; ///< Transfer queue timeline value of the last async upload.
+    u64 lru_tick = 0;    ///< Scheduler tick of the last cache lookup that returned the image.
     vk::ImageUsageFlags usage;
     vk::Flags<vk::PipelineStageFlagBits> pl_stage = vk::PipelineStageFlagBits::eAllCommands;
     vk::Flags<vk::AccessFlagBits> access_mask = vk::AccessFlagBits::eNone;
@@ -45,10 +45,15 @@ struct ImageView {
     ImageView(ImageView&&) = default;
     ImageView& operator=(ImageView&&) = default;
 
+    static constexpr u32 NoBindlessSlot = ~0U;
+
     ImageId image_id{};
     Extent3D size{0, 0, 0};
     ImageViewInfo info{};
     vk::UniqueImageView image_view;
+    /// Element of the global descriptor array the view was published to, or
+    /// NoBindlessSlot when it has not been used by a bindless shader yet.
+    u32 bindless_slot = NoBindlessSlot;
 };
 
 } // namespace VideoCore
@@ -4,15 +4,33 @@
 #include <xxhash.h>
 #include "common/assert.h"
 #include "common/config.h"
+#include "common/logging/log.h"
+#include "common/profiler.h"
+#include "common/singleton.h"
+#include "core/fault_profiler.h"
 #include "core/virtual_memory.h"
+#include "video_core/buffer_cache/buffer_cache.h"
 #include "video_core/renderer_vulkan/vk_instance.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/texture_cache/texture_cache.h"
 #include "video_core/texture_cache/tile_manager.h"
 
 #ifndef _WIN64
+#include <thread>
 #include <signal.h>
 #include <sys/mman.h>
+#include "common/thread.h"
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if __has_include(<linux/userfaultfd.h>)
+#include <linux/userfaultfd.h>
+#endif
+#endif
 
 #define PAGE_NOACCESS PROT_NONE
 #define PAGE_READWRITE (PROT_READ | PROT_WRITE)
@@ -37,7 +55,14 @@ void GuestFaultSignalHandler(int sig, siginfo_t* info, void* raw_context) {
     ucontext_t* ctx = reinterpret_cast<ucontext_t*>(raw_context);
     const VAddr address = reinterpret_cast<VAddr>(info->si_addr);
     if (ctx->uc_mcontext.gregs[REG_ERR] & 0x2) {
+        if (Config::debugDump()) {
+            const VAddr rip = ctx->uc_mcontext.gregs[REG_RIP];
+            Common::Singleton<Core::FaultProfiler>::Instance()->Record(address, rip);
+        }
         g_texture_cache->OnCpuWrite(address);
+        if (auto* buffer_cache = BufferCache::Instance()) {
+            buffer_cache->OnCpuWrite(address);
+        }
     } else {
         // Read not supported!
         UNREACHABLE();
@@ -49,7 +74,14 @@ LONG WINAPI GuestFaultSignalHandler(EXCEPTION_POINTERS* pExp) noexcept {
     if (ec == EXCEPTION_ACCESS_VIOLATION) {
         const auto info = pExp->ExceptionRecord->ExceptionInformation;
         if (info[0] == 1) { // Write violation
+            if (Config::debugDump()) {
+                Common::Singleton<Core::FaultProfiler>::Instance()->Record(
+                    info[1], pExp->ContextRecord->Rip);
+            }
             g_texture_cache->OnCpuWrite(info[1]);
+            if (auto* buffer_cache = BufferCache::Instance()) {
+                buffer_cache->OnCpuWrite(info[1]);
+            }
             return EXCEPTION_CONTINUE_EXECUTION;
         } /* else {
             UNREACHABLE();
@@ -59,27 +91,163 @@ LONG WINAPI GuestFaultSignalHandler(EXCEPTION_POINTERS* pExp) noexcept {
 }
 #endif
 
+#ifndef _WIN64
+#if defined(__linux__) && defined(UFFDIO_WRITEPROTECT_MODE_WP)
+/**
+ * Delivers guest write faults through userfaultfd in write-protect mode instead
+ * of SIGSEGV. Faulting threads block in the kernel while a dedicated reader
+ * drains events in batches and invalidates the touched caches, so per-fault
+ * cost is a queue entry rather than a full signal frame, and concurrent faults
+ * no longer serialize on kernel-side signal delivery. Lifting protection
+ * unregisters the range, which also wakes any thread still blocked on it.
+ */
+class UffdPageTracker {
+public:
+    static std::unique_ptr<UffdPageTracker> TryCreate(TextureCache& owner) {
+        const int fd = static_cast<int>(syscall(SYS_userfaultfd, O_CLOEXEC | O_NONBLOCK));
+        if (fd < 0) {
+            // Typically vm.unprivileged_userfaultfd=0 or a pre-4.3 kernel.
+            LOG_INFO(Render_Vulkan, "userfaultfd unavailable, using signal write tracking");
+            return nullptr;
+        }
+        uffdio_api api{};
+        api.api = UFFD_API;
+        api.features = UFFD_FEATURE_PAGEFAULT_FLAG_WP;
+        if (ioctl(fd, UFFDIO_API, &api) < 0 ||
+            (api.features & UFFD_FEATURE_PAGEFAULT_FLAG_WP) == 0) {
+            LOG_INFO(Render_Vulkan,
+                     "userfaultfd lacks write-protect mode, using signal write tracking");
+            close(fd);
+            return nullptr;
+        }
+        return std::unique_ptr<UffdPageTracker>(new UffdPageTracker(owner, fd));
+    }
+
+    ~UffdPageTracker() {
+        reader.request_stop();
+        reader.join();
+        close(fd);
+    }
+
+    void Protect(VAddr addr, u64 size, bool protect) {
+        uffdio_range range{};
+        range.start = addr;
+        range.len = size;
+        if (protect) {
+            uffdio_register reg{};
+            reg.range = range;
+            reg.mode = UFFDIO_REGISTER_MODE_WP;
+            const int reg_ret = ioctl(fd, UFFDIO_REGISTER, &reg);
+            ASSERT_MSG(reg_ret == 0, "userfaultfd register failed");
+            // Registration alone does not fault; the range must be armed too.
+            uffdio_writeprotect wp{};
+            wp.range = range;
+            wp.mode = UFFDIO_WRITEPROTECT_MODE_WP;
+            const int wp_ret = ioctl(fd, UFFDIO_WRITEPROTECT, &wp);
+            ASSERT_MSG(wp_ret == 0, "userfaultfd write-protect failed");
+        } else {
+            uffdio_writeprotect wp{};
+            wp.range = range;
+            wp.mode = 0;
+            ioctl(fd, UFFDIO_WRITEPROTECT, &wp);
+            // Unregistering wakes every thread still blocked on a fault in the
+            // range, so no explicit UFFDIO_WAKE is needed.
+            ioctl(fd, UFFDIO_UNREGISTER, &range);
+        }
+    }
+
+private:
+    explicit UffdPageTracker(TextureCache& owner_, int fd_) : owner{owner_}, fd{fd_} {
+        reader = std::jthread([this](std::stop_token token) { FaultReaderLoop(token); });
+    }
+
+    void FaultReaderLoop(std::stop_token token) {
+        Common::SetCurrentThreadName("shadPS4:PageFaults");
+        std::array<uffd_msg, 64> msgs;
+        while (!token.stop_requested()) {
+            pollfd pfd{};
+            pfd.fd = fd;
+            pfd.events = POLLIN;
+            // Finite timeout so the stop request is observed without an eventfd.
+            if (poll(&pfd, 1, 100) <= 0) {
+                continue;
+            }
+            const ssize_t bytes = read(fd, msgs.data(), sizeof(msgs));
+            if (bytes <= 0) {
+                continue;
+            }
+            const size_t count = size_t(bytes) / sizeof(uffd_msg);
+            for (size_t i = 0; i < count; ++i) {
+                const uffd_msg& msg = msgs[i];
+                if (msg.event != UFFD_EVENT_PAGEFAULT ||
+                    (msg.arg.pagefault.flags & UFFD_PAGEFAULT_FLAG_WP) == 0) {
+                    continue;
+                }
+                const VAddr address = msg.arg.pagefault.address;
+                if (Config::debugDump()) {
+                    // No faulting instruction pointer travels with the event.
+                    Common::Singleton<Core::FaultProfiler>::Instance()->Record(address, 0);
+                }
+                owner.OnCpuWrite(address);
+                if (auto* buffer_cache = BufferCache::Instance()) {
+                    buffer_cache->OnCpuWrite(address);
+                }
+            }
+        }
+    }
+
+    TextureCache& owner;
+    int fd;
+    std::jthread reader;
+};
+#else
+/// Kernel headers predate userfaultfd write-protect support; keep the type
+/// complete so the owning unique_ptr destroys cleanly, and never construct it.
+class UffdPageTracker {
+public:
+    static std::unique_ptr<UffdPageTracker> TryCreate(TextureCache&) {
+        return nullptr;
+    }
+    void Protect(VAddr, u64, bool) {}
+};
+#endif
+#endif
+
 static constexpr u64 StreamBufferSize = 512_MB;
+// Capacities of the global descriptor arrays used by the bindless texture path.
+// Sized for the largest resource mix seen in titles with comfortable headroom;
+// elements are recycled when images are deleted so the arrays never need to grow.
+static constexpr u32 BindlessSampledImageCount = 4096;
+static constexpr u32 BindlessStorageImageCount = 1024;
+static constexpr u32 BindlessSamplerCount = 512;
+static constexpr u64 UploadRingSize = 256_MB;
 static constexpr u64 PageShift = 12;
+static constexpr u64 NumProtectWords = (USER_MAX >> PageShift) / 64 + 1;
 
 TextureCache::TextureCache(const Vulkan::Instance& instance_, Vulkan::Scheduler& scheduler_)
     : instance{instance_}, scheduler{scheduler_},
       staging{instance, scheduler, vk::BufferUsageFlagBits::eTransferSrc, StreamBufferSize,
               Vulkan::BufferType::Upload},
-      tile_manager{instance, scheduler} {
+      upload_engine{instance, UploadRingSize}, tile_manager{instance, scheduler} {
+    protected_pages = std::make_unique<std::atomic<u64>[]>(NumProtectWords);
 
 #ifndef _WIN64
-    sigset_t signal_mask;
-    sigemptyset(&signal_mask);
-    sigaddset(&signal_mask, SIGSEGV);
+    // Prefer signal-free fault delivery; the SIGSEGV handler remains the
+    // fallback when the kernel does not grant userfaultfd write-protect.
+    uffd_tracker = UffdPageTracker::TryCreate(*this);
+    if (!uffd_tracker) {
+        sigset_t signal_mask;
+        sigemptyset(&signal_mask);
+        sigaddset(&signal_mask, SIGSEGV);
 
-    using HandlerType = decltype(sigaction::sa_sigaction);
+        using HandlerType = decltype(sigaction::sa_sigaction);
 
-    struct sigaction guest_access_fault {};
-    guest_access_fault.sa_flags = SA_SIGINFO | SA_ONSTACK;
-    guest_access_fault.sa_sigaction = &GuestFaultSignalHandler;
-    guest_access_fault.sa_mask = signal_mask;
-    sigaction(SIGSEGV, &guest_access_fault, nullptr);
+        struct sigaction guest_access_fault {};
+        guest_access_fault.sa_flags = SA_SIGINFO | SA_ONSTACK;
+        guest_access_fault.sa_sigaction = &GuestFaultSignalHandler;
+        guest_access_fault.sa_mask = signal_mask;
+        sigaction(SIGSEGV, &guest_access_fault, nullptr);
+    }
 #else
     veh_handle = AddVectoredExceptionHandler(0, GuestFaultSignalHandler);
     ASSERT_MSG(veh_handle, "Failed to register an exception handler");
@@ -94,6 +262,10 @@ TextureCache::TextureCache(const Vulkan::Instance& instance_, Vulkan::Scheduler&
 
     ImageViewInfo view_info;
     void(slot_image_views.insert(instance, view_info, slot_images[null_id], null_id));
+
+    if (instance.IsBindlessTexturesSupported()) {
+        CreateBindlessSet();
+    }
 }
 
 TextureCache::~TextureCache() {
@@ -103,13 +275,41 @@ TextureCache::~TextureCache() {
 }
 
 void TextureCache::OnCpuWrite(VAddr address) {
-    std::unique_lock lock{m_page_table};
-    ForEachImageInRegion(address, 1 << PageShift, [&](ImageId image_id, Image& image) {
-        // Ensure image is reuploaded when accessed again.
+    if (!IsPageProtected(address)) {
+        // Protection has already been lifted by another thread, the write
+        // will succeed on retry without touching the page table.
+        return;
+    }
+    Common::Singleton<Common::Profiler>::Instance()->AddCounter(
+        Common::Profiler::Counter::ImageCpuWriteFaults);
+    // Faults only read the page table, so take it shared; guest threads writing
+    // distinct textures then no longer serialize on each other. The table cannot
+    // change underneath as all structural updates hold the exclusive lock.
+    std::shared_lock lock{m_page_table};
+    boost::container::small_vector<ImageId, 4> image_ids;
+    ForEachPage(address, 1 << PageShift, [&](u64 page) {
+        const auto it = page_table.find(page);
+        if (it == page_table.end()) {
+            return;
+        }
+        for (const ImageId image_id : it->second) {
+            if (std::ranges::find(image_ids, image_id) == image_ids.end()) {
+                image_ids.push_back(image_id);
+            }
+        }
+    });
+    for (const ImageId image_id : image_ids) {
+        Image& image = slot_images[image_id];
+        // Serialize with other faults landing on the same image; the render
+        // thread is already excluded by its exclusive page table lock.
+        std::scoped_lock image_lock{image_lock_stripes[image_id.index % NumImageLockStripes]};
+        // Ensure image is reuploaded when accessed again. Recording the faulted
+        // page lets validation rehash only the touched blocks.
         image.flags |= ImageFlagBits::CpuModified;
+        image.MarkCpuDirty(address & ~((1ULL << PageShift) - 1), 1ULL << PageShift);
         // Untrack image, so the range is unprotected and the guest can write freely.
         UntrackImage(image, image_id);
-    });
+    }
 }
 
 ImageId TextureCache::FindImage(const ImageInfo& info, VAddr cpu_address, bool refresh_on_create) {
@@ -129,17 +329,27 @@ ImageId TextureCache::FindImage(const ImageInfo& info, VAddr cpu_address, bool r
 
     ASSERT_MSG(image_ids.size() <= 1, "Overlapping images not allowed!");
 
+    auto* profiler = Common::Singleton<Common::Profiler>::Instance();
     ImageId image_id{};
-    if (image_ids.empty()) {
+    const bool is_new_image = image_ids.empty();
+    if (is_new_image) {
+        profiler->AddCounter(Common::Profiler::Counter::ImageCacheMisses);
         image_id = slot_images.insert(instance, scheduler, info, cpu_address);
         RegisterImage(image_id);
     } else {
+        profiler->AddCounter(Common::Profiler::Counter::ImageCacheHits);
         image_id = image_ids[0];
     }
 
     RegisterMeta(info, image_id);
 
     Image& image = slot_images[image_id];
+    image.lru_tick = scheduler.CurrentTick();
+    if (is_new_image) {
+        // Creating a new image is the only event that grows device memory usage,
+        // so this is the natural point to reclaim cold surfaces.
+        EvictOverBudget();
+    }
     if (True(image.flags & ImageFlagBits::CpuModified) && refresh_on_create) {
         RefreshImage(image);
         TrackImage(image, image_id);
@@ -148,10 +358,10 @@ ImageId TextureCache::FindImage(const ImageInfo& info, VAddr cpu_address, bool r
     return image_id;
 }
 
-ImageView& TextureCache::RegisterImageView(ImageId image_id, const ImageViewInfo& view_info) {
+ImageViewId TextureCache::RegisterImageView(ImageId image_id, const ImageViewInfo& view_info) {
     Image& image = slot_images[image_id];
     if (const ImageViewId view_id = image.FindView(view_info); view_id) {
-        return slot_image_views[view_id];
+        return view_id;
     }
 
     // All tiled images are created with storage usage flag. This makes set of formats (e.g. sRGB)
@@ -166,13 +376,30 @@ ImageView& TextureCache::RegisterImageView(ImageId image_id, const ImageViewInfo
         slot_image_views.insert(instance, view_info, image, image_id, usage_override);
     image.image_view_infos.emplace_back(view_info);
     image.image_view_ids.emplace_back(view_id);
-    return slot_image_views[view_id];
+    return view_id;
 }
 
 ImageView& TextureCache::FindImageView(const AmdGpu::Image& desc, bool is_storage) {
-    const ImageInfo info{desc};
-    const ImageId image_id = FindImage(info, desc.Address());
+    // Hash-cons on the raw T# descriptor words so repeated binds of the same
+    // descriptor skip the ImageInfo parse and page table walk entirely.
+    const u64 desc_hash = XXH3_64bits(&desc, sizeof(desc)) ^ static_cast<u64>(is_storage);
+    ImageViewId view_id{};
+    ImageId image_id{};
+    if (const auto it = view_lookup.find(desc_hash); it != view_lookup.end()) {
+        view_id = it->second;
+        image_id = slot_image_views[view_id].image_id;
+        if (True(slot_images[image_id].flags & ImageFlagBits::CpuModified)) {
+            // Take the slow path below so FindImage reuploads the contents.
+            view_id = {};
+        }
+    }
+    if (!view_id) {
+        const ImageInfo info{desc};
+        image_id = FindImage(info, desc.Address());
+    }
     Image& image = slot_images[image_id];
+    image.lru_tick = scheduler.CurrentTick();
+    TouchUploadedImage(image);
     auto& usage = image.info.usage;
 
     if (is_storage) {
@@ -186,15 +413,20 @@ ImageView& TextureCache::FindImageView(const AmdGpu::Image& desc, bool is_storag
         usage.texture = true;
     }
 
-    const ImageViewInfo view_info{desc, is_storage};
-    return RegisterImageView(image_id, view_info);
+    if (!view_id) {
+        const ImageViewInfo view_info{desc, is_storage};
+        view_id = RegisterImageView(image_id, view_info);
+        view_lookup.insert_or_assign(desc_hash, view_id);
+    }
+    return slot_image_views[view_id];
 }
 
 ImageView& TextureCache::RenderTarget(const AmdGpu::Liverpool::ColorBuffer& buffer,
-                                      const AmdGpu::Liverpool::CbDbExtent& hint) {
-    const ImageInfo info{buffer, hint};
+                                      const AmdGpu::Liverpool::CbDbExtent& hint, u32 scale_pct) {
+    const ImageInfo info{buffer, hint, scale_pct};
     const ImageId image_id = FindImage(info, buffer.Address());
     Image& image = slot_images[image_id];
+    TouchUploadedImage(image);
     image.flags &= ~ImageFlagBits::CpuModified;
 
     image.Transit(vk::ImageLayout::eColorAttachmentOptimal,
@@ -204,35 +436,138 @@ ImageView& TextureCache::RenderTarget(const AmdGpu::Liverpool::ColorBuffer& buff
     image.info.usage.render_target = true;
 
     ImageViewInfo view_info{buffer, !!image.info.usage.vo_buffer};
-    return RegisterImageView(image_id, view_info);
+    return slot_image_views[RegisterImageView(image_id, view_info)];
 }
 
 ImageView& TextureCache::DepthTarget(const AmdGpu::Liverpool::DepthBuffer& buffer,
                                      VAddr htile_address, const AmdGpu::Liverpool::CbDbExtent& hint,
-                                     bool write_enabled) {
-    const ImageInfo info{buffer, htile_address, hint};
+                                     bool write_enabled, u32 scale_pct) {
+    // Hash-cons on the raw depth registers like FindImageView does for T#
+    // descriptors. Depth targets rarely change between passes, and ping-pong
+    // schemes keep one entry per buffer address, so repeated binds skip the
+    // ImageInfo parse and page table walk.
+    struct DepthKey {
+        AmdGpu::Liverpool::DepthBuffer buffer;
+        VAddr htile_address;
+        u64 hint;  // Widened from u32 so the key has no padding bytes to hash.
+        u64 scale; // Render scale, so a scale change never reuses stale views.
+    } const key{buffer, htile_address, hint.raw, scale_pct};
+    const u64 key_hash = XXH3_64bits(&key, sizeof(key));
+
+    const auto new_layout = write_enabled ? vk::ImageLayout::eDepthStencilAttachmentOptimal
+                                          : vk::ImageLayout::eDepthStencilReadOnlyOptimal;
+    const auto access_mask = vk::AccessFlagBits::eDepthStencilAttachmentWrite |
+                             vk::AccessFlagBits::eDepthStencilAttachmentRead;
+
+    if (const auto it = depth_target_lookup.find(key_hash); it != depth_target_lookup.end()) {
+        ImageView& image_view = slot_image_views[it->second];
+        Image& image = slot_images[image_view.image_id];
+        if (False(image.flags & ImageFlagBits::CpuModified)) {
+            image.lru_tick = scheduler.CurrentTick();
+            TouchUploadedImage(image);
+            // Transit is a no-op when the layout is unchanged, so an identical
+            // depth target across consecutive passes emits no barrier.
+            image.Transit(new_layout, access_mask);
+            return image_view;
+        }
+        // Fall through so FindImage reuploads the contents.
+    }
+
+    const ImageInfo info{buffer, htile_address, hint, scale_pct};
     const ImageId image_id = FindImage(info, buffer.Address(), false);
     Image& image = slot_images[image_id];
+    TouchUploadedImage(image);
     image.flags &= ~ImageFlagBits::CpuModified;
 
-    const auto new_layout = write_enabled ? vk::ImageLayout::eDepthStencilAttachmentOptimal
-                                          : vk::ImageLayout::eDepthStencilReadOnlyOptimal;
-    image.Transit(new_layout, vk::AccessFlagBits::eDepthStencilAttachmentWrite |
-                                  vk::AccessFlagBits::eDepthStencilAttachmentRead);
+    image.Transit(new_layout, access_mask);
 
     image.info.usage.depth_target = true;
 
     ImageViewInfo view_info;
     view_info.format = info.pixel_format;
-    return RegisterImageView(image_id, view_info);
+    const ImageViewId view_id = RegisterImageView(image_id, view_info);
+    depth_target_lookup.insert_or_assign(key_hash, view_id);
+    return slot_image_views[view_id];
 }
 
 void TextureCache::RefreshImage(Image& image) {
+    PROFILE_SCOPE("TextureCache::RefreshImage");
+
     // Mark image as validated.
     image.flags &= ~ImageFlagBits::CpuModified;
 
+    auto* profiler = Common::Singleton<Common::Profiler>::Instance();
+
+    // Validate against the per-block hashes before paying for an upload. Only
+    // blocks inside the faulted range can have changed, so a small write into a
+    // large surface rehashes one block instead of the whole thing.
+    const u64 guest_size = image.info.guest_size_bytes;
+    const u64 num_blocks = (guest_size + Image::HashBlockSize - 1) / Image::HashBlockSize;
+    const u8* guest_data = reinterpret_cast<const u8*>(image.cpu_addr);
+    const auto hash_block = [&](u64 block) {
+        const u64 offset = block * Image::HashBlockSize;
+        return XXH3_64bits(guest_data + offset, std::min(Image::HashBlockSize, guest_size - offset));
+    };
+    bool changed = false;
+    if (image.block_hashes.size() != num_blocks) {
+        // First validation; hash the whole surface while it is uploaded anyway.
+        image.block_hashes.resize(num_blocks);
+        for (u64 block = 0; block < num_blocks; ++block) {
+            image.block_hashes[block] = hash_block(block);
+        }
+        changed = true;
+    } else {
+        // A set modified flag without a recorded fault range means the whole
+        // surface is suspect.
+        u64 first_block = 0;
+        u64 end_block = num_blocks;
+        if (image.dirty_begin != image.dirty_end) {
+            first_block = (image.dirty_begin - image.cpu_addr) / Image::HashBlockSize;
+            end_block = std::min<u64>(num_blocks, (image.dirty_end - image.cpu_addr +
+                                                   Image::HashBlockSize - 1) /
+                                                      Image::HashBlockSize);
+        }
+        for (u64 block = first_block; block < end_block; ++block) {
+            const u64 hash = hash_block(block);
+            if (image.block_hashes[block] != hash) {
+                image.block_hashes[block] = hash;
+                changed = true;
+            }
+        }
+    }
+    image.dirty_begin = 0;
+    image.dirty_end = 0;
+    if (!changed) {
+        profiler->AddCounter(Common::Profiler::Counter::ImageRefreshesSkipped);
+        return;
+    }
+
+    profiler->AddCounter(Common::Profiler::Counter::ImageRefreshBytes,
+                         image.info.guest_size_bytes);
+    if (image.info.IsBlockCoded()) {
+        // Every mapped BCn host format matches the GCN payload bit-for-bit, so
+        // the compressed blocks go up untouched; track the bandwidth that takes
+        // this passthrough path.
+        profiler->AddCounter(Common::Profiler::Counter::ImageBcnPassthroughBytes,
+                             image.info.guest_size_bytes);
+    }
+
     {
-        if (!tile_manager.TryDetile(image)) {
+        if (tile_manager.TryDetile(image)) {
+            profiler->AddCounter(Common::Profiler::Counter::ImageDetilesGpu);
+        } else {
+            if (upload_engine.IsAvailable()) {
+                // Stage the data in the upload ring and record the copy on the transfer
+                // queue. The graphics queue only waits for the upload timeline value
+                // when the image is actually used, overlapping streaming with drawing.
+                const auto [data, offset] =
+                    upload_engine.Map(image.info.guest_size_bytes, 4);
+                std::memcpy(data, reinterpret_cast<const void*>(image.cpu_addr),
+                            image.info.guest_size_bytes);
+                image.Upload(upload_engine.Handle(), offset, upload_engine.CommandBuffer());
+                image.upload_tick = upload_engine.CurrentTick();
+                return;
+            }
             // Upload data to the staging buffer.
             const auto offset = staging.Copy(image.cpu_addr, image.info.guest_size_bytes, 4);
             // Copy to the image.
@@ -253,6 +588,7 @@ void TextureCache::RefreshImage(Image& image) {
         // Upload data to the staging buffer.
         const auto [data, offset, _] = staging.Map(map_size, 16);
         if (image.info.is_tiled) {
+            profiler->AddCounter(Common::Profiler::Counter::ImageDetilesCpu);
             ConvertTileToLinear(data, image_data, width, height, Config::isNeoMode());
         } else {
             std::memcpy(data, image_data, map_size);
@@ -277,8 +613,8 @@ void TextureCache::RefreshImage(Image& image) {
 
         scheduler.EndRendering();
 
-        const auto cmdbuf = scheduler.CommandBuffer();
         image.Transit(vk::ImageLayout::eTransferDstOptimal, vk::AccessFlagBits::eTransferWrite);
+        const auto cmdbuf = scheduler.CommandBuffer();
 
         cmdbuf.copyBufferToImage(staging.Handle(), image.image,
                                  vk::ImageLayout::eTransferDstOptimal, image_copy);
@@ -288,17 +624,156 @@ void TextureCache::RefreshImage(Image& image) {
     }
 }
 
+void TextureCache::TouchUploadedImage(Image& image) {
+    if (image.upload_tick == 0) {
+        return;
+    }
+    if (!upload_engine.IsFree(image.upload_tick)) {
+        // Ensure the batch containing the copy is on its way to the GPU, then make
+        // the next graphics submission wait for it.
+        upload_engine.Flush();
+        scheduler.WaitExternal(upload_engine.Semaphore(), image.upload_tick);
+    }
+    image.upload_tick = 0;
+}
+
 vk::Sampler TextureCache::GetSampler(const AmdGpu::Sampler& sampler) {
     const u64 hash = XXH3_64bits(&sampler, sizeof(sampler));
     const auto [it, new_sampler] = samplers.try_emplace(hash, instance, sampler);
     return it->second.Handle();
 }
 
+void TextureCache::CreateBindlessSet() {
+    const auto device = instance.GetDevice();
+    const std::array bindings = {
+        vk::DescriptorSetLayoutBinding{
+            .binding = 0,
+            .descriptorType = vk::DescriptorType::eSampledImage,
+            .descriptorCount = BindlessSampledImageCount,
+            .stageFlags = vk::ShaderStageFlagBits::eAll,
+        },
+        vk::DescriptorSetLayoutBinding{
+            .binding = 1,
+            .descriptorType = vk::DescriptorType::eStorageImage,
+            .descriptorCount = BindlessStorageImageCount,
+            .stageFlags = vk::ShaderStageFlagBits::eAll,
+        },
+        vk::DescriptorSetLayoutBinding{
+            .binding = 2,
+            .descriptorType = vk::DescriptorType::eSampler,
+            .descriptorCount = BindlessSamplerCount,
+            .stageFlags = vk::ShaderStageFlagBits::eAll,
+        },
+    };
+    // Elements are written once as resources are first used and may stay stale after
+    // their image is deleted; shaders only index elements named by the current draw's
+    // index table so the arrays can be partially bound and updated while in use.
+    constexpr vk::DescriptorBindingFlags element_flags =
+        vk::DescriptorBindingFlagBits::ePartiallyBound |
+        vk::DescriptorBindingFlagBits::eUpdateAfterBind;
+    const std::array binding_flags = {element_flags, element_flags, element_flags};
+    const vk::DescriptorSetLayoutBindingFlagsCreateInfo flags_ci = {
+        .bindingCount = static_cast<u32>(binding_flags.size()),
+        .pBindingFlags = binding_flags.data(),
+    };
+    const vk::DescriptorSetLayoutCreateInfo layout_ci = {
+        .pNext = &flags_ci,
+        .flags = vk::DescriptorSetLayoutCreateFlagBits::eUpdateAfterBindPool,
+        .bindingCount = static_cast<u32>(bindings.size()),
+        .pBindings = bindings.data(),
+    };
+    bindless_layout = device.createDescriptorSetLayoutUnique(layout_ci);
+
+    const std::array pool_sizes = {
+        vk::DescriptorPoolSize{vk::DescriptorType::eSampledImage, BindlessSampledImageCount},
+        vk::DescriptorPoolSize{vk::DescriptorType::eStorageImage, BindlessStorageImageCount},
+        vk::DescriptorPoolSize{vk::DescriptorType::eSampler, BindlessSamplerCount},
+    };
+    const vk::DescriptorPoolCreateInfo pool_ci = {
+        .flags = vk::DescriptorPoolCreateFlagBits::eUpdateAfterBind,
+        .maxSets = 1,
+        .poolSizeCount = static_cast<u32>(pool_sizes.size()),
+        .pPoolSizes = pool_sizes.data(),
+    };
+    bindless_pool = device.createDescriptorPoolUnique(pool_ci);
+
+    const vk::DescriptorSetAllocateInfo alloc_info = {
+        .descriptorPool = *bindless_pool,
+        .descriptorSetCount = 1,
+        .pSetLayouts = std::addressof(*bindless_layout),
+    };
+    bindless_set = device.allocateDescriptorSets(alloc_info)[0];
+}
+
+u32 TextureCache::BindlessSlot(ImageView& image_view) {
+    if (image_view.bindless_slot != ImageView::NoBindlessSlot) {
+        return image_view.bindless_slot;
+    }
+    const bool is_storage = image_view.info.is_storage;
+    auto& free_slots = free_bindless_slots[is_storage];
+    u32 slot;
+    if (!free_slots.empty()) {
+        slot = free_slots.back();
+        free_slots.pop_back();
+    } else {
+        slot = next_bindless_slot[is_storage]++;
+        ASSERT_MSG(slot < (is_storage ? BindlessStorageImageCount : BindlessSampledImageCount),
+                   "Bindless image array exhausted");
+    }
+    // The written layout must match what FindImageView transitions the image to,
+    // otherwise the descriptor disagrees with the layout at draw time.
+    const Image& image = slot_images[image_view.image_id];
+    const vk::ImageLayout layout = is_storage ? vk::ImageLayout::eGeneral
+                                   : image.info.IsDepthStencil()
+                                       ? vk::ImageLayout::eDepthStencilReadOnlyOptimal
+                                       : vk::ImageLayout::eShaderReadOnlyOptimal;
+    const vk::DescriptorImageInfo image_info = {
+        .imageView = *image_view.image_view,
+        .imageLayout = layout,
+    };
+    const vk::WriteDescriptorSet write = {
+        .dstSet = bindless_set,
+        .dstBinding = is_storage ? 1U : 0U,
+        .dstArrayElement = slot,
+        .descriptorCount = 1,
+        .descriptorType =
+            is_storage ? vk::DescriptorType::eStorageImage : vk::DescriptorType::eSampledImage,
+        .pImageInfo = &image_info,
+    };
+    instance.GetDevice().updateDescriptorSets(write, {});
+    image_view.bindless_slot = slot;
+    return slot;
+}
+
+u32 TextureCache::BindlessSamplerSlot(vk::Sampler sampler) {
+    const auto [it, is_new] =
+        bindless_sampler_slots.try_emplace(reinterpret_cast<u64>(static_cast<VkSampler>(sampler)));
+    if (is_new) {
+        const u32 slot = next_bindless_sampler_slot++;
+        ASSERT_MSG(slot < BindlessSamplerCount, "Bindless sampler array exhausted");
+        const vk::DescriptorImageInfo sampler_info = {
+            .sampler = sampler,
+        };
+        const vk::WriteDescriptorSet write = {
+            .dstSet = bindless_set,
+            .dstBinding = 2,
+            .dstArrayElement = slot,
+            .descriptorCount = 1,
+            .descriptorType = vk::DescriptorType::eSampler,
+            .pImageInfo = &sampler_info,
+        };
+        instance.GetDevice().updateDescriptorSets(write, {});
+        it.value() = slot;
+    }
+    return it->second;
+}
+
 void TextureCache::RegisterImage(ImageId image_id) {
     Image& image = slot_images[image_id];
     ASSERT_MSG(False(image.flags & ImageFlagBits::Registered),
                "Trying to register an already registered image");
     image.flags |= ImageFlagBits::Registered;
+    registered_images.push_back(image_id);
     ForEachPage(image.cpu_addr, image.info.guest_size_bytes,
                 [this, image_id](u64 page) { page_table[page].push_back(image_id); });
 }
@@ -349,6 +824,9 @@ void TextureCache::UnregisterImage(ImageId image_id) {
     ASSERT_MSG(True(image.flags & ImageFlagBits::Registered),
                "Trying to unregister an already registered image");
     image.flags &= ~ImageFlagBits::Registered;
+    const auto list_it = std::ranges::find(registered_images, image_id);
+    ASSERT(list_it != registered_images.end());
+    registered_images.erase(list_it);
     ForEachPage(image.cpu_addr, image.info.guest_size_bytes, [this, image_id](u64 page) {
         const auto page_it = page_table.find(page);
         if (page_it == page_table.end()) {
@@ -363,7 +841,85 @@ void TextureCache::UnregisterImage(ImageId image_id) {
         }
         image_ids.erase(vector_it);
     });
-    slot_images.erase(image_id);
+}
+
+void TextureCache::DeleteImage(ImageId image_id) {
+    Image& image = slot_images[image_id];
+    UntrackImage(image, image_id);
+    UnregisterImage(image_id);
+    // Drop any descriptor lookup entries that resolve to the deleted views.
+    const auto drop_stale_views = [&image](tsl::robin_map<u64, ImageViewId>& lookup) {
+        for (auto it = lookup.begin(); it != lookup.end();) {
+            if (std::ranges::find(image.image_view_ids, it->second) !=
+                image.image_view_ids.end()) {
+                it = lookup.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    };
+    drop_stale_views(view_lookup);
+    drop_stale_views(depth_target_lookup);
+    // The GPU might still be reading from the image, delay the destruction of its
+    // backing memory and views until the current tick has been reached.
+    scheduler.DeferOperation([this, image_id, view_ids = image.image_view_ids] {
+        for (const ImageViewId view_id : view_ids) {
+            // Return any published bindless elements to the free list; the stale
+            // descriptor is harmless as no future index table can name the slot
+            // until it is reused, at which point it is overwritten.
+            const ImageView& view = slot_image_views[view_id];
+            if (view.bindless_slot != ImageView::NoBindlessSlot) {
+                free_bindless_slots[view.info.is_storage].push_back(view.bindless_slot);
+            }
+            slot_image_views.erase(view_id);
+        }
+        slot_images.erase(image_id);
+        // The GPU has retired the tick that last referenced these slots, so
+        // trailing storage accumulated over a long session can be released.
+        slot_images.compact();
+        slot_image_views.compact();
+    });
+}
+
+void TextureCache::EvictOverBudget() {
+    if (!instance.IsMemoryBudgetSupported()) {
+        return;
+    }
+    const auto [budget, usage] = instance.GetMemoryBudget();
+    if (budget == 0 || usage + budget / 10 <= budget) {
+        // Keep ten percent of headroom so allocations made before the next
+        // lookup do not immediately push the heap over its limit.
+        return;
+    }
+
+    const u64 current_tick = scheduler.CurrentTick();
+    boost::container::small_vector<ImageId, 32> candidates;
+    for (const ImageId image_id : registered_images) {
+        // Never evict surfaces that were looked up during the current tick, they
+        // may be referenced by the command buffer under construction.
+        if (slot_images[image_id].lru_tick < current_tick) {
+            candidates.push_back(image_id);
+        }
+    }
+    std::ranges::sort(candidates, [this](ImageId lhs, ImageId rhs) {
+        return slot_images[lhs].lru_tick < slot_images[rhs].lru_tick;
+    });
+
+    auto* profiler = Common::Singleton<Common::Profiler>::Instance();
+    u64 reclaimed = 0;
+    const u64 overage = usage + budget / 10 - budget;
+    for (const ImageId image_id : candidates) {
+        if (reclaimed >= overage) {
+            break;
+        }
+        reclaimed += slot_images[image_id].image.MemSize();
+        DeleteImage(image_id);
+        profiler->AddCounter(Common::Profiler::Counter::ImagesEvicted);
+    }
+    if (reclaimed != 0) {
+        LOG_DEBUG(Render_Vulkan, "Evicted {} bytes of image memory, usage {} budget {}", reclaimed,
+                  usage, budget);
+    }
 }
 
 void TextureCache::TrackImage(Image& image, ImageId image_id) {
@@ -394,25 +950,79 @@ void TextureCache::UpdatePagesCachedCount(VAddr addr, u64 size, s32 delta) {
         cached_pages.add({pages_interval, delta});
     }
 
+    // Toggled intervals arrive in ascending order, so runs of adjacent pages
+    // changing in the same direction are coalesced into one protection call
+    // instead of one per tracked interval.
+    const bool protect = delta > 0;
+    VAddr pending_addr = 0;
+    u64 pending_size = 0;
+    const auto flush_pending = [&] {
+        if (pending_size == 0) {
+            return;
+        }
+        if (protect) {
+            // Publish the bits before revoking write access so a fault raised right
+            // after the protect always observes the page as protected.
+            MarkPagesProtected(pending_addr, pending_size, true);
+            ProtectRegion(pending_addr, pending_size, true);
+        } else {
+            ProtectRegion(pending_addr, pending_size, false);
+            MarkPagesProtected(pending_addr, pending_size, false);
+        }
+        pending_size = 0;
+    };
+
     const auto& range = cached_pages.equal_range(pages_interval);
     for (const auto& [range, count] : boost::make_iterator_range(range)) {
         const auto interval = range & pages_interval;
         const VAddr interval_start_addr = boost::icl::first(interval) << PageShift;
         const VAddr interval_end_addr = boost::icl::last_next(interval) << PageShift;
         const u32 interval_size = interval_end_addr - interval_start_addr;
-        void* addr = reinterpret_cast<void*>(interval_start_addr);
-        if (delta > 0 && count == delta) {
-            mprotect(addr, interval_size, PAGE_READONLY);
-        } else if (delta < 0 && count == -delta) {
-            mprotect(addr, interval_size, PAGE_READWRITE);
+        if ((delta > 0 && count == delta) || (delta < 0 && count == -delta)) {
+            if (pending_size != 0 && pending_addr + pending_size == interval_start_addr) {
+                pending_size += interval_size;
+            } else {
+                flush_pending();
+                pending_addr = interval_start_addr;
+                pending_size = interval_size;
+            }
         } else {
             ASSERT(count >= 0);
         }
     }
+    flush_pending();
 
     if (delta < 0) {
         cached_pages.add({pages_interval, delta});
     }
 }
 
+void TextureCache::ProtectRegion(VAddr addr, u64 size, bool protect) {
+#ifndef _WIN64
+    if (uffd_tracker) {
+        uffd_tracker->Protect(addr, size, protect);
+        return;
+    }
+#endif
+    mprotect(reinterpret_cast<void*>(addr), size, protect ? PAGE_READONLY : PAGE_READWRITE);
+}
+
+bool TextureCache::IsPageProtected(VAddr address) const {
+    const u64 page = address >> PageShift;
+    const u64 word = protected_pages[page >> 6].load(std::memory_order_acquire);
+    return (word >> (page & 63)) & 1;
+}
+
+void TextureCache::MarkPagesProtected(VAddr addr, u64 size, bool protect) {
+    const u64 page_end = ((addr + size - 1) >> PageShift) + 1;
+    for (u64 page = addr >> PageShift; page < page_end; ++page) {
+        const u64 mask = 1ULL << (page & 63);
+        if (protect) {
+            protected_pages[page >> 6].fetch_or(mask, std::memory_order_release);
+        } else {
+            protected_pages[page >> 6].fetch_and(~mask, std::memory_order_release);
+        }
+    }
+}
+
 } // namespace VideoCore
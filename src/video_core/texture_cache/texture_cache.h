@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <shared_mutex>
 #include <boost/container/small_vector.hpp>
 #include <boost/icl/interval_map.hpp>
 #include <tsl/robin_map.h>
@@ -10,6 +14,7 @@
 #include "common/slot_vector.h"
 #include "video_core/amdgpu/resource.h"
 #include "video_core/renderer_vulkan/vk_stream_buffer.h"
+#include "video_core/renderer_vulkan/vk_upload_engine.h"
 #include "video_core/texture_cache/image.h"
 #include "video_core/texture_cache/image_view.h"
 #include "video_core/texture_cache/sampler.h"
@@ -21,6 +26,8 @@ struct BufferAttributeGroup;
 
 namespace VideoCore {
 
+class UffdPageTracker;
+
 class TextureCache {
     // This is the page shift for adding images into the hash map. It isn't related to
     // the page size of the guest or the host and is chosen for convenience. A number too
@@ -54,20 +61,58 @@ public:
     /// Retrieves an image view with the properties of the specified image descriptor.
     [[nodiscard]] ImageView& FindImageView(const AmdGpu::Image& image, bool is_storage);
 
-    /// Retrieves the render target with specified properties
+    /// Retrieves the render target with specified properties, allocated at
+    /// scale_pct percent of its guest dimensions.
     [[nodiscard]] ImageView& RenderTarget(const AmdGpu::Liverpool::ColorBuffer& buffer,
-                                          const AmdGpu::Liverpool::CbDbExtent& hint);
+                                          const AmdGpu::Liverpool::CbDbExtent& hint,
+                                          u32 scale_pct = 100);
     [[nodiscard]] ImageView& DepthTarget(const AmdGpu::Liverpool::DepthBuffer& buffer,
                                          VAddr htile_address,
                                          const AmdGpu::Liverpool::CbDbExtent& hint,
-                                         bool write_enabled);
+                                         bool write_enabled, u32 scale_pct = 100);
+
+    /// Records the address of a registered video-out surface. Targets backed by
+    /// these addresses must stay at native size as presentation looks them up
+    /// with guest dimensions.
+    void MarkVoSurface(VAddr address) {
+        std::unique_lock lock{m_page_table};
+        if (std::ranges::find(vo_surface_addrs, address) == vo_surface_addrs.end()) {
+            vo_surface_addrs.push_back(address);
+        }
+    }
+
+    /// Returns true when the address backs a registered video-out surface.
+    bool IsVideoOutSurface(VAddr address) {
+        std::shared_lock lock{m_page_table};
+        return std::ranges::find(vo_surface_addrs, address) != vo_surface_addrs.end();
+    }
 
     /// Reuploads image contents.
     void RefreshImage(Image& image);
 
+    /// Makes the graphics queue wait for any pending async upload of the image.
+    void TouchUploadedImage(Image& image);
+
     /// Retrieves the sampler that matches the provided S# descriptor.
     [[nodiscard]] vk::Sampler GetSampler(const AmdGpu::Sampler& sampler);
 
+    /// Returns the set layout of the global descriptor arrays used by bindless shaders.
+    [[nodiscard]] vk::DescriptorSetLayout BindlessSetLayout() const {
+        return *bindless_layout;
+    }
+
+    /// Returns the descriptor set holding the global descriptor arrays.
+    [[nodiscard]] vk::DescriptorSet BindlessSet() const {
+        return bindless_set;
+    }
+
+    /// Returns the element of the global sampled/storage image array the view occupies,
+    /// publishing its descriptor on first use.
+    [[nodiscard]] u32 BindlessSlot(ImageView& image_view);
+
+    /// Returns the element of the global sampler array the sampler occupies.
+    [[nodiscard]] u32 BindlessSamplerSlot(vk::Sampler sampler);
+
     /// Retrieves the image with the specified id.
     [[nodiscard]] Image& GetImage(ImageId id) {
         return slot_images[id];
@@ -95,7 +140,10 @@ public:
     }
 
 private:
-    ImageView& RegisterImageView(ImageId image_id, const ImageViewInfo& view_info);
+    ImageViewId RegisterImageView(ImageId image_id, const ImageViewInfo& view_info);
+
+    /// Creates the update-after-bind descriptor pool and set backing the bindless path.
+    void CreateBindlessSet();
 
     /// Iterate over all page indices in a range
     template <typename Func>
@@ -163,6 +211,12 @@ private:
     /// Unregister image from the page table
     void UnregisterImage(ImageId image);
 
+    /// Removes the image from the cache and defers destruction of its resources
+    void DeleteImage(ImageId image_id);
+
+    /// Evicts least recently used images until device-local usage is back under budget
+    void EvictOverBudget();
+
     /// Track CPU reads and writes for image
     void TrackImage(Image& image, ImageId image_id);
 
@@ -172,22 +226,58 @@ private:
     /// Increase/decrease the number of surface in pages touching the specified region
     void UpdatePagesCachedCount(VAddr addr, u64 size, s32 delta);
 
+    /// Returns true if the page containing the address is currently write protected
+    bool IsPageProtected(VAddr address) const;
+
+    /// Sets or clears the protection bits for all pages in the region
+    void MarkPagesProtected(VAddr addr, u64 size, bool protect);
+
+    /// Applies or lifts write protection through the active tracking backend.
+    void ProtectRegion(VAddr addr, u64 size, bool protect);
+
 private:
     const Vulkan::Instance& instance;
     Vulkan::Scheduler& scheduler;
     Vulkan::StreamBuffer staging;
+    Vulkan::UploadEngine upload_engine;
     TileManager tile_manager;
     Common::SlotVector<Image> slot_images;
     Common::SlotVector<ImageView> slot_image_views;
     tsl::robin_map<u64, Sampler> samplers;
+    tsl::robin_map<u64, ImageViewId> view_lookup;
+    tsl::robin_map<u64, ImageViewId> depth_target_lookup;
+    boost::container::small_vector<VAddr, 8> vo_surface_addrs;
+    vk::UniqueDescriptorSetLayout bindless_layout;
+    vk::UniqueDescriptorPool bindless_pool;
+    vk::DescriptorSet bindless_set;
+    std::array<u32, 2> next_bindless_slot{};
+    std::array<std::vector<u32>, 2> free_bindless_slots;
+    tsl::robin_map<u64, u32> bindless_sampler_slots;
+    u32 next_bindless_sampler_slot{};
+    std::vector<ImageId> registered_images;
     tsl::robin_pg_map<u64, std::vector<ImageId>> page_table;
     boost::icl::interval_map<VAddr, s32> cached_pages;
+    // Lock-free bitmap with one bit per write protected guest page. The fault handler
+    // consults it before taking the page table lock, so unrelated writes that race with
+    // an unprotect are filtered out without serializing on the render thread.
+    std::unique_ptr<std::atomic<u64>[]> protected_pages;
     tsl::robin_map<VAddr, MetaDataInfo> surface_metas;
     std::mutex mutex;
 #ifdef _WIN64
     void* veh_handle{};
+#else
+    // Signal-free fault delivery backend; null when the kernel lacks
+    // userfaultfd write-protect support and SIGSEGV tracking is used instead.
+    std::unique_ptr<UffdPageTracker> uffd_tracker;
 #endif
-    std::mutex m_page_table;
+    // Structural updates (register/unregister, image insertion) happen on the
+    // render thread under an exclusive lock; fault handlers only read the table
+    // and take it shared so faults on unrelated textures proceed concurrently.
+    std::shared_mutex m_page_table;
+    // Image state touched by fault handlers (dirty flag, tracking) is striped by
+    // image id so concurrent faults landing on the same image still serialize.
+    static constexpr size_t NumImageLockStripes = 16;
+    std::array<std::mutex, NumImageLockStripes> image_lock_stripes;
 };
 
 } // namespace VideoCore
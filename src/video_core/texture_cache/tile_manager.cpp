@@ -1,6 +1,8 @@
 // SPDX-FileCopyrightText: Copyright 2024 shadPS4 Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "common/alignment.h"
+#include "common/config.h"
 #include "video_core/renderer_vulkan/vk_instance.h"
 #include "video_core/renderer_vulkan/vk_scheduler.h"
 #include "video_core/renderer_vulkan/vk_shader_util.h"
@@ -13,10 +15,21 @@
 #include "video_core/host_shaders/detile_m32x4_comp.h"
 #include "video_core/host_shaders/detile_m8x1_comp.h"
 #include "video_core/host_shaders/detile_m8x2_comp.h"
+#include "video_core/host_shaders/detile_macro32x1_comp.h"
+#include "video_core/host_shaders/detile_macro32x2_comp.h"
+#include "video_core/host_shaders/detile_macro32x4_comp.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
 
 #include <boost/container/static_vector.hpp>
 #include <magic_enum.hpp>
 
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 namespace VideoCore {
 
 static u32 IntLog2(u32 i) {
@@ -153,23 +166,60 @@ public:
     }
 };
 
+/// Returns the cached tiled byte offsets of every even texel for the given surface layout.
+/// The bank/pipe swizzle math only depends on (width, height, is_neo), so the table is
+/// computed once and reused on every refresh of surfaces with the same dimensions. The
+/// cache stays small as only a handful of video-out layouts are ever requested.
+static const std::vector<u32>& GetDetileOffsets(u32 width, u32 height, bool is_neo) {
+    static std::mutex lut_mutex;
+    static std::unordered_map<u64, std::vector<u32>> lut_cache;
+
+    const u64 key = (u64(width) << 33) | (u64(height) << 1) | u64(is_neo);
+    std::scoped_lock lk{lut_mutex};
+    const auto [it, is_new] = lut_cache.try_emplace(key);
+    if (is_new) {
+        TileManager32 t;
+        t.Init(width, height, is_neo);
+
+        const u32 pairs_per_row = (width + 1) / 2;
+        auto& offsets = it->second;
+        offsets.resize(size_t(pairs_per_row) * height);
+        for (u32 y = 0; y < height; y++) {
+            for (u32 x = 0; x < width; x += 2) {
+                offsets[size_t(y) * pairs_per_row + (x >> 1)] =
+                    static_cast<u32>(t.getTiledOffs(x, y, is_neo));
+            }
+        }
+    }
+    return it->second;
+}
+
 void ConvertTileToLinear(u8* dst, const u8* src, u32 width, u32 height, bool is_neo) {
-    TileManager32 t;
-    t.Init(width, height, is_neo);
+    const auto& offsets = GetDetileOffsets(width, height, is_neo);
+    const u32 pairs_per_row = (width + 1) / 2;
 
     for (u32 y = 0; y < height; y++) {
+        const u32* row_offsets = offsets.data() + size_t(y) * pairs_per_row;
         u32 x = 0;
-        u64 linear_offset = y * width * 4;
-
+        u64 linear_offset = u64(y) * width * 4;
+
+#ifdef __AVX2__
+        // Gather four texel pairs per iteration using the precomputed offset table.
+        for (; x + 8 <= width; x += 8) {
+            const __m128i vindex =
+                _mm_loadu_si128(reinterpret_cast<const __m128i*>(row_offsets + (x >> 1)));
+            const __m256i data =
+                _mm256_i32gather_epi64(reinterpret_cast<const long long*>(src), vindex, 1);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + linear_offset), data);
+            linear_offset += 32;
+        }
+#endif
         for (; x + 1 < width; x += 2) {
-            auto tiled_offset = t.getTiledOffs(x, y, is_neo);
-
-            std::memcpy(dst + linear_offset, src + tiled_offset, sizeof(u64));
+            std::memcpy(dst + linear_offset, src + row_offsets[x >> 1], sizeof(u64));
             linear_offset += 8;
         }
         if (x < width) {
-            auto tiled_offset = t.getTiledOffs(x, y, is_neo);
-            std::memcpy(dst + linear_offset, src + tiled_offset, sizeof(u32));
+            std::memcpy(dst + linear_offset, src + row_offsets[x >> 1], sizeof(u32));
         }
     }
 }
@@ -188,11 +238,20 @@ vk::Format DemoteImageFormatForDetiling(vk::Format format) {
     case vk::Format::eR32Sfloat:
     case vk::Format::eR32Uint:
         return vk::Format::eR32Uint;
+    case vk::Format::eBc1RgbaSrgbBlock:
     case vk::Format::eBc1RgbaUnormBlock:
+    case vk::Format::eBc4SnormBlock:
+    case vk::Format::eBc4UnormBlock:
     case vk::Format::eR32G32Sfloat:
         return vk::Format::eR32G32Uint;
+    case vk::Format::eBc2SrgbBlock:
+    case vk::Format::eBc2UnormBlock:
     case vk::Format::eBc3SrgbBlock:
     case vk::Format::eBc3UnormBlock:
+    case vk::Format::eBc5SnormBlock:
+    case vk::Format::eBc5UnormBlock:
+    case vk::Format::eBc6HSfloatBlock:
+    case vk::Format::eBc6HUfloatBlock:
     case vk::Format::eBc7SrgbBlock:
     case vk::Format::eBc7UnormBlock:
         return vk::Format::eR32G32B32A32Uint;
@@ -223,6 +282,18 @@ const DetilerContext* TileManager::GetDetiler(const Image& image) const {
             return nullptr;
         }
     }
+    if (image.info.tiling_mode == AmdGpu::TilingMode::Display_MacroTiled) {
+        switch (format) {
+        case vk::Format::eR32Uint:
+            return &detilers[DetilerType::Macro32x1];
+        case vk::Format::eR32G32Uint:
+            return &detilers[DetilerType::Macro32x2];
+        case vk::Format::eR32G32B32A32Uint:
+            return &detilers[DetilerType::Macro32x4];
+        default:
+            return nullptr;
+        }
+    }
     return nullptr;
 }
 
@@ -230,14 +301,33 @@ static constexpr vk::BufferUsageFlags StagingFlags = vk::BufferUsageFlagBits::eT
                                                      vk::BufferUsageFlagBits::eUniformBuffer |
                                                      vk::BufferUsageFlagBits::eStorageBuffer;
 
+struct DetilerParams {
+    u32 pitch;
+    u32 height;
+    u32 is_neo;
+};
+
+/// Returns the height of the surface as padded by the macro tiler.
+static u32 MacroPaddedHeight(u32 height, bool is_neo) {
+    if (height == 1080) {
+        return is_neo ? 1152 : 1088;
+    }
+    if (height == 720) {
+        return 768;
+    }
+    const u32 macro_tile_height = is_neo ? 128 : 64;
+    return Common::AlignUp(height, macro_tile_height);
+}
+
 TileManager::TileManager(const Vulkan::Instance& instance, Vulkan::Scheduler& scheduler)
     : instance{instance}, scheduler{scheduler},
       staging{instance, scheduler, StagingFlags, 128_MB, Vulkan::BufferType::Upload} {
 
     static const std::array detiler_shaders{
-        HostShaders::DETILE_M8X1_COMP,  HostShaders::DETILE_M8X2_COMP,
-        HostShaders::DETILE_M32X1_COMP, HostShaders::DETILE_M32X2_COMP,
-        HostShaders::DETILE_M32X4_COMP,
+        HostShaders::DETILE_M8X1_COMP,       HostShaders::DETILE_M8X2_COMP,
+        HostShaders::DETILE_M32X1_COMP,      HostShaders::DETILE_M32X2_COMP,
+        HostShaders::DETILE_M32X4_COMP,      HostShaders::DETILE_MACRO32X1_COMP,
+        HostShaders::DETILE_MACRO32X2_COMP,  HostShaders::DETILE_MACRO32X4_COMP,
     };
 
     for (int pl_id = 0; pl_id < DetilerType::Max; ++pl_id) {
@@ -282,7 +372,7 @@ TileManager::TileManager(const Vulkan::Instance& instance, Vulkan::Scheduler& sc
         const vk::PushConstantRange push_constants = {
             .stageFlags = vk::ShaderStageFlagBits::eCompute,
             .offset = 0,
-            .size = sizeof(u32),
+            .size = sizeof(DetilerParams),
         };
 
         const vk::DescriptorSetLayout set_layout = *desc_layout;
@@ -365,11 +455,21 @@ bool TileManager::TryDetile(Image& image) {
     cmdbuf.pushDescriptorSetKHR(vk::PipelineBindPoint::eCompute, *detiler->pl_layout, 0,
                                 set_writes);
 
-    cmdbuf.pushConstants(*detiler->pl_layout, vk::ShaderStageFlagBits::eCompute, 0u,
-                         sizeof(image.info.pitch), &image.info.pitch);
-
-    cmdbuf.dispatch((image.info.size.width * image.info.size.height) / 64, 1,
-                    1); // round to 64
+    const bool is_neo = Config::isNeoMode();
+    const bool is_macro = image.info.tiling_mode == AmdGpu::TilingMode::Display_MacroTiled;
+    const DetilerParams params = {
+        .pitch = image.info.pitch,
+        .height = MacroPaddedHeight(image.info.size.height, is_neo),
+        .is_neo = is_neo,
+    };
+    cmdbuf.pushConstants(*detiler->pl_layout, vk::ShaderStageFlagBits::eCompute, 0u, sizeof(params),
+                         &params);
+
+    // The macro detiler works on one element per invocation addressed in pitch units,
+    // while the micro detilers cover a whole tile row per subgroup.
+    const u32 num_texels =
+        (is_macro ? image.info.pitch : image.info.size.width) * image.info.size.height;
+    cmdbuf.dispatch(num_texels / 64, 1, 1); // round to 64
 
     return true;
 }
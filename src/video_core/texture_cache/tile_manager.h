@@ -23,6 +23,9 @@ enum DetilerType : u32 {
     Micro32x1,
     Micro32x2,
     Micro32x4,
+    Macro32x1,
+    Macro32x2,
+    Macro32x4,
 
     Max
 };